@@ -0,0 +1,322 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#ifndef __MIMMO_BENCHMARK_UTILS_HPP__
+#define __MIMMO_BENCHMARK_UTILS_HPP__
+
+#include "mimmo_core.hpp"
+#include "mimmoThreads.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*!
+ * Shared utilities of the mimmo benchmarks: command line options, synthetic mesh
+ * generators and JSON report of the timings.
+ *
+ * Each benchmark accepts the options
+ * - --sizes=n1,n2,...   number of cells per direction of the synthetic meshes;
+ * - --threads=t1,t2,... number of threads of mimmo internal parallel kernels;
+ * - --repeat=r          number of timed repetitions of each kernel;
+ * - --output=file       JSON report file (default: standard output).
+ *
+ * Meshes are built on a mimmo::UStructMesh spanning the unit cube, so that the
+ * same size always produces the same geometry and timings are comparable
+ * between different versions of mimmo.
+ */
+namespace benchmark{
+
+/*!
+ * Options of a benchmark run.
+ */
+struct Options{
+    std::vector<int>            sizes;      /**< Number of cells per direction of the meshes.*/
+    std::vector<std::size_t>    threads;    /**< Numbers of threads to be tested.*/
+    int                         repeat;     /**< Number of timed repetitions.*/
+    std::string                 output;     /**< JSON report file; empty for standard output.*/
+};
+
+/*!
+ * Parse a comma separated list of positive integers.
+ * \param[in] list string to be parsed
+ * \return parsed values.
+ */
+template<typename T>
+std::vector<T> parseList(const std::string & list){
+    std::vector<T> values;
+    std::stringstream ss(list);
+    std::string item;
+    while(std::getline(ss, item, ',')){
+        if(item.empty()) continue;
+        long value = std::stol(item);
+        if(value <= 0) throw std::runtime_error("benchmark: invalid value " + item);
+        values.push_back(T(value));
+    }
+    return values;
+}
+
+/*!
+ * Parse the command line options.
+ * \param[in] argc number of arguments
+ * \param[in] argv arguments
+ * \param[in] defaultSizes sizes used if --sizes is not given
+ * \return options of the run.
+ */
+inline Options parseOptions(int argc, char *argv[], const std::vector<int> & defaultSizes){
+    Options options;
+    options.sizes = defaultSizes;
+    options.threads.push_back(mimmo::threads::getNumberOfThreads());
+    options.repeat = 3;
+    for(int i = 1; i < argc; ++i){
+        std::string arg(argv[i]);
+        std::size_t pos = arg.find('=');
+        std::string key = arg.substr(0, pos);
+        std::string value = (pos == std::string::npos) ? "" : arg.substr(pos + 1);
+        if(key == "--sizes"){
+            options.sizes = parseList<int>(value);
+        }else if(key == "--threads"){
+            options.threads = parseList<std::size_t>(value);
+        }else if(key == "--repeat"){
+            options.repeat = std::max(1, std::stoi(value));
+        }else if(key == "--output"){
+            options.output = value;
+        }else{
+            throw std::runtime_error("benchmark: unknown option " + arg
+                + ". Available options: --sizes=n1,n2,... --threads=t1,t2,... --repeat=r --output=file");
+        }
+    }
+    if(options.sizes.empty() || options.threads.empty()){
+        throw std::runtime_error("benchmark: empty list of sizes or threads");
+    }
+    return options;
+}
+
+/*!
+ * Statistics of the timed repetitions of a kernel.
+ */
+struct Result{
+    std::string kernel;     /**< Name of the kernel.*/
+    int         size;       /**< Number of cells per direction of the mesh.*/
+    long        elements;   /**< Number of elements processed by the kernel.*/
+    std::size_t threads;    /**< Number of threads.*/
+    int         repeat;     /**< Number of timed repetitions.*/
+    double      min;        /**< Minimum time [s].*/
+    double      median;     /**< Median time [s].*/
+    double      mean;       /**< Mean time [s].*/
+    double      max;        /**< Maximum time [s].*/
+};
+
+/*!
+ * \class Report
+ * \brief Collection of the results of a benchmark, written as a JSON document.
+ */
+class Report{
+
+public:
+    /*!
+     * Constructor.
+     * \param[in] name name of the benchmark
+     * \param[in] options options of the run
+     */
+    Report(const std::string & name, const Options & options) : m_name(name), m_options(options){}
+
+    /*!
+     * Time a kernel. For each repetition setup is called first, untimed, to prepare
+     * fresh input data; then kernel is called and timed.
+     * \param[in] kernelName name of the kernel
+     * \param[in] size number of cells per direction of the mesh
+     * \param[in] elements number of elements processed by the kernel
+     * \param[in] setup untimed preparation of each repetition
+     * \param[in] kernel timed function
+     */
+    void run(const std::string & kernelName, int size, long elements,
+             const std::function<void()> & setup, const std::function<void()> & kernel){
+
+        std::vector<double> times;
+        times.reserve(m_options.repeat);
+        for(int r = 0; r < m_options.repeat; ++r){
+            if(setup) setup();
+            auto start = std::chrono::steady_clock::now();
+            kernel();
+            auto stop = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double>(stop - start).count());
+        }
+        std::sort(times.begin(), times.end());
+
+        Result result;
+        result.kernel = kernelName;
+        result.size = size;
+        result.elements = elements;
+        result.threads = mimmo::threads::getNumberOfThreads();
+        result.repeat = m_options.repeat;
+        result.min = times.front();
+        result.max = times.back();
+        std::size_t half = times.size() / 2;
+        result.median = (times.size() % 2) ? times[half] : 0.5 * (times[half - 1] + times[half]);
+        result.mean = 0.0;
+        for(double t : times) result.mean += t;
+        result.mean /= double(times.size());
+        m_results.push_back(result);
+
+        std::cerr << m_name << " " << kernelName << " size " << size << " threads " << result.threads
+                  << " median " << result.median << " s" << std::endl;
+    }
+
+    /*!
+     * Write the report on the output file of the options or on the standard output.
+     */
+    void write() const{
+        if(m_options.output.empty()){
+            write(std::cout);
+            return;
+        }
+        std::ofstream out(m_options.output);
+        if(!out.is_open()){
+            throw std::runtime_error("benchmark: cannot open " + m_options.output);
+        }
+        write(out);
+    }
+
+    /*!
+     * Write the report as a JSON document.
+     * \param[in] out output stream
+     */
+    void write(std::ostream & out) const{
+        out << std::setprecision(9);
+        out << "{\n";
+        out << "  \"benchmark\": \"" << m_name << "\",\n";
+        out << "  \"version\": \"" << MIMMO_VERSION << "\",\n";
+        out << "  \"mpi\": " << (MIMMO_ENABLE_MPI ? "true" : "false") << ",\n";
+        out << "  \"results\": [";
+        for(std::size_t i = 0; i < m_results.size(); ++i){
+            const Result & r = m_results[i];
+            out << (i ? ",\n" : "\n");
+            out << "    {\"kernel\": \"" << r.kernel << "\", \"size\": " << r.size
+                << ", \"elements\": " << r.elements << ", \"threads\": " << r.threads
+                << ", \"repeat\": " << r.repeat << ", \"min\": " << r.min
+                << ", \"median\": " << r.median << ", \"mean\": " << r.mean
+                << ", \"max\": " << r.max << "}";
+        }
+        out << "\n  ]\n}" << std::endl;
+    }
+
+private:
+    std::string         m_name;     /**< Name of the benchmark.*/
+    Options             m_options;  /**< Options of the run.*/
+    std::vector<Result> m_results;  /**< Collected results.*/
+};
+
+/*!
+ * Create a volume mesh of n x n x n hexahedra spanning the unit cube. The nodes are
+ * the nodes of a mimmo::UStructMesh and their ids are the structured point indices.
+ * \param[in] n number of cells per direction
+ * \return volume mesh, with adjacencies and interfaces built.
+ */
+inline mimmo::MimmoSharedPointer<mimmo::MimmoObject> createVolumeMesh(int n){
+
+    mimmo::UStructMesh grid;
+    darray3E origin = {{0.5, 0.5, 0.5}};
+    darray3E span = {{1.0, 1.0, 1.0}};
+    iarray3E dimensions = {{n + 1, n + 1, n + 1}};
+    grid.setMesh(origin, span, mimmo::ShapeType::CUBE, dimensions);
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(2));
+    mesh->getPatch()->reserveVertices(std::size_t(n + 1) * (n + 1) * (n + 1));
+    mesh->getPatch()->reserveCells(std::size_t(n) * n * n);
+
+    dvecarr3E coords = grid.getGlobalCoords();
+    for(std::size_t i = 0; i < coords.size(); ++i){
+        mesh->addVertex(coords[i], long(i));
+    }
+
+    livector1D conn(8);
+    long id = 0;
+    for(int i = 0; i < n; ++i){
+        for(int j = 0; j < n; ++j){
+            for(int k = 0; k < n; ++k){
+                conn[0] = grid.accessPointIndex(i, j, k);
+                conn[1] = grid.accessPointIndex(i + 1, j, k);
+                conn[2] = grid.accessPointIndex(i + 1, j + 1, k);
+                conn[3] = grid.accessPointIndex(i, j + 1, k);
+                conn[4] = grid.accessPointIndex(i, j, k + 1);
+                conn[5] = grid.accessPointIndex(i + 1, j, k + 1);
+                conn[6] = grid.accessPointIndex(i + 1, j + 1, k + 1);
+                conn[7] = grid.accessPointIndex(i, j + 1, k + 1);
+                mesh->addConnectedCell(conn, bitpit::ElementType::HEXAHEDRON, 0, id);
+                ++id;
+            }
+        }
+    }
+
+    mesh->updateAdjacencies();
+    mesh->updateInterfaces();
+    mesh->update();
+    return mesh;
+}
+
+/*!
+ * Create a closed triangulated surface mesh, boundary of the volume mesh of size n.
+ * It is made of 12 n^2 triangles.
+ * \param[in] n number of cells per direction
+ * \return surface mesh, with adjacencies built.
+ */
+inline mimmo::MimmoSharedPointer<mimmo::MimmoObject> createSurfaceMesh(int n){
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> surface = createVolumeMesh(n)->extractBoundaryMesh();
+    surface->triangulate();
+    surface->updateAdjacencies();
+    surface->update();
+    return surface;
+}
+
+/*!
+ * Create a set of deterministic pseudo-random points inside the box [-0.5, 1.5]^3,
+ * enclosing the synthetic meshes.
+ * \param[in] nPoints number of points
+ * \return points.
+ */
+inline dvecarr3E createPoints(std::size_t nPoints){
+    dvecarr3E points(nPoints);
+    // linear congruential generator with fixed seed, identical on every platform
+    unsigned long long state = 12345;
+    for(auto & point : points){
+        for(double & coord : point){
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            coord = -0.5 + 2.0 * double(state >> 11) / double(1ULL << 53);
+        }
+    }
+    return points;
+}
+
+}
+
+#endif /* __MIMMO_BENCHMARK_UTILS_HPP__ */
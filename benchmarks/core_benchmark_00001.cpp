@@ -0,0 +1,120 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "benchmark_utils.hpp"
+#include "SkdTreeUtils.hpp"
+
+// =================================================================================== //
+/*!
+	\example core_benchmark_00001.cpp
+
+	\brief Benchmark of the core kernels: MimmoObject::update, construction of the
+	search trees and skdTreeUtils distance/projection queries.
+
+	Using: MimmoObject, UStructMesh, skdTreeUtils.
+
+	<b>To run</b>: ./core_benchmark_00001 [--sizes=16,32,64] [--threads=1,2,4] [--repeat=3] [--output=core.json] \n
+ */
+
+void benchmark00001(const benchmark::Options & options) {
+
+    benchmark::Report report("core_benchmark_00001", options);
+
+    for(std::size_t nThreads : options.threads){
+        mimmo::threads::setNumberOfThreads(nThreads);
+
+        for(int n : options.sizes){
+
+            /*
+                Volume mesh: full update of the data structures after a change of the mesh.
+             */
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> volume = benchmark::createVolumeMesh(n);
+            volume->buildKdTree();
+            report.run("MimmoObject::update", n, volume->getNCells(),
+                [&volume](){ volume->setUnsyncAll(); },
+                [&volume](){ volume->update(); });
+
+            report.run("MimmoObject::buildKdTree", n, volume->getNVertices(),
+                [&volume](){ volume->setUnsyncAll(); },
+                [&volume](){ volume->buildKdTree(); });
+            volume.reset();
+
+            /*
+                Surface mesh: construction of the skdTree and queries of a cloud of points.
+             */
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> surface = benchmark::createSurfaceMesh(n);
+            report.run("MimmoObject::buildSkdTree", n, surface->getNCells(),
+                [&surface](){ surface->setUnsyncAll(); },
+                [&surface](){ surface->buildSkdTree(); });
+            surface->update();
+
+            int nPoints = 16 * n * n;
+            dvecarr3E points = benchmark::createPoints(nPoints);
+            std::vector<long> ids(nPoints);
+            std::vector<double> distances(nPoints);
+            dvecarr3E normals(nPoints);
+            dvecarr3E projected(nPoints);
+            bitpit::PatchSkdTree * tree = surface->getSkdTree();
+
+            report.run("skdTreeUtils::distance", n, nPoints, nullptr,
+                [&](){ mimmo::skdTreeUtils::distance(nPoints, points.data(), tree, ids.data(), distances.data(), std::numeric_limits<double>::max()); });
+
+            report.run("skdTreeUtils::signedDistance", n, nPoints, nullptr,
+                [&](){ mimmo::skdTreeUtils::signedDistance(nPoints, points.data(), tree, ids.data(), distances.data(), normals.data(), std::numeric_limits<double>::max()); });
+
+            report.run("skdTreeUtils::projectPoint", n, nPoints, nullptr,
+                [&](){ mimmo::skdTreeUtils::projectPoint(nPoints, points.data(), tree, projected.data(), ids.data()); });
+        }
+    }
+
+    report.write();
+}
+
+// =================================================================================== //
+
+int main(int argc, char *argv[]) {
+
+#if MIMMO_ENABLE_MPI==1
+	MPI_Init(&argc, &argv);
+
+	{
+#endif
+
+		/**<calling core benchmark*/
+		try{
+			benchmark00001(benchmark::parseOptions(argc, argv, {16, 32, 64}));
+		}
+		catch(std::exception & e){
+			std::cout<<"core_benchmark_00001 exited with an error of type : "<<e.what()<<std::endl;
+			return 1;
+		}
+
+#if MIMMO_ENABLE_MPI==1
+	}
+
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
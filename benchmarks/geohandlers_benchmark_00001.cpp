@@ -0,0 +1,122 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "benchmark_utils.hpp"
+#include "mimmo_geohandlers.hpp"
+
+// =================================================================================== //
+/*!
+	\example geohandlers_benchmark_00001.cpp
+
+	\brief Benchmark of the geohandlers: stitching of several surface meshes and
+	refinement of a triangulated surface.
+
+	Using: StitchGeometry, RefineGeometry, UStructMesh.
+
+	<b>To run</b>: ./geohandlers_benchmark_00001 [--sizes=16,32,64] [--threads=1,2,4] [--repeat=3] [--output=geohandlers.json] \n
+ */
+
+void benchmark00001(const benchmark::Options & options) {
+
+    benchmark::Report report("geohandlers_benchmark_00001", options);
+
+    for(std::size_t nThreads : options.threads){
+        mimmo::threads::setNumberOfThreads(nThreads);
+
+        for(int n : options.sizes){
+
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> surface = benchmark::createSurfaceMesh(n);
+
+            /*
+                Stitch four copies of the surface.
+             */
+            std::vector<mimmo::MimmoSharedPointer<mimmo::MimmoObject>> parts;
+            for(int i = 0; i < 4; ++i){
+                parts.push_back(surface->clone());
+            }
+            std::unique_ptr<mimmo::StitchGeometry> stitch;
+            report.run("StitchGeometry::execute", n, 4 * surface->getNCells(),
+                [&](){
+                    stitch.reset(new mimmo::StitchGeometry(1));
+                    for(auto & part : parts){
+                        stitch->addGeometry(part);
+                    }
+                },
+                [&](){ stitch->execute(); });
+            stitch.reset();
+            parts.clear();
+
+            /*
+                One step of refinement of a copy of the surface, for each refinement method.
+             */
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> target;
+            std::unique_ptr<mimmo::RefineGeometry> refine;
+            for(mimmo::RefineType type : {mimmo::RefineType::TERNARY, mimmo::RefineType::REDGREEN}){
+                report.run(type == mimmo::RefineType::TERNARY ? "RefineGeometry::execute(TERNARY)" : "RefineGeometry::execute(REDGREEN)",
+                    n, surface->getNCells(),
+                    [&](){
+                        target = surface->clone();
+                        target->updateAdjacencies();
+                        refine.reset(new mimmo::RefineGeometry());
+                        refine->setGeometry(target);
+                        refine->setRefineType(type);
+                        refine->setRefineSteps(1);
+                        refine->setSmoothingSteps(0);
+                    },
+                    [&](){ refine->execute(); });
+            }
+            refine.reset();
+        }
+    }
+
+    report.write();
+}
+
+// =================================================================================== //
+
+int main(int argc, char *argv[]) {
+
+#if MIMMO_ENABLE_MPI==1
+	MPI_Init(&argc, &argv);
+
+	{
+#endif
+
+		/**<calling geohandlers benchmark*/
+		try{
+			benchmark00001(benchmark::parseOptions(argc, argv, {16, 32, 64}));
+		}
+		catch(std::exception & e){
+			std::cout<<"geohandlers_benchmark_00001 exited with an error of type : "<<e.what()<<std::endl;
+			return 1;
+		}
+
+#if MIMMO_ENABLE_MPI==1
+	}
+
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "benchmark_utils.hpp"
+#include "mimmo_iogeneric.hpp"
+
+// =================================================================================== //
+/*!
+	\example iogeneric_benchmark_00001.cpp
+
+	\brief Benchmark of the main readers/writers of MimmoGeometry: binary STL, surface
+	and volume VTU, Nastran.
+
+	Using: MimmoGeometry, UStructMesh.
+
+	<b>To run</b>: ./iogeneric_benchmark_00001 [--sizes=16,32,64] [--threads=1,2,4] [--repeat=3] [--output=iogeneric.json] \n
+ */
+
+/*!
+ * Time writing and reading back a geometry in a given format.
+ * \param[in] report benchmark report
+ * \param[in] n size of the synthetic mesh
+ * \param[in] geometry geometry to be written
+ * \param[in] type file format
+ */
+void benchmarkFormat(benchmark::Report & report, int n, mimmo::MimmoSharedPointer<mimmo::MimmoObject> geometry, FileType type){
+
+    std::string filename = "iogeneric_benchmark_00001." + std::string(type._to_string()) + "." + std::to_string(n);
+
+    std::unique_ptr<mimmo::MimmoGeometry> writer;
+    report.run("MimmoGeometry::write(" + std::string(type._to_string()) + ")", n, geometry->getNCells(),
+        [&](){
+            writer.reset(new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::WRITE));
+            writer->setWriteDir(".");
+            writer->setWriteFileType(type);
+            writer->setWriteFilename(filename);
+            writer->setGeometry(geometry);
+        },
+        [&](){ writer->execute(); });
+    writer.reset();
+
+    std::unique_ptr<mimmo::MimmoGeometry> reader;
+    report.run("MimmoGeometry::read(" + std::string(type._to_string()) + ")", n, geometry->getNCells(),
+        [&](){
+            reader.reset(new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::READ));
+            reader->setReadDir(".");
+            reader->setReadFileType(type);
+            reader->setReadFilename(filename);
+            reader->setBuildSkdTree(false);
+            reader->setBuildKdTree(false);
+        },
+        [&](){ reader->execute(); });
+    reader.reset();
+}
+
+void benchmark00001(const benchmark::Options & options) {
+
+    benchmark::Report report("iogeneric_benchmark_00001", options);
+
+    for(std::size_t nThreads : options.threads){
+        mimmo::threads::setNumberOfThreads(nThreads);
+
+        for(int n : options.sizes){
+
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> surface = benchmark::createSurfaceMesh(n);
+            benchmarkFormat(report, n, surface, FileType::STL);
+            benchmarkFormat(report, n, surface, FileType::SURFVTU);
+            benchmarkFormat(report, n, surface, FileType::NAS);
+            surface.reset();
+
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> volume = benchmark::createVolumeMesh(n);
+            benchmarkFormat(report, n, volume, FileType::VOLVTU);
+        }
+    }
+
+    report.write();
+}
+
+// =================================================================================== //
+
+int main(int argc, char *argv[]) {
+
+#if MIMMO_ENABLE_MPI==1
+	MPI_Init(&argc, &argv);
+
+	{
+#endif
+
+		/**<calling iogeneric benchmark*/
+		try{
+			benchmark00001(benchmark::parseOptions(argc, argv, {16, 32, 64}));
+		}
+		catch(std::exception & e){
+			std::cout<<"iogeneric_benchmark_00001 exited with an error of type : "<<e.what()<<std::endl;
+			return 1;
+		}
+
+#if MIMMO_ENABLE_MPI==1
+	}
+
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "benchmark_utils.hpp"
+#include "mimmo_manipulators.hpp"
+
+// =================================================================================== //
+/*!
+	\example manipulators_benchmark_00001.cpp
+
+	\brief Benchmark of the manipulators: evaluation of the FFDLattice deformation and
+	solution/evaluation of the MRBF interpolation on the nodes of a volume mesh.
+
+	Using: FFDLattice, MRBF, UStructMesh.
+
+	<b>To run</b>: ./manipulators_benchmark_00001 [--sizes=16,32,64] [--threads=1,2,4] [--repeat=3] [--output=manipulators.json] \n
+ */
+
+void benchmark00001(const benchmark::Options & options) {
+
+    benchmark::Report report("manipulators_benchmark_00001", options);
+
+    for(std::size_t nThreads : options.threads){
+        mimmo::threads::setNumberOfThreads(nThreads);
+
+        for(int n : options.sizes){
+
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> volume = benchmark::createVolumeMesh(n);
+            long nVertices = volume->getNVertices();
+            // search trees are built once, out of the timed kernels
+            volume->buildSkdTree();
+            volume->buildKdTree();
+
+            /*
+                FFD lattice of 10x10x10 nodes with cubic Bezier curves enclosing the mesh.
+                Deterministic smooth displacements of the lattice nodes.
+             */
+            darray3E origin = {{0.5, 0.5, 0.5}};
+            darray3E span = {{1.2, 1.2, 1.2}};
+            iarray3E dimensions = {{10, 10, 10}};
+            iarray3E degrees = {{3, 3, 3}};
+            std::unique_ptr<mimmo::FFDLattice> lattice;
+            report.run("FFDLattice::execute", n, nVertices,
+                [&](){
+                    lattice.reset(new mimmo::FFDLattice());
+                    lattice->setGeometry(volume);
+                    lattice->setLattice(origin, span, mimmo::ShapeType::CUBE, dimensions, degrees);
+                    dvecarr3E displ(lattice->getNNodes());
+                    for(std::size_t i = 0; i < displ.size(); ++i){
+                        displ[i] = {{0.0, 0.0, 0.01 * std::sin(0.1 * double(i))}};
+                    }
+                    lattice->setDisplacements(displ);
+                },
+                [&](){ lattice->execute(); });
+            lattice.reset();
+
+            /*
+                MRBF with 4n control nodes randomly placed around the mesh, compact Wendland C2
+                functions. WHOLE solves the interpolation system before evaluating the
+                deformation, NONE uses the displacements as weights.
+             */
+            int nNodes = 4 * n;
+            dvecarr3E nodes = benchmark::createPoints(nNodes);
+            dvecarr3E rbfDispl(nNodes);
+            for(int i = 0; i < nNodes; ++i){
+                rbfDispl[i] = {{0.0, 0.0, 0.01 * std::cos(0.1 * double(i))}};
+            }
+            std::unique_ptr<mimmo::MRBF> mrbf;
+            for(mimmo::MRBFSol solver : {mimmo::MRBFSol::WHOLE, mimmo::MRBFSol::NONE}){
+                report.run(solver == mimmo::MRBFSol::WHOLE ? "MRBF::execute(WHOLE)" : "MRBF::execute(NONE)",
+                    n, nVertices,
+                    [&](){
+                        mrbf.reset(new mimmo::MRBF(solver));
+                        mrbf->setGeometry(volume);
+                        mrbf->setNode(nodes);
+                        mrbf->setDisplacements(rbfDispl);
+                        mrbf->setSupportRadiusReal(0.5);
+                    },
+                    [&](){ mrbf->execute(); });
+            }
+            mrbf.reset();
+        }
+    }
+
+    report.write();
+}
+
+// =================================================================================== //
+
+int main(int argc, char *argv[]) {
+
+#if MIMMO_ENABLE_MPI==1
+	MPI_Init(&argc, &argv);
+
+	{
+#endif
+
+		/**<calling manipulators benchmark*/
+		try{
+			benchmark00001(benchmark::parseOptions(argc, argv, {16, 32, 64}));
+		}
+		catch(std::exception & e){
+			std::cout<<"manipulators_benchmark_00001 exited with an error of type : "<<e.what()<<std::endl;
+			return 1;
+		}
+
+#if MIMMO_ENABLE_MPI==1
+	}
+
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "benchmark_utils.hpp"
+#include "mimmo_propagators.hpp"
+
+// =================================================================================== //
+/*!
+	\example propagators_benchmark_00001.cpp
+
+	\brief Benchmark of PropagateVectorField: propagation into a volume mesh of a
+	displacement field imposed on its whole boundary.
+
+	Using: PropagateVectorField, UStructMesh.
+
+	<b>To run</b>: ./propagators_benchmark_00001 [--sizes=8,16,32] [--threads=1,2,4] [--repeat=3] [--output=propagators.json] \n
+ */
+
+void benchmark00001(const benchmark::Options & options) {
+
+    benchmark::Report report("propagators_benchmark_00001", options);
+
+    for(std::size_t nThreads : options.threads){
+        mimmo::threads::setNumberOfThreads(nThreads);
+
+        for(int n : options.sizes){
+
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> volume = benchmark::createVolumeMesh(n);
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> boundary = volume->extractBoundaryMesh();
+            boundary->updateAdjacencies();
+            boundary->update();
+
+            /*
+                Smooth bump on the bottom face z = 0, zero displacement elsewhere.
+             */
+            mimmo::MimmoPiercedVector<std::array<double,3>> bc;
+            bc.setGeometry(boundary);
+            bc.setDataLocation(mimmo::MPVLocation::POINT);
+            bc.reserve(boundary->getNVertices());
+            for(const bitpit::Vertex & vertex : boundary->getVertices()){
+                std::array<double,3> coords = vertex.getCoords();
+                std::array<double,3> displ = {{0.0, 0.0, 0.0}};
+                if(coords[2] < 1.0e-12){
+                    displ[2] = 0.1 * std::sin(BITPIT_PI * coords[0]) * std::sin(BITPIT_PI * coords[1]);
+                }
+                bc.insert(vertex.getId(), displ);
+            }
+
+            std::unique_ptr<mimmo::PropagateVectorField> prop;
+            report.run("PropagateVectorField::execute", n, volume->getNCells(),
+                [&](){
+                    prop.reset(new mimmo::PropagateVectorField());
+                    prop->setGeometry(volume);
+                    prop->addDirichletBoundaryPatch(boundary);
+                    prop->addDirichletConditions(&bc);
+                    prop->setDamping(false);
+                },
+                [&](){ prop->execute(); });
+            prop.reset();
+        }
+    }
+
+    report.write();
+}
+
+// =================================================================================== //
+
+int main(int argc, char *argv[]) {
+
+#if MIMMO_ENABLE_MPI==1
+	MPI_Init(&argc, &argv);
+
+	{
+#endif
+
+		/**<calling propagators benchmark*/
+		try{
+			benchmark00001(benchmark::parseOptions(argc, argv, {8, 16, 32}));
+		}
+		catch(std::exception & e){
+			std::cout<<"propagators_benchmark_00001 exited with an error of type : "<<e.what()<<std::endl;
+			return 1;
+		}
+
+#if MIMMO_ENABLE_MPI==1
+	}
+
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
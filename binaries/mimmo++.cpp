@@ -23,6 +23,21 @@
 \*---------------------------------------------------------------------------*/
 
 #include "mimmo.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <csignal>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+    #define MIMMOPP_SERVER_AVAILABLE 1
+#else
+    #define MIMMOPP_SERVER_AVAILABLE 0
+#endif
 
 /*!
  * Global logger of the process
@@ -56,6 +71,10 @@ enum class Verbose{
  *  - vlog: (enum VERBOSE) type of message verbosity returned by mimmo++ on log file.
  *  - optres: (bool) if true, return partial results of mimmo++ execution, i.e. all optional results of every block involved in the execution
  *  - optres_path: (string) specify path to save optional results of execution. Meaningful only if optres is active
+ *  - profile: (string) path prefix of the profiling report of the execution. Profiling is disabled if empty
+ *  - server: (string) path of the UNIX socket of the server mode. Server mode is disabled if empty
+ *  - sweep: (string) path of the table of design parameters of the sweep mode. Sweep mode is disabled if empty
+ *  - asyncOutput: (bool) if true, output files and optional results are written in background during the execution
  */
 struct InfoMimmoPP{
 
@@ -65,6 +84,10 @@ struct InfoMimmoPP{
     bool optres;                /**< boolean to activate writing of execution optional results */
     bool expert;                /**< boolean to override mandatory ports checking */
     std::string optres_path;    /**< path to store optional results */
+    std::string profile;        /**< path prefix of profiling report, empty if profiling is disabled */
+    std::string server;         /**< path of the server socket, empty if server mode is disabled */
+    std::string sweep;          /**< path of the design table, empty if sweep mode is disabled */
+    bool asyncOutput;           /**< boolean to activate background writing of output files */
 
     /*! Base constructor*/
     InfoMimmoPP(){
@@ -74,6 +97,10 @@ struct InfoMimmoPP{
         optres      = false;
         optres_path = ".";
         expert      = false;
+        profile     = "";
+        server      = "";
+        sweep       = "";
+        asyncOutput = false;
     }
     /*! Destructor */
     ~InfoMimmoPP(){};
@@ -91,6 +118,10 @@ struct InfoMimmoPP{
         optres = other.optres;
         optres_path = other.optres_path;
         expert = other.expert;
+        profile = other.profile;
+        server = other.server;
+        sweep = other.sweep;
+        asyncOutput = other.asyncOutput;
         return *this;
     }
 };
@@ -150,6 +181,35 @@ InfoMimmoPP readArguments(std::vector<std::string> & sanitized_args ){
         std::cout<<" "<<std::endl;
         std::cout<<"    --expert,-e=yes                                 : override mandatory ports connection checking.              "<<std::endl;
         std::cout<<" "<<std::endl;
+        std::cout<<"    --profile,-prof=<path prefix>                   : activate profiling of the execution. Time, peak memory     "<<std::endl;
+        std::cout<<"                                                    increase and number of elements of each block and phase   "<<std::endl;
+        std::cout<<"                                                    are written in <path prefix>.json and, in Chrome trace     "<<std::endl;
+        std::cout<<"                                                    format, in <path prefix>.trace.json                        "<<std::endl;
+        std::cout<<" "<<std::endl;
+        std::cout<<"    --server,-s=<socket path>                       : run in server mode. The workflow is executed once, then    "<<std::endl;
+        std::cout<<"                                                    mimmo++ listens on the UNIX socket <socket path> for       "<<std::endl;
+        std::cout<<"                                                    line commands, re-executing only the blocks affected by    "<<std::endl;
+        std::cout<<"                                                    the changes. Commands (one reply line OK/ERROR each):      "<<std::endl;
+        std::cout<<"                                                      set <block> <option> <value> : set a block XML option   "<<std::endl;
+        std::cout<<"                                                      get <block> <option>         : get a block XML option   "<<std::endl;
+        std::cout<<"                                                      dirty <block>                : force block execution    "<<std::endl;
+        std::cout<<"                                                      run                          : execute the workflow     "<<std::endl;
+        std::cout<<"                                                      ping                         : check the server         "<<std::endl;
+        std::cout<<"                                                      quit                         : stop the server          "<<std::endl;
+        std::cout<<" "<<std::endl;
+        std::cout<<"    --sweep,-sw=<table path>                        : evaluate the workflow over the designs of a table. The     "<<std::endl;
+        std::cout<<"                                                    first line lists the parameters as <block>:<option>,       "<<std::endl;
+        std::cout<<"                                                    each following line the values of a design; columns are    "<<std::endl;
+        std::cout<<"                                                    separated by ';', lines starting with '#' are ignored.     "<<std::endl;
+        std::cout<<"                                                    Designs run on MIMMO_NUM_THREADS replicas of the workflow, "<<std::endl;
+        std::cout<<"                                                    sharing their setup between designs. The status of each    "<<std::endl;
+        std::cout<<"                                                    design is written as it completes in <table path>.results  "<<std::endl;
+        std::cout<<" "<<std::endl;
+        std::cout<<"    --async-output,-ao=yes                          : write output files and optional results in background,     "<<std::endl;
+        std::cout<<"                                                    overlapping writing with the execution of the following    "<<std::endl;
+        std::cout<<"                                                    blocks. Each chain waits for its files before ending.      "<<std::endl;
+        std::cout<<"                                                    Not active in MPI runs with more than one process.         "<<std::endl;
+        std::cout<<" "<<std::endl;
         std::cout<<" "<<std::endl;
         std::cout<<" "<<std::endl;
         std::cout<<"    For any problem, bug and malfunction please contact mimmo developers.                       "<<std::endl;
@@ -158,13 +218,17 @@ InfoMimmoPP readArguments(std::vector<std::string> & sanitized_args ){
     }
 
     std::unordered_map<int, std::string> keymap;
-    int nkeys = 6;
+    int nkeys = 10;
     keymap[0] = "--dictionary=";
     keymap[1] = "--log-verbosity=";
     keymap[2] = "--console-verbosity=";
     keymap[3] = "--optional-results=";
     keymap[4] = "--optional-results-path=";
     keymap[5] = "--expert=";
+    keymap[6] = "--profile=";
+    keymap[7] = "--server=";
+    keymap[8] = "--sweep=";
+    keymap[9] = "--async-output=";
 
     keymap[nkeys] = "-d=";
     keymap[nkeys+1] = "-lv=";
@@ -172,6 +236,10 @@ InfoMimmoPP readArguments(std::vector<std::string> & sanitized_args ){
     keymap[nkeys+3] = "-or=";
     keymap[nkeys+4] = "-orp=";
     keymap[nkeys+5] = "-e=";
+    keymap[nkeys+6] = "-prof=";
+    keymap[nkeys+7] = "-s=";
+    keymap[nkeys+8] = "-sw=";
+    keymap[nkeys+9] = "-ao=";
 
     keymap[2*nkeys] = "dict=";
     keymap[2*nkeys+1] = "vlog=";
@@ -179,6 +247,10 @@ InfoMimmoPP readArguments(std::vector<std::string> & sanitized_args ){
     keymap[2*nkeys+3] = "opt-res=";
     keymap[2*nkeys+4] = "opt-res-path=";
     keymap[2*nkeys+5] = "expert=";
+    keymap[2*nkeys+6] = "profile=";
+    keymap[2*nkeys+7] = "server=";
+    keymap[2*nkeys+8] = "sweep=";
+    keymap[2*nkeys+9] = "async-output=";
 
     std::map<int, std::string> final_map;
     //visit input list and search for each key string  in key map. If an input string positively match a key,
@@ -208,6 +280,10 @@ InfoMimmoPP readArguments(std::vector<std::string> & sanitized_args ){
     if(final_map.count(4)) result.optres_path = final_map[4];
     if(final_map.count(3)) result.optres = (final_map[3]=="yes");
     if(final_map.count(5)) result.expert = (final_map[5]=="yes");
+    if(final_map.count(6)) result.profile = final_map[6];
+    if(final_map.count(7)) result.server = final_map[7];
+    if(final_map.count(8)) result.sweep = final_map[8];
+    if(final_map.count(9)) result.asyncOutput = (final_map[9]=="yes");
 
     if(final_map.count(1)){
         int check = -1 + int(final_map[1]=="quiet") + 2*int(final_map[1]=="normal") + 3*int(final_map[1]=="full");
@@ -232,11 +308,16 @@ InfoMimmoPP readArguments(std::vector<std::string> & sanitized_args ){
  * ## <B>Blocks</B> ...declaration of all executable objects <B>/Blocks</B>
  * ## <B>Connections</B> ...declaration of all links between executable objects <B>/Connections</B>
  *
+ * Blocks listed in sharedBlocks are not instantiated again: the existing instances are
+ * connected to the new blocks, while the connections among them are not read again.
+ *
  * \param[out] mapInst map of all declared and instantiated blocks
  * \param[out] mapConn map of all blocks that need to be linked/connected
  * \param[in] rootFactory reference to internal register of mimmo API
+ * \param[in] sharedBlocks existing blocks to be reused, by name
  */
-void read_Dictionary(std::map<std::string, std::unique_ptr<mimmo::BaseManipulation > >  & mapInst, std::unordered_map<std::string, mimmo::BaseManipulation * >  & mapConn, mimmo::Factory<mimmo::BaseManipulation> & rootFactory) {
+void read_Dictionary(std::map<std::string, std::unique_ptr<mimmo::BaseManipulation > >  & mapInst, std::unordered_map<std::string, mimmo::BaseManipulation * >  & mapConn, mimmo::Factory<mimmo::BaseManipulation> & rootFactory,
+                     const std::unordered_map<std::string, mimmo::BaseManipulation * > & sharedBlocks = std::unordered_map<std::string, mimmo::BaseManipulation * >()) {
 
     mimmo_log->setPriority(bitpit::log::NORMAL);
     (*mimmo_log)<< "Currently reading XML dictionary"<<std::endl;
@@ -252,6 +333,10 @@ void read_Dictionary(std::map<std::string, std::unique_ptr<mimmo::BaseManipulati
             std::string idstring = sect.first;
             idstring = bitpit::utils::string::trim(idstring);
 
+            if(sharedBlocks.count(idstring)){
+                (*mimmo_log)<< "...Shared mimmo block: "<<sect.first<<" of type "<<className<<std::endl;
+                continue;
+            }
 
             if(rootFactory.containsCreator(className)){
                 std::unique_ptr<mimmo::BaseManipulation >temp (rootFactory.create(className, *(sect.second.get())));
@@ -272,6 +357,9 @@ void read_Dictionary(std::map<std::string, std::unique_ptr<mimmo::BaseManipulati
             mapConn[iM.first] = iM.second.get();
             //need to find a way to define objects inside another object
         }
+        for(auto & iS : sharedBlocks){
+            mapConn[iS.first] = iS.second;
+        }
 
         (*mimmo_log)<<" "<<std::endl;
         (*mimmo_log)<<"Connectable objects : "<<mapConn.size()<<std::endl;
@@ -286,7 +374,21 @@ void read_Dictionary(std::map<std::string, std::unique_ptr<mimmo::BaseManipulati
 
 	if(mimmo_parser->hasSection("Connections")){
 		bitpit::Config::Section & connXML = mimmo_parser->getSection("Connections");
-		conns->absorbConnections(connXML, false);
+		if(sharedBlocks.empty()){
+			conns->absorbConnections(connXML, false);
+		}else{
+			//shared blocks are already linked to their senders.
+			bitpit::Config::Section replicaXML(true);
+			for(auto & sect : connXML.getSections()){
+				std::string receiver = sect.second->get("receiver", "");
+				if(sharedBlocks.count(bitpit::utils::string::trim(receiver))) continue;
+				bitpit::Config::Section & conn = replicaXML.addSection(sect.first);
+				for(auto & option : sect.second->getOptions()){
+					conn.set(option.first, option.second);
+				}
+			}
+			conns->absorbConnections(replicaXML, false);
+		}
 	}else{
         mimmo_log->setPriority(bitpit::log::NORMAL);
         (*mimmo_log)<<"No Connections section available in the XML dictionary"<<std::endl;
@@ -300,6 +402,512 @@ void read_Dictionary(std::map<std::string, std::unique_ptr<mimmo::BaseManipulati
 
 }
 
+// =================================================================================== //
+/*!
+ * Execute the chains of the workflow, in order of priority.
+ * \param[in] chainMap chains of the workflow, sorted by priority
+ * \param[in] info mimmo++ arguments
+ */
+void executeChains(std::map<uint, mimmo::Chain> & chainMap, const InfoMimmoPP & info){
+    for(auto &val : chainMap){
+        if (val.second.getNObjects() > 0){
+            mimmo_log->setPriority(bitpit::log::NORMAL);
+            (*mimmo_log)<<"...executing Chain w/ priority "<<val.first<<std::endl;
+            mimmo_log->setPriority(bitpit::log::DEBUG);
+            val.second.setPlotDebugResults(info.optres);
+            val.second.setOutputDebugResults(info.optres_path);
+            val.second.setAsyncOutput(info.asyncOutput);
+            val.second.exec(true);
+        }
+    }
+}
+
+#if MIMMOPP_SERVER_AVAILABLE
+//=================================================================================== //
+/*!
+ * \class ServerSocket
+ * \brief Listening UNIX stream socket of mimmo++ server mode.
+ *
+ * Clients are served one at a time; each client can send any number of commands,
+ * one per line, and receives one reply line for each command.
+ */
+class ServerSocket{
+
+    std::string m_path;     /**< path of the socket file */
+    int         m_listen;   /**< listening socket descriptor */
+    int         m_client;   /**< connected client descriptor, -1 if none */
+    std::string m_pending;  /**< characters received but not yet consumed */
+
+public:
+    /*!
+     * Constructor. It creates the socket file and starts listening.
+     * \param[in] path path of the socket file
+     */
+    ServerSocket(const std::string & path): m_path(path), m_listen(-1), m_client(-1){
+        struct sockaddr_un address;
+        if(m_path.size() >= sizeof(address.sun_path)){
+            throw std::runtime_error("server socket path too long: " + m_path);
+        }
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+
+        m_listen = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(m_listen < 0) throw std::runtime_error("cannot create server socket " + m_path);
+        unlink(m_path.c_str());
+        if(bind(m_listen, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0 || listen(m_listen, 8) < 0){
+            close(m_listen);
+            throw std::runtime_error("cannot listen on server socket " + m_path);
+        }
+    }
+
+    /*!
+     * Destructor. It closes the connections and removes the socket file.
+     */
+    ~ServerSocket(){
+        if(m_client >= 0) close(m_client);
+        if(m_listen >= 0) close(m_listen);
+        unlink(m_path.c_str());
+    }
+
+    /*!
+     * Wait for the next command line, accepting new clients when needed.
+     * Interrupted or aborted accept calls are retried.
+     * \param[out] line received line, without end of line characters
+     * \return false if no more clients can be accepted on the listening socket.
+     */
+    bool readLine(std::string & line){
+        while(true){
+            std::size_t pos = m_pending.find('\n');
+            if(pos != std::string::npos){
+                line = m_pending.substr(0, pos);
+                m_pending.erase(0, pos + 1);
+                if(!line.empty() && line.back() == '\r') line.pop_back();
+                return true;
+            }
+            if(m_client < 0){
+                m_pending.clear();
+                m_client = accept(m_listen, nullptr, nullptr);
+                if(m_client < 0 && errno != EINTR && errno != ECONNABORTED){
+                    mimmo_log->setPriority(bitpit::log::NORMAL);
+                    (*mimmo_log)<<"Server cannot accept clients: "<<std::strerror(errno)<<std::endl;
+                    mimmo_log->setPriority(bitpit::log::DEBUG);
+                    return false;
+                }
+                continue;
+            }
+            char buffer[4096];
+            ssize_t nread = recv(m_client, buffer, sizeof(buffer), 0);
+            if(nread <= 0){
+                close(m_client);
+                m_client = -1;
+                continue;
+            }
+            m_pending.append(buffer, std::size_t(nread));
+        }
+    }
+
+    /*!
+     * Send a reply line to the current client, if still connected.
+     * \param[in] line reply line
+     */
+    void writeLine(const std::string & line){
+        if(m_client < 0) return;
+        std::string message = line + "\n";
+        std::size_t sent = 0;
+        while(sent < message.size()){
+            ssize_t nsent = send(m_client, message.data() + sent, message.size() - sent, 0);
+            if(nsent <= 0){
+                close(m_client);
+                m_client = -1;
+                return;
+            }
+            sent += std::size_t(nsent);
+        }
+    }
+};
+#endif
+
+//=================================================================================== //
+/*!
+ * Broadcast a string from rank 0 to all the processes (MPI runs only).
+ * \param[in,out] line string to broadcast
+ */
+void broadcastString(std::string & line){
+#if MIMMO_ENABLE_MPI
+    int size = int(line.size());
+    MPI_Bcast(&size, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    line.resize(std::size_t(size));
+    if(size > 0) MPI_Bcast(&line[0], size, MPI_CHAR, 0, MPI_COMM_WORLD);
+#else
+    BITPIT_UNUSED(line);
+#endif
+}
+
+//=================================================================================== //
+/*!
+ * Process a command of server mode.
+ * \param[in] line command line
+ * \param[in] mapConn blocks of the workflow, by name
+ * \param[in] chainMap chains of the workflow, sorted by priority
+ * \param[in] info mimmo++ arguments
+ * \param[out] stop true if the server has to stop
+ * \return reply line, starting with OK or ERROR.
+ */
+std::string processServerCommand(const std::string & line, std::unordered_map<std::string, mimmo::BaseManipulation * > & mapConn,
+                                 std::map<uint, mimmo::Chain> & chainMap, const InfoMimmoPP & info, bool & stop){
+    std::istringstream ss(line);
+    std::string command;
+    ss >> command;
+
+    if(command.empty())  return "ERROR empty command";
+    if(command == "ping") return "OK";
+    if(command == "quit"){
+        stop = true;
+        return "OK";
+    }
+    if(command == "run"){
+        auto start = std::chrono::steady_clock::now();
+        executeChains(chainMap, info);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        int nexecuted = 0;
+        std::string executed;
+        for(auto & val : mapConn){
+            if(!val.second->wasExecuted()) continue;
+            executed += (nexecuted ? "," : "") + val.first;
+            ++nexecuted;
+        }
+        return "OK time=" + std::to_string(elapsed) + " executed=" + std::to_string(nexecuted) + " blocks=" + executed;
+    }
+
+    std::string blockName;
+    ss >> blockName;
+    auto itBlock = mapConn.find(blockName);
+    if(itBlock == mapConn.end()) return "ERROR unknown block " + blockName;
+
+    if(command == "dirty"){
+        itBlock->second->markDirty();
+        return "OK";
+    }
+
+    std::string option;
+    ss >> option;
+    if(option.empty()) return "ERROR missing option for command " + command;
+
+    if(command == "set"){
+        std::string value;
+        std::getline(ss, value);
+        value = bitpit::utils::string::trim(value);
+        bitpit::Config::Section section;
+        section.set(option, value);
+        itBlock->second->absorbSectionXML(section, blockName);
+        itBlock->second->markDirty();
+        return "OK";
+    }
+    if(command == "get"){
+        bitpit::Config::Section section;
+        itBlock->second->flushSectionXML(section, blockName);
+        if(!section.hasOption(option)) return "ERROR option " + option + " not available for block " + blockName;
+        return "OK " + section.get(option);
+    }
+    return "ERROR unknown command " + command;
+}
+
+//=================================================================================== //
+/*!
+ * Run mimmo++ server mode: wait for commands on the UNIX socket specified in the
+ * arguments and process them, until a quit command is received. In MPI runs rank 0
+ * serves the socket and broadcasts the commands to all the processes.
+ * \param[in] info mimmo++ arguments
+ * \param[in] mapConn blocks of the workflow, by name
+ * \param[in] chainMap chains of the workflow, sorted by priority
+ */
+void serveRequests(const InfoMimmoPP & info, std::unordered_map<std::string, mimmo::BaseManipulation * > & mapConn,
+                   std::map<uint, mimmo::Chain> & chainMap){
+#if MIMMOPP_SERVER_AVAILABLE
+    int rank = 0;
+#if MIMMO_ENABLE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    std::unique_ptr<ServerSocket> server;
+    std::string error;
+    if(rank == 0){
+        std::signal(SIGPIPE, SIG_IGN);
+        try{
+            server.reset(new ServerSocket(info.server));
+        }catch(std::exception & e){
+            error = e.what();
+        }
+    }
+    broadcastString(error);
+    if(!error.empty()) throw std::runtime_error(error);
+
+    mimmo_log->setPriority(bitpit::log::NORMAL);
+    (*mimmo_log)<<"Server listening on "<<info.server<<std::endl;
+    mimmo_log->setPriority(bitpit::log::DEBUG);
+
+    bool stop = false;
+    while(!stop){
+        std::string line;
+        // A failure of the listening socket stops the server on all the processes.
+        if(rank == 0 && !server->readLine(line)) line = "quit";
+        broadcastString(line);
+        std::string reply;
+        try{
+            reply = processServerCommand(line, mapConn, chainMap, info, stop);
+        }catch(std::exception & e){
+            reply = std::string("ERROR ") + e.what();
+        }
+        if(rank == 0) server->writeLine(reply);
+    }
+
+    mimmo_log->setPriority(bitpit::log::NORMAL);
+    (*mimmo_log)<<"Server stopped."<<std::endl;
+    mimmo_log->setPriority(bitpit::log::DEBUG);
+#else
+    BITPIT_UNUSED(mapConn);
+    BITPIT_UNUSED(chainMap);
+    throw std::runtime_error("mimmo++ server mode is not available on this platform, socket " + info.server);
+#endif
+}
+
+// =================================================================================== //
+/*!
+ * Read the table of designs of sweep mode. The first non-comment line lists the
+ * parameters as <block>:<option>, each following line the values of a design;
+ * columns are separated by ';' and lines starting with '#' are ignored.
+ * \param[in] path path of the table
+ * \param[out] parameters block name and option of each column
+ * \param[out] designs values of the columns for each design
+ */
+void readSweepTable(const std::string & path, std::vector<std::pair<std::string, std::string>> & parameters,
+                    std::vector<std::vector<std::string>> & designs){
+    std::ifstream in(path);
+    if(!in.is_open()) throw std::runtime_error("mimmo++ sweep mode: cannot open table " + path);
+
+    parameters.clear();
+    designs.clear();
+    std::string line;
+    std::size_t lineNumber = 0;
+    while(std::getline(in, line)){
+        ++lineNumber;
+        line = bitpit::utils::string::trim(line);
+        if(line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> columns;
+        std::istringstream ss(line);
+        std::string column;
+        while(std::getline(ss, column, ';')){
+            columns.push_back(bitpit::utils::string::trim(column));
+        }
+
+        if(parameters.empty()){
+            for(const std::string & header : columns){
+                std::size_t pos = header.find(':');
+                if(pos == std::string::npos || pos == 0 || pos + 1 == header.size()){
+                    throw std::runtime_error("mimmo++ sweep mode: invalid parameter " + header + " in " + path + ", expected <block>:<option>");
+                }
+                parameters.emplace_back(header.substr(0, pos), header.substr(pos + 1));
+            }
+            continue;
+        }
+        if(columns.size() != parameters.size()){
+            throw std::runtime_error("mimmo++ sweep mode: wrong number of values at line " + std::to_string(lineNumber) + " of " + path);
+        }
+        designs.push_back(std::move(columns));
+    }
+    if(parameters.empty()) throw std::runtime_error("mimmo++ sweep mode: no parameters found in " + path);
+}
+
+/*!
+ * \brief Independent instance of the workflow blocks and chains, evaluating designs of sweep mode.
+ */
+struct WorkflowReplica{
+    std::map<std::string, std::unique_ptr<mimmo::BaseManipulation > > mapInst;   /**< owned blocks */
+    std::unordered_map<std::string, mimmo::BaseManipulation * >       mapConn;   /**< blocks by name */
+    std::map<uint, mimmo::Chain>                                       chainMap;  /**< chains sorted by priority */
+};
+
+// =================================================================================== //
+/*!
+ * Collect a block and all its descendants (or ancestors) in the workflow.
+ * \param[in] block starting block
+ * \param[in] descendants true to follow the children of the blocks, false to follow their parents
+ * \param[in,out] blocks collected blocks
+ */
+void collectLinkedBlocks(mimmo::BaseManipulation * block, bool descendants, std::unordered_set<mimmo::BaseManipulation *> & blocks){
+    if(!blocks.insert(block).second) return;
+    int nLinked = descendants ? block->getNChild() : block->getNParent();
+    for(int i = 0; i < nLinked; ++i){
+        mimmo::BaseManipulation * linked = descendants ? block->getChild(i) : block->getParent(i);
+        if(linked != nullptr) collectLinkedBlocks(linked, descendants, blocks);
+    }
+}
+
+/*!
+ * Find the setup blocks of sweep mode, executed once and shared read-only by all the
+ * replicas of the workflow. A block is a setup block unless it is a descendant of a
+ * block whose parameters are changed by the designs, or of an ancestor of a block
+ * deforming geometries in place (see BaseManipulation::setApply) for the designs:
+ * the geometries deformed by a design have to be owned by each replica.
+ * \param[in] parameters block name and option of each design parameter
+ * \param[in] mapConn blocks of the workflow, by name
+ * \return setup blocks, by name
+ */
+std::unordered_map<std::string, mimmo::BaseManipulation * > findSweepSetupBlocks(const std::vector<std::pair<std::string, std::string>> & parameters,
+                                                                                const std::unordered_map<std::string, mimmo::BaseManipulation * > & mapConn){
+    std::unordered_set<mimmo::BaseManipulation *> designBlocks;
+    for(const auto & parameter : parameters){
+        auto itBlock = mapConn.find(parameter.first);
+        if(itBlock != mapConn.end()) collectLinkedBlocks(itBlock->second, true, designBlocks);
+    }
+
+    std::unordered_set<mimmo::BaseManipulation *> deformedSources;
+    for(mimmo::BaseManipulation * block : designBlocks){
+        if(block->isApply()) collectLinkedBlocks(block, false, deformedSources);
+    }
+    std::unordered_set<mimmo::BaseManipulation *> replicaBlocks(designBlocks);
+    for(mimmo::BaseManipulation * block : deformedSources){
+        collectLinkedBlocks(block, true, replicaBlocks);
+    }
+
+    std::unordered_map<std::string, mimmo::BaseManipulation * > setupBlocks;
+    for(const auto & val : mapConn){
+        if(!replicaBlocks.count(val.second)) setupBlocks.insert(val);
+    }
+    return setupBlocks;
+}
+
+// =================================================================================== //
+/*!
+ * Run mimmo++ sweep mode: evaluate the workflow for each design of the table specified
+ * in the arguments. The setup blocks, whose results do not depend on the designs (see
+ * findSweepSetupBlocks), are executed once; additional replicas of the remaining blocks
+ * are created from the dictionary, up to the number of mimmo threads, linked to the shared
+ * setup blocks and evaluate designs concurrently. The status of each design is written in
+ * <table>.results as soon as it is completed, together with the time the design spent waiting
+ * for non thread-safe blocks of other replicas. At the end the sum of the evaluation times of
+ * the designs, net of the waits, over the wall time of the sweep is reported, i.e. the speedup
+ * actually obtained with respect to the evaluation of the designs one at a time.
+ * \param[in] info mimmo++ arguments
+ * \param[in] mapConn blocks of the workflow, by name
+ * \param[in] factory factory of the blocks
+ */
+void runSweep(const InfoMimmoPP & info, std::unordered_map<std::string, mimmo::BaseManipulation * > & mapConn,
+              mimmo::Factory<mimmo::BaseManipulation> & factory){
+
+    std::vector<std::pair<std::string, std::string>> parameters;
+    std::vector<std::vector<std::string>> designs;
+    readSweepTable(info.sweep, parameters, designs);
+
+    int nprocs = 1;
+    int rank = 0;
+#if MIMMO_ENABLE_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    std::size_t nReplicas = 1;
+    if(nprocs == 1){
+        nReplicas = std::max(std::size_t(1), std::min(mimmo::threads::getNumberOfThreads(), designs.size()));
+    }
+
+    auto setChainOptions = [&info](mimmo::Chain & chain){
+        chain.setPlotDebugResults(info.optres);
+        chain.setOutputDebugResults(info.optres_path);
+        chain.setAsyncOutput(info.asyncOutput);
+    };
+
+    //the setup blocks are taken out of the chains of the workflow and shared by the replicas.
+    std::unordered_map<std::string, mimmo::BaseManipulation * > setupBlocks = findSweepSetupBlocks(parameters, mapConn);
+
+    //replica 0 reuses the blocks already created, the others are read again from the dictionary.
+    std::vector<std::unique_ptr<WorkflowReplica>> replicas;
+    replicas.emplace_back(new WorkflowReplica());
+    for(auto &val : mapConn){
+        if(!setupBlocks.count(val.first)) replicas.back()->chainMap[val.second->getPriority()].addObject(val.second);
+    }
+    std::vector<std::unordered_map<std::string, mimmo::BaseManipulation * > *> connMaps(1, &mapConn);
+    for(std::size_t i = 1; i < nReplicas; ++i){
+        replicas.emplace_back(new WorkflowReplica());
+        WorkflowReplica & replica = *replicas.back();
+        read_Dictionary(replica.mapInst, replica.mapConn, factory, setupBlocks);
+        for(auto &val : replica.mapInst){
+            replica.chainMap[val.second->getPriority()].addObject(val.second.get());
+        }
+        connMaps.push_back(&replica.mapConn);
+    }
+
+    //the setup blocks are executed once, transferring their results to all the replicas.
+    {
+        std::map<uint, mimmo::Chain> setupChains;
+        for(auto &val : setupBlocks){
+            setupChains[val.second->getPriority()].addObject(val.second);
+        }
+        mimmo_log->setPriority(bitpit::log::NORMAL);
+        (*mimmo_log)<<"Executing "<<setupBlocks.size()<<" setup blocks shared by the designs... "<<std::endl;
+        mimmo_log->setPriority(bitpit::log::DEBUG);
+        for(auto &val : setupChains){
+            setChainOptions(val.second);
+            val.second.exec();
+        }
+    }
+
+    mimmo::DesignSweep sweep;
+    for(std::unique_ptr<WorkflowReplica> & replica : replicas){
+        std::vector<mimmo::Chain*> replicaChains;
+        for(auto &val : replica->chainMap){
+            if(val.second.getNObjects() == 0) continue;
+            setChainOptions(val.second);
+            replicaChains.push_back(&val.second);
+        }
+        sweep.addReplica(replicaChains);
+    }
+
+    sweep.setDesignSetter([&](std::size_t design, std::size_t replica){
+        std::unordered_map<std::string, mimmo::BaseManipulation * > & blocks = *connMaps[replica];
+        for(std::size_t j = 0; j < parameters.size(); ++j){
+            auto itBlock = blocks.find(parameters[j].first);
+            if(itBlock == blocks.end()) throw std::runtime_error("unknown block " + parameters[j].first);
+            bitpit::Config::Section section;
+            section.set(parameters[j].second, designs[design][j]);
+            itBlock->second->absorbSectionXML(section, parameters[j].first);
+            itBlock->second->markDirty();
+        }
+    });
+
+    std::ofstream results;
+    if(rank == 0){
+        results.open(info.sweep + ".results");
+        if(!results.is_open()) throw std::runtime_error("mimmo++ sweep mode: cannot write " + info.sweep + ".results");
+        results<<"design;status;time;wait;message"<<std::endl;
+    }
+    sweep.setDesignObserver([&](const mimmo::DesignSweep::DesignResult & result){
+        if(rank != 0) return;
+        results<<result.design<<";"<<(result.success ? "OK" : "ERROR")<<";"<<result.time<<";"<<result.waitTime<<";"<<result.message<<std::endl;
+    });
+
+    mimmo_log->setPriority(bitpit::log::NORMAL);
+    (*mimmo_log)<<"Sweeping "<<designs.size()<<" designs on "<<nReplicas<<" workflow replicas... "<<std::endl;
+    mimmo_log->setPriority(bitpit::log::DEBUG);
+
+    auto sweepStart = std::chrono::steady_clock::now();
+    std::vector<mimmo::DesignSweep::DesignResult> outcome = sweep.run(designs.size());
+    double sweepTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - sweepStart).count();
+
+    std::size_t nFailed = 0;
+    double designsTime = 0.0;
+    for(const mimmo::DesignSweep::DesignResult & result : outcome){
+        if(!result.success) ++nFailed;
+        designsTime += result.time - result.waitTime;
+    }
+    mimmo_log->setPriority(bitpit::log::NORMAL);
+    (*mimmo_log)<<"Sweep DONE: "<<designs.size() - nFailed<<" designs succeeded, "<<nFailed<<" failed. Results written in "<<info.sweep<<".results"<<std::endl;
+    if(sweepTime > 0.0){
+        (*mimmo_log)<<"Sweep time: "<<sweepTime<<" s, speedup over the evaluation of one design at a time: "<<designsTime / sweepTime<<std::endl;
+    }
+    mimmo_log->setPriority(bitpit::log::DEBUG);
+}
+
 // =================================================================================== //
 //core of xml handler
 
@@ -335,6 +943,7 @@ void mimmocore(const InfoMimmoPP & info) {
         }
 
         mimmo::setExpertMode(info.expert);
+        mimmo::Profiler::instance().setEnabled(!info.profile.empty());
 
         //print resume args info.
         mimmo_log->setPriority(bitpit::log::NORMAL);
@@ -352,6 +961,10 @@ void mimmocore(const InfoMimmoPP & info) {
             (*mimmo_log)<< "debug results:      "<<yesno[int(info.optres)]<<std::endl;
             (*mimmo_log)<< "debug results path: "<<info.optres_path<<std::endl;
             (*mimmo_log)<< "expert mode:        "<<yesno[int(info.expert)]<<std::endl;
+            (*mimmo_log)<< "profiling report:   "<<(info.profile.empty() ? "no" : info.profile)<<std::endl;
+            (*mimmo_log)<< "server socket:      "<<(info.server.empty() ? "no" : info.server)<<std::endl;
+            (*mimmo_log)<< "sweep table:        "<<(info.sweep.empty() ? "no" : info.sweep)<<std::endl;
+            (*mimmo_log)<< "async output:       "<<yesno[int(info.asyncOutput)]<<std::endl;
             (*mimmo_log)<< " "<<std::endl;
             (*mimmo_log)<< " "<<std::endl;
         }
@@ -380,24 +993,37 @@ void mimmocore(const InfoMimmoPP & info) {
 		}
 		(*mimmo_log)<<" DONE."<<std::endl;
 
-		//Execute
-        (*mimmo_log)<<"Executing your workflow... "<<std::endl;
-        mimmo_log->setPriority(bitpit::log::DEBUG);
+		//in server mode blocks are re-executed only if their inputs changed
+		if(!info.server.empty()){
+			for(auto &val : chainMap){
+				val.second.setMemoizedExecution(true);
+			}
+		}
 
+		if(!info.sweep.empty()){
+			//sweep mode replaces the single execution of the workflow
+			runSweep(info, mapConn, factory);
+		}else{
+			//Execute
+			(*mimmo_log)<<"Executing your workflow... "<<std::endl;
+			mimmo_log->setPriority(bitpit::log::DEBUG);
 
-		for(auto &val : chainMap){
-			if (val.second.getNObjects() > 0){
-                mimmo_log->setPriority(bitpit::log::NORMAL);
-                (*mimmo_log)<<"...executing Chain w/ priority "<<val.first<<std::endl;
-                mimmo_log->setPriority(bitpit::log::DEBUG);
-                val.second.setPlotDebugResults(info.optres);
-                val.second.setOutputDebugResults(info.optres_path);
-				val.second.exec(true);
-			}
+			executeChains(chainMap, info);
+
+			mimmo_log->setPriority(bitpit::log::NORMAL);
+			(*mimmo_log)<<"Workflow DONE."<<std::endl;
+			mimmo_log->setPriority(bitpit::log::DEBUG);
+		}
+
+		if(!info.server.empty()){
+			serveRequests(info, mapConn, chainMap);
 		}
 
-		mimmo_log->setPriority(bitpit::log::NORMAL);
-		(*mimmo_log)<<"Workflow DONE."<<std::endl;
+        mimmo_log->setPriority(bitpit::log::NORMAL);
+        if(!info.profile.empty()){
+            mimmo::Profiler::instance().write(info.profile);
+            (*mimmo_log)<<"Profiling report written in "<<info.profile<<".json and "<<info.profile<<".trace.json"<<std::endl;
+        }
 		//Done, now exiting;
         mimmo_log->setPriority(bitpit::log::DEBUG);
 }
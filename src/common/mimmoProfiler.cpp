@@ -0,0 +1,352 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmoProfiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/resource.h>
+#endif
+
+#if MIMMO_ENABLE_MPI
+    #include <mpi.h>
+#endif
+
+namespace mimmo{
+
+/*!
+ * Escape a string for JSON output.
+ * \param[in] value input string
+ * \return escaped string, quotes included.
+ */
+static std::string jsonString(const std::string & value){
+    std::ostringstream out;
+    out << '"';
+    for(char c : value){
+        switch(c){
+        case '"':  out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n";  break;
+        case '\t': out << "\\t";  break;
+        case '\r': out << "\\r";  break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20){
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+            }else{
+                out << c;
+            }
+            break;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+/*!
+ * \return rank of the current process, 0 in serial runs.
+ */
+static int processRank(){
+    int rank = 0;
+#if MIMMO_ENABLE_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if(initialized) MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    return rank;
+}
+
+/*!
+ * \return number of processes, 1 in serial runs.
+ */
+static int processCount(){
+    int nprocs = 1;
+#if MIMMO_ENABLE_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if(initialized) MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+#endif
+    return nprocs;
+}
+
+/*!
+ * Default constructor. Profiler is disabled.
+ */
+Profiler::Profiler() : m_enabled(false), m_origin(std::chrono::steady_clock::now()){}
+
+/*!
+ * \return the process-wide profiler.
+ */
+Profiler & Profiler::instance(){
+    static Profiler profiler;
+    return profiler;
+}
+
+/*!
+ * Enable/disable the recording of events.
+ * \param[in] enabled true to enable recording.
+ */
+void Profiler::setEnabled(bool enabled){
+    m_enabled.store(enabled);
+}
+
+/*!
+ * \return true if recording of events is enabled.
+ */
+bool Profiler::isEnabled() const{
+    return m_enabled.load();
+}
+
+/*!
+ * Remove all the recorded events.
+ */
+void Profiler::clear(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.clear();
+}
+
+/*!
+ * \return current time in microseconds from the profiler creation.
+ */
+double Profiler::now() const{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_origin).count();
+}
+
+/*!
+ * \return index of the calling thread, assigned in order of first request.
+ */
+int Profiler::getThreadIndex(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_threads.find(std::this_thread::get_id());
+    if(it != m_threads.end()) return it->second;
+    int index = int(m_threads.size());
+    m_threads[std::this_thread::get_id()] = index;
+    return index;
+}
+
+/*!
+ * Record an event.
+ * \param[in] event event to be recorded
+ */
+void Profiler::addEvent(Event && event){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.push_back(std::move(event));
+}
+
+/*!
+ * \return copy of the recorded events.
+ */
+std::vector<Profiler::Event> Profiler::getEvents() const{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_events;
+}
+
+/*!
+ * Write a JSON report of the recorded events. The report contains the list of
+ * events and a summary with number of calls, total and maximum duration,
+ * and maximum peak memory increase of each (name, category) pair.
+ * \param[in] out output stream
+ */
+void Profiler::writeReport(std::ostream & out) const{
+    std::vector<Event> events = getEvents();
+
+    struct Summary{
+        long   calls = 0;
+        double total = 0.;
+        double max = 0.;
+        long   peakMemoryDelta = 0;
+    };
+    std::map<std::pair<std::string, std::string>, Summary> summaries;
+    for(const Event & event : events){
+        Summary & summary = summaries[std::make_pair(event.category, event.name)];
+        ++summary.calls;
+        summary.total += event.duration;
+        summary.max = std::max(summary.max, event.duration);
+        summary.peakMemoryDelta = std::max(summary.peakMemoryDelta, event.peakMemoryDelta);
+    }
+
+    out << std::setprecision(15);
+    out << "{" << std::endl;
+    out << "  \"rank\": " << processRank() << "," << std::endl;
+    out << "  \"time_unit\": \"us\"," << std::endl;
+    out << "  \"memory_unit\": \"kB\"," << std::endl;
+    out << "  \"events\": [";
+    for(std::size_t i = 0; i < events.size(); ++i){
+        const Event & event = events[i];
+        out << (i ? "," : "") << std::endl;
+        out << "    {\"name\": " << jsonString(event.name)
+            << ", \"category\": " << jsonString(event.category)
+            << ", \"thread\": " << event.thread
+            << ", \"start\": " << event.start
+            << ", \"duration\": " << event.duration
+            << ", \"peak_memory_delta\": " << event.peakMemoryDelta
+            << ", \"counters\": {";
+        for(std::size_t j = 0; j < event.counters.size(); ++j){
+            out << (j ? ", " : "") << jsonString(event.counters[j].first) << ": " << event.counters[j].second;
+        }
+        out << "}}";
+    }
+    out << std::endl << "  ]," << std::endl;
+    out << "  \"summary\": [";
+    bool first = true;
+    for(const auto & entry : summaries){
+        out << (first ? "" : ",") << std::endl;
+        first = false;
+        out << "    {\"name\": " << jsonString(entry.first.second)
+            << ", \"category\": " << jsonString(entry.first.first)
+            << ", \"calls\": " << entry.second.calls
+            << ", \"total\": " << entry.second.total
+            << ", \"max\": " << entry.second.max
+            << ", \"peak_memory_delta\": " << entry.second.peakMemoryDelta << "}";
+    }
+    out << std::endl << "  ]" << std::endl;
+    out << "}" << std::endl;
+}
+
+/*!
+ * Write the recorded events in the Chrome trace event format, as complete ("X")
+ * events. The process id is the MPI rank, the thread id the profiler thread index.
+ * \param[in] out output stream
+ */
+void Profiler::writeChromeTrace(std::ostream & out) const{
+    std::vector<Event> events = getEvents();
+    int rank = processRank();
+
+    out << std::setprecision(15);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for(std::size_t i = 0; i < events.size(); ++i){
+        const Event & event = events[i];
+        out << (i ? "," : "") << std::endl;
+        out << "  {\"name\": " << jsonString(event.name)
+            << ", \"cat\": " << jsonString(event.category)
+            << ", \"ph\": \"X\", \"ts\": " << event.start
+            << ", \"dur\": " << event.duration
+            << ", \"pid\": " << rank
+            << ", \"tid\": " << event.thread
+            << ", \"args\": {\"peak_memory_delta_kB\": " << event.peakMemoryDelta;
+        for(const auto & counter : event.counters){
+            out << ", " << jsonString(counter.first) << ": " << counter.second;
+        }
+        out << "}}";
+    }
+    out << std::endl << "]}" << std::endl;
+}
+
+/*!
+ * Write the JSON report in <prefix>.json and the Chrome trace in <prefix>.trace.json.
+ * In MPI runs with more than one process the rank is appended to the prefix.
+ * \param[in] prefix path prefix of the output files
+ */
+void Profiler::write(const std::string & prefix) const{
+    std::string base = prefix;
+    if(processCount() > 1) base += "." + std::to_string(processRank());
+
+    std::ofstream report(base + ".json");
+    if(!report.is_open()) throw std::runtime_error("Profiler: cannot open " + base + ".json");
+    writeReport(report);
+    report.close();
+
+    std::ofstream trace(base + ".trace.json");
+    if(!trace.is_open()) throw std::runtime_error("Profiler: cannot open " + base + ".trace.json");
+    writeChromeTrace(trace);
+    trace.close();
+}
+
+/*!
+ * \return peak resident memory of the process in kB, 0 if not available on the platform.
+ */
+long Profiler::getPeakMemory(){
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return long(usage.ru_maxrss / 1024);
+#else
+    return long(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
+
+/*!
+ * Constructor. The event starts if the Profiler is enabled.
+ * \param[in] name name of the event
+ * \param[in] category category of the event
+ */
+ProfileScope::ProfileScope(const std::string & name, const std::string & category){
+    Profiler & profiler = Profiler::instance();
+    m_active = profiler.isEnabled();
+    m_peakMemory = 0;
+    if(!m_active) return;
+    m_event.name = name;
+    m_event.category = category;
+    m_event.thread = profiler.getThreadIndex();
+    m_event.peakMemoryDelta = 0;
+    m_event.duration = 0.;
+    m_peakMemory = Profiler::getPeakMemory();
+    m_event.start = profiler.now();
+}
+
+/*!
+ * Destructor. It records the event, if not yet recorded.
+ */
+ProfileScope::~ProfileScope(){
+    stop();
+}
+
+/*!
+ * \return true if the scope is recording an event.
+ */
+bool ProfileScope::isActive() const{
+    return m_active;
+}
+
+/*!
+ * Attach a named counter to the event, e.g. the number of processed elements.
+ * \param[in] name name of the counter
+ * \param[in] value value of the counter
+ */
+void ProfileScope::addCounter(const std::string & name, long value){
+    if(!m_active) return;
+    m_event.counters.emplace_back(name, value);
+}
+
+/*!
+ * Stop the event and record it in the Profiler. Further calls have no effect.
+ */
+void ProfileScope::stop(){
+    if(!m_active) return;
+    m_active = false;
+    Profiler & profiler = Profiler::instance();
+    m_event.duration = profiler.now() - m_event.start;
+    m_event.peakMemoryDelta = Profiler::getPeakMemory() - m_peakMemory;
+    profiler.addEvent(std::move(m_event));
+}
+
+}
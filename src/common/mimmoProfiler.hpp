@@ -0,0 +1,137 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#ifndef __MIMMOPROFILER_HPP__
+#define __MIMMOPROFILER_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mimmo{
+
+/*!
+ * \class Profiler
+ * \ingroup common_Utils
+ * \brief Process-wide collector of timing, memory and throughput events.
+ *
+ * The profiler is disabled by default. When enabled, every executable block records
+ * an event for its whole execution and one event for each execution phase (execute,
+ * transfer of output ports, plot of optional results, apply), together with the
+ * increase of the process peak resident memory and the number of geometry elements
+ * handled. Blocks can open finer named scopes with the RAII class ProfileScope.
+ *
+ * Collected events can be written as a JSON report with a per-name summary
+ * (writeReport) or in the Chrome trace event format (writeChromeTrace), readable by
+ * chrome://tracing or Perfetto. Event recording is thread safe.
+ */
+class Profiler{
+
+public:
+    /*!
+     * \brief Single profiled event.
+     */
+    struct Event{
+        std::string name;           /**< Name of the event.*/
+        std::string category;       /**< Category of the event (block, execute, transfer, plot, apply, scope).*/
+        int         thread;         /**< Index of the thread recording the event.*/
+        double      start;          /**< Start time in microseconds from the profiler creation.*/
+        double      duration;       /**< Duration in microseconds.*/
+        long        peakMemoryDelta;/**< Increase of the peak resident memory in kB.*/
+        std::vector<std::pair<std::string, long>> counters; /**< Named counters (e.g. processed elements).*/
+    };
+
+    static Profiler &   instance();
+
+    void                setEnabled(bool enabled);
+    bool                isEnabled() const;
+    void                clear();
+
+    double              now() const;
+    int                 getThreadIndex();
+    void                addEvent(Event && event);
+    std::vector<Event>  getEvents() const;
+
+    void                writeReport(std::ostream & out) const;
+    void                writeChromeTrace(std::ostream & out) const;
+    void                write(const std::string & prefix) const;
+
+    static long         getPeakMemory();
+
+private:
+    Profiler();
+    Profiler(const Profiler &) = delete;
+    Profiler & operator=(const Profiler &) = delete;
+
+    std::atomic<bool>                           m_enabled;  /**< Recording status.*/
+    std::chrono::steady_clock::time_point       m_origin;   /**< Origin of the event times.*/
+    mutable std::mutex                          m_mutex;    /**< Lock of events and thread indices.*/
+    std::vector<Event>                          m_events;   /**< Recorded events.*/
+    std::unordered_map<std::thread::id, int>    m_threads;  /**< Index of each recording thread.*/
+};
+
+/*!
+ * \class ProfileScope
+ * \ingroup common_Utils
+ * \brief RAII timer recording an event of the Profiler.
+ *
+ * The event starts at construction and is recorded at destruction (or at the first
+ * call of stop()). If the Profiler is disabled at construction, the scope does nothing.
+ * Example, inside a block execute():
+ * \code
+ *  {
+ *      mimmo::ProfileScope scope(m_name + "::buildOperator");
+ *      ...
+ *      scope.addCounter("rows", nrows);
+ *  }
+ * \endcode
+ */
+class ProfileScope{
+
+public:
+    explicit ProfileScope(const std::string & name, const std::string & category = "scope");
+    ~ProfileScope();
+
+    bool    isActive() const;
+    void    addCounter(const std::string & name, long value);
+    void    stop();
+
+private:
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope & operator=(const ProfileScope &) = delete;
+
+    bool                m_active;       /**< True if the event has still to be recorded.*/
+    long                m_peakMemory;   /**< Peak resident memory at construction.*/
+    Profiler::Event     m_event;        /**< Event under recording.*/
+};
+
+}
+
+#endif /* __MIMMOPROFILER_HPP__ */
@@ -0,0 +1,358 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmoTextParser.hpp"
+#include <fstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MIMMO_TEXT_MMAP 1
+#else
+#define MIMMO_TEXT_MMAP 0
+#endif
+
+namespace mimmo{
+
+namespace text{
+
+/*!
+ * Default constructor.
+ */
+FileBuffer::FileBuffer() : m_data(nullptr), m_size(0), m_open(false), m_mapped(false){}
+
+/*!
+ * Constructor. It opens the file.
+ * \param[in] filename path of the file
+ */
+FileBuffer::FileBuffer(const std::string & filename) : FileBuffer(){
+    open(filename);
+}
+
+/*!
+ * Destructor.
+ */
+FileBuffer::~FileBuffer(){
+    close();
+}
+
+/*!
+ * Open a file and make its contents available. A previously open file is closed.
+ * \param[in] filename path of the file
+ * \return true if the file is open.
+ */
+bool
+FileBuffer::open(const std::string & filename){
+
+    close();
+
+#if MIMMO_TEXT_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    struct stat info;
+    if(fstat(fd, &info) == 0){
+        m_size = std::size_t(info.st_size);
+        if(m_size == 0){
+            m_open = true;
+        }else{
+            void * mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapped != MAP_FAILED){
+                madvise(mapped, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char *>(mapped);
+                m_mapped = true;
+                m_open = true;
+            }
+        }
+    }
+    ::close(fd);
+    if(m_open) return true;
+    m_size = 0;
+#endif
+
+    // fallback, read the file at once
+    std::ifstream in(filename, std::ios::binary);
+    if(!in.is_open()) return false;
+    in.seekg(0, std::ios::end);
+    m_storage.resize(std::size_t(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    in.read(m_storage.data(), std::streamsize(m_storage.size()));
+    m_data = m_storage.data();
+    m_size = m_storage.size();
+    m_open = true;
+    return true;
+}
+
+/*!
+ * Close the file and release its contents.
+ */
+void
+FileBuffer::close(){
+#if MIMMO_TEXT_MMAP
+    if(m_mapped){
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+#endif
+    std::vector<char>().swap(m_storage);
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+    m_mapped = false;
+}
+
+/*!
+ * \return true if a file is open.
+ */
+bool
+FileBuffer::isOpen() const{
+    return m_open;
+}
+
+/*!
+ * \return pointer to the first character of the file.
+ */
+const char *
+FileBuffer::begin() const{
+    return m_data;
+}
+
+/*!
+ * \return pointer past the last character of the file.
+ */
+const char *
+FileBuffer::end() const{
+    return m_data + m_size;
+}
+
+/*!
+ * \return size of the file in bytes.
+ */
+std::size_t
+FileBuffer::size() const{
+    return m_size;
+}
+
+/*!
+ * Constructor.
+ * \param[in] begin first character of the range
+ * \param[in] end past-the-end character of the range
+ */
+MemoryStreamBuffer::MemoryStreamBuffer(const char * begin, const char * end){
+    char * first = const_cast<char *>(begin);
+    setg(first, first, const_cast<char *>(end));
+}
+
+/*!
+ * Move the read position.
+ * \param[in] off offset
+ * \param[in] dir reference position of the offset
+ * \param[in] which open mode; only input is supported
+ * \return new position, or -1 if the position is invalid.
+ */
+MemoryStreamBuffer::pos_type
+MemoryStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which){
+    if(!(which & std::ios_base::in)) return pos_type(off_type(-1));
+    off_type base = 0;
+    if(dir == std::ios_base::cur) base = off_type(gptr() - eback());
+    else if(dir == std::ios_base::end) base = off_type(egptr() - eback());
+    off_type position = base + off;
+    if(position < 0 || position > off_type(egptr() - eback())) return pos_type(off_type(-1));
+    setg(eback(), eback() + position, egptr());
+    return pos_type(position);
+}
+
+/*!
+ * Move the read position.
+ * \param[in] pos absolute position
+ * \param[in] which open mode; only input is supported
+ * \return new position, or -1 if the position is invalid.
+ */
+MemoryStreamBuffer::pos_type
+MemoryStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which){
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+/*!
+ * Split a text in chunks of similar size, aligned to the beginning of a line.
+ * \param[in] begin begin of the text
+ * \param[in] end end of the text
+ * \param[in] nChunks requested number of chunks
+ * \return bounds of the chunks; chunk i spans [bounds[i], bounds[i+1]). Empty chunks are removed.
+ */
+std::vector<const char *>
+splitLines(const char * begin, const char * end, std::size_t nChunks){
+    std::vector<const char *> bounds(1, begin);
+    nChunks = std::max(std::size_t(1), nChunks);
+    std::size_t size = std::size_t(end - begin);
+    for(std::size_t i = 1; i < nChunks; ++i){
+        const char * bound = begin + size / nChunks * i;
+        // a line belongs to the chunk containing its first character
+        if(bound > bounds.back()) bound = nextLine(bound - 1, end);
+        if(bound > bounds.back() && bound < end) bounds.push_back(bound);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+/*!
+ * \param[in] cursor position in the text
+ * \param[in] end end of the text
+ * \return position of the end of the line containing the cursor, i.e. of the
+ * newline character or end.
+ */
+const char *
+lineEnd(const char * cursor, const char * end){
+    const void * newline = std::memchr(cursor, '\n', std::size_t(end - cursor));
+    return newline ? static_cast<const char *>(newline) : end;
+}
+
+/*!
+ * \param[in] cursor position in the text
+ * \param[in] end end of the text
+ * \return position of the beginning of the line following the cursor, or end.
+ */
+const char *
+nextLine(const char * cursor, const char * end){
+    const char * newline = lineEnd(cursor, end);
+    return newline == end ? end : newline + 1;
+}
+
+/*!
+ * Move the cursor past blanks, i.e. spaces, tabs and carriage returns.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ */
+void
+skipBlanks(const char *& cursor, const char * end){
+    while(cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\v' || *cursor == '\f')) ++cursor;
+}
+
+/*!
+ * Extract the next blank-separated token. The cursor is moved past the token.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text; tokens never contain newlines
+ * \param[out] tokenBegin begin of the token
+ * \param[out] tokenEnd end of the token
+ * \return false if no token is found before the end of the line.
+ */
+bool
+nextToken(const char *& cursor, const char * end, const char *& tokenBegin, const char *& tokenEnd){
+    skipBlanks(cursor, end);
+    tokenBegin = cursor;
+    while(cursor < end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n' && *cursor != '\v' && *cursor != '\f') ++cursor;
+    tokenEnd = cursor;
+    return tokenEnd > tokenBegin;
+}
+
+/*!
+ * \param[in] tokenBegin begin of the token
+ * \param[in] tokenEnd end of the token
+ * \param[in] word null-terminated word
+ * \return true if the token is equal to the word.
+ */
+bool
+equals(const char * tokenBegin, const char * tokenEnd, const char * word){
+    std::size_t length = std::strlen(word);
+    return std::size_t(tokenEnd - tokenBegin) == length && std::memcmp(tokenBegin, word, length) == 0;
+}
+
+/*!
+ * Skip blanks and a delimiter character, if present.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ * \param[in] delimiter delimiter character
+ * \return true if the delimiter is found.
+ */
+bool
+skipDelimiter(const char *& cursor, const char * end, char delimiter){
+    skipBlanks(cursor, end);
+    if(cursor < end && *cursor == delimiter){
+        ++cursor;
+        return true;
+    }
+    return false;
+}
+
+/*!
+ * Parse a floating point value, skipping leading blanks. The cursor is moved past the value.
+ * The accepted syntax is the one of std::strtod.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ * \param[out] value parsed value, unchanged if parsing fails
+ * \return true if a value is parsed.
+ */
+bool
+parseReal(const char *& cursor, const char * end, double & value){
+    skipBlanks(cursor, end);
+    // copy the candidate characters, the text is not null-terminated
+    char buffer[64];
+    std::size_t length = 0;
+    const char * current = cursor;
+    while(current < end && length < sizeof(buffer) - 1){
+        char c = *current;
+        if(c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';') break;
+        buffer[length++] = c;
+        ++current;
+    }
+    if(length == 0) return false;
+    buffer[length] = '\0';
+    char * parsedEnd;
+    double result = std::strtod(buffer, &parsedEnd);
+    if(parsedEnd == buffer) return false;
+    value = result;
+    cursor += (parsedEnd - buffer);
+    return true;
+}
+
+/*!
+ * Parse a decimal integer value, skipping leading blanks. The cursor is moved past the value.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ * \param[out] value parsed value, unchanged if parsing fails
+ * \return true if a value is parsed.
+ */
+bool
+parseInteger(const char *& cursor, const char * end, long long & value){
+    skipBlanks(cursor, end);
+    const char * current = cursor;
+    bool negative = false;
+    if(current < end && (*current == '-' || *current == '+')){
+        negative = (*current == '-');
+        ++current;
+    }
+    const char * digits = current;
+    unsigned long long result = 0;
+    while(current < end && *current >= '0' && *current <= '9'){
+        result = result * 10 + static_cast<unsigned long long>(*current - '0');
+        ++current;
+    }
+    if(current == digits) return false;
+    value = negative ? -static_cast<long long>(result) : static_cast<long long>(result);
+    cursor = current;
+    return true;
+}
+
+}
+
+}
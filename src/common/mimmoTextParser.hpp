@@ -0,0 +1,181 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#ifndef __MIMMOTEXTPARSER_HPP__
+#define __MIMMOTEXTPARSER_HPP__
+
+#include "mimmoThreads.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mimmo{
+
+/*!
+ * \ingroup common_Utils
+ * \brief Utilities for the fast ingestion of ascii files.
+ *
+ * A file is loaded at once in memory (memory-mapped where the platform allows it)
+ * and split in chunks aligned to the beginning of a line. The chunks are parsed
+ * concurrently by the threads available to mimmo (see threads::getNumberOfThreads),
+ * each one filling its own partial result; partial results are returned in file order.
+ *
+ * Numbers are parsed in place, without building intermediate strings or streams.
+ */
+namespace text{
+
+/*!
+ * \class FileBuffer
+ * \ingroup common_Utils
+ * \brief Read-only contents of a file, memory-mapped on POSIX systems, read at once otherwise.
+ */
+class FileBuffer{
+
+public:
+    FileBuffer();
+    explicit FileBuffer(const std::string & filename);
+    ~FileBuffer();
+
+    bool            open(const std::string & filename);
+    void            close();
+    bool            isOpen() const;
+    const char *    begin() const;
+    const char *    end() const;
+    std::size_t     size() const;
+
+private:
+    const char *        m_data;     /**< Pointer to the file contents.*/
+    std::size_t         m_size;     /**< Size of the file in bytes.*/
+    bool                m_open;     /**< True if a file is open.*/
+    bool                m_mapped;   /**< True if the contents are memory-mapped.*/
+    std::vector<char>   m_storage;  /**< Storage of the contents when not memory-mapped.*/
+
+    FileBuffer(const FileBuffer &) = delete;
+    FileBuffer & operator=(const FileBuffer &) = delete;
+};
+
+/*!
+ * \class MemoryStreamBuffer
+ * \ingroup common_Utils
+ * \brief Read-only stream buffer over a range of characters, allowing to use
+ * std::istream based readers on a memory chunk without copying it.
+ */
+class MemoryStreamBuffer : public std::streambuf{
+
+public:
+    MemoryStreamBuffer(const char * begin, const char * end);
+
+protected:
+    pos_type    seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+    pos_type    seekpos(pos_type pos, std::ios_base::openmode which) override;
+};
+
+std::vector<const char *>   splitLines(const char * begin, const char * end, std::size_t nChunks);
+
+const char *    lineEnd(const char * cursor, const char * end);
+const char *    nextLine(const char * cursor, const char * end);
+void            skipBlanks(const char *& cursor, const char * end);
+bool            nextToken(const char *& cursor, const char * end, const char *& tokenBegin, const char *& tokenEnd);
+bool            equals(const char * tokenBegin, const char * tokenEnd, const char * word);
+bool            skipDelimiter(const char *& cursor, const char * end, char delimiter);
+bool            parseReal(const char *& cursor, const char * end, double & value);
+bool            parseInteger(const char *& cursor, const char * end, long long & value);
+
+/*!
+ * Parse an integer value, skipping leading blanks. The cursor is moved past the value.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ * \param[out] value parsed value, unchanged if parsing fails
+ * \return true if a value is parsed.
+ */
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value, bool>::type
+parse(const char *& cursor, const char * end, T & value){
+    long long result;
+    if(!parseInteger(cursor, end, result)) return false;
+    value = static_cast<T>(result);
+    return true;
+}
+
+/*!
+ * Parse a floating point value, skipping leading blanks. The cursor is moved past the value.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ * \param[out] value parsed value, unchanged if parsing fails
+ * \return true if a value is parsed.
+ */
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+parse(const char *& cursor, const char * end, T & value){
+    double result;
+    if(!parseReal(cursor, end, result)) return false;
+    value = static_cast<T>(result);
+    return true;
+}
+
+/*!
+ * Trait marking the types parsable with the parse functions.
+ */
+template<typename T>
+struct isParsable : std::integral_constant<bool, std::is_arithmetic<T>::value>{};
+
+/*!
+ * Split the text in line-aligned chunks and call a function on each chunk, concurrently.
+ * The function is called as f(chunkBegin, chunkEnd, result), where result is the partial
+ * result of the chunk, default constructed. Each line belongs to the chunk containing its
+ * first character; the chunk is allowed to read the text beyond its end, e.g. to complete
+ * a record spanning several lines. Texts smaller than minChunkSize are parsed in a
+ * single chunk by the calling thread.
+ * \param[in] begin begin of the text
+ * \param[in] end end of the text
+ * \param[in] f function parsing a chunk
+ * \param[in] minChunkSize minimum size in bytes of each chunk
+ * \return partial results of the chunks, in text order.
+ */
+template<typename Result, typename Function>
+std::vector<Result> parseChunks(const char * begin, const char * end, Function && f, std::size_t minChunkSize = 1048576){
+    std::size_t size = std::size_t(end - begin);
+    std::size_t nChunks = std::min(threads::getAvailableThreads(), std::max(std::size_t(1), size / std::max(std::size_t(1), minChunkSize)));
+    std::vector<const char *> bounds = splitLines(begin, end, nChunks);
+    nChunks = bounds.size() - 1;
+
+    std::vector<Result> results(nChunks);
+    threads::parallelFor(0, nChunks, [&f, &results, &bounds](std::size_t chunkBegin, std::size_t chunkEnd){
+        for(std::size_t i = chunkBegin; i < chunkEnd; ++i){
+            f(bounds[i], bounds[i+1], results[i]);
+        }
+    }, 1);
+    return results;
+}
+
+}
+
+}
+
+#endif /* __MIMMOTEXTPARSER_HPP__ */
@@ -0,0 +1,480 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmoThreads.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+namespace mimmo{
+
+namespace threads{
+
+/*!
+ * Evaluate the default number of threads.
+ * \return value of MIMMO_NUM_THREADS if defined and positive, otherwise the
+ * hardware concurrency (serial builds) or 1 (MPI builds).
+ */
+static std::size_t defaultNumberOfThreads(){
+    const char * env = std::getenv("MIMMO_NUM_THREADS");
+    if(env){
+        try{
+            long value = std::stol(std::string(env));
+            if(value > 0) return std::size_t(value);
+        }catch(...){
+        }
+    }
+#if MIMMO_ENABLE_MPI
+    return 1;
+#else
+    return std::max(std::size_t(1), std::size_t(std::thread::hardware_concurrency()));
+#endif
+}
+
+/*!
+ * Process-wide number of threads.
+ */
+static std::atomic<std::size_t> & numberOfThreads(){
+    static std::atomic<std::size_t> nThreads(defaultNumberOfThreads());
+    return nThreads;
+}
+
+/*!
+ * \return number of threads used by mimmo internal parallel kernels.
+ */
+std::size_t getNumberOfThreads(){
+    return numberOfThreads().load();
+}
+
+/*!
+ * Set the number of threads used by mimmo internal parallel kernels.
+ * \param[in] nThreads number of threads; 0 restores the default value.
+ */
+void setNumberOfThreads(std::size_t nThreads){
+    if(nThreads == 0) nThreads = defaultNumberOfThreads();
+    numberOfThreads().store(nThreads);
+}
+
+/*!
+ * Number of threads available to the current thread, 0 if not limited by a ThreadBudget.
+ */
+static thread_local std::size_t threadBudget = 0;
+
+/*!
+ * \return number of threads available to the parallel kernels called by the current
+ * thread: getNumberOfThreads(), reduced by the ThreadBudget scopes enclosing the call.
+ */
+std::size_t getAvailableThreads(){
+    std::size_t nThreads = getNumberOfThreads();
+    return (threadBudget > 0) ? std::min(threadBudget, nThreads) : nThreads;
+}
+
+/*!
+ * Constructor. It limits the threads available to the current thread until destruction.
+ * \param[in] nThreads number of available threads; 0 is treated as 1.
+ */
+ThreadBudget::ThreadBudget(std::size_t nThreads) : m_previous(threadBudget){
+    threadBudget = std::max(std::size_t(1), nThreads);
+}
+
+/*!
+ * Destructor. It restores the previous budget of the current thread.
+ */
+ThreadBudget::~ThreadBudget(){
+    threadBudget = m_previous;
+}
+
+/*!
+ * Pool owning the current thread, if any, and index of its queue.
+ */
+static thread_local const WorkStealingPool * currentPool = nullptr;
+static thread_local std::size_t currentQueue = 0;
+
+/*!
+ * Constructor. It starts the worker threads.
+ * \param[in] nWorkers number of worker threads; 0 is treated as 1.
+ */
+WorkStealingPool::WorkStealingPool(std::size_t nWorkers)
+    : m_queued(0), m_pending(0), m_nextQueue(0), m_stop(false)
+{
+    nWorkers = std::max(std::size_t(1), nWorkers);
+    m_queues.reserve(nWorkers);
+    for(std::size_t i = 0; i < nWorkers; ++i){
+        m_queues.emplace_back(new WorkerQueue());
+    }
+    m_workers.reserve(nWorkers);
+    for(std::size_t i = 0; i < nWorkers; ++i){
+        m_workers.emplace_back(&WorkStealingPool::run, this, i);
+    }
+}
+
+/*!
+ * Destructor. Tasks still queued are executed before the workers are joined.
+ */
+WorkStealingPool::~WorkStealingPool(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_taskReady.notify_all();
+    for(std::thread & worker : m_workers){
+        worker.join();
+    }
+}
+
+/*!
+ * \return number of worker threads of the pool.
+ */
+std::size_t WorkStealingPool::getNumberOfWorkers() const{
+    return m_workers.size();
+}
+
+/*!
+ * Submit a task to the pool.
+ * \param[in] task task to be executed.
+ */
+void WorkStealingPool::submit(Task task){
+    std::size_t index;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(currentPool == this){
+            index = currentQueue;
+        }else{
+            index = m_nextQueue;
+            m_nextQueue = (m_nextQueue + 1) % m_queues.size();
+        }
+        ++m_pending;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_queued;
+    }
+    m_taskReady.notify_one();
+}
+
+/*!
+ * Block until all the submitted tasks are completed. If a task threw an
+ * exception, the first one is rethrown here.
+ */
+void WorkStealingPool::wait(){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_allDone.wait(lock, [this](){ return m_pending == 0; });
+    if(m_error){
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+/*!
+ * Take a task, from the back of the own queue or, failing that, from the
+ * front of the other queues.
+ * \param[in] index index of the worker queue
+ * \param[out] task extracted task
+ * \return true if a task was extracted.
+ */
+bool WorkStealingPool::popTask(std::size_t index, Task & task){
+    std::size_t nQueues = m_queues.size();
+    for(std::size_t i = 0; i < nQueues; ++i){
+        WorkerQueue & queue = *m_queues[(index + i) % nQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(queue.tasks.empty()) continue;
+        if(i == 0){
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }else{
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+/*!
+ * Worker loop.
+ * \param[in] index index of the worker queue
+ */
+void WorkStealingPool::run(std::size_t index){
+    currentPool = this;
+    currentQueue = index;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskReady.wait(lock, [this](){ return m_stop || m_queued > 0; });
+            if(m_queued == 0) return;
+            --m_queued;
+        }
+        Task task;
+        // The counter above reserved a task already pushed in one of the
+        // queues, so the loop ends as soon as the queue locks are released.
+        while(!popTask(index, task)){
+            std::this_thread::yield();
+        }
+        try{
+            task();
+        }catch(...){
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_error) m_error = std::current_exception();
+        }
+        bool done;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            done = (--m_pending == 0);
+        }
+        if(done) m_allDone.notify_all();
+    }
+}
+
+/*!
+ * Constructor. The mutex is not owned.
+ */
+SharedMutex::SharedMutex() : m_nShared(0), m_exclusive(false){}
+
+/*!
+ * Acquire the exclusive ownership, waiting for the release of any other owner.
+ */
+void
+SharedMutex::lock(){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_released.wait(lock, [this](){ return !m_exclusive && m_nShared == 0; });
+    m_exclusive = true;
+}
+
+/*!
+ * Release the exclusive ownership.
+ */
+void
+SharedMutex::unlock(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exclusive = false;
+    }
+    m_released.notify_all();
+}
+
+/*!
+ * Acquire a shared ownership, waiting for the release of an exclusive owner.
+ */
+void
+SharedMutex::lock_shared(){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_released.wait(lock, [this](){ return !m_exclusive; });
+    ++m_nShared;
+}
+
+/*!
+ * Release a shared ownership.
+ */
+void
+SharedMutex::unlock_shared(){
+    bool released;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        released = (--m_nShared == 0);
+    }
+    if(released) m_released.notify_all();
+}
+
+/*!
+ * Constructor.
+ * \param[in] target target stream buffer
+ */
+SynchronizedStreamBuffer::SynchronizedStreamBuffer(std::streambuf * target) : m_target(target){}
+
+/*!
+ * Destructor. The lines not yet synchronized are forwarded to the target buffer.
+ */
+SynchronizedStreamBuffer::~SynchronizedStreamBuffer(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(auto & line : m_lines){
+        if(!line.second.empty()) m_target->sputn(line.second.data(), line.second.size());
+    }
+    m_target->pubsync();
+}
+
+/*!
+ * Append a character to the line of the calling thread.
+ * \param[in] ch character
+ * \return ch, or a value different from eof if ch is eof.
+ */
+SynchronizedStreamBuffer::int_type SynchronizedStreamBuffer::overflow(int_type ch){
+    if(!traits_type::eq_int_type(ch, traits_type::eof())){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lines[std::this_thread::get_id()].push_back(traits_type::to_char_type(ch));
+    }
+    return traits_type::not_eof(ch);
+}
+
+/*!
+ * Append a sequence of characters to the line of the calling thread.
+ * \param[in] s characters
+ * \param[in] n number of characters
+ * \return number of characters written.
+ */
+std::streamsize SynchronizedStreamBuffer::xsputn(const char * s, std::streamsize n){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lines[std::this_thread::get_id()].append(s, n);
+    return n;
+}
+
+/*!
+ * Forward the line of the calling thread to the target buffer.
+ * \return result of the synchronization of the target buffer.
+ */
+int SynchronizedStreamBuffer::sync(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string & line = m_lines[std::this_thread::get_id()];
+    if(!line.empty()){
+        m_target->sputn(line.data(), line.size());
+        line.clear();
+    }
+    return m_target->pubsync();
+}
+
+/*!
+ * \return the process-wide asynchronous writer.
+ */
+AsyncWriter & AsyncWriter::instance(){
+    static AsyncWriter writer;
+    return writer;
+}
+
+/*!
+ * Constructor. By default at most 2 tasks are pending: one in execution, one waiting.
+ */
+AsyncWriter::AsyncWriter() : m_pending(0), m_maxPending(2), m_stop(false){}
+
+/*!
+ * Destructor. Tasks still pending are executed before the background thread is joined.
+ */
+AsyncWriter::~AsyncWriter(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_changed.notify_all();
+    if(m_thread.joinable()) m_thread.join();
+}
+
+/*!
+ * Submit a task to the background thread. If the maximum number of pending tasks is
+ * reached, the call blocks until a task is completed. Tasks submitted by the background
+ * thread itself are executed immediately.
+ * \param[in] task task to be executed; it must own the data it writes.
+ */
+void AsyncWriter::submit(Task task){
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if(std::this_thread::get_id() == m_thread.get_id()){
+            lock.unlock();
+            task();
+            return;
+        }
+        if(!m_thread.joinable()) m_thread = std::thread(&AsyncWriter::run, this);
+        m_changed.wait(lock, [this](){ return m_pending < m_maxPending; });
+        m_tasks.push_back(std::move(task));
+        ++m_pending;
+    }
+    m_changed.notify_all();
+}
+
+/*!
+ * Block until all the submitted tasks are completed. If a task threw an exception,
+ * the first one is rethrown here.
+ */
+void AsyncWriter::wait(){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this](){ return m_pending == 0; });
+    if(m_error){
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+/*!
+ * \return number of tasks submitted and not yet completed.
+ */
+std::size_t AsyncWriter::getNumberOfPending(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending;
+}
+
+/*!
+ * \return maximum number of pending tasks.
+ */
+std::size_t AsyncWriter::getMaxPending(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxPending;
+}
+
+/*!
+ * Set the maximum number of pending tasks, i.e. of data snapshots alive at the same time.
+ * \param[in] maxPending maximum number of pending tasks; 0 is treated as 1.
+ */
+void AsyncWriter::setMaxPending(std::size_t maxPending){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maxPending = std::max(std::size_t(1), maxPending);
+    }
+    m_changed.notify_all();
+}
+
+/*!
+ * Background thread loop.
+ */
+void AsyncWriter::run(){
+    while(true){
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_changed.wait(lock, [this](){ return m_stop || !m_tasks.empty(); });
+            if(m_tasks.empty()) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        try{
+            task();
+        }catch(...){
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_error) m_error = std::current_exception();
+        }
+        // release the snapshot before signaling completion
+        task = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_pending;
+        }
+        m_changed.notify_all();
+    }
+}
+
+}
+
+}
@@ -0,0 +1,295 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#ifndef __MIMMOTHREADS_HPP__
+#define __MIMMOTHREADS_HPP__
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <future>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+
+namespace mimmo{
+
+/*!
+ * \ingroup common_Utils
+ * \brief Utilities for shared-memory multithreading inside mimmo.
+ *
+ * The number of worker threads used by mimmo internal parallel kernels is a
+ * process-wide setting. By default it is read from the environment variable
+ * MIMMO_NUM_THREADS; if the variable is not set, the hardware concurrency is
+ * used in serial builds and a single thread is used in MPI builds, to avoid
+ * oversubscribing nodes hosting several ranks.
+ */
+namespace threads{
+
+std::size_t getNumberOfThreads();
+void        setNumberOfThreads(std::size_t nThreads);
+std::size_t getAvailableThreads();
+
+/*!
+ * \class ThreadBudget
+ * \ingroup common_Utils
+ * \brief Scoped limit of the number of threads available to the calling thread.
+ *
+ * Nested parallel kernels share the threads of the enclosing one: parallelFor
+ * runs each chunk with an even share of the threads available to its caller, so
+ * that the threads running at once never exceed getNumberOfThreads().
+ */
+class ThreadBudget{
+
+public:
+    explicit ThreadBudget(std::size_t nThreads);
+    ~ThreadBudget();
+
+private:
+    std::size_t m_previous; /**< Budget of the thread before the scope.*/
+
+    ThreadBudget(const ThreadBudget &) = delete;
+    ThreadBudget & operator=(const ThreadBudget &) = delete;
+};
+
+/*!
+ * Execute a function on the range [begin, end) splitting it in contiguous
+ * chunks, each one processed by a different thread. The function is called
+ * as f(chunkBegin, chunkEnd). The calling thread processes the first chunk.
+ * If the range is smaller than minChunk or a single thread is available,
+ * f is called once on the whole range by the calling thread.
+ * The threads available to the caller, see getAvailableThreads, are shared
+ * evenly among the chunks, so parallel kernels nested in f do not oversubscribe.
+ * \param[in] begin first index of the range
+ * \param[in] end   past-the-end index of the range
+ * \param[in] f     function to be called on each chunk
+ * \param[in] minChunk minimum number of indices for each chunk
+ */
+template<typename Function>
+void parallelFor(std::size_t begin, std::size_t end, Function && f, std::size_t minChunk = 1024){
+    if(end <= begin) return;
+    std::size_t size = end - begin;
+    std::size_t nThreads = getAvailableThreads();
+    std::size_t nChunks = std::min(nThreads, std::max(std::size_t(1), size / std::max(std::size_t(1), minChunk)));
+    if(nChunks < 2){
+        f(begin, end);
+        return;
+    }
+    std::size_t chunkSize = size / nChunks;
+    std::size_t remainder = size % nChunks;
+    std::size_t budget = nThreads / nChunks;
+
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(nChunks - 1);
+    std::size_t firstEnd = begin + chunkSize + (remainder > 0 ? 1 : 0);
+    std::size_t chunkBegin = firstEnd;
+    for(std::size_t i = 1; i < nChunks; ++i){
+        std::size_t chunkEnd = chunkBegin + chunkSize + (i < remainder ? 1 : 0);
+        tasks.push_back(std::async(std::launch::async, [&f, chunkBegin, chunkEnd, budget](){
+            ThreadBudget scope(budget);
+            f(chunkBegin, chunkEnd);
+        }));
+        chunkBegin = chunkEnd;
+    }
+    {
+        ThreadBudget scope(budget);
+        f(begin, firstEnd);
+    }
+    for(auto & task : tasks){
+        task.get();
+    }
+}
+
+/*!
+ * \class WorkStealingPool
+ * \ingroup common_Utils
+ * \brief Fixed-size thread pool with per-worker task queues and work stealing.
+ *
+ * Each worker owns a double-ended queue of tasks. A task submitted from inside
+ * a worker is pushed on the back of the worker own queue and popped back in LIFO
+ * order, preserving cache locality of dependent tasks; tasks submitted from
+ * outside the pool are distributed round-robin. An idle worker steals the
+ * oldest task from the front of the other queues before going to sleep.
+ *
+ * wait() blocks the calling thread until every submitted task, including the
+ * ones submitted by running tasks, is completed. The first exception thrown by
+ * a task is stored and rethrown by wait(). wait() must not be called from a
+ * worker of the same pool.
+ */
+class WorkStealingPool{
+
+public:
+    typedef std::function<void()> Task; /**< Type of the task executed by the pool.*/
+
+    explicit WorkStealingPool(std::size_t nWorkers = getNumberOfThreads());
+    ~WorkStealingPool();
+
+    std::size_t getNumberOfWorkers() const;
+    void        submit(Task task);
+    void        wait();
+
+private:
+    /*!
+     * Task queue owned by a worker.
+     */
+    struct WorkerQueue{
+        std::deque<Task> tasks; /**< Queued tasks.*/
+        std::mutex       mutex; /**< Queue lock.*/
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;  /**< Per-worker task queues.*/
+    std::vector<std::thread>    m_workers;      /**< Worker threads.*/
+    std::mutex                  m_mutex;        /**< Lock of the pool state.*/
+    std::condition_variable     m_taskReady;    /**< Signal of new queued tasks or pool shutdown.*/
+    std::condition_variable     m_allDone;      /**< Signal of completion of all pending tasks.*/
+    std::size_t                 m_queued;       /**< Number of tasks queued but not yet taken by a worker.*/
+    std::size_t                 m_pending;      /**< Number of tasks submitted and not yet completed.*/
+    std::size_t                 m_nextQueue;    /**< Next queue for tasks submitted from outside the pool.*/
+    bool                        m_stop;         /**< Pool shutdown flag.*/
+    std::exception_ptr          m_error;        /**< First exception thrown by a task.*/
+
+    void    run(std::size_t index);
+    bool    popTask(std::size_t index, Task & task);
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool & operator=(const WorkStealingPool &) = delete;
+};
+
+/*!
+ * \class SynchronizedStreamBuffer
+ * \ingroup common_Utils
+ * \brief Stream buffer serializing the lines written concurrently by several threads
+ * on a shared target buffer.
+ *
+ * Each thread accumulates its characters in a private line, forwarded as a whole
+ * to the target buffer on synchronization (e.g. std::endl). It can be temporarily
+ * installed on a shared stream, e.g. a logger, with std::ostream::rdbuf.
+ */
+class SynchronizedStreamBuffer : public std::streambuf{
+
+public:
+    explicit SynchronizedStreamBuffer(std::streambuf * target);
+    ~SynchronizedStreamBuffer();
+
+protected:
+    int_type        overflow(int_type ch) override;
+    std::streamsize xsputn(const char * s, std::streamsize n) override;
+    int             sync() override;
+
+private:
+    std::streambuf *                                    m_target;   /**< Target stream buffer.*/
+    std::mutex                                          m_mutex;    /**< Lock of lines and target buffer.*/
+    std::unordered_map<std::thread::id, std::string>    m_lines;    /**< Pending line of each thread.*/
+
+    SynchronizedStreamBuffer(const SynchronizedStreamBuffer &) = delete;
+    SynchronizedStreamBuffer & operator=(const SynchronizedStreamBuffer &) = delete;
+};
+
+/*!
+ * \class SharedMutex
+ * \ingroup common_Utils
+ * \brief Mutex with shared and exclusive ownership.
+ *
+ * Any number of threads can own the mutex in shared mode (lock_shared), while a
+ * single thread can own it in exclusive mode (lock) when no shared owner exists.
+ * The interface matches the C++14 std::shared_timed_mutex, so it can be used with
+ * std::unique_lock in exclusive mode.
+ */
+class SharedMutex{
+
+public:
+    SharedMutex();
+
+    void    lock();
+    void    unlock();
+    void    lock_shared();
+    void    unlock_shared();
+
+private:
+    std::mutex                  m_mutex;        /**< Lock of the mutex state.*/
+    std::condition_variable     m_released;     /**< Signal of released ownership.*/
+    std::size_t                 m_nShared;      /**< Number of shared owners.*/
+    bool                        m_exclusive;    /**< True if owned in exclusive mode.*/
+
+    SharedMutex(const SharedMutex &) = delete;
+    SharedMutex & operator=(const SharedMutex &) = delete;
+};
+
+/*!
+ * \class AsyncWriter
+ * \ingroup common_Utils
+ * \brief Process-wide background thread executing output tasks in order of submission.
+ *
+ * Writers hand off to the background thread a task owning an immutable snapshot of the
+ * data to be written, and go on with their work. The number of tasks submitted and not
+ * yet completed is bounded (see setMaxPending): submit() blocks until a slot is free, so
+ * that the memory used by the snapshots stays limited.
+ *
+ * wait() is a barrier: it blocks until every submitted task is completed, and rethrows
+ * the first exception thrown by a task. The background thread is started at the first
+ * submission; the destructor completes the pending tasks.
+ */
+class AsyncWriter{
+
+public:
+    typedef std::function<void()> Task; /**< Type of the task executed by the writer.*/
+
+    static AsyncWriter & instance();
+    ~AsyncWriter();
+
+    void        submit(Task task);
+    void        wait();
+    std::size_t getNumberOfPending();
+    std::size_t getMaxPending();
+    void        setMaxPending(std::size_t maxPending);
+
+private:
+    std::thread                 m_thread;       /**< Background thread.*/
+    std::mutex                  m_mutex;        /**< Lock of the writer state.*/
+    std::condition_variable     m_changed;      /**< Signal of new, completed tasks or shutdown.*/
+    std::deque<Task>            m_tasks;        /**< Tasks waiting for execution.*/
+    std::size_t                 m_pending;      /**< Number of tasks submitted and not yet completed.*/
+    std::size_t                 m_maxPending;   /**< Maximum number of pending tasks.*/
+    bool                        m_stop;         /**< Shutdown flag.*/
+    std::exception_ptr          m_error;        /**< First exception thrown by a task.*/
+
+    AsyncWriter();
+    void    run();
+
+    AsyncWriter(const AsyncWriter &) = delete;
+    AsyncWriter & operator=(const AsyncWriter &) = delete;
+};
+
+}
+
+}
+
+#endif /* __MIMMOTHREADS_HPP__ */
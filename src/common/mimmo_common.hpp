@@ -82,6 +82,9 @@
 #include "TrackingPointer.hpp"
 #include "customOperators.hpp"
 #include "mimmo_binary_stream.hpp"
+#include "mimmoThreads.hpp"
+#include "mimmoTextParser.hpp"
+#include "mimmoProfiler.hpp"
 
 
 namespace mimmo{
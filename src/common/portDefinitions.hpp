@@ -47,8 +47,11 @@
 #define M_DISPLS          "M_DISPLS"            /**< Port dedicated to communication of displacements of 3D points [ vector < array < double,3 > > ] */
 #define M_GDISPLS         "M_GDISPLS"           /**< Port dedicated to communication of displacements relative to geometry vertices [ MimmoPiercedVector < array < double,3 > > ] */
 #define M_GDISPLS2        "M_GDISPLS2"           /**< Port dedicated to communication of displacements relative to geometry vertices [ POINTER to MimmoPiercedVector < array < double,3 > > ] */
+#define M_DISPLS32        "M_DISPLS32"          /**< Port dedicated to communication of displacements of 3D points in single precision [ vector < array < float,3 > > ] */
+#define M_GDISPLS32       "M_GDISPLS32"         /**< Port dedicated to communication of displacements relative to geometry vertices in single precision [ POINTER to MimmoPiercedVector < array < float,3 > > ] */
 #define M_FILTER          "M_FILTER"            /**< Port dedicated to communication of a scalar field used as a filter function [ POINTER to MimmoPiercedVector < double > ] */
 #define M_FILTER2         "M_FILTER2"            /**< Port dedicated to communication of a scalar field used as a filter function [ POINTER to MimmoPiercedVector < double > ] */
+#define M_FILTER32        "M_FILTER32"          /**< Port dedicated to communication of a scalar field used as a filter function in single precision [ POINTER to MimmoPiercedVector < float > ] */
 #define M_DATAFIELD       "M_DATAFIELD"         /**< Port dedicated to communication of a generic scalar field [ std::vector<double>] */
 #define M_DATAFIELD2      "M_DATAFIELD2"         /**< Port dedicated to communication of a generic scalar field [ std::vector<double>] */
 #define M_VECTORSI        "M_VECTORSI"          /**< Port dedicated to communication of a generic list of short integers [ vector < short int > ] */
@@ -57,8 +60,10 @@
 #define M_VECTORLI3       "M_VECTORLI3"         /**< Port dedicated to communication of a generic list of long integers [ vector < long int > ] */
 #define M_SCALARFIELD     "M_SCALARFIELD"       /**< Port dedicated to communication of a generic scalar field [ POINTER to MimmoPiercedvector < double > ] */
 #define M_SCALARFIELD2    "M_SCALARFIELD2"      /**< Port dedicated to communication of a generic scalar field [ POINTER to MimmoPiercedvector < double > ] */
+#define M_SCALARFIELD32   "M_SCALARFIELD32"     /**< Port dedicated to communication of a generic scalar field (e.g. a distance field) in single precision [ POINTER to MimmoPiercedvector < float > ] */
 #define M_VECTORFIELD     "M_VECTORFIELD"       /**< Port dedicated to communication of a generic vector field [ POINTER to MimmoPiercedvector < array< double,3> > ] */
 #define M_VECTORFIELD2    "M_VECTORFIELD2"      /**< Port dedicated to communication of a generic vector field [ POINTER to MimmoPiercedvector < array< double,3> > ] */
+#define M_VECTORFIELD32   "M_VECTORFIELD32"     /**< Port dedicated to communication of a generic vector field in single precision [ POINTER to MimmoPiercedvector < array< float,3> > ] */
 #define M_STRINGFIELD     "M_STRINGFIELD"       /**< Port dedicated to communication of a generic string field [ POINTER to MimmoPiercedvector < std::string > ] */
 #define M_STRINGFIELD2    "M_STRINGFIELD2"      /**< Port dedicated to communication of a generic string field [ POINTER to MimmoPiercedvector < std::string > ] */
 #define M_LONGFIELD       "M_LONGFIELD"         /**< Port dedicated to communication of a generic long field [ POINTER to MimmoPiercedvector < long > ] */
@@ -133,6 +138,7 @@
 #define  MD_SHORT                   "MD_SHORT"                   /**< short integer data identifier*/
 #define  MD_LONG                    "MD_LONG"                    /**< long integer data identifier*/
 #define  MD_FLOAT                   "MD_FLOAT"                   /**< float/double data identifier*/
+#define  MD_FLOAT32                 "MD_FLOAT32"                 /**< single precision float data identifier*/
 #define  MD_BOOL                    "MD_BOOL"                    /**< boolean data identifier*/
 #define  MD_SHAPET                  "MD_SHAPET"                  /**< mimmo::ShapeType data identifier*/
 #define  MD_SHAPE_                  "MD_SHAPE_"                  /**< mimmo::BasicShape pointer data identifier*/
@@ -144,6 +150,8 @@
 #define  MD_PAIRLONGLONG            "MD_PAIRLONGLONG"            /**< std::pair< long, long > data identifier */
 #define  MD_MPVECFLOAT_             "MD_MPVECFLOAT_"             /**< pointer to MimmoPiercedVector<double> data structure*/
 #define  MD_MPVECARR3FLOAT_         "MD_MPVECARR3FLOAT_"         /**< pointer to MimmoPiercedVector<array<double,3> > data structure */
+#define  MD_MPVECFLOAT32_           "MD_MPVECFLOAT32_"           /**< pointer to MimmoPiercedVector<float> data structure*/
+#define  MD_MPVECARR3FLOAT32_       "MD_MPVECARR3FLOAT32_"       /**< pointer to MimmoPiercedVector<array<float,3> > data structure */
 #define  MD_MATRIXCOEFF_            "MD_MATRIXCOEFF_"            /**< pointer to array< array< vector<double> ,3> > */
 #define  MD_STRING                  "MD_STRING"                  /**< string data identifier*/
 #define  MD_MPVECSTRING_            "MD_MPVECSTRING_"            /**< pointer to MimmoPiercedVector<std::string> data structure*/
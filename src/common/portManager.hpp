@@ -27,6 +27,7 @@
 
 #include "portDefinitions.hpp"
 #include <unordered_map>
+#include <vector>
 #include <cassert>
 
 
@@ -39,7 +40,7 @@ namespace mimmo{
  * \brief  collection of data functional to a port registration.
  *
  * Contains a unique id identifying the port and two strings indentifying the container and the type
- * of data associated to the port.
+ * of data associated to the port, together with their integer ids.
  */
 struct InfoPort{
 
@@ -47,12 +48,16 @@ struct InfoPort{
     std::string container;   /**< string label identifying the container associated to the port*/
     std::string datatype;    /**< string label identifying the data type associated to the port*/
     std::string file;        /**<file where the port is registrated */
+    long containerId;        /**< integer label identifying the container associated to the port*/
+    long datatypeId;         /**< integer label identifying the data type associated to the port*/
     /*! Base constructor */
     InfoPort(){
         id=0;
         container="";
         datatype="";
         file = "";
+        containerId=0;
+        datatypeId=0;
     };
     /*! Base Destructor */
     virtual ~InfoPort(){};
@@ -67,6 +72,13 @@ struct InfoPort{
  * containers and data types. PortManager can be "extended", that is more ports, containers and data type
  * can be added, once mimmo is already built.
  * PortManager contains utilities to manage the ports addition.
+ *
+ * Port, container and data type names are interned: each name is associated, at its first
+ * registration, to a progressive integer id. Names are used in the XML interface and in the
+ * public API, while ids are used internally, e.g. to index the ports of a block in a flat
+ * array and to check the compatibility of two ports without comparing strings.
+ * Registration is meant to happen during static initialization (see REGISTER_PORT), before
+ * any concurrent access to the singleton.
  */
 class PortManager {
 
@@ -116,21 +128,40 @@ public:
         temp.container = container_name;
         temp.datatype = datatype_name;
         temp.file = fileregistration;
-        long idC=long(containers.size()), idD=long(datatypes.size());
-
+        temp.containerId = addContainer(container_name);
+        temp.datatypeId = addDatatype(datatype_name);
 
-        temp.id = long(ports.size());
+        temp.id = long(portNames.size());
         ports[name]= temp;
+        portNames.push_back(name);
 
-        if(!containsContainer(container_name)){
-            containers[container_name]= idC;
-        }
+        return (long) temp.id;
+    }
 
-        if(!containsDatatype(datatype_name)){
-            datatypes[datatype_name]= idD;
-        }
+    /*! Add a container name to the registered list, if not already present.
+     * \param[in] name name of the container
+     * \return id of the container
+     */
+    long addContainer(const std::string & name)
+    {
+        auto it = containers.find(name);
+        if(it != containers.end())  return it->second;
+        long id = long(containers.size());
+        containers[name] = id;
+        return id;
+    }
 
-        return (long) temp.id;
+    /*! Add a data type name to the registered list, if not already present.
+     * \param[in] name name of the datatype
+     * \return id of the datatype
+     */
+    long addDatatype(const std::string & name)
+    {
+        auto it = datatypes.find(name);
+        if(it != datatypes.end())  return it->second;
+        long id = long(datatypes.size());
+        datatypes[name] = id;
+        return id;
     }
 
     /*! Check if a port name is already registered
@@ -185,9 +216,36 @@ public:
         return ports[name];
     }
 
+    /*!
+     * \param[in] name name of the Port
+     * \return id of the Port, -1 if the Port is not registered
+     */
+    long getPortId(const std::string & name){
+        auto it = ports.find(name);
+        if(it == ports.end())   return -1;
+        return it->second.id;
+    }
+
+    /*!
+     * \param[in] id id of the Port
+     * \return name of the Port, empty if the id is not registered
+     */
+    std::string getPortName(long id){
+        if(id < 0 || id >= long(portNames.size()))  return "";
+        return portNames[id];
+    }
+
+    /*!
+     * \return number of registered ports, i.e. the upper bound of the port ids
+     */
+    std::size_t getNPorts(){
+        return portNames.size();
+    }
+
 
 private:
     std::unordered_map<std::string, InfoPort> ports;  /**< list of registered ports */
+    std::vector<std::string> portNames;               /**< names of the registered ports, ordered by id */
     std::unordered_map<std::string, long> containers; /**< list of registered port containers */
     std::unordered_map<std::string, long> datatypes;  /**< list of registered port data types */
 };
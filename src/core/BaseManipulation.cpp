@@ -22,12 +22,61 @@
  *
 \*---------------------------------------------------------------------------*/
 #include "BaseManipulation.hpp"
+#include "mimmoProfiler.hpp"
+#include <atomic>
+#include <chrono>
 #include <utility>
 #include <map>
+#include <unordered_set>
+#include <sys/stat.h>
 
 namespace mimmo {
 
 int BaseManipulation::sm_baseManipulationCounter(1);
+threads::SharedMutex BaseManipulation::sm_executionMutex;
+std::mutex BaseManipulation::sm_asyncSnapshotsMutex;
+std::vector<std::pair<std::shared_ptr<void>, std::shared_ptr<std::atomic<bool>>>> BaseManipulation::sm_asyncSnapshots;
+
+namespace{
+
+/*!
+ * Nesting level of the executions of blocks on the current thread.
+ */
+thread_local int s_executionDepth = 0;
+
+/*!
+ * Time in seconds spent by the current thread waiting for the execution mutex.
+ */
+thread_local double s_executionWaitTime = 0.0;
+
+/*!
+ * Scoped ownership of the execution mutex of the blocks (see BaseManipulation::runExecution).
+ * Only the outermost execution of a thread acquires the mutex.
+ */
+class ExecutionLock{
+    threads::SharedMutex &  m_mutex;    /**< Execution mutex.*/
+    bool                    m_shared;   /**< True for shared ownership.*/
+    bool                    m_owner;    /**< True if the mutex has been acquired.*/
+public:
+    ExecutionLock(threads::SharedMutex & mutex, bool shared) : m_mutex(mutex), m_shared(shared), m_owner(s_executionDepth == 0){
+        if(m_owner){
+            auto start = std::chrono::steady_clock::now();
+            if(m_shared) m_mutex.lock_shared();
+            else m_mutex.lock();
+            s_executionWaitTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        ++s_executionDepth;
+    }
+    ~ExecutionLock(){
+        --s_executionDepth;
+        if(m_owner){
+            if(m_shared) m_mutex.unlock_shared();
+            else m_mutex.unlock();
+        }
+    }
+};
+
+}
 
 /*!
  * Default constructor of BaseManipulation.
@@ -44,6 +93,15 @@ BaseManipulation::BaseManipulation(){
     m_counter       = sm_baseManipulationCounter;
     m_priority      = 0;
     m_apply         = false;
+    m_memoize       = false;
+    m_dirty         = true;
+    m_executed      = false;
+    m_paramHash     = 0;
+    m_deformedGeometry = nullptr;
+    m_deformedRevision = 0;
+    m_deformationRestored = false;
+    m_asyncOutput   = false;
+    m_outputFloat32 = false;
     sm_baseManipulationCounter++;
 
 #if MIMMO_ENABLE_MPI
@@ -95,6 +153,15 @@ BaseManipulation::BaseManipulation(const BaseManipulation & other){
 
     m_priority      = other.m_priority;
     m_apply         = other.m_apply;
+    m_memoize       = other.m_memoize;
+    m_dirty         = true;
+    m_executed      = false;
+    m_paramHash     = 0;
+    m_deformedGeometry = nullptr;
+    m_deformedRevision = 0;
+    m_deformationRestored = false;
+    m_asyncOutput   = other.m_asyncOutput;
+    m_outputFloat32 = other.m_outputFloat32;
 
     //logger is ready, since another BaseManipulation other, is instantiated.
     m_log           = &bitpit::log::cout(MIMMO_LOG_FILE);
@@ -123,6 +190,13 @@ BaseManipulation & BaseManipulation::operator=(const BaseManipulation & other){
     m_outputPlot    = other.m_outputPlot;
     m_priority      = other.m_priority;
     m_apply         = other.m_apply;
+    m_memoize       = other.m_memoize;
+    m_dirty         = true;
+    m_deformedGeometry = nullptr;
+    m_referenceIds.clear();
+    m_referenceCoords.clear();
+    m_asyncOutput   = other.m_asyncOutput;
+    m_outputFloat32 = other.m_outputFloat32;
 #if MIMMO_ENABLE_MPI
 	MPI_Comm_dup(other.m_communicator, &m_communicator);
 	m_rank			= other.m_rank;
@@ -147,6 +221,18 @@ void BaseManipulation::swap(BaseManipulation & x) noexcept
     std::swap(m_execPlot, x.m_execPlot);
     std::swap(m_apply, x.m_apply);
     std::swap(m_outputPlot, x.m_outputPlot);
+    std::swap(m_memoize, x.m_memoize);
+    std::swap(m_dirty, x.m_dirty);
+    std::swap(m_executed, x.m_executed);
+    std::swap(m_paramHash, x.m_paramHash);
+    std::swap(m_inputHash, x.m_inputHash);
+    std::swap(m_deformedGeometry, x.m_deformedGeometry);
+    std::swap(m_deformedRevision, x.m_deformedRevision);
+    std::swap(m_referenceIds, x.m_referenceIds);
+    std::swap(m_referenceCoords, x.m_referenceCoords);
+    std::swap(m_asyncOutput, x.m_asyncOutput);
+    std::swap(m_outputFloat32, x.m_outputFloat32);
+    std::swap(m_outputFields, x.m_outputFields);
 #if MIMMO_ENABLE_MPI
     std::swap(m_communicator, x.m_communicator);
     std::swap(m_rank, x.m_rank);
@@ -365,6 +451,28 @@ BaseManipulation::getPortsOut(){
     return (m_portOut);
 }
 
+/*!
+ * It gets an input port of the object by id.
+ * \param[in] id id of the port in mimmo::PortManager.
+ * \return pointer to the input port, nullptr if the object has no such port.
+ */
+PortIn*
+BaseManipulation::getPortIn(long id){
+    if (id < 0 || id >= long(m_portInById.size())) return nullptr;
+    return m_portInById[id];
+}
+
+/*!
+ * It gets an output port of the object by id.
+ * \param[in] id id of the port in mimmo::PortManager.
+ * \return pointer to the output port, nullptr if the object has no such port.
+ */
+PortOut*
+BaseManipulation::getPortOut(long id){
+    if (id < 0 || id >= long(m_portOutById.size())) return nullptr;
+    return m_portOutById[id];
+}
+
 /*!
  * \return true if the feature to plot optional results of the block is active.
  */
@@ -381,6 +489,67 @@ BaseManipulation::isApply(){
     return (m_apply);
 }
 
+/*!
+ * \return true if memoized execution of the block is active.
+ */
+bool
+BaseManipulation::isMemoized(){
+    return (m_memoize);
+}
+
+/*!
+ * \return true if the output files of the block are written in background. It is
+ * always false in MPI runs with more than one process.
+ */
+bool
+BaseManipulation::isAsyncOutput(){
+#if MIMMO_ENABLE_MPI
+    if(m_nprocs > 1) return false;
+#endif
+    return (m_asyncOutput);
+}
+
+/*!
+ * \return true if the floating point data fields written with the geometry are stored
+ * in single precision.
+ */
+bool
+BaseManipulation::isOutputFloat32(){
+    return (m_outputFloat32);
+}
+
+/*!
+ * \return true if the execution of the block can run concurrently with other blocks
+ * in a parallel execution of a chain (see Chain::setParallelExecution).
+ * A thread-safe block must not change the priority of the shared logger, must not
+ * create or destroy MimmoObject (i.e. bitpit patches) and must not modify data it does
+ * not own during execute() and apply(). Default is false; blocks fulfilling these
+ * requirements opt in by overriding this method.
+ */
+bool
+BaseManipulation::isThreadSafe(){
+    return false;
+}
+
+/*!
+ * \return time in seconds spent by the calling thread, since its start, waiting for the
+ * executions of other threads to release the blocks (see runExecution). It measures how
+ * much concurrent executions, e.g. of design sweeps, are serialized by non thread-safe blocks.
+ */
+double
+BaseManipulation::getExecutionWaitTime(){
+    return s_executionWaitTime;
+}
+
+/*!
+ * \return true if execute() was called during the last execution of the block,
+ * false if the block was disabled or its execution was skipped by memoization.
+ */
+bool
+BaseManipulation::wasExecuted(){
+    return (m_executed);
+}
+
 /*!
  * It gets if the object is activates or disable during the execution.
  * \return True/false if the object is activates or disable during the execution.
@@ -432,6 +601,7 @@ BaseManipulation::setName(std::string name){
 void
 BaseManipulation::setGeometry(MimmoSharedPointer<MimmoObject> geometry){
     m_geometry = geometry;
+    m_dirty = true;
 };
 
 /*!
@@ -464,6 +634,51 @@ BaseManipulation::setApply( bool flag){
     m_apply = flag;
 }
 
+/*!
+ * Activates the memoized execution of the block: exec() skips the execution if
+ * inputs and parameters are unchanged since the last execution, and forwards the
+ * stored results through the output ports.
+ * See the class documentation for the tracked changes.
+ * \param[in] flag true/false to activate/deactivate the feature
+ */
+void
+BaseManipulation::setMemoization( bool flag){
+    m_memoize = flag;
+}
+
+/*!
+ * Activates the asynchronous writing of the output files of the block: a snapshot of
+ * the geometry and of the data fields is written by a background thread while the
+ * execution goes on. Output files are complete only after waitAsyncOutput() or the end
+ * of the execution of a Chain.
+ * \param[in] flag true/false to activate/deactivate the feature
+ */
+void
+BaseManipulation::setAsyncOutput( bool flag){
+    m_asyncOutput = flag;
+}
+
+/*!
+ * Activates the single precision writing of the floating point data fields written with
+ * the geometry (plot of optional results). Fields are converted when they are handed to
+ * the writer, so that also the snapshots of asynchronous output are stored in single precision.
+ * \param[in] flag true/false to activate/deactivate the feature
+ */
+void
+BaseManipulation::setOutputFloat32( bool flag){
+    m_outputFloat32 = flag;
+}
+
+/*!
+ * Force the execution of the block at the next call of exec(), even if memoization
+ * is active. It has to be called after modifying data of the block through direct
+ * setters not tracked by flushSectionXML.
+ */
+void
+BaseManipulation::markDirty(){
+    m_dirty = true;
+}
+
 /*!
  * Set (force) integer identifier of the object
  * \param[in] id integer identifier
@@ -547,9 +762,166 @@ BaseManipulation::clear(){
 /*!
  * Execution command. exec() runs the execution of output pins (connections) at the end of the execution.
  * execute is pure virtual and it has to be implemented in a derived class.
+ * If mimmo::Profiler is enabled, time, peak memory increase and number of geometry
+ * elements of the execution and of each of its phases are recorded.
  */
 void
 BaseManipulation::exec(){
+    runExecution(nullptr);
+}
+
+/*!
+ * Barrier on the asynchronous output: it blocks until all the output files handed off
+ * to the background thread by any object are written, then releases the snapshots
+ * retained for them (see submitAsyncOutput).
+ * The first error occurred while writing them is rethrown.
+ */
+void
+BaseManipulation::waitAsyncOutput(){
+    try{
+        threads::AsyncWriter::instance().wait();
+    }catch(...){
+        releaseAsyncSnapshots();
+        throw;
+    }
+    releaseAsyncSnapshots();
+}
+
+/*!
+ * Hand off an output task to the background thread of asynchronous output.
+ * The task must own the data it writes, e.g. a snapshot of the data fields.
+ * \param[in] task output task
+ */
+void
+BaseManipulation::submitAsyncOutput(threads::AsyncWriter::Task task){
+    threads::AsyncWriter::instance().submit(std::move(task));
+}
+
+/*!
+ * Hand off an output task writing a snapshot that must not be destroyed by the background
+ * thread, e.g. a clone of a geometry, whose destruction unregisters a patch from bitpit.
+ * The snapshot is retained by the object and released by the thread submitting the following
+ * output tasks or by waitAsyncOutput, once the task is completed; the task must only refer to it.
+ * \param[in] task output task
+ * \param[in] snapshot data written by the task
+ */
+void
+BaseManipulation::submitAsyncOutput(threads::AsyncWriter::Task task, std::shared_ptr<void> snapshot){
+    releaseAsyncSnapshots(false);
+    std::shared_ptr<std::atomic<bool>> done = std::make_shared<std::atomic<bool>>(false);
+    {
+        std::lock_guard<std::mutex> lock(sm_asyncSnapshotsMutex);
+        sm_asyncSnapshots.emplace_back(std::move(snapshot), done);
+    }
+    threads::AsyncWriter::instance().submit([task, done](){
+        try{
+            task();
+        }catch(...){
+            *done = true;
+            throw;
+        }
+        *done = true;
+    });
+}
+
+/*!
+ * Release the snapshots retained for asynchronous output tasks.
+ * \param[in] all if false, only the snapshots of completed tasks are released.
+ */
+void
+BaseManipulation::releaseAsyncSnapshots(bool all){
+    std::vector<std::shared_ptr<void>> released;
+    {
+        std::lock_guard<std::mutex> lock(sm_asyncSnapshotsMutex);
+        auto itKeep = sm_asyncSnapshots.begin();
+        for(auto it = sm_asyncSnapshots.begin(); it != sm_asyncSnapshots.end(); ++it){
+            if(all || *(it->second)){
+                released.push_back(std::move(it->first));
+            }else{
+                *itKeep = std::move(*it);
+                ++itKeep;
+            }
+        }
+        sm_asyncSnapshots.erase(itKeep, sm_asyncSnapshots.end());
+    }
+    //snapshots destroyed here, out of the lock
+}
+
+/*!
+ * Run the execution steps of the object: check of mandatory ports, execute,
+ * transfer of output data, plot of optional results and apply. Each step is
+ * recorded as a mimmo::ProfileScope.
+ * Executions running concurrently on different threads (e.g. parallel chains or
+ * design sweeps) are serialized, unless the objects are thread-safe (see isThreadSafe)
+ * and do not plot results: a non thread-safe object runs alone. Executions nested
+ * in the execution of another object do not synchronize again.
+ * \param[in] transferMutex if not null, lock held during the transfer of output data
+ */
+void
+BaseManipulation::runExecution(std::mutex * transferMutex){
+
+    ExecutionLock lock(sm_executionMutex, isThreadSafe() && !isPlotInExecution());
+    runExecutionSteps(transferMutex);
+}
+
+/*!
+ * Execution steps of runExecution.
+ * \param[in] transferMutex if not null, lock held during the transfer of output data
+ */
+void
+BaseManipulation::runExecutionSteps(std::mutex * transferMutex){
+
+    ProfileScope blockScope(m_name, "block");
+
+    checkMandatoryPorts();
+
+    bool skipped = m_memoize && !isExecutionRequired();
+    m_executed = false;
+    if (m_active && !skipped){
+        std::size_t paramHash = m_memoize ? computeParametersHash() : 0;
+        {
+            ProfileScope scope(m_name + "::execute", "execute");
+            execute();
+        }
+        m_executed = true;
+        m_dirty = false;
+        m_paramHash = paramHash;
+    }
+    if(m_active && skipped){
+        (*m_log) << m_name << " : inputs unchanged since last execution, execution skipped" << std::endl;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock;
+        if(transferMutex) lock = std::unique_lock<std::mutex>(*transferMutex);
+        ProfileScope scope(m_name + "::transfer", "transfer");
+        execPortsOut();
+    }
+
+    if(skipped) return;
+
+    if(isPlotInExecution()){
+        ProfileScope scope(m_name + "::plotOptionalResults", "plot");
+        plotOptionalResults();
+    }
+    if(isApply()){
+        ProfileScope scope(m_name + "::apply", "apply");
+        apply();
+    }
+
+    if(blockScope.isActive() && m_geometry != nullptr){
+        blockScope.addCounter("cells", m_geometry->getNCells());
+        blockScope.addCounter("vertices", m_geometry->getNVertices());
+    }
+}
+
+/*!
+ * Check that the mandatory input ports of the object are linked.
+ * The check is skipped in expert mode.
+ * An exception is thrown if a mandatory port (or a whole family of mandatory ports) is not linked.
+ */
+void
+BaseManipulation::checkMandatoryPorts(){
 
     if (!MIMMO_EXPERT){
         std::map<int, std::vector<PortIn*> > families;
@@ -590,18 +962,214 @@ BaseManipulation::exec(){
             itID++;
         }
     }
+}
 
-    if (m_active) execute();
-
+/*!
+ * Execute the linked output ports of the object, i.e. transfer the output data
+ * to the connected objects. If the object was executed, the receivers of data
+ * communicated by reference are marked as dirty, since the referenced
+ * structures may have changed without changing the communicated pointers.
+ */
+void
+BaseManipulation::execPortsOut(){
     for (std::unordered_map<PortID, PortOut*>::iterator i=m_portOut.begin(); i!=m_portOut.end(); i++){
         std::vector<BaseManipulation*>	linked = i->second->getLink();
         if (linked.size() > 0){
             i->second->exec();
+            if (m_executed && i->second->isReferenceData()){
+                for (BaseManipulation * obj : linked){
+                    if (obj != nullptr) obj->markDirty();
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * Check if the object has to be executed in memoized mode, i.e. if it was marked as
+ * dirty since the last execution, the geometry it deformed in place was restored to the
+ * undeformed coordinates (see restoreInPlaceDeformation) or its parameters changed.
+ * \return true if the execution is required.
+ */
+bool
+BaseManipulation::isExecutionRequired(){
+    if (m_dirty || m_deformationRestored) return true;
+    return computeParametersHash() != m_paramHash;
+}
+
+/*!
+ * Check if execute() will be called by the next execution of the object, i.e. if the object
+ * is active and not memoized or its execution is required (see isExecutionRequired).
+ * \return true if the object will be executed.
+ */
+bool
+BaseManipulation::isExecutionPending(){
+    return m_active && (!m_memoize || isExecutionRequired());
+}
+
+/*!
+ * Compute a hash of the parameters of the object, as written by flushSectionXML, and of
+ * the size and modification time of the files read by the object (see getInputFiles).
+ * \return hash of the parameters.
+ */
+std::size_t
+BaseManipulation::computeParametersHash(){
+    bitpit::Config::Section parameters;
+    std::stringstream out;
+    try{
+        flushSectionXML(parameters, m_name);
+        parameters.dump(out);
+    }catch(...){
+        // Parameters not available: force the execution at each call.
+        return m_paramHash + 1;
+    }
+    for (const std::string & file : getInputFiles()){
+        struct stat info;
+        out << file << " ";
+        if (stat(file.c_str(), &info) != 0){
+            out << "missing" << std::endl;
+            continue;
+        }
+#if defined(__APPLE__)
+        long nanoseconds = long(info.st_mtimespec.tv_nsec);
+#else
+        long nanoseconds = long(info.st_mtim.tv_nsec);
+#endif
+        out << info.st_size << " " << info.st_mtime << " " << nanoseconds << std::endl;
+    }
+    std::string dump = out.str();
+    return PortOut::hashBuffer(dump.data(), dump.size());
+}
+
+/*!
+ * List the files read by the object in its execution. In memoized mode their size and
+ * modification time are tracked together with the parameters of the object (see
+ * computeParametersHash), so that a file rewritten under the same name, e.g. by an
+ * optimizer, triggers the execution again. Reader blocks override this method; the
+ * base one returns an empty list.
+ * \return paths of the files read by the object.
+ */
+std::vector<std::string>
+BaseManipulation::getInputFiles(){
+    return std::vector<std::string>();
+}
+
+/*!
+ * Prepare the in place deformation of the linked geometry. In memoized mode,
+ * if the geometry is still in the state left by the last deformation of this
+ * object, i.e. its coordinates revision did not change (see MimmoObject::getCoordinatesRevision),
+ * the undeformed vertex coordinates are restored; otherwise the current
+ * coordinates are stored as the undeformed ones.
+ * It has to be called before modifying the vertices of the linked geometry in place.
+ */
+void
+BaseManipulation::beginInPlaceDeformation(){
+    MimmoObject * geometry = m_geometry.get();
+    if (!m_memoize || geometry == nullptr){
+        m_deformedGeometry = nullptr;
+        m_deformationRestored = false;
+        m_referenceIds.clear();
+        m_referenceCoords.clear();
+        return;
+    }
+    if (geometry == m_deformedGeometry && geometry->getCoordinatesRevision() == m_deformedRevision){
+        if (!m_deformationRestored){
+            std::size_t nReference = m_referenceIds.size();
+            for (std::size_t i = 0; i < nReference; ++i){
+                geometry->modifyVertex(m_referenceCoords[i], m_referenceIds[i]);
+            }
+        }
+        return;
+    }
+    m_referenceIds.clear();
+    m_referenceCoords.clear();
+    m_referenceIds.reserve(geometry->getNVertices());
+    m_referenceCoords.reserve(geometry->getNVertices());
+    for (const auto & vertex : geometry->getVertices()){
+        m_referenceIds.push_back(vertex.getId());
+        m_referenceCoords.push_back(vertex.getCoords());
+    }
+    m_deformedGeometry = geometry;
+}
+
+/*!
+ * Complete the in place deformation of the linked geometry, storing the coordinates
+ * revision of the deformed geometry (see beginInPlaceDeformation).
+ */
+void
+BaseManipulation::endInPlaceDeformation(){
+    if (m_deformedGeometry == nullptr || m_deformedGeometry != m_geometry.get()) return;
+    m_deformedRevision = m_deformedGeometry->getCoordinatesRevision();
+    m_deformationRestored = false;
+}
+
+/*!
+ * Restore the undeformed vertex coordinates of the geometry deformed in place by the last
+ * memoized execution of the object, if the geometry is still in the state left by that
+ * deformation (see beginInPlaceDeformation). The object is then executed again by its next
+ * execution, deforming the restored geometry.
+ * Chain calls it before the execution of the ancestors of the object, so that they never
+ * work on the deformed geometry.
+ * \return true if the undeformed coordinates were restored.
+ */
+bool
+BaseManipulation::restoreInPlaceDeformation(){
+    MimmoObject * geometry = m_geometry.get();
+    if (m_deformationRestored || geometry == nullptr || geometry != m_deformedGeometry) return false;
+    if (geometry->getCoordinatesRevision() != m_deformedRevision) return false;
+    std::size_t nReference = m_referenceIds.size();
+    for (std::size_t i = 0; i < nReference; ++i){
+        geometry->modifyVertex(m_referenceCoords[i], m_referenceIds[i]);
+    }
+    geometry->update();
+    m_deformedRevision = geometry->getCoordinatesRevision();
+    m_deformationRestored = true;
+    return true;
+}
+
+/*!
+ * Find the descendants of the object, i.e. its children and recursively their children,
+ * that deformed in place their geometry in the last memoized execution and can restore
+ * its undeformed coordinates (see restoreInPlaceDeformation).
+ * \return list of the descendants with a restorable in place deformation.
+ */
+std::vector<BaseManipulation*>
+BaseManipulation::findInPlaceDeformers(){
+    std::vector<BaseManipulation*> deformers;
+    std::unordered_set<BaseManipulation*> visited;
+    std::vector<BaseManipulation*> stack;
+    for (const auto & child : m_child){
+        stack.push_back(child.first);
+    }
+    while (!stack.empty()){
+        BaseManipulation * object = stack.back();
+        stack.pop_back();
+        if (object == nullptr || !visited.insert(object).second) continue;
+        MimmoObject * geometry = object->m_geometry.get();
+        if (!object->m_deformationRestored && geometry != nullptr && geometry == object->m_deformedGeometry
+            && geometry->getCoordinatesRevision() == object->m_deformedRevision){
+            deformers.push_back(object);
+        }
+        for (const auto & child : object->m_child){
+            stack.push_back(child.first);
         }
     }
+    return deformers;
+}
 
-    if(isPlotInExecution())	plotOptionalResults();
-    if(isApply()) apply();
+/*!
+ * Update the hash of the data received by an input port. If the hash differs from
+ * the one received at the last transfer, the object is marked as dirty.
+ * \param[in] port id of the input port in mimmo::PortManager.
+ * \param[in] hash hash of the received data.
+ */
+void
+BaseManipulation::updateInputHash(long port, std::size_t hash){
+    auto it = m_inputHash.find(port);
+    if (it == m_inputHash.end() || it->second != hash){
+        m_inputHash[port] = hash;
+        m_dirty = true;
+    }
 }
 
 /*!
@@ -649,6 +1217,39 @@ BaseManipulation::absorbSectionXML(const bitpit::Config::Section & slotXML, std:
         setPlotInExecution(value);
     }
 
+    if(slotXML.hasOption("Memoize")){
+        std::string input = slotXML.get("Memoize");
+        input = bitpit::utils::string::trim(input);
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setMemoization(value);
+    }
+
+    if(slotXML.hasOption("AsyncOutput")){
+        std::string input = slotXML.get("AsyncOutput");
+        input = bitpit::utils::string::trim(input);
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setAsyncOutput(value);
+    }
+
+    if(slotXML.hasOption("OutputFloat32")){
+        std::string input = slotXML.get("OutputFloat32");
+        input = bitpit::utils::string::trim(input);
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setOutputFloat32(value);
+    }
+
     if(slotXML.hasOption("OutputPlot")){
         std::string input = slotXML.get("OutputPlot");
         input = bitpit::utils::string::trim(input);
@@ -681,6 +1282,15 @@ BaseManipulation::flushSectionXML(bitpit::Config::Section & slotXML, std::string
         slotXML.set("PlotInExecution", std::to_string(1));
         slotXML.set("OutputPlot", m_outputPlot);
     }
+    if(isMemoized()){
+        slotXML.set("Memoize", std::to_string(1));
+    }
+    if(m_asyncOutput){
+        slotXML.set("AsyncOutput", std::to_string(1));
+    }
+    if(m_outputFloat32){
+        slotXML.set("OutputFloat32", std::to_string(1));
+    }
 }
 
 /*!
@@ -696,6 +1306,8 @@ BaseManipulation::deletePorts(){
         delete i->second;
         i->second = nullptr;
     }
+    m_portOutById.clear();
+    m_portInById.clear();
 }
 
 /*!
@@ -710,12 +1322,16 @@ BaseManipulation::setBufferIn(PortID port, mimmo::IBinaryStream& input){
 
 /*!
  * It reads the buffer stored in an input port of the object.
+ * Changes of the data received through ports are tracked by updateInputHash, so
+ * setters marking the object as dirty do not affect the memoization state here.
  * \param[in] port ID of the port that reads the buffer and stores the
  * value in the related variable.
  */
 void
 BaseManipulation::readBufferIn(PortID port){
+    bool dirty = m_dirty;
     m_portIn[port]->readBuffer();
+    m_dirty = dirty;
 }
 
 /*!
@@ -727,6 +1343,23 @@ BaseManipulation::cleanBufferIn(PortID port){
     m_portIn[port]->cleanBuffer();
 }
 
+/*!
+ * It receives data through an input port of the object: the hash of the data is
+ * tracked (see updateInputHash), then the buffer is stored, read and cleaned.
+ * \param[in] port input port of the object.
+ * \param[in] input buffer of the communicated data.
+ * \param[in] hash hash of the communicated data.
+ */
+void
+BaseManipulation::receiveBufferIn(PortIn* port, mimmo::IBinaryStream& input, std::size_t hash){
+    updateInputHash(port->m_id, hash);
+    port->m_ibuffer = input;
+    bool dirty = m_dirty;
+    port->readBuffer();
+    m_dirty = dirty;
+    port->cleanBuffer();
+}
+
 /*!
  * It adds a manipulator object linked by this object.
  * \param[in] parent Pointer to parent manipulator object.
@@ -819,8 +1452,9 @@ BaseManipulation::findPinOut(PortOut& pin){
  */
 void
 BaseManipulation::addPinIn(BaseManipulation* objIn, PortID portR){
-    if (objIn != nullptr && m_portIn.count(portR) !=0 ){
-        m_portIn[portR]->m_objLink.push_back(objIn);
+    PortIn* pinin = getPortIn(PortManager::instance().getPortId(portR));
+    if (objIn != nullptr && pinin != nullptr){
+        pinin->m_objLink.push_back(objIn);
     }
 };
 
@@ -831,10 +1465,13 @@ BaseManipulation::addPinIn(BaseManipulation* objIn, PortID portR){
  */
 void
 BaseManipulation::addPinOut(BaseManipulation* objOut, PortID portS, PortID portR){
-    if (objOut != nullptr && m_portOut.count(portS) != 0 ){
-        if (objOut->m_portIn.count(portR) != 0){
-            m_portOut[portS]->m_objLink.push_back(objOut);
-            m_portOut[portS]->m_portLink.push_back(portR);
+    PortOut* pinout = getPortOut(PortManager::instance().getPortId(portS));
+    if (objOut != nullptr && pinout != nullptr){
+        PortIn* pinin = objOut->getPortIn(PortManager::instance().getPortId(portR));
+        if (pinin != nullptr){
+            pinout->m_objLink.push_back(objOut);
+            pinout->m_portLink.push_back(portR);
+            pinout->m_portInLink.push_back(pinin);
         }
     }
 };
@@ -956,6 +1593,7 @@ void
 BaseManipulation::_apply(MimmoPiercedVector<darray3E> & displacements)
 {
     if (getGeometry() == nullptr) return;
+    beginInPlaceDeformation();
     darray3E vertexcoords;
     long int ID;
     for (const auto & vertex : getGeometry()->getVertices()){
@@ -964,6 +1602,7 @@ BaseManipulation::_apply(MimmoPiercedVector<darray3E> & displacements)
         if(displacements.exists(ID))     vertexcoords += displacements[ID];
         getGeometry()->modifyVertex(vertexcoords, ID);
     }
+    endInPlaceDeformation();
 
     // Update geometry
     getGeometry()->update();
@@ -978,16 +1617,51 @@ BaseManipulation::_apply(MimmoPiercedVector<darray3E> & displacements)
 void
 BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry)
 {
+	std::vector<OutputField> fields;
+	fields.swap(m_outputFields);
+
 	//Check geometry
 	if (geometry == nullptr){
 		(*m_log) << " Warning: geometry null during writing " << m_name << std::endl;
 		return;
 	}
 
-	bitpit::VTKUnstructuredGrid & VTK = geometry->getPatch()->getVTK();
-	VTK.setDirectory(m_outputPlot+"/");
-	VTK.setName(m_name+std::to_string(m_counter));
-	geometry->getPatch()->write();
+	std::string directory = m_outputPlot+"/";
+	std::string name = m_name+std::to_string(m_counter);
+
+	if (isAsyncOutput()){
+		//snapshot of the patch, written in background with the fields and released by this thread
+		std::shared_ptr<bitpit::PatchKernel> snapshot(geometry->getPatch()->clone().release());
+		bitpit::PatchKernel * patch = snapshot.get();
+		submitAsyncOutput([patch, fields, directory, name](){
+			writePatch(*patch, fields, directory, name);
+		}, snapshot);
+		return;
+	}
+
+	writePatch(*(geometry->getPatch()), fields, directory, name);
+}
+
+/*!
+ * Write a patch in VTU format with a list of data fields.
+ * \param[in] patch patch to be written
+ * \param[in] fields data fields attached to the patch during the writing
+ * \param[in] directory output directory
+ * \param[in] name output file name
+ */
+void
+BaseManipulation::writePatch(bitpit::PatchKernel & patch, const std::vector<OutputField> & fields, const std::string & directory, const std::string & name)
+{
+	bitpit::VTKUnstructuredGrid & VTK = patch.getVTK();
+	VTK.setDirectory(directory);
+	VTK.setName(name);
+	for (const OutputField & field : fields){
+		field.attach(VTK);
+	}
+	patch.write();
+	for (const OutputField & field : fields){
+		VTK.removeData(field.name);
+	}
 }
 
 };
@@ -28,6 +28,7 @@
 #include "MimmoObject.hpp"
 #include "InOut.hpp"
 #include "MimmoPiercedVector.hpp"
+#include "mimmoThreads.hpp"
 
 #include <factory.hpp>
 #include <portManager.hpp>
@@ -39,6 +40,9 @@
 #include <unordered_map>
 #include <typeinfo>
 #include <type_traits>
+#include <mutex>
+#include <atomic>
+#include <memory>
 
 #if MIMMO_ENABLE_MPI
     #include <mpi.h>
@@ -50,6 +54,8 @@
 
 namespace mimmo{
 
+class Chain;
+
 /*!
  * \class BaseManipulation
  * \ingroup core
@@ -88,6 +94,37 @@ namespace mimmo{
  * For further information about PortType specification
  * please refer to PortType enum documentation. \n
  *
+ * Memoized execution (setMemoization) is meant for repeated executions of a chain, e.g. in optimization
+ * loops. The object tracks the changes of its inputs since the last execution, and exec() skips execute(),
+ * plot of optional results and apply if nothing changed; the results of the last execution, still stored
+ * in the object, are forwarded again through the output ports. The object is re-executed if:
+ * - it was never executed or markDirty() was called (e.g. after setting data with a direct setter);
+ * - the data received through an input port differ from the data of the last execution;
+ * - a parent object was executed and sent data by reference (e.g. a geometry, port data types ending with "_");
+ * - the parameters written by flushSectionXML changed;
+ * - the size or the modification time of a file read by the object changed (see getInputFiles).
+ *
+ * Blocks deforming in place the linked geometry (apply and Apply block) keep, in memoized mode, a copy
+ * of the undeformed vertex coordinates: if the geometry was not produced again by the upstream blocks
+ * since the last deformation, the undeformed coordinates are restored before deforming it again.
+ * Within a Chain, the undeformed coordinates are restored also before the execution of any upstream
+ * block, so that blocks between the producer of the geometry and the deforming block (e.g. a skipped
+ * reader and a manipulator) always work on the undeformed geometry; the deforming block is then
+ * executed again (see restoreInPlaceDeformation).
+ * Other blocks modifying in place data owned by upstream blocks make the results of such upstream blocks
+ * not reusable: these upstream blocks must not be memoized. \n
+ *
+ * With asynchronous output (setAsyncOutput) the files written by the object, i.e. plot of optional results
+ * and the outputs of writer blocks, are handed off to a background thread (see threads::AsyncWriter) as a
+ * snapshot of the geometry and of the data fields, while the execution goes on. Chain::exec waits for
+ * the outstanding writes at its end; waitAsyncOutput is an explicit barrier. In MPI runs with more than
+ * one process the output is always written synchronously. \n
+ *
+ * With single precision output (setOutputFloat32) the floating point data fields written with the geometry
+ * are converted to single precision when they are handed to the writer: the snapshots kept for asynchronous
+ * output and the written files take half the memory. Only the output is affected, data exchanged through
+ * ports are always in double precision. \n
+ *
  * BaseManipulation controls a initial set of xml attributes which can be read from a xml file interface or written to it,
  * through absorbSectionXML/flushSectionXML methods. Such parameters are:
 
@@ -96,6 +133,9 @@ namespace mimmo{
  * - <B>Apply</B>: boolean 0/1 activate apply result directly in execution;
  * - <B>PlotInExecution</B>: boolean 0/1 print optional results of the class, for debugging purpose.
  * - <B>OutputPlot</B>: target directory for optional results writing.
+ * - <B>Memoize</B>: boolean 0/1 skip execution if inputs and parameters are unchanged since the last execution.
+ * - <B>AsyncOutput</B>: boolean 0/1 write output files in background.
+ * - <B>OutputFloat32</B>: boolean 0/1 write floating point data fields in single precision.
  *
  * All BaseManipulation derived classes inherite these attributes.
  */
@@ -129,6 +169,10 @@ class BaseManipulation{
      * see mimmo::setLoggerDirectory
      */
     friend void mimmo::setLoggerDirectory(std::string dir);
+    /*!
+     * Chain drives the single execution steps in parallel execution mode.
+     */
+    friend class Chain;
 
 public:
     //type definitions
@@ -151,6 +195,8 @@ protected:
                                                             BACKWARD (only input) or FORWARD (only output).*/
     std::unordered_map<PortID, PortIn*>   m_portIn;         /**<Input ports map. */
     std::unordered_map<PortID, PortOut*>  m_portOut;        /**<Output ports map. */
+    std::vector<PortIn*>                  m_portInById;     /**<Input ports indexed by port id (see PortManager), nullptr if missing. */
+    std::vector<PortOut*>                 m_portOutById;    /**<Output ports indexed by port id (see PortManager), nullptr if missing. */
     bool                                  m_arePortsBuilt;  /**<True or false is the ports are already set or not.*/
 
     bool                        m_active;        /**<True/false to activate/disable the object during the execution.*/
@@ -158,10 +204,35 @@ protected:
     bool                        m_apply;         /**<Activate apply result directly in execution.*/
     std::string                 m_outputPlot;    /**<Define path for plotting optional results in execution.*/
 
+    bool                        m_memoize;       /**<Skip execute() if inputs and parameters did not change since the last execution.*/
+    bool                        m_dirty;         /**<True if inputs changed since the last execution.*/
+    bool                        m_executed;      /**<True if execute() was called in the last execution.*/
+    std::size_t                 m_paramHash;     /**<Hash of the parameters of the object at the last execution.*/
+    std::unordered_map<long, std::size_t> m_inputHash;     /**<Hash of the last data received by each input port, by port id.*/
+    MimmoObject *               m_deformedGeometry;     /**<Geometry deformed in place at the last memoized execution.*/
+    std::size_t                 m_deformedRevision;     /**<Coordinates revision of m_deformedGeometry left by the last in place deformation.*/
+    std::vector<long>           m_referenceIds;         /**<Ids of the vertices of m_deformedGeometry.*/
+    std::vector<darray3E>       m_referenceCoords;      /**<Undeformed vertex coordinates of m_deformedGeometry, ordered as m_referenceIds.*/
+    bool                        m_deformationRestored;  /**<True if the undeformed coordinates of m_deformedGeometry were restored by restoreInPlaceDeformation.*/
+    bool                        m_asyncOutput;   /**<Write output files in background.*/
+    bool                        m_outputFloat32; /**<Write floating point data fields in single precision.*/
+
+    /*!
+     * \brief Data field waiting to be attached to the VTK of the geometry written by write().
+     */
+    struct OutputField{
+        std::string name;                                           /**<Name of the field.*/
+        std::function<void(bitpit::VTKUnstructuredGrid &)> attach;  /**<Attach the field, owned by the function, to a VTK.*/
+    };
+    std::vector<OutputField>    m_outputFields;  /**<Data fields to be written with the geometry at the next write().*/
+
     bitpit::Logger*             m_log;           /**<Pointer to logger.*/
 
     //static members
     static  int                 sm_baseManipulationCounter;     /**<Current global number of BaseManipulation object in the instance. */
+    static  threads::SharedMutex sm_executionMutex;             /**<Shared by thread-safe executions, owned exclusively by the other ones. */
+    static  std::mutex          sm_asyncSnapshotsMutex;         /**<Lock of the snapshots retained for asynchronous output. */
+    static  std::vector<std::pair<std::shared_ptr<void>, std::shared_ptr<std::atomic<bool>>>> sm_asyncSnapshots; /**<Snapshots retained for asynchronous output, with completion flag of their task. */
 
 #if MIMMO_ENABLE_MPI
     int							m_nprocs;			/**<Total number of processors.*/
@@ -204,10 +275,16 @@ public:
 
     std::unordered_map<PortID, PortIn*> getPortsIn();
     std::unordered_map<PortID, PortOut*>getPortsOut();
+    PortIn*                             getPortIn(long id);
+    PortOut*                            getPortOut(long id);
 
     bool    isPlotInExecution();
     bool    isActive();
     bool    isApply();
+    bool    isMemoized();
+    bool    isAsyncOutput();
+    bool    isOutputFloat32();
+    bool    wasExecuted();
     int     getId();
 
     void	setLog(bitpit::Logger& log);
@@ -218,6 +295,10 @@ public:
     void    setOutputPlot(std::string path);
     void    setId(int );
     void    setApply(bool flag = true);
+    void    setMemoization(bool flag = true);
+    void    setAsyncOutput(bool flag = true);
+    void    setOutputFloat32(bool flag = true);
+    void    markDirty();
 
     void    activate();
     void    disable();
@@ -230,16 +311,37 @@ public:
 
     void    exec();
 
+    static void waitAsyncOutput();
+    static double getExecutionWaitTime();
+
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name = "");
     virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name= "");
 
     virtual std::vector<BaseManipulation*> getSubBlocksEmbedded();
+    virtual bool isThreadSafe();
 
 protected:
 
     void swap(BaseManipulation & x) noexcept;
     void initializeLogger(bool logexists);
 
+    void runExecution(std::mutex * transferMutex);
+    void runExecutionSteps(std::mutex * transferMutex);
+    void checkMandatoryPorts();
+    void execPortsOut();
+    bool isExecutionRequired();
+    bool isExecutionPending();
+    std::size_t computeParametersHash();
+    virtual std::vector<std::string> getInputFiles();
+    void updateInputHash(long port, std::size_t hash);
+    void beginInPlaceDeformation();
+    void endInPlaceDeformation();
+    bool restoreInPlaceDeformation();
+    std::vector<BaseManipulation*> findInPlaceDeformers();
+    void submitAsyncOutput(threads::AsyncWriter::Task task);
+    void submitAsyncOutput(threads::AsyncWriter::Task task, std::shared_ptr<void> snapshot);
+    static void releaseAsyncSnapshots(bool all = true);
+
     /*!
      * Build ports of the class.
      * Pure virtual method.
@@ -262,6 +364,7 @@ protected:
     void    setBufferIn(PortID port, mimmo::IBinaryStream& input);
     void    readBufferIn(PortID port);
     void    cleanBufferIn(PortID port);
+    void    receiveBufferIn(PortIn* port, mimmo::IBinaryStream& input, std::size_t hash);
 
     void    addParent(BaseManipulation* parent);
     void    addChild(BaseManipulation* child);
@@ -290,6 +393,12 @@ protected:
 
 
     void		    write(MimmoSharedPointer<MimmoObject> geometry);
+    static void     writePatch(bitpit::PatchKernel & patch, const std::vector<OutputField> & fields, const std::string & directory, const std::string & name);
+
+    template<typename T>
+    void            addOutputField(const std::string & name, bitpit::VTKFieldType type, bitpit::VTKLocation loc, std::vector<T> && values);
+    template<typename T>
+    void            pushOutputField(const std::string & name, bitpit::VTKFieldType type, bitpit::VTKLocation loc, std::vector<T> && values);
 
     template<typename mpv_t, typename... Args>
     void		    write(MimmoSharedPointer<MimmoObject> geometry, MimmoPiercedVector<mpv_t> & data, Args ... args);
@@ -37,7 +37,8 @@ BaseManipulation::createPortOut(T* var_, PortID portS){
 
 	//checking if portS containerTAG and dataTAG are registered in mimmo::PortManager
 
-	if(!mimmo::PortManager::instance().containsPort(portS) || m_portOut.count(portS) != 0 ){
+	long id = mimmo::PortManager::instance().getPortId(portS);
+	if(id < 0 || getPortOut(id) != nullptr ){
 		(*m_log)<<"Unable to physically create the Output Port."<<std::endl;
 		(*m_log)<<"Port name was not regularly registered or a port with the same name was already instantiated in the current class."<<std::endl;
 		return check;
@@ -47,6 +48,9 @@ BaseManipulation::createPortOut(T* var_, PortID portS){
 	DataType datat(info.container, info.datatype);
 	PortOutT<T, O>* portOut = new PortOutT<T, O>(var_, datat);
 	m_portOut[portS] = portOut;
+	portOut->m_id = id;
+	if(id >= long(m_portOutById.size())) m_portOutById.resize(id + 1, nullptr);
+	m_portOutById[id] = portOut;
 	check = true;
 	return(check);
 }
@@ -66,7 +70,8 @@ BaseManipulation::createPortOut(O* obj_, T (O::*getVar_)(), PortID portS){
 
 	//checking if portS containerTAG and dataTAG are registered in mimmo::PortManager
 
-	if(!mimmo::PortManager::instance().containsPort(portS) || m_portOut.count(portS) != 0 ){
+	long id = mimmo::PortManager::instance().getPortId(portS);
+	if(id < 0 || getPortOut(id) != nullptr ){
 		(*m_log)<<"Unable to physically create the Output Port."<<std::endl;
 		(*m_log)<<"Port name was not regularly registered or a port with the same name was already instantiated in the current class."<<std::endl;
 		return check;
@@ -76,6 +81,9 @@ BaseManipulation::createPortOut(O* obj_, T (O::*getVar_)(), PortID portS){
 	DataType datat(info.container, info.datatype);
 	PortOutT<T, O>* portOut = new PortOutT<T, O>(obj_, getVar_, datat);
 	m_portOut[portS] = portOut;
+	portOut->m_id = id;
+	if(id >= long(m_portOutById.size())) m_portOutById.resize(id + 1, nullptr);
+	m_portOutById[id] = portOut;
 	check = true;
 	return(check);
 }
@@ -96,7 +104,8 @@ BaseManipulation::createPortIn(T* var_, PortID portR, bool mandatory, int family
 
 	//checking if portR containerTAG and dataTAG are registered in mimmo::PortManager
 
-	if(!mimmo::PortManager::instance().containsPort(portR) || m_portOut.count(portR) != 0 ){
+	long id = mimmo::PortManager::instance().getPortId(portR);
+	if(id < 0 || getPortIn(id) != nullptr ){
 		(*m_log)<<"Unable to physically create the Input Port."<<std::endl;
 		(*m_log)<<"Port name was not regularly registered or a port with the same name was already instantiated in the current class."<<std::endl;
 		return check;
@@ -106,6 +115,9 @@ BaseManipulation::createPortIn(T* var_, PortID portR, bool mandatory, int family
 	DataType datat(info.container, info.datatype);
 	PortInT<T, O>* portIn = new PortInT<T, O>(var_, datat, mandatory, family);
 	m_portIn[portR] = portIn;
+	portIn->m_id = id;
+	if(id >= long(m_portInById.size())) m_portInById.resize(id + 1, nullptr);
+	m_portInById[id] = portIn;
 	check = true;
 	return(check);
 }
@@ -126,7 +138,8 @@ BaseManipulation::createPortIn(O* obj_, void (O::*setVar_)(T), PortID portR, boo
 	bool check = false;
 
 	//checking if portR containerTAG and dataTAG are registered in mimmo::PortManager
-	if(!mimmo::PortManager::instance().containsPort(portR) || m_portOut.count(portR) != 0 ){
+	long id = mimmo::PortManager::instance().getPortId(portR);
+	if(id < 0 || getPortIn(id) != nullptr ){
 		(*m_log)<<"Unable to physically create the Input Port."<<std::endl;
 		(*m_log)<<"Port name was not regularly registered or a port with the same name was already instantiated in the current class."<<std::endl;
 		return check;
@@ -136,10 +149,63 @@ BaseManipulation::createPortIn(O* obj_, void (O::*setVar_)(T), PortID portR, boo
 	DataType datat(info.container, info.datatype);
 	PortInT<T, O>* portIn = new PortInT<T, O>(obj_, setVar_, datat, mandatory, family);
 	m_portIn[portR] = portIn;
+	portIn->m_id = id;
+	if(id >= long(m_portInById.size())) m_portInById.resize(id + 1, nullptr);
+	m_portInById[id] = portIn;
 	check = true;
 	return(check);
 }
 
+/*!
+ * Add a data field to be written with the geometry at the next call of write(geometry).
+ * The values are owned by the field, so that they can be written in background.
+ * With single precision output active, floating point values are converted to single precision.
+ * \param[in] name name of the field
+ * \param[in] type VTK type of the field
+ * \param[in] loc VTK location of the field
+ * \param[in] values values of the field
+ */
+template<typename T>
+void
+BaseManipulation::addOutputField(const std::string & name, bitpit::VTKFieldType type, bitpit::VTKLocation loc, std::vector<T> && values)
+{
+	typedef typename MPVPrecision<T>::float32_type float32_t;
+	if (!m_outputFloat32 || std::is_same<float32_t, T>::value){
+		pushOutputField(name, type, loc, std::move(values));
+		return;
+	}
+
+	std::vector<float32_t> converted(values.size());
+	threads::parallelFor(0, values.size(), [&](std::size_t begin, std::size_t end){
+		for (std::size_t i = begin; i < end; ++i){
+			converted[i] = MPVValueCast<float32_t, T>::apply(values[i]);
+		}
+	});
+	std::vector<T>().swap(values);
+	pushOutputField(name, type, loc, std::move(converted));
+}
+
+/*!
+ * Store a data field to be written with the geometry at the next call of write(geometry),
+ * as it is.
+ * \param[in] name name of the field
+ * \param[in] type VTK type of the field
+ * \param[in] loc VTK location of the field
+ * \param[in] values values of the field
+ */
+template<typename T>
+void
+BaseManipulation::pushOutputField(const std::string & name, bitpit::VTKFieldType type, bitpit::VTKLocation loc, std::vector<T> && values)
+{
+	std::shared_ptr<std::vector<T>> data = std::make_shared<std::vector<T>>(std::move(values));
+	OutputField field;
+	field.name = name;
+	field.attach = [data, name, type, loc](bitpit::VTKUnstructuredGrid & VTK){
+		VTK.addData(name, type, loc, *data);
+	};
+	m_outputFields.push_back(std::move(field));
+}
+
 /*!
  * Write an input geometry given as MimmoObject pointer with an input data field. Input geometry and the geometry linked in the
  * MimmoPiercedVector of data have to be consistent, otherwise the data is skipped.
@@ -161,6 +227,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, MimmoPiercedVe
 	}
 	if (geometry == nullptr){
 		(*m_log) << " Warning: geometry null during writing " << m_name << std::endl;
+		m_outputFields.clear();
 		return;
 	}
 
@@ -176,6 +243,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, MimmoPiercedVe
 	default:
 		(*m_log)<<" Warning: Undefined Reference Location in plotOptionalResults of "<<m_name<<std::endl;
 		(*m_log)<<" Interface or Undefined locations are not supported in VTU writing." <<std::endl;
+		m_outputFields.clear();
 		return;
 		break;
 	}
@@ -201,14 +269,10 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, MimmoPiercedVe
 		return;
 	}
 
-	std::vector<mpv_t> field = data.getDataAsVector();
-
-	geometry->getPatch()->getVTK().addData(data.getName(), fieldtype, loc, field);
+	addOutputField(data.getName(), fieldtype, loc, data.getDataAsVector());
 
 	write(geometry);
 
-	geometry->getPatch()->getVTK().removeData(data.getName());
-
 }
 
 /*!
@@ -233,6 +297,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, MimmoPiercedVe
 	}
 	if (geometry == nullptr){
 		(*m_log) << " Warning: geometry null during writing " << m_name << std::endl;
+		m_outputFields.clear();
 		return;
 	}
 
@@ -247,6 +312,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, MimmoPiercedVe
 	default:
 		(*m_log)<<" Warning: Undefined Reference Location in plotOptionalResults of "<<m_name<<std::endl;
 		(*m_log)<<" Interface or Undefined locations are not supported in VTU writing." <<std::endl;
+		m_outputFields.clear();
 		return;
 		break;
 	}
@@ -272,14 +338,10 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, MimmoPiercedVe
 		return;
 	}
 
-	std::vector<mpv_t> field = data.getDataAsVector();
-
-	geometry->getPatch()->getVTK().addData(data.getName(), fieldtype, loc, field);
+	addOutputField(data.getName(), fieldtype, loc, data.getDataAsVector());
 
 	write(geometry, args...);
 
-	geometry->getPatch()->getVTK().removeData(data.getName());
-
 }
 
 
@@ -296,9 +358,6 @@ template<typename mpv_t>
 void
 BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<MimmoPiercedVector<mpv_t>> & vdata)
 {
-	// Instantiate fields as vector structure
-	std::vector<std::vector<mpv_t>> fields(vdata.size());
-
 	//Deduce data type and add data to vtk object
 	bitpit::VTKFieldType fieldtype;
 	if (std::is_integral<mpv_t>::value == true || std::is_floating_point<mpv_t>::value == true){
@@ -309,11 +368,11 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
 	}
 	else{
 		(*m_log) << " Warning: data type to write not allowed in " << m_name << "; exit" << std::endl;
+		m_outputFields.clear();
 		return;
 	}
 
 	//Loop on all input data
-	std::size_t ifield = 0;
 	for (MimmoPiercedVector<mpv_t> & data : vdata)
 	{
 
@@ -324,6 +383,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
 		}
 		if (geometry == nullptr){
 			(*m_log) << " Warning: geometry null during writing " << m_name << std::endl;
+			m_outputFields.clear();
 			return;
 		}
 
@@ -338,6 +398,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
 		default:
 			(*m_log)<<" Warning: Undefined Reference Location in plotOptionalResults of "<<m_name<<std::endl;
 			(*m_log)<<" Interface or Undefined locations are not supported in VTU writing." <<std::endl;
+			m_outputFields.clear();
 			return;
 			break;
 		}
@@ -348,22 +409,12 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
 			continue;
 		}
 
-		fields[ifield] = data.getDataAsVector();
-
-		geometry->getPatch()->getVTK().addData(data.getName(), fieldtype, loc, fields[ifield]);
-
-		ifield++;
+		addOutputField(data.getName(), fieldtype, loc, data.getDataAsVector());
 
 	} // End loop on data fields
 
 	write(geometry);
 
-	//Loop on all input data to remove fields from vtk object
-	for (MimmoPiercedVector<mpv_t> & data : vdata)
-	{
-		geometry->getPatch()->getVTK().removeData(data.getName());
-	}
-
 }
 
 /*!
@@ -383,9 +434,6 @@ template<typename mpv_t, typename... Args>
 void
 BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<MimmoPiercedVector<mpv_t>> & vdata, Args ... args)
 {
-	// Instantiate fields as vector structure
-	std::vector<std::vector<mpv_t>> fields(vdata.size());
-
 	//Deduce data type and add data to vtk object
 	bitpit::VTKFieldType fieldtype;
 	if (std::is_integral<mpv_t>::value == true || std::is_floating_point<mpv_t>::value == true){
@@ -401,7 +449,6 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
 	}
 
 	//Loop on all input data
-	std::size_t ifield = 0;
 	for (MimmoPiercedVector<mpv_t> & data : vdata)
 	{
 
@@ -412,6 +459,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
 		}
 		if (geometry == nullptr){
 			(*m_log) << " Warning: geometry null during writing " << m_name << std::endl;
+			m_outputFields.clear();
 			return;
 		}
 
@@ -426,6 +474,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
 		default:
 			(*m_log)<<" Warning: Undefined Reference Location in plotOptionalResults of "<<m_name<<std::endl;
 			(*m_log)<<" Interface or Undefined locations are not supported in VTU writing." <<std::endl;
+			m_outputFields.clear();
 			return;
 			break;
 		}
@@ -436,22 +485,12 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
 			continue;
 		}
 
-		fields[ifield] = data.getDataAsVector();
-
-		geometry->getPatch()->getVTK().addData(data.getName(), fieldtype, loc, fields[ifield]);
-
-		ifield++;
+		addOutputField(data.getName(), fieldtype, loc, data.getDataAsVector());
 
 	} // End loop on data fields
 
 	write(geometry, args...);
 
-	//Loop on all input data to remove fields from vtk object
-	for (MimmoPiercedVector<mpv_t> & data : vdata)
-	{
-		geometry->getPatch()->getVTK().removeData(data.getName());
-	}
-
 }
 
 
@@ -469,9 +508,6 @@ template<typename mpv_t>
 void
 BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<MimmoPiercedVector<mpv_t>*> & vdata)
 {
-    // Instantiate fields as vector structure
-    std::vector<std::vector<mpv_t>> fields(vdata.size());
-
     //Deduce data type and add data to vtk object
     bitpit::VTKFieldType fieldtype;
     if (std::is_integral<mpv_t>::value == true || std::is_floating_point<mpv_t>::value == true){
@@ -482,11 +518,11 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
     }
     else{
         (*m_log) << " Warning: data type to write not allowed in " << m_name << "; exit" << std::endl;
+        m_outputFields.clear();
         return;
     }
 
     //Loop on all input data
-    std::size_t ifield = 0;
     for (MimmoPiercedVector<mpv_t>* data : vdata)
     {
 
@@ -497,6 +533,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
         }
         if (geometry == nullptr){
             (*m_log) << " Warning: geometry null during writing " << m_name << std::endl;
+            m_outputFields.clear();
             return;
         }
 
@@ -511,6 +548,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
         default:
             (*m_log)<<" Warning: Undefined Reference Location in plotOptionalResults of "<<m_name<<std::endl;
             (*m_log)<<" Interface or Undefined locations are not supported in VTU writing." <<std::endl;
+            m_outputFields.clear();
             return;
             break;
         }
@@ -521,22 +559,12 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
             continue;
         }
 
-        fields[ifield] = data->getDataAsVector();
-
-        geometry->getPatch()->getVTK().addData(data->getName(), fieldtype, loc, fields[ifield]);
-
-        ifield++;
+        addOutputField(data->getName(), fieldtype, loc, data->getDataAsVector());
 
     } // End loop on data fields
 
     write(geometry);
 
-    //Loop on all input data to remove fields from vtk object
-    for (MimmoPiercedVector<mpv_t> * data : vdata)
-    {
-        geometry->getPatch()->getVTK().removeData(data->getName());
-    }
-
 }
 
 /*!
@@ -553,9 +581,6 @@ template<typename mpv_t, typename... Args>
 void
 BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<MimmoPiercedVector<mpv_t>*> & vdata, Args ... args)
 {
-    // Instantiate fields as vector structure
-    std::vector<std::vector<mpv_t>> fields(vdata.size());
-
     //Deduce data type and add data to vtk object
     bitpit::VTKFieldType fieldtype;
     if (std::is_integral<mpv_t>::value == true || std::is_floating_point<mpv_t>::value == true){
@@ -571,7 +596,6 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
     }
 
     //Loop on all input data
-    std::size_t ifield = 0;
     for (MimmoPiercedVector<mpv_t> * data : vdata)
     {
 
@@ -582,6 +606,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
         }
         if (geometry == nullptr){
             (*m_log) << " Warning: geometry null during writing " << m_name << std::endl;
+            m_outputFields.clear();
             return;
         }
 
@@ -596,6 +621,7 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
         default:
             (*m_log)<<" Warning: Undefined Reference Location in plotOptionalResults of "<<m_name<<std::endl;
             (*m_log)<<" Interface or Undefined locations are not supported in VTU writing." <<std::endl;
+            m_outputFields.clear();
             return;
             break;
         }
@@ -606,22 +632,12 @@ BaseManipulation::write(MimmoSharedPointer<MimmoObject> geometry, std::vector<Mi
             continue;
         }
 
-        fields[ifield] = data->getDataAsVector();
-
-        geometry->getPatch()->getVTK().addData(data->getName(), fieldtype, loc, fields[ifield]);
-
-        ifield++;
+        addOutputField(data->getName(), fieldtype, loc, data->getDataAsVector());
 
     } // End loop on data fields
 
     write(geometry, args...);
 
-    //Loop on all input data to remove fields from vtk object
-    for (MimmoPiercedVector<mpv_t> * data : vdata)
-    {
-        geometry->getPatch()->getVTK().removeData(data->getName());
-    }
-
 }
 
 };
@@ -22,6 +22,11 @@
  *
 \*---------------------------------------------------------------------------*/
 #include "Chain.hpp"
+#include "mimmoThreads.hpp"
+#include "mimmoProfiler.hpp"
+#include <atomic>
+#include <map>
+#include <unordered_map>
 
 namespace mimmo{
 
@@ -39,6 +44,9 @@ Chain::Chain(){
     sm_chaincounter++;
     m_plotDebRes = false;
     m_outputDebRes = ".";
+    m_parallel = false;
+    m_memoize = false;
+    m_asyncOutput = false;
     m_log = &bitpit::log::cout(MIMMO_LOG_FILE);
 };
 
@@ -62,6 +70,9 @@ void Chain::swap(Chain & x) noexcept{
     std::swap(m_objcounter,x.m_objcounter);
     std::swap(m_plotDebRes,x.m_plotDebRes);
     std::swap(m_outputDebRes,x.m_outputDebRes);
+    std::swap(m_parallel,x.m_parallel);
+    std::swap(m_memoize,x.m_memoize);
+    std::swap(m_asyncOutput,x.m_asyncOutput);
 };
 
 /*!
@@ -73,6 +84,9 @@ std::unique_ptr<Chain>  Chain::clone() const{
     std::unique_ptr<Chain> res(new Chain());
     res->setOutputDebugResults(m_outputDebRes);
     res->setPlotDebugResults(m_plotDebRes);
+    res->setParallelExecution(m_parallel);
+    res->setMemoizedExecution(m_memoize);
+    res->setAsyncOutput(m_asyncOutput);
 
     int count(0);
     for(BaseManipulation * pp : m_objects){
@@ -272,17 +286,74 @@ std::string Chain::getOutputDebugResults(){
     return m_outputDebRes;
 }
 
+/*!
+ * Activate the parallel execution of the chain. Objects whose parents have
+ * all been executed are run concurrently on a pool of
+ * mimmo::threads::getNumberOfThreads() threads. See the class documentation
+ * for the constraints of the parallel execution mode.
+ * \param[in] active true/false to activate parallel execution
+ */
+void Chain::setParallelExecution(bool active){
+    m_parallel = active;
+}
+
+/*!
+ * \return true if parallel execution of the chain is active.
+ */
+bool Chain::isParallelExecution(){
+    return m_parallel;
+}
+
+/*!
+ * Activate the memoized execution of all the objects of the chain. In repeated
+ * executions, objects whose inputs and parameters did not change since their
+ * last execution are skipped (see BaseManipulation::setMemoization).
+ * If not active, the memoization settings of the single objects are used.
+ * \param[in] active true/false to activate memoized execution
+ */
+void Chain::setMemoizedExecution(bool active){
+    m_memoize = active;
+}
+
+/*!
+ * \return true if memoized execution of all the objects of the chain is active.
+ */
+bool Chain::isMemoizedExecution(){
+    return m_memoize;
+}
+
+/*!
+ * Activate the asynchronous output of all the objects of the chain: output files and
+ * debug results are written in background while the execution goes on
+ * (see BaseManipulation::setAsyncOutput). exec() returns when all the files are written.
+ * If not active, the asynchronous output settings of the single objects are used.
+ * \param[in] active true/false to activate asynchronous output
+ */
+void Chain::setAsyncOutput(bool active){
+    m_asyncOutput = active;
+}
+
+/*!
+ * \return true if asynchronous output of all the objects of the chain is active.
+ */
+bool Chain::isAsyncOutput(){
+    return m_asyncOutput;
+}
+
 
 /*!
  * It executes the chain, i.e. it executes all the manipulator objects
  * contained in the chain following the correct order.
  * In the case that a loop exists in the chain the execution doesn't start and
  * the process ends with an error.
+ * Output files written asynchronously by the objects are complete on return.
  * \param[in]	debug boolean to activate verbose execution mode.
  */
 void
 Chain::exec(bool debug){
 
+    ProfileScope chainScope("Chain " + std::to_string(int(m_id)), "chain");
+
     std::vector<BaseManipulation*>::iterator it, itb = m_objects.begin();
     std::vector<BaseManipulation*>::iterator itend = m_objects.end();
     bitpit::log::Priority oldPriority = m_log->getPriority();
@@ -299,6 +370,15 @@ Chain::exec(bool debug){
     }
     (*m_log) << " " << std::endl;
     checkLoops();
+    if(m_parallel && canExecuteInParallel()){
+        execParallel();
+        BaseManipulation::waitAsyncOutput();
+        (*m_log) << " " << std::endl;
+        (*m_log) << "--------------------------------------------------" << std::endl;
+        (*m_log) << " " << std::endl;
+        m_log->setPriority(oldPriority);
+        return;
+    }
     int i = 1;
     for (it = itb; it != itend; ++it){
         if(debug)
@@ -309,9 +389,19 @@ Chain::exec(bool debug){
             (*it)->setPlotInExecution(m_plotDebRes);
             (*it)->setOutputPlot(m_outputDebRes);
         }
+        if(m_memoize){
+            (*it)->setMemoization(true);
+        }
+        if(m_asyncOutput){
+            (*it)->setAsyncOutput(true);
+        }
+        if((*it)->isExecutionPending()){
+            restoreInPlaceDeformations(*it, nullptr);
+        }
         (*it)->exec();
         i++;
     }
+    BaseManipulation::waitAsyncOutput();
 
     (*m_log) << " " << std::endl;
     (*m_log) << "--------------------------------------------------" << std::endl;
@@ -319,6 +409,161 @@ Chain::exec(bool debug){
     m_log->setPriority(oldPriority);
 }
 
+/*!
+ * Check if the chain can be executed in parallel. Parallel execution is skipped
+ * if a single thread is available, if the chain holds less than two objects or,
+ * in MPI runs, if any object works on more than one process.
+ * \return true if the chain can be executed in parallel.
+ */
+bool
+Chain::canExecuteInParallel(){
+    if(m_objects.size() < 2 || threads::getNumberOfThreads() < 2) return false;
+#if MIMMO_ENABLE_MPI
+    for(BaseManipulation * obj : m_objects){
+        if(obj->getProcessorCount() > 1){
+            (*m_log) << " parallel execution of chain disabled in MPI runs with more than one process " << std::endl;
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+/*!
+ * Execute the chain on a work-stealing thread pool. Each object is submitted
+ * as soon as all its parents in the chain have completed their execution.
+ * Only objects declared thread-safe (see BaseManipulation::isThreadSafe) and not
+ * plotting results run concurrently with each other; any other object runs alone,
+ * since it may change the priority of the shared logger or create patches.
+ * Objects sharing the same target geometry are executed one at a time and the
+ * transfers of data through output ports are serialized.
+ * The first exception thrown by an object is rethrown once the running objects
+ * have completed; the children of the failed object are not executed.
+ */
+void
+Chain::execParallel(){
+
+    std::size_t nObjects = m_objects.size();
+
+    // Build dependency graph from parent/child links internal to the chain.
+    std::unordered_map<BaseManipulation*, std::size_t> indices;
+    for(std::size_t i = 0; i < nObjects; ++i){
+        indices[m_objects[i]] = i;
+    }
+    std::vector<std::vector<std::size_t>> children(nObjects);
+    std::unique_ptr<std::atomic<int>[]> nWaitingParents(new std::atomic<int>[nObjects]);
+    for(std::size_t i = 0; i < nObjects; ++i){
+        nWaitingParents[i] = 0;
+    }
+    for(std::size_t i = 0; i < nObjects; ++i){
+        for(int j = 0; j < m_objects[i]->getNChild(); ++j){
+            auto itChild = indices.find(m_objects[i]->getChild(j));
+            if(itChild == indices.end()) continue;
+            children[i].push_back(itChild->second);
+            ++nWaitingParents[itChild->second];
+        }
+    }
+
+    threads::WorkStealingPool pool;
+    (*m_log) << " Parallel execution on " << pool.getNumberOfWorkers() << " threads" << std::endl;
+    (*m_log) << " " << std::endl;
+
+    // Serialize lines written on the shared logger by concurrent objects.
+    std::streambuf * logBuffer = m_log->rdbuf();
+    std::unique_ptr<threads::SynchronizedStreamBuffer> syncLogBuffer(new threads::SynchronizedStreamBuffer(logBuffer));
+    m_log->rdbuf(syncLogBuffer.get());
+
+    std::mutex chainMutex;
+    std::map<MimmoObject*, std::unique_ptr<std::mutex>> geometryMutexes;
+    int counter = 1;
+
+    std::function<void(std::size_t)> execObject = [&](std::size_t index){
+        BaseManipulation * obj = m_objects[index];
+
+        std::mutex * geometryMutex = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(chainMutex);
+            (*m_log) << " execution object " << counter << "	: " << obj->getName() << std::endl;
+            ++counter;
+            if(m_plotDebRes){
+                obj->setPlotInExecution(m_plotDebRes);
+                obj->setOutputPlot(m_outputDebRes);
+            }
+            if(m_memoize){
+                obj->setMemoization(true);
+            }
+            if(m_asyncOutput){
+                obj->setAsyncOutput(true);
+            }
+            MimmoObject * geometry = obj->getGeometry().get();
+            if(geometry){
+                std::unique_ptr<std::mutex> & mutex = geometryMutexes[geometry];
+                if(!mutex) mutex.reset(new std::mutex());
+                geometryMutex = mutex.get();
+            }
+        }
+
+        // Descendants of the object cannot run before it: their geometries are locked only
+        // against other running objects.
+        if(obj->isExecutionPending()){
+            restoreInPlaceDeformations(obj, [&](MimmoObject * geometry){
+                std::lock_guard<std::mutex> lock(chainMutex);
+                std::unique_ptr<std::mutex> & mutex = geometryMutexes[geometry];
+                if(!mutex) mutex.reset(new std::mutex());
+                return mutex.get();
+            });
+        }
+
+        {
+            std::unique_lock<std::mutex> geometryLock;
+            if(geometryMutex) geometryLock = std::unique_lock<std::mutex>(*geometryMutex);
+
+            // Non thread-safe objects run alone (see BaseManipulation::runExecution).
+            obj->runExecution(&chainMutex);
+        }
+
+        for(std::size_t child : children[index]){
+            if(--nWaitingParents[child] == 0){
+                pool.submit([&execObject, child](){ execObject(child); });
+            }
+        }
+    };
+
+    for(std::size_t i = 0; i < nObjects; ++i){
+        if(nWaitingParents[i] == 0){
+            pool.submit([&execObject, i](){ execObject(i); });
+        }
+    }
+
+    try{
+        pool.wait();
+    }catch(...){
+        m_log->rdbuf(logBuffer);
+        throw;
+    }
+    m_log->rdbuf(logBuffer);
+}
+
+/*!
+ * Restore the undeformed coordinates of the geometries deformed in place by the memoized
+ * descendants of an object about to be executed (see BaseManipulation::restoreInPlaceDeformation),
+ * so that the object never works on a geometry deformed by a previous execution of the chain.
+ * The deforming descendants are executed again.
+ * \param[in] object object about to be executed
+ * \param[in] geometryMutex if not null, function returning the mutex to be locked while
+ * restoring a geometry
+ */
+void
+Chain::restoreInPlaceDeformations(BaseManipulation * object, std::function<std::mutex*(MimmoObject*)> geometryMutex){
+    for(BaseManipulation * deformer : object->findInPlaceDeformers()){
+        std::unique_lock<std::mutex> lock;
+        if(geometryMutex) lock = std::unique_lock<std::mutex>(*geometryMutex(deformer->getGeometry().get()));
+        if(deformer->restoreInPlaceDeformation()){
+            (*m_log) << " " << deformer->getName() << " : geometry deformed in place restored before the execution of " << object->getName() << std::endl;
+        }
+    }
+}
+
 /*!
  * It executes one manipulator object contained in the chain singularly.
  * \param[in] idobj ID of the target manipulator object.
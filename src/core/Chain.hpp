@@ -26,6 +26,8 @@
 
 #include "BaseManipulation.hpp"
 #include <memory>
+#include <mutex>
+#include <functional>
 
 namespace mimmo{
 
@@ -44,6 +46,37 @@ namespace mimmo{
  * conflicts in parent/child dependencies.
  * Closed connections loops in the chain are not allowed.
  *
+ * By default the objects are executed serially, in the order of the chain.
+ * With setParallelExecution(true) the chain works as a dataflow scheduler: the dependency
+ * graph is built from the parent/child links of the objects and every object is
+ * submitted to a work-stealing thread pool (see mimmo::threads::WorkStealingPool) as soon as
+ * all its parents in the chain have completed their execution and transferred their output
+ * data. The pool size is given by mimmo::threads::getNumberOfThreads().
+ * In parallel execution mode:
+ * - only objects declared thread-safe (see BaseManipulation::isThreadSafe) run concurrently
+ *   with each other; the other objects, e.g. the ones changing the priority of the shared
+ *   logger or creating new geometries, run alone, and so do objects plotting their results;
+ * - objects working on the same target geometry are executed one at a time;
+ * - the data transfers through the output ports are serialized, since different parents
+ *   may write concurrently to the same child;
+ * - lines written by the objects on the shared mimmo logger are serialized, but lines of
+ *   concurrent objects can be interleaved in the log;
+ * - objects must not modify concurrently geometries or data they do not own
+ *   (e.g. a geometry passed through a secondary port while another object deforms it).
+ *
+ * In MPI runs with more than one process the chain is always executed serially,
+ * since concurrent execution of the objects could mix the order of collective communications.
+ *
+ * With setMemoizedExecution(true) the memoized execution is activated on every object of the chain
+ * (see BaseManipulation::setMemoization): in repeated executions, objects whose inputs and parameters
+ * did not change are skipped and forward their stored results. Before the execution of an object,
+ * the geometries deformed in place by its memoized descendants are restored to their undeformed
+ * coordinates, so that blocks placed between a skipped producer of a geometry and the block
+ * deforming it never work on the geometry deformed by a previous execution.
+ *
+ * With setAsyncOutput(true) the output files and debug results of every object of the chain are
+ * written in background (see BaseManipulation::setAsyncOutput); exec() waits for them before returning.
+ *
  */
 class Chain{
 
@@ -58,6 +91,9 @@ protected:
 
     bool                            m_plotDebRes;       /**<boolean to activate plotting of debug intermediate results */
     std::string                     m_outputDebRes;     /**<directory path to store the debug intermediate results, if plot is enabled*/
+    bool                            m_parallel;         /**<boolean to activate the parallel execution of independent objects */
+    bool                            m_memoize;          /**<boolean to activate the memoized execution of all the objects */
+    bool                            m_asyncOutput;      /**<boolean to activate the asynchronous output of all the objects */
 	//static members
 	static	uint8_t					sm_chaincounter;	/**<Current global number of chain in the instance. */
 
@@ -85,6 +121,15 @@ public:
     bool            isPlottingDebugResults();
     std::string     getOutputDebugResults();
 
+    void            setParallelExecution(bool active);
+    bool            isParallelExecution();
+
+    void            setMemoizedExecution(bool active);
+    bool            isMemoizedExecution();
+
+    void            setAsyncOutput(bool active);
+    bool            isAsyncOutput();
+
 	//relationship methods
 	void 		exec(bool debug = false);
 	void 		exec(int idobj);
@@ -94,6 +139,10 @@ protected:
     //check methods
 	void		checkLoops();
 
+    bool        canExecuteInParallel();
+    void        execParallel();
+    void        restoreInPlaceDeformations(BaseManipulation * object, std::function<std::mutex*(MimmoObject*)> geometryMutex);
+
 private:
     // preventing copy constr and assignment. use clone instead.
     Chain(const Chain & other);
@@ -0,0 +1,186 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "DesignSweep.hpp"
+#include "mimmoThreads.hpp"
+#include <atomic>
+#include <chrono>
+
+namespace mimmo{
+
+/*!
+ * Default constructor of DesignSweep.
+ */
+DesignSweep::DesignSweep(){
+    m_log = &bitpit::log::cout(MIMMO_LOG_FILE);
+}
+
+/*!
+ * Default destructor of DesignSweep.
+ */
+DesignSweep::~DesignSweep(){}
+
+/*!
+ * \return number of replicas of the workflow.
+ */
+std::size_t
+DesignSweep::getNReplicas(){
+    return m_replicas.size();
+}
+
+/*!
+ * Add a replica of the workflow. The blocks of the replica must be independent
+ * instances, not shared with the other replicas.
+ * \param[in] chains chains of the replica, in order of execution
+ */
+void
+DesignSweep::addReplica(const std::vector<Chain*> & chains){
+    m_replicas.push_back(chains);
+}
+
+/*!
+ * Set the function updating the parameters of the blocks of a replica for a design.
+ * It is called before the execution of the chains of the replica.
+ * \param[in] setter function called as setter(design, replica)
+ */
+void
+DesignSweep::setDesignSetter(DesignSetter setter){
+    m_setter = setter;
+}
+
+/*!
+ * Set the function called on completion of each design.
+ * \param[in] observer function called as observer(result)
+ */
+void
+DesignSweep::setDesignObserver(DesignObserver observer){
+    m_observer = observer;
+}
+
+/*!
+ * Evaluate a design with a replica.
+ * \param[in] design index of the design
+ * \param[in] replica index of the replica
+ * \param[out] result result of the evaluation
+ */
+void
+DesignSweep::evaluate(std::size_t design, std::size_t replica, DesignResult & result){
+    result.design = design;
+    result.replica = replica;
+    result.success = true;
+    result.message.clear();
+    auto start = std::chrono::steady_clock::now();
+    double waitStart = BaseManipulation::getExecutionWaitTime();
+    try{
+        if(m_setter) m_setter(design, replica);
+        for(Chain * chain : m_replicas[replica]){
+            chain->exec();
+        }
+    }catch(std::exception & e){
+        result.success = false;
+        result.message = e.what();
+    }catch(...){
+        // Exceptions must not escape the worker threads of the sweep.
+        result.success = false;
+        result.message = "unknown exception";
+    }
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.waitTime = BaseManipulation::getExecutionWaitTime() - waitStart;
+}
+
+/*!
+ * Evaluate the designs 0, ..., nDesigns-1. Replicas evaluate the designs concurrently;
+ * a failed design does not stop the sweep.
+ * \param[in] nDesigns number of designs
+ * \return results of the designs, sorted by design index.
+ */
+std::vector<DesignSweep::DesignResult>
+DesignSweep::run(std::size_t nDesigns){
+
+    if(m_replicas.empty()) throw std::runtime_error("DesignSweep: no replica of the workflow available");
+
+    std::size_t nWorkers = std::min(m_replicas.size(), nDesigns);
+#if MIMMO_ENABLE_MPI
+    int nprocs = 1;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if(nprocs > 1 && nWorkers > 1) nWorkers = 1;
+#endif
+
+    for(std::size_t replica = 0; replica < m_replicas.size(); ++replica){
+        for(Chain * chain : m_replicas[replica]){
+            chain->setMemoizedExecution(true);
+            if(nWorkers > 1) chain->setParallelExecution(false);
+        }
+    }
+
+    (*m_log) << " Design sweep : " << nDesigns << " designs on " << nWorkers << " replicas" << std::endl;
+
+    std::vector<DesignResult> results(nDesigns);
+    std::atomic<std::size_t> nextDesign(0);
+    std::mutex observerMutex;
+    std::exception_ptr observerError;
+
+    auto worker = [&](std::size_t replica){
+        while(true){
+            std::size_t design = nextDesign++;
+            if(design >= nDesigns) break;
+            evaluate(design, replica, results[design]);
+            std::lock_guard<std::mutex> lock(observerMutex);
+            (*m_log) << " design " << design << (results[design].success ? " completed" : " failed : " + results[design].message)
+                     << " in " << results[design].time << " s (" << results[design].waitTime << " s waiting for other replicas)" << std::endl;
+            if(m_observer && !observerError){
+                try{
+                    m_observer(results[design]);
+                }catch(...){
+                    observerError = std::current_exception();
+                }
+            }
+        }
+    };
+
+    if(nWorkers < 2){
+        worker(0);
+    }else{
+        // Serialize lines written on the shared logger by concurrent replicas.
+        std::streambuf * logBuffer = m_log->rdbuf();
+        std::unique_ptr<threads::SynchronizedStreamBuffer> syncLogBuffer(new threads::SynchronizedStreamBuffer(logBuffer));
+        m_log->rdbuf(syncLogBuffer.get());
+
+        std::vector<std::thread> threads;
+        threads.reserve(nWorkers - 1);
+        for(std::size_t replica = 1; replica < nWorkers; ++replica){
+            threads.emplace_back(worker, replica);
+        }
+        worker(0);
+        for(std::thread & thread : threads){
+            thread.join();
+        }
+        m_log->rdbuf(logBuffer);
+    }
+
+    if(observerError) std::rethrow_exception(observerError);
+    return results;
+}
+
+}
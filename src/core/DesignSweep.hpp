@@ -0,0 +1,108 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#ifndef __DESIGNSWEEP_HPP__
+#define __DESIGNSWEEP_HPP__
+
+#include "Chain.hpp"
+#include <functional>
+
+namespace mimmo{
+
+/*!
+ * \class DesignSweep
+ * \ingroup core
+ * \brief DesignSweep evaluates a workflow over a list of design parameter sets.
+ *
+ * A sweep works on one or more replicas of the same workflow: a replica is the list of
+ * chains, in order of execution, of an independent instance of the workflow blocks.
+ * For each design, a user defined setter updates the parameters of the blocks of the
+ * replica in charge (e.g. FFD displacements, output file names), then the chains of the
+ * replica are executed.
+ *
+ * The chains of each replica are executed in memoized mode (see Chain::setMemoizedExecution):
+ * the setup blocks not depending on the design parameters (readers, tree builds, operator
+ * factorizations) are executed only for the first design evaluated by the replica, and their
+ * results are shared read-only by the following designs of the same replica. Setup blocks
+ * whose results are not deformed in place by the designs (see BaseManipulation::setApply) can
+ * be shared by all the replicas too: leave them out of the chains of the replicas, link them to
+ * the blocks of each replica and execute them once before run(), as mimmo++ sweep mode does.
+ *
+ * Replicas evaluate different designs concurrently, one thread per replica, picking the next
+ * design to be evaluated as soon as they complete the previous one. As in parallel chains, only
+ * thread-safe blocks of different replicas run concurrently (see BaseManipulation::runExecution),
+ * the other blocks run alone, and the time a design spends waiting for them is reported in its
+ * result (see DesignResult::waitTime); the observer function, the design setter and the output of the
+ * blocks overlap with the execution of the other replicas. The observer function,
+ * if set, is called as soon as each design is completed (calls are serialized), so that
+ * its results can be streamed to disk while the sweep is running.
+ * The blocks of different replicas must not share data modified during the execution.
+ *
+ * In MPI runs with more than one process, all the processes evaluate the designs one at a
+ * time with the first replica, since the blocks work on the whole communicator.
+ */
+class DesignSweep{
+
+public:
+    /*!
+     * \brief Result of the evaluation of a design.
+     */
+    struct DesignResult{
+        std::size_t design;     /**< Index of the design.*/
+        std::size_t replica;    /**< Index of the replica evaluating the design.*/
+        bool        success;    /**< True if the evaluation succeeded.*/
+        double      time;       /**< Wall time of the evaluation in seconds.*/
+        double      waitTime;   /**< Part of time spent waiting for blocks executed by other replicas.*/
+        std::string message;    /**< Error message, if the evaluation failed.*/
+    };
+
+    typedef std::function<void(std::size_t design, std::size_t replica)>   DesignSetter;   /**< Function setting the parameters of a design on a replica.*/
+    typedef std::function<void(const DesignResult & result)>                DesignObserver; /**< Function called on completion of a design.*/
+
+    DesignSweep();
+    virtual ~DesignSweep();
+
+    std::size_t     getNReplicas();
+    void            addReplica(const std::vector<Chain*> & chains);
+    void            setDesignSetter(DesignSetter setter);
+    void            setDesignObserver(DesignObserver observer);
+
+    std::vector<DesignResult> run(std::size_t nDesigns);
+
+protected:
+    std::vector<std::vector<Chain*>>    m_replicas; /**< Chains of each replica of the workflow.*/
+    DesignSetter                        m_setter;   /**< Setter of the design parameters.*/
+    DesignObserver                      m_observer; /**< Observer of the completed designs.*/
+    bitpit::Logger*                     m_log;      /**< Pointer to logger.*/
+
+    void evaluate(std::size_t design, std::size_t replica, DesignResult & result);
+
+private:
+    DesignSweep(const DesignSweep & other) = delete;
+    DesignSweep & operator=(const DesignSweep & other) = delete;
+};
+
+}
+
+#endif /* __DESIGNSWEEP_HPP__ */
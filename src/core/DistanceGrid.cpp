@@ -0,0 +1,337 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+#include "DistanceGrid.hpp"
+#include <unordered_set>
+
+namespace mimmo{
+
+/*!
+ * Default constructor of DistanceGrid.
+ */
+DistanceGrid::DistanceGrid(){
+    m_spacing = 0.0;
+    m_fallbackTol = 0.0;
+    m_origin.fill(0.0);
+    m_dim.fill(0);
+    m_isSet = false;
+    m_target = nullptr;
+    m_targetTopologyRevision = 0;
+    m_targetCoordsRevision = 0;
+}
+
+/*!
+ * Default destructor of DistanceGrid.
+ */
+DistanceGrid::~DistanceGrid(){}
+
+/*!
+ * Set the exact distance evaluator. Cached values are not invalidated.
+ * \param[in] evaluator function computing exact distances of a list of points.
+ */
+void
+DistanceGrid::setEvaluator(DistanceGrid::Evaluator evaluator){
+    m_evaluator = evaluator;
+}
+
+/*!
+ * Set the spacing of the cartesian grid. A change of the spacing invalidates
+   the cached values and the grid must be set up again.
+ * \param[in] spacing grid spacing (> 0).
+ */
+void
+DistanceGrid::setSpacing(double spacing){
+    spacing = std::max(0.0, spacing);
+    if(spacing != m_spacing){
+        m_spacing = spacing;
+        clear();
+    }
+}
+
+/*!
+ * Set the exact fallback tolerance. Points with interpolated distance lower
+   than the tolerance in absolute value are evaluated exactly.
+ * \param[in] tol fallback tolerance (>=0).
+ */
+void
+DistanceGrid::setFallbackTolerance(double tol){
+    m_fallbackTol = std::max(0.0, tol);
+}
+
+/*!
+ * \return grid spacing.
+ */
+double
+DistanceGrid::getSpacing() const{
+    return m_spacing;
+}
+
+/*!
+ * \return exact fallback tolerance.
+ */
+double
+DistanceGrid::getFallbackTolerance() const{
+    return m_fallbackTol;
+}
+
+/*!
+ * \return number of grid nodes with a cached distance value.
+ */
+std::size_t
+DistanceGrid::getCachedNodeCount() const{
+    return m_nodes.size();
+}
+
+/*!
+ * \return true if the grid is set up on a target geometry.
+ */
+bool
+DistanceGrid::isSet() const{
+    return m_isSet;
+}
+
+/*!
+ * Set up the grid on a target geometry. The grid covers the global bounding
+   box of the target, enlarged in each direction by the padding value.
+   If the grid is already set up on the same unmodified target, nothing is done and
+   the cached values are preserved.
+ * \param[in] target target geometry of the distance field.
+ * \param[in] padding enlargement of the target bounding box.
+ * \return true if the cached values are preserved, false if the cache was reset.
+ */
+bool
+DistanceGrid::setup(MimmoSharedPointer<MimmoObject> target, double padding){
+
+    if(target == nullptr || m_spacing <= 0.0){
+        clear();
+        return false;
+    }
+
+    if(isSameTarget(target)){
+        return true;
+    }
+
+    if(target->getBoundingBoxSyncStatus() != SyncStatus::SYNC){
+        target->update();
+    }
+    std::array<double,3> bMin, bMax;
+    target->getBoundingBox(bMin, bMax, true);
+
+    clear();
+
+    padding = std::max(padding, m_spacing);
+    for(int i=0; i<3; ++i){
+        m_origin[i] = bMin[i] - padding;
+        m_dim[i] = long(std::ceil((bMax[i] - bMin[i] + 2.0*padding) / m_spacing)) + 1;
+    }
+
+    m_target = target.get();
+    m_targetTopologyRevision = target->getTopologyRevision();
+    m_targetCoordsRevision = target->getCoordinatesRevision();
+    m_isSet = true;
+
+    return false;
+}
+
+/*!
+ * Evaluate the distance of a list of points, interpolating the cached grid values
+   where possible and calling the exact evaluator elsewhere.
+   Missing node values required by the interpolation are computed and cached.
+   In MPI versions this method must be called by all the ranks, since the evaluator
+   is always called, even with empty lists.
+ * \param[in] points list of points.
+ * \param[out] distances distances of the points.
+ */
+void
+DistanceGrid::evaluate(const std::vector<std::array<double,3>> & points, std::vector<double> & distances){
+
+    if(!m_evaluator){
+        throw std::runtime_error("DistanceGrid: no exact distance evaluator is set.");
+    }
+
+    std::size_t nP = points.size();
+    distances.resize(nP);
+
+    if(!m_isSet){
+        m_evaluator(points, distances);
+        return;
+    }
+
+    // Locate the grid cell of each point and collect the missing node values.
+    std::vector<std::array<long,3>> cells(nP);
+    std::vector<bool> exact(nP, false);
+    std::unordered_set<long> missing;
+    std::array<long,3> ijk;
+    for(std::size_t ip=0; ip<nP; ++ip){
+        bool inside = true;
+        for(int d=0; d<3; ++d){
+            double loc = (points[ip][d] - m_origin[d]) / m_spacing;
+            ijk[d] = long(std::floor(loc));
+            inside = inside && (ijk[d] >= 0) && (ijk[d] < m_dim[d] - 1);
+        }
+        if(!inside){
+            exact[ip] = true;
+            continue;
+        }
+        cells[ip] = ijk;
+        for(int n=0; n<8; ++n){
+            long key = nodeKey(ijk[0] + (n & 1), ijk[1] + ((n >> 1) & 1), ijk[2] + ((n >> 2) & 1));
+            if(m_nodes.count(key) == 0){
+                missing.insert(key);
+            }
+        }
+    }
+
+    // Exact evaluation of the missing nodes.
+    {
+        std::vector<long> keys(missing.begin(), missing.end());
+        std::vector<std::array<double,3>> nodes;
+        nodes.reserve(keys.size());
+        for(long key : keys){
+            nodes.push_back(nodeCoords(key));
+        }
+        std::vector<double> values;
+        m_evaluator(nodes, values);
+        //failed evaluations (e.g. nodes beyond the search radius of the evaluator) are not
+        //cached: they are evaluated again by the next calls, possibly with a larger radius.
+        m_nodes.reserve(m_nodes.size() + keys.size());
+        for(std::size_t i=0; i<keys.size(); ++i){
+            if(isValidDistance(values[i])){
+                m_nodes[keys[i]] = values[i];
+            }
+        }
+    }
+
+    // Trilinear interpolation.
+    for(std::size_t ip=0; ip<nP; ++ip){
+        if(exact[ip]) continue;
+        const std::array<long,3> & c = cells[ip];
+        std::array<double,3> w;
+        for(int d=0; d<3; ++d){
+            w[d] = (points[ip][d] - m_origin[d]) / m_spacing - double(c[d]);
+        }
+        double value = 0.0;
+        bool valid = true;
+        for(int n=0; n<8 && valid; ++n){
+            int a = (n & 1), b = ((n >> 1) & 1), e = ((n >> 2) & 1);
+            auto itNode = m_nodes.find(nodeKey(c[0] + a, c[1] + b, c[2] + e));
+            valid = (itNode != m_nodes.end());
+            if(valid){
+                value += itNode->second * (a ? w[0] : 1.0 - w[0]) * (b ? w[1] : 1.0 - w[1]) * (e ? w[2] : 1.0 - w[2]);
+            }
+        }
+        if(!valid || std::abs(value) < m_fallbackTol){
+            exact[ip] = true;
+        }else{
+            distances[ip] = value;
+        }
+    }
+
+    // Exact fallback evaluation.
+    {
+        std::vector<std::size_t> index;
+        std::vector<std::array<double,3>> work;
+        for(std::size_t ip=0; ip<nP; ++ip){
+            if(exact[ip]){
+                index.push_back(ip);
+                work.push_back(points[ip]);
+            }
+        }
+        std::vector<double> values;
+        m_evaluator(work, values);
+        for(std::size_t i=0; i<index.size(); ++i){
+            distances[index[i]] = values[i];
+        }
+    }
+}
+
+/*!
+ * Clear the cached values and the grid set up.
+ */
+void
+DistanceGrid::clear(){
+    std::unordered_map<long,double>().swap(m_nodes);
+    m_isSet = false;
+    m_dim.fill(0);
+    m_origin.fill(0.0);
+    m_target = nullptr;
+    m_targetTopologyRevision = 0;
+    m_targetCoordsRevision = 0;
+}
+
+/*!
+ * Check if a target geometry is the one used to set up the grid and
+   if it was not modified since then. Revisions are unique among all the geometries,
+   so that a new geometry allocated at the address of the old one is recognized as different.
+   In MPI versions the check is collective: the grid is preserved only if the target is
+   unmodified on all the ranks.
+ * \param[in] target target geometry.
+ * \return true if the target is the same and unmodified.
+ */
+bool
+DistanceGrid::isSameTarget(MimmoSharedPointer<MimmoObject> & target){
+    bool check = m_isSet && (target.get() == m_target);
+    check = check && (target->getTopologyRevision() == m_targetTopologyRevision);
+    check = check && (target->getCoordinatesRevision() == m_targetCoordsRevision);
+#if MIMMO_ENABLE_MPI
+    if(target->isParallel()){
+        MPI_Allreduce(MPI_IN_PLACE, &check, 1, MPI_C_BOOL, MPI_LAND, target->getCommunicator());
+    }
+#endif
+    return check;
+}
+
+/*!
+ * \return unique key of a grid node.
+ * \param[in] i node index in x direction
+ * \param[in] j node index in y direction
+ * \param[in] k node index in z direction
+ */
+long
+DistanceGrid::nodeKey(long i, long j, long k) const{
+    return i + m_dim[0]*(j + m_dim[1]*k);
+}
+
+/*!
+ * \return coordinates of a grid node.
+ * \param[in] key unique key of the node.
+ */
+std::array<double,3>
+DistanceGrid::nodeCoords(long key) const{
+    long i = key % m_dim[0];
+    long j = (key / m_dim[0]) % m_dim[1];
+    long k = key / (m_dim[0]*m_dim[1]);
+    return std::array<double,3>({{m_origin[0] + i*m_spacing, m_origin[1] + j*m_spacing, m_origin[2] + k*m_spacing}});
+}
+
+/*!
+ * \return true if the value is a valid distance, i.e. it is not a placeholder
+   for a failed evaluation.
+ * \param[in] value distance value
+ */
+bool
+DistanceGrid::isValidDistance(double value) const{
+    return std::abs(value) < 1.0E+24;
+}
+
+}
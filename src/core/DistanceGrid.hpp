@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+# ifndef __DISTANCEGRID_HPP__
+# define __DISTANCEGRID_HPP__
+
+#include "MimmoObject.hpp"
+#include <functional>
+
+namespace mimmo{
+
+/*!
+ * \class DistanceGrid
+ * \ingroup core
+ * \brief Sparse cartesian cache of a distance field from a constraint geometry.
+ *
+ * DistanceGrid stores the values of a (signed) distance field w.r.t. a target
+   MimmoObject on the nodes of a uniform cartesian grid, covering the bounding box
+   of the target enlarged by a padding. Grid nodes are sparse: their value is evaluated
+   exactly only the first time a query point falls in one of their cells, and it is then
+   kept for all subsequent queries. Since constraint geometries typically never change
+   along an optimization loop, after the first evaluations the distance of a point is
+   obtained by a trilinear interpolation of the cached node values.
+ *
+ * Exact evaluations are performed through an external evaluator function, provided
+   by the owner of the grid, that computes the distances of a list of points
+   (e.g. a wrapper to skdTreeUtils::signedDistance). The evaluator is always called
+   in batch, at most twice for each DistanceGrid::evaluate call, and it is called also
+   with empty lists, so that it can safely host MPI collective communications.
+ *
+ * Points falling outside the grid, points whose interpolated distance is lower than the
+   fallback tolerance in absolute value (i.e. points close to the target, where the
+   interpolation error is relevant) and points with at least one node without a valid
+   distance are evaluated exactly. Failed node evaluations (e.g. nodes beyond the search
+   radius of the evaluator) are never cached, so that later calls, possibly with a larger
+   radius, evaluate them again.
+ *
+ * The cache is automatically invalidated if the grid is set up on a different target
+   geometry or if the target geometry is modified, as tracked by its topology and
+   coordinates revisions (see MimmoObject::getTopologyRevision and MimmoObject::getCoordinatesRevision).
+ */
+class DistanceGrid{
+
+public:
+    /*!
+        Function computing exact distances of a list of points (first argument)
+        and returning them in a list of values (second argument) of the same size.
+    */
+    typedef std::function<void(const std::vector<std::array<double,3>> &, std::vector<double> &)> Evaluator;
+
+private:
+    Evaluator                       m_evaluator;    /**< Exact distance evaluator */
+    double                          m_spacing;      /**< Grid spacing */
+    double                          m_fallbackTol;  /**< Exact fallback tolerance */
+    std::array<double,3>            m_origin;       /**< Lowest grid point */
+    std::array<long,3>              m_dim;          /**< Number of nodes in each direction */
+    std::unordered_map<long,double> m_nodes;        /**< Cached distances on grid nodes */
+    bool                            m_isSet;        /**< True if the grid is set up */
+
+    const MimmoObject*              m_target;       /**< Target geometry of the cached field */
+    std::size_t                     m_targetTopologyRevision; /**< Topology revision of target at setup */
+    std::size_t                     m_targetCoordsRevision;   /**< Coordinates revision of target at setup */
+
+public:
+    DistanceGrid();
+    virtual ~DistanceGrid();
+
+    DistanceGrid(const DistanceGrid & other) = default;
+    DistanceGrid & operator=(const DistanceGrid & other) = default;
+
+    void    setEvaluator(Evaluator evaluator);
+    void    setSpacing(double spacing);
+    void    setFallbackTolerance(double tol);
+
+    double  getSpacing() const;
+    double  getFallbackTolerance() const;
+    std::size_t getCachedNodeCount() const;
+    bool    isSet() const;
+
+    bool    setup(MimmoSharedPointer<MimmoObject> target, double padding = 0.0);
+    void    evaluate(const std::vector<std::array<double,3>> & points, std::vector<double> & distances);
+    void    clear();
+
+private:
+    bool    isSameTarget(MimmoSharedPointer<MimmoObject> & target);
+    long    nodeKey(long i, long j, long k) const;
+    std::array<double,3> nodeCoords(long key) const;
+    bool    isValidDistance(double value) const;
+};
+
+}
+
+#endif /* __DISTANCEGRID_HPP__ */
@@ -35,6 +35,8 @@ namespace mimmo{
 DataType::DataType(){
     m_conType = "MC_SCALAR";
     m_dataType = "MD_INT";
+    m_conId = PortManager::instance().addContainer(m_conType);
+    m_dataId = PortManager::instance().addDatatype(m_dataType);
 };
 
 /*!
@@ -45,6 +47,8 @@ DataType::DataType(){
 DataType::DataType(containerTAG conType, dataTAG dataType){
     m_conType 	= conType;
     m_dataType	= dataType;
+    m_conId     = PortManager::instance().addContainer(m_conType);
+    m_dataId    = PortManager::instance().addDatatype(m_dataType);
     return;
 };
 
@@ -55,12 +59,12 @@ DataType::~DataType(){};
 
 
 /*!
- * Compare operator of DataType.
+ * Compare operator of DataType. Container and data types are compared by id.
  */
 bool DataType::operator==(const DataType & other){
     bool check = true;
-    check = check && (m_conType == other.m_conType);
-    check = check && (m_dataType == other.m_dataType);
+    check = check && (m_conId == other.m_conId);
+    check = check && (m_dataId == other.m_dataId);
     return(check);
 };
 
@@ -74,6 +78,7 @@ bool DataType::operator==(const DataType & other){
  */
 PortOut::PortOut(){
     m_objLink.clear();
+    m_id = -1;
 };
 
 /*!
@@ -88,7 +93,9 @@ PortOut::PortOut(const PortOut & other){
     m_objLink 	= other.m_objLink;
     m_obuffer	= other.m_obuffer;
     m_portLink	= other.m_portLink;
+    m_portInLink = other.m_portInLink;
     m_datatype	= other.m_datatype;
+    m_id        = other.m_id;
     return;
 };
 
@@ -145,6 +152,32 @@ void
 mimmo::PortOut::clear(){
     m_objLink.clear();
     m_portLink.clear();
+    m_portInLink.clear();
+}
+
+/*!
+ * Compute the FNV-1a hash of a buffer of bytes.
+ * \param[in] data pointer to the buffer
+ * \param[in] size size of the buffer in bytes
+ * \return hash of the buffer.
+ */
+std::size_t
+mimmo::PortOut::hashBuffer(const char * data, std::size_t size){
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i=0; i<size; ++i){
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+/*!
+ * \return true if the port communicates data by reference, i.e. pointers to
+ * structures owned by the sender (data type identifiers ending with "_", e.g. MD_MIMMO_).
+ */
+bool
+mimmo::PortOut::isReferenceData(){
+    return !m_datatype.m_dataType.empty() && m_datatype.m_dataType.back() == '_';
 }
 
 /*!
@@ -156,6 +189,7 @@ mimmo::PortOut::clear(int j){
     if (j < (int)m_objLink.size() && j >= 0){
         m_objLink.erase(m_objLink.begin() + j);
         m_portLink.erase(m_portLink.begin() + j);
+        m_portInLink.erase(m_portInLink.begin() + j);
     }
 }
 
@@ -163,18 +197,30 @@ mimmo::PortOut::clear(int j){
  * Execution of the PIN.
  * All the pins are called in execution of the sending owner after its own execution.
  * Reading stage of pin linked receivers is automatically performed within this execution.
+ * A hash of the communicated buffer is notified to the receivers, to track changes
+ * of their input data (see BaseManipulation::setMemoization). The hash is computed only
+ * if at least one receiver is memoized, otherwise 0 is notified.
+ * Receiver input ports are reached through the pointers resolved when the links were added,
+ * with no lookup by port name.
  */
 void
 mimmo::PortOut::exec(){
     if (m_objLink.size() > 0){
         writeBuffer();
         mimmo::IBinaryStream input(m_obuffer.data(), m_obuffer.getSize());
+        // The hash is used only by memoized receivers.
+        bool memoizedLink = false;
+        for (BaseManipulation * obj : m_objLink){
+            if (obj != nullptr && obj->isMemoized()){
+                memoizedLink = true;
+                break;
+            }
+        }
+        std::size_t hash = memoizedLink ? hashBuffer(m_obuffer.data(), m_obuffer.getSize()) : 0;
         cleanBuffer();
         for (int j=0; j<(int)m_objLink.size(); j++){
             if (m_objLink[j] != nullptr){
-                m_objLink[j]->setBufferIn(m_portLink[j], input);
-                m_objLink[j]->readBufferIn(m_portLink[j]);
-                m_objLink[j]->cleanBufferIn(m_portLink[j]);
+                m_objLink[j]->receiveBufferIn(m_portInLink[j], input, hash);
             }
         }
     }
@@ -184,6 +230,7 @@ mimmo::PortOut::exec(){
  * Default constructor of PortIn
  */
 PortIn::PortIn(){
+    m_id = -1;
     m_mandatory =false;
     m_familym = 0;
 };
@@ -200,6 +247,7 @@ PortIn::PortIn(const PortIn & other){
     m_objLink 	= other.m_objLink;
     m_ibuffer	= other.m_ibuffer;
     m_datatype  = other.m_datatype;
+    m_id        = other.m_id;
     m_mandatory = other.m_mandatory;
     m_familym   = other.m_familym;
     return;
@@ -30,6 +30,7 @@
 namespace mimmo{
 
 class BaseManipulation;
+class PortIn;
 
 /*!
  * \ingroup typedefs
@@ -49,11 +50,15 @@ typedef std::string                 dataTAG; /**< dataTAG typedef */
 *
 * Class retains two members, m_conType and m_dataType to indentify container and data type,
 * respectively, of a given target Port. See mimmo::PortManager.
+* The names are interned in mimmo::PortManager at construction: the comparison of two
+* DataType objects is made on the integer ids m_conId and m_dataId.
 */
 class DataType{
 public:
     containerTAG	m_conType; /**< type of container*/
     dataTAG			m_dataType;/**< type of data*/
+    long            m_conId;   /**< id of the type of container*/
+    long            m_dataId;  /**< id of the type of data*/
 
 public:
     DataType();
@@ -84,6 +89,7 @@ public:
 * - a buffer to communicate output data (m_obuffer)
 * - a list of pointer to BaseManipulation receivers (m_objLink)
 * - a list of Ports identifiers (string basically), marking the input ports of receivers, where the data will be sent (m_portLink)
+* - a list of pointers to the same input ports of receivers, resolved when the link is added (m_portInLink)
 * - information on the container and data type exchanged (m_datatype)
 *
 * In general, a set of data (still not specified in this abstract class) of type m_datatype, written in a buffer stream m_obuffer,
@@ -99,7 +105,9 @@ public:
     mimmo::OBinaryStream            m_obuffer;	/**<Output buffer to communicate data.*/
     std::vector<BaseManipulation*>  m_objLink;	/**<Outputs object to which communicate the data.*/
     std::vector<PortID>             m_portLink;	/**<ID of the input ports of the linked objects.*/
+    std::vector<PortIn*>            m_portInLink;	/**<Input ports of the linked objects.*/
     DataType                        m_datatype;	/**<TAG of type of data communicated.*/
+    long                            m_id;       /**<Id of the port in mimmo::PortManager.*/
 
 public:
     PortOut();
@@ -111,6 +119,7 @@ public:
     std::vector<BaseManipulation*>	getLink();
     std::vector<PortID>				getPortLink();
     DataType						getDataType();
+    bool                            isReferenceData();
 
     /*!
      * Pure virtual function to write a buffer.
@@ -123,6 +132,8 @@ public:
 
     void exec();
 
+    static std::size_t hashBuffer(const char * data, std::size_t size);
+
 };
 
 
@@ -204,6 +215,7 @@ public:
     mimmo::IBinaryStream                m_ibuffer;          /**<input buffer to recover data.*/
     std::vector<BaseManipulation*>      m_objLink;          /**<Input objects from which recover the data. */
     DataType                            m_datatype;         /**<TAG of type of data communicated.*/
+    long                                m_id;               /**<Id of the port in mimmo::PortManager.*/
     bool                                m_mandatory;        /**<Does the port have to be mandatorily linked?.*/
     int                                 m_familym;          /**<Tag of family of mandatory alternative ports.
                                                                  At least one of the ports of the same family has to be linked.
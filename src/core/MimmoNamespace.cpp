@@ -1,5 +1,6 @@
 #include "MimmoNamespace.hpp"
 #include "BaseManipulation.hpp"
+#include <atomic>
 
 std::string mimmo::MIMMO_LOG_FILE = "mimmo";    /**<Default name of logger file.*/
 std::string mimmo::MIMMO_LOG_DIR = ".";         /**<Default directory of logger file.*/
@@ -83,8 +84,11 @@ addPin(BaseManipulation* objSend, BaseManipulation* objRec, PortID portS, PortID
         }
     }
     if (!(objSend->getConnectionType() == ConnectionType::BACKWARD) && !(objRec->getConnectionType() == ConnectionType::FORWARD) ){
-        if (objSend->m_portOut.count(portS) != 0 && objRec->m_portIn.count(portR) != 0){
-            if (forced || checkCompatibility(objSend, objRec, portS, portR)){
+        // port names are resolved once to their ids, then ports are accessed by index
+        PortOut*    pinout  = objSend->getPortOut(PortManager::instance().getPortId(portS));
+        PortIn*     pinin   = objRec->getPortIn(PortManager::instance().getPortId(portR));
+        if (pinout != nullptr && pinin != nullptr){
+            if (forced || pinout->m_datatype == pinin->m_datatype){
                 objSend->addPinOut(objRec, portS, portR);
                 objRec->addPinIn(objSend, portR);
                 objSend->addChild(objRec);
@@ -107,7 +111,7 @@ addPin(BaseManipulation* objSend, BaseManipulation* objRec, PortID portS, PortID
 void
 removeAllPins(BaseManipulation* objSend, BaseManipulation* objRec){
 
-    std::unordered_map<PortID, PortOut*> pinsOut = objSend->getPortsOut();
+    std::unordered_map<PortID, PortOut*> & pinsOut = objSend->m_portOut;
     for (std::unordered_map<PortID, PortOut*>::iterator i = pinsOut.begin(); i != pinsOut.end(); i++){
         if (i->second != nullptr){
             std::vector<BaseManipulation*> linked = i->second->getLink();
@@ -120,10 +124,10 @@ removeAllPins(BaseManipulation* objSend, BaseManipulation* objRec){
         }
     }
 
-    std::unordered_map<PortID, PortIn*> pinsIn = objRec->getPortsIn();
+    std::unordered_map<PortID, PortIn*> & pinsIn = objRec->m_portIn;
     for (std::unordered_map<PortID, PortIn*>::iterator i = pinsIn.begin(); i != pinsIn.end(); i++){
-        std::vector<BaseManipulation*> linked = i->second->getLink();
         if (i->second != nullptr){
+            std::vector<BaseManipulation*> linked = i->second->getLink();
             for (int j=0; j<(int)linked.size(); j++){
                 if (linked[j] == objSend){
                     objRec->removePinIn(i->first,j);
@@ -164,11 +168,10 @@ removePin(BaseManipulation* objSend, BaseManipulation* objRec, PortID portS, Por
 bool
 checkCompatibility(BaseManipulation* objSend, BaseManipulation* objRec, PortID portS, PortID portR){
     bool check = false;
-    PortIn*		pinin 	= objRec->getPortsIn()[portR];
-    PortOut*	pinout 	= objSend->getPortsOut()[portS];
-    DataType typeR = pinin->getDataType();
-    DataType typeS = pinout->getDataType();
-    check = (typeS == typeR);
+    PortIn*		pinin 	= objRec->getPortIn(PortManager::instance().getPortId(portR));
+    PortOut*	pinout 	= objSend->getPortOut(PortManager::instance().getPortId(portS));
+    if (pinin == nullptr || pinout == nullptr) return(check);
+    check = (pinout->m_datatype == pinin->m_datatype);
     return(check);
 }
 
@@ -220,6 +223,19 @@ void setExpertMode(bool flag){
     MIMMO_EXPERT = flag;
 }
 
+/*!
+ * Generate a new revision number. Revision numbers are unique in the process and
+ * monotonically increasing, so that a revision number observed on a structure (e.g.
+ * MimmoObject::getTopologyRevision) changes whenever the structure is modified, also
+ * if the structure is replaced by a different one allocated at the same address.
+ * The method is thread-safe.
+ * \return revision number, greater than any previously generated one.
+ */
+std::size_t nextRevision(){
+    static std::atomic<std::size_t> revision(0);
+    return ++revision;
+}
+
 /*!
     \}
 */
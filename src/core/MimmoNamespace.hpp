@@ -116,6 +116,8 @@ extern bool MIMMO_EXPERT; /**<Flag that defines expert mode (true) or safe mode
 
 void setExpertMode(bool flag = true);
 
+std::size_t nextRevision();
+
 }//end namespace mimmo
 
 #endif
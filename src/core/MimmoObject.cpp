@@ -24,12 +24,14 @@
 #include "MimmoObject.hpp"
 #include "MimmoNamespace.hpp"
 #include "SkdTreeUtils.hpp"
+#include "mimmoThreads.hpp"
 #if MIMMO_ENABLE_MPI
 #include "communications.hpp"
 #endif
 #include <Operators.hpp>
 #include <set>
 #include <cassert>
+#include <algorithm>
 
 namespace mimmo{
 
@@ -311,6 +313,7 @@ MimmoObject::MimmoObject(int type, bool isParallel):m_patch(nullptr),m_extpatch(
 	m_infoSync = SyncStatus::SYNC;
     m_boundingBoxSync = SyncStatus::NONE;
 	m_pointConnectivitySync = SyncStatus::NONE;
+	m_vertexNormalsSync = SyncStatus::NONE;
 
 	setTolerance(1.0e-06);
 }
@@ -451,6 +454,7 @@ MimmoObject::MimmoObject(int type, dvecarr3E & vertex, livector2D * connectivity
 	m_infoSync = SyncStatus::SYNC;
     m_boundingBoxSync = SyncStatus::NONE;
 	m_pointConnectivitySync = SyncStatus::NONE;
+	m_vertexNormalsSync = SyncStatus::NONE;
 
     setTolerance(1.0e-06);
 
@@ -606,6 +610,7 @@ MimmoObject::MimmoObject(int type, bitpit::PatchKernel* geometry):m_patch(nullpt
 	m_infoSync = SyncStatus::SYNC;
     m_boundingBoxSync = SyncStatus::UNSYNC;
 	m_pointConnectivitySync = SyncStatus::NONE;
+	m_vertexNormalsSync = SyncStatus::NONE;
 
     setTolerance(1.0e-06);
 
@@ -761,6 +766,7 @@ MimmoObject::MimmoObject(int type, std::unique_ptr<bitpit::PatchKernel> & geomet
 	m_infoSync = SyncStatus::SYNC;
     m_boundingBoxSync = SyncStatus::UNSYNC;
 	m_pointConnectivitySync = SyncStatus::NONE;
+	m_vertexNormalsSync = SyncStatus::NONE;
 
     setTolerance(1.0e-06);
 
@@ -838,6 +844,7 @@ MimmoObject::MimmoObject(const MimmoObject & other){
 #endif
 
 	m_pointConnectivitySync = SyncStatus::NONE;
+	m_vertexNormalsSync = SyncStatus::NONE;
 
 	m_tolerance = other.m_tolerance;
 
@@ -875,6 +882,9 @@ void MimmoObject::swap(MimmoObject & x) noexcept
 	std::swap(m_skdTreeSync, x.m_skdTreeSync);
 	std::swap(m_kdTreeSync, x.m_kdTreeSync);
     std::swap(m_boundingBoxSync, x.m_boundingBoxSync);
+    std::swap(m_topologyRevision, x.m_topologyRevision);
+    std::swap(m_coordsRevision, x.m_coordsRevision);
+    std::swap(m_pidRevision, x.m_pidRevision);
 
     m_patchInfo.setPatch(getPatch());
 	m_patchInfo.update();
@@ -893,6 +903,10 @@ void MimmoObject::swap(MimmoObject & x) noexcept
 	m_pointGhostExchangeInfoSync = SyncStatus::NONE;
 #endif
 	m_pointConnectivitySync = SyncStatus::NONE; //point connectivity is not copied
+	m_vertexNormals.clear();
+	m_vertexNormalsSync = SyncStatus::NONE; //vertex normals are not copied
+	cleanCachedConnectivity();
+	x.cleanCachedConnectivity();
 
 	std::swap(m_tolerance, x.m_tolerance);
 
@@ -1137,9 +1151,10 @@ MimmoObject::getVerticesCoords(lilimap* mapDataInv){
 	dvecarr3E result(getNVertices());
 	int  i = 0;
 
-	auto pvert = getVertices();
+	const bitpit::PiercedVector<bitpit::Vertex> & pvert = getVertices();
 
 	if (mapDataInv != nullptr){
+		mapDataInv->reserve(mapDataInv->size() + result.size());
 		for (auto const & vertex : pvert){
 			result[i] = vertex.getCoords();
 			(*mapDataInv)[vertex.getId()] = i;
@@ -1265,6 +1280,98 @@ MimmoObject::getConnectivity(){
 	return connecti;
 };
 
+/*!
+ * Return the compact list of local vertex coordinates, as getVerticesCoords does, without copying it.
+ * The list is cached and rebuilt only when the vertex coordinates revision changed since the
+ * last call (see getCoordinatesRevision). Ghost vertices are considered.
+ * The reference is valid until the next call to a method modifying the geometry; if the
+ * bitpit::PatchKernel is modified directly, call the proper mark*Changed() method first.
+ * \return cached coordinates of mesh vertices
+ */
+const dvecarr3E &
+MimmoObject::getCachedVerticesCoords(){
+	if(m_verticesCoordsCacheRevision != m_coordsRevision){
+		dvecarr3E().swap(m_verticesCoordsCache);
+		m_verticesCoordsCache.reserve(getNVertices());
+		for (auto const & vertex : getVertices()){
+			m_verticesCoordsCache.push_back(vertex.getCoords());
+		}
+		m_verticesCoordsCacheRevision = m_coordsRevision;
+	}
+	return m_verticesCoordsCache;
+};
+
+/*!
+ * Return the inverse map of vertex ids of the compact list returned by getCachedVerticesCoords,
+ * i.e. the position of each vertex in the list. The map is cached and rebuilt only when
+ * the topology revision changed since the last call (see getTopologyRevision).
+ * \return cached unique-id/local map
+ */
+const lilimap &
+MimmoObject::getCachedVerticesMapDataInv(){
+	if(m_verticesMapDataInvCacheRevision != m_topologyRevision){
+		lilimap().swap(m_verticesMapDataInvCache);
+		m_verticesMapDataInvCache.reserve(getNVertices());
+		long i = 0;
+		for (auto const & vertex : getVertices()){
+			m_verticesMapDataInvCache.emplace(vertex.getId(), i);
+			++i;
+		}
+		m_verticesMapDataInvCacheRevision = m_topologyRevision;
+	}
+	return m_verticesMapDataInvCache;
+};
+
+/*!
+ * Return the local compact connectivity, as getCompactConnectivity does, without copying it.
+ * Vertex indices refer to the compact list returned by getCachedVerticesCoords.
+ * The connectivity is cached and rebuilt only when the topology revision changed
+ * since the last call (see getTopologyRevision). Ghost cells are considered.
+ * \return cached local compact connectivity
+ */
+const livector2D &
+MimmoObject::getCachedCompactConnectivity(){
+	if(m_compactConnectivityCacheRevision != m_topologyRevision){
+		getCachedVerticesMapDataInv();
+		livector2D().swap(m_compactConnectivityCache);
+		m_compactConnectivityCache = getCompactConnectivity(m_verticesMapDataInvCache);
+		m_compactConnectivityCacheRevision = m_topologyRevision;
+	}
+	return m_compactConnectivityCache;
+};
+
+/*!
+ * Return the connectivity of the local cells, as getConnectivity does, without copying it.
+ * The connectivity is cached and rebuilt only when the topology revision changed
+ * since the last call (see getTopologyRevision). Ghost cells are considered.
+ * \return cached cell-vertices connectivity
+ */
+const livector2D &
+MimmoObject::getCachedConnectivity(){
+	if(m_connectivityCacheRevision != m_topologyRevision){
+		livector2D().swap(m_connectivityCache);
+		m_connectivityCache = getConnectivity();
+		m_connectivityCacheRevision = m_topologyRevision;
+	}
+	return m_connectivityCache;
+};
+
+/*!
+ * Free the memory of the cached vertex coordinates and connectivities.
+ * They are rebuilt on the next call of the getCached* methods.
+ */
+void
+MimmoObject::cleanCachedConnectivity(){
+	dvecarr3E().swap(m_verticesCoordsCache);
+	lilimap().swap(m_verticesMapDataInvCache);
+	livector2D().swap(m_connectivityCache);
+	livector2D().swap(m_compactConnectivityCache);
+	m_verticesCoordsCacheRevision = 0;
+	m_verticesMapDataInvCacheRevision = 0;
+	m_connectivityCacheRevision = 0;
+	m_compactConnectivityCacheRevision = 0;
+};
+
 /*!
  * It gets the connectivity of a cell, with vertex id's in bitpit::PatchKernel unique indexing.
  * Connectivity of polygons is returned as (nV,V1,V2,V3,V4,...) where nV is the number of vertices
@@ -1421,12 +1528,23 @@ MimmoObject::getPatch() const{
  */
 lilimap
 MimmoObject::getMapData(bool withghosts){
+	return getMapData(getMapDataInv(withghosts));
+};
+
+/*!
+ * Return the local indexing vertex map, to pass from local, compact indexing
+ * to bitpit::PatchKernel unique-labeled indexing, inverting a map previously
+ * obtained with getMapDataInv. Use it when both maps are needed, to avoid
+ * evaluating the inverse map twice.
+ * \param[in] mapDataInv unique-id/local map, as returned by getMapDataInv
+ * \return local/unique-id map
+ */
+lilimap
+MimmoObject::getMapData(const lilimap & mapDataInv){
 	lilimap mapData;
-	lilimap mapDataInv = getMapDataInv(withghosts);
-	for (auto const & vertex : getVertices()){
-		long id = vertex.getId();
-		if (mapDataInv.count(id))
-			mapData[mapDataInv[id]] = id;
+	mapData.reserve(mapDataInv.size());
+	for (auto const & val : mapDataInv){
+		mapData.emplace(val.second, val.first);
 	}
 	return mapData;
 };
@@ -1455,8 +1573,9 @@ MimmoObject::getMapDataInv(bool withghosts){
 	BITPIT_UNUSED(withghosts);
 #endif
 	int i = 0;
+	mapDataInv.reserve(getNVertices());
 	for (auto const & vertex : getVertices()){
-		mapDataInv[vertex.getId()] = i;
+		mapDataInv.emplace(vertex.getId(), i);
 		++i;
 	}
 	return mapDataInv;
@@ -2068,6 +2187,7 @@ void MimmoObject::deleteOrphanGhostCells(){
 	//clean marked ghosts;
 	if(!markToDelete.empty()){
 		getPatch()->deleteCells(markToDelete);
+		markTopologyChanged();
 	}
 	//erase temporarely adjacencies
 	if(checkResetAdjacencies){
@@ -2138,6 +2258,7 @@ MimmoObject::addVertex(const darray3E & vertex, const long idtag){
 	m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
 	m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
+	markTopologyChanged();
 	return id;
 };
 
@@ -2174,6 +2295,7 @@ MimmoObject::addVertex(const bitpit::Vertex & vertex, const long idtag){
 	m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
 	m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
+	markTopologyChanged();
 	return id;
 };
 
@@ -2191,12 +2313,14 @@ MimmoObject::modifyVertex(const darray3E & vertex, const long & id){
 	bitpit::Vertex &vert = getPatch()->getVertex(id);
 	vert.setCoords(vertex);
 	m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
+	m_vertexNormalsSync = std::min(m_vertexNormalsSync, SyncStatus::UNSYNC);
 	m_kdTreeSync = std::min(m_kdTreeSync, SyncStatus::UNSYNC);
 	m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
     m_boundingBoxSync = std::min(m_boundingBoxSync, SyncStatus::UNSYNC);
 #if MIMMO_ENABLE_MPI
     m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
+	markCoordinatesChanged();
 	return true;
 };
 
@@ -2272,6 +2396,7 @@ MimmoObject::addConnectedCell(const livector1D & conn, bitpit::ElementType type,
 	setPIDCell(checkedID, PID);
 
 	m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
+	m_vertexNormalsSync = std::min(m_vertexNormalsSync, SyncStatus::UNSYNC);
 	m_AdjSync = std::min(m_AdjSync, SyncStatus::UNSYNC);
 	m_IntSync = std::min(m_IntSync, SyncStatus::UNSYNC);
 	m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
@@ -2279,6 +2404,7 @@ MimmoObject::addConnectedCell(const livector1D & conn, bitpit::ElementType type,
 	m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
 	m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
+	markTopologyChanged();
 	return checkedID;
 };
 
@@ -2339,6 +2465,7 @@ MimmoObject::addCell(bitpit::Cell & cell, const long idtag, int rank){
 	setPIDCell(checkedID, cell.getPID());
 
     m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
+    m_vertexNormalsSync = std::min(m_vertexNormalsSync, SyncStatus::UNSYNC);
     m_AdjSync = std::min(m_AdjSync, SyncStatus::UNSYNC);
     m_IntSync = std::min(m_IntSync, SyncStatus::UNSYNC);
     m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
@@ -2346,6 +2473,7 @@ MimmoObject::addCell(bitpit::Cell & cell, const long idtag, int rank){
     m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
     m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
+    markTopologyChanged();
 	return checkedID;
 };
 
@@ -2371,6 +2499,7 @@ MimmoObject::setPID(livector1D pids){
 	for(const auto & pid : m_pidsType){
 		m_pidsTypeWNames.insert(std::make_pair( pid, ""));
 	}
+	markPIDChanged();
 };
 
 /*!
@@ -2396,7 +2525,7 @@ MimmoObject::setPID(std::unordered_map<long, long> pidsMap){
 	for(const auto & pid : m_pidsType){
 		m_pidsTypeWNames.insert(std::make_pair( pid, ""));
 	}
-
+	markPIDChanged();
 };
 
 /*!
@@ -2411,6 +2540,7 @@ MimmoObject::setPIDCell(long id, long pid){
 		cells[id].setPID((int)pid);
 		m_pidsType.insert(pid);
 		m_pidsTypeWNames.insert(std::make_pair( pid, "") );
+		markPIDChanged();
 	}
 };
 
@@ -2425,6 +2555,7 @@ bool
 MimmoObject::setPIDName(long pid, const std::string & name){
 	if(! bool(m_pidsTypeWNames.count(pid))) return false;
 	m_pidsTypeWNames[pid] = name;
+	markPIDChanged();
 	return true;
 }
 
@@ -2541,14 +2672,73 @@ MimmoObject::setUnsyncAll(){
     m_IntSync = std::min(m_IntSync, SyncStatus::UNSYNC);
     m_kdTreeSync = std::min(m_kdTreeSync, SyncStatus::UNSYNC);
     m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
+    m_vertexNormalsSync = std::min(m_vertexNormalsSync, SyncStatus::UNSYNC);
     m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
     m_boundingBoxSync = SyncStatus::UNSYNC;
 #if MIMMO_ENABLE_MPI
 	m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
 	cleanPointConnectivity(); //forcefully destroy point connectivity.
+	markTopologyChanged();
 };
 
+/*!
+ * \return current revision of the mesh topology, i.e. of the set of vertices and cells
+ * and of their connectivity. It changes every time the topology is modified.
+ */
+std::size_t
+MimmoObject::getTopologyRevision() const{
+    return m_topologyRevision;
+}
+
+/*!
+ * \return current revision of the vertex coordinates. It changes every time a vertex
+ * is moved or the topology is modified.
+ */
+std::size_t
+MimmoObject::getCoordinatesRevision() const{
+    return m_coordsRevision;
+}
+
+/*!
+ * \return current revision of the cell PIDs and their names. It changes every time a PID
+ * is set or the topology is modified.
+ */
+std::size_t
+MimmoObject::getPIDRevision() const{
+    return m_pidRevision;
+}
+
+/*!
+ * Mark the mesh topology as modified. Coordinates and PIDs are marked as modified too.
+ * Use it after inserting/deleting vertices and cells directly in the bitpit::PatchKernel
+ * structure, if setUnsyncAll() is not called.
+ */
+void
+MimmoObject::markTopologyChanged(){
+    m_topologyRevision = nextRevision();
+    m_coordsRevision = nextRevision();
+    m_pidRevision = nextRevision();
+}
+
+/*!
+ * Mark the vertex coordinates as modified.
+ * Use it after moving vertices directly in the bitpit::PatchKernel structure.
+ */
+void
+MimmoObject::markCoordinatesChanged(){
+    m_coordsRevision = nextRevision();
+}
+
+/*!
+ * Mark the cell PIDs as modified.
+ * Use it after setting PIDs directly in the bitpit::PatchKernel structure.
+ */
+void
+MimmoObject::markPIDChanged(){
+    m_pidRevision = nextRevision();
+}
+
 /*!
  * Extract vertex list from an ensamble of geometry cells.
  *\param[in] cellList list of bitpit::PatchKernel ids identifying cells.
@@ -2848,6 +3038,38 @@ MimmoObject::extractBoundaryCellID(bool ghost){
 livector1D
 MimmoObject::extractBoundaryVertexID(std::unordered_map<long, std::set<int> > &map){
 
+    std::unordered_set<long> container = extractBoundaryVertexSet(map);
+
+    livector1D result;
+    result.reserve(container.size());
+    result.insert(result.end(), container.begin(), container.end());
+
+    return result;
+};
+
+/*!
+ * Extract vertices at the mesh boundaries, if any. The method is meant for connected mesh only,
+ * return empty list otherwise.
+ * \param[in] ghost true if the ghosts must be accounted into the search, false otherwise
+ * \return list of vertex ids.
+ */
+livector1D
+MimmoObject::extractBoundaryVertexID(bool ghost){
+    std::unordered_map<long, std::set<int> > map = extractBoundaryFaceCellID(ghost);
+    return extractBoundaryVertexID(map);
+};
+
+/*!
+ * Extract vertices at the mesh boundaries, as an unordered set.
+ * It is the same as extractBoundaryVertexID, without the copy of the ids in a list:
+ * use it when the ids are needed for look-up only.
+ * The method is meant for connected mesh only, return empty set otherwise.
+ * \param[in] map of border faces previously calculated with extractBoundaryFaceCellID
+ * \return set of vertex ids.
+ */
+std::unordered_set<long>
+MimmoObject::extractBoundaryVertexSet(std::unordered_map<long, std::set<int> > &map){
+
     std::unordered_set<long> container;
     container.reserve(getPatch()->getVertexCount());
 
@@ -2861,23 +3083,19 @@ MimmoObject::extractBoundaryVertexID(std::unordered_map<long, std::set<int> > &m
         }// end loop on face
     }
 
-    livector1D result;
-    result.reserve(container.size());
-    result.insert(result.end(), container.begin(), container.end());
-
-    return result;
+    return container;
 };
 
 /*!
- * Extract vertices at the mesh boundaries, if any. The method is meant for connected mesh only,
- * return empty list otherwise.
+ * Extract vertices at the mesh boundaries, if any, as an unordered set.
+ * The method is meant for connected mesh only, return empty set otherwise.
  * \param[in] ghost true if the ghosts must be accounted into the search, false otherwise
- * \return list of vertex ids.
+ * \return set of vertex ids.
  */
-livector1D
-MimmoObject::extractBoundaryVertexID(bool ghost){
+std::unordered_set<long>
+MimmoObject::extractBoundaryVertexSet(bool ghost){
     std::unordered_map<long, std::set<int> > map = extractBoundaryFaceCellID(ghost);
-    return extractBoundaryVertexID(map);
+    return extractBoundaryVertexSet(map);
 };
 
 /*!
@@ -3260,6 +3478,9 @@ void MimmoObject::getBoundingBox(std::array<double,3> & pmin, std::array<double,
 /*!
  * Reset and build again cell skdTree of your geometry (if supports connectivity elements).
  * Ghost cells are insert in the tree.
+ * The tree is built only down to leaves holding value elements at most: a larger
+ * value gives a shallower tree, faster to build and lighter in memory, at the cost
+ * of more elements to be tested during each search.
  *\param[in] value build the minimum leaf of the tree as a bounding box containing value elements at most.
  */
 void MimmoObject::buildSkdTree(std::size_t value){
@@ -3267,7 +3488,7 @@ void MimmoObject::buildSkdTree(std::size_t value){
 
 	if (m_skdTreeSync != SyncStatus::SYNC){
 		m_skdTree->clear();
-		m_skdTree->build(value);
+		m_skdTree->build(std::max(value, std::size_t(1)));
 		m_skdTreeSync = SyncStatus::SYNC;
 	}
 	return;
@@ -3276,25 +3497,133 @@ void MimmoObject::buildSkdTree(std::size_t value){
 /*!
  * Reset and build again vertex kdTree of your geometry.
  * Nodes fo ghost cells are insert in the tree.
+ * The node array of bitpit kdTree is filled directly, following a median-split order, so
+ * that the resulting tree is balanced. Median splits are evaluated with std::nth_element
+ * over a contiguous array of vertex coordinates, processing independent subtrees on
+ * concurrent threads (see mimmo::threads::getNumberOfThreads). Each subtree is stored in
+ * a contiguous range of nodes, with its root on top, so that nodes are linked to their
+ * children while ordering and no vertex is inserted one by one.
  */
 void MimmoObject::buildKdTree(){
 	if( getNVertices() == 0)  return;
-	long label;
 
 	if (m_kdTreeSync != SyncStatus::SYNC){
 		cleanKdTree();
+
+		bitpit::PiercedVector<bitpit::Vertex, long> & vertices = getVertices();
+		std::size_t nVertices = vertices.size();
+
 		//TODO Why : + m_kdTree->MAXSTK ?
-		m_kdTree->nodes.resize(getNVertices() + m_kdTree->MAXSTK);
+		m_kdTree->nodes.resize(nVertices + m_kdTree->MAXSTK);
+
+		std::vector<bitpit::Vertex*> pointers;
+		std::vector<std::array<double,3> > coords;
+		pointers.reserve(nVertices);
+		coords.reserve(nVertices);
+		for(auto & val : vertices){
+			pointers.push_back(&val);
+			coords.push_back(val.getCoords());
+		}
+
+		std::vector<std::size_t> order(nVertices);
+		for(std::size_t i = 0; i < nVertices; ++i){
+			order[i] = i;
+		}
+
+		int parallelDepth = 0;
+		std::size_t nThreads = threads::getNumberOfThreads();
+		while((std::size_t(1) << parallelDepth) < nThreads){
+			++parallelDepth;
+		}
+		buildKdTreeNodes(coords, order.begin(), order.begin(), order.end(), 0, parallelDepth, m_kdTree->nodes.data());
 
-		for(auto & val : getVertices()){
-			label = val.getId();
-			m_kdTree->insert(&val, label);
+		for(std::size_t i = 0; i < nVertices; ++i){
+			m_kdTree->nodes[i].object_ = pointers[order[i]];
+			m_kdTree->nodes[i].label = pointers[order[i]]->getId();
 		}
+		m_kdTree->n_nodes = static_cast<decltype(m_kdTree->n_nodes)>(nVertices);
 		m_kdTreeSync = SyncStatus::SYNC;
 	}
 	return;
 }
 
+/*!
+ * Reorder a range of vertex indices in kdTree node order and link the corresponding nodes.
+ * The median along the splitting direction of the current tree level is moved on top of the
+ * range, followed by the lower and upper halves, recursively ordered in the same way: the
+ * node of the median is linked to the first node of each half. Points with the same
+ * coordinate of the median are all kept in the same half, so that the depth of the tree
+ * exceeds the one of a perfectly balanced tree only because of such ties.
+ * \param[in] coords coordinates of the vertices
+ * \param[in] begin begin of the whole array of indices, matching the first node of the tree
+ * \param[in] first begin of the range of indices to be ordered
+ * \param[in] last end of the range of indices to be ordered
+ * \param[in] level level of the tree the range belongs to
+ * \param[in] parallelDepth number of further levels whose halves are ordered on concurrent threads
+ * \param[in,out] nodes node array of the kdTree, whose children are set
+ */
+void MimmoObject::buildKdTreeNodes(const std::vector<std::array<double,3> > & coords,
+                                   std::vector<std::size_t>::iterator begin,
+                                   std::vector<std::size_t>::iterator first,
+                                   std::vector<std::size_t>::iterator last,
+                                   int level, int parallelDepth,
+                                   bitpit::KdNode<3, bitpit::Vertex, long> * nodes){
+	std::size_t size = std::size_t(last - first);
+	if(size == 0) return;
+
+	bitpit::KdNode<3, bitpit::Vertex, long> & node = nodes[first - begin];
+	if(size == 1){
+		node.lchild_ = -1;
+		node.rchild_ = -1;
+		return;
+	}
+
+	int dim = level % 3;
+	std::vector<std::size_t>::iterator median = first + size/2;
+	std::nth_element(first, median, last, [&coords, dim](std::size_t a, std::size_t b){
+		return coords[a][dim] < coords[b][dim];
+	});
+	//bitpit kdTree sends points lying on the splitting plane of a node to its left subtree:
+	//points tied with the median are kept all in the lower half, or all in the upper one
+	//if this gives a better balance, and the node is the highest point of the lower half,
+	//so that each half is found by the searches in the subtree it was ordered for.
+	double split = coords[*median][dim];
+	std::vector<std::size_t>::iterator lowerEnd = std::partition(first, median, [&coords, dim, split](std::size_t a){
+		return coords[a][dim] < split;
+	});
+	std::vector<std::size_t>::iterator upperBegin = std::partition(median + 1, last, [&coords, dim, split](std::size_t a){
+		return coords[a][dim] <= split;
+	});
+	std::size_t nLess = std::size_t(lowerEnd - first);
+	std::size_t nLessEqual = std::size_t(upperBegin - first);
+	auto imbalance = [size](std::size_t nLower){
+		return std::max(nLower, size - 1 - nLower) - std::min(nLower, size - 1 - nLower);
+	};
+	std::vector<std::size_t>::iterator middle = upperBegin;
+	if(nLess > 0 && imbalance(nLess - 1) < imbalance(nLessEqual - 1)){
+		std::vector<std::size_t>::iterator top = std::max_element(first, lowerEnd, [&coords, dim](std::size_t a, std::size_t b){
+			return coords[a][dim] < coords[b][dim];
+		});
+		std::iter_swap(top, lowerEnd - 1);
+		middle = lowerEnd;
+	}
+	std::rotate(first, middle - 1, middle);
+
+	//lower half in [first + 1, middle), upper half in [middle, last)
+	node.lchild_ = (middle - first > 1) ? int(first + 1 - begin) : -1;
+	node.rchild_ = (middle < last) ? int(middle - begin) : -1;
+
+	if(parallelDepth > 0 && size > 4096){
+		std::future<void> lower = std::async(std::launch::async, &MimmoObject::buildKdTreeNodes,
+		                                     std::cref(coords), begin, first + 1, middle, level + 1, parallelDepth - 1, nodes);
+		buildKdTreeNodes(coords, begin, middle, last, level + 1, parallelDepth - 1, nodes);
+		lower.get();
+	}else{
+		buildKdTreeNodes(coords, begin, first + 1, middle, level + 1, 0, nodes);
+		buildKdTreeNodes(coords, begin, middle, last, level + 1, 0, nodes);
+	}
+}
+
 /*!
  * Clean the KdTree of the class
  */
@@ -3423,6 +3752,12 @@ void MimmoObject::update()
         buildPointConnectivity();
     }
 
+    // Update vertex pseudo-normals
+    status = getVertexNormalsSyncStatus();
+    if (status == SyncStatus::UNSYNC){
+        buildVertexNormals();
+    }
+
 #if MIMMO_ENABLE_MPI
     // Always update/build point ghost exchange information
     status = m_pointGhostExchangeInfoSync;
@@ -3661,6 +3996,9 @@ void MimmoObject::resetPatch(){
 #endif
 	cleanPointConnectivity();
 	m_pointConnectivitySync = SyncStatus::NONE;
+	cleanVertexNormals();
+	m_vertexNormalsSync = SyncStatus::NONE;
+	markTopologyChanged();
 };
 
 /*!
@@ -3806,6 +4144,7 @@ void MimmoObject::reset(int type, bool isParallel){
 	m_infoSync = SyncStatus::NONE;
     m_boundingBoxSync = SyncStatus::NONE;
 	m_pointConnectivitySync = SyncStatus::NONE;
+	m_vertexNormalsSync = SyncStatus::NONE;
 }
 
 /*!
@@ -3910,6 +4249,7 @@ void MimmoObject::restore(std::istream & stream){
 		m_pidsTypeWNames.insert( std::make_pair( pp, sspid[count]));
 		++count;
 	}
+	markTopologyChanged();
 
 	//that's all folks.
 }
@@ -4768,6 +5108,84 @@ MimmoObject::getPointConnectivitySyncStatus(){
 	return m_pointConnectivitySync;
 }
 
+/*!
+    Build and cache the angle-weighted pseudo-normals of the vertices of the geometry.
+    Available only for surface meshes and 3D curves (type 1 and 4). Cell adjacencies
+    are updated if needed, since they are required to visit the vertex one-ring.
+    The cached normals are used by skdTreeUtils signed distance evaluation in place of
+    computing them on-the-fly at each query.
+    The structure is built only if it is not already synchronized with the geometry,
+    i.e. if the vertex coordinates revision changed since the last build (see getCoordinatesRevision).
+ */
+void
+MimmoObject::buildVertexNormals()
+{
+	if(getType() != 1 && getType() != 4) return;
+	if(getVertexNormalsSyncStatus() == SyncStatus::SYNC) return;
+
+	cleanVertexNormals();
+
+	updateAdjacencies();
+
+	bitpit::SurfaceKernel* skernel = static_cast<bitpit::SurfaceKernel*>(getPatch());
+	m_vertexNormals.reserve(getNVertices());
+
+	// All cells are considered, both interiors and ghosts
+	bitpit::ConstProxyVector<long> verts;
+	std::size_t size;
+	long idN;
+	for(const bitpit::Cell & cell: getCells()){
+		verts = cell.getVertexIds();
+		size = verts.size();
+		for(std::size_t i=0; i<size; ++i){
+			idN = verts[i];
+			if(!m_vertexNormals.exists(idN)){
+				m_vertexNormals.insert(idN, skernel->evalVertexNormal(cell.getId(), i));
+			}
+		}
+	}
+
+	m_vertexNormalsSync = SyncStatus::SYNC;
+	m_vertexNormalsRevision = m_coordsRevision;
+}
+
+/*!
+    Clean the cached vertex pseudo-normals structure.
+ */
+void
+MimmoObject::cleanVertexNormals()
+{
+	bitpit::PiercedVector<std::array<double,3>, long>().swap(m_vertexNormals);
+
+	if(m_vertexNormalsSync == SyncStatus::SYNC){
+		m_vertexNormalsSync = SyncStatus::UNSYNC;
+	};
+}
+
+/*!
+    Get the cached vertex pseudo-normals. Call buildVertexNormals first to
+    have them synchronized with the current geometry.
+    \return cached vertex pseudo-normals, referred to vertex ids.
+ */
+const bitpit::PiercedVector<std::array<double,3>, long> &
+MimmoObject::getVertexNormals() const
+{
+	return m_vertexNormals;
+}
+
+/*!
+    \return the vertex pseudo-normals sync status. Normals built on a previous revision of the
+    vertex coordinates, e.g. moved directly in the patch and marked with markCoordinatesChanged,
+    are unsynchronized.
+ */
+SyncStatus
+MimmoObject::getVertexNormalsSyncStatus(){
+	if(m_vertexNormalsSync == SyncStatus::SYNC && m_vertexNormalsRevision != m_coordsRevision){
+		m_vertexNormalsSync = SyncStatus::UNSYNC;
+	}
+	return m_vertexNormalsSync;
+}
+
 /*!
  * Triangulate the linked geometry. It works only for surface geometries (type = 1).
  * After the method call the geometry (internal or linked) is forever modified.
@@ -4866,12 +5284,14 @@ MimmoObject::triangulate(){
 	    m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
         m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
         m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
+        m_vertexNormalsSync = std::min(m_vertexNormalsSync, SyncStatus::UNSYNC);
         m_kdTreeSync = std::min(m_kdTreeSync, SyncStatus::UNSYNC);
         m_AdjSync = std::min(m_AdjSync, SyncStatus::UNSYNC);
         m_IntSync = std::min(m_IntSync, SyncStatus::UNSYNC);
 #if MIMMO_ENABLE_MPI
         m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
+        markTopologyChanged();
     } // end if patch is not empty
 
 #if MIMMO_ENABLE_MPI
@@ -4993,13 +5413,14 @@ MimmoObject::degradeDegenerateElements(bitpit::PiercedVector<bitpit::Cell>* degr
         m_infoSync = std::min(m_infoSync, SyncStatus::UNSYNC);
         m_pointConnectivitySync = std::min(m_pointConnectivitySync, SyncStatus::UNSYNC);
         m_skdTreeSync = std::min(m_skdTreeSync, SyncStatus::UNSYNC);
+        m_vertexNormalsSync = std::min(m_vertexNormalsSync, SyncStatus::UNSYNC);
         m_kdTreeSync = std::min(m_kdTreeSync, SyncStatus::UNSYNC);
         m_AdjSync = std::min(m_AdjSync, SyncStatus::UNSYNC);
         m_IntSync = std::min(m_IntSync, SyncStatus::UNSYNC);
 #if MIMMO_ENABLE_MPI
         m_pointGhostExchangeInfoSync = std::min(m_pointGhostExchangeInfoSync, SyncStatus::UNSYNC);
 #endif
-
+        markTopologyChanged();
     }
 
     update();
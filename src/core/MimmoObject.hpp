@@ -26,6 +26,7 @@
 
 #include "mimmoTypeDef.hpp"
 #include "MimmoSharedPointer.hpp"
+#include "MimmoNamespace.hpp"
 #include <bitpit_volunstructured.hpp>
 #include <bitpit_surfunstructured.hpp>
 #include <bitpit_SA.hpp>
@@ -139,6 +140,16 @@ enum class SyncStatus: long {
   It supports PID convention to mark subparts of geometry as well as building the search-trees
   KdTree (3D point spatial ordering) and skdTree(Cell-AABB spatial ordering) to quickly retrieve
   vertices and cells in the data structure.
+
+  MimmoObject keeps three revision numbers, for the mesh topology, the vertex coordinates and
+  the cell PIDs. They change every time the related data are modified through the MimmoObject
+  interface (e.g. addVertex, modifyVertex, addConnectedCell, setPID) and they are never reused,
+  so that blocks can key internal caches on them and skip work if the geometry did not change
+  since their last execution. A change of topology changes all the revisions.
+  The same revisions key the cached vertex coordinates and connectivities returned by
+  const reference by the getCached* methods.
+  Modifications done directly on the bitpit::PatchKernel structure are not tracked: in that case
+  call setUnsyncAll() or the proper mark*Changed() method.
 */
 class MimmoObject{
 
@@ -185,6 +196,23 @@ protected:
     std::unordered_map<long, std::unordered_set<long> >	m_pointConnectivity;		/**< Point-Point connectivity. 1-Ring neighbours of each vertex.*/
     SyncStatus                     						m_pointConnectivitySync;	/**< Track correct building of points connectivity along with geometry modifications */
 
+    bitpit::PiercedVector<std::array<double,3>, long>	m_vertexNormals;			/**< Cached angle-weighted pseudo-normals of vertices (surface meshes and 3D curves only).*/
+    SyncStatus                     						m_vertexNormalsSync;		/**< Track correct building of vertex pseudo-normals along with geometry modifications */
+
+    std::size_t                 m_topologyRevision = nextRevision();    /**< Revision of the mesh topology (vertices and cells inserted/deleted, connectivity) */
+    std::size_t                 m_coordsRevision = nextRevision();      /**< Revision of the vertex coordinates */
+    std::size_t                 m_pidRevision = nextRevision();         /**< Revision of the cell PIDs */
+    std::size_t                 m_vertexNormalsRevision = 0;            /**< Coordinates revision the cached vertex pseudo-normals were built on */
+
+    dvecarr3E                   m_verticesCoordsCache;                  /**< Cached compact list of vertex coordinates */
+    lilimap                     m_verticesMapDataInvCache;              /**< Cached inverse map of vertex ids of the compact list of vertex coordinates */
+    livector2D                  m_connectivityCache;                    /**< Cached cell-vertices connectivity */
+    livector2D                  m_compactConnectivityCache;             /**< Cached cell-vertices compact connectivity */
+    std::size_t                 m_verticesCoordsCacheRevision = 0;      /**< Coordinates revision the cached compact vertex coordinates were built on */
+    std::size_t                 m_verticesMapDataInvCacheRevision = 0;  /**< Topology revision the cached inverse map of vertex ids was built on */
+    std::size_t                 m_connectivityCacheRevision = 0;        /**< Topology revision the cached connectivity was built on */
+    std::size_t                 m_compactConnectivityCacheRevision = 0; /**< Topology revision the cached compact connectivity was built on */
+
 public:
     MimmoObject(int type = 1, bool isParallel = MIMMO_ENABLE_MPI);
     MimmoObject(int type, dvecarr3E & vertex, livector2D * connectivity = nullptr, bool isParallel = MIMMO_ENABLE_MPI);
@@ -215,6 +243,11 @@ public:
 
     livector2D                                      getCompactConnectivity(lilimap & mapDataInv);
     livector2D                                      getConnectivity();
+    const dvecarr3E &                               getCachedVerticesCoords();
+    const lilimap &                                 getCachedVerticesMapDataInv();
+    const livector2D &                              getCachedCompactConnectivity();
+    const livector2D &                              getCachedConnectivity();
+    void                                            cleanCachedConnectivity();
     livector1D                                      getCellConnectivity(long id) const ;
     bitpit::PiercedVector<bitpit::Cell> &           getCells();
     const bitpit::PiercedVector<bitpit::Cell> &     getCells() const;
@@ -292,6 +325,13 @@ public:
     bool        cleanGeometry();
     void        setUnsyncAll();
 
+    std::size_t getTopologyRevision() const;
+    std::size_t getCoordinatesRevision() const;
+    std::size_t getPIDRevision() const;
+    void        markTopologyChanged();
+    void        markCoordinatesChanged();
+    void        markPIDChanged();
+
     livector1D  getVertexFromCellList(const livector1D &cellList);
     livector1D  getCellFromVertexList(const livector1D &vertList, bool strict = true);
     livector1D  getInterfaceFromCellList(const livector1D &cellList, bool all = true);
@@ -302,6 +342,8 @@ public:
     livector1D                               extractBoundaryCellID(std::unordered_map<long, std::set<int> > & map);
     livector1D                               extractBoundaryVertexID(std::unordered_map<long, std::set<int> > & map);
     livector1D                               extractBoundaryVertexID(bool ghost = false);
+    std::unordered_set<long>                 extractBoundaryVertexSet(std::unordered_map<long, std::set<int> > & map);
+    std::unordered_set<long>                 extractBoundaryVertexSet(bool ghost = false);
     livector1D                               extractBoundaryInterfaceID(std::unordered_map<long, std::set<int> > & map);
     livector1D                               extractBoundaryInterfaceID(bool ghost= false);
     MimmoSharedPointer<MimmoObject>          extractBoundaryMesh();
@@ -318,6 +360,7 @@ public:
     std::map<long, livector1D> extractPIDSubdivision();
 
     lilimap      getMapData(bool withghosts=false);
+    lilimap      getMapData(const lilimap & mapDataInv);
     lilimap      getMapDataInv(bool withghosts=true);
     lilimap	     getMapCell(bool withghosts=true);
     lilimap      getMapCellInv(bool withghosts=true);
@@ -383,6 +426,11 @@ public:
     std::unordered_set<long> &	getPointConnectivity(const long & id);
     SyncStatus  				getPointConnectivitySyncStatus();
 
+    void						buildVertexNormals();
+    void						cleanVertexNormals();
+    const bitpit::PiercedVector<std::array<double,3>, long> &	getVertexNormals() const;
+    SyncStatus  				getVertexNormalsSyncStatus();
+
     void						triangulate();
 
     void                        degradeDegenerateElements(bitpit::PiercedVector<bitpit::Cell>* degradedDeletedCells = nullptr, bitpit::PiercedVector<bitpit::Vertex>* collapsedVertices = nullptr);
@@ -406,6 +454,13 @@ private:
 
     bool    checkCellConnCoherence(const bitpit::ElementType & type, const livector1D & conn_);
 
+    static void buildKdTreeNodes(const std::vector<std::array<double,3> > & coords,
+                                 std::vector<std::size_t>::iterator begin,
+                                 std::vector<std::size_t>::iterator first,
+                                 std::vector<std::size_t>::iterator last,
+                                 int level, int parallelDepth,
+                                 bitpit::KdNode<3, bitpit::Vertex, long> * nodes);
+
 	/*!
         \struct VertexPositionLess
         Functional for comparing the position of two vertices.
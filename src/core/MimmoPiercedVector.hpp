@@ -32,6 +32,12 @@
 
 namespace mimmo{
 
+/*!
+   \ingroup core
+ * \brief Base tag of the nodes of MimmoPiercedVector algebraic expressions (see MimmoPiercedVectorAlgebra.hpp).
+ */
+struct MPVExpressionTag{};
+
 /*!
    \ingroup core
  * \brief Define data location for the MimmoPiercedVector field.
@@ -55,6 +61,30 @@ enum class MPVLocation: long {
  * It supports a string name attribute to mark the field as well as a location enum to
  * understand to which structures of geometry refers the data (UNDEFINED no-info, POINT-vertices,
  * CELL-cells, INTERFACE-interfaces).
+ *
+ * A field is said <B>aligned</B> (dense mode) when it holds exactly one value for each
+ * structure of its location in the linked geometry, stored in the same order the geometry
+ * stores its structures and without holes. Aligned fields can be processed element-wise
+ * by iterating them side by side with the geometry, or with other fields aligned to the same
+ * geometry, without any id lookup; their values can be exchanged with plain contiguous
+ * arrays through getAlignedData/setAlignedData. Any field can be converted to the aligned
+ * mode with alignToGeometry; the usual id-based (sparse) interface remains available in both modes.
+ *
+ * Fields can be combined with element-wise algebraic expressions (e.g. a*x + b*y, x*filter,
+ * pointwiseNorm(x), thresholdMask(x, t)) and reductions (fieldSum, fieldDot, fieldNorm2, fieldNormInf),
+ * evaluated in a single pass without temporaries; see MimmoPiercedVectorAlgebra.hpp.
+ *
+ * The field keeps a data revision number (see getDataRevision), changed by every method of the
+ * class modifying values, ids, geometry or location of the field, and preserved by copies.
+ * Values inserted or modified through the bitpit::PiercedVector interface are not tracked:
+ * call markDataChanged after such modifications, if the field is meant to be cached on.
+ *
+ * Fields of floating point values can be stored in single precision (e.g. fmpvecarr3E),
+ * halving their memory, when they are only meant to be written or visualized. Blocks and
+ * solvers work in double precision: fields are converted explicitly at their boundaries
+ * with toFloat32/toFloat64 (see also convertField). Single precision fields are exchanged
+ * through dedicated ports (e.g. M_GDISPLS32, M_FILTER32, M_SCALARFIELD32): blocks working
+ * in double precision convert them when received.
  */
 template<typename mpv_t>
 class MimmoPiercedVector: public bitpit::PiercedVector<mpv_t, long int> {
@@ -63,6 +93,7 @@ private:
     MPVLocation                              m_loc;         /**< MPVLocation enum */
     bitpit::Logger*                          m_log;         /**<Pointer to logger.*/
     std::string								 m_name;		/**<Field name. */
+    std::size_t                              m_revision;    /**<Revision of the field data. */
 
 public:
     MimmoPiercedVector(MimmoSharedPointer<MimmoObject> geo = nullptr, MPVLocation loc = MPVLocation::UNDEFINED);
@@ -71,6 +102,8 @@ public:
     MimmoPiercedVector(const MimmoPiercedVector<mpv_t> & other);
     MimmoPiercedVector & operator=(MimmoPiercedVector<mpv_t> other);
     MimmoPiercedVector & operator=(bitpit::PiercedVector<mpv_t, long int> other);
+    template<typename expr_t, typename = typename std::enable_if<std::is_base_of<MPVExpressionTag, expr_t>::value>::type>
+    MimmoPiercedVector & operator=(const expr_t & expression);
 
     void  clear();
 
@@ -92,6 +125,9 @@ public:
     void    setData(std::vector<mpv_t> &rawdata);
     void	setName(std::string name);
 
+    std::size_t getDataRevision() const;
+    void        markDataChanged();
+
     bool checkDataSizeCoherence();
     bool checkDataIdsCoherence();
     MimmoPiercedVector<mpv_t> resizeToCoherentDataIds();
@@ -104,6 +140,11 @@ public:
     MimmoPiercedVector cellDataToPointData(const MimmoPiercedVector<mpv_t> & cellGradientsX, const MimmoPiercedVector<mpv_t> & cellGradientsY, const MimmoPiercedVector<mpv_t> & cellGradientsZ, bool maximum = false);
     MimmoPiercedVector pointDataToBoundaryInterfaceData(double p = 0.);
 
+    bool isAligned() const;
+    bool alignToGeometry(const mpv_t & defValue);
+    std::vector<mpv_t> getAlignedData() const;
+    bool setAlignedData(const std::vector<mpv_t> & data);
+
     std::size_t getDataFrom(const MimmoPiercedVector<mpv_t> & other, bool strict = false);
     void squeezeOutExcept(const std::vector<long int> & list, bool keepOrder = false);
     void squeezeOutExcept(const std::unordered_set<long int> & list, bool keepOrder = false);
@@ -114,8 +155,83 @@ public:
 
 private:
     livector1D getGeometryIds(bool ordered=false);
+
+    template<typename structure_t>
+    bool isAlignedTo(const bitpit::PiercedVector<structure_t, long int> & structures) const;
+    template<typename structure_t>
+    void alignTo(const bitpit::PiercedVector<structure_t, long int> & structures, const mpv_t & defValue);
+};
+
+/*!
+   \ingroup core
+ * \brief Single and double precision counterparts of a field value type.
+ *
+ * Floating point values (double, float and std::array of them) have a float32_type
+ * (float, std::array<float,d>) and a float64_type (double, std::array<double,d>);
+ * other value types are their own counterparts.
+ */
+template<typename T>
+struct MPVPrecision{
+    typedef T float32_type; /**< single precision counterpart */
+    typedef T float64_type; /**< double precision counterpart */
 };
 
+/*! \brief Precision counterparts of double values. */
+template<>
+struct MPVPrecision<double>{
+    typedef float float32_type;     /**< single precision counterpart */
+    typedef double float64_type;    /**< double precision counterpart */
+};
+
+/*! \brief Precision counterparts of float values. */
+template<>
+struct MPVPrecision<float>{
+    typedef float float32_type;     /**< single precision counterpart */
+    typedef double float64_type;    /**< double precision counterpart */
+};
+
+/*! \brief Precision counterparts of arrays of double values. */
+template<std::size_t d>
+struct MPVPrecision<std::array<double,d>>{
+    typedef std::array<float,d> float32_type;   /**< single precision counterpart */
+    typedef std::array<double,d> float64_type;  /**< double precision counterpart */
+};
+
+/*! \brief Precision counterparts of arrays of float values. */
+template<std::size_t d>
+struct MPVPrecision<std::array<float,d>>{
+    typedef std::array<float,d> float32_type;   /**< single precision counterpart */
+    typedef std::array<double,d> float64_type;  /**< double precision counterpart */
+};
+
+/*!
+   \ingroup core
+ * \brief Conversion of a field value to a value of another type.
+ */
+template<typename dst_t, typename src_t>
+struct MPVValueCast{
+    /*! Convert a value. \param[in] src value \return converted value */
+    static dst_t apply(const src_t & src){ return static_cast<dst_t>(src); }
+};
+
+/*! \brief Component-wise conversion of array values. */
+template<typename dst_t, typename src_t, std::size_t d>
+struct MPVValueCast<std::array<dst_t,d>, std::array<src_t,d>>{
+    /*! Convert a value. \param[in] src value \return converted value */
+    static std::array<dst_t,d> apply(const std::array<src_t,d> & src){
+        std::array<dst_t,d> dst;
+        for(std::size_t i = 0; i < d; ++i) dst[i] = static_cast<dst_t>(src[i]);
+        return dst;
+    }
+};
+
+template<typename dst_t, typename src_t>
+MimmoPiercedVector<dst_t> convertField(const MimmoPiercedVector<src_t> & field);
+template<typename T>
+MimmoPiercedVector<typename MPVPrecision<T>::float32_type> toFloat32(const MimmoPiercedVector<T> & field);
+template<typename T>
+MimmoPiercedVector<typename MPVPrecision<T>::float64_type> toFloat64(const MimmoPiercedVector<T> & field);
+
 /*!
  * \ingroup typedefs
  * \{
@@ -127,6 +243,8 @@ typedef mimmo::MimmoPiercedVector<std::vector<double>>  dmpvector2D;   /**< mimm
 typedef mimmo::MimmoPiercedVector<long int>  limpvector1D;   /**< mimmo custom typedef*/
 typedef mimmo::MimmoPiercedVector<std::vector<long int>>  limpvector2D;   /**< mimmo custom typedef*/
 typedef mimmo::MimmoPiercedVector<darray3E>  dmpvecarr3E;   /**< mimmo custom typedef*/
+typedef mimmo::MimmoPiercedVector<float>  fmpvector1D;   /**< mimmo custom typedef*/
+typedef mimmo::MimmoPiercedVector<std::array<float,3>>  fmpvecarr3E;   /**< mimmo custom typedef*/
 
 /*!
  * \}
@@ -150,5 +268,6 @@ mimmo::OBinaryStream& operator<<(mimmo::OBinaryStream &buf, const mimmo::MimmoPi
 
 
 #include "MimmoPiercedVector.tpp"
+#include "MimmoPiercedVectorAlgebra.hpp"
 
 #endif /* __MIMMOPIERCEDVECTOR_HPP__ */
@@ -93,6 +93,7 @@ MimmoPiercedVector<mpv_t>::MimmoPiercedVector(MimmoSharedPointer<MimmoObject> ge
 	m_loc = loc;
 	m_log = &bitpit::log::cout(MIMMO_LOG_FILE);
 	m_name = "data";
+	m_revision = nextRevision();
 }
 
 /*!
@@ -110,6 +111,7 @@ MimmoPiercedVector<mpv_t>::MimmoPiercedVector(const MimmoPiercedVector<mpv_t> &
 	this->m_geometry = other.m_geometry;
 	this->m_loc = other.m_loc;
 	this->m_name = other.m_name;
+	this->m_revision = other.m_revision;
 	m_log = &bitpit::log::cout(MIMMO_LOG_FILE);
 };
 
@@ -131,6 +133,7 @@ template<typename mpv_t>
 MimmoPiercedVector<mpv_t> & MimmoPiercedVector<mpv_t>::operator =(bitpit::PiercedVector<mpv_t, long int> other){
 
 	this->bitpit::PiercedVector<mpv_t, long int>::swap(other);
+	markDataChanged();
 	return *this;
 };
 
@@ -145,6 +148,7 @@ void MimmoPiercedVector<mpv_t>::swap(MimmoPiercedVector<mpv_t> & x) noexcept
 	std::swap(this->m_geometry, x.m_geometry);
 	std::swap(this->m_loc, x.m_loc);
 	this->m_name.swap(x.m_name);
+	std::swap(this->m_revision, x.m_revision);
 	this->bitpit::PiercedVector<mpv_t, long int>::swap(x);
 }
 
@@ -159,6 +163,7 @@ MimmoPiercedVector<mpv_t>::clear(){
 	m_name = "data";
 	m_loc = MPVLocation::UNDEFINED;
 	bitpit::PiercedVector<mpv_t, long int>::clear();
+	markDataChanged();
 }
 
 /*!
@@ -313,6 +318,7 @@ template<typename mpv_t>
 void
 MimmoPiercedVector<mpv_t>::setGeometry(MimmoSharedPointer<MimmoObject> geo){
 	m_geometry = geo;
+	markDataChanged();
 }
 
 /*!
@@ -323,6 +329,7 @@ template<typename mpv_t>
 void
 MimmoPiercedVector<mpv_t>::setDataLocation(MPVLocation loc){
 	m_loc = loc;
+	markDataChanged();
 }
 
 /*!
@@ -353,6 +360,7 @@ MimmoPiercedVector<mpv_t>::setData(std::vector<mpv_t>& data){
 		this->insert(id, val);
 		id++;
 	}
+	markDataChanged();
 }
 
 /*!
@@ -365,6 +373,29 @@ MimmoPiercedVector<mpv_t>::setName(std::string name){
 	m_name = name;
 }
 
+/*!
+ * Get the revision of the field data. The revision changes every time values, ids,
+ * geometry or location of the field are modified through the methods of the class,
+ * and it is preserved by copies of the field. Revisions are never reused, so they
+ * can be used as keys of caches of quantities derived from the field.
+ * \return current data revision.
+ */
+template<typename mpv_t>
+std::size_t
+MimmoPiercedVector<mpv_t>::getDataRevision() const{
+	return m_revision;
+}
+
+/*!
+ * Mark the field data as modified, assigning a new data revision.
+ * Use it after modifying values through the bitpit::PiercedVector interface.
+ */
+template<typename mpv_t>
+void
+MimmoPiercedVector<mpv_t>::markDataChanged(){
+	m_revision = nextRevision();
+}
+
 /*!
  * Check data coherence with the geometry linked. Return a coherence boolean flag which is
  * false if:
@@ -566,6 +597,7 @@ template<typename mpv_t>
 bool
 MimmoPiercedVector<mpv_t>::completeMissingData(const mpv_t & defValue){
 
+	if(this->isAligned()) return true;
 	if(!this->checkDataIdsCoherence()) return false;
 	if(!this->checkDataSizeCoherence()){
 
@@ -574,6 +606,7 @@ MimmoPiercedVector<mpv_t>::completeMissingData(const mpv_t & defValue){
 		for(auto id: ids){
 			if(!this->exists(id)) this->insert(id, defValue);
 		}
+		markDataChanged();
 	}
 	return true;
 }
@@ -631,8 +664,9 @@ MimmoPiercedVector<mpv_t>::initialize(MimmoSharedPointer<MimmoObject> geo, MPVLo
 		break;
 	default:
 		//do nothing
-		break;
+		return;
 	}
+	markDataChanged();
 }
 
 /*!
@@ -826,6 +860,141 @@ MimmoPiercedVector<mpv_t> MimmoPiercedVector<mpv_t>::pointDataToBoundaryInterfac
 	return interfaceData;
 };
 
+/*!
+ * Check if the field is aligned to the linked geometry, i.e. it holds one value
+ * for each structure of its location, stored in the same order of the geometry
+ * container. The check runs over the two containers side by side, without any id lookup.
+ * \return true if the field is aligned.
+ */
+template<typename mpv_t>
+bool
+MimmoPiercedVector<mpv_t>::isAligned() const{
+    if(m_geometry == nullptr) return false;
+    switch(m_loc){
+        case MPVLocation::POINT:
+            return isAlignedTo(m_geometry->getVertices());
+        case MPVLocation::CELL:
+            return isAlignedTo(m_geometry->getCells());
+        case MPVLocation::INTERFACE:
+            return isAlignedTo(m_geometry->getInterfaces());
+        default:
+            return false;
+    }
+}
+
+/*!
+ * Convert the field to the aligned (dense) mode. Values are reordered following
+ * the storage order of the linked geometry structures of the field location;
+ * structures with no value get the default value provided, while values not
+ * related to any structure of the geometry are dropped.
+ * If the field is already aligned nothing is done.
+ * \param[in] defValue value assigned to the missing elements
+ * \return false if no geometry is linked or the location is undefined, true otherwise.
+ */
+template<typename mpv_t>
+bool
+MimmoPiercedVector<mpv_t>::alignToGeometry(const mpv_t & defValue){
+    if(m_geometry == nullptr) return false;
+    switch(m_loc){
+        case MPVLocation::POINT:
+            alignTo(m_geometry->getVertices(), defValue);
+            break;
+        case MPVLocation::CELL:
+            alignTo(m_geometry->getCells(), defValue);
+            break;
+        case MPVLocation::INTERFACE:
+            alignTo(m_geometry->getInterfaces(), defValue);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+/*!
+ * Get the values of an aligned field as a plain contiguous array. The i-th value
+ * refers to the i-th structure of the linked geometry container of the field location.
+ * \return values of the field, empty if the field is not aligned.
+ */
+template<typename mpv_t>
+std::vector<mpv_t>
+MimmoPiercedVector<mpv_t>::getAlignedData() const{
+    std::vector<mpv_t> result;
+    if(!isAligned()) return result;
+    result.reserve(this->size());
+    for(auto it = this->cbegin(); it != this->cend(); ++it){
+        result.push_back(*it);
+    }
+    return result;
+}
+
+/*!
+ * Set the values of an aligned field from a plain contiguous array. The i-th value
+ * is assigned to the i-th structure of the linked geometry container of the field location.
+ * If the field is not aligned yet, it is aligned before assignment.
+ * \param[in] data values of the field, one for each structure of the geometry container.
+ * \return false if the field cannot be aligned or data size does not match the geometry container size.
+ */
+template<typename mpv_t>
+bool
+MimmoPiercedVector<mpv_t>::setAlignedData(const std::vector<mpv_t> & data){
+    if(!isAligned()){
+        if(!alignToGeometry(mpv_t())) return false;
+    }
+    if(data.size() != this->size()) return false;
+    auto itData = data.cbegin();
+    for(auto it = this->begin(); it != this->end(); ++it){
+        *it = *itData;
+        ++itData;
+    }
+    markDataChanged();
+    return true;
+}
+
+/*!
+ * Check if the field is aligned to a target geometry structures container.
+ * \param[in] structures geometry container
+ * \return true if the field holds one value for each structure, in the same order.
+ */
+template<typename mpv_t>
+template<typename structure_t>
+bool
+MimmoPiercedVector<mpv_t>::isAlignedTo(const bitpit::PiercedVector<structure_t, long int> & structures) const{
+    if(this->size() != structures.size()) return false;
+    auto itS = structures.cbegin();
+    for(auto it = this->cbegin(); it != this->cend(); ++it){
+        if(it.getId() != itS.getId()) return false;
+        ++itS;
+    }
+    return true;
+}
+
+/*!
+ * Align the field to a target geometry structures container.
+ * \param[in] structures geometry container
+ * \param[in] defValue value assigned to the structures with no value
+ */
+template<typename mpv_t>
+template<typename structure_t>
+void
+MimmoPiercedVector<mpv_t>::alignTo(const bitpit::PiercedVector<structure_t, long int> & structures, const mpv_t & defValue){
+    if(isAlignedTo(structures)) return;
+    bitpit::PiercedVector<mpv_t, long int> aligned;
+    aligned.reserve(structures.size());
+    long id;
+    for(auto itS = structures.cbegin(); itS != structures.cend(); ++itS){
+        id = itS.getId();
+        auto it = this->find(id);
+        if(it != this->end()){
+            aligned.insert(id, *it);
+        }else{
+            aligned.insert(id, defValue);
+        }
+    }
+    this->bitpit::PiercedVector<mpv_t, long int>::swap(aligned);
+    markDataChanged();
+}
+
 /*!
  * Copy data from another target MimmoPiercedVector of the same type.
  * - strict true: data transfer is made only on the shared ids of the structure.
@@ -850,6 +1019,7 @@ MimmoPiercedVector<mpv_t>::getDataFrom(const MimmoPiercedVector<mpv_t> & other,
             counter++;
         }
     }
+    if(counter > 0) markDataChanged();
     return counter;
 }
 
@@ -886,6 +1056,7 @@ MimmoPiercedVector<mpv_t>::squeezeOutExcept(const std::vector<long int> & list,
         }
         this->swap(result);
     }
+    markDataChanged();
 }
 
 /*!
@@ -920,6 +1091,7 @@ MimmoPiercedVector<mpv_t>::squeezeOutExcept(const std::unordered_set<long int> &
         }
         this->swap(result);
     }
+    markDataChanged();
 }
 
 #if MIMMO_ENABLE_MPI
@@ -1018,7 +1190,53 @@ MimmoPiercedVector<mpv_t>::communicateData(){
     // Wait for the sends to finish
     dataCommunicator->waitAllSends();
     dataCommunicator->finalize();
+
+    markDataChanged();
 }
 #endif
 
+/*!
+ * Convert a field to a field of another value type, e.g. of another precision.
+ * Ids, geometry, location and name of the field are preserved, as well as the order
+ * of its values, so that an aligned field is converted into an aligned field.
+ * \param[in] field field to be converted
+ * \return converted field
+ */
+template<typename dst_t, typename src_t>
+MimmoPiercedVector<dst_t>
+convertField(const MimmoPiercedVector<src_t> & field){
+    MimmoPiercedVector<dst_t> result(field.getGeometry(), field.getConstDataLocation());
+    result.setName(field.getName());
+    result.reserve(field.size());
+    for(auto it = field.cbegin(); it != field.cend(); ++it){
+        result.insert(it.getId(), MPVValueCast<dst_t, src_t>::apply(*it));
+    }
+    return result;
+}
+
+/*!
+ * Convert a field to single precision, e.g. to store it for writing or visualization purposes
+ * only. Values which are not floating point are copied as they are.
+ * \param[in] field field to be converted
+ * \return single precision field
+ */
+template<typename T>
+MimmoPiercedVector<typename MPVPrecision<T>::float32_type>
+toFloat32(const MimmoPiercedVector<T> & field){
+    return convertField<typename MPVPrecision<T>::float32_type>(field);
+}
+
+/*!
+ * Convert a field to double precision, e.g. to feed a single precision field to a block
+ * working in double precision.
+ * Values which are not floating point are copied as they are.
+ * \param[in] field field to be converted
+ * \return double precision field
+ */
+template<typename T>
+MimmoPiercedVector<typename MPVPrecision<T>::float64_type>
+toFloat64(const MimmoPiercedVector<T> & field){
+    return convertField<typename MPVPrecision<T>::float64_type>(field);
+}
+
 }
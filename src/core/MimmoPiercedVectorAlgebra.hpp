@@ -0,0 +1,517 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+#ifndef __MIMMOPIERCEDVECTORALGEBRA_HPP__
+#define __MIMMOPIERCEDVECTORALGEBRA_HPP__
+
+// This header is included at the end of MimmoPiercedVector.hpp: do not include it directly.
+
+#include <type_traits>
+#include <utility>
+#include <cmath>
+#include <algorithm>
+
+namespace mimmo{
+
+/*!
+ * \ingroup core
+ * \brief Layout of the fields involved in a MimmoPiercedVector algebraic expression.
+ *
+ * The layout is defined if at least one field is involved in the expression; it is aligned
+ * if all the fields are aligned (see MimmoPiercedVector::isAligned) to the same geometry
+ * and data location.
+ */
+struct MPVLayout{
+    MimmoSharedPointer<MimmoObject> geometry;   /**< geometry of the first field of the expression */
+    MPVLocation                     location;   /**< data location of the first field of the expression */
+    bool                            defined;    /**< true if at least one field is involved */
+    bool                            aligned;    /**< true if all the fields share the same aligned layout */
+
+    MPVLayout(): geometry(nullptr), location(MPVLocation::UNDEFINED), defined(false), aligned(true){};
+
+    /*!
+     * Merge the layout of another sub-expression into the current one.
+     * \param[in] other layout of the sub-expression
+     */
+    void merge(const MPVLayout & other){
+        if(!other.defined) return;
+        if(!defined){
+            *this = other;
+            return;
+        }
+        aligned = aligned && other.aligned && (geometry == other.geometry) && (location == other.location);
+    }
+};
+
+/*!
+ * \ingroup core
+ * \brief Return a pointer to the contiguous values of a MimmoPiercedVector.
+ * \param[in] field target field
+ * \return pointer to the first value if the values are stored without holes, nullptr otherwise.
+ */
+template<typename T>
+const T * mpvContiguousData(const MimmoPiercedVector<T> & field){
+    if(field.size() == 0) return nullptr;
+    const T * first = &(field.front());
+    const T * last = &(field.back());
+    if(std::size_t(last - first) + 1 != field.size()) return nullptr;
+    return first;
+}
+
+/*!
+ * \ingroup core
+ * \brief Return a pointer to the contiguous values of a MimmoPiercedVector.
+ * \param[in] field target field
+ * \return pointer to the first value if the values are stored without holes, nullptr otherwise.
+ */
+template<typename T>
+T * mpvContiguousData(MimmoPiercedVector<T> & field){
+    if(field.size() == 0) return nullptr;
+    T * first = &(field.front());
+    T * last = &(field.back());
+    if(std::size_t(last - first) + 1 != field.size()) return nullptr;
+    return first;
+}
+
+/*!
+ * \ingroup core
+ * \brief Boolean fields have no addressable contiguous storage.
+ * \return nullptr
+ */
+inline const bool * mpvContiguousData(const MimmoPiercedVector<bool> &){
+    return nullptr;
+}
+
+/*!
+ * \ingroup core
+ * \brief Boolean fields have no addressable contiguous storage.
+ * \return nullptr
+ */
+inline bool * mpvContiguousData(MimmoPiercedVector<bool> &){
+    return nullptr;
+}
+
+/*!
+ * \ingroup core
+ * \brief Leaf of an algebraic expression referring to a MimmoPiercedVector.
+ *
+ * Every node of an expression provides three evaluation paths, used by mimmo::evaluate
+ * and by the reductions according to the layout of the fields involved:
+ * - id access (at), for fields with different layouts;
+ * - lockstep traversal (begin/current/next), for aligned fields;
+ * - raw access (bindRaw/raw), for aligned fields with contiguous storage, which
+ *   reduces to plain loops over arrays.
+ *
+ * The leaf holds a reference to the field: expressions must not outlive their operands.
+ */
+template<typename T>
+class MPVTerminal: public MPVExpressionTag{
+public:
+    typedef T value_type;   /**< type of the values of the expression */
+
+    /*!
+     * Constructor.
+     * \param[in] field referred field
+     */
+    explicit MPVTerminal(const MimmoPiercedVector<T> & field): m_field(field), m_data(nullptr){};
+
+    /*! \return layout of the referred field */
+    MPVLayout layout() const{
+        MPVLayout result;
+        result.geometry = m_field.getGeometry();
+        result.location = m_field.getConstDataLocation();
+        result.defined = true;
+        result.aligned = m_field.isAligned();
+        return result;
+    }
+
+    /*!
+     * Fill the ids of the referred field.
+     * \param[out] ids ids of the field, in storage order
+     * \return true
+     */
+    bool referenceIds(livector1D & ids) const{
+        ids.clear();
+        ids.reserve(m_field.size());
+        for(auto it = m_field.cbegin(); it != m_field.cend(); ++it){
+            ids.push_back(it.getId());
+        }
+        return true;
+    }
+
+    /*!
+     * \param[in] id element id
+     * \return value of the element, value-initialized if the id is not in the field.
+     */
+    value_type at(long id) const{
+        auto it = m_field.find(id);
+        if(it == m_field.cend()) return value_type();
+        return *it;
+    }
+
+    /*! Start the lockstep traversal of the field. */
+    void begin() const{
+        m_it = m_field.cbegin();
+    }
+
+    /*! \return current value of the lockstep traversal */
+    value_type current() const{
+        return *m_it;
+    }
+
+    /*! Advance the lockstep traversal */
+    void next() const{
+        ++m_it;
+    }
+
+    /*!
+     * Bind the contiguous storage of the field for raw access.
+     * \return true if the field has contiguous storage.
+     */
+    bool bindRaw() const{
+        m_data = mpvContiguousData(m_field);
+        return (m_data != nullptr);
+    }
+
+    /*!
+     * \param[in] k position in the contiguous storage
+     * \return value in position k
+     */
+    value_type raw(std::size_t k) const{
+        return m_data[k];
+    }
+
+private:
+    const MimmoPiercedVector<T> &                            m_field;  /**< referred field */
+    mutable typename MimmoPiercedVector<T>::const_iterator   m_it;     /**< lockstep traversal iterator */
+    mutable const T *                                        m_data;   /**< bound contiguous storage */
+};
+
+/*!
+ * \ingroup core
+ * \brief Leaf of an algebraic expression holding a scalar constant.
+ */
+class MPVScalar: public MPVExpressionTag{
+public:
+    typedef double value_type;   /**< type of the values of the expression */
+
+    /*!
+     * Constructor.
+     * \param[in] value scalar constant
+     */
+    explicit MPVScalar(double value): m_value(value){};
+
+    /*! \return undefined layout */
+    MPVLayout layout() const{ return MPVLayout(); }
+    /*! \return false, scalars carry no ids */
+    bool referenceIds(livector1D &) const{ return false; }
+    /*! \return scalar constant */
+    value_type at(long) const{ return m_value; }
+    /*! Start lockstep traversal (nothing to do) */
+    void begin() const{}
+    /*! \return scalar constant */
+    value_type current() const{ return m_value; }
+    /*! Advance lockstep traversal (nothing to do) */
+    void next() const{}
+    /*! \return true */
+    bool bindRaw() const{ return true; }
+    /*! \return scalar constant */
+    value_type raw(std::size_t) const{ return m_value; }
+
+private:
+    double m_value;   /**< scalar constant */
+};
+
+/*!
+ * \ingroup core
+ * \brief Node of an algebraic expression applying an element-wise binary operation.
+ */
+template<typename L, typename R, typename Op>
+class MPVBinary: public MPVExpressionTag{
+public:
+    /*! type of the values of the expression */
+    typedef typename std::decay<decltype(std::declval<const Op &>()(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()))>::type value_type;
+
+    /*!
+     * Constructor.
+     * \param[in] left left operand
+     * \param[in] right right operand
+     * \param[in] op binary operation
+     */
+    MPVBinary(const L & left, const R & right, const Op & op = Op()): m_left(left), m_right(right), m_op(op){};
+
+    /*! \return merged layout of the operands */
+    MPVLayout layout() const{
+        MPVLayout result = m_left.layout();
+        result.merge(m_right.layout());
+        return result;
+    }
+    /*! \param[out] ids ids of the first field of the expression \return true if a field is found */
+    bool referenceIds(livector1D & ids) const{ return m_left.referenceIds(ids) || m_right.referenceIds(ids); }
+    /*! \param[in] id element id \return value of the element */
+    value_type at(long id) const{ return m_op(m_left.at(id), m_right.at(id)); }
+    /*! Start lockstep traversal */
+    void begin() const{ m_left.begin(); m_right.begin(); }
+    /*! \return current value of lockstep traversal */
+    value_type current() const{ return m_op(m_left.current(), m_right.current()); }
+    /*! Advance lockstep traversal */
+    void next() const{ m_left.next(); m_right.next(); }
+    /*! \return true if all the fields have contiguous storage */
+    bool bindRaw() const{
+        bool left = m_left.bindRaw();
+        bool right = m_right.bindRaw();
+        return left && right;
+    }
+    /*! \param[in] k position \return value in position k */
+    value_type raw(std::size_t k) const{ return m_op(m_left.raw(k), m_right.raw(k)); }
+
+private:
+    L  m_left;    /**< left operand */
+    R  m_right;   /**< right operand */
+    Op m_op;      /**< binary operation */
+};
+
+/*!
+ * \ingroup core
+ * \brief Node of an algebraic expression applying an element-wise unary operation.
+ */
+template<typename E, typename Op>
+class MPVUnary: public MPVExpressionTag{
+public:
+    /*! type of the values of the expression */
+    typedef typename std::decay<decltype(std::declval<const Op &>()(std::declval<typename E::value_type>()))>::type value_type;
+
+    /*!
+     * Constructor.
+     * \param[in] operand operand
+     * \param[in] op unary operation
+     */
+    MPVUnary(const E & operand, const Op & op = Op()): m_operand(operand), m_op(op){};
+
+    /*! \return layout of the operand */
+    MPVLayout layout() const{ return m_operand.layout(); }
+    /*! \param[out] ids ids of the first field of the expression \return true if a field is found */
+    bool referenceIds(livector1D & ids) const{ return m_operand.referenceIds(ids); }
+    /*! \param[in] id element id \return value of the element */
+    value_type at(long id) const{ return m_op(m_operand.at(id)); }
+    /*! Start lockstep traversal */
+    void begin() const{ m_operand.begin(); }
+    /*! \return current value of lockstep traversal */
+    value_type current() const{ return m_op(m_operand.current()); }
+    /*! Advance lockstep traversal */
+    void next() const{ m_operand.next(); }
+    /*! \return true if all the fields have contiguous storage */
+    bool bindRaw() const{ return m_operand.bindRaw(); }
+    /*! \param[in] k position \return value in position k */
+    value_type raw(std::size_t k) const{ return m_op(m_operand.raw(k)); }
+
+private:
+    E  m_operand;   /**< operand */
+    Op m_op;        /**< unary operation */
+};
+
+/*!
+ * \ingroup core
+ * \brief Element-wise operations of MimmoPiercedVector algebra.
+ * \{
+ */
+/*! Sum */
+struct MPVAdd{
+    template<typename A, typename B>
+    auto operator()(const A & a, const B & b) const -> decltype(a + b){ return a + b; }
+};
+/*! Difference */
+struct MPVSubtract{
+    template<typename A, typename B>
+    auto operator()(const A & a, const B & b) const -> decltype(a - b){ return a - b; }
+};
+/*! Product (Hadamard product for fields, scaling for scalars) */
+struct MPVMultiply{
+    template<typename A, typename B>
+    auto operator()(const A & a, const B & b) const -> decltype(a * b){ return a * b; }
+};
+/*! Division */
+struct MPVDivide{
+    template<typename A, typename B>
+    auto operator()(const A & a, const B & b) const -> decltype(a / b){ return a / b; }
+};
+/*! Negation */
+struct MPVNegate{
+    template<typename A>
+    auto operator()(const A & a) const -> decltype(-1.0 * a){ return -1.0 * a; }
+};
+/*! Euclidean norm of each element */
+struct MPVPointwiseNorm{
+    /*! \param[in] a value \return absolute value */
+    double operator()(double a) const{ return std::abs(a); }
+    /*! \param[in] a value \return euclidean norm */
+    template<std::size_t N>
+    double operator()(const std::array<double, N> & a) const{ return norm2(a); }
+};
+/*! Mask of elements whose norm is not lower than a threshold */
+struct MPVThresholdMask{
+    double threshold;   /**< threshold value */
+    /*! \param[in] a value \return 1 if norm of a is not lower than threshold, 0 otherwise */
+    template<typename A>
+    double operator()(const A & a) const{ return (MPVPointwiseNorm()(a) >= threshold) ? 1.0 : 0.0; }
+};
+/*!
+ * \}
+ */
+
+/*!
+ * \ingroup core
+ * \brief Traits mapping the operands of MimmoPiercedVector algebra to expression nodes.
+ */
+template<typename X, typename Enable = void>
+struct MPVOperand{
+    static const bool valid = false;   /**< not an operand */
+    static const bool field = false;   /**< not a field expression */
+};
+
+/*!
+ * \ingroup core
+ * \brief Fields are wrapped in a MPVTerminal leaf.
+ */
+template<typename T>
+struct MPVOperand<MimmoPiercedVector<T>, void>{
+    static const bool valid = true;     /**< valid operand */
+    static const bool field = true;     /**< field expression */
+    typedef MPVTerminal<T> type;        /**< expression node type */
+    /*! \param[in] x field \return expression node */
+    static type make(const MimmoPiercedVector<T> & x){ return type(x); }
+};
+
+/*!
+ * \ingroup core
+ * \brief Expressions are used as they are.
+ */
+template<typename X>
+struct MPVOperand<X, typename std::enable_if<std::is_base_of<MPVExpressionTag, X>::value>::type>{
+    static const bool valid = true;     /**< valid operand */
+    static const bool field = true;     /**< field expression */
+    typedef X type;                     /**< expression node type */
+    /*! \param[in] x expression \return expression node */
+    static const type & make(const X & x){ return x; }
+};
+
+/*!
+ * \ingroup core
+ * \brief Arithmetic values are wrapped in a MPVScalar leaf.
+ */
+template<typename X>
+struct MPVOperand<X, typename std::enable_if<std::is_arithmetic<X>::value>::type>{
+    static const bool valid = true;     /**< valid operand */
+    static const bool field = false;    /**< not a field expression */
+    typedef MPVScalar type;             /**< expression node type */
+    /*! \param[in] x scalar \return expression node */
+    static type make(X x){ return type(double(x)); }
+};
+
+/*!
+ * \ingroup core
+ * \brief Select the binary expression node when at least one of the operands is a field.
+ */
+template<typename A, typename B, typename Op,
+         bool enabled = (MPVOperand<A>::valid && MPVOperand<B>::valid && (MPVOperand<A>::field || MPVOperand<B>::field))>
+struct MPVBinaryEnable{};
+
+/*!
+ * \ingroup core
+ * \brief Binary expression node selected.
+ */
+template<typename A, typename B, typename Op>
+struct MPVBinaryEnable<A, B, Op, true>{
+    typedef MPVBinary<typename MPVOperand<A>::type, typename MPVOperand<B>::type, Op> type;   /**< expression node type */
+};
+
+/*!
+ * \ingroup core
+ * \brief Select the unary expression node when the operand is a field.
+ */
+template<typename A, typename Op, bool enabled = MPVOperand<A>::field>
+struct MPVUnaryEnable{};
+
+/*!
+ * \ingroup core
+ * \brief Unary expression node selected.
+ */
+template<typename A, typename Op>
+struct MPVUnaryEnable<A, Op, true>{
+    typedef MPVUnary<typename MPVOperand<A>::type, Op> type;   /**< expression node type */
+};
+
+template<typename A>
+typename MPVUnaryEnable<A, MPVPointwiseNorm>::type pointwiseNorm(const A & a);
+
+template<typename A>
+typename MPVUnaryEnable<A, MPVThresholdMask>::type thresholdMask(const A & a, double threshold);
+
+template<typename T, typename E>
+bool evaluate(const E & expression, MimmoPiercedVector<T> & result);
+
+template<typename E>
+typename MPVOperand<E>::type::value_type fieldSum(const E & expression, bool global = false);
+
+template<typename A, typename B>
+double fieldDot(const A & a, const B & b, bool global = false);
+
+template<typename E>
+double fieldNorm2(const E & expression, bool global = false);
+
+template<typename E>
+double fieldNormInf(const E & expression, bool global = false);
+
+}
+
+/*!
+ * \ingroup core
+ * \brief Operators of MimmoPiercedVector algebra.
+ *
+ * They are declared in the global namespace, as the bitpit operators on std::array
+ * and std::vector they compose with, so that none of them hides the others.
+ * Operands can be fields (MimmoPiercedVector), sub-expressions or arithmetic scalars;
+ * at least one of the two operands of binary operators must be a field or sub-expression.
+ * \{
+ */
+template<typename A, typename B>
+typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVAdd>::type operator+(const A & a, const B & b);
+
+template<typename A, typename B>
+typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVSubtract>::type operator-(const A & a, const B & b);
+
+template<typename A, typename B>
+typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVMultiply>::type operator*(const A & a, const B & b);
+
+template<typename A, typename B>
+typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVDivide>::type operator/(const A & a, const B & b);
+
+template<typename A>
+typename mimmo::MPVUnaryEnable<A, mimmo::MPVNegate>::type operator-(const A & a);
+/*!
+ * \}
+ */
+
+#include "MimmoPiercedVectorAlgebra.tpp"
+
+#endif /* __MIMMOPIERCEDVECTORALGEBRA_HPP__ */
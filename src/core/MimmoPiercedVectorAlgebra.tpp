@@ -0,0 +1,435 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+/*!
+ * Element-wise sum of two operands.
+ * \param[in] a first operand
+ * \param[in] b second operand
+ * \return expression node
+ */
+template<typename A, typename B>
+typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVAdd>::type operator+(const A & a, const B & b){
+    return typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVAdd>::type(mimmo::MPVOperand<A>::make(a), mimmo::MPVOperand<B>::make(b));
+}
+
+/*!
+ * Element-wise difference of two operands.
+ * \param[in] a first operand
+ * \param[in] b second operand
+ * \return expression node
+ */
+template<typename A, typename B>
+typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVSubtract>::type operator-(const A & a, const B & b){
+    return typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVSubtract>::type(mimmo::MPVOperand<A>::make(a), mimmo::MPVOperand<B>::make(b));
+}
+
+/*!
+ * Element-wise product of two operands (scaling if one of them is a scalar).
+ * \param[in] a first operand
+ * \param[in] b second operand
+ * \return expression node
+ */
+template<typename A, typename B>
+typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVMultiply>::type operator*(const A & a, const B & b){
+    return typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVMultiply>::type(mimmo::MPVOperand<A>::make(a), mimmo::MPVOperand<B>::make(b));
+}
+
+/*!
+ * Element-wise division of two operands.
+ * \param[in] a first operand
+ * \param[in] b second operand
+ * \return expression node
+ */
+template<typename A, typename B>
+typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVDivide>::type operator/(const A & a, const B & b){
+    return typename mimmo::MPVBinaryEnable<A, B, mimmo::MPVDivide>::type(mimmo::MPVOperand<A>::make(a), mimmo::MPVOperand<B>::make(b));
+}
+
+/*!
+ * Element-wise negation of an operand.
+ * \param[in] a operand
+ * \return expression node
+ */
+template<typename A>
+typename mimmo::MPVUnaryEnable<A, mimmo::MPVNegate>::type operator-(const A & a){
+    return typename mimmo::MPVUnaryEnable<A, mimmo::MPVNegate>::type(mimmo::MPVOperand<A>::make(a));
+}
+
+namespace mimmo{
+
+/*!
+ * Element-wise euclidean norm of an operand (absolute value for scalar fields).
+ * \param[in] a operand
+ * \return expression node
+ */
+template<typename A>
+typename MPVUnaryEnable<A, MPVPointwiseNorm>::type pointwiseNorm(const A & a){
+    return typename MPVUnaryEnable<A, MPVPointwiseNorm>::type(MPVOperand<A>::make(a));
+}
+
+/*!
+ * Element-wise mask of an operand: 1 where the element norm is not lower than threshold, 0 elsewhere.
+ * The result can be used as a filter field.
+ * \param[in] a operand
+ * \param[in] threshold threshold value
+ * \return expression node
+ */
+template<typename A>
+typename MPVUnaryEnable<A, MPVThresholdMask>::type thresholdMask(const A & a, double threshold){
+    MPVThresholdMask mask;
+    mask.threshold = threshold;
+    return typename MPVUnaryEnable<A, MPVThresholdMask>::type(MPVOperand<A>::make(a), mask);
+}
+
+/*!
+ * Evaluate an algebraic expression on MimmoPiercedVector fields in a single pass, storing
+ * the result in a target field, which can be an operand of the expression itself.
+ *
+ * If all the fields of the expression are aligned to the same geometry and location, the result
+ * is aligned to it too and the expression is evaluated traversing all the fields side by side,
+ * without any id lookup; if, in addition, all of them have contiguous storage, the evaluation
+ * reduces to a plain loop over arrays, which the compiler can vectorize.
+ * Otherwise, the result holds the ids of the first field of the expression and the other fields are
+ * accessed by id; missing ids are considered as value-initialized elements (zero for arithmetic types).
+ *
+ * \param[in] expression algebraic expression
+ * \param[in,out] result target field
+ * \return false if the expression involves no field, true otherwise.
+ */
+template<typename T, typename E>
+bool evaluate(const E & expression, MimmoPiercedVector<T> & result){
+
+    MPVLayout layout = expression.layout();
+    if(!layout.defined) return false;
+
+    if(layout.aligned){
+        // Result is not an operand of the expression if not aligned, so it can be freely reshaped.
+        bool resultAligned = (result.getGeometry() == layout.geometry) && (result.getConstDataLocation() == layout.location) && result.isAligned();
+        if(!resultAligned){
+            result.setGeometry(layout.geometry);
+            result.setDataLocation(layout.location);
+            result.alignToGeometry(T());
+        }
+
+        T * output = mpvContiguousData(result);
+        if(output != nullptr && expression.bindRaw()){
+            std::size_t size = result.size();
+            for(std::size_t k = 0; k < size; ++k){
+                output[k] = static_cast<T>(expression.raw(k));
+            }
+        }else{
+            expression.begin();
+            for(auto it = result.begin(); it != result.end(); ++it){
+                *it = static_cast<T>(expression.current());
+                expression.next();
+            }
+        }
+        result.markDataChanged();
+        return true;
+    }
+
+    livector1D ids;
+    expression.referenceIds(ids);
+    bitpit::PiercedVector<T, long int> values;
+    values.reserve(ids.size());
+    for(long id : ids){
+        values.insert(id, static_cast<T>(expression.at(id)));
+    }
+    result.setGeometry(layout.geometry);
+    result.setDataLocation(layout.location);
+    static_cast<bitpit::PiercedVector<T, long int> &>(result).swap(values);
+    result.markDataChanged();
+    return true;
+}
+
+/*!
+ * Assignment of an algebraic expression of fields, see mimmo::evaluate.
+ * \param[in] expression algebraic expression
+ */
+template<typename mpv_t>
+template<typename expr_t, typename>
+MimmoPiercedVector<mpv_t> & MimmoPiercedVector<mpv_t>::operator=(const expr_t & expression){
+    evaluate(expression, *this);
+    return *this;
+}
+
+/*!
+ * Check if a geometry element is interior, i.e. owned by the current process.
+ * \param[in] geometry target geometry
+ * \param[in] location element location
+ * \param[in] id element id
+ * \return true if the element is interior
+ */
+inline bool mpvIsInterior(MimmoSharedPointer<MimmoObject> geometry, MPVLocation location, long id){
+    switch(location){
+    case MPVLocation::POINT:
+        return geometry->isPointInterior(id);
+    case MPVLocation::CELL:
+        return geometry->getCells().at(id).isInterior();
+    case MPVLocation::INTERFACE:
+        return geometry->getCells().at(geometry->getInterfaces().at(id).getOwner()).isInterior();
+    default:
+        return true;
+    }
+}
+
+/*!
+ * Visit all the values of an expression in a single pass.
+ * \param[in] expression algebraic expression
+ * \param[in] visitor function called on each value
+ * \param[in] interiorOnly if true, values of non-interior elements are skipped
+ */
+template<typename E, typename F>
+void mpvVisit(const E & expression, F & visitor, bool interiorOnly){
+
+    MPVLayout layout = expression.layout();
+    if(!layout.defined) return;
+
+    if(layout.aligned && !interiorOnly){
+        std::size_t size = 0;
+        switch(layout.location){
+        case MPVLocation::POINT:
+            size = layout.geometry->getVertices().size();
+            break;
+        case MPVLocation::CELL:
+            size = layout.geometry->getCells().size();
+            break;
+        case MPVLocation::INTERFACE:
+            size = layout.geometry->getInterfaces().size();
+            break;
+        default:
+            break;
+        }
+        if(expression.bindRaw()){
+            for(std::size_t k = 0; k < size; ++k){
+                visitor(expression.raw(k));
+            }
+        }else{
+            expression.begin();
+            for(std::size_t k = 0; k < size; ++k){
+                visitor(expression.current());
+                expression.next();
+            }
+        }
+        return;
+    }
+
+    livector1D ids;
+    expression.referenceIds(ids);
+    for(long id : ids){
+        if(interiorOnly && !mpvIsInterior(layout.geometry, layout.location, id)) continue;
+        visitor(expression.at(id));
+    }
+}
+
+/*!
+ * \return true if a reduction on the expression has to be made global over the processes.
+ * \param[in] expression algebraic expression
+ * \param[in] global global reduction requested
+ */
+template<typename E>
+bool mpvIsGlobalReduction(const E & expression, bool global){
+#if MIMMO_ENABLE_MPI
+    MPVLayout layout = expression.layout();
+    return global && layout.defined && layout.geometry != nullptr && layout.geometry->isDistributed();
+#else
+    BITPIT_UNUSED(expression);
+    BITPIT_UNUSED(global);
+    return false;
+#endif
+}
+
+#if MIMMO_ENABLE_MPI
+/*!
+ * Global sum over the processes of a scalar value.
+ * \param[in,out] value reduced value
+ * \param[in] communicator MPI communicator
+ */
+inline void mpvAllReduceSum(double & value, const MPI_Comm & communicator){
+    MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_SUM, communicator);
+}
+
+/*!
+ * Global sum over the processes of a scalar value.
+ * \param[in,out] value reduced value
+ * \param[in] communicator MPI communicator
+ */
+inline void mpvAllReduceSum(long & value, const MPI_Comm & communicator){
+    MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_LONG, MPI_SUM, communicator);
+}
+
+/*!
+ * Global sum over the processes of a scalar value.
+ * \param[in,out] value reduced value
+ * \param[in] communicator MPI communicator
+ */
+inline void mpvAllReduceSum(int & value, const MPI_Comm & communicator){
+    MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_INT, MPI_SUM, communicator);
+}
+
+/*!
+ * Global sum over the processes of an array value.
+ * \param[in,out] value reduced value
+ * \param[in] communicator MPI communicator
+ */
+template<std::size_t N>
+void mpvAllReduceSum(std::array<double, N> & value, const MPI_Comm & communicator){
+    MPI_Allreduce(MPI_IN_PLACE, value.data(), int(N), MPI_DOUBLE, MPI_SUM, communicator);
+}
+#endif
+
+/*!
+ * Element-wise dot product of two values.
+ * \param[in] a first value
+ * \param[in] b second value
+ * \return product a*b
+ */
+inline double mpvDot(double a, double b){
+    return a * b;
+}
+
+/*!
+ * Element-wise dot product of two values.
+ * \param[in] a first value
+ * \param[in] b second value
+ * \return dot product of a and b
+ */
+template<std::size_t N>
+double mpvDot(const std::array<double, N> & a, const std::array<double, N> & b){
+    return dotProduct(a, b);
+}
+
+/*!
+ * \ingroup core
+ * \brief Element-wise dot product operation of MimmoPiercedVector algebra.
+ */
+struct MPVDot{
+    /*! \param[in] u first value \param[in] v second value \return dot product */
+    template<typename U, typename V>
+    double operator()(const U & u, const V & v) const{ return mpvDot(u, v); }
+};
+
+/*!
+ * Sum of all the values of an expression, evaluated in a single pass.
+ * \param[in] expression field or algebraic expression
+ * \param[in] global if true, the sum is made over all the processes, counting only interior
+ * elements of a distributed geometry (meaningful only in MPI version).
+ * \return sum of the values
+ */
+template<typename E>
+typename MPVOperand<E>::type::value_type fieldSum(const E & expression, bool global){
+    typedef typename MPVOperand<E>::type expression_t;
+    typedef typename expression_t::value_type value_t;
+    const expression_t & expr = MPVOperand<E>::make(expression);
+
+    bool isGlobal = mpvIsGlobalReduction(expr, global);
+    value_t result = value_t();
+    auto visitor = [&result](const value_t & value){ result = result + value; };
+    mpvVisit(expr, visitor, isGlobal);
+#if MIMMO_ENABLE_MPI
+    if(isGlobal){
+        mpvAllReduceSum(result, expr.layout().geometry->getCommunicator());
+    }
+#endif
+    return result;
+}
+
+/*!
+ * Dot product of two fields or expressions, i.e. sum of the element-wise dot products,
+ * evaluated in a single pass.
+ * \param[in] a first field or algebraic expression
+ * \param[in] b second field or algebraic expression
+ * \param[in] global if true, the product is made over all the processes, counting only interior
+ * elements of a distributed geometry (meaningful only in MPI version).
+ * \return dot product
+ */
+template<typename A, typename B>
+double fieldDot(const A & a, const B & b, bool global){
+    typedef typename MPVOperand<A>::type left_t;
+    typedef typename MPVOperand<B>::type right_t;
+    MPVBinary<left_t, right_t, MPVDot> expr(MPVOperand<A>::make(a), MPVOperand<B>::make(b));
+
+    bool isGlobal = mpvIsGlobalReduction(expr, global);
+    double result = 0.0;
+    auto visitor = [&result](double value){ result += value; };
+    mpvVisit(expr, visitor, isGlobal);
+#if MIMMO_ENABLE_MPI
+    if(isGlobal){
+        mpvAllReduceSum(result, expr.layout().geometry->getCommunicator());
+    }
+#endif
+    return result;
+}
+
+/*!
+ * Euclidean norm of a field or expression, evaluated in a single pass.
+ * \param[in] expression field or algebraic expression
+ * \param[in] global if true, the norm is made over all the processes, counting only interior
+ * elements of a distributed geometry (meaningful only in MPI version).
+ * \return euclidean norm
+ */
+template<typename E>
+double fieldNorm2(const E & expression, bool global){
+    typedef typename MPVOperand<E>::type expression_t;
+    const expression_t & expr = MPVOperand<E>::make(expression);
+
+    bool isGlobal = mpvIsGlobalReduction(expr, global);
+    double result = 0.0;
+    auto visitor = [&result](const typename expression_t::value_type & value){ result += mpvDot(value, value); };
+    mpvVisit(expr, visitor, isGlobal);
+#if MIMMO_ENABLE_MPI
+    if(isGlobal){
+        mpvAllReduceSum(result, expr.layout().geometry->getCommunicator());
+    }
+#endif
+    return std::sqrt(result);
+}
+
+/*!
+ * Infinity norm of a field or expression, i.e. the maximum element-wise euclidean norm,
+ * evaluated in a single pass.
+ * \param[in] expression field or algebraic expression
+ * \param[in] global if true, the norm is made over all the processes (meaningful only in MPI version).
+ * \return infinity norm
+ */
+template<typename E>
+double fieldNormInf(const E & expression, bool global){
+    typedef typename MPVOperand<E>::type expression_t;
+    const expression_t & expr = MPVOperand<E>::make(expression);
+
+    bool isGlobal = mpvIsGlobalReduction(expr, global);
+    double result = 0.0;
+    MPVPointwiseNorm norm;
+    auto visitor = [&result, &norm](const typename expression_t::value_type & value){ result = std::max(result, norm(value)); };
+    // ghost elements carry copies of interior values: no need to skip them for maximum.
+    mpvVisit(expr, visitor, false);
+#if MIMMO_ENABLE_MPI
+    if(isGlobal){
+        MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_DOUBLE, MPI_MAX, expr.layout().geometry->getCommunicator());
+    }
+#endif
+    return result;
+}
+
+}
@@ -80,8 +80,11 @@ double distance(const std::array<double,3> *point, const bitpit::PatchSkdTree *t
  * \param[in] r Length of the side of the box or radius of the sphere used to search. (The algorithm checks
  * every element encountered inside the box/sphere).
  * \return Signed distance of the input point from the patch in the skd-tree.
+ * \param[in] vertexNormals (optional) pointer to cached vertex pseudo-normals of the surface mesh
+ * (see MimmoObject::buildVertexNormals). If null, vertex normals are evaluated on-the-fly.
  */
-double signedDistance(const std::array<double,3> *point, const bitpit::PatchSkdTree *tree, long &id, std::array<double,3> &normal, double r)
+double signedDistance(const std::array<double,3> *point, const bitpit::PatchSkdTree *tree, long &id, std::array<double,3> &normal, double r,
+                      const bitpit::PiercedVector<std::array<double,3>, long> *vertexNormals)
 {
 
     double h = std::numeric_limits<double>::max();
@@ -96,7 +99,7 @@ double signedDistance(const std::array<double,3> *point, const bitpit::PatchSkdT
 
     static_cast<const bitpit::SurfaceSkdTree*>(tree)->findPointClosestCell(*point, r, &id, &h);
 
-    double s = computePseudoNormal(*point, spatch, id, normal);
+    double s = computePseudoNormal(*point, spatch, id, normal, vertexNormals);
     return s*h;
 
 }
@@ -182,11 +185,14 @@ void distance(int nP, const std::array<double,3> *points, const bitpit::PatchSkd
  * the projection of P on the plane of the simplex.
  * \param[in] r Length of the side of the box or radius of the sphere used to search. (The algorithm checks
  * every element encountered inside the box/sphere).
+ * \param[in] vertexNormals (optional) pointer to cached vertex pseudo-normals of the surface mesh
+ * (see MimmoObject::buildVertexNormals). If null, vertex normals are evaluated on-the-fly.
  */
-void signedDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, double *distances, std::array<double,3> *normals, double r)
+void signedDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, double *distances, std::array<double,3> *normals, double r,
+                    const bitpit::PiercedVector<std::array<double,3>, long> *vertexNormals)
 {
     std::vector<double> rs(nP, r);
-    signedDistance(nP, points, tree, ids, distances, normals, rs.data());
+    signedDistance(nP, points, tree, ids, distances, normals, rs.data(), vertexNormals);
 }
 
 /*!
@@ -209,8 +215,11 @@ void signedDistance(int nP, const std::array<double,3> *points, const bitpit::Pa
  * the projection of P on the plane of the simplex.
  * \param[in] r Length of the side of the box or radius of the sphere used to search for each input
  * point. (The algorithm checks every element encountered inside the box/sphere).
+ * \param[in] vertexNormals (optional) pointer to cached vertex pseudo-normals of the surface mesh
+ * (see MimmoObject::buildVertexNormals). If null, vertex normals are evaluated on-the-fly.
  */
-void signedDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, double *distances, std::array<double,3> *normals, double *r)
+void signedDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, double *distances, std::array<double,3> *normals, double *r,
+                    const bitpit::PiercedVector<std::array<double,3>, long> *vertexNormals)
 {
 
     // Initialize distances
@@ -232,7 +241,7 @@ void signedDistance(int nP, const std::array<double,3> *points, const bitpit::Pa
         double *distance = &distances[ip];
         double rpoint = r[ip];
         static_cast<const bitpit::SurfaceSkdTree*>(tree)->findPointClosestCell(*point, rpoint, id, distance);
-        double s = computePseudoNormal(*point, spatch, *id, normals[ip]);
+        double s = computePseudoNormal(*point, spatch, *id, normals[ip], vertexNormals);
         *distance *= s;
     }
 
@@ -510,11 +519,14 @@ long locatePointOnPatch(const std::array<double, 3> &point, const bitpit::PatchS
  * \param[in] surface_mesh pointer to surface mesh
  * \param[in] id cell id belong to the input surface mesh
  * \param[out] pseudo_normal 3-components array representing the pseudo-normal.
+ * \param[in] vertexNormals (optional) pointer to cached vertex pseudo-normals of the surface mesh
+   (see MimmoObject::buildVertexNormals). If null, vertex normals are evaluated on-the-fly.
    \return +/- 1.0 to identify if the pseudo normal is pointing in the same direction
     of the local surface normal or in the opposite side.
  */
 double
-computePseudoNormal(const std::array<double, 3> &point, const bitpit::SurfUnstructured *surface_mesh, long id, std::array<double, 3> &pseudo_normal)
+computePseudoNormal(const std::array<double, 3> &point, const bitpit::SurfUnstructured *surface_mesh, long id, std::array<double, 3> &pseudo_normal,
+                    const bitpit::PiercedVector<std::array<double,3>, long> *vertexNormals)
 {
 
     pseudo_normal.fill(0.);
@@ -535,12 +547,20 @@ computePseudoNormal(const std::array<double, 3> &point, const bitpit::SurfUnstru
         darray3E xP = {{0.0,0.0,0.0}};
         darray3E normal= {{0.0,0.0,0.0}};
 
+        // Vertex normals are taken from cache if available, otherwise evaluated on the vertex one-ring.
+        auto vertexNormal = [&](int local){
+            if (vertexNormals && vertexNormals->exists(vertIds[local])){
+                return vertexNormals->at(vertIds[local]);
+            }
+            return surface_mesh->evalVertexNormal(id, local);
+        };
+
         if ( vertIds.size() == 3 ){ //TRIANGLE
             darray3E lambda;
             h = bitpit::CGElem::distancePointTriangle(point, VS[0], VS[1], VS[2],lambda);
             int count = 0;
             for(const auto &val: lambda){
-                normal += val * surface_mesh->evalVertexNormal(id,count) ;
+                normal += val * vertexNormal(count);
                 xP += val * VS[count];
                 ++count;
             }
@@ -549,7 +569,7 @@ computePseudoNormal(const std::array<double, 3> &point, const bitpit::SurfUnstru
             h = bitpit::CGElem::distancePointSegment(point, VS[0], VS[1], lambda);
             int count = 0;
             for(const auto &val: lambda){
-                normal += val * surface_mesh->evalVertexNormal(id,count) ;
+                normal += val * vertexNormal(count);
                 xP += val * VS[count];
                 ++count;
             }
@@ -558,7 +578,7 @@ computePseudoNormal(const std::array<double, 3> &point, const bitpit::SurfUnstru
             h = bitpit::CGElem::distancePointPolygon(point, VS,lambda);
             int count = 0;
             for(const auto &val: lambda){
-                normal += val * surface_mesh->evalVertexNormal(id,count) ;
+                normal += val * vertexNormal(count);
                 xP += val * VS[count];
                 ++count;
             }
@@ -686,11 +706,14 @@ void globalDistance(int nP, const std::array<double,3> *points, const bitpit::Pa
  * \param[in] shared True if the input points are shared between the processes
  * \param[in] r Length of the side of the box or radius of the sphere used to search. (The algorithm checks
  * every element encountered inside the box/sphere).
+ * \param[in] vertexNormals (optional) pointer to cached vertex pseudo-normals of the surface mesh
+ * (see MimmoObject::buildVertexNormals). If null, vertex normals are evaluated on-the-fly.
  */
-void signedGlobalDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, int *ranks, std::array<double,3> *normals, double *distances, double r, bool shared)
+void signedGlobalDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, int *ranks, std::array<double,3> *normals, double *distances, double r, bool shared,
+                          const bitpit::PiercedVector<std::array<double,3>, long> *vertexNormals)
 {
     std::vector<double> rs(nP, r);
-    signedGlobalDistance(nP, points, tree, ids, ranks, normals, distances, rs.data(), shared);
+    signedGlobalDistance(nP, points, tree, ids, ranks, normals, distances, rs.data(), shared, vertexNormals);
 }
 
 /*!
@@ -708,8 +731,11 @@ void signedGlobalDistance(int nP, const std::array<double,3> *points, const bitp
  * \param[in] shared True if the input points are shared between the processes
  * \param[in] r Length of the side of the box or radius of the sphere used to search for each input point. (The algorithm checks
  * every element encountered inside the box/sphere).
+ * \param[in] vertexNormals (optional) pointer to cached vertex pseudo-normals of the surface mesh
+ * (see MimmoObject::buildVertexNormals). If null, vertex normals are evaluated on-the-fly.
  */
-void signedGlobalDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, int *ranks, std::array<double,3> *normals, double *distances, double *r, bool shared)
+void signedGlobalDistance(int nP, const std::array<double,3> *points, const bitpit::PatchSkdTree *tree, long *ids, int *ranks, std::array<double,3> *normals, double *distances, double *r, bool shared,
+                          const bitpit::PiercedVector<std::array<double,3>, long> *vertexNormals)
 {
 
     if(!tree){
@@ -750,7 +776,7 @@ void signedGlobalDistance(int nP, const std::array<double,3> *points, const bitp
         // If the current rank is the the owner of the cell compute normal
         if (cellRank == myrank){
 
-            double s = computePseudoNormal(point, &spatch, cellId, pseudo_normal);
+            double s = computePseudoNormal(point, &spatch, cellId, pseudo_normal, vertexNormals);
             if(cellId != bitpit::Cell::NULL_ID){
                 if (shared) {
                     signs[ip] = s;
@@ -854,7 +880,7 @@ void signedGlobalDistance(int nP, const std::array<double,3> *points, const bitp
                     std::array<double,3> & pseudo_normal = normal_to_rank[irank][ip];
                     double & s = sign_to_rank[irank][ip];
 
-                    s = computePseudoNormal(point, &spatch, cellId, pseudo_normal);
+                    s = computePseudoNormal(point, &spatch, cellId, pseudo_normal, vertexNormals);
 
                 } // end loop on points received
             }  // end loop on ranks
@@ -0,0 +1,854 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "VTUStreamIO.hpp"
+#include <cctype>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#if MIMMO_ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace mimmo{
+
+/*!
+ * \return true if the current architecture is little endian.
+ */
+static bool isLittleEndian(){
+    uint16_t value = 1;
+    unsigned char first;
+    std::memcpy(&first, &value, 1);
+    return (first == 1);
+}
+
+/*!
+ * \return VTK cell type code of a bitpit element type (0 if not supported).
+ * \param[in] type bitpit element type
+ */
+static uint8_t vtkCellType(bitpit::ElementType type){
+    switch(type){
+    case bitpit::ElementType::VERTEX:       return uint8_t(bitpit::VTKElementType::VERTEX);
+    case bitpit::ElementType::LINE:         return uint8_t(bitpit::VTKElementType::LINE);
+    case bitpit::ElementType::TRIANGLE:     return uint8_t(bitpit::VTKElementType::TRIANGLE);
+    case bitpit::ElementType::PIXEL:        return uint8_t(bitpit::VTKElementType::PIXEL);
+    case bitpit::ElementType::QUAD:         return uint8_t(bitpit::VTKElementType::QUAD);
+    case bitpit::ElementType::POLYGON:      return uint8_t(bitpit::VTKElementType::POLYGON);
+    case bitpit::ElementType::TETRA:        return uint8_t(bitpit::VTKElementType::TETRA);
+    case bitpit::ElementType::VOXEL:        return uint8_t(bitpit::VTKElementType::VOXEL);
+    case bitpit::ElementType::HEXAHEDRON:   return uint8_t(bitpit::VTKElementType::HEXAHEDRON);
+    case bitpit::ElementType::WEDGE:        return uint8_t(bitpit::VTKElementType::WEDGE);
+    case bitpit::ElementType::PYRAMID:      return uint8_t(bitpit::VTKElementType::PYRAMID);
+    case bitpit::ElementType::POLYHEDRON:   return uint8_t(bitpit::VTKElementType::POLYHEDRON);
+    default:                                return 0;
+    }
+}
+
+/*!
+ * \return bitpit element type of a VTK cell type code (UNDEFINED if not supported).
+ * \param[in] type VTK cell type code
+ */
+static bitpit::ElementType elementType(long type){
+    switch(type){
+    case 1:     return bitpit::ElementType::VERTEX;
+    case 3:     return bitpit::ElementType::LINE;
+    case 5:     return bitpit::ElementType::TRIANGLE;
+    case 7:     return bitpit::ElementType::POLYGON;
+    case 8:     return bitpit::ElementType::PIXEL;
+    case 9:     return bitpit::ElementType::QUAD;
+    case 10:    return bitpit::ElementType::TETRA;
+    case 11:    return bitpit::ElementType::VOXEL;
+    case 12:    return bitpit::ElementType::HEXAHEDRON;
+    case 13:    return bitpit::ElementType::WEDGE;
+    case 14:    return bitpit::ElementType::PYRAMID;
+    case 42:    return bitpit::ElementType::POLYHEDRON;
+    default:    return bitpit::ElementType::UNDEFINED;
+    }
+}
+
+/*!
+ * Get the value of an attribute of a XML tag.
+ * \param[in] tag text of the tag
+ * \param[in] name name of the attribute
+ * \return value of the attribute, empty if not found.
+ */
+static std::string xmlAttribute(const std::string & tag, const std::string & name){
+    std::string key = name + "=\"";
+    std::size_t pos = tag.find(key);
+    while(pos != std::string::npos && pos > 0 && !std::isspace(static_cast<unsigned char>(tag[pos-1]))){
+        pos = tag.find(key, pos + 1);
+    }
+    if(pos == std::string::npos) return "";
+    pos += key.size();
+    std::size_t end = tag.find('"', pos);
+    if(end == std::string::npos) return "";
+    return tag.substr(pos, end - pos);
+}
+
+/*!
+ * \return size in bytes of a VTK data type, 0 if not supported.
+ * \param[in] type VTK data type name
+ */
+static std::size_t vtkTypeSize(const std::string & type){
+    if(type == "Int8" || type == "UInt8")                               return 1;
+    if(type == "Int16" || type == "UInt16")                             return 2;
+    if(type == "Int32" || type == "UInt32" || type == "Float32")        return 4;
+    if(type == "Int64" || type == "UInt64" || type == "Float64")        return 8;
+    return 0;
+}
+
+/*!
+ * Default settings: uncompressed blocks of 1 MB, double precision coordinates.
+ */
+VTUStreamOptions::VTUStreamOptions() : compress(false), float32(false), blockSize(std::size_t(1) << 20){}
+
+/*!
+ * \class VTUStreamWriter::BlockWriter
+ * \brief Encoder of a data array of known size in appended raw binary blocks.
+ *
+ * Uncompressed arrays are written as a byte count followed by the data. Compressed arrays are written
+ * with the header of vtkZLibDataCompressor (number of blocks, block size, size of the partial last block,
+ * compressed size of each block), reserved at the beginning and filled once all the blocks are written.
+ */
+class VTUStreamWriter::BlockWriter{
+
+public:
+    /*!
+     * Constructor. It writes/reserves the header of the array.
+     * \param[in] out output stream
+     * \param[in] nBytes total size in bytes of the array
+     * \param[in] blockSize size in bytes of the blocks, multiple of 8
+     * \param[in] compress true to compress the blocks
+     */
+    BlockWriter(std::ostream & out, uint64_t nBytes, std::size_t blockSize, bool compress)
+        : m_out(out), m_nBytes(nBytes), m_written(0), m_blockSize(blockSize), m_compress(compress), m_used(0)
+    {
+        m_buffer.resize(std::size_t(std::min(uint64_t(m_blockSize), m_nBytes)));
+        if(m_compress){
+            uint64_t nBlocks = (m_nBytes + m_blockSize - 1) / m_blockSize;
+            m_compressedSizes.reserve(nBlocks);
+            m_header = m_out.tellp();
+            std::vector<uint64_t> header(3 + nBlocks, 0);
+            m_out.write(reinterpret_cast<const char *>(header.data()), header.size() * sizeof(uint64_t));
+        }else{
+            m_out.write(reinterpret_cast<const char *>(&m_nBytes), sizeof(uint64_t));
+        }
+    }
+
+    /*!
+     * Append a value to the array.
+     * \param[in] value value to be appended
+     */
+    template<typename T>
+    void append(T value){
+        std::memcpy(m_buffer.data() + m_used, &value, sizeof(T));
+        m_used += sizeof(T);
+        if(m_used == m_buffer.size()) flushBlock();
+    }
+
+    /*!
+     * Write the last block and complete the header of compressed arrays.
+     */
+    void finish(){
+        if(m_used > 0) flushBlock();
+        if(m_written != m_nBytes){
+            throw std::runtime_error("VTUStreamWriter : size mismatch in appended data array");
+        }
+        if(m_compress){
+            std::streampos end = m_out.tellp();
+            uint64_t header[3] = {uint64_t(m_compressedSizes.size()), uint64_t(m_blockSize), m_nBytes % m_blockSize};
+            m_out.seekp(m_header);
+            m_out.write(reinterpret_cast<const char *>(header), 3 * sizeof(uint64_t));
+            m_out.write(reinterpret_cast<const char *>(m_compressedSizes.data()), m_compressedSizes.size() * sizeof(uint64_t));
+            m_out.seekp(end);
+        }
+    }
+
+private:
+    std::ostream &          m_out;              /**< output stream */
+    uint64_t                m_nBytes;           /**< total size in bytes of the array */
+    uint64_t                m_written;          /**< bytes of the array already encoded */
+    std::size_t             m_blockSize;        /**< size in bytes of the blocks */
+    bool                    m_compress;         /**< compression flag */
+    std::vector<char>       m_buffer;           /**< current block */
+    std::size_t             m_used;             /**< bytes used in the current block */
+    std::vector<char>       m_compressed;       /**< compressed block */
+    std::vector<uint64_t>   m_compressedSizes;  /**< compressed size of the written blocks */
+    std::streampos          m_header;           /**< position of the header of compressed arrays */
+
+    /*!
+     * Write the current block.
+     */
+    void flushBlock(){
+#if MIMMO_ENABLE_ZLIB
+        if(m_compress){
+            uLongf size = compressBound(uLong(m_used));
+            m_compressed.resize(size);
+            if(compress2(reinterpret_cast<Bytef *>(m_compressed.data()), &size,
+                         reinterpret_cast<const Bytef *>(m_buffer.data()), uLong(m_used), Z_BEST_SPEED) != Z_OK){
+                throw std::runtime_error("VTUStreamWriter : zlib compression failed");
+            }
+            m_out.write(m_compressed.data(), size);
+            m_compressedSizes.push_back(uint64_t(size));
+        }else
+#endif
+        {
+            m_out.write(m_buffer.data(), m_used);
+        }
+        m_written += m_used;
+        m_used = 0;
+    }
+};
+
+/*!
+ * Constructor.
+ * \param[in] options writing settings
+ */
+VTUStreamWriter::VTUStreamWriter(const VTUStreamOptions & options) : m_options(options){}
+
+/*!
+ * Write a geometry on a *.vtu file. Only the cells of the VTK write range of the patch and
+ * the vertices they reference are written.
+ * \param[in] geometry geometry to be written
+ * \param[in] filename full name of the file, extension included
+ */
+void VTUStreamWriter::write(MimmoObject * geometry, const std::string & filename){
+
+    if(geometry == nullptr){
+        throw std::runtime_error("VTUStreamWriter : no geometry to write");
+    }
+    bitpit::PatchKernel & patch = *(geometry->getPatch());
+
+#if MIMMO_ENABLE_ZLIB
+    bool compress = m_options.compress;
+#else
+    bool compress = false;
+#endif
+    // blocks are a multiple of the size of any written value, so that no value is split between blocks
+    std::size_t blockSize = std::max(std::size_t(8), m_options.blockSize / 8 * 8);
+
+    // VTK numbering of the written vertices and dimensions of the mesh
+    bitpit::PiercedStorage<long, long> vtkVertexMap(1, &(patch.getVertices()));
+    vtkVertexMap.fill(bitpit::Vertex::NULL_ID);
+
+    bool faceStreamNeeded = false;
+    uint64_t nCells = 0, connectSize = 0, faceStreamSize = 0;
+    for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+        if (cell.getDimension() > 2 && !cell.hasInfo()) {
+            faceStreamNeeded = true;
+        }
+        bitpit::ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+        for (long vertexId : cellVertexIds) {
+            vtkVertexMap.at(vertexId) = 0;
+        }
+        connectSize += cellVertexIds.size();
+        faceStreamSize += (cell.getDimension() <= 2 || cell.hasInfo()) ? 1 : cell.getFaceStreamSize();
+        ++nCells;
+    }
+    uint64_t nPoints = 0;
+    for (bitpit::PatchKernel::VertexConstIterator itr = patch.vertexConstBegin(); itr != patch.vertexConstEnd(); ++itr) {
+        long & vtkId = vtkVertexMap.rawAt(itr.getRawIndex());
+        if (vtkId != bitpit::Vertex::NULL_ID) vtkId = nPoints++;
+    }
+
+    std::ofstream out(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!out.is_open()){
+        throw std::runtime_error("VTUStreamWriter : impossible to open file " + filename);
+    }
+
+    // XML header, offsets of the arrays are reserved and filled at the end
+    std::vector<std::streampos> offsetPositions;
+    auto declareArray = [&out, &offsetPositions](const std::string & name, const std::string & type, int components){
+        out << "        <DataArray type=\"" << type << "\" Name=\"" << name << "\" NumberOfComponents=\"" << components << "\" format=\"appended\" offset=\"";
+        offsetPositions.push_back(out.tellp());
+        out << std::string(20, ' ') << "\"/>\n";
+    };
+
+    out << "<?xml version=\"1.0\"?>\n";
+    out << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << (isLittleEndian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\"";
+    if(compress) out << " compressor=\"vtkZLibDataCompressor\"";
+    out << ">\n";
+    out << "  <UnstructuredGrid>\n";
+    out << "    <Piece NumberOfPoints=\"" << nPoints << "\" NumberOfCells=\"" << nCells << "\">\n";
+    out << "      <PointData>\n";
+    declareArray("vertexIndex", "Int64", 1);
+#if MIMMO_ENABLE_MPI
+    declareArray("vertexRank", "Int32", 1);
+#endif
+    out << "      </PointData>\n";
+    out << "      <CellData>\n";
+    declareArray("cellIndex", "Int64", 1);
+    declareArray("PID", "Int32", 1);
+#if MIMMO_ENABLE_MPI
+    declareArray("cellGlobalIndex", "Int64", 1);
+    declareArray("cellRank", "Int32", 1);
+#endif
+    out << "      </CellData>\n";
+    out << "      <Points>\n";
+    declareArray("Points", (m_options.float32 ? "Float32" : "Float64"), 3);
+    out << "      </Points>\n";
+    out << "      <Cells>\n";
+    declareArray("connectivity", "Int64", 1);
+    declareArray("offsets", "Int64", 1);
+    declareArray("types", "UInt8", 1);
+    if(faceStreamNeeded){
+        declareArray("faces", "Int64", 1);
+        declareArray("faceoffsets", "Int64", 1);
+    }
+    out << "      </Cells>\n";
+    out << "    </Piece>\n";
+    out << "  </UnstructuredGrid>\n";
+    out << "  <AppendedData encoding=\"raw\">\n_";
+
+    // appended data, in the order of declaration
+    std::streampos appendedBegin = out.tellp();
+    std::vector<uint64_t> offsets;
+    auto beginArray = [&out, &offsets, &appendedBegin](){
+        offsets.push_back(uint64_t(out.tellp() - appendedBegin));
+    };
+
+    {
+        beginArray();
+        BlockWriter writer(out, nPoints * sizeof(int64_t), blockSize, compress);
+        for (bitpit::PatchKernel::VertexConstIterator itr = patch.vertexConstBegin(); itr != patch.vertexConstEnd(); ++itr) {
+            if (vtkVertexMap.rawAt(itr.getRawIndex()) != bitpit::Vertex::NULL_ID) writer.append(int64_t(itr.getId()));
+        }
+        writer.finish();
+    }
+#if MIMMO_ENABLE_MPI
+    {
+        beginArray();
+        BlockWriter writer(out, nPoints * sizeof(int32_t), blockSize, compress);
+        for (bitpit::PatchKernel::VertexConstIterator itr = patch.vertexConstBegin(); itr != patch.vertexConstEnd(); ++itr) {
+            if (vtkVertexMap.rawAt(itr.getRawIndex()) != bitpit::Vertex::NULL_ID) writer.append(int32_t(patch.getVertexRank(itr.getId())));
+        }
+        writer.finish();
+    }
+#endif
+    {
+        beginArray();
+        BlockWriter writer(out, nCells * sizeof(int64_t), blockSize, compress);
+        for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+            writer.append(int64_t(cell.getId()));
+        }
+        writer.finish();
+    }
+    {
+        beginArray();
+        BlockWriter writer(out, nCells * sizeof(int32_t), blockSize, compress);
+        for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+            writer.append(int32_t(cell.getPID()));
+        }
+        writer.finish();
+    }
+#if MIMMO_ENABLE_MPI
+    {
+        beginArray();
+        bitpit::PatchNumberingInfo numberingInfo(&patch);
+        BlockWriter writer(out, nCells * sizeof(int64_t), blockSize, compress);
+        for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+            writer.append(int64_t(numberingInfo.getCellGlobalId(cell.getId())));
+        }
+        writer.finish();
+    }
+    {
+        beginArray();
+        BlockWriter writer(out, nCells * sizeof(int32_t), blockSize, compress);
+        for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+            writer.append(int32_t(patch.getCellRank(cell.getId())));
+        }
+        writer.finish();
+    }
+#endif
+    {
+        beginArray();
+        std::size_t valueSize = m_options.float32 ? sizeof(float) : sizeof(double);
+        BlockWriter writer(out, 3 * nPoints * valueSize, blockSize, compress);
+        auto & vertices = patch.getVertices();
+        for (bitpit::PatchKernel::VertexConstIterator itr = patch.vertexConstBegin(); itr != patch.vertexConstEnd(); ++itr) {
+            std::size_t rawIndex = itr.getRawIndex();
+            if (vtkVertexMap.rawAt(rawIndex) == bitpit::Vertex::NULL_ID) continue;
+            const std::array<double, 3> & coords = vertices.rawAt(rawIndex).getCoords();
+            for (double val : coords) {
+                if (m_options.float32) {
+                    writer.append(float(val));
+                } else {
+                    writer.append(val);
+                }
+            }
+        }
+        writer.finish();
+    }
+    {
+        beginArray();
+        BlockWriter writer(out, connectSize * sizeof(int64_t), blockSize, compress);
+        for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+            for (long vertexId : cell.getVertexIds()) {
+                writer.append(int64_t(vtkVertexMap.at(vertexId)));
+            }
+        }
+        writer.finish();
+    }
+    {
+        beginArray();
+        BlockWriter writer(out, nCells * sizeof(int64_t), blockSize, compress);
+        int64_t offset = 0;
+        for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+            offset += cell.getVertexCount();
+            writer.append(offset);
+        }
+        writer.finish();
+    }
+    {
+        beginArray();
+        BlockWriter writer(out, nCells * sizeof(uint8_t), blockSize, compress);
+        for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+            writer.append(vtkCellType(cell.getType()));
+        }
+        writer.finish();
+    }
+    if(faceStreamNeeded){
+        {
+            beginArray();
+            BlockWriter writer(out, faceStreamSize * sizeof(int64_t), blockSize, compress);
+            for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+                if (cell.getDimension() <= 2 || cell.hasInfo()) {
+                    writer.append(int64_t(0));
+                } else {
+                    std::vector<long> faceStream = cell.getFaceStream();
+                    bitpit::Cell::renumberFaceStream(vtkVertexMap, &faceStream);
+                    for (long val : faceStream) {
+                        writer.append(int64_t(val));
+                    }
+                }
+            }
+            writer.finish();
+        }
+        {
+            beginArray();
+            BlockWriter writer(out, nCells * sizeof(int64_t), blockSize, compress);
+            int64_t offset = 0;
+            for (const bitpit::Cell & cell : patch.getVTKCellWriteRange()) {
+                offset += (cell.getDimension() <= 2 || cell.hasInfo()) ? 1 : cell.getFaceStreamSize();
+                writer.append(offset);
+            }
+            writer.finish();
+        }
+    }
+
+    out << "\n  </AppendedData>\n";
+    out << "</VTKFile>\n";
+
+    // fill the reserved offsets
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        out.seekp(offsetPositions[i]);
+        out << std::setw(20) << offsets[i];
+    }
+    out.close();
+    if(out.fail()){
+        throw std::runtime_error("VTUStreamWriter : error writing file " + filename);
+    }
+}
+
+/*!
+ * \class VTUStreamReader::ArrayReader
+ * \brief Decoder of an appended raw binary data array, reading it block by block from its own stream.
+ */
+class VTUStreamReader::ArrayReader{
+
+public:
+    /*!
+     * Constructor. It reads the header of the array.
+     * \param[in] filename name of the file
+     * \param[in] begin position of the array in the file
+     * \param[in] type VTK data type of the array
+     * \param[in] headerType VTK data type of the header (UInt32 or UInt64)
+     * \param[in] compressed true if the array is compressed with zlib
+     * \param[in] blockSize size in bytes of the blocks read from uncompressed arrays
+     */
+    ArrayReader(const std::string & filename, std::streamoff begin, const std::string & type,
+                const std::string & headerType, bool compressed, std::size_t blockSize)
+        : m_type(type), m_typeSize(vtkTypeSize(type)), m_compressed(compressed), m_headerType64(headerType == "UInt64"),
+          m_blockSize(blockSize), m_nextBlock(0), m_pos(0), m_end(0)
+    {
+        if(m_typeSize == 0){
+            throw std::runtime_error("VTUStreamReader : unsupported data type " + type);
+        }
+        m_in.open(filename, std::ios::in | std::ios::binary);
+        m_in.seekg(begin);
+        if(m_compressed){
+            uint64_t nBlocks = readHeaderValue();
+            m_blockSize = readHeaderValue();
+            uint64_t lastBlockSize = readHeaderValue();
+            m_compressedSizes.resize(nBlocks);
+            for(uint64_t & size : m_compressedSizes){
+                size = readHeaderValue();
+            }
+            m_remaining = nBlocks * m_blockSize;
+            if(nBlocks > 0 && lastBlockSize != 0) m_remaining -= (m_blockSize - lastBlockSize);
+        }else{
+            m_remaining = readHeaderValue();
+        }
+        if(!m_in.good()){
+            throw std::runtime_error("VTUStreamReader : corrupted header of appended data array");
+        }
+        m_size = m_remaining / m_typeSize;
+        m_buffer.resize(std::size_t(std::min(uint64_t(m_blockSize), m_remaining)) + sizeof(uint64_t));
+    }
+
+    /*!
+     * \return number of values of the array.
+     */
+    uint64_t size() const{
+        return m_size;
+    }
+
+    /*!
+     * \return next value of an integer array.
+     */
+    long nextInteger(){
+        switch(m_typeSize){
+        case 1: return (m_type[0] == 'U') ? long(next<uint8_t>()) : long(next<int8_t>());
+        case 2: return (m_type[0] == 'U') ? long(next<uint16_t>()) : long(next<int16_t>());
+        case 4:
+            if(m_type[0] == 'F') break;
+            return (m_type[0] == 'U') ? long(next<uint32_t>()) : long(next<int32_t>());
+        case 8:
+            if(m_type[0] == 'F') break;
+            return (m_type[0] == 'U') ? long(next<uint64_t>()) : long(next<int64_t>());
+        default:
+            break;
+        }
+        throw std::runtime_error("VTUStreamReader : integer data expected, found " + m_type);
+    }
+
+    /*!
+     * \return next value of a floating point array.
+     */
+    double nextReal(){
+        if(m_type == "Float64") return next<double>();
+        if(m_type == "Float32") return double(next<float>());
+        throw std::runtime_error("VTUStreamReader : floating point data expected, found " + m_type);
+    }
+
+private:
+    std::ifstream           m_in;               /**< input stream */
+    std::string             m_type;             /**< VTK data type */
+    std::size_t             m_typeSize;         /**< size in bytes of a value */
+    bool                    m_compressed;       /**< compression flag */
+    bool                    m_headerType64;     /**< true if the header values are 64 bit */
+    uint64_t                m_blockSize;        /**< size in bytes of the blocks */
+    uint64_t                m_remaining;        /**< bytes of the array not yet loaded */
+    uint64_t                m_size;             /**< number of values of the array */
+    std::vector<uint64_t>   m_compressedSizes;  /**< compressed size of the blocks */
+    std::size_t             m_nextBlock;        /**< next compressed block to be loaded */
+    std::vector<char>       m_buffer;           /**< loaded data */
+    std::vector<char>       m_block;            /**< compressed block */
+    std::size_t             m_pos;              /**< position of the next value in the loaded data */
+    std::size_t             m_end;              /**< end of the loaded data */
+
+    /*!
+     * \return next value of the header of the array.
+     */
+    uint64_t readHeaderValue(){
+        if(m_headerType64){
+            uint64_t value = 0;
+            m_in.read(reinterpret_cast<char *>(&value), sizeof(uint64_t));
+            return value;
+        }
+        uint32_t value = 0;
+        m_in.read(reinterpret_cast<char *>(&value), sizeof(uint32_t));
+        return value;
+    }
+
+    /*!
+     * \return next value of the array, of type T.
+     */
+    template<typename T>
+    T next(){
+        if(m_end - m_pos < sizeof(T)) load();
+        T value;
+        std::memcpy(&value, m_buffer.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+
+    /*!
+     * Load the next block, keeping the bytes not yet used of the current one.
+     */
+    void load(){
+        std::size_t left = m_end - m_pos;
+        if(m_remaining == 0){
+            throw std::runtime_error("VTUStreamReader : unexpected end of appended data array");
+        }
+        std::memmove(m_buffer.data(), m_buffer.data() + m_pos, left);
+        std::size_t size = std::size_t(std::min(m_blockSize, m_remaining));
+        if(m_buffer.size() < left + size) m_buffer.resize(left + size);
+
+        if(m_compressed){
+#if MIMMO_ENABLE_ZLIB
+            m_block.resize(std::size_t(m_compressedSizes[m_nextBlock]));
+            m_in.read(m_block.data(), m_block.size());
+            uLongf uncompressedSize = uLongf(size);
+            if(!m_in.good() || uncompress(reinterpret_cast<Bytef *>(m_buffer.data() + left), &uncompressedSize,
+                                          reinterpret_cast<const Bytef *>(m_block.data()), uLong(m_block.size())) != Z_OK
+                            || uncompressedSize != uLongf(size)){
+                throw std::runtime_error("VTUStreamReader : corrupted compressed block");
+            }
+            ++m_nextBlock;
+#else
+            throw std::runtime_error("VTUStreamReader : compressed data not supported");
+#endif
+        }else{
+            m_in.read(m_buffer.data() + left, size);
+            if(!m_in.good()){
+                throw std::runtime_error("VTUStreamReader : unexpected end of file");
+            }
+        }
+        m_remaining -= size;
+        m_pos = 0;
+        m_end = left + size;
+    }
+};
+
+/*!
+ * Constructor.
+ * \param[in] blockSize size in bytes of the blocks read from uncompressed arrays
+ */
+VTUStreamReader::VTUStreamReader(std::size_t blockSize) : m_blockSize(std::max(std::size_t(8), blockSize)){}
+
+/*!
+ * Read a *.vtu file and add its vertices and cells to a geometry, which should be empty.
+ * \param[in] filename full name of the file, extension included
+ * \param[in] geometry target geometry
+ * \return false if the file does not exist or its format is not supported by the reader; in this
+ * case the geometry is not modified.
+ */
+bool VTUStreamReader::read(const std::string & filename, MimmoObject * geometry){
+
+    std::unordered_map<std::string, ArrayInfo> arrays;
+    std::string headerType, compressor;
+    std::streamoff appendedBegin;
+    {
+        std::ifstream in(filename, std::ios::in | std::ios::binary);
+        if(!in.is_open()) return false;
+        if(!parseHeader(in, arrays, headerType, compressor, appendedBegin)) return false;
+    }
+
+    bool compressed = !compressor.empty();
+#if MIMMO_ENABLE_ZLIB
+    if(compressed && compressor != "vtkZLibDataCompressor") return false;
+#else
+    if(compressed) return false;
+#endif
+    for(const char * name : {"Points", "connectivity", "offsets", "types"}){
+        if(!arrays.count(name)) return false;
+    }
+    if(arrays["Points"].components != 3) return false;
+
+    auto openArray = [&](const std::string & name) -> std::unique_ptr<ArrayReader>{
+        auto it = arrays.find(name);
+        if(it == arrays.end()) return std::unique_ptr<ArrayReader>(nullptr);
+        return std::unique_ptr<ArrayReader>(new ArrayReader(filename, appendedBegin + std::streamoff(it->second.offset),
+                                                            it->second.type, headerType, compressed, m_blockSize));
+    };
+
+    //insert vertices, using their labels if any
+    std::vector<long> vertexIds;
+    {
+        std::unique_ptr<ArrayReader> points = openArray("Points");
+        std::unique_ptr<ArrayReader> vertexIndex = openArray("vertexIndex");
+        std::size_t nVertices = std::size_t(points->size() / 3);
+        if(vertexIndex && vertexIndex->size() != nVertices) vertexIndex.reset();
+
+        geometry->getPatch()->reserveVertices(nVertices);
+        vertexIds.resize(nVertices);
+        darray3E coords;
+        for(long & vertexId : vertexIds){
+            for(double & val : coords){
+                val = points->nextReal();
+            }
+            vertexId = bitpit::Vertex::NULL_ID;
+            if(vertexIndex) vertexId = geometry->addVertex(coords, vertexIndex->nextInteger());
+            if(vertexId == bitpit::Vertex::NULL_ID) vertexId = geometry->addVertex(coords);
+        }
+    }
+
+    //insert cells, reading all the cell arrays side by side
+    std::unique_ptr<ArrayReader> offsets = openArray("offsets");
+    std::unique_ptr<ArrayReader> types = openArray("types");
+    std::unique_ptr<ArrayReader> connectivity = openArray("connectivity");
+    std::unique_ptr<ArrayReader> faces = openArray("faces");
+    std::unique_ptr<ArrayReader> faceoffsets = openArray("faceoffsets");
+    std::unique_ptr<ArrayReader> cellIndex = openArray("cellIndex");
+    std::unique_ptr<ArrayReader> pids = openArray("PID");
+    std::unique_ptr<ArrayReader> cellRank = openArray("cellRank");
+
+    std::size_t nCells = std::size_t(offsets->size());
+    if(types->size() != nCells){
+        throw std::runtime_error("VTUStreamReader : no valid connectivity info detected while reading " + filename);
+    }
+    if(cellIndex && cellIndex->size() != nCells) cellIndex.reset();
+    if(pids && pids->size() != nCells) pids.reset();
+    if(cellRank && cellRank->size() != nCells) cellRank.reset();
+    if(faceoffsets && (faceoffsets->size() != nCells || !faces)) faceoffsets.reset();
+
+    geometry->getPatch()->reserveCells(nCells);
+    livector1D conn;
+    long connBegin = 0, faceBegin = 0;
+    for(std::size_t i = 0; i < nCells; ++i){
+        long connEnd = offsets->nextInteger();
+        bitpit::ElementType type = elementType(types->nextInteger());
+        long faceEnd = faceoffsets ? faceoffsets->nextInteger() : -1;
+        long cellId = cellIndex ? cellIndex->nextInteger() : bitpit::Cell::NULL_ID;
+        long PID = pids ? pids->nextInteger() : 0;
+        int rank = cellRank ? int(cellRank->nextInteger()) : -1;
+
+        if(type == bitpit::ElementType::UNDEFINED){
+            throw std::runtime_error("VTUStreamReader : found unsupported cell elements. Impossible to absorb mesh");
+        }
+        if(connEnd < connBegin || (faceEnd > 0 && faceEnd < faceBegin)){
+            throw std::runtime_error("VTUStreamReader : corrupted cell offsets while reading " + filename);
+        }
+
+        if(type == bitpit::ElementType::POLYHEDRON){
+            if(faceEnd < 0){
+                throw std::runtime_error("VTUStreamReader : trying to acquire POLYHEDRON info without faces and faceoffsets data");
+            }
+            //face stream with local vertex indices, remapped face by face. 0 value contains the number of faces
+            conn.resize(std::size_t(faceEnd - faceBegin));
+            for(long & val : conn){
+                val = faces->nextInteger();
+            }
+            std::size_t posBegin = 1;
+            while(posBegin < conn.size()){
+                std::size_t posEnd = std::min(conn.size(), posBegin + std::size_t(conn[posBegin]) + 1);
+                for(std::size_t k = posBegin + 1; k < posEnd; ++k){
+                    conn[k] = vertexIds.at(conn[k]);
+                }
+                posBegin = posEnd;
+            }
+            for(long k = connBegin; k < connEnd; ++k){
+                connectivity->nextInteger();
+            }
+        }else{
+            std::size_t shift = (type == bitpit::ElementType::POLYGON) ? 1 : 0;
+            conn.resize(std::size_t(connEnd - connBegin) + shift);
+            if(shift) conn[0] = connEnd - connBegin;
+            for(std::size_t k = shift; k < conn.size(); ++k){
+                conn[k] = vertexIds.at(connectivity->nextInteger());
+            }
+            for(long k = faceBegin; k < faceEnd; ++k){
+                faces->nextInteger();
+            }
+        }
+
+        long id = bitpit::Cell::NULL_ID;
+        if(cellId != bitpit::Cell::NULL_ID) id = geometry->addConnectedCell(conn, type, PID, cellId, rank);
+        if(id == bitpit::Cell::NULL_ID) id = geometry->addConnectedCell(conn, type, PID, bitpit::Cell::NULL_ID, rank);
+        if(id == bitpit::Cell::NULL_ID){
+            throw std::runtime_error("VTUStreamReader : cell element not compatible with the target geometry");
+        }
+
+        connBegin = connEnd;
+        if(faceEnd > 0) faceBegin = faceEnd;
+    }
+
+    return true;
+}
+
+/*!
+ * Parse the XML header of a *.vtu file, up to the beginning of the appended data.
+ * \param[in] in input stream, positioned at the beginning of the file
+ * \param[out] arrays description of the appended data arrays, by name
+ * \param[out] headerType VTK data type of the headers of the arrays
+ * \param[out] compressor name of the compressor, empty if the data are not compressed
+ * \param[out] appendedBegin position in the file of the beginning of the appended data
+ * \return false if the file is not a single-piece unstructured grid with raw appended data only.
+ */
+bool VTUStreamReader::parseHeader(std::ifstream & in, std::unordered_map<std::string, ArrayInfo> & arrays,
+                                  std::string & headerType, std::string & compressor, std::streamoff & appendedBegin){
+
+    //load the header; inline arrays are detected as soon as possible, avoiding to load them.
+    std::string header;
+    std::vector<char> chunk(1 << 16);
+    std::size_t appended = std::string::npos;
+    while(appended == std::string::npos){
+        in.read(chunk.data(), chunk.size());
+        std::streamsize nRead = in.gcount();
+        if(nRead <= 0) return false;
+        header.append(chunk.data(), std::size_t(nRead));
+        if(header.find("format=\"ascii\"") != std::string::npos || header.find("format=\"binary\"") != std::string::npos){
+            return false;
+        }
+        std::size_t tagBegin = header.find("<AppendedData");
+        if(tagBegin == std::string::npos) continue;
+        std::size_t tagEnd = header.find('>', tagBegin);
+        if(tagEnd == std::string::npos) continue;
+        std::size_t underscore = header.find('_', tagEnd);
+        if(underscore == std::string::npos) continue;
+        if(xmlAttribute(header.substr(tagBegin, tagEnd - tagBegin), "encoding") != "raw") return false;
+        appended = tagBegin;
+        appendedBegin = std::streamoff(underscore + 1);
+    }
+    header.resize(appended);
+
+    //file attributes
+    std::size_t pos = header.find("<VTKFile");
+    if(pos == std::string::npos) return false;
+    std::string tag = header.substr(pos, header.find('>', pos) - pos);
+    if(xmlAttribute(tag, "type") != "UnstructuredGrid") return false;
+    if(xmlAttribute(tag, "byte_order") != (isLittleEndian() ? "LittleEndian" : "BigEndian")) return false;
+    headerType = xmlAttribute(tag, "header_type");
+    if(headerType.empty()) headerType = "UInt32";
+    if(headerType != "UInt32" && headerType != "UInt64") return false;
+    compressor = xmlAttribute(tag, "compressor");
+
+    //single piece only
+    pos = header.find("<Piece");
+    if(pos == std::string::npos || header.find("<Piece", pos + 1) != std::string::npos) return false;
+
+    //data arrays
+    pos = header.find("<DataArray");
+    while(pos != std::string::npos){
+        tag = header.substr(pos, header.find('>', pos) - pos);
+        if(xmlAttribute(tag, "format") != "appended") return false;
+        ArrayInfo info;
+        info.type = xmlAttribute(tag, "type");
+        std::string components = xmlAttribute(tag, "NumberOfComponents");
+        std::string offset = xmlAttribute(tag, "offset");
+        if(vtkTypeSize(info.type) == 0 || offset.empty()) return false;
+        try{
+            info.components = components.empty() ? 1 : std::stoi(components);
+            info.offset = std::stoull(offset);
+        }catch(...){
+            return false;
+        }
+        arrays[xmlAttribute(tag, "Name")] = info;
+        pos = header.find("<DataArray", pos + 1);
+    }
+    return true;
+}
+
+}
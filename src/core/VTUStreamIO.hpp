@@ -0,0 +1,115 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#ifndef __VTUSTREAMIO_HPP__
+#define __VTUSTREAMIO_HPP__
+
+#include "MimmoObject.hpp"
+#include <fstream>
+
+namespace mimmo{
+
+/*!
+ * \struct VTUStreamOptions
+ * \ingroup core
+ * \brief Settings of the streaming VTU writer VTUStreamWriter.
+ */
+struct VTUStreamOptions{
+    bool        compress;   /**< compress the appended blocks with zlib (effective only if mimmo is built with zlib) */
+    bool        float32;    /**< write point coordinates in single precision */
+    std::size_t blockSize;  /**< size in bytes of the uncompressed blocks of data */
+
+    VTUStreamOptions();
+};
+
+/*!
+ * \class VTUStreamWriter
+ * \ingroup core
+ * \brief Streaming writer of MimmoObject meshes to *.vtu files with appended raw binary data.
+ *
+ * Vertex coordinates, connectivity and mesh labels (vertexIndex, cellIndex, PID and, for MPI
+ * versions, cellGlobalIndex, cellRank and vertexRank) are written as in VTUGridWriterASCII, but
+ * each data array is encoded on the fly in blocks of fixed size, without building any intermediate
+ * copy of the mesh data. Blocks can be compressed with zlib (vtkZLibDataCompressor encoding) if mimmo
+ * is built with zlib support; point coordinates can be stored in single precision.
+ *
+ * The file written is a regular serial *.vtu file, readable by ParaView/VTK and by VTUStreamReader.
+ * Compressed files cannot be read by VTUGridReader.
+ */
+class VTUStreamWriter{
+
+public:
+    VTUStreamWriter(const VTUStreamOptions & options = VTUStreamOptions());
+
+    void write(MimmoObject * geometry, const std::string & filename);
+
+private:
+    class BlockWriter;
+
+    VTUStreamOptions    m_options;  /**< writing settings */
+};
+
+/*!
+ * \class VTUStreamReader
+ * \ingroup core
+ * \brief Streaming reader of *.vtu files with appended raw binary data into MimmoObject meshes.
+ *
+ * Data arrays are decoded in blocks, uncompressed or compressed with zlib (the latter only if mimmo is
+ * built with zlib support), and vertices and cells are inserted directly into the target MimmoObject
+ * while reading, without intermediate copies of the mesh data. Fields vertexIndex, cellIndex, PID and
+ * cellRank (MPI versions) are used, if present, as in VTUGridStreamer; a label already assigned
+ * is replaced by an automatic one.
+ *
+ * Files with ascii/base64 inline data, with multiple pieces, with a byte order different from the
+ * native one or with unsupported compressors are not handled: read returns false without
+ * touching the target geometry, so that the caller can fall back to VTUGridReader.
+ */
+class VTUStreamReader{
+
+public:
+    VTUStreamReader(std::size_t blockSize = std::size_t(1) << 20);
+
+    bool read(const std::string & filename, MimmoObject * geometry);
+
+private:
+    class ArrayReader;
+
+    /*!
+     * Description of an appended data array.
+     */
+    struct ArrayInfo{
+        std::string type;       /**< VTK data type */
+        int         components; /**< number of components */
+        uint64_t    offset;     /**< offset of the array from the beginning of the appended data */
+    };
+
+    std::size_t m_blockSize;    /**< size in bytes of the blocks read from uncompressed arrays */
+
+    bool parseHeader(std::ifstream & in, std::unordered_map<std::string, ArrayInfo> & arrays,
+                     std::string & headerType, std::string & compressor, std::streamoff & appendedBegin);
+};
+
+}
+
+#endif /* __VTUSTREAMIO_HPP__ */
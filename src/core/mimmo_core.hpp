@@ -38,6 +38,7 @@
 #include "BasicMeshes.hpp"
 #include "BasicShapes.hpp"
 #include "Chain.hpp"
+#include "DesignSweep.hpp"
 #include "InOut.hpp"
 #include "IOConnections.hpp"
 #include "Lattice.hpp"
@@ -46,8 +47,10 @@
 #include "MimmoObject.hpp"
 #include "MimmoPiercedVector.hpp"
 #include "SkdTreeUtils.hpp"
+#include "DistanceGrid.hpp"
 #include "VTUGridReader.hpp"
 #include "VTUGridWriterASCII.hpp"
+#include "VTUStreamIO.hpp"
 #include "Module.hpp"
 #include "MimmoSharedPointer.hpp"
 #include "Primitive.hpp"
@@ -399,11 +399,7 @@ FVGenericSelection::checkCoherenceBulkBoundary(){
     bool check = true;
     //analyze vertices
     livector1D boundaryIds = m_bndgeometry->getVerticesIds(true); //only internals nodes.
-    std::unordered_set<long> bulkset;
-    {
-        livector1D bulkIds = m_geometry->extractBoundaryVertexID(false); //only rank internals
-        bulkset.insert(bulkIds.begin(), bulkIds.end());
-    }
+    std::unordered_set<long> bulkset = m_geometry->extractBoundaryVertexSet(false); //only rank internals
     if(!boundaryIds.empty()){
         for(long id: boundaryIds){
             check = check && (bulkset.count(id) > 0);
@@ -24,6 +24,13 @@
 
 #include "IOCGNS.hpp"
 #include <cgnslib.h>
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <unordered_set>
+#if MIMMO_ENABLE_MPI && CG_BUILD_PARALLEL
+#include <pcgnslib.h>
+#endif
 
 namespace mimmo{
 
@@ -85,6 +92,8 @@ IOCGNS::IOCGNS(const IOCGNS & other):BaseManipulation(other){
     m_writeOnFile = other.m_writeOnFile;
     m_wtype = other.m_wtype;
     m_multizone = other.m_multizone;
+    m_parallel = other.m_parallel;
+    m_parallelRead = other.m_parallelRead;
     m_elementsSectionName = other.m_elementsSectionName;
 
     m_storedBC = std::move(std::unique_ptr<BCCGNS>(new BCCGNS(*(other.m_storedBC.get()))));
@@ -115,11 +124,24 @@ void IOCGNS::swap(IOCGNS & x) noexcept
     std::swap(m_writeOnFile, x.m_writeOnFile);
     std::swap(m_wtype, x.m_wtype);
     std::swap(m_multizone, x.m_multizone);
+    std::swap(m_parallel, x.m_parallel);
+    std::swap(m_parallelRead, x.m_parallelRead);
     std::swap(m_elementsSectionName, x.m_elementsSectionName);
 
     BaseManipulation::swap(x);
 }
 
+/*!
+ * Get the cgns file read by the object, if it is in IOCGNS_Mode::READ.
+ * \return path of the input file.
+ */
+std::vector<std::string>
+IOCGNS::getInputFiles(){
+    std::vector<std::string> files;
+    if (m_mode == IOCGNS_Mode::READ) files.push_back(m_dir+"/"+m_filename+".cgns");
+    return files;
+}
+
 /*!
  * Default values for IOCGNS.
  */
@@ -137,6 +159,8 @@ IOCGNS::setDefaults(){
     m_writeOnFile = false;
     m_wtype = IOCGNS_WriteType::ADF;
     m_multizone = false;
+    m_parallel = false;
+    m_parallelRead = false;
 
     m_elementsSectionName[static_cast<int>(CGNS_ENUMV(TETRA_4))] = "Elem_tetra";
     m_elementsSectionName[static_cast<int>(CGNS_ENUMV(PYRA_5))]  = "Elem_pyra";
@@ -278,6 +302,24 @@ bool    IOCGNS::isWritingMultiZone(){
     return m_multizone;
 }
 
+/*!
+  Check if the class is set to write partitioned meshes with parallel cgns or not.
+  The method is meaningful only in class mode IOCGNS_Mode::WRITE.
+  \return boolean true-writing in parallel, false-writing on rank 0 only.
+ */
+bool    IOCGNS::isWritingParallel(){
+    return m_parallel;
+}
+
+/*!
+  Check if the class is set to read partitioned meshes with all the ranks or not.
+  The method is meaningful only in class mode IOCGNS_Mode::READ.
+  \return boolean true-reading in parallel, false-reading on rank 0 only.
+ */
+bool    IOCGNS::isReadingParallel(){
+    return m_parallelRead;
+}
+
 
 /*!It sets the  working directory path for IO operation.
    File to be read or file to be written will be located here.
@@ -394,6 +436,35 @@ void    IOCGNS::setWritingMultiZone(bool multizone){
     m_multizone = false;
 }
 
+/*!
+    Set the class to write a partitioned mesh with parallel cgns: each rank writes
+    its interior vertices and cells directly on the file through collective HDF5 access,
+    so that the mesh is never gathered on rank 0. The option is meaningful only in
+    class mode IOCGNS_Mode::WRITE, for a distributed geometry, in MPI builds linked to a
+    cgns library with parallel support; otherwise the mesh is written on rank 0 only.
+    The file is always written in HDF5 format.
+    \param[in] parallel true write in parallel, false write on rank 0 only.
+*/
+void    IOCGNS::setWritingParallel(bool parallel){
+    m_parallel = parallel;
+}
+
+/*!
+    Set the class to read a partitioned mesh with all the ranks: each rank reads a contiguous
+    range of the volume elements of the file and the coordinates of their vertices, then
+    the cells sharing vertices with other ranks are exchanged as ghosts. Boundary surface
+    cells are the border faces of the local volume cells belonging to a boundary condition.
+    The option is meaningful only in class mode IOCGNS_Mode::READ, in MPI builds, for
+    single zone files with homogeneous sections (no MIXED or polyhedral sections);
+    otherwise the mesh is read by rank 0 only.
+    Vertex and volume cell ids are the same of the rank 0 read, while surface cells are
+    labeled with the id of their volume cell and face as 6*cellId + face.
+    \param[in] parallel true read in parallel, false read on rank 0 only.
+*/
+void    IOCGNS::setReadingParallel(bool parallel){
+    m_parallelRead = parallel;
+}
+
 /*!
  * Set geometric tolerance used to perform geometric operations on the mimmo object.
  * param[in] tol input geometric tolerance
@@ -531,6 +602,17 @@ void IOCGNS::writeInfoFile(){
 bool
 IOCGNS::read(const std::string & file){
 
+#if MIMMO_ENABLE_MPI
+    if(m_parallelRead && m_nprocs > 1){
+        bool supported = true;
+        bool check = readParallel(file, supported);
+        if(supported){
+            return check;
+        }
+        (*m_log) << m_name << " : parallel read not supported for " << file << ", the mesh is read by rank 0" << std::endl;
+    }
+#endif
+
     m_volmesh = MimmoSharedPointer<MimmoObject>(new MimmoObject(2));
     m_surfmesh = MimmoSharedPointer<MimmoObject>(new MimmoObject(1));
     MimmoSharedPointer<MimmoObject> patchVol(new MimmoObject(2));
@@ -1061,6 +1143,7 @@ IOCGNS::read(const std::string & file){
 
     //Squeeze the mother volume
     m_volmesh->getPatch()->squeeze();
+    m_volmesh->setUnsyncAll();
 
     //now create the surface mesh, using the mapCellFacePid information.
     long totSV, totSC(0);
@@ -1162,6 +1245,12 @@ IOCGNS::read(const std::string & file){
 bool
 IOCGNS::write(const std::string & file){
 
+#if MIMMO_ENABLE_MPI && CG_BUILD_PARALLEL
+if(m_parallel && !m_multizone && getGeometry() != nullptr && getGeometry()->isDistributed()){
+    return writeParallel(file);
+}
+#endif
+
 switch(m_wtype){
     case IOCGNS_WriteType::HDF5:
         cg_set_file_type(CG_FILE_HDF5);
@@ -1220,7 +1309,7 @@ if(m_multizone){
     std::string zonename = "Zone0001";
 
     livector1D cellIds, vertIds;
-    std::unordered_map<long, int> globToLoc;
+    std::unordered_map<long, long> globToLoc;
     std::map<long, std::vector<cgsize_t>> bndPools;
 
     int zoneindex=1;
@@ -1230,7 +1319,7 @@ if(m_multizone){
 
 
     // fill the inverse point map. Start from 1 because CGNS is a fortran buddy
-    int countvert = 1;
+    long countvert = 1;
     for(long idV : vertIds){
         globToLoc[idV] = countvert;
         ++countvert;
@@ -1311,7 +1400,7 @@ if(m_multizone){
         }
     }
     std::map<int, std::size_t> bndcgns_ncells;
-    std::unordered_map<long, int> surfCellGlobToLoc;
+    std::unordered_map<long, long> surfCellGlobToLoc;
     std::map<int, std::vector<std::size_t> > bndcgns = getBCElementsConn(bndCellIds, globToLoc, bndcgns_ncells, surfCellGlobToLoc);
 
     /* Write volume elements */
@@ -1401,7 +1490,7 @@ if(m_multizone){
             ptset_type = CGNS_ENUMV(ElementList);
             //remap the ids of elements into the pool.
             for(cgsize_t & idSC : pool.second){
-                idSC = surfCellGlobToLoc[idSC] + int(startSurfElementsOffset);
+                idSC = cgsize_t(surfCellGlobToLoc[idSC]) + startSurfElementsOffset;
             }
         }
         cgsize_t nelems = pool.second.size();
@@ -1428,6 +1517,895 @@ if(m_multizone){
     return true;
 }
 
+#if MIMMO_ENABLE_MPI
+#if CG_BUILD_PARALLEL
+/*!
+    Gather on all ranks the lists of indices filled by each rank, in rank order.
+    \param[in,out] list local list in input, gathered list in output.
+    \param[in] comm MPI communicator
+*/
+static void allGatherCGNSList(std::vector<cgsize_t> & list, MPI_Comm comm){
+    int nprocs;
+    MPI_Comm_size(comm, &nprocs);
+    MPI_Datatype type = (sizeof(cgsize_t) == sizeof(long long)) ? MPI_LONG_LONG : MPI_INT;
+
+    int size = list.size();
+    std::vector<int> sizes(nprocs), displs(nprocs, 0);
+    MPI_Allgather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, comm);
+    for(int i = 1; i < nprocs; ++i){
+        displs[i] = displs[i-1] + sizes[i-1];
+    }
+    std::vector<cgsize_t> gathered(displs[nprocs-1] + sizes[nprocs-1]);
+    MPI_Allgatherv(list.data(), size, type, gathered.data(), sizes.data(), displs.data(), type, comm);
+    std::swap(list, gathered);
+}
+#endif
+
+/*!It writes a partitioned mesh geometry on output .cgns file with parallel cgns.
+   Each rank writes the coordinates of its interior vertices and the connectivity of its
+   interior cells in its own range of the cgns arrays, numbered with the global consecutive
+   vertex indexing of the volume mesh. Volume and boundary elements are grouped in one
+   section for each element type, as in serial writing. Only the boundary condition lists,
+   sized as the boundary surface, are gathered on all ranks, since cgns metadata are
+   written collectively.
+   The boundary surface has to be partitioned coherently with the volume mesh, i.e. each
+   boundary cell has to refer to vertices of the volume partition of the same rank.
+  \param[in] file abs path file to write mesh.
+  \return False if valid volume geometry or surface geometry is not found.
+ */
+bool
+IOCGNS::writeParallel(const std::string & file){
+
+#if CG_BUILD_PARALLEL
+    MimmoSharedPointer<MimmoObject> vol = getGeometry();
+    MimmoSharedPointer<MimmoObject> bnd = getSurfaceBoundary();
+
+    if( vol == nullptr || bnd == nullptr ) return false;
+
+    //just in case resynchronize the internal pids - to be sure
+    vol->resyncPID();
+    bnd->resyncPID();
+
+    // global consecutive indexing of the volume vertices, ghosts included.
+    if(vol->getPointGhostExchangeInfoSyncStatus() != SyncStatus::SYNC){
+        vol->updatePointGhostExchangeInfo();
+    }
+    lilimap consecutiveIds = vol->getMapDataInv(true);
+    long nInteriorVertices = vol->getNInternalVertices();
+    long vertexOffset = vol->getPointGlobalCountOffset();
+
+    // fill the inverse point map. Start from 1 because CGNS is a fortran buddy
+    std::unordered_map<long, long> globToLoc;
+    globToLoc.reserve(consecutiveIds.size());
+    for(const auto & entry : consecutiveIds){
+        globToLoc[entry.first] = entry.second + 1;
+    }
+    consecutiveIds.clear();
+
+    // interior cells of volume and boundary
+    livector1D cellIds;
+    cellIds.reserve(vol->getNCells());
+    for(const bitpit::Cell & cell : vol->getCells()){
+        if(cell.isInterior()) cellIds.push_back(cell.getId());
+    }
+
+    std::map<long, std::vector<cgsize_t>> bndPools;
+    livector1D bndCellIds;
+    for(const bitpit::Cell & cell : bnd->getCells()){
+        if(!cell.isInterior()) continue;
+        long pid = cell.getPID();
+        if(m_storedBC->mcg_pidtobc.count(pid) < 1) continue;
+        if(m_storedBC->mcg_pidtolisttype[pid] > 0){
+            bndCellIds.push_back(cell.getId());
+        }else{
+            std::vector<cgsize_t> & pool = bndPools[pid];
+            for(long idV : cell.getVertexIds()){
+                pool.push_back(globToLoc.at(idV));
+            }
+        }
+    }
+
+    std::map<int, std::size_t> mmcgns_ncells;
+    std::map<int, std::vector<std::size_t> > mmcgns = getZoneConn(cellIds, globToLoc, mmcgns_ncells);
+    std::map<int, std::size_t> bndcgns_ncells;
+    std::unordered_map<long, long> surfCellGlobToLoc;
+    std::map<int, std::vector<std::size_t> > bndcgns = getBCElementsConn(bndCellIds, globToLoc, bndcgns_ncells, surfCellGlobToLoc);
+
+    // global number of elements for each type and offset of the rank range.
+    std::vector<int> types = {CGNS_ENUMV(TETRA_4), CGNS_ENUMV(PYRA_5), CGNS_ENUMV(PENTA_6), CGNS_ENUMV(HEXA_8),
+                              CGNS_ENUMV(TRI_3), CGNS_ENUMV(QUAD_4)};
+    std::size_t nVolumeTypes = 4;
+    std::vector<long> localCounts(types.size(), 0), globalCounts(types.size(), 0), rankOffsets(types.size(), 0);
+    for(std::size_t i = 0; i < types.size(); ++i){
+        std::map<int, std::size_t> & ncells = (i < nVolumeTypes) ? mmcgns_ncells : bndcgns_ncells;
+        if(ncells.count(types[i]) > 0) localCounts[i] = long(ncells[types[i]]);
+    }
+    MPI_Allreduce(localCounts.data(), globalCounts.data(), int(types.size()), MPI_LONG, MPI_SUM, m_communicator);
+    MPI_Exscan(localCounts.data(), rankOffsets.data(), int(types.size()), MPI_LONG, MPI_SUM, m_communicator);
+    if(m_rank == 0){
+        std::fill(rankOffsets.begin(), rankOffsets.end(), 0);
+    }
+
+    //Open index and Write Unique Base Info
+    int indexfile;
+    cgp_mpi_comm(m_communicator);
+    if(cgp_open(file.c_str(), CG_MODE_WRITE, &indexfile) != CG_OK){
+        (*m_log) << "error: cgns error during write: opening file " << file << std::endl;
+        throw std::runtime_error ("cgns error during write " + file);
+    }
+
+    int baseindex = 1;
+    char basename[33] = "Base0001";
+    int physdim=3, celldim=3;
+    if(cg_base_write(indexfile,basename, celldim, physdim, &baseindex) != CG_OK){
+        (*m_log) << "error: cgns error during write : base  " << file << std::endl;
+        throw std::runtime_error ("cgns error during write " + file);
+    }
+
+    std::string zonename = "Zone0001";
+    int zoneindex=1;
+    CGNS_ENUMT(ZoneType_t) zoneType =CGNS_ENUMT(ZoneType_t)::CGNS_ENUMV(Unstructured) ;
+    std::vector<cgsize_t> sizeG(3);
+    sizeG[0] = vol->getNGlobalVertices();
+    sizeG[1] = std::accumulate(globalCounts.begin(), globalCounts.begin() + nVolumeTypes, long(0));
+    sizeG[2] = 0; //unsorted elements.
+
+    if(cg_zone_write(indexfile,baseindex, zonename.data(), sizeG.data(), zoneType, &zoneindex) != CG_OK ){
+        (*m_log) << "error: cgns error during write: zone " << file << std::endl;
+        throw std::runtime_error ("cgns error during write " + file);
+    }
+
+    //writing vertices. Ranks without interior vertices take part to the collective
+    //call with a null buffer.
+    svector1D names(3, "CoordinateX");
+    names[1] = "CoordinateY";
+    names[2] = "CoordinateZ";
+
+    CGNS_ENUMT(DataType_t) datatype= CGNS_ENUMV(RealDouble);
+    {
+        std::array<std::vector<double>,3 > coords;
+        for(int i=0; i<3; ++i){
+            coords[i].resize(nInteriorVertices);
+        }
+        for(const bitpit::Vertex & vertex : vol->getVertices()){
+            long idV = vertex.getId();
+            if(!vol->isPointInterior(idV)) continue;
+            long pos = globToLoc.at(idV) - 1 - vertexOffset;
+            const std::array<double,3> & temp = vertex.getCoords();
+            coords[0][pos] = temp[0];
+            coords[1][pos] = temp[1];
+            coords[2][pos] = temp[2];
+        }
+
+        cgsize_t rmin = vertexOffset + 1;
+        cgsize_t rmax = vertexOffset + nInteriorVertices;
+        if(nInteriorVertices == 0){
+            rmin = rmax = 1;
+        }
+        for(int i=1; i<=3; ++i){
+            int index;
+            if(cgp_coord_write(indexfile,baseindex,zoneindex, datatype, names[i-1].data(), &index) != CG_OK ||
+               cgp_coord_write_data(indexfile,baseindex,zoneindex, index, &rmin, &rmax,
+                                    nInteriorVertices > 0 ? coords[i-1].data() : nullptr) != CG_OK)
+            {
+                (*m_log) << "error: cgns error during write: node coordinates " << file << std::endl;
+                throw std::runtime_error ("cgns error during write " + file);
+            }
+        }
+    }//end scope vertices
+
+    /* Write volume and surface elements */
+    int sec;
+    cgsize_t eBeg = 1, eEnd;
+    std::string sectionname;
+    std::vector<cgsize_t> cgtemp;
+    std::map<int, cgsize_t> surfElementsOffset;
+
+    for(std::size_t i = 0; i < types.size(); ++i){
+
+        if(globalCounts[i] == 0) continue;
+
+        int type = types[i];
+        eEnd = eBeg + globalCounts[i] - 1;
+
+        sectionname = "UndefElements";
+        if(m_elementsSectionName.count(type) > 0){
+            sectionname = m_elementsSectionName[type];
+        }
+
+        if(cgp_section_write(indexfile,baseindex,zoneindex,sectionname.data(), static_cast<CGNS_ENUMT(ElementType_t)>(type),
+                             eBeg,eEnd,0, &sec) !=CG_OK )
+        {
+            cg_error_print();
+            (*m_log) << "error: cgns error during write: section " << file << std::endl;
+            throw std::runtime_error ("cgns error during write " + file);
+        }
+
+        std::map<int, std::vector<std::size_t> > & conns = (i < nVolumeTypes) ? mmcgns : bndcgns;
+        cgtemp.clear();
+        if(conns.count(type) > 0){
+            cgtemp.assign(conns[type].begin(), conns[type].end());
+            conns[type].clear();
+        }
+
+        // rank range of the section; ranks without elements of this type
+        // take part to the collective call with a null buffer.
+        cgsize_t rankBeg = eBeg + rankOffsets[i];
+        cgsize_t rankEnd = rankBeg + localCounts[i] - 1;
+        if(localCounts[i] == 0){
+            rankBeg = rankEnd = eBeg;
+        }
+        if(cgp_elements_write_data(indexfile,baseindex,zoneindex,sec, rankBeg, rankEnd,
+                                   localCounts[i] > 0 ? cgtemp.data() : nullptr) !=CG_OK )
+        {
+            cg_error_print();
+            (*m_log) << "error: cgns error during write: section " << file << std::endl;
+            throw std::runtime_error ("cgns error during write " + file);
+        }
+
+        if(i >= nVolumeTypes){
+            surfElementsOffset[type] = rankBeg;
+        }
+        eBeg = eEnd+1;
+    }
+
+    mmcgns.clear();
+    bndcgns.clear();
+
+    // remap the boundary elements into their global element index: surfCellGlobToLoc
+    // numbers them consecutively, element types in ascending order.
+    {
+        std::map<int, cgsize_t> typeStart;
+        cgsize_t counter = 0;
+        for(auto & mapp : bndcgns_ncells){
+            typeStart[mapp.first] = counter;
+            counter += cgsize_t(mapp.second);
+        }
+        for(long idC : bndCellIds){
+            const bitpit::Cell & cell = bnd->getCells().at(idC);
+            int type = (cell.getType() == bitpit::ElementType::TRIANGLE) ? int(CGNS_ENUMV(TRI_3)) : int(CGNS_ENUMV(QUAD_4));
+            bndPools[cell.getPID()].push_back(surfElementsOffset[type] + surfCellGlobToLoc.at(idC) - typeStart[type]);
+        }
+    }
+
+    /* Write boundary conditions. Each pool is gathered on all ranks, since
+     * cgns metadata are written collectively.
+     */
+    int bcid;
+    for(auto & val : m_storedBC->mcg_pidtobc){
+
+        int pid = val.first;
+        std::vector<cgsize_t> & pool = bndPools[pid];
+        allGatherCGNSList(pool, m_communicator);
+        std::sort(pool.begin(), pool.end());
+        pool.erase(std::unique(pool.begin(), pool.end()), pool.end());
+        if(pool.empty()) continue;
+
+        CGNS_ENUMT(BCType_t) bocotype = static_cast<CGNS_ENUMT(BCType_t)>(val.second);
+        std::string bcname = "Undefined_BC_"+ std::to_string(pid);
+        if(m_storedBC->mcg_bcpidnames.count(pid) > 0) bcname = m_storedBC->mcg_bcpidnames[pid];
+        CGNS_ENUMT(PointSetType_t) ptset_type = CGNS_ENUMV(PointList);
+        if(m_storedBC->mcg_pidtolisttype[pid] > 0){
+            ptset_type = CGNS_ENUMV(ElementList);
+        }
+        cgsize_t nelems = pool.size();
+
+        if(cg_boco_write(indexfile, baseindex, zoneindex, bcname.data(),
+                bocotype, ptset_type, nelems, pool.data(), &bcid )!= CG_OK)
+        {
+            (*m_log) << "error: cgns error during write: bc " << file << std::endl;
+            throw std::runtime_error ("cgns error during write " + file);
+        }
+        pool.clear();
+    }
+
+    /* Finish writing CGNS file */
+    cgp_close(indexfile);
+
+    return true;
+#else
+    (*m_log) << "error: parallel writing of " << file << " requires a cgns library built with parallel support" << std::endl;
+    return false;
+#endif
+}
+
+/*!
+    Map a homogeneous cgns element type on the bitpit element type read by IOCGNS,
+    high order elements are read as their linear counterparts.
+    \param[in] type cgns element type
+    \param[out] nVertices number of vertices of the bitpit element
+    \return bitpit element type, UNDEFINED if the cgns type is not supported.
+*/
+static bitpit::ElementType getBitpitElementType(CGNS_ENUMT(ElementType_t) type, int & nVertices){
+
+    switch(type){
+    case CGNS_ENUMV(TETRA_4):
+    case CGNS_ENUMV(TETRA_10):
+    case CGNS_ENUMV(TETRA_16):
+    case CGNS_ENUMV(TETRA_20):
+    case CGNS_ENUMV(TETRA_22):
+    case CGNS_ENUMV(TETRA_34):
+    case CGNS_ENUMV(TETRA_35):
+        nVertices = 4;
+        return bitpit::ElementType::TETRA;
+    case CGNS_ENUMV(PYRA_5):
+    case CGNS_ENUMV(PYRA_13):
+    case CGNS_ENUMV(PYRA_14):
+    case CGNS_ENUMV(PYRA_21):
+    case CGNS_ENUMV(PYRA_29):
+    case CGNS_ENUMV(PYRA_30):
+    case CGNS_ENUMV(PYRA_50):
+    case CGNS_ENUMV(PYRA_55):
+        nVertices = 5;
+        return bitpit::ElementType::PYRAMID;
+    case CGNS_ENUMV(PENTA_6):
+    case CGNS_ENUMV(PENTA_15):
+    case CGNS_ENUMV(PENTA_18):
+    case CGNS_ENUMV(PENTA_24):
+    case CGNS_ENUMV(PENTA_38):
+    case CGNS_ENUMV(PENTA_40):
+    case CGNS_ENUMV(PENTA_33):
+    case CGNS_ENUMV(PENTA_66):
+    case CGNS_ENUMV(PENTA_75):
+        nVertices = 6;
+        return bitpit::ElementType::WEDGE;
+    case CGNS_ENUMV(HEXA_8):
+    case CGNS_ENUMV(HEXA_20):
+    case CGNS_ENUMV(HEXA_27):
+    case CGNS_ENUMV(HEXA_32):
+    case CGNS_ENUMV(HEXA_56):
+    case CGNS_ENUMV(HEXA_64):
+    case CGNS_ENUMV(HEXA_44):
+    case CGNS_ENUMV(HEXA_98):
+    case CGNS_ENUMV(HEXA_125):
+        nVertices = 8;
+        return bitpit::ElementType::HEXAHEDRON;
+    case CGNS_ENUMV(TRI_3):
+    case CGNS_ENUMV(TRI_6):
+    case CGNS_ENUMV(TRI_9):
+    case CGNS_ENUMV(TRI_10):
+    case CGNS_ENUMV(TRI_12):
+    case CGNS_ENUMV(TRI_15):
+        nVertices = 3;
+        return bitpit::ElementType::TRIANGLE;
+    case CGNS_ENUMV(QUAD_4):
+    case CGNS_ENUMV(QUAD_8):
+    case CGNS_ENUMV(QUAD_9):
+    case CGNS_ENUMV(QUAD_12):
+    case CGNS_ENUMV(QUAD_16):
+    case CGNS_ENUMV(QUAD_25):
+        nVertices = 4;
+        return bitpit::ElementType::QUAD;
+    default:
+        nVertices = 0;
+        return bitpit::ElementType::UNDEFINED;
+    }
+}
+
+/*!It reads the mesh geometry from an input file with all the ranks, see setReadingParallel.
+   Each rank reads a contiguous range of the volume elements and the coordinates of a
+   contiguous range of vertices, then requests the vertices of its elements to the ranks
+   owning their ranges. Cells sharing vertices with other ranks are exchanged as ghosts.
+   Boundary condition lists and surface sections, sized as the boundary surface, are read
+   by all the ranks. Collective on the communicator.
+   \param[in] file abs path to read cgns.
+   \param[out] supported false if the file has multiple zones or sections not supported by
+   the parallel read, true otherwise.
+   \return False if problems occur during reading stage.
+ */
+bool
+IOCGNS::readParallel(const std::string & file, bool & supported){
+
+    m_volmesh = MimmoSharedPointer<MimmoObject>(new MimmoObject(2));
+    m_surfmesh = MimmoSharedPointer<MimmoObject>(new MimmoObject(1));
+    m_storedBC = std::unique_ptr<BCCGNS>(new BCCGNS());
+
+    supported = true;
+
+    std::string zonename;
+    long nVertices = 0;
+    long vertexBegin = 0;
+    std::array<std::vector<double>, 3> coords; //coordinates of the vertex range of the rank
+    livector1D localIds;
+    std::vector<bitpit::ElementType> localTypes;
+    livector2D localConns;
+    std::vector<std::string> bcNames;
+    std::vector<CGNS_ENUMT(BCType_t)> bcTypes;
+    std::vector<bool> bcOnElements;
+    livector2D bcLists;
+    std::unordered_map<long, livector1D> surfElements; //surface elements referenced by element lists
+
+    //FIRST STEP ABSORB LOCAL INFO from FILE//
+    int indexfile;
+    auto readLocal = [&]() -> bool {
+
+        //Read name of basis and physical dimension
+        char basename[33];
+        int physdim, celldim;
+        if(cg_base_read(indexfile, 1, basename, &celldim, &physdim) != CG_OK){
+            return false;
+        }
+        if(celldim != 3 || physdim !=3){
+            //Only volume mesh supported
+            return false;
+        }
+
+        int nzones;
+        if(cg_nzones(indexfile, 1, &nzones)!=CG_OK){
+            return false;
+        }
+        if(nzones != 1){
+            supported = false;
+            return false;
+        }
+
+        CGNS_ENUMT(ZoneType_t) zoneType;
+        int index_dim;
+        if(cg_zone_type(indexfile, 1, 1, &zoneType) != CG_OK || cg_index_dim(indexfile, 1, 1, &index_dim) != CG_OK){
+            return false;
+        }
+        if(zoneType != CGNS_ENUMT(ZoneType_t)::CGNS_ENUMV(Unstructured) || index_dim != 1){
+            return false;
+        }
+        char fzz[33];
+        cgsize_t sizeG[3];
+        if(cg_zone_read(indexfile, 1, 1, fzz, sizeG) != CG_OK ){
+            return false;
+        }
+        zonename = std::string(fzz);
+        nVertices = long(sizeG[0]);
+
+        //Read sections info, volume elements are split in contiguous ranges among the ranks.
+        int nSections;
+        if(cg_nsections(indexfile, 1, 1, &nSections)!= CG_OK){
+            return false;
+        }
+        std::vector<CGNS_ENUMT(ElementType_t)> sectionTypes(nSections);
+        std::vector<cgsize_t> sectionBegin(nSections), sectionEnd(nSections);
+        long nVolumeElements = 0;
+        for(int sec = 0; sec < nSections; ++sec){
+            char elementname[33];
+            int enBdry, parent_flag, nv;
+            if(cg_section_read(indexfile, 1, 1, sec+1, elementname, &sectionTypes[sec], &sectionBegin[sec], &sectionEnd[sec], &enBdry, &parent_flag)!= CG_OK){
+                return false;
+            }
+            bitpit::ElementType btype = getBitpitElementType(sectionTypes[sec], nv);
+            if(btype == bitpit::ElementType::UNDEFINED){
+                supported = false;
+                return false;
+            }
+            if(btype != bitpit::ElementType::TRIANGLE && btype != bitpit::ElementType::QUAD){
+                nVolumeElements += long(sectionEnd[sec] - sectionBegin[sec] + 1);
+            }
+        }
+
+        long elementBegin = nVolumeElements * m_rank / m_nprocs;
+        long elementEnd = nVolumeElements * (m_rank + 1) / m_nprocs;
+        long elementOffset = 0;
+        for(int sec = 0; sec < nSections; ++sec){
+            int nv;
+            bitpit::ElementType btype = getBitpitElementType(sectionTypes[sec], nv);
+            if(btype == bitpit::ElementType::TRIANGLE || btype == bitpit::ElementType::QUAD) continue;
+
+            long size = long(sectionEnd[sec] - sectionBegin[sec] + 1);
+            long first = std::max(elementBegin, elementOffset);
+            long last = std::min(elementEnd, elementOffset + size);
+            cgsize_t start = sectionBegin[sec] + cgsize_t(first - elementOffset);
+            elementOffset += size;
+            if(first >= last) continue;
+
+            int npe;
+            if(cg_npe(sectionTypes[sec], &npe) != CG_OK){
+                return false;
+            }
+            std::vector<cgsize_t> connlocal(std::size_t((last - first) * npe));
+            if(cg_elements_partial_read(indexfile, 1, 1, sec+1, start, start + cgsize_t(last - first) - 1, connlocal.data(), nullptr) != CG_OK){
+                return false;
+            }
+            livector1D lConn(nv);
+            for(long i = 0; i < last - first; ++i){
+                for(int j = 0; j < nv; ++j){
+                    lConn[j] = long(connlocal[i*npe + j]) - 1; //from fortran to c indexing.
+                }
+                if(btype == bitpit::ElementType::WEDGE){
+                    //remap in bitpit conn.
+                    std::swap(lConn[1], lConn[2]);
+                    std::swap(lConn[4], lConn[5]);
+                }
+                localIds.push_back(long(start) - 1 + i);
+                localTypes.push_back(btype);
+                localConns.push_back(lConn);
+            }
+        }
+
+        //Read the coordinates of the vertex range of the rank.
+        int nCoords;
+        if(cg_ncoords(indexfile, 1, 1, &nCoords)!= CG_OK || nCoords != 3){
+            return false;
+        }
+        vertexBegin = nVertices * m_rank / m_nprocs;
+        long vertexEnd = nVertices * (m_rank + 1) / m_nprocs;
+        if(vertexEnd > vertexBegin){
+            cgsize_t startIndex = cgsize_t(vertexBegin + 1);
+            cgsize_t finishIndex = cgsize_t(vertexEnd);
+            for(int i = 0; i < 3; ++i){
+                CGNS_ENUMT(DataType_t) datatype;
+                char name[33];
+                coords[i].resize(std::size_t(vertexEnd - vertexBegin));
+                if(cg_coord_info(indexfile, 1, 1, i+1, &datatype, name)!=CG_OK){
+                    return false;
+                }
+                if(cg_coord_read(indexfile, 1, 1, name, CGNS_ENUMV(RealDouble), &startIndex, &finishIndex, coords[i].data())!=CG_OK){
+                    return false;
+                }
+            }
+        }
+
+        //Read boundary conditions lists on all the ranks.
+        int nBcs;
+        if(cg_nbocos(indexfile, 1, 1, &nBcs)!= CG_OK){
+            return false;
+        }
+        bcNames.resize(nBcs);
+        bcTypes.resize(nBcs);
+        bcOnElements.resize(nBcs);
+        bcLists.resize(nBcs);
+        bool anyOnElements = false;
+        for(int indexbc = 0; indexbc < nBcs; ++indexbc){
+
+            char name[33];
+            CGNS_ENUMT(BCType_t) bocotype;
+            CGNS_ENUMT(PointSetType_t) ptset_type;
+            std::vector<cgsize_t> nBCElements(2);
+            int normalIndex;
+            cgsize_t normalListSize;
+            CGNS_ENUMT(DataType_t) normalDataType;
+            int ndataset;
+            if(cg_boco_info(indexfile, 1, 1, indexbc+1, name, &bocotype, &ptset_type, nBCElements.data(),
+                    &normalIndex, &normalListSize, &normalDataType, &ndataset) != CG_OK){
+                return false;
+            }
+            GridLocation_t bclocation;
+            if(cg_boco_gridlocation_read(indexfile, 1, 1, indexbc+1, &bclocation) != CG_OK){
+                return false;
+            }
+            bcNames[indexbc] = std::string(name);
+            bcTypes[indexbc] = bocotype;
+
+            std::vector<cgsize_t> localbclist;
+            switch(ptset_type){
+                case CGNS_ENUMV(PointList):
+                case CGNS_ENUMV(ElementList):
+                    localbclist.resize((size_t) nBCElements[0]);
+                    if(cg_boco_read(indexfile, 1, 1, indexbc+1, localbclist.data(), nullptr )!= CG_OK){
+                        return false;
+                    }
+                break;
+                case CGNS_ENUMV(PointRange):
+                case CGNS_ENUMV(ElementRange):
+                    for (cgsize_t idx = nBCElements[0]; idx <= nBCElements[1]; idx++){
+                        localbclist.push_back(idx);
+                    }
+                break;
+                default:
+                    (*m_log)<<"IOCGNS reader cannot support BC PointSetType_t different from PointList, PointRange, ElementList and ElementRange.Aborting"<<std::endl;
+                    return false;
+            }
+
+            bool flag = ( ptset_type == CGNS_ENUMV(ElementList) );
+            flag = flag ||  (ptset_type == CGNS_ENUMV(ElementRange) );
+            flag = flag ||  ( (ptset_type == CGNS_ENUMV(PointList) || ptset_type == CGNS_ENUMV(PointRange) )
+                               && bclocation == CGNS_ENUMV(FaceCenter) ) ;
+            bcOnElements[indexbc] = flag;
+            anyOnElements = anyOnElements || flag;
+            bcLists[indexbc].reserve(localbclist.size());
+            for(cgsize_t val : localbclist){
+                bcLists[indexbc].push_back(long(val) - 1); //from fortran to c style
+            }
+        }
+
+        //Read the surface sections referenced by element lists on all the ranks.
+        for(int sec = 0; anyOnElements && sec < nSections; ++sec){
+            int nv;
+            bitpit::ElementType btype = getBitpitElementType(sectionTypes[sec], nv);
+            if(btype != bitpit::ElementType::TRIANGLE && btype != bitpit::ElementType::QUAD) continue;
+
+            int npe;
+            if(cg_npe(sectionTypes[sec], &npe) != CG_OK){
+                return false;
+            }
+            std::vector<cgsize_t> connlocal(std::size_t((sectionEnd[sec] - sectionBegin[sec] + 1) * npe));
+            if(cg_elements_read(indexfile, 1, 1, sec+1, connlocal.data(), nullptr) != CG_OK){
+                return false;
+            }
+            for(cgsize_t i = 0; i < sectionEnd[sec] - sectionBegin[sec] + 1; ++i){
+                livector1D & lConn = surfElements[long(sectionBegin[sec] + i) - 1];
+                lConn.resize(nv);
+                for(int j = 0; j < nv; ++j){
+                    lConn[j] = long(connlocal[i*npe + j]) - 1;
+                }
+            }
+        }
+
+        return true;
+    };
+
+    bool good = (cg_open(file.c_str(), CG_MODE_READ, &indexfile) == CG_OK);
+    if(good){
+        good = readLocal();
+        //Finish reading CGNS file
+        cg_close(indexfile);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &supported, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
+    MPI_Allreduce(MPI_IN_PLACE, &good, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
+    if(!good || !supported){
+        return false;
+    }
+
+    //Request the vertices of the local cells to the ranks owning their ranges.
+    auto owner = [&](long id){
+        int rank = int(id * m_nprocs / nVertices);
+        while(rank + 1 < m_nprocs && nVertices * (rank + 1) / m_nprocs <= id) ++rank;
+        return rank;
+    };
+
+    std::unordered_set<long> referenced;
+    for(const livector1D & conn : localConns){
+        referenced.insert(conn.begin(), conn.end());
+    }
+    std::vector<std::vector<long>> requests(m_nprocs);
+    for(long id : referenced){
+        requests[owner(id)].push_back(id);
+    }
+    std::vector<std::vector<long>> recvRequests = exchangeRecords(requests);
+
+    std::unordered_map<long, std::vector<int>> referencingRanks;
+    std::vector<std::vector<VertexRecord>> replies(m_nprocs);
+    for(int rank = 0; rank < m_nprocs; ++rank){
+        for(long id : recvRequests[rank]){
+            std::size_t i = std::size_t(id - vertexBegin);
+            replies[rank].push_back(VertexRecord{id, {coords[0][i], coords[1][i], coords[2][i]}});
+            referencingRanks[id].push_back(rank);
+        }
+    }
+    recvRequests.clear();
+    for(std::vector<double> & coord : coords){
+        std::vector<double>().swap(coord);
+    }
+    std::vector<std::vector<VertexRecord>> recvReplies = exchangeRecords(replies);
+    replies.clear();
+
+    //PUT THIS INFO IN MimmoObject
+    m_volmesh->getPatch()->reserveVertices(referenced.size());
+    m_volmesh->getPatch()->reserveCells(localIds.size());
+    for(const std::vector<VertexRecord> & records : recvReplies){
+        for(const VertexRecord & vertex : records){
+            m_volmesh->addVertex(darray3E({{vertex.coords[0], vertex.coords[1], vertex.coords[2]}}), vertex.id);
+        }
+    }
+    recvReplies.clear();
+
+    long PIDZone = 0;
+    for(std::size_t i = 0; i < localIds.size(); ++i){
+        m_volmesh->addConnectedCell(localConns[i], localTypes[i], PIDZone, localIds[i]);
+    }
+    localConns.clear();
+
+    for(auto it = referencingRanks.begin(); it != referencingRanks.end();){
+        if(it->second.size() < 2){
+            it = referencingRanks.erase(it);
+        }else{
+            ++it;
+        }
+    }
+    buildGhosts(m_volmesh.get(), shareVertices(referencingRanks));
+
+    //store boundary conditions info, known by all the ranks.
+    long PIDBCOffset = 1;
+    int nbc = int(bcNames.size());
+    for(int j = 0; j < nbc; ++j){
+        m_storedBC->mcg_pidtobc[PIDBCOffset + j] = bcTypes[j];
+        m_storedBC->mcg_bcpidnames[PIDBCOffset + j] = bcNames[j];
+        m_storedBC->mcg_zonetobndpid[0].push_back(PIDBCOffset + j);
+        m_storedBC->mcg_pidtolisttype[int(PIDBCOffset + j)] = int(bcOnElements[j]);
+    }
+    m_storedBC->mcg_zonepidnames[PIDZone] = zonename;
+
+    //now create the surface mesh from the border faces of the local cells, ghosts included.
+    //Points lists are matched on face vertices, element lists on the sorted element connectivity.
+    std::vector<std::set<long>> pools(nbc);
+    std::map<livector1D, long> elementsPID;
+    for(int j = 0; j < nbc; ++j){
+        if(!bcOnElements[j]){
+            pools[j].insert(bcLists[j].begin(), bcLists[j].end());
+            continue;
+        }
+        for(long idC : bcLists[j]){
+            auto itElement = surfElements.find(idC);
+            if(itElement == surfElements.end()) continue;
+            livector1D key = itElement->second;
+            std::sort(key.begin(), key.end());
+            elementsPID.insert(std::make_pair(key, PIDBCOffset + long(j)));
+        }
+    }
+    surfElements.clear();
+    bcLists.clear();
+
+    std::unordered_map<long, std::set<int> > borderFaceCells = m_volmesh->extractBoundaryFaceCellID(true);
+
+    bitpit::PiercedVector<bitpit::Cell> & volCells = m_volmesh->getCells();
+    bitpit::PiercedVector<bitpit::Vertex> & volVerts = m_volmesh->getVertices();
+    bitpit::PiercedVector<bitpit::Vertex> & surfVerts = m_surfmesh->getVertices();
+    for(const auto & cellPair : borderFaceCells){
+        bitpit::Cell & cell = volCells.at(cellPair.first);
+        int rank = m_volmesh->getPatch()->getCellRank(cellPair.first);
+
+        for(int iface : cellPair.second){
+            bitpit::ConstProxyVector<long> conn = cell.getFaceConnect(iface);
+            long PIDSurf = -1;
+            for(int j = 0; j < nbc && PIDSurf < 0; ++j){
+                if(!bcOnElements[j] && belongToPool(conn, pools[j])){
+                    PIDSurf = PIDBCOffset + long(j);
+                }
+            }
+            if(PIDSurf < 0 && !elementsPID.empty()){
+                livector1D key(conn.begin(), conn.end());
+                std::sort(key.begin(), key.end());
+                auto itPID = elementsPID.find(key);
+                if(itPID != elementsPID.end()) PIDSurf = itPID->second;
+            }
+            if(PIDSurf < 0) continue;
+
+            //push vertices in m_surfmesh;
+            for(long idV : conn){
+                if(!surfVerts.exists(idV)){
+                    m_surfmesh->addVertex(volVerts.at(idV), idV);
+                }
+            }
+            m_surfmesh->addConnectedCell(livector1D(conn.begin(), conn.end()), cell.getFaceType(iface), PIDSurf, 6*cellPair.first + iface, rank);
+        }
+    }
+
+    // Set Tolerance
+    m_volmesh->setTolerance(m_tolerance);
+    m_surfmesh->setTolerance(m_tolerance);
+
+    // Update meshes
+    m_volmesh->update();
+    m_surfmesh->update();
+
+    // Build patch info
+    m_volmesh->buildPatchInfo();
+    m_surfmesh->buildPatchInfo();
+
+    return true;
+}
+
+/*!
+ * Exchange records between all the processes of the communicator.
+ * \param[in] sendRecords records to be sent to each process
+ * \return records received from each process.
+ */
+template<typename T>
+std::vector<std::vector<T>>
+IOCGNS::exchangeRecords(const std::vector<std::vector<T>> & sendRecords){
+
+    MPI_Datatype recordType;
+    MPI_Type_contiguous(int(sizeof(T)), MPI_BYTE, &recordType);
+    MPI_Type_commit(&recordType);
+
+    std::vector<int> sendCounts(m_nprocs), recvCounts(m_nprocs);
+    std::vector<int> sendDispls(m_nprocs, 0), recvDispls(m_nprocs, 0);
+    for (int rank = 0; rank < m_nprocs; ++rank){
+        sendCounts[rank] = int(sendRecords[rank].size());
+    }
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, m_communicator);
+    for (int rank = 1; rank < m_nprocs; ++rank){
+        sendDispls[rank] = sendDispls[rank-1] + sendCounts[rank-1];
+        recvDispls[rank] = recvDispls[rank-1] + recvCounts[rank-1];
+    }
+
+    std::vector<T> sendBuffer;
+    sendBuffer.reserve(std::size_t(sendDispls.back() + sendCounts.back()));
+    for (const std::vector<T> & records : sendRecords){
+        sendBuffer.insert(sendBuffer.end(), records.begin(), records.end());
+    }
+    std::vector<T> recvBuffer(std::size_t(recvDispls.back() + recvCounts.back()));
+    MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), recordType,
+                  recvBuffer.data(), recvCounts.data(), recvDispls.data(), recordType, m_communicator);
+    MPI_Type_free(&recordType);
+
+    std::vector<std::vector<T>> recvRecords(m_nprocs);
+    for (int rank = 0; rank < m_nprocs; ++rank){
+        recvRecords[rank].assign(recvBuffer.begin() + recvDispls[rank], recvBuffer.begin() + recvDispls[rank] + recvCounts[rank]);
+    }
+    return recvRecords;
+}
+
+/*!
+ * Distribute the sharing information of the vertices, collected by the ranks owning their ranges.
+ * \param[in] referencingRanks ranks referencing each owned vertex shared by more ranks
+ * \return for each local vertex shared with other ranks, the other ranks.
+ */
+std::unordered_map<long, std::vector<int>>
+IOCGNS::shareVertices(const std::unordered_map<long, std::vector<int>> & referencingRanks){
+
+    std::vector<std::vector<SharingRecord>> sendSharing(m_nprocs);
+    for (const auto & entry : referencingRanks){
+        for (int rank : entry.second){
+            for (int other : entry.second){
+                if (other != rank){
+                    sendSharing[rank].push_back(SharingRecord{entry.first, other});
+                }
+            }
+        }
+    }
+    std::vector<std::vector<SharingRecord>> recvSharing = exchangeRecords(sendSharing);
+
+    std::unordered_map<long, std::vector<int>> sharedWith;
+    for (const std::vector<SharingRecord> & records : recvSharing){
+        for (const SharingRecord & record : records){
+            sharedWith[record.id].push_back(record.rank);
+        }
+    }
+    return sharedWith;
+}
+
+/*!
+ * Send to the other ranks, as ghosts, the local cells having at least one vertex shared with
+ * them, receive the ghost cells of the current rank and update the geometry.
+ * \param[in,out] geometry partitioned geometry
+ * \param[in] sharedWith for each local vertex shared with other ranks, the other ranks
+ */
+void
+IOCGNS::buildGhosts(MimmoObject * geometry, const std::unordered_map<long, std::vector<int>> & sharedWith){
+
+    std::vector<std::unordered_set<long>> ghostCells(m_nprocs);
+    for (const bitpit::Cell & cell : geometry->getCells()){
+        for (long vertexId : cell.getVertexIds()){
+            auto it = sharedWith.find(vertexId);
+            if (it == sharedWith.end()) continue;
+            for (int rank : it->second){
+                ghostCells[rank].insert(cell.getId());
+            }
+        }
+    }
+
+    std::vector<std::vector<CellRecord>> sendCells(m_nprocs);
+    std::vector<std::vector<VertexRecord>> sendVertices(m_nprocs);
+    for (int rank = 0; rank < m_nprocs; ++rank){
+        for (long cellId : ghostCells[rank]){
+            const bitpit::Cell & cell = geometry->getCells()[cellId];
+            bitpit::ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+            sendCells[rank].push_back(CellRecord{cellId, long(cell.getPID()), int(cell.getType()), int(cellVertexIds.size())});
+            for (long vertexId : cellVertexIds){
+                const darray3E & point = geometry->getVertexCoords(vertexId);
+                sendVertices[rank].push_back(VertexRecord{vertexId, {point[0], point[1], point[2]}});
+            }
+        }
+    }
+    std::vector<std::vector<CellRecord>> recvCells = exchangeRecords(sendCells);
+    std::vector<std::vector<VertexRecord>> recvVertices = exchangeRecords(sendVertices);
+
+    livector1D conn;
+    for (int rank = 0; rank < m_nprocs; ++rank){
+        std::size_t counter = 0;
+        for (const CellRecord & cell : recvCells[rank]){
+            conn.clear();
+            for (int i = 0; i < cell.nVertices; ++i){
+                const VertexRecord & vertex = recvVertices[rank][counter++];
+                if (!geometry->getVertices().exists(vertex.id)){
+                    geometry->addVertex(darray3E({{vertex.coords[0], vertex.coords[1], vertex.coords[2]}}), vertex.id);
+                }
+                conn.push_back(vertex.id);
+            }
+            geometry->addConnectedCell(conn, static_cast<bitpit::ElementType>(cell.type), cell.pid, cell.id, rank);
+        }
+    }
+
+    geometry->update();
+}
+#endif
 
 
 /*!
@@ -1494,6 +2472,28 @@ IOCGNS::absorbSectionXML(const bitpit::Config::Section & slotXML, std::string na
         setWritingMultiZone(value);
     };
 
+    if(slotXML.hasOption("WriteParallel")){
+        input = slotXML.get("WriteParallel");
+        input = bitpit::utils::string::trim(input);
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >>value;
+        };
+        setWritingParallel(value);
+    };
+
+    if(slotXML.hasOption("ReadParallel")){
+        input = slotXML.get("ReadParallel");
+        input = bitpit::utils::string::trim(input);
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >>value;
+        };
+        setReadingParallel(value);
+    };
+
     if(slotXML.hasOption("Tolerance")){
         input = slotXML.get("Tolerance");
         double value = 1.0e-10;
@@ -1524,6 +2524,8 @@ IOCGNS::flushSectionXML(bitpit::Config::Section & slotXML, std::string name){
     slotXML.set("WriteInfo", std::to_string(int(m_writeOnFile)));
     slotXML.set("WriteFormat", std::to_string(static_cast<int>(whatWritingFormat())));
     slotXML.set("WriteMultiZone", std::to_string(int(isWritingMultiZone())));
+    slotXML.set("WriteParallel", std::to_string(int(isWritingParallel())));
+    slotXML.set("ReadParallel", std::to_string(int(isReadingParallel())));
 
     std::stringstream ss;
     ss<<std::scientific<<m_tolerance;
@@ -1561,7 +2563,7 @@ bool IOCGNS::belongToPool(const bitpit::ConstProxyVector<long> & elementconn, co
  */
 std::map<int, std::vector<std::size_t> >
 IOCGNS::getZoneConn(const livector1D& cellIds,
-                    const std::unordered_map<long, int> & mapToLocVert,
+                    const std::unordered_map<long, long> & mapToLocVert,
                     std::map<int, std::size_t> &ncells)
 {
     std::map<int, std::vector<std::size_t> > mm;
@@ -1633,9 +2635,9 @@ IOCGNS::getZoneConn(const livector1D& cellIds,
  */
 std::map<int, std::vector<std::size_t> >
 IOCGNS::getBCElementsConn(const livector1D& cellIds,
-                          const std::unordered_map<long, int> & mapToLocVert,
+                          const std::unordered_map<long, long> & mapToLocVert,
                           std::map<int, std::size_t> &ncells,
-                          std::unordered_map<long, int> & surfCellGlobToLoc)
+                          std::unordered_map<long, long> & surfCellGlobToLoc)
 {
     std::map<int, std::vector<std::size_t> > mm;
     std::map<int, std::vector<long> > idInsertion;
@@ -1677,7 +2679,7 @@ IOCGNS::getBCElementsConn(const livector1D& cellIds,
         idInsertion[tt].push_back(idC);
     }
 
-    int counter = 0;
+    long counter = 0;
     for(auto &mapp: idInsertion){
         for(long & val: mapp.second){
             surfCellGlobToLoc.insert(std::make_pair(val, counter) );
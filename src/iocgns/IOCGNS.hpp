@@ -92,7 +92,12 @@ private:
  *   their names and their cgns type.
    - CGNS meshes exported from Pointwise16 and StarCCM++ are still unreadable with
      the current class. Errors are known and will be fixed in later versions.
-   - Reading/writing partitioned mesh in cgns format is not yet available.
+   - Reading partitioned mesh is available for single zone files without MIXED/polyhedral
+     sections, see setReadingParallel: each rank reads its own range of volume elements and
+     ghost cells are exchanged among ranks. Other files are read by rank 0.
+   - Writing partitioned mesh is available if the cgns library is built with parallel support
+     (pcgns), see setWritingParallel: each rank writes its own vertices and cells ranges of
+     the file through collective HDF5 access.
  *
  * Dependencies : cgns libraries.
  *
@@ -130,6 +135,8 @@ private:
  * - <B>WriteInfo</B>: boolean (1/0) write on file zoneNames, bcNames, either in reading and writing mode. The save directory path is specified with Dir.
  * - <B>WriteFormat</B>: writing format supported by the class, see IOCGNS_WriteType enum
  * - <B>WriteMultiZone</B>: 0- write single zone, 1- write multizone(if multi zone are available in the mesh).
+ * - <B>WriteParallel</B>: 0- write on rank 0 only, 1- write partitioned mesh with parallel cgns (MPI and pcgns only).
+ * - <B>ReadParallel</B>: 0- read on rank 0 only, 1- read partitioned mesh with all the ranks (MPI only).
  * - <B>Tolerance</B>:value of the geometric tolerance to be used;
  *
  * Geometry has to be mandatorily read or passed through port.
@@ -144,9 +151,9 @@ public:
         \brief enumeration of IOCGNS class I/O modes.
     */
     enum IOCGNS_Mode{
-        READ = 0        , /**< 0 - 0rank only, Read the cgns from file */
+        READ = 0        , /**< 0 - 0rank only or parallel (see setReadingParallel), Read the cgns from file */
         RESTORE=1       , /**< 1 - Read the mesh from a previous <>.dump file*/
-        WRITE=2         , /**< 2 - 0rank only, Write the mesh on a cgns file */
+        WRITE=2         , /**< 2 - 0rank only or parallel (see setWritingParallel), Write the mesh on a cgns file */
         DUMP=3            /**< 3 - Write the mesh to dump file*/
     };
 
@@ -179,6 +186,8 @@ public:
 
     IOCGNS_WriteType  whatWritingFormat();
     bool              isWritingMultiZone();
+    bool              isWritingParallel();
+    bool              isReadingParallel();
 
     void            setDir(const std::string &dir);
     void            setFilename(const std::string &filename);
@@ -189,6 +198,8 @@ public:
 
     void            setWritingFormat(IOCGNS_WriteType type);
     void            setWritingMultiZone(bool multizone);
+    void            setWritingParallel(bool parallel);
+    void            setReadingParallel(bool parallel);
     void            setWriteOnFileMeshInfo(bool write);
 
     void            setTolerance(double tol);
@@ -200,6 +211,7 @@ public:
 
 protected:
     void            swap(IOCGNS &) noexcept;
+    std::vector<std::string> getInputFiles();
     bool            write(const std::string & file);
     bool            read(const std::string & file);
     bool            dump(std::ostream & stream);
@@ -217,22 +229,57 @@ protected:
     void            writeInfoFile();
     std::map<int, std::vector<std::size_t> >
                     getZoneConn(const livector1D& cellIds,
-                                const std::unordered_map<long,int> & mapToLocVert,
+                                const std::unordered_map<long,long> & mapToLocVert,
                                 std::map<int, std::size_t> & ncells);
     std::map<int, std::vector<std::size_t> >
                     getBCElementsConn(const livector1D& cellIds,
-                                      const std::unordered_map<long,int> & mapToLocVert,
+                                      const std::unordered_map<long,long> & mapToLocVert,
                                       std::map<int, std::size_t> &ncells,
-                                      std::unordered_map<long, int> & surfCellGlobToLoc);
+                                      std::unordered_map<long, long> & surfCellGlobToLoc);
 
 #if MIMMO_ENABLE_MPI
+    bool writeParallel(const std::string & file);
+    bool readParallel(const std::string & file, bool & supported);
     void communicateAllProcsStoredBC();
+
+    /*!
+     * Vertex record exchanged between processes.
+     */
+    struct VertexRecord{
+        long    id;         /**< vertex id */
+        double  coords[3];  /**< vertex coordinates */
+    };
+
+    /*!
+     * Cell record exchanged between processes.
+     */
+    struct CellRecord{
+        long    id;         /**< cell id */
+        long    pid;        /**< cell part identifier */
+        int     type;       /**< cell bitpit::ElementType */
+        int     nVertices;  /**< number of vertices of the cell */
+    };
+
+    /*!
+     * Record of a vertex shared with another process.
+     */
+    struct SharingRecord{
+        long    id;         /**< vertex id */
+        int     rank;       /**< rank of the process sharing the vertex */
+    };
+
+    template<typename T>
+    std::vector<std::vector<T>> exchangeRecords(const std::vector<std::vector<T>> & sendRecords);
+    std::unordered_map<long, std::vector<int>> shareVertices(const std::unordered_map<long, std::vector<int>> & referencingRanks);
+    void buildGhosts(MimmoObject * geometry, const std::unordered_map<long, std::vector<int>> & sharedWith);
 #endif
 
 private:
     IOCGNS_Mode      m_mode;       /**<Mode of execution.See setMode configuration.*/
     IOCGNS_WriteType m_wtype;      /**<Writing type HDF5 or ADF*/
     bool             m_multizone;  /**<Writing multizone true, or single zone false*/
+    bool             m_parallel;   /**<Writing partitioned mesh with parallel cgns true, or on rank 0 only false*/
+    bool             m_parallelRead; /**<Reading partitioned mesh with all the ranks true, or on rank 0 only false*/
 
     std::string     m_dir;         /**<Name of directory path*/
     std::string     m_filename;    /**<Name of file */
@@ -0,0 +1,413 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+#include "FieldContainer.hpp"
+#include <cstring>
+
+namespace mimmo{
+
+namespace fieldContainer{
+
+static const char           MAGIC[8] = {'M','I','M','M','O','F','L','D'};   /**< Magic string of container files.*/
+static const std::uint32_t  VERSION = 1;                                    /**< Version of the format.*/
+static const std::uint32_t  BYTE_ORDER_MARK = 0x01020304;                   /**< Byte order mark.*/
+static const std::size_t    FILE_HEADER_SIZE = 16;                          /**< Size of the file header.*/
+
+static_assert(sizeof(ChunkHeader) == 64, "unexpected padding of fieldContainer::ChunkHeader");
+
+/*!
+ * \return size rounded up to a multiple of 8 bytes.
+ * \param[in] size size in bytes
+ */
+static std::size_t pad8(std::size_t size){
+    return (size + 7) & ~std::size_t(7);
+}
+
+/*!
+ * \return size in bytes of a value component of a storage type, 0 for unknown types.
+ * \param[in] dtype storage type, as stored in the file
+ */
+static std::size_t getComponentSize(std::uint32_t dtype){
+    if(dtype == std::uint32_t(DataType::FLOAT32)) return sizeof(float);
+    if(dtype == std::uint32_t(DataType::FLOAT64)) return sizeof(double);
+    return 0;
+}
+
+/*!
+ * Check the file header of a container.
+ * \param[in] data contents of the file header
+ * \param[in] size size of the contents
+ * \return true if the header is valid.
+ */
+static bool checkFileHeader(const char * data, std::size_t size){
+    if(size < FILE_HEADER_SIZE) return false;
+    std::uint32_t version, mark;
+    std::memcpy(&version, data + 8, sizeof(std::uint32_t));
+    std::memcpy(&mark, data + 12, sizeof(std::uint32_t));
+    return std::memcmp(data, MAGIC, 8) == 0 && version == VERSION && mark == BYTE_ORDER_MARK;
+}
+
+/*!
+ * \return true if the file is a field container, written with the byte order of the host.
+ * \param[in] filename path to the file
+ */
+bool isContainerFile(const std::string & filename){
+    std::ifstream in(filename, std::ios::binary);
+    char header[FILE_HEADER_SIZE];
+    if(!in.read(header, FILE_HEADER_SIZE)) return false;
+    return checkFileHeader(header, FILE_HEADER_SIZE);
+}
+
+/*!
+ * Compute the fingerprint of the structures of a geometry a field may refer to, i.e. a 64 bits
+ * FNV-1a hash of their sorted ids. Interfaces are considered only if they are built.
+ * The fingerprint of a partitioned geometry is the one of the local partition.
+ * \param[in] geometry geometry
+ * \param[in] location location of the field
+ * \return fingerprint of the geometry, 0 if the geometry is missing or the location is undefined.
+ */
+std::uint64_t computeGeometryFingerprint(const MimmoSharedPointer<MimmoObject> & geometry, MPVLocation location){
+    if(!geometry) return 0;
+
+    std::vector<long> ids;
+    switch(location){
+    case MPVLocation::POINT:
+        ids = geometry->getVertices().getIds(false);
+        break;
+    case MPVLocation::CELL:
+        ids = geometry->getCells().getIds(false);
+        break;
+    case MPVLocation::INTERFACE:
+        if(geometry->getInterfacesSyncStatus() == SyncStatus::SYNC){
+            ids = geometry->getInterfaces().getIds(false);
+        }
+        break;
+    default:
+        return 0;
+    }
+    std::sort(ids.begin(), ids.end());
+
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](std::int64_t value){
+        unsigned char bytes[sizeof(std::int64_t)];
+        std::memcpy(bytes, &value, sizeof(std::int64_t));
+        for(unsigned char byte : bytes){
+            hash ^= byte;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(std::int64_t(location));
+    mix(std::int64_t(ids.size()));
+    for(long id : ids){
+        mix(std::int64_t(id));
+    }
+    return (hash == 0) ? 1 : hash;
+}
+
+/*!
+ * Default constructor.
+ */
+Reader::Reader(){}
+
+/*!
+ * Constructor, opening a container file.
+ * \param[in] filename path to the file
+ */
+Reader::Reader(const std::string & filename){
+    open(filename);
+}
+
+/*!
+ * Open a container file and index its fields. Each chunk flagged as FIELD_BEGIN starts
+ * a new field, so that a field appended again, e.g. a new version of it, forms a new
+ * field even right after the previous one. In files written without the flag,
+ * consecutive chunks with the same name form a field.
+ * \param[in] filename path to the file
+ * \return false if the file cannot be opened or it is not a valid container.
+ */
+bool
+Reader::open(const std::string & filename){
+    close();
+    if(!m_buffer.open(filename)) return false;
+
+    const char * data = m_buffer.begin();
+    std::size_t size = m_buffer.size();
+    if(!checkFileHeader(data, size)){
+        close();
+        return false;
+    }
+
+    std::size_t offset = FILE_HEADER_SIZE;
+    while(offset < size){
+        if(offset + sizeof(ChunkHeader) > size){
+            close();
+            return false;
+        }
+        ChunkHeader header = getChunkHeader(offset);
+        std::size_t componentSize = getComponentSize(header.dtype);
+        std::size_t required = sizeof(ChunkHeader) + pad8(header.nameLength)
+                             + ((header.flags & HAS_IDS) ? header.count * sizeof(std::int64_t) : 0)
+                             + pad8(header.count * header.components * componentSize);
+        if(componentSize == 0 || header.components == 0 || header.chunkSize < required
+           || header.chunkSize > size - offset || header.chunkSize % 8 != 0){
+            close();
+            return false;
+        }
+
+        std::string name(data + offset + sizeof(ChunkHeader), header.nameLength);
+        bool sameField = !(header.flags & FIELD_BEGIN) && !m_fields.empty() && m_fields.back().name == name
+                         && m_fields.back().location == static_cast<MPVLocation>(header.location)
+                         && std::uint32_t(m_fields.back().dtype) == header.dtype
+                         && m_fields.back().components == header.components;
+        if(!sameField){
+            FieldInfo field;
+            field.name = name;
+            field.location = static_cast<MPVLocation>(header.location);
+            field.dtype = static_cast<DataType>(header.dtype);
+            field.components = header.components;
+            field.count = 0;
+            field.fingerprint = header.fingerprint;
+            m_fields.push_back(field);
+        }
+        m_fields.back().count += std::size_t(header.count);
+        m_fields.back().chunks.push_back(offset);
+        offset += std::size_t(header.chunkSize);
+    }
+    return true;
+}
+
+/*!
+ * Close the container file.
+ */
+void
+Reader::close(){
+    m_buffer.close();
+    m_fields.clear();
+}
+
+/*!
+ * \return true if a container file is open.
+ */
+bool
+Reader::isOpen() const{
+    return m_buffer.isOpen();
+}
+
+/*!
+ * \return the number of fields of the container.
+ */
+std::size_t
+Reader::getFieldCount() const{
+    return m_fields.size();
+}
+
+/*!
+ * \return the description of a field, nullptr if the index is out of range.
+ * \param[in] index index of the field, in file order
+ */
+const FieldInfo *
+Reader::getFieldInfo(std::size_t index) const{
+    if(index >= m_fields.size()) return nullptr;
+    return &m_fields[index];
+}
+
+/*!
+ * \return the description of the last field with a given name, nullptr if no field has that name.
+ * \param[in] name name of the field
+ */
+const FieldInfo *
+Reader::getFieldInfo(const std::string & name) const{
+    for(auto it = m_fields.rbegin(); it != m_fields.rend(); ++it){
+        if(it->name == name) return &(*it);
+    }
+    return nullptr;
+}
+
+/*!
+ * \return the header of a chunk.
+ * \param[in] offset offset of the chunk in the file
+ */
+ChunkHeader
+Reader::getChunkHeader(std::size_t offset) const{
+    ChunkHeader header;
+    std::memcpy(&header, m_buffer.begin() + offset, sizeof(ChunkHeader));
+    return header;
+}
+
+/*!
+ * Decode the entries of a chunk in a range of ids.
+ * \param[in] offset offset of the chunk in the file
+ * \param[in] idBegin lowest id to be decoded
+ * \param[in] idEnd highest id to be decoded plus one
+ * \param[out] ids ids of the decoded entries
+ * \param[out] values components of the decoded values
+ * \return false if the ids of the chunk are not sorted.
+ */
+bool
+Reader::decodeChunk(std::size_t offset, long idBegin, long idEnd, std::vector<long> & ids, std::vector<double> & values) const{
+
+    ids.clear();
+    values.clear();
+    ChunkHeader header = getChunkHeader(offset);
+    if(header.count == 0 || header.idEnd <= idBegin || header.idBegin >= idEnd) return true;
+
+    const char * cursor = m_buffer.begin() + offset + sizeof(ChunkHeader) + pad8(header.nameLength);
+    std::size_t count = std::size_t(header.count);
+    std::size_t first = 0, last = count;
+    if(header.flags & HAS_IDS){
+        ids.resize(count);
+        for(std::size_t k = 0; k < count; ++k){
+            std::int64_t id;
+            std::memcpy(&id, cursor + k * sizeof(std::int64_t), sizeof(std::int64_t));
+            ids[k] = long(id);
+        }
+        if(!std::is_sorted(ids.begin(), ids.end())) return false;
+        first = std::size_t(std::lower_bound(ids.begin(), ids.end(), idBegin) - ids.begin());
+        last = std::size_t(std::lower_bound(ids.begin(), ids.end(), idEnd) - ids.begin());
+        ids.erase(ids.begin() + last, ids.end());
+        ids.erase(ids.begin(), ids.begin() + first);
+        cursor += count * sizeof(std::int64_t);
+    }else{
+        if(idBegin > header.idBegin) first = std::size_t(idBegin - header.idBegin);
+        if(idEnd < header.idEnd)     last = std::size_t(idEnd - header.idBegin);
+        ids.resize(last - first);
+        for(std::size_t k = first; k < last; ++k){
+            ids[k - first] = long(header.idBegin) + long(k);
+        }
+    }
+
+    std::size_t nComponents = (last - first) * header.components;
+    values.resize(nComponents);
+    cursor += first * header.components * getComponentSize(header.dtype);
+    if(header.dtype == std::uint32_t(DataType::FLOAT32)){
+        for(std::size_t k = 0; k < nComponents; ++k){
+            float value;
+            std::memcpy(&value, cursor + k * sizeof(float), sizeof(float));
+            values[k] = double(value);
+        }
+    }else{
+        std::memcpy(values.data(), cursor, nComponents * sizeof(double));
+    }
+    return true;
+}
+
+/*!
+ * Default constructor.
+ */
+Writer::Writer(){}
+
+/*!
+ * Open a container file for writing.
+ * \param[in] filename path to the file
+ * \param[in] append if true and the file is a valid container, new fields are appended
+ * to the ones already stored; otherwise the file is overwritten.
+ * \return false if the file cannot be opened.
+ */
+bool
+Writer::open(const std::string & filename, bool append){
+    close();
+    if(append && isContainerFile(filename)){
+        m_out.open(filename, std::ios::binary | std::ios::out | std::ios::app);
+        return m_out.is_open();
+    }
+
+    m_out.open(filename, std::ios::binary | std::ios::out | std::ios::trunc);
+    if(!m_out.is_open()) return false;
+    m_out.write(MAGIC, 8);
+    m_out.write(reinterpret_cast<const char *>(&VERSION), sizeof(std::uint32_t));
+    m_out.write(reinterpret_cast<const char *>(&BYTE_ORDER_MARK), sizeof(std::uint32_t));
+    return m_out.good();
+}
+
+/*!
+ * Close the container file.
+ */
+void
+Writer::close(){
+    if(m_out.is_open()) m_out.close();
+}
+
+/*!
+ * \return true if a container file is open.
+ */
+bool
+Writer::isOpen() const{
+    return m_out.is_open();
+}
+
+/*!
+ * Write a chunk of a field.
+ * \param[in] name name of the field
+ * \param[in] location location of the field
+ * \param[in] dtype storage type of the values
+ * \param[in] components number of components of each value
+ * \param[in] fingerprint fingerprint of the reference geometry
+ * \param[in] ids sorted ids of the entries
+ * \param[in] values components of the values of the entries
+ * \param[in] count number of entries
+ * \param[in] first true for the first chunk of the field
+ * \return false if the chunk cannot be written.
+ */
+bool
+Writer::writeChunk(const std::string & name, MPVLocation location, DataType dtype, std::uint32_t components,
+                   std::uint64_t fingerprint, const long * ids, const double * values, std::size_t count,
+                   bool first){
+
+    static const char padding[8] = {0,0,0,0,0,0,0,0};
+    std::size_t componentSize = getComponentSize(std::uint32_t(dtype));
+    bool consecutive = (count == 0) || (ids[count - 1] - ids[0] == long(count) - 1);
+
+    ChunkHeader header;
+    header.count = count;
+    header.fingerprint = fingerprint;
+    header.location = std::int64_t(location);
+    header.idBegin = (count > 0) ? ids[0] : 0;
+    header.idEnd = (count > 0) ? ids[count - 1] + 1 : 0;
+    header.dtype = std::uint32_t(dtype);
+    header.components = components;
+    header.flags = (consecutive ? 0 : HAS_IDS) | (first ? FIELD_BEGIN : 0);
+    header.nameLength = std::uint32_t(name.size());
+    std::size_t valuesSize = count * components * componentSize;
+    header.chunkSize = sizeof(ChunkHeader) + pad8(name.size()) + (consecutive ? 0 : count * sizeof(std::int64_t)) + pad8(valuesSize);
+
+    m_out.write(reinterpret_cast<const char *>(&header), sizeof(ChunkHeader));
+    m_out.write(name.data(), std::streamsize(name.size()));
+    m_out.write(padding, std::streamsize(pad8(name.size()) - name.size()));
+    if(!consecutive){
+        std::vector<std::int64_t> table(ids, ids + count);
+        m_out.write(reinterpret_cast<const char *>(table.data()), std::streamsize(count * sizeof(std::int64_t)));
+    }
+    std::size_t nComponents = count * components;
+    if(dtype == DataType::FLOAT32){
+        std::vector<float> converted(values, values + nComponents);
+        m_out.write(reinterpret_cast<const char *>(converted.data()), std::streamsize(valuesSize));
+    }else{
+        m_out.write(reinterpret_cast<const char *>(values), std::streamsize(valuesSize));
+    }
+    m_out.write(padding, std::streamsize(pad8(valuesSize) - valuesSize));
+    return m_out.good();
+}
+
+}
+
+}
@@ -0,0 +1,198 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+#ifndef __FIELDCONTAINER_HPP__
+#define __FIELDCONTAINER_HPP__
+
+#include "MimmoPiercedVector.hpp"
+#include "mimmoTextParser.hpp"
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mimmo{
+
+/*!
+ * \ingroup iogeneric
+ * \brief Binary container of MimmoPiercedVector fields.
+ *
+ * A container file holds any number of fields, each one stored as a sequence of chunks.
+ * The file starts with a 16 bytes header: the magic string MIMMOFLD, the format version
+ * and a byte order mark (uint32 values). Every chunk starts with a 64 bytes ChunkHeader,
+ * followed by the field name, the optional id table (int64) and the values (float32 or
+ * float64, components interleaved); each section is padded to 8 bytes.
+ * Entries are sorted by id, so that each chunk covers a range of ids: when the ids of a
+ * chunk are consecutive the id table is omitted.
+ *
+ * The file is memory-mapped when reading; chunks are decoded concurrently and those out
+ * of a requested id range are skipped without being touched, so that each process of a
+ * parallel run can read only the ids of its own partition.
+ * A field may carry a fingerprint of the geometry it refers to (see computeGeometryFingerprint),
+ * to detect a mismatch between the field and the geometry it is applied to.
+ * Files are read and written with the byte order of the host.
+ */
+namespace fieldContainer{
+
+    /*!
+     * \brief Storage type of the values of a field.
+     */
+    enum class DataType : std::uint32_t{
+        FLOAT32 = 1, /**< 32 bits floating point */
+        FLOAT64 = 2  /**< 64 bits floating point */
+    };
+
+    /*!
+     * \brief Header of a chunk of a field, as stored in the file.
+     */
+    struct ChunkHeader{
+        std::uint64_t   chunkSize;      /**< Size of the chunk in bytes, header included.*/
+        std::uint64_t   count;          /**< Number of entries of the chunk.*/
+        std::uint64_t   fingerprint;    /**< Fingerprint of the reference geometry, 0 if unknown.*/
+        std::int64_t    location;       /**< Location of the field, as MPVLocation.*/
+        std::int64_t    idBegin;        /**< Lowest id of the chunk.*/
+        std::int64_t    idEnd;          /**< Highest id of the chunk plus one.*/
+        std::uint32_t   dtype;          /**< Storage type of the values, as DataType.*/
+        std::uint32_t   components;     /**< Number of components of each value.*/
+        std::uint32_t   flags;          /**< Flags of the chunk, see HAS_IDS and FIELD_BEGIN.*/
+        std::uint32_t   nameLength;     /**< Length of the field name.*/
+    };
+
+    const std::uint32_t HAS_IDS = 1;        /**< Flag of chunks storing an id table.*/
+    const std::uint32_t FIELD_BEGIN = 2;    /**< Flag of the first chunk of a field.*/
+
+    /*!
+     * \brief Description of a field stored in a container.
+     */
+    struct FieldInfo{
+        std::string                 name;           /**< Name of the field.*/
+        MPVLocation                 location;       /**< Location of the field.*/
+        DataType                    dtype;          /**< Storage type of the values.*/
+        std::uint32_t               components;     /**< Number of components of each value.*/
+        std::size_t                 count;          /**< Number of entries of the field.*/
+        std::uint64_t               fingerprint;    /**< Fingerprint of the reference geometry, 0 if unknown.*/
+        std::vector<std::size_t>    chunks;         /**< Offsets of the chunks of the field in the file.*/
+    };
+
+    /*!
+     * \brief Conversion of the values of a field from/to their components.
+     * Defined for arithmetic types and std::array of arithmetic types.
+     */
+    template<typename T, typename Enable = void>
+    struct ValueTraits;
+
+    /*!
+     * \brief Conversion of arithmetic values from/to their components.
+     */
+    template<typename T>
+    struct ValueTraits<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>{
+        static const std::uint32_t components = 1;  /**< Number of components.*/
+        /*! Get the components of a value. \param[in] value value \param[out] out components */
+        static void get(const T & value, double * out){ out[0] = double(value); }
+        /*! Set a value from its components. \param[in] in components \param[out] value value */
+        static void set(const double * in, T & value){ value = T(in[0]); }
+    };
+
+    /*!
+     * \brief Conversion of array values from/to their components.
+     */
+    template<typename T, std::size_t d>
+    struct ValueTraits<std::array<T,d>, typename std::enable_if<std::is_arithmetic<T>::value>::type>{
+        static const std::uint32_t components = std::uint32_t(d);  /**< Number of components.*/
+        /*! Get the components of a value. \param[in] value value \param[out] out components */
+        static void get(const std::array<T,d> & value, double * out){ for(std::size_t i = 0; i < d; ++i) out[i] = double(value[i]); }
+        /*! Set a value from its components. \param[in] in components \param[out] value value */
+        static void set(const double * in, std::array<T,d> & value){ for(std::size_t i = 0; i < d; ++i) value[i] = T(in[i]); }
+    };
+
+    /*!
+     * \class Reader
+     * \ingroup iogeneric
+     * \brief Reader of a field container file. The file is memory-mapped.
+     */
+    class Reader{
+
+    public:
+        Reader();
+        explicit Reader(const std::string & filename);
+
+        bool                open(const std::string & filename);
+        void                close();
+        bool                isOpen() const;
+
+        std::size_t         getFieldCount() const;
+        const FieldInfo *   getFieldInfo(std::size_t index) const;
+        const FieldInfo *   getFieldInfo(const std::string & name) const;
+
+        template<typename T>
+        bool                read(const FieldInfo & field, MimmoPiercedVector<T> & data,
+                                 long idBegin = std::numeric_limits<long>::min(),
+                                 long idEnd = std::numeric_limits<long>::max()) const;
+
+    private:
+        text::FileBuffer        m_buffer;   /**< Contents of the file.*/
+        std::vector<FieldInfo>  m_fields;   /**< Fields of the container.*/
+
+        ChunkHeader         getChunkHeader(std::size_t offset) const;
+        bool                decodeChunk(std::size_t offset, long idBegin, long idEnd, std::vector<long> & ids, std::vector<double> & values) const;
+    };
+
+    /*!
+     * \class Writer
+     * \ingroup iogeneric
+     * \brief Writer of a field container file.
+     */
+    class Writer{
+
+    public:
+        Writer();
+
+        bool    open(const std::string & filename, bool append = false);
+        void    close();
+        bool    isOpen() const;
+
+        template<typename T>
+        bool    write(const MimmoPiercedVector<T> & field, DataType dtype = DataType::FLOAT64,
+                      std::uint64_t fingerprint = 0, std::size_t chunkCount = 1048576);
+
+    private:
+        std::ofstream   m_out;      /**< Output stream of the file.*/
+
+        bool    writeChunk(const std::string & name, MPVLocation location, DataType dtype, std::uint32_t components,
+                           std::uint64_t fingerprint, const long * ids, const double * values, std::size_t count,
+                           bool first);
+    };
+
+    std::uint64_t   computeGeometryFingerprint(const MimmoSharedPointer<MimmoObject> & geometry, MPVLocation location);
+    bool            isContainerFile(const std::string & filename);
+
+}
+
+}
+
+#include "FieldContainer.tpp"
+
+#endif /* __FIELDCONTAINER_HPP__ */
@@ -0,0 +1,135 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <algorithm>
+
+namespace mimmo{
+
+namespace fieldContainer{
+
+/*!
+ * Read a field of the container, or the part of it in a range of ids. Chunks are
+ * decoded concurrently; chunks out of the range are skipped.
+ * The field read is not linked to any geometry.
+ * \param[in] field field to be read, as returned by getFieldInfo
+ * \param[out] data field read
+ * \param[in] idBegin lowest id to be read
+ * \param[in] idEnd highest id to be read plus one
+ * \return false if the container is not open, the field is corrupted or its values
+ * have a number of components different from the ones of T.
+ */
+template<typename T>
+bool
+Reader::read(const FieldInfo & field, MimmoPiercedVector<T> & data, long idBegin, long idEnd) const{
+
+    if(!isOpen() || field.components != ValueTraits<T>::components) return false;
+
+    std::size_t nChunks = field.chunks.size();
+    std::vector<std::vector<long>> ids(nChunks);
+    std::vector<std::vector<double>> values(nChunks);
+    std::vector<int> status(nChunks, 0);
+    threads::parallelFor(0, nChunks, [&](std::size_t begin, std::size_t end){
+        for(std::size_t i = begin; i < end; ++i){
+            status[i] = int(decodeChunk(field.chunks[i], idBegin, idEnd, ids[i], values[i]));
+        }
+    }, 1);
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < nChunks; ++i){
+        if(status[i] == 0) return false;
+        count += ids[i].size();
+    }
+
+    data.clear();
+    data.setName(field.name);
+    data.setDataLocation(field.location);
+    data.reserve(count);
+    const std::uint32_t components = ValueTraits<T>::components;
+    T value;
+    for(std::size_t i = 0; i < nChunks; ++i){
+        const double * chunkValues = values[i].data();
+        for(std::size_t k = 0; k < ids[i].size(); ++k){
+            if(data.exists(ids[i][k])) continue;
+            ValueTraits<T>::set(chunkValues + k * components, value);
+            data.insert(ids[i][k], value);
+        }
+    }
+    return true;
+}
+
+/*!
+ * Append a field to the container. Entries are sorted by id and split in chunks.
+ * \param[in] field field to be written
+ * \param[in] dtype storage type of the values
+ * \param[in] fingerprint fingerprint of the reference geometry of the field, 0 if unknown
+ * \param[in] chunkCount maximum number of entries of a chunk
+ * \return false if the container is not open or the field cannot be written.
+ */
+template<typename T>
+bool
+Writer::write(const MimmoPiercedVector<T> & field, DataType dtype, std::uint64_t fingerprint, std::size_t chunkCount){
+
+    if(!isOpen()) return false;
+
+    const std::uint32_t components = ValueTraits<T>::components;
+    std::size_t count = field.size();
+
+    std::vector<std::pair<long, std::size_t>> order;
+    order.reserve(count);
+    std::vector<double> values(count * components);
+    std::size_t index = 0;
+    for(auto it = field.cbegin(); it != field.cend(); ++it){
+        order.emplace_back(it.getId(), index);
+        ValueTraits<T>::get(*it, values.data() + index * components);
+        ++index;
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<long> ids(count);
+    std::vector<double> sortedValues(count * components);
+    threads::parallelFor(0, count, [&](std::size_t begin, std::size_t end){
+        for(std::size_t k = begin; k < end; ++k){
+            ids[k] = order[k].first;
+            std::copy_n(values.data() + order[k].second * components, components, sortedValues.data() + k * components);
+        }
+    });
+
+    std::string name = field.getName();
+    MPVLocation location = field.getConstDataLocation();
+    if(count == 0){
+        return writeChunk(name, location, dtype, components, fingerprint, nullptr, nullptr, 0, true);
+    }
+    if(chunkCount == 0) chunkCount = count;
+
+    bool good = true;
+    for(std::size_t begin = 0; begin < count && good; begin += chunkCount){
+        std::size_t n = std::min(chunkCount, count - begin);
+        good = writeChunk(name, location, dtype, components, fingerprint, ids.data() + begin, sortedValues.data() + begin * components, n, begin == 0);
+    }
+    return good;
+}
+
+}
+
+}
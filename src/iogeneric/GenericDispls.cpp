@@ -22,6 +22,7 @@
  *
 \*---------------------------------------------------------------------------*/
 #include "GenericDispls.hpp"
+#include "mimmoTextParser.hpp"
 #include <bitpit_operators.hpp>
 #include <fstream>
 
@@ -103,6 +104,17 @@ void GenericDispls::swap(GenericDispls & x )noexcept
     std::swap(m_template, x.m_template);
     BaseManipulation::swap(x);
 }
+
+/*!
+ * Get the file read by the object, if it is in read mode.
+ * \return path of the input file.
+ */
+std::vector<std::string>
+GenericDispls::getInputFiles(){
+    std::vector<std::string> files;
+    if (m_read) files.push_back(m_dir+"/"+m_filename);
+    return files;
+}
 /*!
  * It builds the input/output ports of the object
  */
@@ -116,6 +128,7 @@ GenericDispls::buildPorts(){
     built = (built && createPortIn<int, GenericDispls>(this, &mimmo::GenericDispls::setNDispl, M_VALUEI));
 
     built = (built && createPortOut<dvecarr3E, GenericDispls>(this, &mimmo::GenericDispls::getDispl, M_DISPLS));
+    built = (built && createPortOut<fvecarr3E, GenericDispls>(this, &mimmo::GenericDispls::getDisplFloat32, M_DISPLS32));
     built = (built && createPortOut<livector1D, GenericDispls>(this, &mimmo::GenericDispls::getLabels, M_VECTORLI));
     built = (built && createPortOut<int, GenericDispls>(this, &mimmo::GenericDispls::getNDispl, M_VALUEI));
 
@@ -140,6 +153,21 @@ GenericDispls::getDispl(){
     return m_displ;
 };
 
+/*!
+ * Return the displacements actually stored into the class, converted to single precision.
+ * \return list of displacements
+ */
+fvecarr3E
+GenericDispls::getDisplFloat32(){
+    fvecarr3E displ(m_displ.size());
+    for(std::size_t i=0; i<m_displ.size(); ++i){
+        for(int loc=0; loc<3; ++loc){
+            displ[i][loc] = float(m_displ[i][loc]);
+        }
+    }
+    return displ;
+};
+
 /*!
  * Return the labels attached to displacements actually stored into the class.
  * Labels are always checked and automatically fit to displacements during the class execution
@@ -378,13 +406,17 @@ void GenericDispls::flushSectionXML(bitpit::Config::Section & slotXML, std::stri
 
 
 /*!
- * Read displacement data from file
+ * Records of a chunk of a displacements file.
  */
-void GenericDispls::read(){
+struct DisplsChunk{
+    livector1D labels;  /**< labels of the displacements */
+    dvecarr3E displ;    /**< displacements */
+};
 
-    std::ifstream reading;
-    std::string source = m_dir+"/"+ m_filename;
-    reading.open(source.c_str());
+/*!
+ * Read displacement data from file. The file is parsed in chunks, concurrently.
+ */
+void GenericDispls::read(){
 
 #if MIMMO_ENABLE_MPI
     // Leave the reading only to the master rank
@@ -392,34 +424,40 @@ void GenericDispls::read(){
 #endif
     {
 
-        if(reading.is_open()){
+        std::string source = m_dir+"/"+ m_filename;
+        text::FileBuffer reading(source);
+
+        if(reading.isOpen()){
 
             m_displ.clear();
             m_labels.clear();
 
-            std::string keyword, line;
-            long label;
-            darray3E dtrial;
-
-            do{
-                line.clear();
-                keyword.clear();
-                std::getline(reading,line);
-                line = bitpit::utils::string::trim(line);
-                std::stringstream ss(line);
-                ss>>keyword;
-                keyword = bitpit::utils::string::trim(keyword);
-                if(keyword == "$DISPL")    {
-
-                    ss>>label;
-                    m_labels.push_back(label);
+            std::vector<DisplsChunk> chunks = text::parseChunks<DisplsChunk>(reading.begin(), reading.end(),
+                                                                             [](const char * begin, const char * end, DisplsChunk & chunk){
+                long label;
+                darray3E dtrial;
+                for(const char * line = begin; line < end; line = text::nextLine(line, end)){
+                    const char * cursor = line;
+                    const char * stop = text::lineEnd(line, end);
+                    const char * keyBegin;
+                    const char * keyEnd;
+                    if(!text::nextToken(cursor, stop, keyBegin, keyEnd)) continue;
+                    if(!text::equals(keyBegin, keyEnd, "$DISPL")) continue;
+                    if(!text::parse(cursor, stop, label)) continue;
 
                     dtrial.fill(0.0);
-                    ss>>dtrial[0]>>dtrial[1]>>dtrial[2];
-                    m_displ.push_back(dtrial);
+                    for(double & coord : dtrial){
+                        if(!text::parse(cursor, stop, coord)) break;
+                    }
+                    chunk.labels.push_back(label);
+                    chunk.displ.push_back(dtrial);
                 }
+            });
 
-            }while(!reading.eof());
+            for(const DisplsChunk & chunk : chunks){
+                m_labels.insert(m_labels.end(), chunk.labels.begin(), chunk.labels.end());
+                m_displ.insert(m_displ.end(), chunk.displ.begin(), chunk.displ.end());
+            }
 
             m_nDispl = m_displ.size();
 
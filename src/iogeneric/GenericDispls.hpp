@@ -81,6 +81,7 @@ namespace mimmo{
    |---------------|-------------------|-----------------------|
    | <B>PortType</B>   | <B>variable/function</B>  |<B>DataType</B> |
    | M_DISPLS      | getDispl          | (MC_VECARR3, MD_FLOAT)      |
+   | M_DISPLS32    | getDisplFloat32   | (MC_VECARR3, MD_FLOAT32)    |
    | M_VECTORLI    | getLabels         | (MC_VECTOR, MD_LONG)        |
    | M_VALUEI      | getNDispl         | (MC_SCALAR, MD_INT)         |
 
@@ -124,6 +125,7 @@ public:
 
     int         getNDispl();
     dvecarr3E   getDispl();
+    fvecarr3E   getDisplFloat32();
     livector1D  getLabels();
     bool        isTemplate();
 
@@ -144,6 +146,7 @@ public:
 
 protected:
     void swap(GenericDispls &) noexcept;
+    std::vector<std::string> getInputFiles();
 
 private:
     virtual void read();
@@ -152,6 +155,7 @@ private:
 };
 
 REGISTER_PORT(M_DISPLS, MC_VECARR3, MD_FLOAT,__GENERICDISPLS_HPP__)
+REGISTER_PORT(M_DISPLS32, MC_VECARR3, MD_FLOAT32,__GENERICDISPLS_HPP__)
 REGISTER_PORT(M_VECTORLI, MC_VECTOR, MD_LONG,__GENERICDISPLS_HPP__)
 REGISTER_PORT(M_VALUEI, MC_SCALAR, MD_INT,__GENERICDISPLS_HPP__)
 
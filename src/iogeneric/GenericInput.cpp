@@ -115,6 +115,17 @@ void GenericInput::swap(GenericInput & x) noexcept
     BaseManipulation::swap(x);
 }
 
+/*!
+ * Get the file read by the object, if it reads its values from file.
+ * \return path of the input file.
+ */
+std::vector<std::string>
+GenericInput::getInputFiles(){
+    std::vector<std::string> files;
+    if (m_readFromFile) files.push_back(m_dir+"/"+m_filename);
+    return files;
+}
+
 /*!
  * It sets if the object imports the displacements from an input file.
  * \param[in] readFromFile True if the object reads the values from file.
@@ -269,6 +280,7 @@ GenericInputMPVData::GenericInputMPVData(bool csv){
     m_name          = "mimmo.GenericInputMPVData";
     m_dir           = "./";
     m_binary        = false;
+    m_fieldname     = "";
 };
 
 /*!
@@ -283,6 +295,7 @@ GenericInputMPVData::GenericInputMPVData(const bitpit::Config::Section & rootXML
     m_dir       = "./";
     m_filename  = "input.txt";
     m_binary        = false;
+    m_fieldname     = "";
 
     std::string fallback_name = "ClassNONE";
     std::string input = rootXML.get("ClassName", fallback_name);
@@ -307,6 +320,7 @@ GenericInputMPVData::GenericInputMPVData(std::string dir, std::string filename,
     m_filename      = filename;
     m_name          = "mimmo.GenericInputMPVData";
     m_binary        = false;
+    m_fieldname     = "";
     m_portsType     = BaseManipulation::ConnectionType::BOTH;
 };
 
@@ -320,6 +334,7 @@ GenericInputMPVData::GenericInputMPVData(const GenericInputMPVData & other):Base
     m_dir           = other.m_dir;
     m_filename      = other.m_filename;
     m_binary        = other.m_binary;
+    m_fieldname     = other.m_fieldname;
 };
 
 /*!
@@ -340,10 +355,20 @@ void GenericInputMPVData::swap(GenericInputMPVData & x) noexcept
     std::swap(m_dir         , x.m_dir);
     std::swap(m_filename    , x.m_filename);
     std::swap(m_binary      , x.m_binary);
+    std::swap(m_fieldname   , x.m_fieldname);
     std::swap(m_result      , x.m_result);
     BaseManipulation::swap(x);
 }
 
+/*!
+ * Get the file read by the object.
+ * \return path of the input file.
+ */
+std::vector<std::string>
+GenericInputMPVData::getInputFiles(){
+    return std::vector<std::string>(1, m_dir+"/"+m_filename);
+}
+
 
 /*!It sets if the input file is in csv format.
  * \param[in] csv Is the input file write in comma separated value format?
@@ -361,6 +386,14 @@ GenericInputMPVData::setBinary(bool binary){
     m_binary = binary;
 };
 
+/*!It sets the name of the field to be read from a field container file.
+ * \param[in] fieldname Name of the field; if empty, the first field of the file is read.
+ */
+void
+GenericInputMPVData::setFieldName(std::string fieldname){
+    m_fieldname = fieldname;
+};
+
 /*!It sets the name of the input file.
  * \param[in] filename Name of the input file.
  */
@@ -387,11 +420,54 @@ GenericInputMPVData::buildPorts(){
     built = (built && createPortIn<MimmoSharedPointer<MimmoObject>, GenericInputMPVData>(this, &mimmo::GenericInputMPVData::setGeometry, M_GEOM));
     built = (built && createPortOut<dmpvector1D*, GenericInputMPVData>(this, &mimmo::GenericInputMPVData::getResult<double>, M_SCALARFIELD));
     built = (built && createPortOut<dmpvecarr3E*, GenericInputMPVData>(this, &mimmo::GenericInputMPVData::getResult<darray3E>, M_VECTORFIELD));
+    built = (built && createPortOut<fmpvector1D*, GenericInputMPVData>(this, &mimmo::GenericInputMPVData::getResult<float>, M_SCALARFIELD32));
+    built = (built && createPortOut<fmpvecarr3E*, GenericInputMPVData>(this, &mimmo::GenericInputMPVData::getResult<farray3E>, M_VECTORFIELD32));
 
 
     m_arePortsBuilt = built;
 }
 
+/*!
+ * Get the range of ids of the local reference geometry for a data location.
+ * The range is unbounded if the location is undefined or the structures of
+ * the location are not available.
+ * \param[in] location data location
+ * \param[out] idBegin lowest id of the range
+ * \param[out] idEnd highest id of the range plus one
+ */
+void
+GenericInputMPVData::getContainerIdRange(MPVLocation location, long & idBegin, long & idEnd){
+
+    idBegin = std::numeric_limits<long>::min();
+    idEnd = std::numeric_limits<long>::max();
+
+    MimmoSharedPointer<MimmoObject> refgeo = getGeometry();
+    std::vector<long> ids;
+    switch(location){
+    case MPVLocation::POINT:
+        ids = refgeo->getVertices().getIds(false);
+        break;
+    case MPVLocation::CELL:
+        ids = refgeo->getCells().getIds(false);
+        break;
+    case MPVLocation::INTERFACE:
+        if(refgeo->getInterfacesSyncStatus() != SyncStatus::SYNC) return;
+        ids = refgeo->getInterfaces().getIds(false);
+        break;
+    default:
+        return;
+    }
+
+    if(ids.empty()){
+        idBegin = 0;
+        idEnd = 0;
+        return;
+    }
+    auto range = std::minmax_element(ids.begin(), ids.end());
+    idBegin = *(range.first);
+    idEnd = *(range.second) + 1;
+}
+
 /*!It clear the result member of the object
  */
 void
@@ -454,6 +530,12 @@ GenericInputMPVData::absorbSectionXML(const bitpit::Config::Section & slotXML, s
         setBinary(temp);
     };
 
+    if(slotXML.hasOption("FieldName")){
+        std::string input = slotXML.get("FieldName");
+        input = bitpit::utils::string::trim(input);
+        setFieldName(input);
+    };
+
 }
 
 /*!
@@ -472,6 +554,9 @@ GenericInputMPVData::flushSectionXML(bitpit::Config::Section & slotXML, std::str
     slotXML.set("ReadDir", m_dir);
     slotXML.set("Filename", m_filename);
     slotXML.set("Binary", std::to_string((int)m_binary));
+    if(!m_fieldname.empty()){
+        slotXML.set("FieldName", m_fieldname);
+    }
 };
 
 }
@@ -27,6 +27,8 @@
 
 #include "BaseManipulation.hpp"
 #include "IOData.hpp"
+#include "FieldContainer.hpp"
+#include "mimmoTextParser.hpp"
 
 namespace mimmo{
 
@@ -54,6 +56,34 @@ namespace inputCSVStream{
 
 }
 
+/*!
+ * \brief Utilities to read records of MimmoPiercedVector data from ascii/CSV files,
+ * parsing the file in chunks concurrently.
+ * \ingroup iogeneric
+ */
+namespace inputTextStream{
+    /*!
+     * Trait marking the data types whose records can be parsed in chunks.
+     */
+    template<typename T>
+    struct isRecordParsable : text::isParsable<T>{};
+
+    /*!
+     * Trait marking the data types whose records can be parsed in chunks.
+     */
+    template<typename T, std::size_t d>
+    struct isRecordParsable<std::array<T,d>> : text::isParsable<T>{};
+
+    template<typename T>
+    bool    parseRecord(const char *& cursor, const char * end, bool csv, T &x);
+    template<typename T, std::size_t d>
+    bool    parseRecord(const char *& cursor, const char * end, bool csv, std::array<T,d> &x);
+    template<typename T>
+    bool    absorbMPV(const std::string & filename, bool csv, MimmoPiercedVector< T > &x, std::true_type);
+    template<typename T>
+    bool    absorbMPV(const std::string & filename, bool csv, MimmoPiercedVector< T > &x, std::false_type);
+}
+
 /*!
  * \class GenericInput
  * \ingroup iogeneric
@@ -168,6 +198,7 @@ public:
 
 protected:
     void swap(GenericInput & x) noexcept;
+    std::vector<std::string> getInputFiles();
 #if MIMMO_ENABLE_MPI
     template<typename T>
     void                sendReadDataToAllProcs(T & data);
@@ -212,6 +243,16 @@ private:
  * On MPI versions, GenericInputMPVData read data from file with proc rank 0, and send
  * all the data to all other procs.
  *
+ * Field container files written by GenericOutputMPVData (see fieldContainer namespace) are
+ * recognized automatically, regardless of CSV/Binary flags. The field to be read is chosen by
+ * name (the first field of the file if no name is set). Container files are read directly by
+ * every process: if a reference geometry is available, only the chunks overlapping the range of
+ * ids of the local partition are decoded. In serial runs, a warning is issued if the fingerprint
+ * stored with the field does not match the reference geometry.
+ *
+ * Linking the ports M_SCALARFIELD32/M_VECTORFIELD32, the field is read and stored in single
+ * precision, e.g. for output-only chains.
+ *
  * \n
  * Ports available in GenericInput Class :
  *
@@ -227,6 +268,8 @@ private:
  *     | <B>PortType</B>   | <B>variable/function</B>  |<B>DataType</B> |
  *     | M_SCALARFIELD | getResult         | (MC_SCALAR, MD_MPVECFLOAT_)     |
  *     | M_VECTORFIELD | getResult         | (MC_SCALAR, MD_MPVECARR3FLOAT_)    |
+ *     | M_SCALARFIELD32 | getResult       | (MC_SCALAR, MD_MPVECFLOAT32_)   |
+ *     | M_VECTORFIELD32 | getResult       | (MC_SCALAR, MD_MPVECARR3FLOAT32_) |
  *
  *    =========================================================
  * \n
@@ -241,6 +284,7 @@ private:
  * - <B>ReadDir</B>: path to your current file data;
  * - <B>Filename</B>: path to your current file data.
  * - <B>Binary</B>: 0/1 set read a BINARY file (default ASCII);
+ * - <B>FieldName</B>: name of the field to be read from a field container file (default the first one);
  *
  */
 class GenericInputMPVData: public BaseManipulation{
@@ -252,6 +296,7 @@ private:
     std::unique_ptr<IOData>                m_result;        /**<Pointer to a base class object Result (derived class is template).*/
 
     bool            m_binary;       /**<Input binary files (used only for MimmoPiercedVector structures).*/
+    std::string     m_fieldname;    /**<Name of the field to be read from a field container file. */
 
 public:
     GenericInputMPVData(bool csv = false);
@@ -273,6 +318,7 @@ public:
     void setReadDir(std::string dir);
     void setFilename(std::string filename);
     void setBinary(bool binary);
+    void setFieldName(std::string fieldname);
 
     void    clearResult();
 
@@ -283,6 +329,8 @@ public:
 
 protected:
     void swap(GenericInputMPVData & x) noexcept;
+    std::vector<std::string> getInputFiles();
+    void getContainerIdRange(MPVLocation location, long & idBegin, long & idEnd);
 #if MIMMO_ENABLE_MPI
     template<typename T>
     void sendReadDataToAllProcs(MimmoPiercedVector<T> & data);
@@ -296,6 +344,8 @@ private:
     void                             _setResult(MimmoPiercedVector< T >*);
     template<typename T>
     void                             _setResult(MimmoPiercedVector< T >&);
+    template<typename T>
+    void                             readContainer(const std::string & path, MimmoPiercedVector< T > & data);
 
 
 };
@@ -312,6 +362,8 @@ REGISTER_PORT(M_VALUEB, MC_SCALAR, MD_BOOL,__INPUTDOF_HPP__)
 REGISTER_PORT(M_DEG, MC_ARRAY3, MD_INT,__INPUTDOF_HPP__)
 REGISTER_PORT(M_VECTORFIELD, MC_SCALAR, MD_MPVECARR3FLOAT_,__INPUTDOF_HPP__)
 REGISTER_PORT(M_SCALARFIELD, MC_SCALAR, MD_MPVECFLOAT_,__INPUTDOF_HPP__)
+REGISTER_PORT(M_VECTORFIELD32, MC_SCALAR, MD_MPVECARR3FLOAT32_,__INPUTDOF_HPP__)
+REGISTER_PORT(M_SCALARFIELD32, MC_SCALAR, MD_MPVECFLOAT32_,__INPUTDOF_HPP__)
 REGISTER_PORT(M_GEOM, MC_SCALAR, MD_MIMMO_ ,__INPUTDOF_HPP__)
 
 REGISTER(BaseManipulation, GenericInput, "mimmo.GenericInput")
@@ -195,6 +195,139 @@ std::fstream&  ifstreamcsv(std::fstream &in, MimmoPiercedVector< std::array< T,d
 }
 
 
+}
+
+namespace inputTextStream{
+
+/*!
+ * Parse the value of a record.
+ * \param[in,out] cursor position in the text, moved past the value
+ * \param[in] end end of the text
+ * \param[in] csv true if the values are separated by delimiters
+ * \param[out] x value read
+ * \return true if the value is parsed.
+ */
+template<typename T>
+bool
+parseRecord(const char *& cursor, const char * end, bool csv, T &x){
+    BITPIT_UNUSED(csv);
+    return text::parse(cursor, end, x);
+}
+
+/*!
+ * Parse the array value of a record.
+ * \param[in,out] cursor position in the text, moved past the value
+ * \param[in] end end of the text
+ * \param[in] csv true if the values are separated by delimiters
+ * \param[out] x array value read
+ * \return true if the value is parsed.
+ */
+template<typename T, std::size_t d>
+bool
+parseRecord(const char *& cursor, const char * end, bool csv, std::array<T,d> &x){
+    for(std::size_t i = 0; i < d; ++i){
+        if(csv && i > 0 && !text::skipDelimiter(cursor, end, ',')) text::skipDelimiter(cursor, end, ';');
+        if(!text::parse(cursor, end, x[i])) return false;
+    }
+    return true;
+}
+
+/*!
+ * Records of a chunk of a MimmoPiercedVector file.
+ */
+template<typename T>
+struct MPVChunk{
+    std::vector<long>   ids;    /**< ids of the records */
+    std::vector<T>      values; /**< values of the records */
+};
+
+/*!
+ * Read a MimmoPiercedVector written in ascii or CSV format, i.e. name, location and
+ * number of records, followed by one record (id and value) per line. The records
+ * are parsed in chunks of lines, concurrently.
+ * \param[in] filename path of the file
+ * \param[in] csv true if the values are separated by delimiters
+ * \param[out] x MimmoPiercedVector data read
+ * \return false if the file cannot be opened.
+ */
+template<typename T>
+bool
+absorbMPV(const std::string & filename, bool csv, MimmoPiercedVector< T > &x, std::true_type){
+
+    text::FileBuffer file(filename);
+    if(!file.isOpen()) return false;
+
+    const char * cursor = file.begin();
+    const char * end = file.end();
+    const char * tokenBegin = nullptr;
+    const char * tokenEnd = nullptr;
+    int location = 0;
+    long sizeData = 0;
+
+    // header tokens may be placed on one or several lines
+    auto nextHeaderToken = [&cursor, end, &tokenBegin, &tokenEnd](){
+        while(cursor < end && !text::nextToken(cursor, text::lineEnd(cursor, end), tokenBegin, tokenEnd)){
+            cursor = text::nextLine(cursor, end);
+        }
+        return cursor < end || tokenEnd > tokenBegin;
+    };
+    if(nextHeaderToken()){
+        x.setName(std::string(tokenBegin, tokenEnd));
+    }
+    if(nextHeaderToken()){
+        const char * value = tokenBegin;
+        if(text::parse(value, tokenEnd, location)){
+            if(csv){
+                if(x.intIsValidLocation(location)) x.setDataLocation(static_cast<MPVLocation>(location));
+            }else{
+                x.setDataLocation(location);
+            }
+        }
+    }
+    if(nextHeaderToken()){
+        const char * value = tokenBegin;
+        if(!text::parse(value, tokenEnd, sizeData) || sizeData < 0) sizeData = 0;
+    }
+    cursor = text::nextLine(cursor, end);
+
+    std::vector<MPVChunk<T>> chunks = text::parseChunks<MPVChunk<T>>(cursor, end,
+                                                                     [csv](const char * chunkBegin, const char * chunkEnd, MPVChunk<T> & chunk){
+        long id;
+        T value;
+        for(const char * line = chunkBegin; line < chunkEnd; line = text::nextLine(line, chunkEnd)){
+            const char * field = line;
+            const char * stop = text::lineEnd(line, chunkEnd);
+            if(!text::parse(field, stop, id)) continue;
+            if(csv && !text::skipDelimiter(field, stop, ',')) text::skipDelimiter(field, stop, ';');
+            if(!parseRecord(field, stop, csv, value)) continue;
+            chunk.ids.push_back(id);
+            chunk.values.push_back(value);
+        }
+    });
+
+    x.reserve(sizeData);
+    long count = 0;
+    for(const MPVChunk<T> & chunk : chunks){
+        for(std::size_t i = 0; i < chunk.ids.size() && count < sizeData; ++i, ++count){
+            x.insert(chunk.ids[i], chunk.values[i]);
+        }
+    }
+    return true;
+}
+
+/*!
+ * Fallback for data types whose records cannot be parsed in chunks.
+ * \return false, the data has to be read with the stream based readers.
+ */
+template<typename T>
+bool
+absorbMPV(const std::string & filename, bool csv, MimmoPiercedVector< T > &x, std::false_type){
+    BITPIT_UNUSED(filename);
+    BITPIT_UNUSED(csv);
+    BITPIT_UNUSED(x);
+    return false;
+}
+
 }
 
 ///GENERICINPUT////////////////////////////////////////////////////////////////////////////
@@ -209,6 +342,7 @@ void
 GenericInput::setInput(T* data){
     _setInput(data);
     _setResult(data);
+    markDirty();
 }
 
 /*!
@@ -221,6 +355,7 @@ void
 GenericInput::setInput(T& data){
     _setInput(data);
     _setResult(data);
+    markDirty();
 }
 
 /*!
@@ -440,8 +575,21 @@ GenericInputMPVData::_getResult(){
     MimmoPiercedVector< T > data;
     MimmoSharedPointer<MimmoObject> refgeo = getGeometry();
 
+    std::string path = m_dir+"/"+m_filename;
+    bool container = fieldContainer::isContainerFile(path);
 #if MIMMO_ENABLE_MPI
-    if(getRank() == 0)
+    MPI_Bcast(&container, 1, MPI_C_BOOL, 0, m_communicator);
+#endif
+
+    // field containers are read by every process on its own
+    if(container){
+        readContainer(path, data);
+    }
+
+#if MIMMO_ENABLE_MPI
+    if(!container && getRank() == 0)
+#else
+    if(!container)
 #endif
     {
     	std::string name;
@@ -452,9 +600,13 @@ GenericInputMPVData::_getResult(){
 
         if(m_csv)   m_binary = false;
 
+        // ascii and CSV records of numeric data are parsed in chunks, concurrently
+        bool parsed = !m_binary && inputTextStream::absorbMPV(m_dir+"/"+m_filename, m_csv, data,
+                                                             std::integral_constant<bool, inputTextStream::isRecordParsable<T>::value>());
+
         std::fstream file;
-        file.open(m_dir+"/"+m_filename, std::fstream::in);
-        if (file.is_open()){
+        if (!parsed) file.open(m_dir+"/"+m_filename, std::fstream::in);
+        if (!parsed && file.is_open()){
             if (m_binary){
             	std::size_t length;
                 bitpit::genericIO::absorbBINARY(file, length);
@@ -491,7 +643,7 @@ GenericInputMPVData::_getResult(){
                 data.setName(name);
             }
             file.close();
-        }else{
+        }else if (!parsed){
             (*m_log) << "file not open --> exit" << std::endl;
             throw std::runtime_error (m_name + " : cannot open " + m_filename + " requested");
         }
@@ -499,7 +651,7 @@ GenericInputMPVData::_getResult(){
 
 #if MIMMO_ENABLE_MPI
     //if there are any other procs send data to them.
-    if(m_nprocs > 1)    sendReadDataToAllProcs(data);
+    if(!container && m_nprocs > 1)    sendReadDataToAllProcs(data);
 #endif
 
     if(refgeo == nullptr){
@@ -514,6 +666,51 @@ GenericInputMPVData::_getResult(){
 }
 
 
+/*!
+ * Read the data field from a field container file. If a reference geometry is available,
+ * only the entries in the range of ids of the local geometry are read.
+ * \param[in] path path to the container file
+ * \param[out] data data field read
+ */
+template<typename T>
+void
+GenericInputMPVData::readContainer(const std::string & path, MimmoPiercedVector<T> & data){
+
+    fieldContainer::Reader reader(path);
+    const fieldContainer::FieldInfo * field = nullptr;
+    if(m_fieldname.empty()){
+        field = reader.getFieldInfo(std::size_t(0));
+    }else{
+        field = reader.getFieldInfo(m_fieldname);
+    }
+    if(field == nullptr){
+        (*m_log) << "field " << m_fieldname << " not found --> exit" << std::endl;
+        throw std::runtime_error (m_name + " : cannot find field " + m_fieldname + " in " + m_filename);
+    }
+
+    long idBegin = std::numeric_limits<long>::min();
+    long idEnd = std::numeric_limits<long>::max();
+    MimmoSharedPointer<MimmoObject> refgeo = getGeometry();
+    if(refgeo != nullptr){
+        getContainerIdRange(field->location, idBegin, idEnd);
+#if MIMMO_ENABLE_MPI
+        if(m_nprocs == 1)
+#endif
+        {
+            std::uint64_t fingerprint = fieldContainer::computeGeometryFingerprint(refgeo, field->location);
+            if(field->fingerprint != 0 && fingerprint != 0 && field->fingerprint != fingerprint){
+                (*m_log) << "WARNING " << m_name << " : field " << field->name << " in " << m_filename
+                         << " was written for a different geometry" << std::endl;
+            }
+        }
+    }
+
+    if(!reader.read(*field, data, idBegin, idEnd)){
+        (*m_log) << "field " << field->name << " not readable --> exit" << std::endl;
+        throw std::runtime_error (m_name + " : cannot read field " + field->name + " from " + m_filename);
+    }
+}
+
 #if MIMMO_ENABLE_MPI
 /*!
  * For reading part only. Since we assume the 0 rank proc read from file,
@@ -234,6 +234,9 @@ GenericOutputMPVData::GenericOutputMPVData(std::string dir, std::string filename
     m_portsType    = ConnectionType::BACKWARD;
     m_name         = "mimmo.GenericOutputMPVData";
     m_binary        = false;
+    m_container     = false;
+    m_append        = false;
+    m_float32       = false;
 };
 
 /*!
@@ -248,6 +251,9 @@ GenericOutputMPVData::GenericOutputMPVData(const bitpit::Config::Section & rootX
     m_name         = "mimmo.GenericOutputMPVData";
     m_csv       = false;
     m_binary        = false;
+    m_container     = false;
+    m_append        = false;
+    m_float32       = false;
 
     std::string fallback_name = "ClassNONE";
     std::string input = rootXML.get("ClassName", fallback_name);
@@ -272,6 +278,9 @@ GenericOutputMPVData::GenericOutputMPVData(const GenericOutputMPVData & other):B
     m_filename      = other.m_filename;
     m_csv           = other.m_csv;
     m_binary        = other.m_binary;
+    m_container     = other.m_container;
+    m_append        = other.m_append;
+    m_float32       = other.m_float32;
 };
 
 /*!
@@ -292,6 +301,9 @@ void GenericOutputMPVData::swap(GenericOutputMPVData & x) noexcept
     std::swap(m_filename, x.m_filename);
     std::swap(m_csv, x.m_csv);
     std::swap(m_binary, x.m_binary);
+    std::swap(m_container, x.m_container);
+    std::swap(m_append, x.m_append);
+    std::swap(m_float32, x.m_float32);
     std::swap(m_input, x.m_input);
     BaseManipulation::swap(x);
 }
@@ -305,6 +317,8 @@ GenericOutputMPVData::buildPorts(){
     bool built = true;
     built = (built && createPortIn<dmpvector1D*, GenericOutputMPVData>(this, &mimmo::GenericOutputMPVData::setInput<double>, M_SCALARFIELD));
     built = (built && createPortIn<dmpvecarr3E*, GenericOutputMPVData>(this, &mimmo::GenericOutputMPVData::setInput<darray3E>, M_VECTORFIELD));
+    built = (built && createPortIn<fmpvector1D*, GenericOutputMPVData>(this, &mimmo::GenericOutputMPVData::setInput<float>, M_SCALARFIELD32));
+    built = (built && createPortIn<fmpvecarr3E*, GenericOutputMPVData>(this, &mimmo::GenericOutputMPVData::setInput<farray3E>, M_VECTORFIELD32));
 
     m_arePortsBuilt = built;
 }
@@ -344,6 +358,33 @@ GenericOutputMPVData::setBinary(bool binary){
     m_binary = binary;
 };
 
+/*!It sets if the output file is a field container.
+ * \param[in] container Write the output file as a field container?
+ */
+void
+GenericOutputMPVData::setContainer(bool container){
+    m_container = container;
+};
+
+/*!It sets if the field has to be appended to an existing field container file.
+ * If the file is not a valid field container, it is overwritten.
+ * \param[in] append Append the field to the field container file?
+ */
+void
+GenericOutputMPVData::setAppend(bool append){
+    m_append = append;
+};
+
+/*!It sets if the values of a field container are stored in single precision.
+ * Data are converted to single precision when written, or when copied for
+ * asynchronous output.
+ * \param[in] float32 Store the values in single precision?
+ */
+void
+GenericOutputMPVData::setFloat32(bool float32){
+    m_float32 = float32;
+};
+
 
 /*!
  * It clear the input member of the object
@@ -412,6 +453,39 @@ GenericOutputMPVData::absorbSectionXML(const bitpit::Config::Section & slotXML,
         }
         setBinary(temp);
     };
+
+    if(slotXML.hasOption("Container")){
+        std::string input = slotXML.get("Container");
+        input = bitpit::utils::string::trim(input);
+        bool temp = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss>>temp;
+        }
+        setContainer(temp);
+    };
+
+    if(slotXML.hasOption("Append")){
+        std::string input = slotXML.get("Append");
+        input = bitpit::utils::string::trim(input);
+        bool temp = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss>>temp;
+        }
+        setAppend(temp);
+    };
+
+    if(slotXML.hasOption("Float32")){
+        std::string input = slotXML.get("Float32");
+        input = bitpit::utils::string::trim(input);
+        bool temp = false;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss>>temp;
+        }
+        setFloat32(temp);
+    };
 }
 
 /*!
@@ -430,6 +504,9 @@ GenericOutputMPVData::flushSectionXML(bitpit::Config::Section & slotXML, std::st
     slotXML.set("WriteDir", m_dir);
     slotXML.set("CSV", std::to_string((int)m_csv));
     slotXML.set("Binary", std::to_string((int)m_binary));
+    slotXML.set("Container", std::to_string((int)m_container));
+    slotXML.set("Append", std::to_string((int)m_append));
+    slotXML.set("Float32", std::to_string((int)m_float32));
 };
 
 
@@ -26,6 +26,7 @@
 
 #include "BaseManipulation.hpp"
 #include "IOData.hpp"
+#include "FieldContainer.hpp"
 
 namespace mimmo{
 
@@ -166,6 +167,14 @@ private:
  * to build link (pin) with an other object.
  * Can write binary data in raw format only, activating the binary flag.
  *
+ * Activating the container flag, data are written as a field container (see fieldContainer
+ * namespace), a chunked binary format indexed by id that GenericInputMPVData recognizes
+ * automatically. Values can be stored in single precision, and more fields can be appended to
+ * the same container file. In serial runs the field is marked with the fingerprint of its
+ * geometry.
+ * Single precision fields (ports M_SCALARFIELD32/M_VECTORFIELD32) are written as they are,
+ * without any conversion to double precision.
+ *
  * On distributed archs, only the 0 rank procs is deputed to writing.
  * \n
  * Ports available in GenericOutputMPVData Class :
@@ -177,6 +186,8 @@ private:
  *  | <B>PortType</B>   | <B>variable/function</B>  |<B>DataType</B> |
  *  | M_SCALARFIELD | setInput       | (MC_SCALAR, MD_MPVECFLOAT_)    |
  *  | M_VECTORFIELD | setInput       | (MC_SCALAR, MD_MPVECARR3FLOAT_)   |
+ *  | M_SCALARFIELD32 | setInput     | (MC_SCALAR, MD_MPVECFLOAT32_)  |
+ *  | M_VECTORFIELD32 | setInput     | (MC_SCALAR, MD_MPVECARR3FLOAT32_) |
  *
  *
  *  |              Port Output  ||              |
@@ -198,7 +209,14 @@ private:
  * - <B>WriteDir</B>: name of directory to write data;
  * - <B>CSV</B>: true if write in csv format;
  * - <B>Binary</B>: 0/1 set write a BINARY file (default ASCII).If CSV, only ASCII is available;
+ * - <B>Container</B>: 0/1 write a field container file (overrides CSV and Binary);
+ * - <B>Append</B>: 0/1 append the field to an existing field container file;
+ * - <B>Float32</B>: 0/1 store the values of a field container in single precision;
  *
+ * With asynchronous output and single precision field containers, the copy of the field
+ * written in background is kept in single precision too.
+ * Field containers written in single precision are read back in double precision by
+ * GenericInputMPVData.
  */
 class GenericOutputMPVData: public BaseManipulation{
 private:
@@ -210,6 +228,9 @@ private:
     std::unique_ptr<IOData> m_input;        /**<Pointer to a base class object Input, meant for input temporary data, cleanable in execution (derived class is template).*/
 
     bool            m_binary;       /**<Output unformatted binary files.*/
+    bool            m_container;    /**<Output field container files.*/
+    bool            m_append;       /**<Append fields to an existing field container file.*/
+    bool            m_float32;      /**<Store field container values in single precision.*/
 
 public:
     GenericOutputMPVData(std::string dir = "./", std::string filename = "output.txt", bool csv = false);
@@ -236,6 +257,9 @@ public:
     void setFilename(std::string filename);
     void setCSV(bool csv);
     void setBinary(bool binary);
+    void setContainer(bool container);
+    void setAppend(bool append);
+    void setFloat32(bool float32);
 
     void    execute();
 
@@ -260,6 +284,8 @@ REGISTER_PORT(M_DISPLS, MC_VECARR3, MD_FLOAT,__OUTPUTDOF_HPP__)
 REGISTER_PORT(M_DATAFIELD, MC_VECTOR, MD_FLOAT,__OUTPUTDOF_HPP__)
 REGISTER_PORT(M_VECTORFIELD, MC_SCALAR, MD_MPVECARR3FLOAT_,__OUTPUTDOF_HPP__)
 REGISTER_PORT(M_SCALARFIELD, MC_SCALAR, MD_MPVECFLOAT_,__OUTPUTDOF_HPP__)
+REGISTER_PORT(M_VECTORFIELD32, MC_SCALAR, MD_MPVECARR3FLOAT32_,__OUTPUTDOF_HPP__)
+REGISTER_PORT(M_SCALARFIELD32, MC_SCALAR, MD_MPVECFLOAT32_,__OUTPUTDOF_HPP__)
 REGISTER_PORT(M_POINT, MC_ARRAY3, MD_FLOAT,__OUTPUTDOF_HPP__)
 REGISTER_PORT(M_SPAN, MC_ARRAY3, MD_FLOAT,__OUTPUTDOF_HPP__)
 REGISTER_PORT(M_DIMENSION, MC_ARRAY3, MD_INT,__OUTPUTDOF_HPP__)
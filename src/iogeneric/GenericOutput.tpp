@@ -169,20 +169,33 @@ template<typename T>
 void
 GenericOutput::setInput(T* data){
     _setInput(*data);
-    std::fstream file;
 #if MIMMO_ENABLE_MPI
     if(getRank() == 0)
 #endif
     {
-        file.open(m_dir+"/"+m_filename, std::fstream::out);
-        if (file.is_open()){
-            if (m_csv){
-                outputCSVStream::ofstreamcsv(file, *data);
-            }
-            else{
-                file << *data;
+        std::string filename = m_dir+"/"+m_filename;
+        bool csv = m_csv;
+        auto writeFile = [filename, csv](T & values){
+            std::fstream file;
+            file.open(filename, std::fstream::out);
+            if (file.is_open()){
+                if (csv){
+                    outputCSVStream::ofstreamcsv(file, values);
+                }
+                else{
+                    file << values;
+                }
+                file.close();
             }
-            file.close();
+        };
+        if (isAsyncOutput()){
+            //copy of the data, written in background
+            std::shared_ptr<T> snapshot = std::make_shared<T>(*data);
+            submitAsyncOutput([writeFile, snapshot](){
+                writeFile(*snapshot);
+            });
+        }else{
+            writeFile(*data);
         }
     }
 }
@@ -230,6 +243,13 @@ GenericOutputMPVData::setInput(MimmoPiercedVector< T > * data){
     std::string name = data->getName();
     int loc = static_cast<int>(data->getDataLocation());
     MimmoPiercedVector<T> * workingptr_ = data;
+    std::uint64_t fingerprint = 0;
+#if MIMMO_ENABLE_MPI
+    if(m_nprocs == 1)
+#endif
+    {
+        if(m_container) fingerprint = fieldContainer::computeGeometryFingerprint(data->getGeometry(), data->getConstDataLocation());
+    }
 
 #if MIMMO_ENABLE_MPI
     std::unique_ptr< MimmoPiercedVector<T> > dataglobal(new MimmoPiercedVector<T>());
@@ -239,37 +259,80 @@ GenericOutputMPVData::setInput(MimmoPiercedVector< T > * data){
     if(getRank() == 0)
 #endif
     {
-        std::fstream file;
-        file.open(m_dir+"/"+m_filename, std::fstream::out);
-        if (file.is_open()){
-            if(m_binary){
-            	std::size_t length = name.length();
-                bitpit::genericIO::flushBINARY(file, length);
-                for (std::size_t i=0; i<length; i++){
-                	char a = name.at(i);
-                	bitpit::genericIO::flushBINARY(file, a);
-                }
-                bitpit::genericIO::flushBINARY(file, loc);
-                bitpit::genericIO::flushBINARY(file, long(workingptr_->size()));
-                for (auto datait = workingptr_->begin(); datait != workingptr_->end(); ++datait) {
-                    bitpit::genericIO::flushBINARY(file, datait.getId());
-                    bitpit::genericIO::flushBINARY(file, *datait);
+        std::string filename = m_dir+"/"+m_filename;
+        bool binary = m_binary;
+        bool csv = m_csv;
+        bool container = m_container;
+        bool append = m_append;
+        fieldContainer::DataType dtype = m_float32 ? fieldContainer::DataType::FLOAT32 : fieldContainer::DataType::FLOAT64;
+        auto writeFile = [filename, binary, csv, container, append, dtype, fingerprint, name, loc](MimmoPiercedVector<T> & values){
+            if(container){
+                fieldContainer::Writer writer;
+                if(writer.open(filename, append)){
+                    writer.write(values, dtype, fingerprint);
+                    writer.close();
                 }
-            } else if (m_csv){
-                outputCSVStream::ofstreamcsv(file, *workingptr_);
-            }else{
-                bitpit::genericIO::flushASCII(file, name);
-                bitpit::genericIO::flushASCII(file,loc);
-                file<<'\n';
-                bitpit::genericIO::flushASCII(file,long(workingptr_->size()));
-                file<<'\n';
-                for (auto datait = workingptr_->begin(); datait != workingptr_->end(); ++datait) {
-                    bitpit::genericIO::flushASCII(file, datait.getId());
-                    bitpit::genericIO::flushASCII(file, *datait);
+                return;
+            }
+            std::fstream file;
+            file.open(filename, std::fstream::out);
+            if (file.is_open()){
+                if(binary){
+                    std::size_t length = name.length();
+                    bitpit::genericIO::flushBINARY(file, length);
+                    for (std::size_t i=0; i<length; i++){
+                        char a = name.at(i);
+                        bitpit::genericIO::flushBINARY(file, a);
+                    }
+                    bitpit::genericIO::flushBINARY(file, loc);
+                    bitpit::genericIO::flushBINARY(file, long(values.size()));
+                    for (auto datait = values.begin(); datait != values.end(); ++datait) {
+                        bitpit::genericIO::flushBINARY(file, datait.getId());
+                        bitpit::genericIO::flushBINARY(file, *datait);
+                    }
+                } else if (csv){
+                    outputCSVStream::ofstreamcsv(file, values);
+                }else{
+                    bitpit::genericIO::flushASCII(file, name);
+                    bitpit::genericIO::flushASCII(file,loc);
                     file<<'\n';
+                    bitpit::genericIO::flushASCII(file,long(values.size()));
+                    file<<'\n';
+                    for (auto datait = values.begin(); datait != values.end(); ++datait) {
+                        bitpit::genericIO::flushASCII(file, datait.getId());
+                        bitpit::genericIO::flushASCII(file, *datait);
+                        file<<'\n';
+                    }
+                }
+                file.close();
+            }
+        };
+        typedef typename MPVPrecision<T>::float32_type float32_t;
+        if (isAsyncOutput() && container && m_float32 && !std::is_same<float32_t, T>::value){
+            //single precision copy of the data not linked to the geometry, written in background:
+            //values are stored in single precision anyway.
+            std::shared_ptr<MimmoPiercedVector<float32_t>> snapshot = std::make_shared<MimmoPiercedVector<float32_t>>(toFloat32(*workingptr_));
+            snapshot->setGeometry(nullptr);
+            submitAsyncOutput([filename, append, dtype, fingerprint, snapshot](){
+                fieldContainer::Writer writer;
+                if(writer.open(filename, append)){
+                    writer.write(*snapshot, dtype, fingerprint);
+                    writer.close();
                 }
+            });
+        }else if (isAsyncOutput()){
+            //copy of the data not linked to the geometry, written in background
+            std::shared_ptr<MimmoPiercedVector<T>> snapshot = std::make_shared<MimmoPiercedVector<T>>();
+            snapshot->setName(name);
+            snapshot->setDataLocation(workingptr_->getDataLocation());
+            for (auto datait = workingptr_->begin(); datait != workingptr_->end(); ++datait) {
+                snapshot->insert(datait.getId(), *datait);
             }
-            file.close();
+            submitAsyncOutput([writeFile, snapshot](){
+                writeFile(*snapshot);
+            });
+        }else{
+            writeFile(*workingptr_);
         }
     }// exiting scope writing.
 }
@@ -23,6 +23,7 @@
 \*---------------------------------------------------------------------------*/
 
 #include "IOCloudPoints.hpp"
+#include "mimmoTextParser.hpp"
 
 namespace mimmo {
 
@@ -104,6 +105,17 @@ void IOCloudPoints::swap(IOCloudPoints & x) noexcept
     BaseManipulation::swap(x);
 }
 
+/*!
+ * Get the file read by the object, if it is in read mode.
+ * \return path of the input file.
+ */
+std::vector<std::string>
+IOCloudPoints::getInputFiles(){
+    std::vector<std::string> files;
+    if (m_read) files.push_back(m_dir+"/"+m_filename);
+    return files;
+}
+
 /*!
  * It builds the input/output ports of the object
  */
@@ -385,7 +397,17 @@ IOCloudPoints::plotOptionalResults(){
 }
 
 /*!
- * Read displacement data from file
+ * Records of a chunk of a cloud points file.
+ */
+struct CloudChunk{
+    livector1D labels;                                  /**< labels of the points */
+    dvecarr3E points;                                   /**< coordinates of the points */
+    std::vector<std::pair<long, double>> scalars;       /**< scalar field records */
+    std::vector<std::pair<long, darray3E>> vectors;     /**< vector field records */
+};
+
+/*!
+ * Read displacement data from file. The file is parsed in chunks, concurrently.
  */
 void
 IOCloudPoints::read(){
@@ -404,77 +426,82 @@ IOCloudPoints::read(){
 #endif
     {
 
-        std::unordered_map<long, int> mapP;
-        std::ifstream reading;
         std::string source = m_dir+"/"+m_filename;
-        reading.open(source.c_str());
-        if(reading.is_open()){
+        text::FileBuffer reading(source);
+        if(!reading.isOpen()){
+            (*m_log)<<"error of "<<m_name<<" : cannot open "<<m_filename<< " requested. Exiting... "<<std::endl;
+            throw std::runtime_error (m_name + " : cannot open " + m_filename + " requested. Exiting... ");
+        }
 
-            std::string keyword, line;
+        // Parse the file in line-aligned chunks, concurrently
+        std::vector<CloudChunk> chunks = text::parseChunks<CloudChunk>(reading.begin(), reading.end(),
+                                                                       [](const char * begin, const char * end, CloudChunk & chunk){
             long label;
             darray3E dtrial;
             double temp;
-
-            do{
-                line.clear();
-                keyword.clear();
-                std::getline(reading,line);
-                line = bitpit::utils::string::trim(line);
-                std::stringstream ss(line);
-                ss>>keyword;
-                keyword = bitpit::utils::string::trim(keyword);
-                if(keyword == "$POINT")    {
-
-                    ss>>label;
-                    m_labels.push_back(label);
-
+            for(const char * line = begin; line < end; line = text::nextLine(line, end)){
+                const char * cursor = line;
+                const char * stop = text::lineEnd(line, end);
+                const char * keyBegin;
+                const char * keyEnd;
+                if(!text::nextToken(cursor, stop, keyBegin, keyEnd)) continue;
+
+                if(text::equals(keyBegin, keyEnd, "$POINT")){
+                    if(!text::parse(cursor, stop, label)) continue;
                     dtrial.fill(0.0);
-                    ss>>dtrial[0]>>dtrial[1]>>dtrial[2];
-                    m_points.push_back(dtrial);
+                    for(double & coord : dtrial){
+                        if(!text::parse(cursor, stop, coord)) break;
+                    }
+                    chunk.labels.push_back(label);
+                    chunk.points.push_back(dtrial);
                 }
-
-            }while(!reading.eof());
-
-            int counter = 0;
-            for(auto &lab :m_labels){
-                mapP[lab] = counter;
-                ++counter;
-            }
-
-            m_scalarfield.reserve(m_points.size());
-            m_vectorfield.reserve(m_points.size());
-
-            reading.clear();
-            reading.seekg(0, std::ios::beg);
-
-            do{
-                line.clear();
-                keyword.clear();
-                std::getline(reading,line);
-                line = bitpit::utils::string::trim(line);
-                std::stringstream ss(line);
-                ss>>keyword;
-                keyword = bitpit::utils::string::trim(keyword);
-                if(keyword == "$SCALARF")    {
-
-                    ss>>label>>temp;
-                    m_scalarfield.insert(mapP[label],temp);
+                else if(text::equals(keyBegin, keyEnd, "$SCALARF")){
+                    if(!text::parse(cursor, stop, label)) continue;
+                    temp = 0.0;
+                    text::parse(cursor, stop, temp);
+                    chunk.scalars.emplace_back(label, temp);
                 }
-                if(keyword == "$VECTORF")    {
-
+                else if(text::equals(keyBegin, keyEnd, "$VECTORF")){
+                    if(!text::parse(cursor, stop, label)) continue;
                     dtrial.fill(0.0);
-                    ss>>label>>dtrial[0]>>dtrial[1]>>dtrial[2];
-                    m_vectorfield.insert(mapP[label],dtrial);
+                    for(double & coord : dtrial){
+                        if(!text::parse(cursor, stop, coord)) break;
+                    }
+                    chunk.vectors.emplace_back(label, dtrial);
                 }
+            }
+        });
+        reading.close();
 
-            }while(!reading.eof());
+        std::size_t nPoints = 0;
+        for(const CloudChunk & chunk : chunks){
+            nPoints += chunk.points.size();
+        }
+        m_labels.reserve(nPoints);
+        m_points.reserve(nPoints);
+        for(const CloudChunk & chunk : chunks){
+            m_labels.insert(m_labels.end(), chunk.labels.begin(), chunk.labels.end());
+            m_points.insert(m_points.end(), chunk.points.begin(), chunk.points.end());
+        }
 
-        }else{
-            (*m_log)<<"error of "<<m_name<<" : cannot open "<<m_filename<< " requested. Exiting... "<<std::endl;
-            throw std::runtime_error (m_name + " : cannot open " + m_filename + " requested. Exiting... ");
+        std::unordered_map<long, int> mapP;
+        mapP.reserve(m_labels.size());
+        int counter = 0;
+        for(auto &lab :m_labels){
+            mapP[lab] = counter;
+            ++counter;
         }
 
-        reading.close();
+        m_scalarfield.reserve(m_points.size());
+        m_vectorfield.reserve(m_points.size());
+        for(const CloudChunk & chunk : chunks){
+            for(const auto & scalar : chunk.scalars){
+                m_scalarfield.insert(mapP[scalar.first], scalar.second);
+            }
+            for(const auto & vector : chunk.vectors){
+                m_vectorfield.insert(mapP[vector.first], vector.second);
+            }
+        }
 
     }
 
@@ -529,9 +556,37 @@ IOCloudPoints::write(){
         filename = m_filename;
     }
 
-    std::ofstream writing;
     std::string source = m_dir+"/"+m_filename;
-    std::string keyT1 = "{", keyT2 = "}";
+
+    //snapshot of the points and fields, as written on file
+    std::shared_ptr<CloudData> data = std::make_shared<CloudData>();
+    {
+        MimmoSharedPointer<MimmoObject> geometry = getGeometry();
+        data->isTemplate = m_template;
+        data->ids = geometry->getVerticesIds();
+        data->coords.reserve(data->ids.size());
+        for(const long & label : data->ids){
+            data->coords.push_back(geometry->getVertexCoords(label));
+            if(m_template) continue;
+            if(m_scalarfield.exists(label)) data->scalars.emplace_back(label, m_scalarfield[label]);
+            if(m_vectorfield.exists(label)) data->vectors.emplace_back(label, m_vectorfield[label]);
+        }
+    }
+
+    if(isAsyncOutput()){
+        std::string name = m_name;
+        std::string filenameW = m_filename;
+        submitAsyncOutput([data, source, name, filenameW](){
+            std::ofstream writing(source.c_str());
+            if(!writing.is_open()){
+                throw std::runtime_error (name + " : cannot open " + filenameW + " requested. Exiting... ");
+            }
+            writeCloud(writing, *data);
+        });
+        return;
+    }
+
+    std::ofstream writing;
 
 #if MIMMO_ENABLE_MPI
     // Write on the file in a sequential way
@@ -548,41 +603,7 @@ IOCloudPoints::write(){
 #endif
 
             if(writing.is_open()){
-
-                MimmoSharedPointer<MimmoObject> geometry = getGeometry();
-                darray3E coords;
-                for(const long & label : geometry->getVerticesIds()){
-                    coords = geometry->getVertexCoords(label);
-                    writing<<"$POINT"<<'\t'<<label<<'\t'<<coords[0]<<'\t'<<coords[1]<<'\t'<<coords[2]<<std::endl;
-                }
-                writing<<""<<std::endl;
-
-                for(const long & label : geometry->getVerticesIds()){
-                    if(m_template){
-                        std::string str1 = keyT1+"s"+std::to_string(label)+keyT2;
-                        writing<<"$SCALARF"<<'\t'<<label<<'\t'<<str1<<std::endl;
-                    }else{
-                        if(!m_scalarfield.exists(label)) continue;
-                        double val = m_scalarfield[label];
-                        writing<<"$SCALARF"<<'\t'<<label<<'\t'<<val<<std::endl;
-                    }
-                }
-                writing<<""<<std::endl;
-
-                for(const long & label : geometry->getVerticesIds()){
-                    if(m_template){
-                        std::string str1 = keyT1+"x"+std::to_string(label)+keyT2;
-                        std::string str2 = keyT1+"y"+std::to_string(label)+keyT2;
-                        std::string str3 = keyT1+"z"+std::to_string(label)+keyT2;
-
-                        writing<<"$VECTORF"<<'\t'<<label<<'\t'<<str1<<'\t'<<str2<<'\t'<<str3<<std::endl;
-                    }else{
-                        if(!m_vectorfield.exists(label))    continue;
-                        std::array<double,3> val = m_vectorfield[label];
-                        writing<<"$VECTORF"<<'\t'<<label<<'\t'<<val[0]<<'\t'<<val[1]<<'\t'<<val[2]<<std::endl;
-                    }
-                }
-                writing<<""<<std::endl;
+                writeCloud(writing, *data);
             }else{
                 (*m_log)<<"error of "<<m_name<<" : cannot open "<<m_filename<< " requested. Exiting... "<<std::endl;
                 throw std::runtime_error (m_name + " : cannot open " + m_filename + " requested. Exiting... ");
@@ -600,4 +621,48 @@ IOCloudPoints::write(){
 };
 
 
+/*!
+ * Write points and fields of a cloud on a stream.
+ * \param[in] out output stream
+ * \param[in] data points and fields of the cloud
+ */
+void
+IOCloudPoints::writeCloud(std::ostream & out, const CloudData & data){
+
+    std::string keyT1 = "{", keyT2 = "}";
+
+    for(std::size_t i = 0; i < data.ids.size(); ++i){
+        const darray3E & coords = data.coords[i];
+        out<<"$POINT"<<'\t'<<data.ids[i]<<'\t'<<coords[0]<<'\t'<<coords[1]<<'\t'<<coords[2]<<std::endl;
+    }
+    out<<""<<std::endl;
+
+    if(data.isTemplate){
+        for(const long & label : data.ids){
+            std::string str1 = keyT1+"s"+std::to_string(label)+keyT2;
+            out<<"$SCALARF"<<'\t'<<label<<'\t'<<str1<<std::endl;
+        }
+    }else{
+        for(const auto & val : data.scalars){
+            out<<"$SCALARF"<<'\t'<<val.first<<'\t'<<val.second<<std::endl;
+        }
+    }
+    out<<""<<std::endl;
+
+    if(data.isTemplate){
+        for(const long & label : data.ids){
+            std::string str1 = keyT1+"x"+std::to_string(label)+keyT2;
+            std::string str2 = keyT1+"y"+std::to_string(label)+keyT2;
+            std::string str3 = keyT1+"z"+std::to_string(label)+keyT2;
+
+            out<<"$VECTORF"<<'\t'<<label<<'\t'<<str1<<'\t'<<str2<<'\t'<<str3<<std::endl;
+        }
+    }else{
+        for(const auto & val : data.vectors){
+            out<<"$VECTORF"<<'\t'<<val.first<<'\t'<<val.second[0]<<'\t'<<val.second[1]<<'\t'<<val.second[2]<<std::endl;
+        }
+    }
+    out<<""<<std::endl;
+}
+
 }
@@ -176,10 +176,23 @@ public:
 
 protected:
     void swap(IOCloudPoints & x) noexcept;
+    std::vector<std::string> getInputFiles();
 
 private:
+    /*!
+     * \brief Points and fields of the cloud, as written on file.
+     */
+    struct CloudData{
+        bool                                    isTemplate; /**< Template mode.*/
+        livector1D                              ids;        /**< Vertex ids.*/
+        dvecarr3E                               coords;     /**< Vertex coordinates.*/
+        std::vector<std::pair<long, double>>    scalars;    /**< Values of the scalar field, by vertex id.*/
+        std::vector<std::pair<long, darray3E>>  vectors;    /**< Values of the vector field, by vertex id.*/
+    };
+
     virtual void read();
     virtual void write();
+    static void writeCloud(std::ostream & out, const CloudData & data);
 };
 
 REGISTER_PORT(M_SCALARFIELD, MC_SCALAR, MD_MPVECFLOAT_,__IOCLOUDPOINTS_HPP__)
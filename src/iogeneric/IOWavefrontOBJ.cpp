@@ -24,7 +24,10 @@
 #include "IOWavefrontOBJ.hpp"
 #include "bitpit_common.hpp"
 #include "customOperators.hpp"
+#include "mimmoTextParser.hpp"
 #include <algorithm>
+#include <future>
+#include <set>
 
 namespace mimmo{
 
@@ -802,6 +805,9 @@ void ManipulateWFOBJData::checkNormalsMagnitude(){
 /*!
     Compute annotations and send it as new pids to the reference geometry.
     New Created PID will be named as the oldPid (if any) + _name of annotation.
+    Each annotation is resolved first to the positions of its cells in the cellgroups
+    storage and then marked in a single concurrent pass; annotations are applied in
+    the order they were added.
 */
 void ManipulateWFOBJData::computeAnnotations(){
 
@@ -818,50 +824,67 @@ void ManipulateWFOBJData::computeAnnotations(){
     }
 
     livector1D geoCellsIds = m_extData->refGeometry->getCells().getIds();
+    const std::size_t npos = std::numeric_limits<std::size_t>::max();
+    const OverlapAnnotationMode mode = m_annMode;
+    std::vector<std::size_t> positions;
     //check for annotations:
     for(MimmoPiercedVector<long> & data : m_annotations){
         //clean up ids not in the current geo.
         data.squeezeOutExcept(geoCellsIds, false);
-        //run over the single annotation
-        long id;
-        for(auto it=data.begin(); it!= data.end(); ++it){
-            id = it.getId();
-            switch(m_annMode){
-                case OverlapAnnotationMode::SOFT: //write only
-                    if(cgs[id].empty()){
-                        cgs[id] = data.getName();
-                    }
-                break;
-                case OverlapAnnotationMode::GETALL:
-                    if(cgs[id].empty()){
-                        cgs[id] = data.getName();
-                    }else{
-                        //append data name with a blank space in front.
-                        cgs[id] = cgs[id] + " " + data.getName();
-                    }
-                    break;
-                case OverlapAnnotationMode::GETALLNOBLANKS:
-                    if(cgs[id].empty()){
-                        cgs[id] = data.getName();
-                    }else{
-                        // be sure to skip marking if the data.getName() string is already here.
-                        if(cgs[id].find(data.getName()) == std::string::npos){
-                            cgs[id] = cgs[id] + data.getName();
+        //resolve cellgroups raw positions, cellgroups ids are coherent with the geometry ones.
+        livector1D ids = data.getIds(false);
+        std::size_t nIds = ids.size();
+        positions.resize(nIds);
+        threads::parallelFor(0, nIds, [&](std::size_t begin, std::size_t end){
+            for(std::size_t k = begin; k < end; ++k){
+                positions[k] = cgs.exists(ids[k]) ? std::size_t(cgs.getRawIndex(ids[k])) : npos;
+            }
+        });
+
+        //mark the annotation. Positions are unique, each entry is modified by one thread only.
+        const std::string name = data.getName();
+        threads::parallelFor(0, nIds, [&](std::size_t begin, std::size_t end){
+            for(std::size_t k = begin; k < end; ++k){
+                if(positions[k] == npos) continue;
+                std::string & entry = cgs.rawAt(positions[k]);
+                switch(mode){
+                    case OverlapAnnotationMode::SOFT: //write only
+                        if(entry.empty()){
+                            entry = name;
                         }
-                    }
-                    break;
-                case OverlapAnnotationMode::HARD:
-                default:
-                    cgs[id] = data.getName();
-                    break;
-            }//end switch
-        } //end data contents
+                        break;
+                    case OverlapAnnotationMode::GETALL:
+                        if(entry.empty()){
+                            entry = name;
+                        }else{
+                            //append data name with a blank space in front.
+                            entry += " " + name;
+                        }
+                        break;
+                    case OverlapAnnotationMode::GETALLNOBLANKS:
+                        if(entry.empty()){
+                            entry = name;
+                        }else{
+                            // be sure to skip marking if the name string is already here.
+                            if(entry.find(name) == std::string::npos){
+                                entry += name;
+                            }
+                        }
+                        break;
+                    case OverlapAnnotationMode::HARD:
+                    default:
+                        entry = name;
+                        break;
+                }//end switch
+            }
+        });
     }// end of annotations.
 }
 
 /*!
     Computing vertex normals on candidates of a mesh cell list a store it in
-    WavefrontOBJData::normals structure;
+    WavefrontOBJData::normals structure. Normals are evaluated in bulk by
+    evalBulkVNormals, then pushed in the normals structure.
 */
 void ManipulateWFOBJData::computeNormals(){
 
@@ -877,8 +900,9 @@ void ManipulateWFOBJData::computeNormals(){
     }
 
     //track if i'm forcing the mother to build adjacencies.
+    //Only bitpit flat normals walk the vertex 1-Ring through adjacencies.
     bool deleteMotherAdjacency=false;
-    if(mother->getAdjacenciesSyncStatus() != SyncStatus::SYNC){
+    if(m_normalsMode == NormalsComputeMode::FLAT_BITPIT && mother->getAdjacenciesSyncStatus() != SyncStatus::SYNC){
         mother->updateAdjacencies();
         deleteMotherAdjacency = true;
     }
@@ -889,7 +913,6 @@ void ManipulateWFOBJData::computeNormals(){
     m_normalsCells.squeezeOutExcept(geoCellsIds, false);
 
     bitpit::PiercedVector<bitpit::Cell> & motherCells = m_extData->refGeometry->getCells();
-    std::array<double,3> candidateNormal;
 
     livector1D candidateCells = m_normalsCells.getIds();
 
@@ -900,54 +923,50 @@ void ManipulateWFOBJData::computeNormals(){
     vnormals->getPatch()->squeezeCells();
     vnormals->getPatch()->reserveCells(targetCellSize);
 
-    //Step 2 evaluate how many new normals we need to push in the normals structure.
-    long newNverts(0);
-    for(long idCell : candidateCells){
-        newNverts += motherCells.at(idCell).getVertexCount();
-    }
-    // and reserve vnormals vertices
-    vnormals->getPatch()->reserveVertices(vnormals->getNVertices() + newNverts);
-
-    //Step 3 ready to calculate new vn from mother mesh, and push new properties in vnormals.
-    bitpit::ConstProxyVector<long> mother_vids;
-    std::vector<long> conn_normals;
-    std::vector<long> motherRing;
-    std::size_t locsize;
-    int rank;
-
     bitpit::SurfaceKernel * motherSK = static_cast<bitpit::SurfaceKernel*>(mother->getPatch());
 
-    // loop on candidate cells
+    //Step 2 collect the candidate cells owned by the current rank.
+    std::vector<long> targetCells;
+    targetCells.reserve(candidateCells.size());
     for (long idCell : candidateCells){
-
 #if MIMMO_ENABLE_MPI
-        if (motherSK->getCell(idCell).isInterior())
+        if (!motherSK->getCell(idCell).isInterior())   continue;
 #endif
-        {
+        targetCells.push_back(idCell);
+    }
 
-            bitpit::Cell & motherCell = motherCells.at(idCell);
-            mother_vids = motherCell.getVertexIds();
-            locsize = mother_vids.size();
-            //resize  future connectivity for vnormals cell
-            conn_normals.resize(locsize);
+    //Step 3 calculate new vn from mother mesh.
+    std::vector<long> normalsConn;
+    std::vector<std::array<double,3>> normals;
+    evalBulkVNormals(motherSK, targetCells, normalsConn, normals);
 
-            // for each local vertices find the 1Ring, calculate the new normals, and
-            // fill the local connectivity ready to be pushed in vnormals as the new cell with id=idCell.
-            for(std::size_t i=0; i<locsize; ++i){
-                candidateNormal = evalVNormal(motherSK, idCell, motherCell.findVertex(mother_vids[i]));
+    //Step 4 push new vn and properties in vnormals.
+    vnormals->getPatch()->reserveVertices(vnormals->getNVertices() + normals.size());
+    std::vector<long> normalsIds(normals.size());
+    for(std::size_t k=0; k<normals.size(); ++k){
+        normalsIds[k] = vnormals->addVertex(normals[k], bitpit::Vertex::NULL_ID);
+        assert(normalsIds[k] >= 0 && "ManipulateWFOBJData::computeNormals cannot insert new vertex normal into WavefrontOBJData::normals. Data can be compromised");
+    }
 
-                conn_normals[i] = vnormals->addVertex(candidateNormal, bitpit::Vertex::NULL_ID);
-                assert(conn_normals[i] >= 0 && "ManipulateWFOBJData::computeNormals cannot insert new vertex normal into WavefrontOBJData::normals. Data can be compromised");
-            }
+    std::vector<long> conn_normals;
+    std::size_t locsize, offset(0);
+    int rank;
+    for (long idCell : targetCells){
+        bitpit::Cell & motherCell = motherCells.at(idCell);
+        locsize = motherCell.getVertexCount();
+        //fill the local connectivity ready to be pushed in vnormals as the new cell with id=idCell.
+        conn_normals.resize(locsize);
+        for(std::size_t i=0; i<locsize; ++i){
+            conn_normals[i] = normalsIds[normalsConn[offset + i]];
+        }
+        offset += locsize;
 
-            //push the new cell
-            rank = -1;
+        //push the new cell
+        rank = -1;
 #if MIMMO_ENABLE_MPI
-            rank = mother->getPatch()->getCellRank(idCell);
+        rank = mother->getPatch()->getCellRank(idCell);
 #endif
-            vnormals->addConnectedCell(conn_normals, motherCell.getType(), long(motherCell.getPID()), idCell, rank);
-
-        }
+        vnormals->addConnectedCell(conn_normals, motherCell.getType(), long(motherCell.getPID()), idCell, rank);
     } // end loop on cells
 
 #if MIMMO_ENABLE_MPI
@@ -1052,6 +1071,220 @@ void ManipulateWFOBJData::extractPinnedLists(){
 }
 
 
+/*!
+    Evaluate the vertex normals on the nodes of a list of cells of a physical mesh, according
+    to the strategy selected in m_normalsMode member.
+
+    For area and angle weighted strategies normals are evaluated once per vertex fan: the
+    cells incident to a target vertex are grouped in fans, i.e. sets of cells connected through
+    the edges sharing the vertex, which are the one-rings findCellVertexOneRing would walk
+    through adjacencies. Facet normals and areas of the incident cells are computed concurrently,
+    then the contributions of each fan are accumulated concurrently on each vertex, through a
+    vertex-to-cells incidence table. Adjacencies are not needed. A manifold vertex gets a single
+    normal shared by its cells, while a non-manifold (bowtie) vertex gets one normal for each fan,
+    as evalVNormal would return.
+    For FLAT_BITPIT strategy normals are evaluated concurrently on each cell vertex through evalVNormal,
+    mesh adjacencies must be built.
+
+    \param[in] mesh pointer to the mesh
+    \param[in] cells ids of the target cells
+    \param[out] conn for each vertex of each target cell, in the order of cells and of
+    their connectivity, index of its normal in normals
+    \param[out] normals vertex normals evaluated
+*/
+void
+ManipulateWFOBJData::evalBulkVNormals(bitpit::SurfaceKernel * mesh, const std::vector<long> & cells,
+                                      std::vector<long> & conn, std::vector<std::array<double,3>> & normals){
+
+    bitpit::PiercedVector<bitpit::Cell> & meshCells = mesh->getCells();
+    std::size_t nCells = cells.size();
+
+    std::vector<const bitpit::Cell *> targetCells(nCells);
+    std::vector<std::size_t> offsets(nCells + 1, 0);
+    for(std::size_t i=0; i<nCells; ++i){
+        targetCells[i] = &(meshCells.at(cells[i]));
+        offsets[i+1] = offsets[i] + targetCells[i]->getVertexCount();
+    }
+    conn.resize(offsets.back());
+
+    if(m_normalsMode != NormalsComputeMode::AREA_WEIGHTED && m_normalsMode != NormalsComputeMode::ANGLE_WEIGHTED){
+        //one normal for each cell vertex.
+        normals.resize(offsets.back());
+        threads::parallelFor(0, nCells, [&](std::size_t begin, std::size_t end){
+            for(std::size_t i=begin; i<end; ++i){
+                std::size_t size = offsets[i+1] - offsets[i];
+                for(std::size_t j=0; j<size; ++j){
+                    conn[offsets[i] + j] = long(offsets[i] + j);
+                    normals[offsets[i] + j] = evalVNormal(mesh, cells[i], int(j));
+                }
+            }
+        }, 64);
+        return;
+    }
+
+    //number the target vertices.
+    bitpit::PiercedStorage<long, long> vertexSlot(1, &(mesh->getVertices()));
+    vertexSlot.fill(-1);
+    std::vector<long> vertexIds;
+    vertexIds.reserve(offsets.back());
+    for(std::size_t i=0; i<nCells; ++i){
+        bitpit::ConstProxyVector<long> vids = targetCells[i]->getVertexIds();
+        for(std::size_t j=0; j<vids.size(); ++j){
+            long & slot = vertexSlot.at(vids[j]);
+            if(slot < 0){
+                slot = long(vertexIds.size());
+                vertexIds.push_back(vids[j]);
+            }
+            conn[offsets[i] + j] = slot;
+        }
+    }
+    std::size_t nVertices = vertexIds.size();
+
+    //collect the cells incident to the target vertices and count their incidences.
+    std::vector<std::size_t> incidence(nVertices + 1, 0);
+    std::vector<const bitpit::Cell *> ringCells;
+    for(const bitpit::Cell & cell : meshCells){
+        bool incident = false;
+        for(long vid : cell.getVertexIds()){
+            long slot = vertexSlot.at(vid);
+            if(slot < 0) continue;
+            ++incidence[slot + 1];
+            incident = true;
+        }
+        if(incident)    ringCells.push_back(&cell);
+    }
+    for(std::size_t k=0; k<nVertices; ++k){
+        incidence[k+1] += incidence[k];
+    }
+
+    //vertex-to-cells incidence table: entries are the index of the ring cell and the local
+    //index of the vertex inside it.
+    std::vector<std::pair<std::size_t, std::size_t>> ring(incidence.back());
+    {
+        std::vector<std::size_t> fill(incidence.begin(), incidence.end() - 1);
+        for(std::size_t r=0; r<ringCells.size(); ++r){
+            bitpit::ConstProxyVector<long> vids = ringCells[r]->getVertexIds();
+            for(std::size_t j=0; j<vids.size(); ++j){
+                long slot = vertexSlot.at(vids[j]);
+                if(slot < 0) continue;
+                ring[fill[slot]++] = std::make_pair(r, j);
+            }
+        }
+    }
+
+    //split the cells incident to each vertex in fans, merging cells which share an edge
+    //of the vertex. Fans are numbered in order of their first incident cell.
+    std::vector<std::size_t> fan(ring.size());
+    std::vector<std::size_t> fanOffsets(nVertices + 1, 0);
+    threads::parallelFor(0, nVertices, [&](std::size_t begin, std::size_t end){
+        std::vector<std::size_t> parent;
+        std::vector<std::pair<long, std::size_t>> edges;
+        auto findRoot = [&parent](std::size_t k){
+            while(parent[k] != k){
+                parent[k] = parent[parent[k]];
+                k = parent[k];
+            }
+            return k;
+        };
+        std::size_t first, nIncident, size, loc, root, other, nFans;
+        for(std::size_t v=begin; v<end; ++v){
+            first = incidence[v];
+            nIncident = incidence[v+1] - first;
+            parent.resize(nIncident);
+            edges.clear();
+            for(std::size_t k=0; k<nIncident; ++k){
+                parent[k] = k;
+                bitpit::ConstProxyVector<long> vlist = ringCells[ring[first + k].first]->getVertexIds();
+                size = vlist.size();
+                loc = ring[first + k].second;
+                edges.emplace_back(vlist[(loc - 1 + size)%size], k);
+                edges.emplace_back(vlist[(loc + 1)%size], k);
+            }
+            std::sort(edges.begin(), edges.end());
+            for(std::size_t e=1; e<edges.size(); ++e){
+                if(edges[e].first != edges[e-1].first) continue;
+                root = findRoot(edges[e-1].second);
+                other = findRoot(edges[e].second);
+                parent[std::max(root, other)] = std::min(root, other);
+            }
+            //roots are the smallest entries of their fans.
+            nFans = 0;
+            for(std::size_t k=0; k<nIncident; ++k){
+                root = findRoot(k);
+                fan[first + k] = (root == k) ? nFans++ : fan[first + root];
+            }
+            fanOffsets[v+1] = nFans;
+        }
+    }, 256);
+    for(std::size_t k=0; k<nVertices; ++k){
+        fanOffsets[k+1] += fanOffsets[k];
+    }
+
+    //point the target cell vertices to the normal of their fan.
+    threads::parallelFor(0, nCells, [&](std::size_t begin, std::size_t end){
+        for(std::size_t i=begin; i<end; ++i){
+            for(std::size_t j=offsets[i]; j<offsets[i+1]; ++j){
+                std::size_t v = std::size_t(conn[j]);
+                for(std::size_t k=incidence[v]; k<incidence[v+1]; ++k){
+                    if(ringCells[ring[k].first] == targetCells[i]){
+                        conn[j] = long(fanOffsets[v] + fan[k]);
+                        break;
+                    }
+                }
+            }
+        }
+    }, 256);
+
+    //facet normals and, if needed, areas of ring cells.
+    bool areaWeighted = (m_normalsMode == NormalsComputeMode::AREA_WEIGHTED);
+    std::size_t nRing = ringCells.size();
+    std::vector<std::array<double,3>> facetNormals(nRing);
+    std::vector<double> facetAreas(areaWeighted ? nRing : 0);
+    threads::parallelFor(0, nRing, [&](std::size_t begin, std::size_t end){
+        for(std::size_t r=begin; r<end; ++r){
+            long id = ringCells[r]->getId();
+            facetNormals[r] = mesh->evalFacetNormal(id);
+            if(areaWeighted)    facetAreas[r] = mesh->evalCellArea(id);
+        }
+    }, 256);
+
+    //accumulate the weighted facet normals on the vertex fans.
+    normals.assign(fanOffsets.back(), std::array<double,3>({{0.0, 0.0, 0.0}}));
+    threads::parallelFor(0, nVertices, [&](std::size_t begin, std::size_t end){
+        std::size_t size, loc, loc_left, loc_right;
+        double l0, l1, ww;
+        darray3E e0, e1, targetCoords;
+        std::vector<double> wwTot;
+        for(std::size_t v=begin; v<end; ++v){
+            wwTot.assign(fanOffsets[v+1] - fanOffsets[v], 0.0);
+            targetCoords = mesh->getVertexCoords(vertexIds[v]);
+            for(std::size_t k=incidence[v]; k<incidence[v+1]; ++k){
+                std::size_t r = ring[k].first;
+                if(areaWeighted){
+                    ww = facetAreas[r];
+                }else{
+                    bitpit::ConstProxyVector<long> vlist = ringCells[r]->getVertexIds();
+                    size = vlist.size();
+                    loc = ring[k].second;
+                    //MWA - modified with cosine version;
+                    loc_left = (loc - 1 + size)%size;
+                    loc_right = (loc + 1)%size;
+                    e0 = mesh->getVertexCoords(vlist[loc_left]) - targetCoords;
+                    e1 = mesh->getVertexCoords(vlist[loc_right]) - targetCoords;
+                    l0 = std::max(std::numeric_limits<double>::min(), norm2(e0));
+                    l1 = std::max(std::numeric_limits<double>::min(), norm2(e1));
+                    ww = std::acos(std::min(1.0, std::max(-1.0, dotProduct(e0,e1)/(l0*l1))));
+                }
+                normals[fanOffsets[v] + fan[k]] += ww * facetNormals[r];
+                wwTot[fan[k]] += ww;
+            }
+            for(std::size_t f=0; f<wwTot.size(); ++f){
+                normals[fanOffsets[v] + f] /= wwTot[f];
+            }
+        }
+    }, 256);
+}
+
 /*!
     Given a physical mesh, the target vertex id and its ring of cells compute the
     average normal on vertex id according to the strategy selected in m_normalsMode member.
@@ -1209,6 +1442,17 @@ void IOWavefrontOBJ::swap(IOWavefrontOBJ & x) noexcept{
     BaseManipulation::swap(x);
 }
 
+/*!
+ * Get the obj file read by the object, if it is in IOMode::READ.
+ * \return path of the input file.
+ */
+std::vector<std::string>
+IOWavefrontOBJ::getInputFiles(){
+    std::vector<std::string> files;
+    if (m_mode == IOMode::READ) files.push_back(m_dir+"/"+m_filename+".obj");
+    return files;
+}
+
 /*!
     Building class ports
 */
@@ -1600,8 +1844,6 @@ void   IOWavefrontOBJ::execute(){
 */
 void IOWavefrontOBJ::read(const std::string & filename){
 
-    std::ifstream in(filename, std::ios::binary);
-
     //compile safely data options
     m_intData->materials.setGeometry(getGeometry());
     m_intData->cellgroups.setGeometry(getGeometry());
@@ -1622,49 +1864,15 @@ void IOWavefrontOBJ::read(const std::string & filename){
     if(getRank() == 0)
 #endif
     {
-        if(in.is_open()){
-
-            //search and store the material file fullpath.
-            m_intData->materialfile = searchMaterialFile(in);
-            //search and store the stream position of the sub-objects
-            std::vector<std::streampos> objectPositions; //streampos of each new object
-            std::vector<std::string> objectNames; // name of the new object
-            std::vector<std::array<long,3>> objectVCounters; //number of v, vt, and vn in each object
-            std::array<long,3>  totVCounters; //total number of v, vt, and vn
-            long nCellTot; // number of total facet f
-
-            // open the file and fill the information required.
-            searchObjectPosition(in, objectPositions, objectNames, objectVCounters, totVCounters, nCellTot);
-
-            //reserve geometry vertices and cells
-            m_geometry->getVertices().reserve(totVCounters[0]);
-            m_geometry->getCells().reserve(nCellTot);
-            m_intData->materials.reserve(nCellTot);
-            m_intData->cellgroups.reserve(nCellTot);
-            m_intData->smoothids.reserve(nCellTot);
-
-            // prepare textures and normals
-            if(totVCounters[1]> 0){
-                m_intData->textures->getVertices().reserve(totVCounters[1]);
-                m_intData->textures->getCells().reserve(nCellTot);
-            }
-            if(totVCounters[2]> 0){
-                m_intData->normals->getVertices().reserve(totVCounters[2]);
-                m_intData->normals->getCells().reserve(nCellTot);
-            }
-
-            long pidObject(0);
-            long vOffset(1), vnOffset(1), vTxtOffset(1), cOffset(1);
-            //read file object by object
-            for(std::streampos & pos : objectPositions){
+        text::FileBuffer buffer(filename);
+        if(buffer.isOpen()){
 
-                readObjectData(in, pos, pidObject,objectNames[pidObject], objectVCounters[pidObject],
-                        vOffset, vnOffset, vTxtOffset, cOffset);
-                m_geometry->setPIDName(pidObject, objectNames[pidObject]);
-                ++pidObject;
-            }
+            //search the material file and the first sub-object declaration.
+            const char * objectsBegin = searchFirstObject(buffer.begin(), buffer.end(), m_intData->materialfile);
 
-            in.close();
+            //parse line-aligned chunks concurrently, then fill mesh and data.
+            std::vector<OBJChunk> chunks = text::parseChunks<OBJChunk>(objectsBegin, buffer.end(), &IOWavefrontOBJ::parseChunk);
+            absorbChunks(chunks);
 
         }else{
             *(m_log)<<m_name<<" : impossible to read from obj file "<<filename<<std::endl;
@@ -1725,12 +1933,17 @@ void IOWavefrontOBJ::read(const std::string & filename){
     if(m_cleanDoubleVertices){
         m_geometry->getPatch()->deleteCoincidentVertices();
     }
+    //vertices deleted directly in the patch.
+    m_geometry->setUnsyncAll();
 
     // check for fuzzy or degenerate cells into your tessellation.
     bitpit::PiercedVector<bitpit::Cell>degenerateElements;
     // erase or degrade it.
     m_geometry->degradeDegenerateElements(&degenerateElements, nullptr);
-    m_geometry->getPatch()->deleteOrphanVertices();
+    if(m_geometry->getPatch()->countOrphanVertices() > 0){
+        m_geometry->getPatch()->deleteOrphanVertices();
+        m_geometry->setUnsyncAll();
+    }
 
     // the real mesh is ok, we need to check textures, normals, and other cell data.
     if(degenerateElements.size() > 0){
@@ -2717,4 +2930,408 @@ int IOWavefrontOBJ::checkFacetDefinition(const std::string & str){
 }
 
 
+/*!
+    \brief Contents of a line-aligned chunk of an obj file, parsed concurrently while reading.
+
+    Coordinates of v, vt and vn entries are stored with 3 components each. Facets are stored in
+    compact form: number of vertices, mask of the available indices and flat lists of v, vt and
+    vn indices. Indices relative to the end of an entry list (negative in the file) are resolved
+    against the entries of the chunk only, and their positions are stored to be shifted later by the
+    entries of the previous chunks. Keywords changing the state of the following facets (o, usemtl,
+    g, s) are stored as events, marked by the number of facets of the chunk preceding them.
+*/
+struct IOWavefrontOBJ::OBJChunk{
+    /*!
+        \brief Keyword changing the state of the following facets.
+    */
+    struct Event{
+        std::size_t facet;  /**< number of facets of the chunk preceding the event */
+        char        key;    /**< first character of the keyword (o, u, g, s) */
+        std::string label;  /**< argument of the keyword */
+    };
+
+    std::array<std::vector<double>,3>       coords;     /**< coordinates of v, vt, vn entries */
+    std::array<std::vector<long>,3>         indices;    /**< v, vt, vn indices of facets; a vt/vn index is valid only if the facet mask has it */
+    std::array<std::vector<std::size_t>,3>  relative;   /**< positions of the v, vt, vn indices to be shifted by previous chunks entries */
+    std::vector<int>                        sizes;      /**< number of vertices of each facet */
+    std::vector<unsigned char>              masks;      /**< for each facet, bit 1 set if vt indices are available, bit 2 if vn indices are */
+    std::vector<Event>                      events;     /**< state events of the chunk */
+    std::vector<char>                       unsupported;/**< unsupported keywords found */
+    long                                    skipped = 0;/**< number of unsupported facets skipped */
+    std::string                             materialfile; /**< material file declared by mtllib, if any */
+};
+
+/*!
+    Search the first sub-object declaration (o key entry) of an obj file, and the material
+    file declared by mtllib before it, if any.
+    \param[in] begin begin of the file contents
+    \param[in] end end of the file contents
+    \param[out] materialfile material file name, empty if not found
+    \return position of the first sub-object declaration, end if none.
+*/
+const char * IOWavefrontOBJ::searchFirstObject(const char * begin, const char * end, std::string & materialfile){
+    materialfile.clear();
+    const char * cursor = begin;
+    while(cursor < end){
+        const char * eol = text::lineEnd(cursor, end);
+        if(eol - cursor >= 2){
+            if(*cursor == 'o') return cursor;
+            const char * current = cursor;
+            const char * tokenBegin;
+            const char * tokenEnd;
+            if(materialfile.empty() && text::nextToken(current, eol, tokenBegin, tokenEnd) && text::equals(tokenBegin, tokenEnd, "mtllib")){
+                materialfile = std::string(current, eol);
+                materialfile = bitpit::utils::string::trim(materialfile);
+            }
+        }
+        cursor = text::nextLine(cursor, end);
+    }
+    return end;
+}
+
+/*!
+    Parse a line-aligned chunk of an obj file. Supported entries are the ones of readObjectData.
+    Facets with less than 3 vertices or not readable are skipped.
+    \param[in] begin begin of the chunk
+    \param[in] end end of the chunk
+    \param[out] chunk contents of the chunk
+*/
+void IOWavefrontOBJ::parseChunk(const char * begin, const char * end, OBJChunk & chunk){
+
+    std::array<std::vector<long>,3> facet;
+    std::array<std::vector<std::size_t>,3> facetRelative;
+    const char * tokenBegin;
+    const char * tokenEnd;
+
+    const char * cursor = begin;
+    while(cursor < end){
+        const char * eol = text::lineEnd(cursor, end);
+        const char * current = cursor;
+        cursor = text::nextLine(cursor, end);
+        if(eol - current < 2) continue; //ignore all lines with less then 2 characters into.
+
+        char key = *current;
+        if(key == 'v'){
+            int entry = -1;
+            if(current[1] == ' ' || current[1] == '\t') entry = 0;
+            if(current[1] == 't')   entry = 1;
+            if(current[1] == 'n')   entry = 2;
+            if(entry < 0){
+                chunk.unsupported.push_back(key);
+                continue;
+            }
+            current += (entry == 0) ? 1 : 2;
+            //missing components are set to zero.
+            std::array<double,3> temp({{0.0,0.0,0.0}});
+            for(double & val : temp){
+                if(!text::parseReal(current, eol, val)) break;
+            }
+            chunk.coords[entry].insert(chunk.coords[entry].end(), temp.begin(), temp.end());
+        }
+        else if(key == 'f'){
+            // tokens v, v/vt, v/vt/vn or v//vn
+            for(int e=0; e<3; ++e){
+                facet[e].clear();
+                facetRelative[e].clear();
+            }
+            bool valid = text::nextToken(current, eol, tokenBegin, tokenEnd);
+            while(valid && text::nextToken(current, eol, tokenBegin, tokenEnd)){
+                const char * p = tokenBegin;
+                std::array<long long,3> values({{0,0,0}});
+                std::array<bool,3> found({{false,false,false}});
+                found[0] = text::parseInteger(p, tokenEnd, values[0]);
+                if(found[0] && p < tokenEnd && *p == '/'){
+                    ++p;
+                    if(p < tokenEnd && *p != '/'){
+                        found[1] = text::parseInteger(p, tokenEnd, values[1]);
+                    }
+                    if(p < tokenEnd && *p == '/'){
+                        ++p;
+                        found[2] = text::parseInteger(p, tokenEnd, values[2]);
+                    }
+                }
+                valid = found[0] && p == tokenEnd;
+                for(int e=0; e<3 && valid; ++e){
+                    if(!found[e]) continue;
+                    long value = long(values[e]);
+                    if(value < 0){
+                        value += long(chunk.coords[e].size() / 3) + 1;
+                        facetRelative[e].push_back(facet[e].size());
+                    }
+                    facet[e].push_back(value);
+                }
+            }
+            if(!valid || facet[0].size() < 3){
+                ++chunk.skipped;
+                continue;
+            }
+
+            std::size_t offset = chunk.indices[0].size();
+            unsigned char mask = 0;
+            for(int e=0; e<3; ++e){
+                if(e > 0 && facet[e].size() != facet[0].size()) continue;
+                if(e > 0)   mask |= (1 << e);
+                chunk.indices[e].resize(offset, 0);
+                chunk.indices[e].insert(chunk.indices[e].end(), facet[e].begin(), facet[e].end());
+                for(std::size_t pos : facetRelative[e]){
+                    chunk.relative[e].push_back(offset + pos);
+                }
+            }
+            chunk.sizes.push_back(int(facet[0].size()));
+            chunk.masks.push_back(mask);
+        }
+        else if(key == 'o' || key == 'u' || key == 'g' || key == 's'){
+            OBJChunk::Event event;
+            event.facet = chunk.sizes.size();
+            event.key = key;
+            if(key == 'o'){
+                // the object name is the whole rest of the line
+                event.label = std::string(current + 1, eol);
+            }else if(text::nextToken(current, eol, tokenBegin, tokenEnd) && text::nextToken(current, eol, tokenBegin, tokenEnd)){
+                event.label = std::string(tokenBegin, tokenEnd);
+            }
+            event.label = bitpit::utils::string::trim(event.label);
+            chunk.events.push_back(std::move(event));
+        }
+        else if(key == 'm'){
+            if(chunk.materialfile.empty() && text::nextToken(current, eol, tokenBegin, tokenEnd) && text::equals(tokenBegin, tokenEnd, "mtllib")){
+                chunk.materialfile = std::string(current, eol);
+                chunk.materialfile = bitpit::utils::string::trim(chunk.materialfile);
+            }
+        }
+        else if(key != '#'){
+            chunk.unsupported.push_back(key);
+        }
+    }
+}
+
+/*!
+    Fill mesh, textures, normals and cell data with the contents of the parsed chunks of an obj file.
+    Indices relative to the end of the entry lists are resolved first; then the global ids of
+    vertices and cells follow from the chunk contents, so that the mesh, the textures, the normals and
+    the cell data can be filled concurrently, each one by a different thread.
+    Vertices (v, vt, vn) and cells are numbered consecutively from 1, in file order.
+    Chunks are released while they are absorbed.
+    \param[in,out] chunks parsed chunks, in file order
+*/
+void IOWavefrontOBJ::absorbChunks(std::vector<OBJChunk> & chunks){
+
+    std::size_t nChunks = chunks.size();
+
+    // entries of the previous chunks, part identifier active at the begin of each chunk
+    std::vector<std::array<long,3>> entryBase(nChunks + 1, std::array<long,3>({{0,0,0}}));
+    std::vector<long> pidBase(nChunks, -1);
+    std::vector<std::string> objectNames;
+    long nCellTot(0);
+    std::set<char> unsupported;
+    long skipped(0);
+    for(std::size_t i=0; i<nChunks; ++i){
+        const OBJChunk & chunk = chunks[i];
+        for(int e=0; e<3; ++e){
+            entryBase[i+1][e] = entryBase[i][e] + long(chunk.coords[e].size() / 3);
+        }
+        pidBase[i] = long(objectNames.size()) - 1;
+        for(const OBJChunk::Event & event : chunk.events){
+            if(event.key == 'o')    objectNames.push_back(event.label);
+        }
+        nCellTot += long(chunk.sizes.size());
+        unsupported.insert(chunk.unsupported.begin(), chunk.unsupported.end());
+        skipped += chunk.skipped;
+        if(m_intData->materialfile.empty())    m_intData->materialfile = chunk.materialfile;
+    }
+    const std::array<long,3> & totVCounters = entryBase[nChunks];
+
+    for(char key : unsupported){
+        *(m_log)<<"WARNING "<<m_name<<" : unsupported flag "<<key<<" declaration while reading obj file. Ignoring..."<<std::endl;
+    }
+    if(skipped > 0){
+        *(m_log)<<"WARNING "<<m_name<<" : skipping "<<skipped<<" unsupported facets while reading obj file. "<<std::endl;
+    }
+
+    // resolve relative indices
+    threads::parallelFor(0, nChunks, [&chunks, &entryBase](std::size_t begin, std::size_t end){
+        for(std::size_t i=begin; i<end; ++i){
+            for(int e=0; e<3; ++e){
+                for(std::size_t pos : chunks[i].relative[e]){
+                    chunks[i].indices[e][pos] += entryBase[i][e];
+                }
+                std::vector<std::size_t>().swap(chunks[i].relative[e]);
+            }
+        }
+    }, 1);
+
+    //reserve geometry vertices and cells
+    m_geometry->getVertices().reserve(totVCounters[0]);
+    m_geometry->getCells().reserve(nCellTot);
+    m_intData->materials.reserve(nCellTot);
+    m_intData->cellgroups.reserve(nCellTot);
+    m_intData->smoothids.reserve(nCellTot);
+
+    // prepare textures and normals
+    MimmoSharedPointer<MimmoObject> textures = m_intData->textures;
+    MimmoSharedPointer<MimmoObject> normals = m_intData->normals;
+    if(totVCounters[1]> 0){
+        textures->getVertices().reserve(totVCounters[1]);
+        textures->getCells().reserve(nCellTot);
+    }
+    if(totVCounters[2]> 0){
+        normals->getVertices().reserve(totVCounters[2]);
+        normals->getCells().reserve(nCellTot);
+    }
+
+    // fill independent containers concurrently
+    std::vector<std::future<void>> tasks;
+    if(totVCounters[1]> 0){
+        tasks.push_back(std::async(std::launch::async, [this, textures, &chunks, &pidBase](){
+            pushChunkVertices(textures, chunks, 1);
+            pushChunkCells(textures, chunks, pidBase, 1);
+        }));
+    }
+    if(totVCounters[2]> 0){
+        tasks.push_back(std::async(std::launch::async, [this, normals, &chunks, &pidBase](){
+            pushChunkVertices(normals, chunks, 2);
+            pushChunkCells(normals, chunks, pidBase, 2);
+        }));
+    }
+    tasks.push_back(std::async(std::launch::async, [this, &chunks](){
+        pushChunkCellData(chunks);
+    }));
+
+    pushChunkVertices(m_geometry, chunks, 0);
+    pushChunkCells(m_geometry, chunks, pidBase, 0);
+
+    for(auto & task : tasks){
+        task.get();
+    }
+    for(std::size_t pid=0; pid<objectNames.size(); ++pid){
+        m_geometry->setPIDName(long(pid), objectNames[pid]);
+    }
+    std::vector<OBJChunk>().swap(chunks);
+}
+
+/*!
+    Add the entries of the parsed chunks of an obj file as vertices of a mesh, with ids
+    consecutive from 1. Vertices are added directly to the bitpit patch, and the mesh
+    is marked as modified once at the end of the batch.
+    \param[in] obj target mesh
+    \param[in] chunks parsed chunks
+    \param[in] entry type of entries, 0 for v, 1 for vt, 2 for vn
+*/
+void IOWavefrontOBJ::pushChunkVertices(MimmoSharedPointer<MimmoObject> obj, const std::vector<OBJChunk> & chunks, int entry){
+    bitpit::PatchKernel * patch = obj->getPatch();
+    long id(1);
+    std::array<double,3> temp;
+    for(const OBJChunk & chunk : chunks){
+        const std::vector<double> & coords = chunk.coords[entry];
+        for(std::size_t k=0; k<coords.size(); k+=3){
+            std::copy_n(coords.begin() + k, 3, temp.begin());
+            patch->addVertex(temp, id);
+            ++id;
+        }
+    }
+    obj->setUnsyncAll();
+}
+
+/*!
+    Add the facets of the parsed chunks of an obj file as cells of a mesh, with ids consecutive from 1.
+    For textures and normals, facets without vt or vn indices are skipped, without consuming their id.
+    Cells are added directly to the bitpit patch, and PIDs and revisions of the mesh are
+    resynchronized once at the end of the batch.
+    \param[in] obj target mesh
+    \param[in] chunks parsed chunks
+    \param[in] pidBase part identifier active at the begin of each chunk
+    \param[in] entry type of indices, 0 for v, 1 for vt, 2 for vn
+*/
+void IOWavefrontOBJ::pushChunkCells(MimmoSharedPointer<MimmoObject> obj, const std::vector<OBJChunk> & chunks,
+                                    const std::vector<long> & pidBase, int entry){
+    bitpit::PatchKernel * patch = obj->getPatch();
+    bitpit::PatchKernel::CellIterator it;
+    long id(1);
+    std::vector<long> conn;
+    for(std::size_t i=0; i<chunks.size(); ++i){
+        const OBJChunk & chunk = chunks[i];
+        long pid = pidBase[i];
+        std::size_t offset(0), iEvent(0);
+        for(std::size_t f=0; f<chunk.sizes.size(); ++f){
+            for(; iEvent < chunk.events.size() && chunk.events[iEvent].facet <= f; ++iEvent){
+                if(chunk.events[iEvent].key == 'o') ++pid;
+            }
+            std::size_t size = std::size_t(chunk.sizes[f]);
+            if(entry == 0 || (chunk.masks[f] & (1 << entry))){
+                std::vector<long>::const_iterator first = chunk.indices[entry].begin() + offset;
+                bitpit::ElementType type = bitpit::ElementType::POLYGON;
+                conn.clear();
+                if(size == 3){
+                    type = bitpit::ElementType::TRIANGLE;
+                }else if(size == 4){
+                    type = bitpit::ElementType::QUAD;
+                }else{
+                    conn.push_back(long(size));
+                }
+                conn.insert(conn.end(), first, first + size);
+#if MIMMO_ENABLE_MPI
+                it = patch->addCell(type, conn, obj->getRank(), id);
+#else
+                it = patch->addCell(type, conn, id);
+#endif
+                it->setPID(int(pid));
+            }
+            offset += size;
+            ++id;
+        }
+    }
+    obj->resyncPID();
+    obj->setUnsyncAll();
+}
+
+/*!
+    Fill materials, smoothing group ids and cell groups of the cells with the state
+    events of the parsed chunks of an obj file. State is reset at each sub-object.
+    \param[in] chunks parsed chunks
+*/
+void IOWavefrontOBJ::pushChunkCellData(const std::vector<OBJChunk> & chunks){
+    std::string activeMaterial(""), activeGroup(""), defaultGroup("");
+    long activeSmooth(0);
+    long id(1);
+    for(const OBJChunk & chunk : chunks){
+        std::size_t iEvent(0);
+        for(std::size_t f=0; f<=chunk.sizes.size(); ++f){
+            for(; iEvent < chunk.events.size() && chunk.events[iEvent].facet <= f; ++iEvent){
+                const OBJChunk::Event & event = chunk.events[iEvent];
+                switch(event.key){
+                    case 'o':
+                        defaultGroup = event.label;
+                        activeMaterial = "";
+                        activeGroup = "";
+                        activeSmooth = 0;
+                        break;
+                    case 'u':
+                        activeMaterial = event.label;
+                        break;
+                    case 'g':
+                        if(!m_ignoringCellGroups){
+                            activeGroup = (event.label == defaultGroup) ? std::string("") : event.label;
+                        }
+                        break;
+                    case 's':
+                        if(event.label.empty() || event.label == "off"){
+                            activeSmooth = 0;
+                        }else{
+                            activeSmooth = std::stol(event.label);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+            if(f == chunk.sizes.size()) break;
+            m_intData->materials.insert(id, activeMaterial);
+            m_intData->smoothids.insert(id, activeSmooth);
+            m_intData->cellgroups.insert(id, activeGroup);
+            ++id;
+        }
+    }
+}
+
+
 }
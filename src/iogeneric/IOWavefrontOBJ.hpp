@@ -100,6 +100,9 @@ The class performs manipulation of Wavefront mesh optional data such as:
   according to NormalsComputeMode enum. NormalsComputeMode::FLAT_BITPIT is the default.
   Please note that recomputing normals will modify MimmoObject internal structures,
   so its properties (kdtrees, adjacencies etc..) will be invalidated.
+  Area and angle weighted normals are evaluated in a single multithreaded pass on the
+  candidate vertices, accumulating the contributions of all the cells sharing each vertex;
+  they do not need the mesh adjacencies.
 
 - recover list of cell-ids referring to target Wavefront data cell properties such as
   materials, cellgroups, smoothids (f.e. extract all mesh cell-ids with material
@@ -227,6 +230,8 @@ protected:
     void extractPinnedLists();
 
     std::array<double,3> evalVNormal(bitpit::SurfaceKernel * mesh, long idCell, int locVertex);
+    void evalBulkVNormals(bitpit::SurfaceKernel * mesh, const std::vector<long> & cells,
+                          std::vector<long> & conn, std::vector<std::array<double,3>> & normals);
 
     WavefrontOBJData * m_extData; /**< externally linked data*/
     MimmoPiercedVector<long> m_normalsCells; /**< candidate cell list for normals recomputation.*/
@@ -280,11 +285,16 @@ are the same in all 3 objects (reference mesh, textures and normals).
 fields attached to the MimmoObject mesh cells-ids.
 
 
-WARNING 1: for reading/writing of v,vt,vn data chunks, the class supposes that the three of them
-are organized in the file in blocks of consecutive entries, i.e. after 'o' sub-object declaration
+The obj file is read memory-mapped and split in line-aligned chunks, parsed concurrently
+by the threads available to mimmo (see threads::getNumberOfThreads), regardless of the
+sub-object boundaries. Mesh, textures, normals and cell data are then filled concurrently,
+with ids precomputed from the chunk contents. Entries declared before the first 'o' sub-object
+declaration are ignored.
+
+WARNING 1: for writing of v,vt,vn data chunks, the class organizes the three of them
+in the file in blocks of consecutive entries, i.e. after 'o' sub-object declaration
 all the v's of the object are written, then the vt's if any, and finally the vn's if any.
-This may be not true for the general Wavefront format(in which declarations can be random and not organized at all),
-but meet quite well with the practice of well known OBJ file exporter like the Blender's one.
+This is not required while reading, where declarations can be sparse, as in the general Wavefront format.
 
 WARNING 2: During OBJ writing if empty cellgroup entry is encountered, it will be assigned the
 object name (o) by default.
@@ -383,6 +393,7 @@ public:
 
 protected:
     void swap(IOWavefrontOBJ & x) noexcept;
+    std::vector<std::string> getInputFiles();
     void buildPorts();
 
     void read(const std::string & fullpath);
@@ -433,6 +444,15 @@ private:
     int convertKeyEntryToInt(char key);
     long pushCell(MimmoSharedPointer<MimmoObject> geo, std::vector<long> &conn, long PID, long id, int rank = -1 );
     int checkFacetDefinition(const std::string & str);
+
+    struct OBJChunk;
+    static const char * searchFirstObject(const char * begin, const char * end, std::string & materialfile);
+    static void parseChunk(const char * begin, const char * end, OBJChunk & chunk);
+    void absorbChunks(std::vector<OBJChunk> & chunks);
+    void pushChunkVertices(MimmoSharedPointer<MimmoObject> obj, const std::vector<OBJChunk> & chunks, int entry);
+    void pushChunkCells(MimmoSharedPointer<MimmoObject> obj, const std::vector<OBJChunk> & chunks,
+                        const std::vector<long> & pidBase, int entry);
+    void pushChunkCellData(const std::vector<OBJChunk> & chunks);
 };
 
 REGISTER_PORT(M_GEOM, MC_SCALAR, MD_MIMMO_, __IOWAVEFRONTOBJ__HPP__)
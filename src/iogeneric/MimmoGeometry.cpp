@@ -24,7 +24,13 @@
 #include "MimmoGeometry.hpp"
 #include "VTUGridReader.hpp"
 #include "VTUGridWriterASCII.hpp"
+#include "ParallelSurfaceReader.hpp"
+#include "mimmoTextParser.hpp"
 #include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
 
 namespace mimmo {
 
@@ -95,6 +101,9 @@ MimmoGeometry::MimmoGeometry(const MimmoGeometry & other):BaseManipulation(other
     m_tolerance = other.m_tolerance;
     m_clean = other.m_clean;
     m_parallelRestore = other.m_parallelRestore;
+    m_parallelRead = other.m_parallelRead;
+    m_streamVTU = other.m_streamVTU;
+    m_vtuOptions = other.m_vtuOptions;
 };
 
 /*!
@@ -126,9 +135,48 @@ void MimmoGeometry::swap(MimmoGeometry & x) noexcept
     std::swap(m_tolerance, x.m_tolerance);
     std::swap(m_clean, x.m_clean);
     std::swap(m_parallelRestore, x.m_parallelRestore);
+    std::swap(m_parallelRead, x.m_parallelRead);
+    std::swap(m_streamVTU, x.m_streamVTU);
+    std::swap(m_vtuOptions, x.m_vtuOptions);
     BaseManipulation::swap(x);
 }
 
+/*!
+ * Get the files the object can read, if it is in read mode. All the alternative
+ * extensions accepted for the current file type are listed, so that creating one of
+ * them is detected as well.
+ * \return paths of the input files.
+ */
+std::vector<std::string>
+MimmoGeometry::getInputFiles(){
+    std::vector<std::string> files;
+    if (!m_read) return files;
+
+    std::string name = m_rinfo.fdir+"/"+m_rinfo.fname;
+    switch(FileType::_from_integral(m_rinfo.ftype)){
+    case FileType::STL :
+        files.push_back(name+".stl");
+        files.push_back(name+".STL");
+        break;
+    case FileType::SURFVTU :
+    case FileType::VOLVTU :
+    case FileType::PCVTU :
+    case FileType::CURVEVTU :
+        files.push_back(name+".vtu");
+        files.push_back(name+".pvtu");
+        break;
+    case FileType::NAS :
+        files.push_back(name+".nas");
+        break;
+    case FileType::MIMMO :
+        files.push_back(name+".geomimmo");
+        break;
+    default:
+        break;
+    }
+    return files;
+}
+
 /*!
  * Building the ports available in the class
  */
@@ -173,6 +221,9 @@ MimmoGeometry::setDefaults(){
     m_tolerance = 1.0e-06;
     m_clean = true;
     m_parallelRestore = MIMMO_ENABLE_MPI;
+    m_parallelRead = false;
+    m_streamVTU = false;
+    m_vtuOptions = VTUStreamOptions();
 }
 
 
@@ -396,6 +447,48 @@ MimmoGeometry::setParallelRestore(bool parallelRestore){
     m_parallelRestore = parallelRestore;
 }
 
+/*!
+ * Set if STL and Nastran files have to be read by all the processes, each one reading
+ * a part of the file. The read geometry is already partitioned among the processes.
+ * If false, or if MPI is not enabled or a single process is running, the file is read
+ * by the master rank 0 only.
+ * \param[in] parallelRead if true activate the distributed reading
+ */
+void
+MimmoGeometry::setParallelRead(bool parallelRead){
+    m_parallelRead = parallelRead;
+}
+
+/*!
+ * Set if binary VTU files have to be read and written in streaming mode, i.e. encoding/decoding
+ * their data in blocks directly from/to the geometry. The option is effective on serial files only
+ * and, while writing, with binary codex only.
+ * \param[in] stream if true activate the streaming mode
+ */
+void
+MimmoGeometry::setStreamVTU(bool stream){
+    m_streamVTU = stream;
+}
+
+/*!
+ * Set if VTU files written in streaming mode have to be compressed with zlib.
+ * The option is effective only if mimmo is built with zlib support.
+ * \param[in] compress if true activate the compression
+ */
+void
+MimmoGeometry::setVTUCompression(bool compress){
+    m_vtuOptions.compress = compress;
+}
+
+/*!
+ * Set if VTU files written in streaming mode have to store point coordinates in single precision.
+ * \param[in] float32 if true write coordinates in single precision
+ */
+void
+MimmoGeometry::setVTUFloat32(bool float32){
+    m_vtuOptions.float32 = float32;
+}
+
 /*!
  * Force your class to allocate an internal MimmoObject of type 1-Superficial mesh
  * 2-Volume Mesh,3-Point Cloud, 4-3DCurve. Other internal object allocated or externally linked geometries
@@ -504,6 +597,7 @@ MimmoGeometry::setFormatNAS(WFORMAT wform){
 }
 
 /*!It writes the mesh geometry on output .vtu file.
+ * With asynchronous output active, a snapshot of the geometry is written in background.
  *\return False if geometry is not linked.
  */
 bool
@@ -526,18 +620,56 @@ MimmoGeometry::write(){
         return false;
     }
 
-    switch(FileType::_from_integral(m_winfo.ftype)){
+    if (isAsyncOutput()){
+        //snapshot of the geometry and of the writing settings, written in background;
+        //the geometry clone is released by this thread (see BaseManipulation::submitAsyncOutput).
+        std::shared_ptr<MimmoSharedPointer<MimmoObject>> snapshot = std::make_shared<MimmoSharedPointer<MimmoObject>>(getGeometry()->clone());
+        MimmoObject * geometry = snapshot->get();
+        FileDataInfo winfo = m_winfo;
+        bool codex = m_codex;
+        bool multiSolidSTL = m_multiSolidSTL;
+        WFORMAT wformat = m_wformat;
+        bool streamVTU = m_streamVTU;
+        VTUStreamOptions vtuOptions = m_vtuOptions;
+        std::string header = m_name;
+        submitAsyncOutput([geometry, winfo, codex, multiSolidSTL, wformat, streamVTU, vtuOptions, header](){
+            writeFile(geometry, winfo, codex, multiSolidSTL, wformat, streamVTU, vtuOptions, header);
+        }, snapshot);
+        return true;
+    }
+
+    return writeFile(getGeometry().get(), m_winfo, m_codex, m_multiSolidSTL, m_wformat, m_streamVTU, m_vtuOptions, m_name);
+};
+
+/*!
+ * Write a geometry on file. It does not depend on the state of the object, so that
+ * it can write a snapshot of the geometry in background.
+ * \param[in] geometry geometry to be written
+ * \param[in] winfo info on the file to write
+ * \param[in] codex true binary, false ascii format
+ * \param[in] multiSolidSTL true to write a multi-solid STL file
+ * \param[in] wformat format of NAS files
+ * \param[in] streamVTU true to write binary serial VTU files in streaming mode
+ * \param[in] vtuOptions settings of VTU files written in streaming mode
+ * \param[in] header header of mimmo dump files
+ * \return False if the file type is not supported.
+ */
+bool
+MimmoGeometry::writeFile(MimmoObject * geometry, const FileDataInfo & winfo, bool codex, bool multiSolidSTL, WFORMAT wformat,
+                         bool streamVTU, const VTUStreamOptions & vtuOptions, const std::string & header){
+
+    switch(FileType::_from_integral(winfo.ftype)){
 
     case FileType::STL :
         //Export STL
     {
-        auto pidsMap = getGeometry()->getPIDTypeListWNames();
+        auto pidsMap = geometry->getPIDTypeListWNames();
         std::unordered_map<int, std::string> mpp;
         for(const auto & touple : pidsMap){
             mpp[touple.first] = touple.second;
         }
-        std::string name = (m_winfo.fdir+"/"+m_winfo.fname+".stl");
-        dynamic_cast<bitpit::SurfUnstructured*>(getGeometry()->getPatch())->exportSTL(name, m_codex, m_multiSolidSTL, &mpp);
+        std::string name = (winfo.fdir+"/"+winfo.fname+".stl");
+        dynamic_cast<bitpit::SurfUnstructured*>(geometry->getPatch())->exportSTL(name, codex, multiSolidSTL, &mpp);
         return true;
     }
     break;
@@ -549,16 +681,20 @@ MimmoGeometry::write(){
     case FileType::PCVTU:
         //Export Surface/Volume/3DCurve VTU
     {
-        if(!m_codex){
+        if(!codex){
             VTUFlushStreamerASCII streamer;
-            VTUGridWriterASCII vtkascii(streamer, *(getGeometry()->getPatch()) );
-            vtkascii.write(m_winfo.fdir+"/", m_winfo.fname);
+            VTUGridWriterASCII vtkascii(streamer, *(geometry->getPatch()) );
+            vtkascii.write(winfo.fdir+"/", winfo.fname);
+        }
+        else if(streamVTU && geometry->getProcessorCount() == 1){
+            VTUStreamWriter writer(vtuOptions);
+            writer.write(geometry, winfo.fdir+"/"+winfo.fname+".vtu");
         }
         else{
-            getGeometry()->getPatch()->getVTK().setCodex(bitpit::VTKFormat::APPENDED);
-            getGeometry()->getPatch()->getVTK().setDirectory(m_winfo.fdir+"/");
-            getGeometry()->getPatch()->getVTK().setName(m_winfo.fname);
-            getGeometry()->getPatch()->write();
+            geometry->getPatch()->getVTK().setCodex(bitpit::VTKFormat::APPENDED);
+            geometry->getPatch()->getVTK().setDirectory(winfo.fdir+"/");
+            geometry->getPatch()->getVTK().setName(winfo.fname);
+            geometry->getPatch()->write();
         }
         return true;
     }
@@ -571,10 +707,10 @@ MimmoGeometry::write(){
         // Beware if id >= 10^8 nas format does not support it.
     {
         lilimap mapDataInv;
-        dvecarr3E    points = getGeometry()->getVerticesCoords();
+        dvecarr3E    points = geometry->getVerticesCoords();
         livector1D   pointsID;
         pointsID.reserve(points.size());
-        bitpit::PiercedVector<bitpit::Vertex> & vertices = getGeometry()->getVertices();
+        bitpit::PiercedVector<bitpit::Vertex> & vertices = geometry->getVertices();
         long id;
         for(bitpit::Vertex & vv : vertices){
             id = vv.getId();
@@ -582,16 +718,16 @@ MimmoGeometry::write(){
             pointsID.push_back(id+1);
         }
         //return compactconnectivity using vertex map
-        livector2D   connectivity = getGeometry()->getCompactConnectivity(mapDataInv);
+        livector2D   connectivity = geometry->getCompactConnectivity(mapDataInv);
         livector1D   elementsID;
         elementsID.reserve(connectivity.size());
-        for(bitpit::Cell & cell : getGeometry()->getCells()){
+        for(bitpit::Cell & cell : geometry->getCells()){
             elementsID.push_back(cell.getId()+1);
         }
         NastranInterface nastran;
-        nastran.setWFormat(m_wformat);
-        livector1D pids = getGeometry()->getCompactPID();
-        std::unordered_set<long>  pidsset = getGeometry()->getPIDTypeList();
+        nastran.setWFormat(wformat);
+        livector1D pids = geometry->getCompactPID();
+        std::unordered_set<long>  pidsset = geometry->getPIDTypeList();
         // pid cannot be negative or 0 in NAS.
         if(pidsset.count(-1) > 0 || pidsset.count(0) > 0){
             std::unordered_set<long> temp;
@@ -604,16 +740,16 @@ MimmoGeometry::write(){
                 val+=offset;
             }
         }
-        std::string namefile = m_winfo.fname;
+        std::string namefile = winfo.fname;
 #if MIMMO_ENABLE_MPI
         // Only master rank 0 writes on file
-        if (getRank() == 0)
+        if (geometry->getRank() == 0)
 #endif
         {
             if (pids.size() == connectivity.size()){
-                nastran.write(m_winfo.fdir,namefile,points, pointsID, connectivity,elementsID, &pids, &pidsset);
+                nastran.write(winfo.fdir,namefile,points, pointsID, connectivity,elementsID, &pids, &pidsset);
             }else{
-                nastran.write(m_winfo.fdir,namefile,points, pointsID, connectivity, elementsID);
+                nastran.write(winfo.fdir,namefile,points, pointsID, connectivity, elementsID);
             }
         }
         return true;
@@ -645,14 +781,13 @@ MimmoGeometry::write(){
     	//Export in mimmo (bitpit) dump format
     {
     	int archiveVersion = 1;
-    	std::string header = m_name;
-    	std::string filename = (m_winfo.fdir+"/"+m_winfo.fname);
+    	std::string filename = (winfo.fdir+"/"+winfo.fname);
 #if MIMMO_ENABLE_MPI
-    	bitpit::OBinaryArchive binaryWriter(filename, "geomimmo", archiveVersion, header, getRank());
+    	bitpit::OBinaryArchive binaryWriter(filename, "geomimmo", archiveVersion, header, geometry->getRank());
 #else
     	bitpit::OBinaryArchive binaryWriter(filename, "geomimmo", archiveVersion, header);
 #endif
-    	getGeometry()->dump(binaryWriter.getStream());
+    	geometry->dump(binaryWriter.getStream());
     	binaryWriter.close();
     	return true;
     }
@@ -665,6 +800,40 @@ MimmoGeometry::write(){
     return false;
 };
 
+/*!
+ * Check if a STL stream is binary. A file whose size matches the number of facets declared
+ * in the binary header (84 + 50 bytes for each facet) is binary, even if its header starts
+ * with the ascii keyword "solid"; otherwise the file is ascii if it starts with "solid".
+ * The stream is rewound to its beginning.
+ * \param[in] in STL stream, opened in binary mode
+ * \return true if the STL stream is binary.
+ */
+bool
+MimmoGeometry::isBinarySTL(std::istream & in){
+    in.clear();
+    in.seekg(0, std::ios::end);
+    unsigned long long size = (unsigned long long)(in.tellg());
+    bool binary = false;
+    if (size >= 84){
+        std::uint32_t nFacets = 0;
+        in.seekg(80);
+        in.read(reinterpret_cast<char *>(&nFacets), sizeof(nFacets));
+        binary = in.good() && (size == 84 + 50 * (unsigned long long)(nFacets));
+    }
+    if (!binary){
+        in.clear();
+        in.seekg(0);
+        std::string ss, sstype;
+        std::getline(in, ss);
+        std::stringstream ins(ss);
+        ins >> sstype;
+        binary = !(sstype == "solid" || sstype == "SOLID");
+    }
+    in.clear();
+    in.seekg(0);
+    return binary;
+}
+
 /*!It reads the mesh geometry from an input file and reverse it in the internal
  * MimmoObject container. If an external container is linked skip reading and doing nothing.
  * \return False if file doesn't exists or not found geometry container address.
@@ -685,7 +854,15 @@ MimmoGeometry::read(){
         setGeometry(1);
         std::string name;
 #if MIMMO_ENABLE_MPI
-        if (getRank() == 0) {
+        if (m_parallelRead && getProcessorCount() > 1){
+            name = m_rinfo.fdir+"/"+m_rinfo.fname+".stl";
+            if (!fileExist(name)){
+                name = m_rinfo.fdir+"/"+m_rinfo.fname+".STL";
+            }
+            ParallelSurfaceReader reader(getCommunicator());
+            if (!reader.readSTL(name, getGeometry().get())) return false;
+        }
+        else if (getRank() == 0) {
 #endif
             {
                 name = m_rinfo.fdir+"/"+m_rinfo.fname+".stl";
@@ -697,14 +874,8 @@ MimmoGeometry::read(){
         		}
         	}
 
-        	std::ifstream in(name);
-        	std::string    ss, sstype;
-        	std::getline(in,ss);
-        	std::stringstream ins;
-        	ins << ss;
-        	ins >> sstype;
-        	bool binary = true;
-        	if (sstype == "solid" || sstype == "SOLID") binary = false;
+        	std::ifstream in(name, std::ios::binary);
+        	bool binary = isBinarySTL(in);
         	in.close();
 
         	std::unordered_map<int,std::string> mapPIDSolid;
@@ -747,10 +918,7 @@ MimmoGeometry::read(){
 
         if (!fileExist(name+extension)) return false;
 
-        VTUGridStreamer vtustreamer;
-        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
-
-        input.read() ;
+        readVTU(masterRankOnly);
 
         getGeometry()->resyncPID();
     }
@@ -778,10 +946,7 @@ MimmoGeometry::read(){
 
         if (!fileExist(name+extension)) return false;
 
-        VTUGridStreamer vtustreamer;
-        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
-
-        input.read() ;
+        readVTU(masterRankOnly);
 
         getGeometry()->resyncPID();
     }
@@ -792,7 +957,13 @@ MimmoGeometry::read(){
     {
         setGeometry(1);
 #if MIMMO_ENABLE_MPI
-    	if (getRank() == 0) {
+        if (m_parallelRead && getProcessorCount() > 1){
+            NastranInterface nastran;
+            nastran.setWFormat(m_wformat);
+            ParallelSurfaceReader reader(getCommunicator());
+            if (!reader.readNAS(m_rinfo.fdir+"/"+m_rinfo.fname+".nas", nastran, getGeometry().get())) return false;
+        }
+        else if (getRank() == 0) {
 #endif
         bool check = fileExist(m_rinfo.fdir+"/"+m_rinfo.fname+".nas");
         if (!check) return false;
@@ -863,10 +1034,7 @@ MimmoGeometry::read(){
 
         if (!fileExist(name+extension)) return false;
 
-        VTUGridStreamer vtustreamer;
-        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
-
-        input.read() ;
+        readVTU(masterRankOnly);
         getGeometry()->resyncPID();
     }
     break;
@@ -893,10 +1061,7 @@ MimmoGeometry::read(){
 
         if (!fileExist(name+extension)) return false;
 
-        VTUGridStreamer vtustreamer;
-        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
-
-        input.read() ;
+        readVTU(masterRankOnly);
 
         getGeometry()->resyncPID();
     }
@@ -961,6 +1126,27 @@ MimmoGeometry::fileExist(const std::string & filename){
     return  check;
 }
 
+/*!
+ * Read the VTU file of the reading info into the current geometry. In streaming mode, serial
+ * files are read by VTUStreamReader; files it does not support are read by VTUGridReader.
+ * \param[in] masterRankOnly true if a serial *.vtu file is read by the master rank only,
+ * false if a partitioned *.pvtu file is read by all the ranks
+ */
+void
+MimmoGeometry::readVTU(bool masterRankOnly){
+    bool streamed = false;
+    if(m_streamVTU && masterRankOnly && getGeometry()->getRank() == 0){
+        VTUStreamReader reader;
+        streamed = reader.read(m_rinfo.fdir+"/"+m_rinfo.fname+".vtu", getGeometry().get());
+    }
+    if(!streamed){
+        VTUGridStreamer vtustreamer;
+        VTUGridReader  input(m_rinfo.fdir, m_rinfo.fname, vtustreamer, *(getGeometry()->getPatch()), masterRankOnly);
+
+        input.read() ;
+    }
+}
+
 /*!Execution command.
  * It reads the geometry if the condition m_read is true.
  * It writes the geometry if the condition m_write is true.
@@ -1198,6 +1384,46 @@ MimmoGeometry::absorbSectionXML(const bitpit::Config::Section & slotXML, std::st
         setParallelRestore(value);
     };
 
+    if(slotXML.hasOption("ParallelRead")){
+        input = slotXML.get("ParallelRead");
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(bitpit::utils::string::trim(input));
+            ss >> value;
+        }
+        setParallelRead(value);
+    };
+
+    if(slotXML.hasOption("StreamVTU")){
+        input = slotXML.get("StreamVTU");
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(bitpit::utils::string::trim(input));
+            ss >> value;
+        }
+        setStreamVTU(value);
+    };
+
+    if(slotXML.hasOption("CompressVTU")){
+        input = slotXML.get("CompressVTU");
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(bitpit::utils::string::trim(input));
+            ss >> value;
+        }
+        setVTUCompression(value);
+    };
+
+    if(slotXML.hasOption("Float32VTU")){
+        input = slotXML.get("Float32VTU");
+        bool value = false;
+        if(!input.empty()){
+            std::stringstream ss(bitpit::utils::string::trim(input));
+            ss >> value;
+        }
+        setVTUFloat32(value);
+    };
+
 };
 
 /*!
@@ -1268,6 +1494,13 @@ MimmoGeometry::flushSectionXML(bitpit::Config::Section & slotXML, std::string na
     output = std::to_string(m_parallelRestore);
     slotXML.set("ParallelRestore", output);
 
+    output = std::to_string(m_parallelRead);
+    slotXML.set("ParallelRead", output);
+
+    slotXML.set("StreamVTU", std::to_string(m_streamVTU));
+    slotXML.set("CompressVTU", std::to_string(m_vtuOptions.compress));
+    slotXML.set("Float32VTU", std::to_string(m_vtuOptions.float32));
+
 };
 
 
@@ -1575,7 +1808,18 @@ void NastranInterface::write(std::string& outputDir, std::string& surfaceName, d
 
 //========READ====//
 /*!
- * Read a bdf nastran file
+ * Cards read from a chunk of a nastran file.
+ */
+struct NastranChunk{
+    dvecarr3E points;       /**< GRID points coordinates */
+    livector1D pointsID;    /**< GRID points labels */
+    livector2D faces;       /**< element-point connectivity */
+    livector1D facesID;     /**< element labels */
+    livector1D PIDS;        /**< element part identifiers */
+};
+
+/*!
+ * Read a bdf nastran file. The file is parsed in chunks, concurrently.
  * \param[in] inputDir    input directory
  * \param[in] surfaceName    input filename
  * \param[out] points    reference of a point container that has to be filled
@@ -1587,7 +1831,60 @@ void NastranInterface::write(std::string& outputDir, std::string& surfaceName, d
 void NastranInterface::read(std::string& inputDir, std::string& surfaceName, dvecarr3E& points, livector1D & pointsID,
                             livector2D& faces, livector1D & facesID, livector1D& PIDS){
 
-    std::ifstream is(inputDir +"/"+surfaceName + ".nas");
+    points.clear();
+    pointsID.clear();
+    faces.clear();
+    facesID.clear();
+    PIDS.clear();
+
+    text::FileBuffer file(inputDir +"/"+surfaceName + ".nas");
+    if (!file.isOpen()) return;
+
+    // Parse the cards in line-aligned chunks, concurrently. A card belongs to the chunk
+    // containing its first line, continuation lines are read past the chunk end.
+    std::vector<NastranChunk> chunks = text::parseChunks<NastranChunk>(file.begin(), file.end(),
+                                                                       [this, &file](const char * begin, const char * end, NastranChunk & chunk){
+        text::MemoryStreamBuffer buffer(begin, file.end());
+        std::istream is(&buffer);
+        read(is, std::streamoff(end - begin), chunk.points, chunk.pointsID, chunk.faces, chunk.facesID, chunk.PIDS);
+    });
+
+    std::size_t nPoints = 0, nFaces = 0;
+    for (const NastranChunk & chunk : chunks){
+        nPoints += chunk.points.size();
+        nFaces += chunk.faces.size();
+    }
+    points.reserve(nPoints);
+    pointsID.reserve(nPoints);
+    faces.reserve(nFaces);
+    facesID.reserve(nFaces);
+    PIDS.reserve(nFaces);
+    for (NastranChunk & chunk : chunks){
+        points.insert(points.end(), chunk.points.begin(), chunk.points.end());
+        pointsID.insert(pointsID.end(), chunk.pointsID.begin(), chunk.pointsID.end());
+        std::move(chunk.faces.begin(), chunk.faces.end(), std::back_inserter(faces));
+        facesID.insert(facesID.end(), chunk.facesID.begin(), chunk.facesID.end());
+        PIDS.insert(PIDS.end(), chunk.PIDS.begin(), chunk.PIDS.end());
+    }
+
+}
+
+/*!
+ * Read the cards of a bdf nastran stream, starting from the current position of the stream.
+ * Only the cards whose first line starts before the stream offset end are read; a card
+ * starting before end is read as a whole, continuation lines included. The stream
+ * has to be positioned at the beginning of a line.
+ * It allows to read a nastran file in separated byte ranges, e.g. by different processes.
+ * \param[in,out] is   input stream
+ * \param[in] end      stream offset where reading of new cards stops
+ * \param[out] points    reference of a point container that has to be filled
+ * \param[out] pointsID  reference to a label point container to be filled
+ * \param[out] faces     reference to element-point connectivity that has to be filled
+ * \param[out] facesID  reference to a label element container to be filled
+ * \param[out] PIDS        reference to long int vector for Part Identifier storage
+ */
+void NastranInterface::read(std::istream & is, std::streamoff end, dvecarr3E& points, livector1D & pointsID,
+                            livector2D& faces, livector1D & facesID, livector1D& PIDS){
 
     points.clear();
     pointsID.clear();
@@ -1603,6 +1900,15 @@ void NastranInterface::read(std::string& inputDir, std::string& surfaceName, dve
     std::string sread;
     std::string ssub = trim(sread.substr(0,8));
 
+    // track the offset of the line start, counting the characters extracted by getline
+    std::streamoff nextLineStart = is.tellg();
+    std::streamoff lineStart = nextLineStart;
+    auto getline = [&](std::istream & stream, std::string & line){
+        lineStart = nextLineStart;
+        std::getline(stream, line);
+        nextLineStart += std::streamoff(line.size() + 1);
+    };
+
     while(!is.eof()){
         while(((ssub != "GRID" && ssub != "GRID*") || !isEnabled(NastranElementType::GRID)) &&
                 ((ssub != "CTRIA3" && ssub != "CTRIA3*") || !isEnabled(NastranElementType::CTRIA)) &&
@@ -1611,93 +1917,95 @@ void NastranInterface::read(std::string& inputDir, std::string& surfaceName, dve
                 (ssub != "RBE3" || !isEnabled(NastranElementType::RBE3)) &&
                 (ssub != "CBAR" || !isEnabled(NastranElementType::CBAR)) &&
                 !is.eof()){
-            std::getline(is,sread);
+            getline(is,sread);
             ssub = trim(sread.substr(0,8));
         }
+        // cards starting after the end of the range belong to the next one.
+        if(lineStart >= end) break;
         if(ssub == "GRID"){
-            ipoint = stoi(sread.substr(8,8));
-            point[0] = stod(convertVertex(trim(sread.substr(24,8))));
-            point[1] = stod(convertVertex(trim(sread.substr(32,8))));
-            point[2] = stod(convertVertex(trim(sread.substr(40,8))));
+            ipoint = readInteger(sread, 8, 8);
+            point[0] = readReal(sread, 24, 8);
+            point[1] = readReal(sread, 32, 8);
+            point[2] = readReal(sread, 40, 8);
             points.push_back(point);
             pointsID.push_back(ipoint);
-            std::getline(is,sread);
+            getline(is,sread);
             ssub = trim(sread.substr(0,8));
         }
         else if(ssub == "GRID*"){
-            ipoint = stoi(sread.substr(16,16));
-            point[0] = stod(convertVertex(trim(sread.substr(48,16))));
-            point[1] = stod(convertVertex(trim(sread.substr(64,16))));
-            point[2] = stod(convertVertex(trim(sread.substr(80,16))));
+            ipoint = readInteger(sread, 16, 16);
+            point[0] = readReal(sread, 48, 16);
+            point[1] = readReal(sread, 64, 16);
+            point[2] = readReal(sread, 80, 16);
             points.push_back(point);
             pointsID.push_back(ipoint);
-            std::getline(is,sread);
+            getline(is,sread);
             ssub = trim(sread.substr(0,8));
         }
         else if(ssub == "CTRIA3"){
             face.resize(3);
-            iface = stoi(sread.substr(8,8));
-            pid   = stoi(sread.substr(16,8));
-            face[0] = stoi(sread.substr(24,8));
-            face[1] = stoi(sread.substr(32,8));
-            face[2] = stoi(sread.substr(40,8));
+            iface = readInteger(sread, 8, 8);
+            pid   = readInteger(sread, 16, 8);
+            face[0] = readInteger(sread, 24, 8);
+            face[1] = readInteger(sread, 32, 8);
+            face[2] = readInteger(sread, 40, 8);
             faces.push_back(face);
             facesID.push_back(iface);
             PIDS.push_back(pid);
-            std::getline(is,sread);
+            getline(is,sread);
             ssub = trim(sread.substr(0,8));
         }
         else if(ssub == "CTRIA3*"){
             face.resize(3);
-            iface = stoi(sread.substr(16,16));
-            pid   = stoi(sread.substr(32,16));
-            face[0] = stoi(sread.substr(48,16));
-            face[1] = stoi(sread.substr(64,16));
-            face[2] = stoi(sread.substr(80,16));
+            iface = readInteger(sread, 16, 16);
+            pid   = readInteger(sread, 32, 16);
+            face[0] = readInteger(sread, 48, 16);
+            face[1] = readInteger(sread, 64, 16);
+            face[2] = readInteger(sread, 80, 16);
             faces.push_back(face);
             facesID.push_back(iface);
             PIDS.push_back(pid);
-            std::getline(is,sread);
+            getline(is,sread);
             ssub = trim(sread.substr(0,8));
         }
         else if(ssub == "CQUAD4"){
             face.resize(4);
-            iface = stoi(sread.substr(8,8));
-            pid = stoi(sread.substr(16,8));
-            face[0] = stoi(sread.substr(24,8));
-            face[1] = stoi(sread.substr(32,8));
-            face[2] = stoi(sread.substr(40,8));
-            face[3] = stoi(sread.substr(48,8));
+            iface = readInteger(sread, 8, 8);
+            pid = readInteger(sread, 16, 8);
+            face[0] = readInteger(sread, 24, 8);
+            face[1] = readInteger(sread, 32, 8);
+            face[2] = readInteger(sread, 40, 8);
+            face[3] = readInteger(sread, 48, 8);
             faces.push_back(face);
             facesID.push_back(iface);
             PIDS.push_back(pid);
-            std::getline(is,sread);
+            getline(is,sread);
             ssub = trim(sread.substr(0,8));
         }
         else if(ssub == "CQUAD4*"){
             face.resize(4);
-            iface = stoi(sread.substr(16,16));
-            pid = stoi(sread.substr(32,16));
-            face[0] = stoi(sread.substr(48,16));
-            face[1] = stoi(sread.substr(64,16));
-            face[2] = stoi(sread.substr(80,16));
-            face[3] = stoi(sread.substr(96,16));
+            iface = readInteger(sread, 16, 16);
+            pid = readInteger(sread, 32, 16);
+            face[0] = readInteger(sread, 48, 16);
+            face[1] = readInteger(sread, 64, 16);
+            face[2] = readInteger(sread, 80, 16);
+            face[3] = readInteger(sread, 96, 16);
             faces.push_back(face);
             facesID.push_back(iface);
             PIDS.push_back(pid);
-            std::getline(is,sread);
+            getline(is,sread);
             ssub = trim(sread.substr(0,8));
         }
         else if(ssub == "CBAR"){
             face.resize(2);
-            iface = stoi(sread.substr(8,8));
-            pid = stoi(sread.substr(16,8));
-            face[0] = stoi(sread.substr(24,8));
-            face[1] = stoi(sread.substr(32,8));
+            iface = readInteger(sread, 8, 8);
+            pid = readInteger(sread, 16, 8);
+            face[0] = readInteger(sread, 24, 8);
+            face[1] = readInteger(sread, 32, 8);
             faces.push_back(face);
             facesID.push_back(iface);
             PIDS.push_back(pid);
-            std::getline(is,sread);
+            getline(is,sread);
             ssub = trim(sread.substr(0,8));
         }
         else if(ssub == "RBE3"){
@@ -1769,8 +2077,6 @@ void NastranInterface::read(std::string& inputDir, std::string& surfaceName, dve
         }
 
     }
-    is.close();
-
 }
 
 /*!
@@ -1812,6 +2118,59 @@ NastranInterface::convertVertex(std::string in){
     return in;
 }
 
+/*!
+ * Read an integer from a fixed-width field of a nas line, as std::stoi(line.substr(pos, length)).
+ * \param[in] line input line
+ * \param[in] pos position of the field
+ * \param[in] length length of the field
+ * \return integer value
+ */
+long
+NastranInterface::readInteger(const std::string & line, std::size_t pos, std::size_t length){
+    if (pos > line.size()) throw std::out_of_range("NastranInterface::readInteger");
+    const char * cursor = line.data() + pos;
+    long value;
+    if (!text::parse(cursor, line.data() + std::min(line.size(), pos + length), value)){
+        throw std::invalid_argument("NastranInterface::readInteger");
+    }
+    return value;
+}
+
+/*!
+ * Read a float from a fixed-width field of a nas line, accepting the nas exponent
+ * notation without E (e.g. 1.0-5), as std::stod(convertVertex(trim(line.substr(pos, length)))).
+ * \param[in] line input line
+ * \param[in] pos position of the field
+ * \param[in] length length of the field
+ * \return float value
+ */
+double
+NastranInterface::readReal(const std::string & line, std::size_t pos, std::size_t length){
+    if (pos > line.size()) throw std::out_of_range("NastranInterface::readReal");
+    const char * begin = line.data() + pos;
+    const char * end = line.data() + std::min(line.size(), pos + length);
+    text::skipBlanks(begin, end);
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+
+    char field[40];
+    std::size_t size = std::min(std::size_t(end - begin), sizeof(field) - 2);
+    std::memcpy(field, begin, size);
+    field[size] = '\0';
+    char * sign = std::strrchr(field, '-');
+    if (sign == nullptr || sign == field) sign = std::strrchr(field, '+');
+    if (sign != nullptr && sign != field && sign[-1] != 'E' && sign[-1] != 'e'){
+        std::memmove(sign + 1, sign, std::size_t(field + size + 1 - sign));
+        *sign = 'E';
+        ++size;
+    }
+    const char * cursor = field;
+    double value;
+    if (!text::parse(cursor, field + size, value)){
+        throw std::invalid_argument("NastranInterface::readReal");
+    }
+    return value;
+}
+
 /*!
  * Append records of given length of an input line in a records structure
  * \param[in] sread input line given as string
@@ -1931,10 +2290,12 @@ NastranInterface::isInteger(std::string & str){
 bool
 NastranInterface::isEnabled(NastranElementType type){
     // If not in the map return false
-    if (!m_enabled.count(type)){
+    // If not in the map return false; lookup only, the method is called by concurrent readers
+    auto it = m_enabled.find(type);
+    if (it == m_enabled.end()){
         return false;
     }
-    return m_enabled[type];
+    return it->second;
 }
 
 /*!
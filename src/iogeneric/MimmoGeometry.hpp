@@ -25,9 +25,11 @@
 #define __MIMMOGEOMETRY_HPP__
 
 #include "BaseManipulation.hpp"
+#include "VTUStreamIO.hpp"
 #include "enum.hpp"
 #include <typeinfo>
 #include <type_traits>
+#include <istream>
 
 BETTER_ENUM(FileType, int, STL = 0, SURFVTU = 1, VOLVTU = 2, NAS = 3, PCVTU = 4, CURVEVTU = 5, MIMMO = 99);
 
@@ -76,6 +78,17 @@ enum WFORMAT{
  * has to be coherent with the restored geometry, i.e. it has to be known a-priori by the user.
  * Default value of the feature is true (parallel) in case of MPI enabled when reading a mimmo dumping format geometry.
  *
+ * STL and Nastran files are read by default by the master rank 0 only. When MPI is enabled they can be read
+ * in parallel (setParallelRead): each process reads a part of the file and the duplicated vertices are merged
+ * among the processes, so that the resulting geometry is already partitioned, ghost cells included
+ * (see ParallelSurfaceReader).
+ *
+ * Binary VTU files can be written and read in streaming mode (setStreamVTU): data are encoded/decoded in
+ * blocks of fixed size directly from/to the geometry (see VTUStreamWriter and VTUStreamReader). Written files
+ * can be compressed with zlib, if mimmo is built with zlib support, and can store point coordinates in single
+ * precision. Streaming mode is applied to serial files only; files not supported by the streaming reader
+ * (e.g. ascii or partitioned ones) are read in the standard way.
+ *
  *  \n
  *  It can be used in three modes reader/writer/converter. To set the mode it uses an enum
  *  IOMode list:
@@ -142,6 +155,10 @@ enum WFORMAT{
  * - <B>Clean</B>: clean the geometry after read true 1/false 0;
  * - <B>FormatNAS</B>: 0-singlePrecision 1-doubleprecision for writing nas files;
  * - <B>ParallelRestore</B>: set if the read geometry is parallel true 1/false 0;
+ * - <B>ParallelRead</B>: read STL/Nastran files in parallel by all the processes true 1/false 0 (default 0);
+ * - <B>StreamVTU</B>: read/write binary VTU files in streaming mode true 1/false 0 (default 0);
+ * - <B>CompressVTU</B>: compress VTU files written in streaming mode true 1/false 0 (default 0);
+ * - <B>Float32VTU</B>: write point coordinates of VTU files in streaming mode in single precision true 1/false 0 (default 0);
 
  *
  * In case of writing mode Geometry has to be mandatorily passed through port.
@@ -169,6 +186,9 @@ protected:
     bool        m_clean;                    /**<Set if the geometry has to cleaned after reading. */
 
     bool        m_parallelRestore;               /**<Set if the geometry to read is parallel. */
+    bool        m_parallelRead;                  /**<Set if STL/Nastran files are read in parallel by all the processes. */
+    bool        m_streamVTU;                     /**<Set if binary VTU files are read/written in streaming mode. */
+    VTUStreamOptions m_vtuOptions;               /**<Settings of VTU files written in streaming mode. */
 
 public:
     /*!
@@ -212,6 +232,10 @@ public:
     void 		setTolerance(double tol);
     void        setClean(bool clean = true);
     void        setParallelRestore(bool parallelRestore = MIMMO_ENABLE_MPI);
+    void        setParallelRead(bool parallelRead = true);
+    void        setStreamVTU(bool stream = true);
+    void        setVTUCompression(bool compress = true);
+    void        setVTUFloat32(bool float32 = true);
 
     using BaseManipulation::setGeometry;
     void        setGeometry(int type=1);
@@ -234,6 +258,8 @@ public:
     bool        write();
     bool        read();
 
+    static bool isBinarySTL(std::istream & in);
+
     void         execute();
 
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name="");
@@ -241,12 +267,16 @@ public:
 
 protected:
     void swap(MimmoGeometry & x) noexcept;
+    std::vector<std::string> getInputFiles();
     void        setIOMode(IOMode mode);
     void        setIOMode(int mode);
     void    setDefaults();
     void    _setRead(bool read = true);
     void    _setWrite(bool write = true);
     bool   fileExist(const std::string & filename);
+    void    readVTU(bool masterRankOnly);
+    static bool writeFile(MimmoObject * geometry, const FileDataInfo & winfo, bool codex, bool multiSolidSTL, WFORMAT wformat,
+                          bool streamVTU, const VTUStreamOptions & vtuOptions, const std::string & header);
 
 };
 
@@ -273,9 +303,12 @@ public:
     void writeFooter(std::ofstream& os, std::unordered_set<long>* PIDSSET = nullptr);
     void write(std::string& outputDir, std::string& surfaceName, dvecarr3E& points, livector1D& pointsID, livector2D& faces, livector1D& facesID, livector1D* PIDS = nullptr, std::unordered_set<long>* PIDSSET = nullptr);
     void read(std::string& inputDir, std::string& surfaceName, dvecarr3E& points, livector1D& pointsID, livector2D& faces, livector1D& facesID, livector1D& PIDS);
+    void read(std::istream & is, std::streamoff end, dvecarr3E& points, livector1D& pointsID, livector2D& faces, livector1D& facesID, livector1D& PIDS);
 
     std::string trim(std::string in);
     std::string convertVertex(std::string in);
+    long        readInteger(const std::string & line, std::size_t pos, std::size_t length);
+    double      readReal(const std::string & line, std::size_t pos, std::size_t length);
 
     void appendLineRecords(std::string & sread, std::size_t recordlength, std::vector<std::string> & records);
     void absorbRBE2(std::vector<std::string> & records, long & ID, long & PID, std::vector<long> & connectivity, std::string & components);
@@ -0,0 +1,614 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "ParallelSurfaceReader.hpp"
+
+#if MIMMO_ENABLE_MPI
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <unordered_set>
+
+namespace mimmo{
+
+/*!
+ * Hasher of vertex coordinates, comparing them bitwise. It selects the process owning a STL vertex.
+ */
+struct CoordsHasher{
+    /*!
+     * \param[in] coords vertex coordinates
+     * \return hash of the coordinates.
+     */
+    std::size_t operator()(const darray3E & coords) const{
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (double value : coords){
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ULL;
+            hash ^= (hash >> 29);
+        }
+        return std::size_t(hash);
+    }
+};
+
+/*!
+ * Constructor.
+ * \param[in] communicator MPI communicator of the processes reading the file
+ */
+ParallelSurfaceReader::ParallelSurfaceReader(MPI_Comm communicator) : m_communicator(communicator){
+    MPI_Comm_rank(m_communicator, &m_rank);
+    MPI_Comm_size(m_communicator, &m_nProcs);
+}
+
+/*!
+ * Read a STL file, ascii or binary, and fill the empty surface geometry with its partition.
+ * In multi-solid ascii files, the facets of the i-th solid get PID i and the solid name is
+ * assigned to the PID. Collective on the communicator.
+ * \param[in] filename path of the STL file
+ * \param[in,out] geometry empty surface geometry to be filled
+ * \return true if the file has been read by all the processes.
+ */
+bool
+ParallelSurfaceReader::readSTL(const std::string & filename, MimmoObject * geometry){
+
+    std::ifstream in(filename, std::ios::binary);
+    bool good = in.is_open();
+
+    std::vector<darray3E> coords;
+    livector1D localSolids;
+    std::vector<std::string> localNames;
+    long firstFacet = 0;
+    bool binary = true;
+    if (good){
+        binary = MimmoGeometry::isBinarySTL(in);
+
+        if (binary){
+            good = readSTLBinary(in, coords, firstFacet);
+        }else{
+            good = readSTLASCII(in, coords, localSolids, localNames);
+        }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &good, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
+    if (!good) return false;
+
+    long nFacets = long(coords.size() / 3);
+    livector1D pids(nFacets, 0);
+    std::vector<std::string> solidNames;
+    if (!binary){
+        firstFacet = exscan(nFacets);
+
+        // Facets read before the first local solid keyword belong to the last solid of the previous processes
+        long solidOffset = exscan(long(localNames.size()));
+        for (long i = 0; i < nFacets; ++i){
+            pids[i] = std::max(long(0), solidOffset + localSolids[i]);
+        }
+
+        // Share the solid names
+        std::string names;
+        for (const std::string & name : localNames){
+            names += name + '\n';
+        }
+        int nChars = int(names.size());
+        std::vector<int> counts(m_nProcs), displs(m_nProcs, 0);
+        MPI_Allgather(&nChars, 1, MPI_INT, counts.data(), 1, MPI_INT, m_communicator);
+        for (int rank = 1; rank < m_nProcs; ++rank){
+            displs[rank] = displs[rank-1] + counts[rank-1];
+        }
+        std::string allNames(std::size_t(displs.back() + counts.back()), ' ');
+        MPI_Allgatherv(names.data(), nChars, MPI_CHAR, &allNames[0], counts.data(), displs.data(), MPI_CHAR, m_communicator);
+        std::stringstream namesStream(allNames);
+        std::string name;
+        while (std::getline(namesStream, name)){
+            solidNames.push_back(name);
+        }
+    }
+
+    // Merge duplicated vertices locally, then on the owner process
+    std::unordered_map<darray3E, std::size_t, CoordsHasher> localIndex;
+    std::vector<std::size_t> connectivity(coords.size());
+    std::vector<const darray3E *> uniqueCoords;
+    for (std::size_t i = 0; i < coords.size(); ++i){
+        auto result = localIndex.emplace(coords[i], uniqueCoords.size());
+        if (result.second){
+            uniqueCoords.push_back(&(result.first->first));
+        }
+        connectivity[i] = result.first->second;
+    }
+
+    std::vector<std::vector<VertexRecord>> sendVertices(m_nProcs);
+    std::vector<std::pair<int, std::size_t>> ownerPosition(uniqueCoords.size());
+    CoordsHasher hasher;
+    for (std::size_t i = 0; i < uniqueCoords.size(); ++i){
+        const darray3E & point = *uniqueCoords[i];
+        int owner = int(hasher(point) % std::size_t(m_nProcs));
+        ownerPosition[i] = std::make_pair(owner, sendVertices[owner].size());
+        sendVertices[owner].push_back(VertexRecord{bitpit::Vertex::NULL_ID, {point[0], point[1], point[2]}});
+    }
+    std::vector<std::vector<VertexRecord>> recvVertices = exchangeRecords(sendVertices);
+
+    std::unordered_map<darray3E, long, CoordsHasher> ownedIndex;
+    std::vector<std::vector<int>> ownedRanks;
+    std::vector<std::vector<long>> replyIds(m_nProcs);
+    for (int rank = 0; rank < m_nProcs; ++rank){
+        replyIds[rank].reserve(recvVertices[rank].size());
+        for (const VertexRecord & vertex : recvVertices[rank]){
+            darray3E point({{vertex.coords[0], vertex.coords[1], vertex.coords[2]}});
+            auto result = ownedIndex.emplace(point, long(ownedRanks.size()));
+            if (result.second){
+                ownedRanks.emplace_back();
+            }
+            ownedRanks[result.first->second].push_back(rank);
+            replyIds[rank].push_back(result.first->second);
+        }
+    }
+    long idOffset = exscan(long(ownedRanks.size()));
+    std::unordered_map<long, std::vector<int>> referencingRanks;
+    for (std::size_t i = 0; i < ownedRanks.size(); ++i){
+        if (ownedRanks[i].size() > 1){
+            referencingRanks[idOffset + long(i)] = ownedRanks[i];
+        }
+    }
+    for (std::vector<long> & ids : replyIds){
+        for (long & id : ids){
+            id += idOffset;
+        }
+    }
+    std::vector<std::vector<long>> recvIds = exchangeRecords(replyIds);
+
+    // Fill the geometry
+    bitpit::PatchKernel * patch = geometry->getPatch();
+    patch->reserveVertices(uniqueCoords.size());
+    patch->reserveCells(std::size_t(nFacets));
+    livector1D vertexIds(uniqueCoords.size());
+    for (std::size_t i = 0; i < uniqueCoords.size(); ++i){
+        vertexIds[i] = recvIds[ownerPosition[i].first][ownerPosition[i].second];
+        geometry->addVertex(*uniqueCoords[i], vertexIds[i]);
+    }
+    livector1D conn(3);
+    for (long i = 0; i < nFacets; ++i){
+        for (std::size_t k = 0; k < 3; ++k){
+            conn[k] = vertexIds[connectivity[3*i+k]];
+        }
+        geometry->addConnectedCell(conn, bitpit::ElementType::TRIANGLE, pids[i], firstFacet + i);
+    }
+
+    buildGhosts(geometry, shareVertices(referencingRanks));
+
+    geometry->resyncPID();
+    for (std::size_t i = 0; i < solidNames.size(); ++i){
+        geometry->setPIDName(long(i), solidNames[i]);
+    }
+
+    return true;
+}
+
+/*!
+ * Read a Nastran file and fill the empty surface geometry with its partition. Collective on the communicator.
+ * \param[in] filename path of the Nastran file
+ * \param[in] nastran Nastran interface used to read the cards
+ * \param[in,out] geometry empty surface geometry to be filled
+ * \return true if the file has been read by all the processes.
+ */
+bool
+ParallelSurfaceReader::readNAS(const std::string & filename, NastranInterface & nastran, MimmoObject * geometry){
+
+    std::ifstream in(filename, std::ios::binary);
+    bool good = in.is_open();
+
+    dvecarr3E points;
+    livector1D pointsID;
+    livector2D faces;
+    livector1D facesID;
+    livector1D pids;
+    std::streamoff begin, end;
+    if (good && alignToLine(in, begin, end)){
+        nastran.read(in, end, points, pointsID, faces, facesID, pids);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &good, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
+    if (!good) return false;
+
+    auto owner = [this](long id){
+        return int(((id % m_nProcs) + m_nProcs) % m_nProcs);
+    };
+
+    // Send the GRID points to their owner process
+    std::vector<std::vector<VertexRecord>> sendPoints(m_nProcs);
+    for (std::size_t i = 0; i < points.size(); ++i){
+        sendPoints[owner(pointsID[i])].push_back(VertexRecord{pointsID[i], {points[i][0], points[i][1], points[i][2]}});
+    }
+    points.clear();
+    pointsID.clear();
+    std::unordered_map<long, darray3E> ownedPoints;
+    {
+        std::vector<std::vector<VertexRecord>> recvPoints = exchangeRecords(sendPoints);
+        for (const std::vector<VertexRecord> & records : recvPoints){
+            for (const VertexRecord & point : records){
+                ownedPoints[point.id] = darray3E({{point.coords[0], point.coords[1], point.coords[2]}});
+            }
+        }
+    }
+
+    // Request the points referenced by the local elements
+    std::unordered_set<long> referenced;
+    for (const livector1D & face : faces){
+        for (std::size_t k = (face.size() > 4 ? 1 : 0); k < face.size(); ++k){
+            referenced.insert(face[k]);
+        }
+    }
+    std::vector<std::vector<long>> requests(m_nProcs);
+    for (long id : referenced){
+        requests[owner(id)].push_back(id);
+    }
+    std::vector<std::vector<long>> recvRequests = exchangeRecords(requests);
+
+    std::unordered_map<long, std::vector<int>> referencingRanks;
+    std::vector<std::vector<VertexRecord>> replies(m_nProcs);
+    for (int rank = 0; rank < m_nProcs; ++rank){
+        for (long id : recvRequests[rank]){
+            auto it = ownedPoints.find(id);
+            if (it == ownedPoints.end()){
+                replies[rank].push_back(VertexRecord{bitpit::Vertex::NULL_ID, {0., 0., 0.}});
+                continue;
+            }
+            replies[rank].push_back(VertexRecord{id, {it->second[0], it->second[1], it->second[2]}});
+            referencingRanks[id].push_back(rank);
+        }
+    }
+    std::vector<std::vector<VertexRecord>> recvReplies = exchangeRecords(replies);
+
+    // Fill the geometry
+    bitpit::PatchKernel * patch = geometry->getPatch();
+    patch->reserveVertices(referenced.size());
+    patch->reserveCells(faces.size());
+    for (const std::vector<VertexRecord> & records : recvReplies){
+        for (const VertexRecord & vertex : records){
+            if (vertex.id == bitpit::Vertex::NULL_ID) continue;
+            geometry->addVertex(darray3E({{vertex.coords[0], vertex.coords[1], vertex.coords[2]}}), vertex.id);
+        }
+    }
+
+    bitpit::ElementType eltype;
+    const bitpit::PiercedVector<bitpit::Vertex> & vertices = geometry->getVertices();
+    for (std::size_t i = 0; i < faces.size(); ++i){
+        const livector1D & cc = faces[i];
+        std::size_t ccsize = cc.size();
+        bool complete = true;
+        for (std::size_t k = (ccsize > 4 ? 1 : 0); k < ccsize; ++k){
+            complete = complete && vertices.exists(cc[k]);
+        }
+        // elements referencing missing GRID points are skipped
+        if (!complete) continue;
+
+        eltype = bitpit::ElementType::UNDEFINED;
+        if(ccsize == 1)  eltype = bitpit::ElementType::VERTEX;
+        if(ccsize == 2)  eltype = bitpit::ElementType::LINE;
+        if(ccsize == 3)  eltype = bitpit::ElementType::TRIANGLE;
+        if(ccsize == 4)  eltype = bitpit::ElementType::QUAD;
+        if(ccsize > 4)   eltype = bitpit::ElementType::POLYGON;
+
+        geometry->addConnectedCell(cc, eltype, pids[i], facesID[i]);
+    }
+
+    for (auto it = referencingRanks.begin(); it != referencingRanks.end();){
+        if (it->second.size() < 2){
+            it = referencingRanks.erase(it);
+        }else{
+            ++it;
+        }
+    }
+    buildGhosts(geometry, shareVertices(referencingRanks));
+
+    geometry->resyncPID();
+
+    return true;
+}
+
+/*!
+ * Exchange records between all the processes of the communicator.
+ * \param[in] sendRecords records to be sent to each process
+ * \return records received from each process.
+ */
+template<typename T>
+std::vector<std::vector<T>>
+ParallelSurfaceReader::exchangeRecords(const std::vector<std::vector<T>> & sendRecords){
+
+    MPI_Datatype recordType;
+    MPI_Type_contiguous(int(sizeof(T)), MPI_BYTE, &recordType);
+    MPI_Type_commit(&recordType);
+
+    std::vector<int> sendCounts(m_nProcs), recvCounts(m_nProcs);
+    std::vector<int> sendDispls(m_nProcs, 0), recvDispls(m_nProcs, 0);
+    for (int rank = 0; rank < m_nProcs; ++rank){
+        sendCounts[rank] = int(sendRecords[rank].size());
+    }
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, m_communicator);
+    for (int rank = 1; rank < m_nProcs; ++rank){
+        sendDispls[rank] = sendDispls[rank-1] + sendCounts[rank-1];
+        recvDispls[rank] = recvDispls[rank-1] + recvCounts[rank-1];
+    }
+
+    std::vector<T> sendBuffer;
+    sendBuffer.reserve(std::size_t(sendDispls.back() + sendCounts.back()));
+    for (const std::vector<T> & records : sendRecords){
+        sendBuffer.insert(sendBuffer.end(), records.begin(), records.end());
+    }
+    std::vector<T> recvBuffer(std::size_t(recvDispls.back() + recvCounts.back()));
+    MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), recordType,
+                  recvBuffer.data(), recvCounts.data(), recvDispls.data(), recordType, m_communicator);
+    MPI_Type_free(&recordType);
+
+    std::vector<std::vector<T>> recvRecords(m_nProcs);
+    for (int rank = 0; rank < m_nProcs; ++rank){
+        recvRecords[rank].assign(recvBuffer.begin() + recvDispls[rank], recvBuffer.begin() + recvDispls[rank] + recvCounts[rank]);
+    }
+    return recvRecords;
+}
+
+/*!
+ * \param[in] value local value
+ * \return sum of the values of the processes with lower rank.
+ */
+long
+ParallelSurfaceReader::exscan(long value){
+    long result = 0;
+    MPI_Exscan(&value, &result, 1, MPI_LONG, MPI_SUM, m_communicator);
+    if (m_rank == 0) result = 0;
+    return result;
+}
+
+/*!
+ * Evaluate the byte range of the file assigned to the current process and position the
+ * stream at the first line starting inside the range.
+ * \param[in,out] in input file stream
+ * \param[out] begin offset of the first line starting inside the range
+ * \param[out] end end offset of the range
+ * \return false if no line starts inside the range.
+ */
+bool
+ParallelSurfaceReader::alignToLine(std::ifstream & in, std::streamoff & begin, std::streamoff & end){
+
+    in.clear();
+    in.seekg(0, std::ios::end);
+    unsigned long long size = static_cast<unsigned long long>(in.tellg());
+    begin = std::streamoff(size * m_rank / m_nProcs);
+    end = std::streamoff(size * (m_rank + 1) / m_nProcs);
+
+    if (begin == 0){
+        in.seekg(0);
+        return end > 0;
+    }
+
+    // skip the line containing the byte before the range, it belongs to a previous process
+    in.seekg(begin - 1);
+    std::string line;
+    std::getline(in, line);
+    if (!in.good()){
+        in.clear();
+        return false;
+    }
+    begin += std::streamoff(line.size());
+    return begin < end;
+}
+
+/*!
+ * Read the facets of the current process from a binary STL file.
+ * \param[in,out] in input file stream
+ * \param[out] coords coordinates of the vertices of the facets, three for each facet
+ * \param[out] firstFacet global index of the first facet read
+ * \return false if the file is corrupted.
+ */
+bool
+ParallelSurfaceReader::readSTLBinary(std::ifstream & in, std::vector<darray3E> & coords, long & firstFacet){
+
+    std::uint32_t nFacets = 0;
+    in.seekg(80);
+    in.read(reinterpret_cast<char *>(&nFacets), sizeof(nFacets));
+    if (!in.good()) return false;
+
+    long begin = long((unsigned long long)(nFacets) * m_rank / m_nProcs);
+    long end = long((unsigned long long)(nFacets) * (m_rank + 1) / m_nProcs);
+    firstFacet = begin;
+    coords.reserve(std::size_t(3 * (end - begin)));
+
+    // each record holds normal, three vertices as float32 and a 2-bytes attribute
+    const long recordSize = 50;
+    const long blockSize = 4096;
+    std::vector<char> buffer;
+    in.seekg(std::streamoff(84 + recordSize * begin));
+    for (long block = begin; block < end; block += blockSize){
+        long nRecords = std::min(blockSize, end - block);
+        buffer.resize(std::size_t(recordSize * nRecords));
+        in.read(buffer.data(), std::streamsize(buffer.size()));
+        if (!in.good()) return false;
+        for (long i = 0; i < nRecords; ++i){
+            const char * record = buffer.data() + recordSize * i + 12;
+            for (int v = 0; v < 3; ++v){
+                darray3E point;
+                for (int k = 0; k < 3; ++k){
+                    float value;
+                    std::memcpy(&value, record + 12 * v + 4 * k, sizeof(float));
+                    // sum zero to merge negative zeros with positive ones
+                    point[k] = double(value) + 0.0;
+                }
+                coords.push_back(point);
+            }
+        }
+    }
+    return true;
+}
+
+/*!
+ * Read the facets of the current process from an ascii STL file.
+ * \param[in,out] in input file stream
+ * \param[out] coords coordinates of the vertices of the facets, three for each facet
+ * \param[out] solids index of the local solid of each facet; -1 if the facet belongs to a solid started by a previous process
+ * \param[out] solidNames names of the solids started by the current process
+ * \return false if the file is corrupted.
+ */
+bool
+ParallelSurfaceReader::readSTLASCII(std::ifstream & in, std::vector<darray3E> & coords, livector1D & solids,
+                                    std::vector<std::string> & solidNames){
+
+    std::streamoff begin, end;
+    if (!alignToLine(in, begin, end)) return true;
+
+    std::streamoff lineStart = begin;
+    std::string line, keyword;
+    bool inFacet = false;
+    std::size_t facetBegin = 0;
+    while (std::getline(in, line)){
+        std::streamoff start = lineStart;
+        lineStart += std::streamoff(line.size() + 1);
+        // a facet starting inside the range is read as a whole
+        if (start >= end && !inFacet) break;
+
+        std::size_t keyBegin = line.find_first_not_of(" \t\r");
+        if (keyBegin == std::string::npos) continue;
+        std::size_t keyEnd = std::min(line.find_first_of(" \t\r", keyBegin), line.size());
+        keyword = line.substr(keyBegin, keyEnd - keyBegin);
+        std::transform(keyword.begin(), keyword.end(), keyword.begin(), ::tolower);
+
+        // the lines of a facet started by a previous process are skipped
+        if (!inFacet && (keyword == "vertex" || keyword == "endfacet")) continue;
+
+        if (keyword == "vertex"){
+            darray3E point;
+            const char * cursor = line.c_str() + keyEnd;
+            for (int k = 0; k < 3; ++k){
+                char * next;
+                // sum zero to merge negative zeros with positive ones
+                point[k] = std::strtod(cursor, &next) + 0.0;
+                if (next == cursor) return false;
+                cursor = next;
+            }
+            coords.push_back(point);
+        }else if (keyword == "facet"){
+            inFacet = true;
+            facetBegin = coords.size();
+        }else if (keyword == "endfacet"){
+            if (coords.size() != facetBegin + 3) return false;
+            inFacet = false;
+            solids.push_back(long(solidNames.size()) - 1);
+        }else if (keyword == "solid"){
+            solidNames.push_back(bitpit::utils::string::trim(line.substr(keyEnd)));
+        }
+    }
+    return !inFacet;
+}
+
+/*!
+ * Distribute the sharing information of the vertices, collected by their owner processes.
+ * \param[in] referencingRanks ranks of the processes referencing each owned vertex shared by more processes
+ * \return for each local vertex shared with other processes, the ranks of the other processes.
+ */
+std::unordered_map<long, std::vector<int>>
+ParallelSurfaceReader::shareVertices(const std::unordered_map<long, std::vector<int>> & referencingRanks){
+
+    std::vector<std::vector<SharingRecord>> sendSharing(m_nProcs);
+    for (const auto & entry : referencingRanks){
+        for (int rank : entry.second){
+            for (int other : entry.second){
+                if (other != rank){
+                    sendSharing[rank].push_back(SharingRecord{entry.first, other});
+                }
+            }
+        }
+    }
+    std::vector<std::vector<SharingRecord>> recvSharing = exchangeRecords(sendSharing);
+
+    std::unordered_map<long, std::vector<int>> sharedWith;
+    for (const std::vector<SharingRecord> & records : recvSharing){
+        for (const SharingRecord & record : records){
+            sharedWith[record.id].push_back(record.rank);
+        }
+    }
+    return sharedWith;
+}
+
+/*!
+ * Send to the other processes, as ghosts, the local cells having at least one vertex shared with
+ * them, receive the ghost cells of the current process and update the geometry.
+ * \param[in,out] geometry partitioned geometry
+ * \param[in] sharedWith for each local vertex shared with other processes, the ranks of the other processes
+ */
+void
+ParallelSurfaceReader::buildGhosts(MimmoObject * geometry, const std::unordered_map<long, std::vector<int>> & sharedWith){
+
+    std::vector<std::unordered_set<long>> ghostCells(m_nProcs);
+    for (const bitpit::Cell & cell : geometry->getCells()){
+        for (long vertexId : cell.getVertexIds()){
+            auto it = sharedWith.find(vertexId);
+            if (it == sharedWith.end()) continue;
+            for (int rank : it->second){
+                ghostCells[rank].insert(cell.getId());
+            }
+        }
+    }
+
+    std::vector<std::vector<CellRecord>> sendCells(m_nProcs);
+    std::vector<std::vector<VertexRecord>> sendVertices(m_nProcs);
+    for (int rank = 0; rank < m_nProcs; ++rank){
+        for (long cellId : ghostCells[rank]){
+            const bitpit::Cell & cell = geometry->getCells()[cellId];
+            bitpit::ConstProxyVector<long> cellVertexIds = cell.getVertexIds();
+            sendCells[rank].push_back(CellRecord{cellId, long(cell.getPID()), int(cell.getType()), int(cellVertexIds.size())});
+            for (long vertexId : cellVertexIds){
+                const darray3E & point = geometry->getVertexCoords(vertexId);
+                sendVertices[rank].push_back(VertexRecord{vertexId, {point[0], point[1], point[2]}});
+            }
+        }
+    }
+    std::vector<std::vector<CellRecord>> recvCells = exchangeRecords(sendCells);
+    std::vector<std::vector<VertexRecord>> recvVertices = exchangeRecords(sendVertices);
+
+    livector1D conn;
+    for (int rank = 0; rank < m_nProcs; ++rank){
+        std::size_t counter = 0;
+        for (const CellRecord & cell : recvCells[rank]){
+            bitpit::ElementType type = static_cast<bitpit::ElementType>(cell.type);
+            conn.clear();
+            if (type == bitpit::ElementType::POLYGON){
+                conn.push_back(cell.nVertices);
+            }
+            for (int i = 0; i < cell.nVertices; ++i){
+                const VertexRecord & vertex = recvVertices[rank][counter++];
+                if (!geometry->getVertices().exists(vertex.id)){
+                    geometry->addVertex(darray3E({{vertex.coords[0], vertex.coords[1], vertex.coords[2]}}), vertex.id);
+                }
+                conn.push_back(vertex.id);
+            }
+            geometry->addConnectedCell(conn, type, cell.pid, cell.id, rank);
+        }
+    }
+
+    geometry->update();
+}
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+#ifndef __PARALLELSURFACEREADER_HPP__
+#define __PARALLELSURFACEREADER_HPP__
+
+#include "MimmoGeometry.hpp"
+
+#if MIMMO_ENABLE_MPI
+
+#include <mpi.h>
+#include <fstream>
+
+namespace mimmo{
+
+/*!
+ * \class ParallelSurfaceReader
+ * \ingroup iogeneric
+ * \brief ParallelSurfaceReader reads STL and Nastran surface meshes with all the processes of a communicator.
+ *
+ * Each process reads a contiguous part of the file: binary STL files are split by facet records,
+ * ascii STL and Nastran files by byte ranges aligned to the beginning of a line. A facet/card
+ * belongs to the process whose range contains its first line.
+ *
+ * Vertices are merged with a distributed hash table: each vertex is owned by the process selected by
+ * a hash of its coordinates (STL) or of its GRID id (Nastran), which assigns the global vertex id and
+ * collects the list of processes referencing it. Every process keeps as internal cells the elements it
+ * has read, and receives as ghosts the elements of the other processes sharing at least one vertex
+ * with its own ones. The resulting MimmoObject is already partitioned.
+ *
+ * Vertices and cells maintain unique ids across the processes: STL facets are labeled with their
+ * global position in the file, Nastran elements and GRID points with their own ids.
+ * GRID points not referenced by any element are not added to the geometry.
+ *
+ * The class is available only with MPI enabled.
+ */
+class ParallelSurfaceReader{
+
+public:
+    ParallelSurfaceReader(MPI_Comm communicator);
+
+    bool    readSTL(const std::string & filename, MimmoObject * geometry);
+    bool    readNAS(const std::string & filename, NastranInterface & nastran, MimmoObject * geometry);
+
+private:
+    /*!
+     * Vertex record exchanged between processes.
+     */
+    struct VertexRecord{
+        long    id;         /**< global vertex id */
+        double  coords[3];  /**< vertex coordinates */
+    };
+
+    /*!
+     * Cell record exchanged between processes.
+     */
+    struct CellRecord{
+        long    id;         /**< cell id */
+        long    pid;        /**< cell part identifier */
+        int     type;       /**< cell bitpit::ElementType */
+        int     nVertices;  /**< number of vertices of the cell */
+    };
+
+    /*!
+     * Record of a vertex shared with another process.
+     */
+    struct SharingRecord{
+        long    id;         /**< global vertex id */
+        int     rank;       /**< rank of the process sharing the vertex */
+    };
+
+    MPI_Comm    m_communicator; /**< MPI communicator */
+    int         m_rank;         /**< rank of the current process */
+    int         m_nProcs;       /**< number of processes of the communicator */
+
+    template<typename T>
+    std::vector<std::vector<T>> exchangeRecords(const std::vector<std::vector<T>> & sendRecords);
+
+    long        exscan(long value);
+    bool        alignToLine(std::ifstream & in, std::streamoff & begin, std::streamoff & end);
+
+    bool        readSTLBinary(std::ifstream & in, std::vector<darray3E> & coords, long & firstFacet);
+    bool        readSTLASCII(std::ifstream & in, std::vector<darray3E> & coords, livector1D & solids,
+                             std::vector<std::string> & solidNames);
+
+    std::unordered_map<long, std::vector<int>> shareVertices(const std::unordered_map<long, std::vector<int>> & referencingRanks);
+    void        buildGhosts(MimmoObject * geometry, const std::unordered_map<long, std::vector<int>> & sharedWith);
+};
+
+}
+
+#endif
+
+#endif /* __PARALLELSURFACEREADER_HPP__ */
@@ -34,11 +34,13 @@
 
 #include "mimmo_core.hpp"
 
+#include "FieldContainer.hpp"
 #include "GenericDispls.hpp"
 #include "GenericInput.hpp"
 #include "GenericOutput.hpp"
 #include "IOCloudPoints.hpp"
 #include "MimmoGeometry.hpp"
+#include "ParallelSurfaceReader.hpp"
 #include "IOWavefrontOBJ.hpp"
 #include "CreatePointCloud.hpp"
 #include "Create3DCurve.hpp"
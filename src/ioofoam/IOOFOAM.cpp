@@ -23,6 +23,8 @@
 \*---------------------------------------------------------------------------*/
 #include "IOOFOAM.hpp"
 #include "openFoamFiles_native.hpp"
+#include "openFoamFiles_raw.hpp"
+#include <numeric>
 #include <processorCyclicFvPatch.H>
 
 namespace mimmo{
@@ -335,6 +337,7 @@ IOOFOAM::IOOFOAM(MimmoSharedPointer<MimmoObject> bulk, MimmoSharedPointer<MimmoO
     m_name = "mimmo.IOOFOAM";
     m_overwrite= false;
     m_writepointsonly = true;
+    m_directread = false;
 };
 
 /*!
@@ -345,6 +348,7 @@ IOOFOAM::IOOFOAM(const bitpit::Config::Section & rootXML){
 
 	m_name = "mimmo.IOOFOAM";
     m_overwrite= false;
+    m_directread = false;
     std::string fallback_name = "ClassNONE";
 	std::string input = rootXML.get("ClassName", fallback_name);
 	input = bitpit::utils::string::trim(input);
@@ -379,6 +383,9 @@ IOOFOAM::IOOFOAM(const IOOFOAM & other):IOOFOAM_Kernel(other){
     m_writepointsonly = other.m_writepointsonly;
 	m_path = other.m_path;
 	m_overwrite = other.m_overwrite;
+	m_directread = other.m_directread;
+	m_pointsorder = other.m_pointsorder;
+	m_labelsize = other.m_labelsize;
 	m_OFbitpitmapfaces = other.m_OFbitpitmapfaces;
 };
 
@@ -398,6 +405,9 @@ void IOOFOAM::swap(IOOFOAM & x) noexcept
 {
 	std::swap(m_overwrite, x.m_overwrite);
     std::swap(m_writepointsonly, x.m_writepointsonly);
+    std::swap(m_directread, x.m_directread);
+    std::swap(m_pointsorder, x.m_pointsorder);
+    std::swap(m_labelsize, x.m_labelsize);
 	IOOFOAM_Kernel::swap(x);
 };
 
@@ -408,6 +418,7 @@ void
 IOOFOAM::setDefaults(){
 	m_overwrite = false;
     m_writepointsonly = true;
+    m_directread = false;
     IOOFOAM_Kernel::setDefaults();
 }
 
@@ -483,6 +494,27 @@ IOOFOAM::getOverwrite(){
 	return m_overwrite;
 }
 
+/*!
+ * Set direct read parameter. This option is valid only in read mode.
+ * If true the polyMesh files of the case are parsed directly and the subdomains of
+ * a decomposed case are read concurrently, whatever the number of MPI processes.
+ * If false the mesh is read through the OpenFOAM libraries.
+ * \param[in] flag activation flag.
+ */
+void
+IOOFOAM::setDirectRead(bool flag){
+	m_directread = flag;
+}
+
+/*!
+ * Get DirectRead parameter. See setDirectRead method.
+ * \return direct read parameter content
+ */
+bool
+IOOFOAM::getDirectRead(){
+	return m_directread;
+}
+
 
 /*!
  * It sets infos reading from a XML bitpit::Config::section.
@@ -515,6 +547,15 @@ IOOFOAM::absorbSectionXML(const bitpit::Config::Section & slotXML, std::string n
 		}
 		setOverwrite(value);
 	};
+	if(slotXML.hasOption("DirectRead")){
+		input = slotXML.get("DirectRead");
+		bool value = false;
+		if(!input.empty()){
+			std::stringstream ss(bitpit::utils::string::trim(input));
+			ss >> value;
+		}
+		setDirectRead(value);
+	};
 };
 
 /*!
@@ -530,6 +571,7 @@ IOOFOAM::flushSectionXML(bitpit::Config::Section & slotXML, std::string name){
 	IOOFOAM_Kernel::flushSectionXML(slotXML, name);
     slotXML.set("WritePointsOnly", std::to_string(m_overwrite));
     slotXML.set("Overwrite", std::to_string(m_overwrite));
+    slotXML.set("DirectRead", std::to_string(m_directread));
 };
 
 /*!Execution command.
@@ -559,6 +601,11 @@ IOOFOAM::execute(){
 bool
 IOOFOAM::read(){
 
+    if(m_directread){
+        if(readDirect()) return true;
+        (*m_log)<<"WARNING: "<<m_name<<" cannot read directly the OpenFOAM case at "<<m_path<<". Reading it with OpenFOAM libraries."<<std::endl;
+    }
+
     //instantiate my bulk geometry container
     m_geometry = MimmoSharedPointer<MimmoObject>(new MimmoObject(2));
     MimmoSharedPointer<MimmoObject> mesh = m_geometry;
@@ -659,438 +706,674 @@ IOOFOAM::read(){
 
 	// Build ghost cells only in case of multi-processors run
 	if (getProcessorCount() > 1){
+	    buildGhostCells(mesh);
+	}
 
-	    // Build Ghost Cells from boundary cells of patches of type processor boundary
+    // Update mesh
+    mesh->update();
 
-	    // Recovering boundary nodes for each partition
-	    std::vector<long> boundary_vertices = mesh->extractBoundaryVertexID();
+#endif
 
-	    // Communicate boundary vertices to all other partitions
-	    std::unordered_map<int, std::vector<long>*> boundaryVertexExchangeSources;
-	    std::unordered_map<int, bitpit::PiercedVector<bitpit::Vertex> > receivedBoundaryVertices;
+    mesh->updateAdjacencies();
+    mesh->updateInterfaces();
+    mesh->update();
 
-	    // Fill map to communicate
-	    for (int irank = 0; irank < getProcessorCount(); irank++){
-	        if (irank != getRank()){
-	            boundaryVertexExchangeSources[irank] = &boundary_vertices;
-	        }
-	    }
+    // TODO bitpit sort is bugged
+    // Sort cells and vertices
+//    mesh->getPatch()->sortVertices();
+//    mesh->getPatch()->sortCells();
 
-	    {
-	        // Send boundary vertices
-	        std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
-	        dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
+    bitpit::PiercedVector<bitpit::Cell> & bitCells = mesh->getCells();
+    bitpit::PiercedVector<bitpit::Interface> & bitInterfaces = mesh->getInterfaces();
 
-	        for (auto & entry : boundaryVertexExchangeSources){
+    forAll(faces, iOF){
 
-	            int target_rank = entry.first;
-	            std::vector<long> & vertexList = *entry.second;
+        std::vector<long> vListOF(faces[iOF].size());
+        forAll(faces[iOF], index){
+            vListOF[index] = long(faces[iOF][index]);
+        }
+        std::sort(vListOF.begin(), vListOF.end());
 
-	            // Prepare buffer for source cells and vertices of the source cells
-	            size_t vertexBufferSize = 0;
-	            for (long vertexId : vertexList){
-	                vertexBufferSize += mesh->getPatch()->getVertex(vertexId).getBinarySize();
-	            }
-	            dataCommunicator->setSend(target_rank, sizeof(size_t) + vertexBufferSize);
-	            bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(target_rank);
+        long iDC = long(faceOwner[iOF]);
+        long * bitFaceList = bitCells[iDC].getInterfaces();
+        std::size_t sizeFList = bitCells[iDC].getInterfaceCount();
 
-	            // Fill the buffer with the source cells and vertices
-	            buffer << vertexList.size();
-	            for (long vertexId : vertexList){
-	                buffer << mesh->getPatch()->getVertex(vertexId);
-	            }
-	            dataCommunicator->startSend(target_rank);
+        long iBIT = bitpit::Interface::NULL_ID;
+        std::size_t j(0);
+        while(iBIT < 0 && j<sizeFList){
+            bitpit::ConstProxyVector<long> vconn = bitInterfaces[bitFaceList[j]].getVertexIds();
+            std::vector<long> vListBIT(vconn.begin(), vconn.end());
+            std::sort(vListBIT.begin(), vListBIT.end());
 
-	        }
+            if(std::equal(vListBIT.begin(), vListBIT.end(), vListOF.begin()) ){
+                iBIT = bitFaceList[j];
+            }else{
+                ++j;
+            }
+        }
+        m_OFbitpitmapfaces.insert(std::make_pair(long(iOF),iBIT) );
+    }
 
-	        // Discover & start all the receives
-	        dataCommunicator->discoverRecvs();
-	        dataCommunicator->startAllRecvs();
-
-	        // Receive the target boundary vertices
-	        int nCompletedRecvs = 0;
-	        while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
-	            int source_rank = dataCommunicator->waitAnyRecv();
-	            bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(source_rank);
-
-	            // Receive boundary vertices from mesh partitions
-	            std::size_t vertexCount;
-	            buffer >> vertexCount;
-	            receivedBoundaryVertices[source_rank].reserve(vertexCount);
-	            for (std::size_t ivertex = 0; ivertex < vertexCount; ivertex++){
-	                bitpit::Vertex boundaryVertex;
-	                buffer >> boundaryVertex;
-	                receivedBoundaryVertices[source_rank].insert(boundaryVertex.getId(), boundaryVertex);
-	            }
 
-	            ++nCompletedRecvs;
-	        }
-	        // Wait for the sends to finish
-	        dataCommunicator->waitAllSends();
+	// From MimmoObject utilities, create the raw boundary mesh, storing it in m_boundary internal member.
+	// PID will be every where 0. Need to be compiled to align with patch division of foamBoundaryMesh.
+	// Every cell of the boundary mesh will have the same id of the border interfaces of the bulk.
+    m_boundary = mesh->extractBoundaryMesh();
 
-	    }
+	//Once OFoam faces and bitpit Interfaces link is set,
+	//Extract boundary patch info from foamBoundary and
+	// get boundary patch division automatically pidding the class boundary mesh.
 
-	    // Update kdtree
-	    if (mesh->getKdTreeSyncStatus() != SyncStatus::SYNC){
-	        mesh->buildKdTree();
-	    }
+	const Foam::fvBoundaryMesh &foamBMesh = foamMesh->boundary();
+	long startIndex;
+	long endIndex;
 
-	    // Found list of vertices coincident
-	    // with received boundary vertices for each partition
+	forAll(foamBMesh, iBoundary){
+		long PID = long(iBoundary+1);
+		startIndex = foamBMesh[iBoundary].patch().start();
+		endIndex = startIndex + long(foamBMesh[iBoundary].patch().size());
+        for(long ind=startIndex; ind<endIndex; ++ind){
+            m_boundary->setPIDCell(m_OFbitpitmapfaces[ind], PID);
+		}
+        m_boundary->setPIDName(PID,foamBMesh[iBoundary].name().c_str());
+	}
+	m_boundary->resyncPID();
 
-	    // Initialize ghost cells to communicate to each processor
-	    std::unordered_map<int, long> ghostVertexExchangeSourcesCount;
-	    std::unordered_map<int, std::unordered_set<long>> ghostCellExchangeSources;
-	    std::unordered_map<int, std::unordered_set<long>> vertexCellExchangeSources;
+	// Update bounfary mesh
+	m_boundary->update();
 
-	    // Loop over received bounday vertices for rank
-	    for (int irank = 0; irank < getProcessorCount(); irank ++){
+	// Destroy interfaces to save memory
+	m_geometry->destroyInterfaces();
 
-	        if (irank == getRank()) continue;
+	return true;
 
-	        long received_vertices_count = receivedBoundaryVertices[irank].size();
-	        std::vector<long> coincident_vertices;
-	        coincident_vertices.reserve(received_vertices_count);
+}
 
-	        // Check received vertices with local kdtree
-	        for (bitpit::Vertex vertex : receivedBoundaryVertices[irank]){
+/*!
+ * Get the paths of the subdomains of the case handled by the current process.
+ * The processor directories of a decomposed case are distributed in contiguous blocks among
+ * the processes; an undecomposed case is handled by the process of rank 0.
+ * \param[out] decomposed true if the case is decomposed
+ * \return paths of the processor directories of the process, or the path of the case
+ */
+std::vector<std::string>
+IOOFOAM::getSubdomainPaths(bool & decomposed){
 
-	            long coincident_vertex_id = bitpit::Vertex::NULL_ID;
-	            mesh->getKdTree()->exist(&vertex, coincident_vertex_id);
-	            if (coincident_vertex_id != bitpit::Vertex::NULL_ID){
-	                coincident_vertices.push_back(coincident_vertex_id);
-	            }
-	            coincident_vertices.shrink_to_fit();
+    int nProcs = getProcessorCount();
+    int rank = getRank();
 
-	        }
+    int nSubdomains = foamUtilsRaw::countProcessorDirectories(m_path);
+    decomposed = (nSubdomains > 0);
+    if(!decomposed) nSubdomains = 1;
+    int firstSubdomain = int((long(rank) * nSubdomains + nProcs - 1) / nProcs);
+    int lastSubdomain  = int((long(rank + 1) * nSubdomains + nProcs - 1) / nProcs);
+
+    std::vector<std::string> casePaths;
+    for(int subdomain = firstSubdomain; subdomain < lastSubdomain; ++subdomain){
+        casePaths.push_back(decomposed ? m_path + "/processor" + std::to_string(subdomain) : m_path);
+    }
+    return casePaths;
+}
 
-	        // Extract local source cells those are ghost cells for i-th rank
-	        std::vector<long> ghosts = mesh->getCellFromVertexList(coincident_vertices, false);
+/*!
+ * It reads the OpenFOAM mesh parsing directly the polyMesh files of the case, without
+ * OpenFOAM libraries, and stores it in the class structures m_bulk and m_boundary.
+ * The processor directories of a decomposed case are distributed in contiguous blocks among
+ * the processes, whatever their number; the subdomains of each process are read concurrently
+ * and merged through the addressing written by decomposePar, so that vertices and cells get the
+ * ids of the undecomposed mesh. An undecomposed case is read by the process of rank 0.
+ * The mesh is read at the start time of the case.
+ * \return false if the files of the case are not supported; the class structures are not modified in that case.
+ */
+bool
+IOOFOAM::readDirect(){
+
+    int nProcs = getProcessorCount();
+
+    // Read the local subdomains concurrently
+    bool decomposed;
+    std::vector<std::string> casePaths = getSubdomainPaths(decomposed);
+    std::size_t nLocal = casePaths.size();
+    std::string timeName = foamUtilsRaw::getStartTime(m_path, decomposed);
+    std::vector<foamUtilsRaw::PolyMesh> subdomains(nLocal);
+    std::vector<int> status(nLocal, 0);
+    threads::parallelFor(0, nLocal, [&](std::size_t begin, std::size_t end){
+        for(std::size_t i = begin; i < end; ++i){
+            status[i] = int(foamUtilsRaw::readPolyMesh(casePaths[i], timeName, subdomains[i], decomposed));
+        }
+    }, 1);
 
-	        // Fill communication structures
-	        ghostVertexExchangeSourcesCount[irank] = 0;
-	        for (long cellId : ghosts){
-	            ghostCellExchangeSources[irank].insert(cellId);
-	            for (long vertexId : mesh->getPatch()->getCell(cellId).getVertexIds()){
-	                vertexCellExchangeSources[irank].insert(vertexId);
-	                ghostVertexExchangeSourcesCount[irank]++;
-	            }
-	        }
+    bool success = true;
+    for(int flag : status){
+        success = success && (flag != 0);
+    }
+#if MIMMO_ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &success, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
+#endif
+    if(!success) return false;
 
-	    }
+    //instantiate my bulk geometry container
+    m_geometry = MimmoSharedPointer<MimmoObject>(new MimmoObject(2));
+    MimmoSharedPointer<MimmoObject> mesh = m_geometry;
+    m_OFbitpitmapfaces.clear();
+    m_pointsorder.clear();
+    m_labelsize.clear();
+
+    std::size_t nVertices = 0, nCells = 0;
+    for(const foamUtilsRaw::PolyMesh & subdomain : subdomains){
+        nVertices += subdomain.points.size();
+        nCells += std::size_t(subdomain.nCells);
+    }
+    mesh->getPatch()->reserveVertices(nVertices);
+    mesh->getPatch()->reserveCells(nCells);
+
+    std::vector<std::vector<long>> cellOffsets(nLocal), cellFaces(nLocal);
+    long PID = 0;
+    livector1D conn, shape, faceVertices;
+    for(std::size_t i = 0; i < nLocal; ++i){
+
+        const foamUtilsRaw::PolyMesh & subdomain = subdomains[i];
+        const std::vector<long> & pointIds = subdomain.pointAddressing;
+
+        //absorbing mesh nodes/points, the ones shared with a previous subdomain are skipped.
+        darray3E coords;
+        long nPoints = long(subdomain.points.size());
+        livector1D & pointsOrder = m_pointsorder[casePaths[i]];
+        pointsOrder.resize(nPoints);
+        m_labelsize[casePaths[i]] = subdomain.labelSize;
+        for(long in = 0; in < nPoints; ++in){
+            for (int k = 0; k < 3; k++) {
+                coords[k] = subdomain.points[in][k];
+            }
+            pointsOrder[in] = decomposed ? pointIds[in] : in;
+            mesh->addVertex(coords, pointsOrder[in]);
+        }
 
+        //absorbing cells.
+        foamUtilsRaw::getCellFaces(subdomain, cellOffsets[i], cellFaces[i]);
+        for(long iC = 0; iC < subdomain.nCells; ++iC){
 
-	    {
-	        // Send number of vertices
-	        std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
-	        dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
+            const long * faces = cellFaces[i].data() + cellOffsets[i][iC];
+            std::size_t nFaces = std::size_t(cellOffsets[i][iC + 1] - cellOffsets[i][iC]);
+            std::string eleshape = foamUtilsRaw::getCellShape(subdomain, faces, nFaces, shape);
+            bitpit::ElementType eltype;
+            conn.clear();
 
-	        for (auto & entry : ghostCellExchangeSources){
+            if(m_OFE_supp.count(eleshape) > 0){
+                eltype = m_OFE_supp[eleshape];
+                if(decomposed){
+                    for(long & vertex : shape) vertex = pointIds[vertex];
+                }
+                conn = foamUtilsNative::mapEleVConnectivity(shape, eltype);
+            }else{
+                eltype = bitpit::ElementType::POLYHEDRON;
+                // faces are oriented with normal pointing outwards the cell.
+                conn.push_back(long(nFaces));
+                for(std::size_t locC = 0; locC < nFaces; ++locC){
+                    foamUtilsRaw::getFaceVertices(subdomain, faces[locC], faceVertices);
+                    conn.push_back(long(faceVertices.size()));
+                    for(long vertex : faceVertices){
+                        conn.push_back(decomposed ? pointIds[vertex] : vertex);
+                    }
+                }
+            }
+            mesh->addConnectedCell(conn, eltype, PID, decomposed ? subdomain.cellAddressing[iC] : iC);
+        }
+    }
 
-	            int target_rank = entry.first;
-	            std::unordered_set<long> & vertexList = vertexCellExchangeSources[target_rank];
+#if MIMMO_ENABLE_MPI
 
-	            // Prepare buffer for source vertices
-	            long vertexCount = vertexList.size();
+    // Build ghost cells only in case of multi-processors run
+    if (nProcs > 1){
+        buildGhostCells(mesh);
+    }
 
-	            dataCommunicator->setSend(target_rank, vertexCount*sizeof(long));
-	            bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(target_rank);
+    // Update mesh
+    mesh->update();
 
-	            // Fill the buffer with the source  vertices
-	            buffer << vertexCount;
-	            dataCommunicator->startSend(target_rank);
-	        }
+#endif
 
-	        // Discover & start all the receives
-	        dataCommunicator->discoverRecvs();
-	        dataCommunicator->startAllRecvs();
+    mesh->updateAdjacencies();
+    mesh->updateInterfaces();
+    mesh->update();
 
-	        // Receive the target count vertices
+    bitpit::PiercedVector<bitpit::Cell> & bitCells = mesh->getCells();
+    bitpit::PiercedVector<bitpit::Interface> & bitInterfaces = mesh->getInterfaces();
 
-	        int nCompletedRecvs = 0;
-	        while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
-	            int source_rank = dataCommunicator->waitAnyRecv();
-	            bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(source_rank);
+    // Map OpenFOAM faces, with their id in the undecomposed mesh, to bitpit interfaces.
+    std::vector<std::vector<long>> faceIds(nLocal);
+    for(std::size_t i = 0; i < nLocal; ++i){
 
-	            long vertexCount;
-	            buffer >> vertexCount;
+        const foamUtilsRaw::PolyMesh & subdomain = subdomains[i];
+        long nFaces = subdomain.getFaceCount();
+        faceIds[i].resize(nFaces);
+        for(long iOF = 0; iOF < nFaces; ++iOF){
 
-	            ghostVertexExchangeSourcesCount[source_rank] = vertexCount;
+            long faceId = decomposed ? std::abs(subdomain.faceAddressing[iOF]) - 1 : iOF;
+            faceIds[i][iOF] = faceId;
+            if(m_OFbitpitmapfaces.count(faceId) > 0) continue;
 
-	            ++nCompletedRecvs;
-	        }
-	        // Wait for the sends to finish
-	        dataCommunicator->waitAllSends();
+            std::vector<long> vListOF(subdomain.faceVertices.begin() + subdomain.faceOffsets[iOF],
+                                      subdomain.faceVertices.begin() + subdomain.faceOffsets[iOF + 1]);
+            if(decomposed){
+                for(long & vertex : vListOF) vertex = subdomain.pointAddressing[vertex];
+            }
+            std::sort(vListOF.begin(), vListOF.end());
+
+            long iDC = decomposed ? subdomain.cellAddressing[subdomain.owner[iOF]] : subdomain.owner[iOF];
+            long * bitFaceList = bitCells[iDC].getInterfaces();
+            std::size_t sizeFList = bitCells[iDC].getInterfaceCount();
+
+            long iBIT = bitpit::Interface::NULL_ID;
+            std::size_t j(0);
+            while(iBIT < 0 && j<sizeFList){
+                bitpit::ConstProxyVector<long> vconn = bitInterfaces[bitFaceList[j]].getVertexIds();
+                std::vector<long> vListBIT(vconn.begin(), vconn.end());
+                std::sort(vListBIT.begin(), vListBIT.end());
+
+                if(vListBIT.size() == vListOF.size() && std::equal(vListBIT.begin(), vListBIT.end(), vListOF.begin()) ){
+                    iBIT = bitFaceList[j];
+                }else{
+                    ++j;
+                }
+            }
+            m_OFbitpitmapfaces.insert(std::make_pair(faceId, iBIT));
+        }
+    }
 
-	    } // end communication of receive vertex count
+    // From MimmoObject utilities, create the raw boundary mesh, storing it in m_boundary internal member.
+    // Every cell of the boundary mesh will have the same id of the border interfaces of the bulk.
+    m_boundary = mesh->extractBoundaryMesh();
 
+    // Pid the boundary mesh following the physical patches of the subdomains.
+    // Processor patches are internal to the undecomposed mesh and they are skipped.
+    for(std::size_t i = 0; i < nLocal; ++i){
+        const std::vector<foamUtilsRaw::PolyPatch> & patches = subdomains[i].patches;
+        for(std::size_t iBoundary = 0; iBoundary < patches.size(); ++iBoundary){
+            if(patches[iBoundary].isProcessor()) continue;
+            long PID = long(iBoundary+1);
+            long startIndex = patches[iBoundary].startFace;
+            long endIndex = startIndex + patches[iBoundary].nFaces;
+            for(long ind=startIndex; ind<endIndex; ++ind){
+                m_boundary->setPIDCell(m_OFbitpitmapfaces[faceIds[i][ind]], PID);
+            }
+            m_boundary->setPIDName(PID, patches[iBoundary].name);
+        }
+    }
+    m_boundary->resyncPID();
 
-	    // Force re-build kdTree of vertices with new over-sized reserved vertex container
-	    mesh->buildKdTree();
+    // Update boundary mesh
+    m_boundary->update();
 
-	    // Instantiate a to_insert structure for unique received vertices for each sending rank
-	    // Initialize a kdTree tree for the received ghost vertices
-	    std::unordered_map< long , std::vector<bitpit::Vertex> > unique_ghosts;
-	    for (auto entry : ghostVertexExchangeSourcesCount){
-	        unique_ghosts[entry.first].reserve(entry.second);
-	    }
-	    bitpit::KdTree<3, bitpit::Vertex, std::pair<int, long> > ghost_tree;
+    // Destroy interfaces to save memory
+    m_geometry->destroyInterfaces();
 
-	    // Renumber connectivity of cells with new vertex ids for each sending rnak
-	    std::unordered_map< long, std::unordered_map<long, long> > oldToNewVertexId;
+    return true;
+}
 
-	    // Some vertex are coincident with other ghost vertices already to be insert
-	    // Link these vertices to renumber after the insertion of the linked ones of the related source rank
-	    std::unordered_map< long, std::unordered_map<long, std::pair<int, long> > > oldToRenumberedGhostVertexId;
+#if MIMMO_ENABLE_MPI
+/*!
+ * Build the ghost cells of a mesh partition, each partition holding its own cells only.
+ * Ghost cells are found by matching the boundary vertices of the partitions and are
+ * received from the partitions owning them.
+ * \param[in] mesh partition of the bulk mesh
+ */
+void
+IOOFOAM::buildGhostCells(MimmoSharedPointer<MimmoObject> mesh){
 
-	    {
-	        // Send vertices
-	        std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
-	        dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
 
-	        for (auto & entry : ghostCellExchangeSources){
+	// Build Ghost Cells from boundary cells of patches of type processor boundary
 
-	            int target_rank = entry.first;
-	            std::unordered_set<long> & vertexList = vertexCellExchangeSources[target_rank];
+	// Recovering boundary nodes for each partition
+	std::vector<long> boundary_vertices = mesh->extractBoundaryVertexID();
 
-	            // Prepare buffer for vertices of the source cells
-	            size_t vertexBufferSize = 0;
-	            for (long vertexId : vertexList){
-	                vertexBufferSize += mesh->getPatch()->getVertex(vertexId).getBinarySize();
-	            }
-	            dataCommunicator->setSend(target_rank, sizeof(size_t) + vertexBufferSize);
-	            bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(target_rank);
+	// Communicate boundary vertices to all other partitions
+	std::unordered_map<int, std::vector<long>*> boundaryVertexExchangeSources;
+	std::unordered_map<int, bitpit::PiercedVector<bitpit::Vertex> > receivedBoundaryVertices;
 
-	            // Fill the buffer with the source vertices
-	            buffer << vertexList.size();
-	            for (long vertexId : vertexList){
-	                buffer << mesh->getPatch()->getVertex(vertexId);
-	            }
-	            dataCommunicator->startSend(target_rank);
+	// Fill map to communicate
+	for (int irank = 0; irank < getProcessorCount(); irank++){
+	    if (irank != getRank()){
+	        boundaryVertexExchangeSources[irank] = &boundary_vertices;
+	    }
+	}
+
+	{
+	    // Send boundary vertices
+	    std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
+	    dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
+
+	    for (auto & entry : boundaryVertexExchangeSources){
+
+	        int target_rank = entry.first;
+	        std::vector<long> & vertexList = *entry.second;
+
+	        // Prepare buffer for source cells and vertices of the source cells
+	        size_t vertexBufferSize = 0;
+	        for (long vertexId : vertexList){
+	            vertexBufferSize += mesh->getPatch()->getVertex(vertexId).getBinarySize();
 	        }
+	        dataCommunicator->setSend(target_rank, sizeof(size_t) + vertexBufferSize);
+	        bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(target_rank);
 
-	        // Discover & start all the receives
-	        dataCommunicator->discoverRecvs();
-	        dataCommunicator->startAllRecvs();
+	        // Fill the buffer with the source cells and vertices
+	        buffer << vertexList.size();
+	        for (long vertexId : vertexList){
+	            buffer << mesh->getPatch()->getVertex(vertexId);
+	        }
+	        dataCommunicator->startSend(target_rank);
 
-	        // Receive the target ghost vertices
+	    }
 
-	        int nCompletedRecvs = 0;
-	        while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
-	            int source_rank = dataCommunicator->waitAnyRecv();
-	            bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(source_rank);
+	    // Discover & start all the receives
+	    dataCommunicator->discoverRecvs();
+	    dataCommunicator->startAllRecvs();
+
+	    // Receive the target boundary vertices
+	    int nCompletedRecvs = 0;
+	    while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
+	        int source_rank = dataCommunicator->waitAnyRecv();
+	        bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(source_rank);
+
+	        // Receive boundary vertices from mesh partitions
+	        std::size_t vertexCount;
+	        buffer >> vertexCount;
+	        receivedBoundaryVertices[source_rank].reserve(vertexCount);
+	        for (std::size_t ivertex = 0; ivertex < vertexCount; ivertex++){
+	            bitpit::Vertex boundaryVertex;
+	            buffer >> boundaryVertex;
+	            receivedBoundaryVertices[source_rank].insert(boundaryVertex.getId(), boundaryVertex);
+	        }
 
-	            // Receive ghost vertices
-	            std::size_t vertexCount;
-	            buffer >> vertexCount;
-	            for (std::size_t ivertex = 0; ivertex < vertexCount; ivertex++){
-	                bitpit::Vertex ghostVertex;
-	                buffer >> ghostVertex;
-	                long oldGhostVertexId = ghostVertex.getId();
-	                // ADd vertex if not already in the tree
-	                long ghostVertexId = oldGhostVertexId;
-	                std::pair<int, long> ghost_label(source_rank, ghostVertexId);
-	                std::pair<int, long> old_ghost_label(ghost_label);
+	        ++nCompletedRecvs;
+	    }
+	    // Wait for the sends to finish
+	    dataCommunicator->waitAllSends();
 
-	                // Check if already an insert ghost vertex
-	                if (ghost_tree.exist(&ghostVertex, ghost_label) == -1){
+	}
 
-	                    // Check if coincident qith a local vertex
-	                    if ((mesh->getKdTree()->exist(&ghostVertex, ghostVertexId)) == -1){
+	// Update kdtree
+	if (mesh->getKdTreeSyncStatus() != SyncStatus::SYNC){
+	    mesh->buildKdTree();
+	}
 
-	                        // To insert ghost vertex
-	                        unique_ghosts[source_rank].push_back(ghostVertex);
+	// Found list of vertices coincident
+	// with received boundary vertices for each partition
 
-	                        // Insert in the tree because the received vertices can be duplicated between partitions
-	                        ghost_tree.insert(&unique_ghosts[source_rank].back(), ghost_label);
+	// Initialize ghost cells to communicate to each processor
+	std::unordered_map<int, long> ghostVertexExchangeSourcesCount;
+	std::unordered_map<int, std::unordered_set<long>> ghostCellExchangeSources;
+	std::unordered_map<int, std::unordered_set<long>> vertexCellExchangeSources;
 
-	                    }
+	// Loop over received bounday vertices for rank
+	for (int irank = 0; irank < getProcessorCount(); irank ++){
 
-	                    // Insert item in map oldid->newid for ghost vertices coincident with a vertex
-	                    // already in the local tree
-	                    if (ghostVertexId != oldGhostVertexId){
-	                        oldToNewVertexId[source_rank].insert({{oldGhostVertexId, ghostVertexId}});
-	                    }
+	    if (irank == getRank()) continue;
 
-	                }
+	    long received_vertices_count = receivedBoundaryVertices[irank].size();
+	    std::vector<long> coincident_vertices;
+	    coincident_vertices.reserve(received_vertices_count);
 
-	                // Insert item in map oldid->newid for ghost vertices coincident with a vertex
-	                // already in the tree of ghosts [received by a previous partition])
-	                if (ghost_label != old_ghost_label){
-	                    oldToRenumberedGhostVertexId[source_rank].insert({{old_ghost_label.second, ghost_label}});
-	                }
+	    // Check received vertices with local kdtree
+	    for (bitpit::Vertex vertex : receivedBoundaryVertices[irank]){
 
-	            }
-	            ++nCompletedRecvs;
+	        long coincident_vertex_id = bitpit::Vertex::NULL_ID;
+	        mesh->getKdTree()->exist(&vertex, coincident_vertex_id);
+	        if (coincident_vertex_id != bitpit::Vertex::NULL_ID){
+	            coincident_vertices.push_back(coincident_vertex_id);
 	        }
+	        coincident_vertices.shrink_to_fit();
 
-	        // Wait for the sends to finish
-	        dataCommunicator->waitAllSends();
 	    }
 
-	    // Insert unique vertices in mesh
-	    for (auto & entry : unique_ghosts){
-	        int source_rank = entry.first;
-	        for (auto & ghostVertex : entry.second){
-	            long oldGhostVertexId = ghostVertex.getId();
-	            long ghostVertexId = bitpit::Vertex::NULL_ID;
-	            ghostVertex.setId(bitpit::Vertex::NULL_ID);
-	            ghostVertexId = mesh->addVertex(ghostVertex.getCoords(), bitpit::Vertex::NULL_ID);
-	            // Insert new vertex id in map old->new to update connectivity
-	            if (ghostVertexId != oldGhostVertexId){
-	                oldToNewVertexId[source_rank].insert({{oldGhostVertexId, ghostVertexId}});
-	            }
+	    // Extract local source cells those are ghost cells for i-th rank
+	    std::vector<long> ghosts = mesh->getCellFromVertexList(coincident_vertices, false);
+
+	    // Fill communication structures
+	    ghostVertexExchangeSourcesCount[irank] = 0;
+	    for (long cellId : ghosts){
+	        ghostCellExchangeSources[irank].insert(cellId);
+	        for (long vertexId : mesh->getPatch()->getCell(cellId).getVertexIds()){
+	            vertexCellExchangeSources[irank].insert(vertexId);
+	            ghostVertexExchangeSourcesCount[irank]++;
 	        }
 	    }
 
-	    // Insert in the map the id of the ghost vertices dependent
-	    // from the insertion of the ghost vertices received from other partitions
-	    for (auto entry : oldToRenumberedGhostVertexId){
-	        int source_rank = entry.first;
-	        for (auto tuple : entry.second){
-	            long old_id = tuple.first;
-	            int linked_source_rank = tuple.second.first;
-	            long linked_old_id = tuple.second.second;
-	            oldToNewVertexId[source_rank].insert({{old_id, oldToNewVertexId[linked_source_rank][linked_old_id]}});
-	        }
+	}
+
+
+	{
+	    // Send number of vertices
+	    std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
+	    dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
+
+	    for (auto & entry : ghostCellExchangeSources){
+
+	        int target_rank = entry.first;
+	        std::unordered_set<long> & vertexList = vertexCellExchangeSources[target_rank];
+
+	        // Prepare buffer for source vertices
+	        long vertexCount = vertexList.size();
+
+	        dataCommunicator->setSend(target_rank, vertexCount*sizeof(long));
+	        bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(target_rank);
+
+	        // Fill the buffer with the source  vertices
+	        buffer << vertexCount;
+	        dataCommunicator->startSend(target_rank);
 	    }
 
-	    {
-	        // Send cells
-	        std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
-	        dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
+	    // Discover & start all the receives
+	    dataCommunicator->discoverRecvs();
+	    dataCommunicator->startAllRecvs();
 
-	        for (auto & entry : ghostCellExchangeSources){
+	    // Receive the target count vertices
 
-	            int target_rank = entry.first;
-	            std::unordered_set<long> & cellList = entry.second;
+	    int nCompletedRecvs = 0;
+	    while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
+	        int source_rank = dataCommunicator->waitAnyRecv();
+	        bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(source_rank);
 
-	            // Prepare buffer for source cells
-	            size_t cellBufferSize = 0;
-	            for (long cellId : cellList){
-	                cellBufferSize += mesh->getPatch()->getCell(cellId).getBinarySize();
-	            }
-	            dataCommunicator->setSend(target_rank, sizeof(size_t) + cellBufferSize);
-	            bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(target_rank);
+	        long vertexCount;
+	        buffer >> vertexCount;
 
-	            // Fill the buffer with the source cells
-	            buffer << cellList.size();
-	            for (long cellId : cellList){
-	                buffer << mesh->getPatch()->getCell(cellId);
-	            }
-	            dataCommunicator->startSend(target_rank);
+	        ghostVertexExchangeSourcesCount[source_rank] = vertexCount;
 
-	        }
+	        ++nCompletedRecvs;
+	    }
+	    // Wait for the sends to finish
+	    dataCommunicator->waitAllSends();
 
-	        // Discover & start all the receives
-	        dataCommunicator->discoverRecvs();
-	        dataCommunicator->startAllRecvs();
-
-	        // Receive the target ghost cells
-	        int nCompletedRecvs = 0;
-	        while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
-	            int source_rank = dataCommunicator->waitAnyRecv();
-	            bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(source_rank);
-
-	            // Receive ghost cells add to mesh partition
-	            std::size_t cellCount;
-	            buffer >> cellCount;
-	            for (std::size_t icell = 0; icell < cellCount; icell++){
-	                bitpit::Cell ghostCell;
-	                buffer >> ghostCell;
-	                ghostCell.renumberVertices(oldToNewVertexId[source_rank]);
-	                ghostCell.setId(bitpit::Cell::NULL_ID);
-	                long ghostId = mesh->addCell(ghostCell, int(source_rank));
-                    BITPIT_UNUSED(ghostId);
-	            }
-	            ++nCompletedRecvs;
+	} // end communication of receive vertex count
+
+
+	// Force re-build kdTree of vertices with new over-sized reserved vertex container
+	mesh->buildKdTree();
+
+	// Instantiate a to_insert structure for unique received vertices for each sending rank
+	// Initialize a kdTree tree for the received ghost vertices
+	std::unordered_map< long , std::vector<bitpit::Vertex> > unique_ghosts;
+	for (auto entry : ghostVertexExchangeSourcesCount){
+	    unique_ghosts[entry.first].reserve(entry.second);
+	}
+	bitpit::KdTree<3, bitpit::Vertex, std::pair<int, long> > ghost_tree;
+
+	// Renumber connectivity of cells with new vertex ids for each sending rnak
+	std::unordered_map< long, std::unordered_map<long, long> > oldToNewVertexId;
+
+	// Some vertex are coincident with other ghost vertices already to be insert
+	// Link these vertices to renumber after the insertion of the linked ones of the related source rank
+	std::unordered_map< long, std::unordered_map<long, std::pair<int, long> > > oldToRenumberedGhostVertexId;
+
+	{
+	    // Send vertices
+	    std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
+	    dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
+
+	    for (auto & entry : ghostCellExchangeSources){
+
+	        int target_rank = entry.first;
+	        std::unordered_set<long> & vertexList = vertexCellExchangeSources[target_rank];
+
+	        // Prepare buffer for vertices of the source cells
+	        size_t vertexBufferSize = 0;
+	        for (long vertexId : vertexList){
+	            vertexBufferSize += mesh->getPatch()->getVertex(vertexId).getBinarySize();
 	        }
-	        // Wait for the sends to finish
-	        dataCommunicator->waitAllSends();
+	        dataCommunicator->setSend(target_rank, sizeof(size_t) + vertexBufferSize);
+	        bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(target_rank);
 
+	        // Fill the buffer with the source vertices
+	        buffer << vertexList.size();
+	        for (long vertexId : vertexList){
+	            buffer << mesh->getPatch()->getVertex(vertexId);
+	        }
+	        dataCommunicator->startSend(target_rank);
 	    }
 
-	} // end if multi-processors
+	    // Discover & start all the receives
+	    dataCommunicator->discoverRecvs();
+	    dataCommunicator->startAllRecvs();
 
-    // Update mesh
-    mesh->update();
+	    // Receive the target ghost vertices
 
-#endif
+	    int nCompletedRecvs = 0;
+	    while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
+	        int source_rank = dataCommunicator->waitAnyRecv();
+	        bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(source_rank);
 
-    mesh->updateAdjacencies();
-    mesh->updateInterfaces();
-    mesh->update();
+	        // Receive ghost vertices
+	        std::size_t vertexCount;
+	        buffer >> vertexCount;
+	        for (std::size_t ivertex = 0; ivertex < vertexCount; ivertex++){
+	            bitpit::Vertex ghostVertex;
+	            buffer >> ghostVertex;
+	            long oldGhostVertexId = ghostVertex.getId();
+	            // ADd vertex if not already in the tree
+	            long ghostVertexId = oldGhostVertexId;
+	            std::pair<int, long> ghost_label(source_rank, ghostVertexId);
+	            std::pair<int, long> old_ghost_label(ghost_label);
 
-    // TODO bitpit sort is bugged
-    // Sort cells and vertices
-//    mesh->getPatch()->sortVertices();
-//    mesh->getPatch()->sortCells();
+	            // Check if already an insert ghost vertex
+	            if (ghost_tree.exist(&ghostVertex, ghost_label) == -1){
 
-    bitpit::PiercedVector<bitpit::Cell> & bitCells = mesh->getCells();
-    bitpit::PiercedVector<bitpit::Interface> & bitInterfaces = mesh->getInterfaces();
+	                // Check if coincident qith a local vertex
+	                if ((mesh->getKdTree()->exist(&ghostVertex, ghostVertexId)) == -1){
 
-    forAll(faces, iOF){
+	                    // To insert ghost vertex
+	                    unique_ghosts[source_rank].push_back(ghostVertex);
 
-        std::vector<long> vListOF(faces[iOF].size());
-        forAll(faces[iOF], index){
-            vListOF[index] = long(faces[iOF][index]);
-        }
-        std::sort(vListOF.begin(), vListOF.end());
+	                    // Insert in the tree because the received vertices can be duplicated between partitions
+	                    ghost_tree.insert(&unique_ghosts[source_rank].back(), ghost_label);
 
-        long iDC = long(faceOwner[iOF]);
-        long * bitFaceList = bitCells[iDC].getInterfaces();
-        std::size_t sizeFList = bitCells[iDC].getInterfaceCount();
+	                }
 
-        long iBIT = bitpit::Interface::NULL_ID;
-        std::size_t j(0);
-        while(iBIT < 0 && j<sizeFList){
-            bitpit::ConstProxyVector<long> vconn = bitInterfaces[bitFaceList[j]].getVertexIds();
-            std::vector<long> vListBIT(vconn.begin(), vconn.end());
-            std::sort(vListBIT.begin(), vListBIT.end());
+	                // Insert item in map oldid->newid for ghost vertices coincident with a vertex
+	                // already in the local tree
+	                if (ghostVertexId != oldGhostVertexId){
+	                    oldToNewVertexId[source_rank].insert({{oldGhostVertexId, ghostVertexId}});
+	                }
 
-            if(std::equal(vListBIT.begin(), vListBIT.end(), vListOF.begin()) ){
-                iBIT = bitFaceList[j];
-            }else{
-                ++j;
-            }
-        }
-        m_OFbitpitmapfaces.insert(std::make_pair(long(iOF),iBIT) );
-    }
+	            }
 
+	            // Insert item in map oldid->newid for ghost vertices coincident with a vertex
+	            // already in the tree of ghosts [received by a previous partition])
+	            if (ghost_label != old_ghost_label){
+	                oldToRenumberedGhostVertexId[source_rank].insert({{old_ghost_label.second, ghost_label}});
+	            }
 
-	// From MimmoObject utilities, create the raw boundary mesh, storing it in m_boundary internal member.
-	// PID will be every where 0. Need to be compiled to align with patch division of foamBoundaryMesh.
-	// Every cell of the boundary mesh will have the same id of the border interfaces of the bulk.
-    m_boundary = mesh->extractBoundaryMesh();
+	        }
+	        ++nCompletedRecvs;
+	    }
 
-	//Once OFoam faces and bitpit Interfaces link is set,
-	//Extract boundary patch info from foamBoundary and
-	// get boundary patch division automatically pidding the class boundary mesh.
+	    // Wait for the sends to finish
+	    dataCommunicator->waitAllSends();
+	}
 
-	const Foam::fvBoundaryMesh &foamBMesh = foamMesh->boundary();
-	long startIndex;
-	long endIndex;
+	// Insert unique vertices in mesh
+	for (auto & entry : unique_ghosts){
+	    int source_rank = entry.first;
+	    for (auto & ghostVertex : entry.second){
+	        long oldGhostVertexId = ghostVertex.getId();
+	        long ghostVertexId = bitpit::Vertex::NULL_ID;
+	        ghostVertex.setId(bitpit::Vertex::NULL_ID);
+	        ghostVertexId = mesh->addVertex(ghostVertex.getCoords(), bitpit::Vertex::NULL_ID);
+	        // Insert new vertex id in map old->new to update connectivity
+	        if (ghostVertexId != oldGhostVertexId){
+	            oldToNewVertexId[source_rank].insert({{oldGhostVertexId, ghostVertexId}});
+	        }
+	    }
+	}
 
-	forAll(foamBMesh, iBoundary){
-		long PID = long(iBoundary+1);
-		startIndex = foamBMesh[iBoundary].patch().start();
-		endIndex = startIndex + long(foamBMesh[iBoundary].patch().size());
-        for(long ind=startIndex; ind<endIndex; ++ind){
-            m_boundary->setPIDCell(m_OFbitpitmapfaces[ind], PID);
-		}
-        m_boundary->setPIDName(PID,foamBMesh[iBoundary].name().c_str());
+	// Insert in the map the id of the ghost vertices dependent
+	// from the insertion of the ghost vertices received from other partitions
+	for (auto entry : oldToRenumberedGhostVertexId){
+	    int source_rank = entry.first;
+	    for (auto tuple : entry.second){
+	        long old_id = tuple.first;
+	        int linked_source_rank = tuple.second.first;
+	        long linked_old_id = tuple.second.second;
+	        oldToNewVertexId[source_rank].insert({{old_id, oldToNewVertexId[linked_source_rank][linked_old_id]}});
+	    }
 	}
-	m_boundary->resyncPID();
 
-	// Update bounfary mesh
-	m_boundary->update();
+	{
+	    // Send cells
+	    std::unique_ptr<bitpit::DataCommunicator> dataCommunicator;
+	    dataCommunicator = std::unique_ptr<bitpit::DataCommunicator>(new bitpit::DataCommunicator(getCommunicator()));
 
-	// Destroy interfaces to save memory
-	m_geometry->destroyInterfaces();
+	    for (auto & entry : ghostCellExchangeSources){
 
-	return true;
+	        int target_rank = entry.first;
+	        std::unordered_set<long> & cellList = entry.second;
+
+	        // Prepare buffer for source cells
+	        size_t cellBufferSize = 0;
+	        for (long cellId : cellList){
+	            cellBufferSize += mesh->getPatch()->getCell(cellId).getBinarySize();
+	        }
+	        dataCommunicator->setSend(target_rank, sizeof(size_t) + cellBufferSize);
+	        bitpit::SendBuffer &buffer = dataCommunicator->getSendBuffer(target_rank);
+
+	        // Fill the buffer with the source cells
+	        buffer << cellList.size();
+	        for (long cellId : cellList){
+	            buffer << mesh->getPatch()->getCell(cellId);
+	        }
+	        dataCommunicator->startSend(target_rank);
+
+	    }
+
+	    // Discover & start all the receives
+	    dataCommunicator->discoverRecvs();
+	    dataCommunicator->startAllRecvs();
+
+	    // Receive the target ghost cells
+	    int nCompletedRecvs = 0;
+	    while (nCompletedRecvs < dataCommunicator->getRecvCount()) {
+	        int source_rank = dataCommunicator->waitAnyRecv();
+	        bitpit::RecvBuffer &buffer = dataCommunicator->getRecvBuffer(source_rank);
+
+	        // Receive ghost cells add to mesh partition
+	        std::size_t cellCount;
+	        buffer >> cellCount;
+	        for (std::size_t icell = 0; icell < cellCount; icell++){
+	            bitpit::Cell ghostCell;
+	            buffer >> ghostCell;
+	            ghostCell.renumberVertices(oldToNewVertexId[source_rank]);
+	            ghostCell.setId(bitpit::Cell::NULL_ID);
+	            long ghostId = mesh->addCell(ghostCell, int(source_rank));
+                BITPIT_UNUSED(ghostId);
+	        }
+	        ++nCompletedRecvs;
+	    }
+	    // Wait for the sends to finish
+	    dataCommunicator->waitAllSends();
+
+	}
 
 }
+#endif
 
 /*!
  * It writes the OpenFOAM mesh to an output file from internal structure m_bulk and m_boundary
@@ -1112,6 +1395,11 @@ IOOFOAM::write(){
 bool
 IOOFOAM::writePointsOnly(){
 
+    if(m_directread){
+        if(writePointsDirect()) return true;
+        (*m_log)<<"WARNING: "<<m_name<<" cannot write directly the points of the OpenFOAM case at "<<m_path<<". Writing them with OpenFOAM libraries."<<std::endl;
+    }
+
 	dvecarr3E points;
 
 #if MIMMO_ENABLE_MPI
@@ -1152,6 +1440,82 @@ IOOFOAM::writePointsOnly(){
 
 }
 
+/*!
+ * It writes the bulk mesh points directly in the binary points files of the OpenFOAM case,
+ * one for each subdomain of the current process, written concurrently. The bulk mesh is
+ * expected to be read with DirectRead, i.e. its vertex ids are the ones of the undecomposed
+ * mesh. The points order of each subdomain is read from pointProcAddressing at the first
+ * call, then it is cached, together with the label size declared by the mesh files, which
+ * is kept in the header of the written points files.
+ * Points are written at the start time of the case if Overwrite is enabled, otherwise at
+ * start time + 1.
+ * \return false if the points order cannot be recovered or a vertex is missing.
+ */
+bool
+IOOFOAM::writePointsDirect(){
+
+    MimmoSharedPointer<MimmoObject> mesh = getGeometry();
+    if(!mesh) return false;
+
+    bool decomposed;
+    std::vector<std::string> casePaths = getSubdomainPaths(decomposed);
+    std::size_t nLocal = casePaths.size();
+    std::string startTime = foamUtilsRaw::getStartTime(m_path, decomposed);
+    std::string timeName = startTime;
+    if(!m_overwrite){
+        timeName = foamUtilsRaw::getTimeName(std::strtod(startTime.c_str(), nullptr) + 1.);
+    }
+
+    std::vector<livector1D*> pointsOrders(nLocal);
+    std::vector<int*> labelSizes(nLocal);
+    for(std::size_t i = 0; i < nLocal; ++i){
+        pointsOrders[i] = &m_pointsorder[casePaths[i]];
+        labelSizes[i] = &m_labelsize.emplace(casePaths[i], 4).first->second;
+    }
+
+    const bitpit::PiercedVector<bitpit::Vertex> & vertices = mesh->getVertices();
+    std::vector<int> status(nLocal, 0);
+    threads::parallelFor(0, nLocal, [&](std::size_t begin, std::size_t end){
+        for(std::size_t i = begin; i < end; ++i){
+            livector1D & pointsOrder = *pointsOrders[i];
+            if(pointsOrder.empty()){
+                if(decomposed){
+                    if(!foamUtilsRaw::readLabels(casePaths[i] + "/constant/polyMesh/pointProcAddressing", pointsOrder, labelSizes[i])) continue;
+                }else{
+                    std::vector<std::array<double,3>> points;
+                    if(!foamUtilsRaw::readPoints(foamUtilsRaw::findMeshInstance(casePaths[i], startTime, "points") + "/points", points, labelSizes[i])) continue;
+                    pointsOrder.resize(points.size());
+                    std::iota(pointsOrder.begin(), pointsOrder.end(), long(0));
+                }
+            }
+
+            std::vector<std::array<double,3>> points(pointsOrder.size());
+            bool found = true;
+            for(std::size_t k = 0; k < pointsOrder.size() && found; ++k){
+                found = vertices.exists(pointsOrder[k]);
+                if(found) points[k] = vertices.at(pointsOrder[k]).getCoords();
+            }
+            status[i] = int(found && foamUtilsRaw::writePoints(casePaths[i], timeName, points, *labelSizes[i]));
+        }
+    }, 1);
+
+    bool success = true;
+    for(int flag : status){
+        success = success && (flag != 0);
+    }
+#if MIMMO_ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &success, 1, MPI_C_BOOL, MPI_LAND, m_communicator);
+#endif
+    if(!success){
+        // drop a points order possibly not coherent with the case
+        for(const std::string & casePath : casePaths){
+            m_pointsorder.erase(casePath);
+            m_labelsize.erase(casePath);
+        }
+    }
+    return success;
+}
+
 /*
  * ========================================================================================================
  */
@@ -137,7 +137,20 @@ protected:
 WARNING: WRITE mode is available at the moment only with writePointsOnly option always enabled.
 
 NOTE: in case of MPI support enabled the OpenFOAM mesh has to be read with the same number of processors
-used to write it with OpenFOAM utilities.
+used to write it with OpenFOAM utilities, unless DirectRead is enabled.
+
+If DirectRead is enabled (see setDirectRead), the polyMesh files of the case are parsed directly,
+without loading the mesh through the OpenFOAM libraries. In a decomposed case the processor* directories
+are distributed in contiguous blocks among the MPI ranks, whatever their number, and the subdomains of
+each rank are read concurrently by threads, sharing with the files of each subdomain the threads given by
+mimmo::threads::getNumberOfThreads(); ghost cells are then rebuilt between the ranks. Vertex and
+cell ids of the bulk mesh are the ones of the undecomposed mesh, as well as the keys of the faces map.
+Uncompressed ascii and binary files are supported; in case of unsupported files (e.g. compressed
+or collated) the reader falls back to the OpenFOAM libraries.
+In WRITE mode, DirectRead declares that the bulk mesh was read with DirectRead: points are then
+written back directly in binary points files, one per processor directory, written concurrently,
+without loading the case with the OpenFOAM libraries. The order of the points of each subdomain
+is cached at the first write, or at the read if the same object is used.
 
  Proper of the class :
 *
@@ -173,6 +186,9 @@ used to write it with OpenFOAM utilities.
 * - <B>Overwrite</B>: valid only in WRITE mode and WritePointOnly activated: if 1-true overwrite
                       points in the current OpenFoam case time of the mesh at WriteDir.
                       If 0-false (DEFAULT) save them in a newly created case time at current time + 1;
+* - <B>DirectRead</B>: if 1-true, in READ mode parse the polyMesh files directly, reading the subdomains
+                       of a decomposed case concurrently; in WRITE mode write the points files directly.
+                       0-false (DEFAULT) read/write the mesh with the OpenFOAM libraries;
 
 * In case of writing mode Geometries have to be mandatorily passed by port.
 *
@@ -182,6 +198,9 @@ class IOOFOAM: public IOOFOAM_Kernel{
 protected:
     bool        m_overwrite;        /**< Overwrite in time case when in mode WRITE and writePointsOnly is true */
     bool        m_writepointsonly;  /**< write points only attaching it to a preexistent OF mesh */
+    bool        m_directread;       /**< read the polyMesh files directly, without OpenFOAM libraries */
+    std::unordered_map<std::string, livector1D> m_pointsorder; /**< vertex ids of each subdomain of the case, in OpenFOAM points order */
+    std::unordered_map<std::string, int>        m_labelsize;   /**< size in bytes of labels of each subdomain of the case, as declared by its mesh files */
 
     using       IOOFOAM_Kernel::m_geometry;
 
@@ -198,8 +217,10 @@ public:
    void            buildPorts();
    bool            getOverwrite();
    bool            getWritePointsOnly();
+   bool            getDirectRead();
    void            setOverwrite(bool flag);
    void            setWritePointsOnly(bool flag);
+   void            setDirectRead(bool flag);
 
    virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name="");
    virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name="");
@@ -212,6 +233,12 @@ protected:
    virtual bool read();
    virtual bool write();
    virtual bool writePointsOnly();
+   bool         readDirect();
+   bool         writePointsDirect();
+   std::vector<std::string> getSubdomainPaths(bool & decomposed);
+#if MIMMO_ENABLE_MPI
+   void         buildGhostCells(MimmoSharedPointer<MimmoObject> mesh);
+#endif
 
 private:
     // hide the method from interface.
@@ -0,0 +1,933 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "openFoamFiles_raw.hpp"
+#include "mimmoTextParser.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace mimmo{
+
+namespace foamUtilsRaw{
+
+/*!
+ * \brief Contents of the header of an OpenFOAM file relevant for reading.
+ */
+struct FoamHeader{
+    bool        binary;         /**< True for binary format.*/
+    bool        littleEndian;   /**< True for little endian binary data.*/
+    int         labelSize;      /**< Size in bytes of labels.*/
+    int         scalarSize;     /**< Size in bytes of scalars.*/
+    std::string className;      /**< Class of the stored object.*/
+
+    FoamHeader() : binary(false), littleEndian(true), labelSize(4), scalarSize(8){}
+};
+
+/*!
+ * \return true if the host is little endian.
+ */
+static bool isLittleEndian(){
+    std::uint16_t value = 1;
+    unsigned char first;
+    std::memcpy(&first, &value, 1);
+    return first == 1;
+}
+
+/*!
+ * \return true if the file exists and can be opened.
+ * \param[in] filename path of the file
+ */
+static bool fileExists(const std::string & filename){
+    std::ifstream in(filename);
+    return in.good();
+}
+
+/*!
+ * Move the cursor past blanks, newlines and C/C++ comments.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ */
+static void skipSpace(const char *& cursor, const char * end){
+    while(cursor < end){
+        char c = *cursor;
+        if(c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'){
+            ++cursor;
+            continue;
+        }
+        if(c == '/' && cursor + 1 < end){
+            if(cursor[1] == '/'){
+                cursor = text::nextLine(cursor, end);
+                continue;
+            }
+            if(cursor[1] == '*'){
+                const char * current = cursor + 2;
+                while(current + 1 < end && !(current[0] == '*' && current[1] == '/')) ++current;
+                cursor = (current + 1 < end) ? current + 2 : end;
+                continue;
+            }
+        }
+        break;
+    }
+}
+
+/*!
+ * Move the cursor past blanks, newlines and list parentheses.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ */
+static void skipSeparators(const char *& cursor, const char * end){
+    while(cursor < end){
+        char c = *cursor;
+        if(c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f' || c == '(' || c == ')'){
+            ++cursor;
+            continue;
+        }
+        break;
+    }
+}
+
+/*!
+ * Skip blanks and comments and a delimiter character, if present.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ * \param[in] delimiter delimiter character
+ * \return true if the delimiter is found.
+ */
+static bool expect(const char *& cursor, const char * end, char delimiter){
+    skipSpace(cursor, end);
+    if(cursor < end && *cursor == delimiter){
+        ++cursor;
+        return true;
+    }
+    return false;
+}
+
+/*!
+ * Read the next word, i.e. a quoted string or a sequence of characters different
+ * from blanks and from the punctuation of OpenFOAM dictionaries.
+ * \param[in,out] cursor position in the text
+ * \param[in] end end of the text
+ * \param[out] word word read
+ * \return false if no word is found at the cursor position.
+ */
+static bool readWord(const char *& cursor, const char * end, std::string & word){
+    skipSpace(cursor, end);
+    word.clear();
+    if(cursor >= end) return false;
+    if(*cursor == '"'){
+        const char * close = static_cast<const char *>(std::memchr(cursor + 1, '"', std::size_t(end - cursor - 1)));
+        if(!close) return false;
+        word.assign(cursor + 1, close);
+        cursor = close + 1;
+        return true;
+    }
+    const char * begin = cursor;
+    while(cursor < end && std::strchr(" \t\r\n\v\f{}();\"", *cursor) == nullptr) ++cursor;
+    word.assign(begin, cursor);
+    return !word.empty();
+}
+
+/*!
+ * Read the value of a dictionary entry, up to the terminating semicolon. Words are
+ * joined by a blank; parentheses are skipped.
+ * \param[in,out] cursor position in the text, past the entry keyword
+ * \param[in] end end of the text
+ * \param[out] value value of the entry
+ * \return false if the text ends before the semicolon.
+ */
+static bool readEntryValue(const char *& cursor, const char * end, std::string & value){
+    value.clear();
+    std::string word;
+    while(true){
+        skipSpace(cursor, end);
+        if(cursor >= end) return false;
+        if(*cursor == ';'){
+            ++cursor;
+            return true;
+        }
+        if(!readWord(cursor, end, word)){
+            ++cursor;
+            continue;
+        }
+        if(!value.empty()) value += ' ';
+        value += word;
+    }
+}
+
+/*!
+ * Skip a dictionary block, nested blocks included.
+ * \param[in,out] cursor position in the text, past the opening brace
+ * \param[in] end end of the text
+ * \return false if the text ends before the closing brace.
+ */
+static bool skipBlock(const char *& cursor, const char * end){
+    int depth = 1;
+    std::string word;
+    while(depth > 0){
+        skipSpace(cursor, end);
+        if(cursor >= end) return false;
+        if(*cursor == '{') ++depth;
+        else if(*cursor == '}') --depth;
+        if(!readWord(cursor, end, word)) ++cursor;
+    }
+    return true;
+}
+
+/*!
+ * Parse the FoamFile header of an OpenFOAM file.
+ * \param[in,out] cursor position in the text, moved past the header
+ * \param[in] end end of the text
+ * \param[out] header parsed header
+ * \return false if the header is not found.
+ */
+static bool parseHeader(const char *& cursor, const char * end, FoamHeader & header){
+    std::string word, value;
+    if(!readWord(cursor, end, word) || word != "FoamFile") return false;
+    if(!expect(cursor, end, '{')) return false;
+    while(true){
+        if(expect(cursor, end, '}')) break;
+        if(!readWord(cursor, end, word) || !readEntryValue(cursor, end, value)) return false;
+        if(word == "format"){
+            header.binary = (value == "binary");
+        }else if(word == "class"){
+            header.className = value;
+        }else if(word == "arch"){
+            header.littleEndian = (value.find("MSB") == std::string::npos);
+            std::size_t pos = value.find("label=");
+            if(pos != std::string::npos) header.labelSize = std::atoi(value.c_str() + pos + 6) / 8;
+            pos = value.find("scalar=");
+            if(pos != std::string::npos) header.scalarSize = std::atoi(value.c_str() + pos + 7) / 8;
+        }
+    }
+    if(header.binary){
+        if(header.littleEndian != isLittleEndian()) return false;
+        if(header.labelSize != 4 && header.labelSize != 8) return false;
+        if(header.scalarSize != 4 && header.scalarSize != 8) return false;
+    }
+    return true;
+}
+
+/*!
+ * Parse the size of a list and its opening parenthesis. In binary files the data
+ * begin right after the cursor.
+ * \param[in,out] cursor position in the text, moved past the parenthesis
+ * \param[in] end end of the text
+ * \param[out] size size of the list
+ * \return false if no list is found, or if it is a uniform list.
+ */
+static bool parseListSize(const char *& cursor, const char * end, long & size){
+    skipSpace(cursor, end);
+    if(!text::parse(cursor, end, size) || size < 0) return false;
+    return expect(cursor, end, '(');
+}
+
+/*!
+ * \return position of the last closing parenthesis in the text, or end if not found.
+ * \param[in] begin begin of the text
+ * \param[in] end end of the text
+ */
+static const char * lastParenthesis(const char * begin, const char * end){
+    const char * current = end;
+    while(current > begin){
+        --current;
+        if(*current == ')') return current;
+    }
+    return end;
+}
+
+/*!
+ * Decode binary values of type Stored into a vector of type T.
+ * \param[in] data begin of the binary data
+ * \param[out] values decoded values; its size sets the number of values to decode
+ */
+template<typename Stored, typename T>
+static void decodeBinary(const char * data, std::vector<T> & values){
+    threads::parallelFor(0, values.size(), [&](std::size_t begin, std::size_t end){
+        Stored value;
+        for(std::size_t i = begin; i < end; ++i){
+            std::memcpy(&value, data + i * sizeof(Stored), sizeof(Stored));
+            values[i] = static_cast<T>(value);
+        }
+    }, 65536);
+}
+
+/*!
+ * Parse the values of a list of labels.
+ * \param[in,out] cursor position in the text, past the opening parenthesis; moved past the list
+ * \param[in] end end of the text
+ * \param[in] header header of the file
+ * \param[in] size size of the list
+ * \param[in] last true if the list is the last one of the file; its values are parsed concurrently
+ * \param[out] labels labels of the list
+ * \return false if the list is corrupted.
+ */
+static bool parseLabelList(const char *& cursor, const char * end, const FoamHeader & header, long size, bool last, std::vector<long> & labels){
+    labels.clear();
+    if(header.binary){
+        std::size_t bytes = std::size_t(size) * std::size_t(header.labelSize);
+        if(std::size_t(end - cursor) < bytes) return false;
+        labels.resize(size);
+        if(header.labelSize == 4) decodeBinary<std::int32_t>(cursor, labels);
+        else                      decodeBinary<std::int64_t>(cursor, labels);
+        cursor += bytes;
+        return expect(cursor, end, ')');
+    }
+
+    if(!last){
+        labels.reserve(size);
+        long value;
+        for(long i = 0; i < size; ++i){
+            skipSpace(cursor, end);
+            if(!text::parse(cursor, end, value)) return false;
+            labels.push_back(value);
+        }
+        return expect(cursor, end, ')');
+    }
+
+    const char * listEnd = lastParenthesis(cursor, end);
+    if(listEnd == end) return false;
+    std::vector<std::vector<long>> chunks = text::parseChunks<std::vector<long>>(cursor, listEnd,
+        [listEnd](const char * chunkBegin, const char * chunkEnd, std::vector<long> & result){
+            const char * current = chunkBegin;
+            long value;
+            while(true){
+                skipSeparators(current, chunkEnd);
+                if(current >= chunkEnd || !text::parse(current, listEnd, value)) break;
+                result.push_back(value);
+            }
+        });
+    labels.reserve(size);
+    for(std::vector<long> & chunk : chunks){
+        labels.insert(labels.end(), chunk.begin(), chunk.end());
+        std::vector<long>().swap(chunk);
+    }
+    cursor = listEnd + 1;
+    return long(labels.size()) == size;
+}
+
+/*!
+ * Read the list of points of an OpenFOAM points file.
+ * \param[in] filename path of the file
+ * \param[out] points coordinates of the points
+ * \param[out] labelSize if not null, size in bytes of labels declared by the file header
+ * \return false if the file is not found, not supported or corrupted.
+ */
+bool readPoints(const std::string & filename, std::vector<std::array<double,3>> & points, int * labelSize){
+    points.clear();
+    text::FileBuffer buffer;
+    if(!buffer.open(filename)) return false;
+    const char * cursor = buffer.begin();
+    const char * end = buffer.end();
+
+    FoamHeader header;
+    long size;
+    if(!parseHeader(cursor, end, header) || !parseListSize(cursor, end, size)) return false;
+    if(labelSize) *labelSize = header.labelSize;
+
+    if(header.binary){
+        std::size_t bytes = 3 * std::size_t(size) * std::size_t(header.scalarSize);
+        if(std::size_t(end - cursor) < bytes) return false;
+        points.resize(size);
+        threads::parallelFor(0, points.size(), [&](std::size_t begin, std::size_t stop){
+            for(std::size_t i = begin; i < stop; ++i){
+                for(int k = 0; k < 3; ++k){
+                    const char * data = cursor + (3 * i + k) * header.scalarSize;
+                    if(header.scalarSize == 8){
+                        std::memcpy(&points[i][k], data, 8);
+                    }else{
+                        float value;
+                        std::memcpy(&value, data, 4);
+                        points[i][k] = value;
+                    }
+                }
+            }
+        }, 65536);
+        cursor += bytes;
+        return expect(cursor, end, ')');
+    }
+
+    const char * listEnd = lastParenthesis(cursor, end);
+    if(listEnd == end) return false;
+    std::vector<std::vector<double>> chunks = text::parseChunks<std::vector<double>>(cursor, listEnd,
+        [listEnd](const char * chunkBegin, const char * chunkEnd, std::vector<double> & result){
+            const char * current = chunkBegin;
+            double value;
+            while(true){
+                skipSeparators(current, chunkEnd);
+                if(current >= chunkEnd || !text::parse(current, listEnd, value)) break;
+                result.push_back(value);
+            }
+        });
+    points.reserve(size);
+    std::array<double,3> point;
+    int k = 0;
+    for(std::vector<double> & chunk : chunks){
+        for(double value : chunk){
+            point[k++] = value;
+            if(k == 3){
+                points.push_back(point);
+                k = 0;
+            }
+        }
+        std::vector<double>().swap(chunk);
+    }
+    return k == 0 && long(points.size()) == size;
+}
+
+/*!
+ * Read a list of labels of an OpenFOAM file, e.g. owner, neighbour or the addressing
+ * files of a decomposed case.
+ * \param[in] filename path of the file
+ * \param[out] labels labels of the list
+ * \param[out] labelSize if not null, size in bytes of labels declared by the file header
+ * \return false if the file is not found, not supported or corrupted.
+ */
+bool readLabels(const std::string & filename, std::vector<long> & labels, int * labelSize){
+    labels.clear();
+    text::FileBuffer buffer;
+    if(!buffer.open(filename)) return false;
+    const char * cursor = buffer.begin();
+    const char * end = buffer.end();
+
+    FoamHeader header;
+    long size;
+    if(!parseHeader(cursor, end, header) || !parseListSize(cursor, end, size)) return false;
+    if(labelSize) *labelSize = header.labelSize;
+    return parseLabelList(cursor, end, header, size, true, labels);
+}
+
+/*!
+ * Read the faces of an OpenFOAM faces file, stored as faceCompactList (ascii or
+ * binary) or faceList (ascii only).
+ * \param[in] filename path of the file
+ * \param[out] faceOffsets offsets of the faces in faceVertices, of size number of faces + 1
+ * \param[out] faceVertices vertices of the faces
+ * \return false if the file is not found, not supported or corrupted.
+ */
+bool readFaces(const std::string & filename, std::vector<long> & faceOffsets, std::vector<long> & faceVertices){
+    faceOffsets.clear();
+    faceVertices.clear();
+    text::FileBuffer buffer;
+    if(!buffer.open(filename)) return false;
+    const char * cursor = buffer.begin();
+    const char * end = buffer.end();
+
+    FoamHeader header;
+    long size;
+    if(!parseHeader(cursor, end, header) || !parseListSize(cursor, end, size)) return false;
+
+    if(header.className == "faceCompactList"){
+        if(!parseLabelList(cursor, end, header, size, false, faceOffsets)) return false;
+        long vertexCount;
+        if(!parseListSize(cursor, end, vertexCount)) return false;
+        if(!parseLabelList(cursor, end, header, vertexCount, true, faceVertices)) return false;
+        if(faceOffsets.empty()) faceOffsets.push_back(0);
+        return faceOffsets.front() == 0 && faceOffsets.back() == long(faceVertices.size());
+    }
+
+    if(header.binary) return false;
+
+    // ascii faceList, one face n(v0 ... vn-1) for each line.
+    struct FaceChunk{
+        std::vector<long>   sizes;      /**< Number of vertices of each face.*/
+        std::vector<long>   vertices;   /**< Vertices of the faces.*/
+        bool                valid = true; /**< False if a corrupted face is found.*/
+    };
+    const char * listEnd = lastParenthesis(cursor, end);
+    if(listEnd == end) return false;
+    std::vector<FaceChunk> chunks = text::parseChunks<FaceChunk>(cursor, listEnd,
+        [listEnd](const char * chunkBegin, const char * chunkEnd, FaceChunk & result){
+            const char * current = chunkBegin;
+            long nVertices, vertex;
+            while(true){
+                skipSpace(current, chunkEnd);
+                if(current >= chunkEnd) break;
+                if(!text::parse(current, listEnd, nVertices) || !expect(current, listEnd, '(')){
+                    result.valid = false;
+                    break;
+                }
+                for(long i = 0; i < nVertices && result.valid; ++i){
+                    skipSpace(current, listEnd);
+                    result.valid = text::parse(current, listEnd, vertex);
+                    result.vertices.push_back(vertex);
+                }
+                if(!result.valid || !expect(current, listEnd, ')')){
+                    result.valid = false;
+                    break;
+                }
+                result.sizes.push_back(nVertices);
+            }
+        });
+
+    faceOffsets.reserve(size + 1);
+    faceOffsets.push_back(0);
+    for(FaceChunk & chunk : chunks){
+        if(!chunk.valid) return false;
+        for(long nVertices : chunk.sizes){
+            faceOffsets.push_back(faceOffsets.back() + nVertices);
+        }
+        faceVertices.insert(faceVertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        chunk = FaceChunk();
+    }
+    return long(faceOffsets.size()) == size + 1;
+}
+
+/*!
+ * Read the boundary patches of an OpenFOAM boundary file.
+ * \param[in] filename path of the file
+ * \param[out] patches boundary patches
+ * \return false if the file is not found, not supported or corrupted.
+ */
+bool readBoundary(const std::string & filename, std::vector<PolyPatch> & patches){
+    patches.clear();
+    text::FileBuffer buffer;
+    if(!buffer.open(filename)) return false;
+    const char * cursor = buffer.begin();
+    const char * end = buffer.end();
+
+    FoamHeader header;
+    long size;
+    if(!parseHeader(cursor, end, header) || !parseListSize(cursor, end, size)) return false;
+
+    std::string word, value;
+    patches.resize(size);
+    for(PolyPatch & patch : patches){
+        if(!readWord(cursor, end, patch.name) || !expect(cursor, end, '{')) return false;
+        while(!expect(cursor, end, '}')){
+            if(!readWord(cursor, end, word)) return false;
+            if(expect(cursor, end, '{')){
+                if(!skipBlock(cursor, end)) return false;
+                continue;
+            }
+            if(!readEntryValue(cursor, end, value)) return false;
+            if(word == "type"){
+                patch.type = value;
+            }else if(word == "nFaces"){
+                patch.nFaces = std::atol(value.c_str());
+            }else if(word == "startFace"){
+                patch.startFace = std::atol(value.c_str());
+            }else if(word == "neighbProcNo"){
+                patch.neighbourProcessor = std::atoi(value.c_str());
+            }
+        }
+    }
+    return expect(cursor, end, ')');
+}
+
+/*!
+ * Read the polyMesh of an OpenFOAM case, or of a subdomain of a decomposed case, at a
+ * given time. As OpenFOAM does, points and faces are searched in the latest time
+ * directory not later than timeName containing them, then in constant. The files are
+ * read concurrently, sharing the threads available to the caller.
+ * \param[in] casePath path to the case, or to the processor directory of a subdomain
+ * \param[in] timeName name of the time directory
+ * \param[out] mesh polyMesh contents
+ * \param[in] readAddressing if true read the addressing files written by decomposePar
+ * \return false if a file is not found, not supported or corrupted.
+ */
+bool readPolyMesh(const std::string & casePath, const std::string & timeName, PolyMesh & mesh, bool readAddressing){
+    mesh.clear();
+    std::string pointsDir = findMeshInstance(casePath, timeName, "points");
+    std::string facesDir = findMeshInstance(casePath, timeName, "faces");
+    std::string addressingDir = casePath + "/constant/polyMesh";
+
+    std::vector<std::function<bool()>> tasks;
+    tasks.push_back([&](){ return readPoints(pointsDir + "/points", mesh.points); });
+    tasks.push_back([&](){ return readFaces(facesDir + "/faces", mesh.faceOffsets, mesh.faceVertices); });
+    tasks.push_back([&](){ return readLabels(facesDir + "/owner", mesh.owner, &mesh.labelSize); });
+    tasks.push_back([&](){ return readLabels(facesDir + "/neighbour", mesh.neighbour); });
+    tasks.push_back([&](){ return readBoundary(facesDir + "/boundary", mesh.patches); });
+    if(readAddressing){
+        tasks.push_back([&](){ return readLabels(addressingDir + "/pointProcAddressing", mesh.pointAddressing); });
+        tasks.push_back([&](){ return readLabels(addressingDir + "/faceProcAddressing", mesh.faceAddressing); });
+        tasks.push_back([&](){ return readLabels(addressingDir + "/cellProcAddressing", mesh.cellAddressing); });
+    }
+    // the files share the threads available to the caller, see threads::parallelFor
+    std::vector<int> status(tasks.size(), 0);
+    threads::parallelFor(0, tasks.size(), [&](std::size_t begin, std::size_t end){
+        for(std::size_t i = begin; i < end; ++i){
+            status[i] = int(tasks[i]());
+        }
+    }, 1);
+    for(int flag : status){
+        if(flag == 0) return false;
+    }
+
+    long nFaces = mesh.getFaceCount();
+    if(long(mesh.owner.size()) != nFaces || long(mesh.neighbour.size()) > nFaces) return false;
+    long maxCell = -1;
+    for(long cell : mesh.owner)     maxCell = std::max(maxCell, cell);
+    for(long cell : mesh.neighbour) maxCell = std::max(maxCell, cell);
+    mesh.nCells = maxCell + 1;
+
+    long maxPoint = -1;
+    for(long vertex : mesh.faceVertices) maxPoint = std::max(maxPoint, vertex);
+    if(maxPoint >= long(mesh.points.size())) return false;
+
+    if(readAddressing){
+        if(mesh.pointAddressing.size() != mesh.points.size()) return false;
+        if(long(mesh.faceAddressing.size()) != nFaces) return false;
+        if(long(mesh.cellAddressing.size()) != mesh.nCells) return false;
+    }
+    for(const PolyPatch & patch : mesh.patches){
+        if(patch.startFace < 0 || patch.nFaces < 0 || patch.startFace + patch.nFaces > nFaces) return false;
+    }
+    return true;
+}
+
+/*!
+ * \return the number of processor directories, processor0 ... processorN-1, of a decomposed
+ * case, 0 if the case is not decomposed.
+ * \param[in] casePath path to the case
+ */
+int countProcessorDirectories(const std::string & casePath){
+    int count = 0;
+    while(fileExists(casePath + "/processor" + std::to_string(count) + "/constant/polyMesh/boundary")){
+        ++count;
+    }
+    return count;
+}
+
+/*!
+ * \return the names of the time directories of a case, sorted by increasing time.
+ * The constant directory is not included.
+ * \param[in] casePath path to the case, or to a processor directory
+ */
+std::vector<std::string> listTimeDirectories(const std::string & casePath){
+    std::vector<std::pair<double, std::string>> times;
+    DIR * dir = opendir(casePath.c_str());
+    if(dir){
+        while(struct dirent * entry = readdir(dir)){
+            std::string name(entry->d_name);
+            const char * begin = name.c_str();
+            char * parsedEnd;
+            double value = std::strtod(begin, &parsedEnd);
+            if(name.empty() || parsedEnd != begin + name.size()) continue;
+            times.emplace_back(value, name);
+        }
+        closedir(dir);
+    }
+    std::sort(times.begin(), times.end());
+    std::vector<std::string> names;
+    names.reserve(times.size());
+    for(auto & time : times){
+        names.push_back(time.second);
+    }
+    return names;
+}
+
+/*!
+ * \return the name of the start time directory of a case, as set by the startFrom and
+ * startTime entries of system/controlDict; "0" if the dictionary cannot be read.
+ * \param[in] casePath path to the case
+ * \param[in] decomposed if true, time directories are searched in processor0
+ */
+std::string getStartTime(const std::string & casePath, bool decomposed){
+    std::string startFrom = "startTime";
+    std::string startTime = "0";
+
+    text::FileBuffer buffer;
+    if(buffer.open(casePath + "/system/controlDict")){
+        const char * cursor = buffer.begin();
+        const char * end = buffer.end();
+        FoamHeader header;
+        std::string word, value;
+        if(parseHeader(cursor, end, header)){
+            while(readWord(cursor, end, word)){
+                if(expect(cursor, end, '{')){
+                    if(!skipBlock(cursor, end)) break;
+                    continue;
+                }
+                if(!readEntryValue(cursor, end, value)) break;
+                if(word == "startFrom")  startFrom = value;
+                if(word == "startTime")  startTime = value;
+            }
+        }
+    }
+
+    if(startFrom == "startTime") {
+        // use the name of the time directory matching the value, if any
+        std::vector<std::string> times = listTimeDirectories(decomposed ? casePath + "/processor0" : casePath);
+        double value = std::strtod(startTime.c_str(), nullptr);
+        for(const std::string & time : times){
+            if(std::strtod(time.c_str(), nullptr) == value) return time;
+        }
+        return startTime;
+    }
+
+    std::vector<std::string> times = listTimeDirectories(decomposed ? casePath + "/processor0" : casePath);
+    if(times.empty()) return "0";
+    return (startFrom == "latestTime") ? times.back() : times.front();
+}
+
+/*!
+ * Find the polyMesh directory containing a mesh file at a given time, searching the
+ * latest time directory not later than timeName containing it, then constant.
+ * \param[in] casePath path to the case, or to a processor directory
+ * \param[in] timeName name of the time directory
+ * \param[in] fileName name of the mesh file, e.g. points or faces
+ * \return path to the polyMesh directory.
+ */
+std::string findMeshInstance(const std::string & casePath, const std::string & timeName, const std::string & fileName){
+    double current = std::strtod(timeName.c_str(), nullptr);
+    std::vector<std::string> times = listTimeDirectories(casePath);
+    for(auto it = times.rbegin(); it != times.rend(); ++it){
+        if(std::strtod(it->c_str(), nullptr) > current) continue;
+        std::string dir = casePath + "/" + *it + "/polyMesh";
+        if(fileExists(dir + "/" + fileName)) return dir;
+    }
+    return casePath + "/constant/polyMesh";
+}
+
+/*!
+ * \return the name of the time directory of a time value, formatted as OpenFOAM does
+ * with the default general time format and precision.
+ * \param[in] time time value
+ */
+std::string getTimeName(double time){
+    std::ostringstream name;
+    name << std::setprecision(6) << time;
+    return name.str();
+}
+
+/*!
+ * Write the points file of a polyMesh, in binary format, in the time directory of a case.
+ * The time and polyMesh directories are created if missing. Only the points file is
+ * written: the other mesh files are found by OpenFOAM in the previous mesh instance.
+ * \param[in] casePath path to the case, or to a processor directory
+ * \param[in] timeName name of the time directory
+ * \param[in] points coordinates of the points, in OpenFOAM order
+ * \param[in] labelSize size in bytes of labels declared in the file header; use the one of
+ *            the mesh files of the case, e.g. as read by readPolyMesh or readLabels
+ * \return false if the file cannot be written.
+ */
+bool writePoints(const std::string & casePath, const std::string & timeName, const std::vector<std::array<double,3>> & points, int labelSize){
+    static_assert(sizeof(std::array<double,3>) == 3 * sizeof(double), "points are expected to be contiguous");
+    std::string dir = casePath + "/" + timeName;
+    mkdir(dir.c_str(), 0755);
+    dir += "/polyMesh";
+    mkdir(dir.c_str(), 0755);
+
+    std::ofstream out(dir + "/points", std::ios::binary);
+    if(!out.is_open()) return false;
+
+    out << "FoamFile\n{\n";
+    out << "    version     2.0;\n";
+    out << "    format      binary;\n";
+    out << "    class       vectorField;\n";
+    out << "    arch        \"" << (isLittleEndian() ? "LSB" : "MSB") << ";label=" << 8*labelSize << ";scalar=" << 8*sizeof(double) << "\";\n";
+    out << "    location    \"" << timeName << "/polyMesh\";\n";
+    out << "    object      points;\n}\n\n";
+    out << points.size() << "\n(";
+    if(!points.empty()){
+        out.write(reinterpret_cast<const char *>(points.data()), std::streamsize(3 * sizeof(double) * points.size()));
+    }
+    out << ")\n";
+    return out.good();
+}
+
+/*!
+ * Compute the faces of each cell of a polyMesh, in compact form. Faces are encoded with
+ * their orientation with respect to the cell: a face f owned by the cell, whose normal
+ * points outwards, is stored as f; a face f whose neighbour is the cell is stored as -f-1.
+ * \param[in] mesh polyMesh
+ * \param[out] cellOffsets offsets of the cells in cellFaces, of size number of cells + 1
+ * \param[out] cellFaces encoded faces of the cells
+ */
+void getCellFaces(const PolyMesh & mesh, std::vector<long> & cellOffsets, std::vector<long> & cellFaces){
+    cellOffsets.assign(mesh.nCells + 1, 0);
+    for(long cell : mesh.owner)     ++cellOffsets[cell + 1];
+    for(long cell : mesh.neighbour) ++cellOffsets[cell + 1];
+    for(long i = 0; i < mesh.nCells; ++i){
+        cellOffsets[i + 1] += cellOffsets[i];
+    }
+    cellFaces.resize(cellOffsets.back());
+    std::vector<long> filled(cellOffsets.begin(), cellOffsets.end() - 1);
+    long nFaces = long(mesh.owner.size());
+    for(long face = 0; face < nFaces; ++face){
+        cellFaces[filled[mesh.owner[face]]++] = face;
+    }
+    long nInternal = long(mesh.neighbour.size());
+    for(long face = 0; face < nInternal; ++face){
+        cellFaces[filled[mesh.neighbour[face]]++] = -face - 1;
+    }
+}
+
+/*!
+ * Get the vertices of a face, oriented with respect to a cell.
+ * \param[in] mesh polyMesh
+ * \param[in] face encoded face, as returned by getCellFaces
+ * \param[out] vertices vertices of the face, ordered so that the face normal points
+ * outwards of the cell
+ */
+void getFaceVertices(const PolyMesh & mesh, long face, std::vector<long> & vertices){
+    bool flip = face < 0;
+    if(flip) face = -face - 1;
+    vertices.assign(mesh.faceVertices.begin() + mesh.faceOffsets[face], mesh.faceVertices.begin() + mesh.faceOffsets[face + 1]);
+    if(flip) std::reverse(vertices.begin(), vertices.end());
+}
+
+/*!
+ * Recognize the shape of a polyMesh cell among the OpenFOAM models hex, prism, pyr and tet.
+ * The vertices of the recognized shape follow the OpenFOAM cellModel ordering, as the ones
+ * returned by Foam::cellShape.
+ * \param[in] mesh polyMesh
+ * \param[in] faces encoded faces of the cell, as returned by getCellFaces
+ * \param[in] nFaces number of faces of the cell
+ * \param[out] shape vertices of the cell shape
+ * \return name of the OpenFOAM cell model, or an empty string if the cell is a generic polyhedron.
+ */
+std::string getCellShape(const PolyMesh & mesh, const long * faces, std::size_t nFaces, std::vector<long> & shape){
+    shape.clear();
+    if(nFaces < 4 || nFaces > 6) return "";
+
+    std::vector<std::vector<long>> vertices(nFaces);
+    int nTriangles = 0, nQuads = 0;
+    int base = -1;
+    for(std::size_t i = 0; i < nFaces; ++i){
+        getFaceVertices(mesh, faces[i], vertices[i]);
+        if(vertices[i].size() == 3) ++nTriangles;
+        else if(vertices[i].size() == 4) ++nQuads;
+        else return "";
+    }
+
+    std::string model;
+    std::size_t nVertices;
+    std::size_t baseSize;
+    if(nFaces == 4 && nTriangles == 4){
+        model = "tet";     nVertices = 4; baseSize = 3;
+    }else if(nFaces == 5 && nQuads == 1){
+        model = "pyr";     nVertices = 5; baseSize = 4;
+    }else if(nFaces == 5 && nQuads == 3){
+        model = "prism";   nVertices = 6; baseSize = 3;
+    }else if(nFaces == 6 && nQuads == 6){
+        model = "hex";     nVertices = 8; baseSize = 4;
+    }else{
+        return "";
+    }
+    for(std::size_t i = 0; i < nFaces && base < 0; ++i){
+        if(vertices[i].size() == baseSize) base = int(i);
+    }
+
+    // the base face, with outward normal, is (0 2 1) for tet and prism, (0 3 2 1) for pyr and hex.
+    const std::vector<long> & baseFace = vertices[base];
+    shape.assign(nVertices, -1);
+    shape[0] = baseFace[0];
+    for(std::size_t k = 1; k < baseSize; ++k){
+        shape[baseSize - k] = baseFace[k];
+    }
+
+    std::vector<long> cellVertices;
+    for(const std::vector<long> & face : vertices){
+        cellVertices.insert(cellVertices.end(), face.begin(), face.end());
+    }
+    std::sort(cellVertices.begin(), cellVertices.end());
+    cellVertices.erase(std::unique(cellVertices.begin(), cellVertices.end()), cellVertices.end());
+    if(cellVertices.size() != nVertices) return "";
+
+    auto inBase = [&](long vertex){
+        return std::find(baseFace.begin(), baseFace.end(), vertex) != baseFace.end();
+    };
+
+    if(model == "tet" || model == "pyr"){
+        // apex: the only vertex out of the base
+        for(long vertex : cellVertices){
+            if(!inBase(vertex)) shape[baseSize] = vertex;
+        }
+    }else{
+        // top vertex k + baseSize is the one connected by an edge to base vertex k
+        for(std::size_t k = 0; k < baseSize; ++k){
+            long found = -1;
+            for(const std::vector<long> & face : vertices){
+                std::size_t size = face.size();
+                for(std::size_t j = 0; j < size; ++j){
+                    long a = face[j], b = face[(j + 1) % size];
+                    if(a == shape[k] && !inBase(b)) found = b;
+                    if(b == shape[k] && !inBase(a)) found = a;
+                }
+            }
+            if(found < 0) return "";
+            shape[k + baseSize] = found;
+        }
+    }
+
+    std::vector<long> check(shape);
+    std::sort(check.begin(), check.end());
+    if(check != cellVertices) return "";
+    return model;
+}
+
+/*!
+ * Default constructor.
+ */
+PolyPatch::PolyPatch() : startFace(0), nFaces(0), neighbourProcessor(-1){}
+
+/*!
+ * \return true if the patch is a processor boundary of a decomposed case.
+ */
+bool PolyPatch::isProcessor() const{
+    return type == "processor" || type == "processorCyclic";
+}
+
+/*!
+ * Default constructor.
+ */
+PolyMesh::PolyMesh() : nCells(0), labelSize(4){}
+
+/*!
+ * \return number of faces.
+ */
+long PolyMesh::getFaceCount() const{
+    return faceOffsets.empty() ? 0 : long(faceOffsets.size()) - 1;
+}
+
+/*!
+ * Release the contents.
+ */
+void PolyMesh::clear(){
+    std::vector<std::array<double,3>>().swap(points);
+    std::vector<long>().swap(faceOffsets);
+    std::vector<long>().swap(faceVertices);
+    std::vector<long>().swap(owner);
+    std::vector<long>().swap(neighbour);
+    std::vector<PolyPatch>().swap(patches);
+    std::vector<long>().swap(pointAddressing);
+    std::vector<long>().swap(faceAddressing);
+    std::vector<long>().swap(cellAddressing);
+    nCells = 0;
+    labelSize = 4;
+}
+
+}// end namespace foamUtilsRaw
+
+}// end namespace mimmo
@@ -0,0 +1,111 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+#ifndef FOAM_FILES_RAW_H
+#define FOAM_FILES_RAW_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mimmo{
+
+/*!
+ * \brief Utilities reading the files of an OpenFOAM polyMesh directly, without
+ * employing native OpenFOAM libraries, and writing back its points.
+ *
+ * Uncompressed files written in ascii or binary format are supported; binary files
+ * have to share the endianness of the host. Labels of 32 or 64 bits and scalars of
+ * 32 or 64 bits are supported, as declared by the arch entry of the file header.
+ * Each function returns false for unsupported or corrupted files, so that the caller
+ * can fall back to the native OpenFOAM libraries.
+ *
+ * \ingroup ioofoam
+ */
+namespace foamUtilsRaw{
+
+    /*!
+     * \brief Boundary patch of an OpenFOAM polyMesh.
+     */
+    struct PolyPatch{
+        std::string name;               /**< Name of the patch.*/
+        std::string type;               /**< Type of the patch, e.g. wall, patch, processor.*/
+        long        startFace;          /**< Index of the first face of the patch.*/
+        long        nFaces;             /**< Number of faces of the patch.*/
+        int         neighbourProcessor; /**< Neighbour subdomain of processor patches, -1 otherwise.*/
+
+        PolyPatch();
+        bool        isProcessor() const;
+    };
+
+    /*!
+     * \brief Contents of an OpenFOAM polyMesh directory.
+     *
+     * Faces are stored in compact form: the vertices of face i are
+     * faceVertices[faceOffsets[i]] ... faceVertices[faceOffsets[i+1]-1].
+     * Addressing lists are filled only for the subdomains of a decomposed case and map
+     * local points, faces and cells to the ones of the undecomposed mesh; face addressing
+     * is stored as written by decomposePar, i.e. 1-based and signed (negative if the face
+     * is flipped with respect to the undecomposed mesh).
+     */
+    struct PolyMesh{
+        std::vector<std::array<double,3>>   points;             /**< Coordinates of the points.*/
+        std::vector<long>                   faceOffsets;        /**< Offsets of the faces in faceVertices.*/
+        std::vector<long>                   faceVertices;       /**< Vertices of the faces.*/
+        std::vector<long>                   owner;              /**< Owner cell of each face.*/
+        std::vector<long>                   neighbour;          /**< Neighbour cell of each internal face.*/
+        std::vector<PolyPatch>              patches;            /**< Boundary patches.*/
+        std::vector<long>                   pointAddressing;    /**< Local to global point map.*/
+        std::vector<long>                   faceAddressing;     /**< Local to global signed 1-based face map.*/
+        std::vector<long>                   cellAddressing;     /**< Local to global cell map.*/
+        long                                nCells;             /**< Number of cells.*/
+        int                                 labelSize;          /**< Size in bytes of labels, as declared by the mesh files.*/
+
+        PolyMesh();
+        long        getFaceCount() const;
+        void        clear();
+    };
+
+    bool readPoints(const std::string & filename, std::vector<std::array<double,3>> & points, int * labelSize = nullptr);
+    bool readLabels(const std::string & filename, std::vector<long> & labels, int * labelSize = nullptr);
+    bool readFaces(const std::string & filename, std::vector<long> & faceOffsets, std::vector<long> & faceVertices);
+    bool readBoundary(const std::string & filename, std::vector<PolyPatch> & patches);
+    bool readPolyMesh(const std::string & casePath, const std::string & timeName, PolyMesh & mesh, bool readAddressing = false);
+
+    int  countProcessorDirectories(const std::string & casePath);
+    std::vector<std::string> listTimeDirectories(const std::string & casePath);
+    std::string getStartTime(const std::string & casePath, bool decomposed = false);
+    std::string findMeshInstance(const std::string & casePath, const std::string & timeName, const std::string & fileName);
+    std::string getTimeName(double time);
+
+    bool writePoints(const std::string & casePath, const std::string & timeName, const std::vector<std::array<double,3>> & points, int labelSize = 4);
+
+    void getCellFaces(const PolyMesh & mesh, std::vector<long> & cellOffsets, std::vector<long> & cellFaces);
+    void getFaceVertices(const PolyMesh & mesh, long face, std::vector<long> & vertices);
+    std::string getCellShape(const PolyMesh & mesh, const long * faces, std::size_t nFaces, std::vector<long> & shape);
+
+};//end namespace foamUtilsRaw
+
+}// end namespace mimmo.
+#endif
@@ -110,6 +110,9 @@ Apply::buildPorts(){
 	built = (built && createPortIn<dmpvecarr3E*, Apply>(this, &Apply::setInput, M_GDISPLS, true, 1));
     built = (built && createPortIn<dmpvector1D*, Apply>(this, &Apply::setScalarInput, M_SCALARFIELD, true, 1));
     built = (built && createPortIn<dmpvector1D*, Apply>(this, &Apply::setFilter, M_FILTER));
+    built = (built && createPortIn<fmpvecarr3E*, Apply>(this, &Apply::setInputFloat32, M_GDISPLS32, true, 1));
+    built = (built && createPortIn<fmpvector1D*, Apply>(this, &Apply::setScalarInputFloat32, M_SCALARFIELD32, true, 1));
+    built = (built && createPortIn<fmpvector1D*, Apply>(this, &Apply::setFilterFloat32, M_FILTER32));
 	built = (built && createPortIn<MimmoSharedPointer<MimmoObject>, Apply>(this, &BaseManipulation::setGeometry, M_GEOM, true));
 
 	built = (built && createPortOut<MimmoSharedPointer<MimmoObject>, Apply>(this, &BaseManipulation::getGeometry, M_GEOM));
@@ -150,6 +153,36 @@ Apply::setFilter(dmpvector1D *input){
     m_filter = *input;
 };
 
+/*!It sets the displacements input given in single precision.
+ * The displacements are converted to double precision to deform the geometry.
+ * \param[in] input Input displacements of the geometry vertices.
+ */
+void
+Apply::setInputFloat32(fmpvecarr3E *input){
+    if(!input)  return;
+    m_input = toFloat64(*input);
+};
+
+/*!It sets the displacements given as scalar input in single precision.
+ * The field is converted to double precision; see setScalarInput.
+ * \param[in] input Input displacements of the geometry vertices given as module of normal directed vectors.
+ */
+void
+Apply::setScalarInputFloat32(fmpvector1D *input){
+    if(!input) return;
+    m_scalarinput = toFloat64(*input);
+};
+
+/*!It sets the filter to be applied during the deformation of the geometry, given in single precision.
+ * The filter is converted to double precision; see setFilter.
+ * \param[in] input Input filter field used during the deformation.
+ */
+void
+Apply::setFilterFloat32(fmpvector1D *input){
+    if(!input) return;
+    m_filter = toFloat64(*input);
+};
+
 /*!It sets the displacements scalar factor.
  * The displacements will be scaled by using this factor.
  * \param[in] alpha Scale factor of displacements field.
@@ -251,17 +284,21 @@ Apply::execute(){
 	checkInput();
 
 	m_output = m_input;
+	m_output = m_factor * m_output;
 
+	// output is aligned to geometry vertices: traverse them side by side.
+	beginInPlaceDeformation();
 	darray3E vertexcoords;
 	long int ID;
+	auto itOut = m_output.cbegin();
 	for (const auto & vertex : m_geometry->getVertices()){
 		vertexcoords = vertex.getCoords();
 		ID = vertex.getId();
-		std::array<double,3> val = m_factor*m_input[ID];
-		m_output[ID] = val;
-		vertexcoords += val;
+		vertexcoords += *itOut;
+		++itOut;
 		getGeometry()->modifyVertex(vertexcoords, ID);
 	}
+	endInPlaceDeformation();
 
     //step 2: produce annotations.
     if(m_annotation){
@@ -433,11 +470,10 @@ Apply::checkInput(){
 	    // Complete missing data force filter to 0.
 	    check = check && m_filter.completeMissingData(0.0);
 	    if (check){
-	        // Apply filter to deformation field
-	        for (const auto & vertex : m_geometry->getVertices()){
-	            long ID = vertex.getId();
-	            m_input[ID] *= m_filter[ID];
-	        }
+	        // Apply filter to deformation field, both aligned to geometry vertices.
+	        m_input.alignToGeometry({{0.0,0.0,0.0}});
+	        m_filter.alignToGeometry(0.0);
+	        m_input = m_input * m_filter;
 	    }
 	}
 	if (!check){
@@ -452,6 +488,7 @@ Apply::checkInput(){
 			m_input.insert(vertex.getId(), {{0.0,0.0,0.0}});
 		}
 	}
+	m_input.alignToGeometry({{0.0,0.0,0.0}});
 };
 
 }
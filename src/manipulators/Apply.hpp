@@ -42,6 +42,8 @@ namespace mimmo{
  *    of a displacements field with direction along the normal of the surface on each vertex.
  *    The Apply block allows to pass a scalar filter field; the filter field is applied to the
  *    displacements field before the geometry deformation.
+ *    Displacements and filter can be given in single precision too (ports M_GDISPLS32,
+ *    M_SCALARFIELD32, M_FILTER32): they are converted to double precision when received.
  *
  *    After the execution of an object Apply, the original geometry will be modified.
  *    The resulting deformation field is provided as output of the block.
@@ -57,6 +59,9 @@ namespace mimmo{
      | M_GDISPLS | setInput          | (MC_SCALAR,MD_MPVECARR3FLOAT_) |
      | M_SCALARFIELD | setScalarInput    | (MC_SCALAR,MD_MPVECFLOAT_) |
      | M_FILTER | setFilter    | (MC_SCALAR,MD_MPVECFLOAT_) |
+     | M_GDISPLS32 | setInputFloat32   | (MC_SCALAR,MD_MPVECARR3FLOAT32_) |
+     | M_SCALARFIELD32 | setScalarInputFloat32 | (MC_SCALAR,MD_MPVECFLOAT32_) |
+     | M_FILTER32 | setFilterFloat32  | (MC_SCALAR,MD_MPVECFLOAT32_) |
      | M_GEOM    | setGeometry       | (MC_SCALAR,MD_MIMMO_) |
 
      |Port Output | | |
@@ -102,6 +107,9 @@ public:
     void setInput(dmpvecarr3E *input);
     void setScalarInput(dmpvector1D* input);
     void setFilter(dmpvector1D* input);
+    void setInputFloat32(fmpvecarr3E *input);
+    void setScalarInputFloat32(fmpvector1D* input);
+    void setFilterFloat32(fmpvector1D* input);
 
     void setScaling(double alpha);
 
@@ -143,6 +151,9 @@ protected:
 REGISTER_PORT(M_GDISPLS, MC_SCALAR, MD_MPVECARR3FLOAT_, __APPLYDEFORMATION_HPP__)
 REGISTER_PORT(M_SCALARFIELD, MC_SCALAR, MD_MPVECFLOAT_, __APPLYDEFORMATION_HPP__)
 REGISTER_PORT(M_FILTER, MC_SCALAR, MD_MPVECFLOAT_, __APPLYDEFORMATION_HPP__)
+REGISTER_PORT(M_GDISPLS32, MC_SCALAR, MD_MPVECARR3FLOAT32_, __APPLYDEFORMATION_HPP__)
+REGISTER_PORT(M_SCALARFIELD32, MC_SCALAR, MD_MPVECFLOAT32_, __APPLYDEFORMATION_HPP__)
+REGISTER_PORT(M_FILTER32, MC_SCALAR, MD_MPVECFLOAT32_, __APPLYDEFORMATION_HPP__)
 REGISTER_PORT(M_GEOM, MC_SCALAR, MD_MIMMO_, __APPLYDEFORMATION_HPP__)
 REGISTER_PORT(M_LONGFIELD, MC_SCALAR, MD_MPVECLONG_, __APPLYDEFORMATION_HPP__)
 REGISTER_PORT(M_LONGFIELD2, MC_SCALAR, MD_MPVECLONG_, __APPLYDEFORMATION_HPP__)
@@ -79,6 +79,9 @@ ApplyFilter::buildPorts(){
 	built = (built && createPortIn<dmpvecarr3E*, ApplyFilter>(this, &ApplyFilter::setInput, M_GDISPLS, true, 1));
     built = (built && createPortIn<dmpvector1D*, ApplyFilter>(this, &ApplyFilter::setScalarInput, M_SCALARFIELD, true, 1));
     built = (built && createPortIn<dmpvector1D*, ApplyFilter>(this, &ApplyFilter::setFilter, M_FILTER));
+    built = (built && createPortIn<fmpvecarr3E*, ApplyFilter>(this, &ApplyFilter::setInputFloat32, M_GDISPLS32, true, 1));
+    built = (built && createPortIn<fmpvector1D*, ApplyFilter>(this, &ApplyFilter::setScalarInputFloat32, M_SCALARFIELD32, true, 1));
+    built = (built && createPortIn<fmpvector1D*, ApplyFilter>(this, &ApplyFilter::setFilterFloat32, M_FILTER32));
     built = (built && createPortIn<MimmoSharedPointer<MimmoObject>, Apply>(this, &BaseManipulation::setGeometry, M_GEOM));
 
 	built = (built && createPortOut<dmpvecarr3E*, ApplyFilter>(this, &ApplyFilter::getOutput, M_GDISPLS));
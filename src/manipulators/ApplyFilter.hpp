@@ -50,6 +50,9 @@ namespace mimmo{
      | M_GDISPLS | setInput          | (MC_SCALAR,MD_MPVECARR3FLOAT_) |
      | M_SCALARFIELD | setScalarInput    | (MC_SCALAR,MD_MPVECFLOAT_) |
      | M_FILTER | setFilter    | (MC_SCALAR,MD_MPVECFLOAT_) |
+     | M_GDISPLS32 | setInputFloat32   | (MC_SCALAR,MD_MPVECARR3FLOAT32_) |
+     | M_SCALARFIELD32 | setScalarInputFloat32 | (MC_SCALAR,MD_MPVECFLOAT32_) |
+     | M_FILTER32 | setFilterFloat32  | (MC_SCALAR,MD_MPVECFLOAT32_) |
      | M_GEOM    | setGeometry       | (MC_SCALAR,MD_MIMMO_) |
 
      |Port Output | | |
@@ -116,6 +119,9 @@ private:
 REGISTER_PORT(M_GDISPLS, MC_SCALAR, MD_MPVECARR3FLOAT_, __APPLYFILTER_HPP__)
 REGISTER_PORT(M_SCALARFIELD, MC_SCALAR, MD_MPVECFLOAT_, __APPLYFILTER_HPP__)
 REGISTER_PORT(M_FILTER, MC_SCALAR, MD_MPVECFLOAT_, __APPLYFILTER_HPP__)
+REGISTER_PORT(M_GDISPLS32, MC_SCALAR, MD_MPVECARR3FLOAT32_, __APPLYFILTER_HPP__)
+REGISTER_PORT(M_SCALARFIELD32, MC_SCALAR, MD_MPVECFLOAT32_, __APPLYFILTER_HPP__)
+REGISTER_PORT(M_FILTER32, MC_SCALAR, MD_MPVECFLOAT32_, __APPLYFILTER_HPP__)
 
 REGISTER(BaseManipulation, ApplyFilter, "mimmo.ApplyFilter")
 
@@ -154,6 +154,7 @@ public:
 
     void     execute();
     void     apply();
+    bool     isThreadSafe();
 
     //XML utilities from reading writing settings to file
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name="");
@@ -123,6 +123,8 @@ FFDLattice::buildPorts(){
     //input
     built = (built && createPortIn<dvecarr3E, FFDLattice>(this, &mimmo::FFDLattice::setDisplacements, M_DISPLS));
     built = (built && createPortIn<dmpvector1D*, FFDLattice>(this, &mimmo::FFDLattice::setFilter,M_FILTER));
+    built = (built && createPortIn<fvecarr3E, FFDLattice>(this, &mimmo::FFDLattice::setDisplacementsFloat32, M_DISPLS32));
+    built = (built && createPortIn<fmpvector1D*, FFDLattice>(this, &mimmo::FFDLattice::setFilterFloat32,M_FILTER32));
     built = (built && createPortIn<iarray3E, FFDLattice>(this, &mimmo::FFDLattice::setDegrees, M_DEG));
     built = (built && createPortIn<dvector1D, FFDLattice>(this, &mimmo::FFDLattice::setNodalWeight, M_NURBSWEIGHTS));
     built = (built && createPortIn<std::array<mimmo::CoordType,3>, FFDLattice>(this, &mimmo::FFDLattice::setCoordType, M_NURBSCOORDTYPE));
@@ -283,6 +285,22 @@ FFDLattice::setDegrees(iarray3E degrees){
 void
 FFDLattice::setDisplacements(dvecarr3E displacements){
     m_displ = displacements;
+    markDirty();
+};
+
+/*! Set current DOF displacements of your lattice, given in single precision.
+   Displacements are converted to double precision; see setDisplacements.
+ * \param[in]  displacements of control nodes
+ */
+void
+FFDLattice::setDisplacementsFloat32(fvecarr3E displacements){
+    dvecarr3E displacements64(displacements.size());
+    for(std::size_t i=0; i<displacements.size(); ++i){
+        for(int loc=0; loc<3; ++loc){
+            displacements64[i][loc] = double(displacements[i][loc]);
+        }
+    }
+    setDisplacements(displacements64);
 };
 
 /*! Set if displacements are meant as global-true or local-false.
@@ -493,6 +511,17 @@ FFDLattice::setFilter(dmpvector1D *filter){
     m_filter = *filter;
 };
 
+/*! Sets filter field given in single precision. The field is converted to double precision;
+ * see setFilter.
+ * \param[in] filter fields.
+ */
+void
+FFDLattice::setFilterFloat32(fmpvector1D *filter){
+    if(!filter) return;
+    dmpvector1D filter64 = toFloat64(*filter);
+    setFilter(&filter64);
+};
+
 /*! Plot your current lattice as a structured grid to *vtu file.
    Wrapped method of plotGrid of mother class UStrucMesh.
 
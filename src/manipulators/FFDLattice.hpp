@@ -52,6 +52,8 @@ namespace mimmo{
      | <B>PortType</B>   | <B>variable/function</B>  |<B>DataType</B> |
      | M_DISPLS         | setDisplacements              | (MC_VECARR3, MD_FLOAT)    |
      | M_FILTER         | setFilter                     | (MC_SCALAR, MD_MPVECFLOAT_)     |
+     | M_DISPLS32       | setDisplacementsFloat32       | (MC_VECARR3, MD_FLOAT32)  |
+     | M_FILTER32       | setFilterFloat32              | (MC_SCALAR, MD_MPVECFLOAT32_)   |
      | M_DEG            | setDegrees                    | (MC_ARRAY3, MD_INT)       |
      | M_NURBSWEIGHTS   | setNodalWeight                | (MC_VECTOR, MD_FLOAT)     |
      | M_NURBSCOORDTYPE | setCoordType                  | (MC_ARRAY3, MD_COORDT)    |
@@ -176,6 +178,7 @@ public:
 
     void         setDegrees(iarray3E curveDegrees);
     void         setDisplacements(dvecarr3E displacements);
+    void         setDisplacementsFloat32(fvecarr3E displacements);
     void         setDisplGlobal(bool flag);
     void         setLattice(darray3E & origin, darray3E & span, ShapeType, iarray3E & dimensions, iarray3E & degrees);
     void         setLattice(darray3E & origin, darray3E & span, ShapeType, dvector1D & spacing, iarray3E & degrees);
@@ -187,6 +190,7 @@ public:
     void         setNodalWeight(dvector1D );
 
     void        setFilter(dmpvector1D * );
+    void        setFilterFloat32(fmpvector1D * );
 
     //plotting wrappers
     void        plotGrid(std::string directory, std::string filename, int counter, bool binary, bool deformed);
@@ -256,6 +260,8 @@ inline int FFDLattice::accessMapNodes(int i, int j, int k){
 
 REGISTER_PORT(M_DISPLS, MC_VECARR3, MD_FLOAT,__FFDLATTICE_HPP__)
 REGISTER_PORT(M_FILTER, MC_SCALAR, MD_MPVECFLOAT_,__FFDLATTICE_HPP__)
+REGISTER_PORT(M_DISPLS32, MC_VECARR3, MD_FLOAT32,__FFDLATTICE_HPP__)
+REGISTER_PORT(M_FILTER32, MC_SCALAR, MD_MPVECFLOAT32_,__FFDLATTICE_HPP__)
 REGISTER_PORT(M_DEG, MC_ARRAY3, MD_INT,__FFDLATTICE_HPP__)
 REGISTER_PORT(M_NURBSWEIGHTS, MC_VECTOR, MD_FLOAT,__FFDLATTICE_HPP__)
 REGISTER_PORT(M_NURBSCOORDTYPE, MC_ARRAY3, MD_COORDT,__FFDLATTICE_HPP__)
@@ -159,6 +159,8 @@ MRBF::buildPorts(){
     built = (built && createPortIn<std::vector<double>, MRBF>(this, &mimmo::MRBF::setScalarDisplacements, M_DATAFIELD));
     built = (built && createPortIn<std::vector<double>, MRBF>(this, &mimmo::MRBF::setVariableSupportRadii, M_DATAFIELD2));
 	built = (built && createPortIn<dmpvector1D*, MRBF>(this, &mimmo::MRBF::setFilter, M_FILTER));
+    built = (built && createPortIn<fvecarr3E, MRBF>(this, &mimmo::MRBF::setDisplacementsFloat32, M_DISPLS32));
+    built = (built && createPortIn<fmpvector1D*, MRBF>(this, &mimmo::MRBF::setFilterFloat32, M_FILTER32));
     built = (built && createPortIn<MimmoSharedPointer<MimmoObject>, MRBF>(this, &mimmo::MRBF::setNode, M_GEOM2));
     built = (built && createPortIn<dmpvecarr3E*, MRBF>(this, &mimmo::MRBF::setDisplacements, M_VECTORFIELD));
     built = (built && createPortIn<dmpvector1D*, MRBF>(this, &mimmo::MRBF::setScalarDisplacements, M_SCALARFIELD));
@@ -364,6 +366,17 @@ MRBF::setFilter(dmpvector1D * filter){
 	m_filter = *filter;
 };
 
+/*! Sets filter field given in single precision. The field is converted to double precision;
+ * see setFilter.
+ * \param[in] filter fields.
+ */
+void
+MRBF::setFilterFloat32(fmpvector1D * filter){
+    if(!filter) return;
+    dmpvector1D filter64 = toFloat64(*filter);
+    setFilter(&filter64);
+};
+
 /*! Find all possible duplicated nodes within a prescribed distance tolerance.
  * Default tolerance value is 1.0E-12;
  * \param[in] tol distance tolerance
@@ -528,6 +541,23 @@ MRBF::setDisplacements(dvecarr3E displ){
     m_areScalarResults = false;
 }
 
+/*!
+ * Set a list of 3D displacements on your RBF Nodes given in single precision.
+ * Displacements are converted to double precision; see setDisplacements.
+ *
+ * \param[in] displ list of nodal displacements
+ */
+void
+MRBF::setDisplacementsFloat32(fvecarr3E displ){
+    dvecarr3E displ64(displ.size());
+    for(std::size_t i=0; i<displ.size(); ++i){
+        for(int loc=0; loc<3; ++loc){
+            displ64[i][loc] = double(displ[i][loc]);
+        }
+    }
+    setDisplacements(displ64);
+}
+
 /*!
  * Set a field  of 3D displacements on your RBF Nodes. According to MRBFSol mode
  * active in the class set: displacements as direct RBF weights coefficients in MRBFSol::NONE mode,
@@ -791,26 +821,23 @@ MRBF::execute(){
         }
 	}
 
-	//apply m_filter if it's active;
+    // align results to geometry vertices, completing missing data with zero.
+    if(m_areScalarResults){
+        m_scalarDispl.alignToGeometry(0.0);
+    }else{
+        m_displ.alignToGeometry({{0.0,0.0,0.0}});
+    }
+
+	//apply m_filter if it's active; filter and results are aligned, so they are combined in a single pass.
 	if(m_bfilter){
 	    checkFilter();
+	    m_filter.alignToGeometry(0.0);
         if(m_areScalarResults){
-            for (auto it=m_scalarDispl.begin(); it!=m_scalarDispl.end(); ++it){
-                (*it) *= m_filter.at(it.getId());
-            }
+            m_scalarDispl = m_scalarDispl * m_filter;
         }else{
-            for (auto it=m_displ.begin(); it!=m_displ.end(); ++it){
-                (*it) *= m_filter.at(it.getId());
-            }
+            m_displ = m_displ * m_filter;
         }
 	}
-
-
-    if(m_areScalarResults){
-        m_scalarDispl.completeMissingData(0.0);
-    }else{
-        m_displ.completeMissingData({{0.0,0.0,0.0}});
-    }
 };
 
 /*!
@@ -100,6 +100,8 @@ enum class MRBFSol{
      | M_DATAFIELD | setScalarDisplacements       | (MC_VECTOR, MD_FLOAT)       |
      | M_DATAFIELD2| setVariableSupportRadii| (MC_VECTOR, MD_FLOAT)       |
      | M_FILTER    | setFilter              | (MC_SCALAR, MD_MPVECFLOAT_) |
+     | M_DISPLS32  | setDisplacementsFloat32 | (MC_VECARR3, MD_FLOAT32)   |
+     | M_FILTER32  | setFilterFloat32       | (MC_SCALAR, MD_MPVECFLOAT32_) |
      | M_GEOM      | setGeometry            | (MC_SCALAR, MD_MIMMO_)      |
      | M_GEOM2     | setNode                | (MC_SCALAR, MD_MIMMO_)      |
      | M_VECTORFIELD    | setDisplacements | (MC_SCALAR, MD_MPVECARR3FLOAT_)      |
@@ -205,6 +207,7 @@ public:
     void            setNode(dvecarr3E);
     void            setNode(MimmoSharedPointer<MimmoObject> geometry);
     void            setFilter(dmpvector1D * );
+    void            setFilterFloat32(fmpvector1D * );
 
     ivector1D       checkDuplicatedNodes(double tol=1.0E-12);
     bool            removeDuplicatedNodes(ivector1D * list=nullptr);
@@ -221,6 +224,7 @@ BITPIT_DEPRECATED(
     void            setTol(double tol);
     void            setDisplacements(dvecarr3E displ);
     void            setDisplacements(dmpvecarr3E* displ);
+    void            setDisplacementsFloat32(fvecarr3E displ);
     void            setScalarDisplacements(dvector1D displ);
     void            setScalarDisplacements(dmpvector1D* displ);
 
@@ -287,6 +291,8 @@ REGISTER_PORT(M_DISPLS, MC_VECARR3, MD_FLOAT ,__MRBF_HPP__)
 REGISTER_PORT(M_DATAFIELD, MC_VECTOR, MD_FLOAT, __MRBF_HPP_)
 REGISTER_PORT(M_DATAFIELD2, MC_VECTOR, MD_FLOAT, __MRBF_HPP_)
 REGISTER_PORT(M_FILTER, MC_SCALAR, MD_MPVECFLOAT_ ,__MRBF_HPP__)
+REGISTER_PORT(M_DISPLS32, MC_VECARR3, MD_FLOAT32 ,__MRBF_HPP__)
+REGISTER_PORT(M_FILTER32, MC_SCALAR, MD_MPVECFLOAT32_ ,__MRBF_HPP__)
 REGISTER_PORT(M_GEOM, MC_SCALAR, MD_MIMMO_ ,__MRBF_HPP__)
 REGISTER_PORT(M_GEOM2, MC_SCALAR, MD_MIMMO_ ,__MRBF_HPP_)
 REGISTER_PORT(M_VECTORFIELD, MC_SCALAR, MD_MPVECARR3FLOAT_ ,__MRBF_HPP_)
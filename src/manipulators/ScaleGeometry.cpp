@@ -197,6 +197,16 @@ ScaleGeometry::apply(){
     _apply(m_displ);
 }
 
+/*!
+ * The scaling displacements, including the mean point of the target geometry, are computed
+ * in the object; apply() deforms the target geometry, locked by the chain.
+ * \return true, the object can be executed concurrently in a parallel chain.
+ */
+bool
+ScaleGeometry::isThreadSafe(){
+    return true;
+}
+
 /*!
  * Check if the filter is related to the target geometry.
  * If not create a unitary filter field.
@@ -208,9 +218,7 @@ ScaleGeometry::checkFilter(){
     check = check && m_filter.getGeometry() == getGeometry();
 
     if (!check){
-        m_log->setPriority(bitpit::log::Verbosity::DEBUG);
         (*m_log)<<"Not valid filter found in "<<m_name<<". Proceeding with default unitary field"<<std::endl;
-        m_log->setPriority(bitpit::log::Verbosity::NORMAL);
 
         m_filter.clear();
         m_filter.setGeometry(m_geometry);
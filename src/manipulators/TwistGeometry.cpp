@@ -254,6 +254,16 @@ TwistGeometry::apply(){
     _apply(m_displ);
 }
 
+/*!
+ * The twist displacements are stored in the object, reading only the target geometry and
+ * the filter; apply() deforms the target geometry, locked by the chain.
+ * \return true, the object can be executed concurrently in a parallel chain.
+ */
+bool
+TwistGeometry::isThreadSafe(){
+    return true;
+}
+
 /*!
  * Check if the filter is related to the target geometry.
  * If not create a unitary filter field.
@@ -266,9 +276,7 @@ TwistGeometry::checkFilter(){
     check = check && m_filter.getGeometry() == getGeometry();
 
     if (!check){
-        m_log->setPriority(bitpit::log::Verbosity::DEBUG);
         (*m_log)<<"Not valid filter found in "<<m_name<<". Proceeding with default unitary field"<<std::endl;
-        m_log->setPriority(bitpit::log::Verbosity::NORMAL);
 
         m_filter.clear();
         m_filter.setGeometry(m_geometry);
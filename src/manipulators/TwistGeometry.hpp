@@ -115,6 +115,7 @@ public:
 
     void         execute();
     void         apply();
+    bool         isThreadSafe();
 
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name = "");
     virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name= "");
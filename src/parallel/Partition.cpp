@@ -220,6 +220,7 @@ Partition::execute(){
         getGeometry()->cleanSkdTree();
         getGeometry()->cleanKdTree();
         getGeometry()->cleanBoundingBox();
+        getGeometry()->cleanVertexNormals();
 #if MIMMO_ENABLE_MPI
         getGeometry()->resetPointGhostExchangeInfo();
 #endif
@@ -231,6 +232,8 @@ Partition::execute(){
             //getGeometry()->getPatch()->sortCells();
             getGeometry()->getPatch()->sortVertices();
         }
+        // The patch is modified directly: invalidate the caches keyed on the geometry revisions
+        getGeometry()->markTopologyChanged();
 
         // Adjacencies Sync and Interfaces Sync not changed by partition,
         // the bitpit partitioning maintains adjacencies and
@@ -256,6 +259,7 @@ Partition::execute(){
                 getBoundaryGeometry()->cleanSkdTree();
                 getBoundaryGeometry()->cleanKdTree();
                 getBoundaryGeometry()->cleanBoundingBox();
+                getBoundaryGeometry()->cleanVertexNormals();
         #if MIMMO_ENABLE_MPI
                 getBoundaryGeometry()->resetPointGhostExchangeInfo();
         #endif
@@ -267,6 +271,7 @@ Partition::execute(){
                     //getBoundaryGeometry()->getPatch()->sortCells();
                     getBoundaryGeometry()->getPatch()->sortVertices();
                 }
+                getBoundaryGeometry()->markTopologyChanged();
 
                 // Adjacencies Sync and Interfaces Sync not changed by partition,
                 // the bitpit partitioning maintains adjacencies and
@@ -106,8 +106,10 @@ PropagateScalarField::buildPorts(){
     PropagateField<1>::buildPorts();
 
     bool built = m_arePortsBuilt;
-    built = (built && createPortIn<dmpvector1D*, PropagateScalarField>(this, &PropagateScalarField::addDirichletConditions, M_FILTER, true));
+    built = (built && createPortIn<dmpvector1D*, PropagateScalarField>(this, &PropagateScalarField::addDirichletConditions, M_FILTER, true, 1));
+    built = (built && createPortIn<fmpvector1D*, PropagateScalarField>(this, &PropagateScalarField::addDirichletConditionsFloat32, M_FILTER32, true, 1));
     built = (built && createPortOut<dmpvector1D*, PropagateScalarField>(this, &PropagateScalarField::getPropagatedField, M_FILTER));
+    built = (built && createPortOut<fmpvector1D*, PropagateScalarField>(this, &PropagateScalarField::getPropagatedFieldFloat32, M_FILTER32));
 
     m_arePortsBuilt = built;
 };
@@ -129,6 +131,23 @@ PropagateScalarField::getPropagatedField(){
     return &m_tempfield;
 }
 
+/*!
+ * It gets the resulting propagated field on the whole bulk mesh, converted to single precision.
+ * \return Propagated field in single precision.
+ */
+fmpvector1D*
+PropagateScalarField::getPropagatedFieldFloat32(){
+    m_tempfield32.clear();
+    m_tempfield32.reserve(m_field.size());
+    m_tempfield32.setDataLocation(m_field.getDataLocation());
+    m_tempfield32.setGeometry(m_field.getGeometry());
+    for(auto it = m_field.begin(); it != m_field.end(); ++it){
+        m_tempfield32.insert(it.getId(), float((*it)[0]));
+    }
+
+    return &m_tempfield32;
+}
+
 /*!
   Add Dirichlet conditions for scalar field on the previously linked
   Dirichlet Boundary patches list.
@@ -152,6 +171,18 @@ PropagateScalarField::addDirichletConditions(dmpvector1D * bc){
     m_dirichletPatches.insert(m_tempDirichletBcs.back().getGeometry());
 }
 
+/*!
+ * Add Dirichlet conditions given in single precision. Values are converted to double
+ * precision for the solver; see addDirichletConditions.
+ * \param[in] bc dirichlet conditions
+ */
+void
+PropagateScalarField::addDirichletConditionsFloat32(fmpvector1D * bc){
+    if(!bc) return;
+    dmpvector1D bc64 = toFloat64(*bc);
+    addDirichletConditions(&bc64);
+}
+
 /*!
  * Force solver to get deformation in a finite number of substep
  * \param[in] sstep number of substep. Default is 1.
@@ -284,9 +315,7 @@ PropagateScalarField::execute(){
 
     //Laplacians update on border: store the id of the border, internal nodes only.
     // Don't worry here for ghosts, laplacianStencils are always defined on rank internals.
-    //TODO extract boundary vertex ID as unordered_set
-    livector1D borderPointsID_vector = geo->extractBoundaryVertexID(false);
-    std::unordered_set<long> borderPointsID(borderPointsID_vector.begin(), borderPointsID_vector.end());
+    std::unordered_set<long> borderPointsID = geo->extractBoundaryVertexSet(false);
 
     //get this inverse map -> you will need it to compact the stencils.
     //MPI version, here get ghost also for renumbering stencils purpose in initializeLaplaceSolver and assignBCAndEvaluateRHS.
@@ -341,7 +370,7 @@ PropagateScalarField::execute(){
     }
 
     //reconstruct getting the direct node map -> you will need it uncompact the system solution in global id.
-    lilimap mapdata = geo->getMapData(true);
+    lilimap mapdata = geo->getMapData(dataInv);
     reconstructResults(result, mapdata);
     // now data are direcly pushed in m_field.
 
@@ -694,7 +723,7 @@ bool PropagateVectorField::checkBoundariesCoherence(){
     // run over periodic surfaces and retain border patch vertices common with the volume mesh
     m_periodicBoundaryPoints.clear();
     for (MimmoSharedPointer<MimmoObject> obj : m_periodicSurfaces){
-        std::vector<long> tempboundary = obj->extractBoundaryVertexID(false); //no ghost, only internals
+        std::unordered_set<long> tempboundary = obj->extractBoundaryVertexSet(false); //no ghost, only internals
         //I have all internals and operations before guarantees me that
         //all internal points of periodic surfaces are present in the bulk mesh
         m_periodicBoundaryPoints.insert(tempboundary.begin(), tempboundary.end());
@@ -1142,14 +1171,12 @@ PropagateVectorField::execute(){
 
     //store the id of the border nodes only;
     //always defined on internals node. No need to ghosts for this list.
-    //TODO extract boundary vertex ID as unordered_set
-    livector1D borderPointsID_vector = geo->extractBoundaryVertexID(false);
-    std::unordered_set<long> borderPointsID(borderPointsID_vector.begin(), borderPointsID_vector.end());
+    std::unordered_set<long> borderPointsID = geo->extractBoundaryVertexSet(false);
 
     //get this inverse map -> you will need it to compact the stencils.
     dataInv = geo->getMapDataInv(true);
     //get this direct map -> you will need it to deflate compact solution of the system.
-    data = geo->getMapData(true);
+    data = geo->getMapData(dataInv);
     //need ghosts in both here for stencil renumbering in initialize/updateLaplace and assignBC
 
     //since bc is constant, even in case of multistep, once and for all
@@ -241,11 +241,13 @@ protected:
     | M_GEOM3        | addDampingBoundarySurface             | (MC_SCALAR, MD_MIMMO_) |
     | M_GEOM7        | addNarrowBandBoundarySurface          | (MC_SCALAR, MD_MIMMO_) |
     | M_FILTER       | addDirichletConditions                | (MC_SCALAR, MD_MPVECFLOAT_)|
+    | M_FILTER32     | addDirichletConditionsFloat32         | (MC_SCALAR, MD_MPVECFLOAT32_)|
 
     |Port Output|||
     ||||
     | <B>PortType</B>   | <B>variable/function</B>  |<B>DataType</B> |
     | M_FILTER         | getPropagatedField                  | (MC_SCALAR, MD_MPVECFLOAT_) |
+    | M_FILTER32       | getPropagatedFieldFloat32           | (MC_SCALAR, MD_MPVECFLOAT32_) |
 
  *    =========================================================
  *
@@ -292,8 +294,10 @@ public:
     PropagateScalarField & operator=(PropagateScalarField other);
 
     dmpvector1D* getPropagatedField();
+    fmpvector1D* getPropagatedFieldFloat32();
 
     void    addDirichletConditions(dmpvector1D *bc);
+    void    addDirichletConditionsFloat32(fmpvector1D *bc);
     void    setSolverMultiStep(unsigned int sstep);
 
     //cleaners and setters
@@ -316,6 +320,7 @@ protected:
 
 private:
     dmpvector1D m_tempfield;             /**< temporary field storage for output purpose of getPropagatedField */
+    fmpvector1D m_tempfield32;           /**< temporary single precision field storage for output purpose of getPropagatedFieldFloat32 */
     std::vector<MimmoPiercedVector<std::array<double,1> > > m_tempDirichletBcs; /**< temporary input bc dirichlet storage for input managing purposes */
 
     //override interface methods, unmeaningful for the current class.
@@ -505,6 +510,7 @@ REGISTER_PORT(M_GEOM5, MC_SCALAR, MD_MIMMO_,__PROPAGATEFIELD_HPP__)
 REGISTER_PORT(M_GEOM6, MC_SCALAR, MD_MIMMO_,__PROPAGATEFIELD_HPP__)
 REGISTER_PORT(M_GEOM7, MC_SCALAR, MD_MIMMO_,__PROPAGATEFIELD_HPP__)
 REGISTER_PORT(M_FILTER, MC_SCALAR, MD_MPVECFLOAT_,__PROPAGATEFIELD_HPP__)
+REGISTER_PORT(M_FILTER32, MC_SCALAR, MD_MPVECFLOAT32_,__PROPAGATEFIELD_HPP__)
 REGISTER_PORT(M_GDISPLS, MC_SCALAR, MD_MPVECARR3FLOAT_,__PROPAGATEFIELD_HPP__)
 
 REGISTER(BaseManipulation, PropagateScalarField, "mimmo.PropagateScalarField")
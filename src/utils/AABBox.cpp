@@ -263,6 +263,16 @@ AABBox::plot(std::string directory, std::string filename,int counter, bool binar
 };
 
 
+/*!
+ * The execution only reads the vertices of the target geometries, computing the box in
+ * the members of the object.
+ * \return true, the object can be executed concurrently in a parallel chain.
+ */
+bool
+AABBox::isThreadSafe(){
+    return true;
+}
+
 /*!Execute your object, calculate the AABBox of your geometry.
  * Implementation of pure virtual BaseManipulation::execute
  */
@@ -120,6 +120,7 @@ public:
 
     //building method
     void execute();
+    bool isThreadSafe();
 
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name = "");
     virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name= "");
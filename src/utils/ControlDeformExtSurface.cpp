@@ -25,6 +25,7 @@
 #include "SkdTreeUtils.hpp"
 #include <volcartesian.hpp>
 #include <CG.hpp>
+#include <unordered_set>
 
 namespace mimmo{
 
@@ -34,6 +35,8 @@ namespace mimmo{
 ControlDeformExtSurface::ControlDeformExtSurface(){
     m_name = "mimmo.ControlDeformExtSurface";
     m_tolerance = 0.0;
+    m_gridSpacing = 0.0;
+    m_gridTolerance = 0.0;
 
     m_allowed.insert((FileType::_from_string("STL"))._to_integral());
     m_allowed.insert((FileType::_from_string("SURFVTU"))._to_integral());
@@ -49,6 +52,8 @@ ControlDeformExtSurface::ControlDeformExtSurface(const bitpit::Config::Section &
 
     m_name = "mimmo.ControlDeformExtSurface";
     m_tolerance = 0.0;
+    m_gridSpacing = 0.0;
+    m_gridTolerance = 0.0;
     m_allowed.insert((FileType::_from_string("STL"))._to_integral());
     m_allowed.insert((FileType::_from_string("SURFVTU"))._to_integral());
     m_allowed.insert((FileType::_from_string("NAS"))._to_integral());
@@ -75,6 +80,8 @@ ControlDeformExtSurface::ControlDeformExtSurface(const ControlDeformExtSurface &
     m_geoList = other.m_geoList;
     m_geoFileList = other.m_geoFileList;
     m_tolerance = other.m_tolerance;
+    m_gridSpacing = other.m_gridSpacing;
+    m_gridTolerance = other.m_gridTolerance;
 };
 
 /*!
@@ -96,6 +103,10 @@ void ControlDeformExtSurface::swap(ControlDeformExtSurface & x) noexcept
     std::swap(m_geoList, x.m_geoList);
     std::swap(m_geoFileList, x.m_geoFileList);
     std::swap(m_tolerance, x.m_tolerance);
+    std::swap(m_gridSpacing, x.m_gridSpacing);
+    std::swap(m_gridTolerance, x.m_gridTolerance);
+    std::swap(m_grids, x.m_grids);
+    std::swap(m_fileGeos, x.m_fileGeos);
     m_violationField.swap(x.m_violationField);
     m_defField.swap(x.m_defField);
     BaseManipulation::swap(x);
@@ -161,6 +172,22 @@ ControlDeformExtSurface::getTolerance(){
     return m_tolerance;
 }
 
+/*!
+ * \return spacing of the sparse grid caching constraints distance field. 0 if the cache is disabled.
+ */
+double
+ControlDeformExtSurface::getDistanceGridSpacing(){
+    return m_gridSpacing;
+}
+
+/*!
+ * \return exact fallback tolerance of the sparse grid caching constraints distance field.
+ */
+double
+ControlDeformExtSurface::getDistanceGridTolerance(){
+    return m_gridTolerance;
+}
+
 /*!
  * Return the actual list of external geometry files selected as constraint to check your deformation.
    Only constraints specified by files are returned.
@@ -210,6 +237,34 @@ ControlDeformExtSurface::setTolerance(double tol){
     m_tolerance = std::max(0.0, tol);
 }
 
+/*!
+ * Set the spacing of the sparse grid caching the signed distance field of each
+  constraint surface (see DistanceGrid). Grid values are kept between successive
+  executions as long as constraints are unchanged, so that the distance of the deformed
+  points is mostly evaluated by interpolation. Constraints provided by files are read
+  only once when the cache is enabled.
+  \param[in] spacing grid spacing (>=0). If 0 the cache is disabled (default).
+ */
+void
+ControlDeformExtSurface::setDistanceGridSpacing(double spacing){
+    m_gridSpacing = std::max(0.0, spacing);
+    if(m_gridSpacing == 0.0){
+        m_grids.clear();
+        m_fileGeos.clear();
+    }
+}
+
+/*!
+ * Set the exact fallback tolerance of the distance grid cache. Deformed points
+  whose interpolated distance is lower than this value in absolute value are evaluated
+  exactly. A value of the order of the grid spacing is suggested.
+  \param[in] tol fallback tolerance (>=0).
+ */
+void
+ControlDeformExtSurface::setDistanceGridTolerance(double tol){
+    m_gridTolerance = std::max(0.0, tol);
+}
+
 /*!
  * Add a surface geometry as constraint for violation control.
   For MPI version, this is the only method to provide partitioned external constraint
@@ -293,6 +348,10 @@ ControlDeformExtSurface::clear(){
     m_defField.clear();
     m_violationField.clear();
     m_tolerance = 0.0;
+    m_gridSpacing = 0.0;
+    m_gridTolerance = 0.0;
+    m_grids.clear();
+    m_fileGeos.clear();
     BaseManipulation::clear();
 };
 
@@ -355,6 +414,21 @@ ControlDeformExtSurface::execute(){
     // then add those directly linked with addConstraint method.
     constraint_geos.insert(constraint_geos.end(), m_geoList.begin(), m_geoList.end());
 
+    //drop distance grids of geometries which are no more constraints, releasing them.
+    {
+        std::unordered_set<MimmoObject*> current;
+        for(MimmoSharedPointer<MimmoObject> & localg : constraint_geos){
+            current.insert(localg.get());
+        }
+        for(auto it = m_grids.begin(); it != m_grids.end();){
+            if(current.count(it->first.get()) == 0){
+                it = m_grids.erase(it);
+            }else{
+                ++it;
+            }
+        }
+    }
+
     //check list size of constraints and rise a warning if the list is empty.
     if(constraint_geos.empty()) {
         (*m_log)<<"Warning in " + m_name +" : no valid constraint geometries are linked to the class. "<<std::endl;
@@ -396,7 +470,20 @@ ControlDeformExtSurface::execute(){
         }
         searchRadius = std::max( suppval, norm2(loc_dcenter - 0.5*(bbMin + bbMax)) );
 
-        evaluateSignedDistance(points, localg, searchRadius, distances);
+        if(m_gridSpacing > 0.0){
+            //interpolate distances on the cached grid, evaluating missing values exactly.
+            DistanceGrid & grid = m_grids[localg];
+            grid.setSpacing(m_gridSpacing);
+            grid.setFallbackTolerance(m_gridTolerance);
+            grid.setEvaluator([&](const std::vector<darray3E> & work, std::vector<double> & values){
+                evaluateSignedDistance(work, localg, searchRadius, values);
+            });
+            grid.setup(localg, 0.25*norm2(bbMax - bbMin));
+            grid.evaluate(points, distances);
+            grid.setEvaluator(nullptr);
+        }else{
+            evaluateSignedDistance(points, localg, searchRadius, distances);
+        }
 
         distances *= refsign;
 
@@ -467,6 +554,28 @@ ControlDeformExtSurface::absorbSectionXML(const bitpit::Config::Section & slotXM
         setTolerance(value);
     }
 
+    if(slotXML.hasOption("DistanceGridSpacing")){
+        std::string input = slotXML.get("DistanceGridSpacing");
+        input = bitpit::utils::string::trim(input);
+        double value = 0.0;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setDistanceGridSpacing(value);
+    }
+
+    if(slotXML.hasOption("DistanceGridTolerance")){
+        std::string input = slotXML.get("DistanceGridTolerance");
+        input = bitpit::utils::string::trim(input);
+        double value = 0.0;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setDistanceGridTolerance(value);
+    }
+
 };
 
 /*!
@@ -493,6 +602,10 @@ ControlDeformExtSurface::flushSectionXML(bitpit::Config::Section & slotXML, std:
     }
 
     slotXML.set("Tolerance", std::to_string(m_tolerance));
+    if(m_gridSpacing > 0.0){
+        slotXML.set("DistanceGridSpacing", std::to_string(m_gridSpacing));
+        slotXML.set("DistanceGridTolerance", std::to_string(m_gridTolerance));
+    }
 
 };
 
@@ -513,6 +626,13 @@ ControlDeformExtSurface::readFileConstraints(std::vector<MimmoSharedPointer<Mimm
 
     for(auto & geoinfo : m_geoFileList){
 
+        //reuse constraints already read, if distance grid cache is enabled
+        if(m_gridSpacing > 0.0 && m_fileGeos.count(geoinfo.first) > 0){
+            extFileGeos[counter] = m_fileGeos[geoinfo.first];
+            ++counter;
+            continue;
+        }
+
         svector1D info = extractInfo(geoinfo.first);
         geo->setDir(info[0]);
         geo->setFilename(info[1]);
@@ -527,6 +647,10 @@ ControlDeformExtSurface::readFileConstraints(std::vector<MimmoSharedPointer<Mimm
         extFileGeos[counter]->updateAdjacencies();
         extFileGeos[counter]->buildSkdTree();
 
+        if(m_gridSpacing > 0.0){
+            m_fileGeos[geoinfo.first] = locMesh;
+        }
+
         ++counter;
     }
     extFileGeos.resize(counter);
@@ -576,6 +700,7 @@ ControlDeformExtSurface::evaluateSignedDistance(const std::vector<darray3E> &poi
 {
 
     geo->buildSkdTree();
+    geo->buildVertexNormals();
 
     double rate = 0.05;
     int kmax = 1000;
@@ -602,9 +727,9 @@ ControlDeformExtSurface::evaluateSignedDistance(const std::vector<darray3E> &poi
 
 #if MIMMO_ENABLE_MPI
         std::vector<int> suppCellRanks(work.size());
-        skdTreeUtils::signedGlobalDistance(work.size(), work.data(), geo->getSkdTree(), suppCellIds.data(), suppCellRanks.data(), normals.data(), distanceWork.data(), sRadius, false);
+        skdTreeUtils::signedGlobalDistance(work.size(), work.data(), geo->getSkdTree(), suppCellIds.data(), suppCellRanks.data(), normals.data(), distanceWork.data(), sRadius, false, &(geo->getVertexNormals()));
 #else
-        skdTreeUtils::signedDistance(work.size(), work.data(), geo->getSkdTree(), suppCellIds.data(), distanceWork.data(), normals.data(), sRadius);
+        skdTreeUtils::signedDistance(work.size(), work.data(), geo->getSkdTree(), suppCellIds.data(), distanceWork.data(), normals.data(), sRadius, &(geo->getVertexNormals()));
 #endif
 
         //get all points with distances not calculated.
@@ -26,6 +26,7 @@
 
 #include "BaseManipulation.hpp"
 #include "MimmoGeometry.hpp"
+#include "DistanceGrid.hpp"
 
 namespace mimmo{
 
@@ -98,6 +99,11 @@ namespace mimmo{
                         from constraint surfaces. A violation is detected if a deformed point of the target surface exceeds
                         this threshold, no matter if the target has already collided the constraint or not. This parameter allow to control
                         when the violation occurs, since the distance calculation is sometimes prone to approximations.
+ *  - <B>DistanceGridSpacing</B>: double(>=0) spacing of the sparse distance grid used to cache the signed distance field
+                        of each constraint (see DistanceGrid). If 0 (default) distances are always evaluated exactly.
+                        Enable it when the block is executed many times on unchanged constraints, e.g. in optimization loops.
+ *  - <B>DistanceGridTolerance</B>: double(>=0) exact fallback tolerance of the distance grid: deformed points with interpolated distance
+                        lower than this value are evaluated exactly. A value of the order of the grid spacing is suggested.
  *
  * Geometry and deformation field have to be mandatorily passed through port.
  *
@@ -120,6 +126,10 @@ private:
     dmpvecarr3E                                        m_defField; /**<Deformation field*/
     std::unordered_set<int>                             m_allowed; /**< list of currently file format supported by the class*/
     double                                            m_tolerance; /**< proximity tolerance offset */
+    double                                          m_gridSpacing; /**< spacing of the distance grid cache (0 disabled) */
+    double                                        m_gridTolerance; /**< exact fallback tolerance of the distance grid cache */
+    std::unordered_map<MimmoSharedPointer<MimmoObject>, DistanceGrid> m_grids; /**< distance grid caches of current constraints */
+    std::unordered_map<std::string, MimmoSharedPointer<MimmoObject>> m_fileGeos; /**< constraints read from file, kept if distance grid is enabled */
 
 public:
     ControlDeformExtSurface();
@@ -134,11 +144,15 @@ public:
     double                        getViolation();
     dmpvector1D *                 getViolationField();
     double                        getTolerance();
+    double                        getDistanceGridSpacing();
+    double                        getDistanceGridTolerance();
     const    fileListWithType &   getConstraintFiles() const;
 
     void    setDefField(dmpvecarr3E *field);
     void    setGeometry(MimmoSharedPointer<MimmoObject> target);
     void    setTolerance(double tol);
+    void    setDistanceGridSpacing(double spacing);
+    void    setDistanceGridTolerance(double tol);
 
     void    addConstraint(MimmoSharedPointer<MimmoObject> constraint);
 
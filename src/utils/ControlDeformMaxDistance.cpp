@@ -32,6 +32,8 @@ namespace mimmo{
 ControlDeformMaxDistance::ControlDeformMaxDistance(){
     m_name = "mimmo.ControlDeformMaxDistance";
     m_maxDist= 0.0 ;
+    m_gridSpacing = 0.0;
+    m_gridTolerance = 0.0;
 
 };
 
@@ -43,6 +45,8 @@ ControlDeformMaxDistance::ControlDeformMaxDistance(const bitpit::Config::Section
 
     m_name = "mimmo.ControlDeformMaxDistance";
     m_maxDist= 0.0 ;
+    m_gridSpacing = 0.0;
+    m_gridTolerance = 0.0;
 
     std::string fallback_name = "ClassNONE";
     std::string input = rootXML.get("ClassName", fallback_name);
@@ -63,6 +67,8 @@ ControlDeformMaxDistance::~ControlDeformMaxDistance(){};
  */
 ControlDeformMaxDistance::ControlDeformMaxDistance(const ControlDeformMaxDistance & other):BaseManipulation(other){
     m_maxDist = other.m_maxDist;
+    m_gridSpacing = other.m_gridSpacing;
+    m_gridTolerance = other.m_gridTolerance;
 };
 
 /*!
@@ -81,6 +87,9 @@ ControlDeformMaxDistance & ControlDeformMaxDistance::operator=(ControlDeformMaxD
 void ControlDeformMaxDistance::swap(ControlDeformMaxDistance & x) noexcept
 {
     std::swap(m_maxDist, x.m_maxDist);
+    std::swap(m_gridSpacing, x.m_gridSpacing);
+    std::swap(m_gridTolerance, x.m_gridTolerance);
+    std::swap(m_grid, x.m_grid);
     m_violationField.swap(x.m_violationField);
     m_defField.swap(x.m_defField);
     BaseManipulation::swap(x);
@@ -93,11 +102,13 @@ ControlDeformMaxDistance::buildPorts(){
     bool built = true;
 
     built = (built && createPortIn<dmpvecarr3E*, ControlDeformMaxDistance>(this, &mimmo::ControlDeformMaxDistance::setDefField, M_GDISPLS));
+    built = (built && createPortIn<fmpvecarr3E*, ControlDeformMaxDistance>(this, &mimmo::ControlDeformMaxDistance::setDefFieldFloat32, M_GDISPLS32));
     built = (built && createPortIn<double, ControlDeformMaxDistance>(this, &mimmo::ControlDeformMaxDistance::setLimitDistance, M_VALUED));
     built = (built && createPortIn<MimmoSharedPointer<MimmoObject>, ControlDeformMaxDistance>(this, &mimmo::ControlDeformMaxDistance::setGeometry, M_GEOM, true));
 
     built = (built && createPortOut<double, ControlDeformMaxDistance>(this, &mimmo::ControlDeformMaxDistance::getViolation, M_VALUED));
     built = (built && createPortOut<dmpvector1D*, ControlDeformMaxDistance>(this, &mimmo::ControlDeformMaxDistance::getViolationField, M_SCALARFIELD));
+    built = (built && createPortOut<fmpvector1D*, ControlDeformMaxDistance>(this, &mimmo::ControlDeformMaxDistance::getViolationFieldFloat32, M_SCALARFIELD32));
     m_arePortsBuilt = built;
 };
 
@@ -134,6 +145,17 @@ ControlDeformMaxDistance::getViolationField(){
     return  &m_violationField;
 };
 
+/*!
+ * Return the violation distances of each point of deformed geometry, converted to single precision,
+ * e.g. to be written or visualized only. See getViolationField.
+ * \return violation field values in single precision
+ */
+fmpvector1D *
+ControlDeformMaxDistance::getViolationFieldFloat32(){
+    m_violationField32 = toFloat32(m_violationField);
+    return  &m_violationField32;
+};
+
 /*!
  * Set the deformative field associated to each point of the target geometry.
  * Field resize occurs in execution, if point dimension between field and geoemetry does not match.
@@ -147,6 +169,18 @@ ControlDeformMaxDistance::setDefField(dmpvecarr3E *field){
     m_defField = *field;
 };
 
+/*!
+ * Set the deformative field associated to each point of the target geometry, given in single precision.
+ * The field is converted to double precision to evaluate the distances; see setDefField.
+ * \param[in]    field of deformation
+ */
+void
+ControlDeformMaxDistance::setDefFieldFloat32(fmpvecarr3E *field){
+    if(!field) return;
+    dmpvecarr3E field64 = toFloat64(*field);
+    setDefField(&field64);
+};
+
 /*! Set limit distance d of the constraint surface. Must be a positive definite value (>= 0).
  *  Given a target geometry surface (open or closed), its constraint surface is intended
  *  as the iso-level surface where every points are at distance d from the target surface.
@@ -157,6 +191,47 @@ ControlDeformMaxDistance::setLimitDistance(double dist){
     m_maxDist = std::fmax(1.0E-12,dist);
 };
 
+/*!
+ * Set the spacing of the sparse grid caching the distance field from the undeformed
+   target geometry (see DistanceGrid). Grid values are kept between successive executions
+   as long as the target geometry is unchanged, so that the distance of the deformed points
+   is mostly evaluated by interpolation.
+ * \param[in] spacing grid spacing (>=0). If 0 the cache is disabled (default).
+ */
+void
+ControlDeformMaxDistance::setDistanceGridSpacing(double spacing){
+    m_gridSpacing = std::max(0.0, spacing);
+    if(m_gridSpacing == 0.0){
+        m_grid.clear();
+    }
+}
+
+/*!
+ * Set the exact fallback tolerance of the distance grid cache. Deformed points
+   whose interpolated distance is lower than this value are evaluated exactly.
+ * \param[in] tol fallback tolerance (>=0).
+ */
+void
+ControlDeformMaxDistance::setDistanceGridTolerance(double tol){
+    m_gridTolerance = std::max(0.0, tol);
+}
+
+/*!
+ * \return spacing of the distance grid cache. 0 if the cache is disabled.
+ */
+double
+ControlDeformMaxDistance::getDistanceGridSpacing(){
+    return m_gridSpacing;
+}
+
+/*!
+ * \return exact fallback tolerance of the distance grid cache.
+ */
+double
+ControlDeformMaxDistance::getDistanceGridTolerance(){
+    return m_gridTolerance;
+}
+
 /*!
  * Set the link to MimmoObject target geometry. Geometry must be a 3D surface
  * (MimmoObject of type 1). Reimplemented from BaseManipulation::setGeometry().
@@ -212,14 +287,40 @@ ControlDeformMaxDistance::execute(){
     }
 
     std::vector<double> distances(mapIDV.size());
-    std::vector<long> suppCellIds(mapIDV.size());
+
+    if(m_gridSpacing > 0.0){
+        //interpolate distances on the cached grid. Exact evaluations use a uniform search
+        //radius, large enough to include grid nodes surrounding the deformed points.
+        double radius = 1.0E-08;
+        for(double val : normDef){
+            radius = std::max(radius, val);
+        }
+        radius += 2.0*m_gridSpacing;
+        m_grid.setSpacing(m_gridSpacing);
+        m_grid.setFallbackTolerance(m_gridTolerance);
+        m_grid.setEvaluator([&](const std::vector<std::array<double,3>> & work, std::vector<double> & values){
+            values.resize(work.size());
+            std::vector<long> ids(work.size());
+#if MIMMO_ENABLE_MPI
+            std::vector<int> ranks(work.size());
+            skdTreeUtils::globalDistance(work.size(), work.data(), geo->getSkdTree(), ids.data(), ranks.data(), values.data(), radius, false);
+#else
+            skdTreeUtils::distance(work.size(), work.data(), geo->getSkdTree(), ids.data(), values.data(), radius);
+#endif
+        });
+        m_grid.setup(geo, m_maxDist);
+        m_grid.evaluate(points, distances);
+        m_grid.setEvaluator(nullptr);
+    }else{
+        std::vector<long> suppCellIds(mapIDV.size());
 
 #if MIMMO_ENABLE_MPI
-    std::vector<int> suppCellRanks(mapIDV.size());
-    skdTreeUtils::globalDistance(points.size(), points.data(), geo->getSkdTree(), suppCellIds.data(), suppCellRanks.data(), distances.data(), normDef.data(), false);
+        std::vector<int> suppCellRanks(mapIDV.size());
+        skdTreeUtils::globalDistance(points.size(), points.data(), geo->getSkdTree(), suppCellIds.data(), suppCellRanks.data(), distances.data(), normDef.data(), false);
 #else
-    skdTreeUtils::distance(points.size(), points.data(), geo->getSkdTree(), suppCellIds.data(), distances.data(), normDef.data());
+        skdTreeUtils::distance(points.size(), points.data(), geo->getSkdTree(), suppCellIds.data(), distances.data(), normDef.data());
 #endif
+    }
     //transfer distance value inside m_violation field.(parallel case, ghost are already in)
     //Final value of violation is local distance of deformed point minus the offset m_maxDist
     // fixed by the user
@@ -274,6 +375,28 @@ ControlDeformMaxDistance::absorbSectionXML(const bitpit::Config::Section & slotX
         }
         setLimitDistance(value);
     }
+
+    if(slotXML.hasOption("DistanceGridSpacing")){
+        std::string input = slotXML.get("DistanceGridSpacing");
+        input = bitpit::utils::string::trim(input);
+        double value = 0.0;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setDistanceGridSpacing(value);
+    }
+
+    if(slotXML.hasOption("DistanceGridTolerance")){
+        std::string input = slotXML.get("DistanceGridTolerance");
+        input = bitpit::utils::string::trim(input);
+        double value = 0.0;
+        if(!input.empty()){
+            std::stringstream ss(input);
+            ss >> value;
+        }
+        setDistanceGridTolerance(value);
+    }
 };
 
 /*!
@@ -289,6 +412,10 @@ ControlDeformMaxDistance::flushSectionXML(bitpit::Config::Section & slotXML, std
     BaseManipulation::flushSectionXML(slotXML, name);
 
     slotXML.set("LimitDistance", std::to_string(m_maxDist));
+    if(m_gridSpacing > 0.0){
+        slotXML.set("DistanceGridSpacing", std::to_string(m_gridSpacing));
+        slotXML.set("DistanceGridTolerance", std::to_string(m_gridTolerance));
+    }
 
 };
 
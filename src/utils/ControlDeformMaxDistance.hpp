@@ -25,6 +25,7 @@
 #define __CONTROLDEFORMMAXDISTANCE_HPP__
 
 #include "BaseManipulation.hpp"
+#include "DistanceGrid.hpp"
 
 namespace mimmo{
 
@@ -55,6 +56,7 @@ namespace mimmo{
      |-|-|-|
      | <B>PortType</B>   | <B>variable/function</B>  |<B>DataType</B> |
      | M_GDISPLS| setDefField       | (MC_SCALAR, MD_MPVECARR3FLOAT_)       |
+     | M_GDISPLS32| setDefFieldFloat32 | (MC_SCALAR, MD_MPVECARR3FLOAT32_)  |
      | M_VALUED | setLimitDistance  | (MC_SCALAR, MD_FLOAT)         |
      | M_GEOM   | setGeometry       | (MC_SCALAR, MD_MIMMO_)        |
 
@@ -62,6 +64,7 @@ namespace mimmo{
      |-|-|-|
      | <B>PortType</B> | <B>variable/function</B> |<B>DataType</B> |
      | M_SCALARFIELD | getViolationField | (MC_SCALAR, MD_MPVECFLOAT_)             |
+     | M_SCALARFIELD32 | getViolationFieldFloat32 | (MC_SCALAR, MD_MPVECFLOAT32_)  |
      | M_VALUED      | getViolation      | (MC_SCALAR, MD_FLOAT)             |
 
  *    =========================================================
@@ -77,6 +80,10 @@ namespace mimmo{
  *
  * Proper of the class:
  * - <B>LimitDistance</B>: constraint surface distance from target geometry;
+ * - <B>DistanceGridSpacing</B>: spacing of the sparse grid caching the distance field from the undeformed target geometry
+                                (see DistanceGrid). If 0 (default) distances are always evaluated exactly;
+ * - <B>DistanceGridTolerance</B>: exact fallback tolerance of the distance grid cache. Deformed points with interpolated
+                                distance lower than this value are evaluated exactly.
  *
  * Geometry and deformation field have to be mandatorily passed through port.
  *
@@ -85,7 +92,11 @@ class ControlDeformMaxDistance: public BaseManipulation{
 private:
     double                         m_maxDist;        /**<Limit Distance*/
     dmpvector1D                    m_violationField;    /**<Violation Distance Field */
+    fmpvector1D                    m_violationField32;  /**<Violation Distance Field in single precision, for output purposes */
     dmpvecarr3E                    m_defField;     /**<Deformation field*/
+    double                         m_gridSpacing;  /**<Spacing of the distance grid cache (0 disabled)*/
+    double                         m_gridTolerance;/**<Exact fallback tolerance of the distance grid cache*/
+    DistanceGrid                   m_grid;         /**<Distance grid cache*/
 
 public:
     ControlDeformMaxDistance();
@@ -99,10 +110,17 @@ public:
 
     double                                     getViolation();
     dmpvector1D  *                             getViolationField();
+    fmpvector1D  *                             getViolationFieldFloat32();
 
     void    setDefField(dmpvecarr3E *field);
+    void    setDefFieldFloat32(fmpvecarr3E *field);
     void    setLimitDistance(double dist);
     void    setGeometry(MimmoSharedPointer<MimmoObject> geo);
+    void    setDistanceGridSpacing(double spacing);
+    void    setDistanceGridTolerance(double tol);
+
+    double  getDistanceGridSpacing();
+    double  getDistanceGridTolerance();
 
     void     execute();
 
@@ -118,6 +136,8 @@ REGISTER_PORT(M_GDISPLS, MC_SCALAR, MD_MPVECARR3FLOAT_,__CONTROLDEFORMMAXDISTANC
 REGISTER_PORT(M_VALUED, MC_SCALAR, MD_FLOAT,__CONTROLDEFORMMAXDISTANCE_HPP__)
 REGISTER_PORT(M_GEOM, MC_SCALAR, MD_MIMMO_,__CONTROLDEFORMMAXDISTANCE_HPP__)
 REGISTER_PORT(M_SCALARFIELD, MC_SCALAR, MD_MPVECFLOAT_,__CONTROLDEFORMMAXDISTANCE_HPP__)
+REGISTER_PORT(M_GDISPLS32, MC_SCALAR, MD_MPVECARR3FLOAT32_,__CONTROLDEFORMMAXDISTANCE_HPP__)
+REGISTER_PORT(M_SCALARFIELD32, MC_SCALAR, MD_MPVECFLOAT32_,__CONTROLDEFORMMAXDISTANCE_HPP__)
 
 
 REGISTER(BaseManipulation, ControlDeformMaxDistance, "mimmo.ControlDeformMaxDistance")
@@ -321,6 +321,16 @@ OBBox::plot(std::string directory, std::string filename,int counter, bool binary
 }
 
 
+/*!
+ * The execution only reads the vertices and cells of the target geometries, computing the
+ * box in the members of the object.
+ * \return true, the object can be executed concurrently in a parallel chain.
+ */
+bool
+OBBox::isThreadSafe(){
+    return true;
+}
+
 /*!Execute your object, calculate the OBBox of your geometry.
  * If forced externally, evaluate the AABB, no matter what.
  * Implementation of pure virtual BaseManipulation::execute
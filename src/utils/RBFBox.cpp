@@ -201,6 +201,16 @@ RBFBox::plot(std::string directory, std::string filename,int counter, bool binar
 };
 
 
+/*!
+ * The execution only reads the RBF nodes of the linked point cloud, computing the box in
+ * the members of the object.
+ * \return true, the object can be executed concurrently in a parallel chain.
+ */
+bool
+RBFBox::isThreadSafe(){
+    return true;
+}
+
 /*!Execute your object.
  * It calculates the RBFBox of the input set of RBFs (+1% of support radius).
  *
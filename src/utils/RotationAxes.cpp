@@ -215,6 +215,15 @@ RotationAxes::getRotatedOrigin(){
     return(m_rotax_origin);
 }
 
+/*!
+ * The execution works only on the point/axes members of the object.
+ * \return true, the object can be executed concurrently in a parallel chain.
+ */
+bool
+RotationAxes::isThreadSafe(){
+    return true;
+}
+
 /*!Execution command. It saves in "rot"-terms the modified axes and origin, by the
  * rotation conditions. This terms can be recovered and passed by a pin to a child object
  * by the related get-methods.
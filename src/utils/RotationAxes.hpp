@@ -116,6 +116,8 @@ public:
 	virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name = "");
 	virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name= "");
 
+	bool isThreadSafe();
+
 protected:
     void swap(RotationAxes & x) noexcept;
 
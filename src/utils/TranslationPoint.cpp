@@ -154,6 +154,15 @@ TranslationPoint::setOrigin(darray3E origin){
     m_origin = origin;
 }
 
+/*!
+ * The execution works only on the point/axes members of the object.
+ * \return true, the object can be executed concurrently in a parallel chain.
+ */
+bool
+TranslationPoint::isThreadSafe(){
+    return true;
+}
+
 /*!Execution command. It modifies the coordinates of the origin
  * with the translation conditions.
  * The result of the translation is stored in member result of base class
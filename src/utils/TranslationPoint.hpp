@@ -102,6 +102,8 @@ public:
     virtual void absorbSectionXML(const bitpit::Config::Section & slotXML, std::string name="");
     virtual void flushSectionXML(bitpit::Config::Section & slotXML, std::string name="");
 
+    bool isThreadSafe();
+
 protected:
     void swap(TranslationPoint & x) noexcept;
 };
@@ -0,0 +1,130 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_common.hpp"
+#include <sstream>
+#if MIMMO_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+/*
+ * Test 00002
+ * Testing Profiler: nested scopes, counters, multithreaded recording and report output.
+ */
+
+// =================================================================================== //
+
+int test2() {
+
+    mimmo::Profiler & profiler = mimmo::Profiler::instance();
+    bool check = true;
+
+    // disabled profiler does not record anything
+    {
+        mimmo::ProfileScope scope("disabled");
+        check = check && !scope.isActive();
+    }
+    check = check && profiler.getEvents().empty();
+
+    profiler.setEnabled(true);
+    {
+        mimmo::ProfileScope outer("outer", "block");
+        {
+            mimmo::ProfileScope inner("inner");
+            std::vector<double> work(100000, 1.0);
+            double sum = 0.0;
+            for(double val : work) sum += val;
+            inner.addCounter("elements", long(sum));
+        }
+        mimmo::threads::parallelFor(0, 4, [](std::size_t begin, std::size_t end){
+            for(std::size_t i = begin; i < end; ++i){
+                mimmo::ProfileScope scope("task");
+            }
+        }, 1);
+    }
+    profiler.setEnabled(false);
+
+    std::vector<mimmo::Profiler::Event> events = profiler.getEvents();
+    check = check && (events.size() == 6);
+
+    int nTasks = 0;
+    const mimmo::Profiler::Event * outer = nullptr;
+    const mimmo::Profiler::Event * inner = nullptr;
+    for(const mimmo::Profiler::Event & event : events){
+        if(event.name == "task") ++nTasks;
+        if(event.name == "outer") outer = &event;
+        if(event.name == "inner") inner = &event;
+    }
+    check = check && (nTasks == 4) && outer && inner;
+    if(outer && inner){
+        check = check && (outer->category == "block") && (inner->category == "scope");
+        check = check && (inner->start >= outer->start);
+        check = check && (inner->start + inner->duration <= outer->start + outer->duration);
+        check = check && (inner->counters.size() == 1) && (inner->counters[0].second == 100000);
+    }
+
+    std::stringstream report, trace;
+    profiler.writeReport(report);
+    profiler.writeChromeTrace(trace);
+    check = check && (report.str().find("\"summary\"") != std::string::npos);
+    check = check && (report.str().find("\"outer\"") != std::string::npos);
+    check = check && (trace.str().find("\"traceEvents\"") != std::string::npos);
+    check = check && (trace.str().find("\"ph\": \"X\"") != std::string::npos);
+
+    profiler.clear();
+    check = check && profiler.getEvents().empty();
+
+    if(check){
+        std::cout<<"test_common_00002 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_common_00002 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    /**<Calling mimmo Test routines*/
+    int val = 1;
+    try{
+        val = test2() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_common_00002 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_common.hpp"
+#include <atomic>
+#include <chrono>
+#if MIMMO_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+/*
+ * Test 00003
+ * Testing AsyncWriter: tasks executed in background in order of submission, bounded
+ * number of pending tasks, barrier and rethrow of task errors.
+ */
+
+// =================================================================================== //
+
+int test3() {
+
+    mimmo::threads::AsyncWriter & writer = mimmo::threads::AsyncWriter::instance();
+    writer.setMaxPending(3);
+    bool check = (writer.getMaxPending() == 3);
+
+    std::vector<int> order;
+    std::atomic<std::size_t> maxPending(0);
+    for(int i = 0; i < 20; ++i){
+        std::shared_ptr<std::vector<double>> snapshot = std::make_shared<std::vector<double>>(1000, double(i));
+        writer.submit([&writer, &order, &maxPending, snapshot, i](){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::size_t pending = writer.getNumberOfPending();
+            if(pending > maxPending) maxPending = pending;
+            if((*snapshot)[999] == double(i)) order.push_back(i);
+        });
+    }
+    writer.wait();
+    check = check && (writer.getNumberOfPending() == 0);
+    check = check && (maxPending <= 3);
+    check = check && (order.size() == 20);
+    for(std::size_t i = 0; i < order.size(); ++i){
+        check = check && (order[i] == int(i));
+    }
+
+    // the first error is rethrown by the barrier, the following tasks are executed
+    bool executed = false;
+    writer.submit([](){ throw std::runtime_error("write failed"); });
+    writer.submit([&executed](){ executed = true; });
+    bool thrown = false;
+    try{
+        writer.wait();
+    }catch(std::exception & e){
+        thrown = (std::string(e.what()) == "write failed");
+    }
+    check = check && thrown && executed;
+
+    // errors are reported once
+    writer.wait();
+    writer.setMaxPending(2);
+
+    if(check){
+        std::cout<<"test_common_00003 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_common_00003 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    /**<Calling mimmo Test routines*/
+    int val = 1;
+    try{
+        val = test3() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_common_00003 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
@@ -0,0 +1,154 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_common.hpp"
+#include <fstream>
+#include <sstream>
+#if MIMMO_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+/*
+ * Test 00004
+ * Testing text parsing utilities: file buffer, line-aligned chunks, concurrent parsing
+ * of records and in-place number parsing.
+ */
+
+// =================================================================================== //
+
+/*
+ * Partial result of a parsed chunk.
+ */
+struct Records{
+    std::vector<long>   labels;
+    std::vector<double> values;
+};
+
+int test4() {
+
+    // number parsing
+    std::string numbers = "  -12 3.5e+2, 7 abc";
+    const char * cursor = numbers.data();
+    const char * end = numbers.data() + numbers.size();
+    long label = 0;
+    double value = 0.;
+    int count = 0;
+    bool check = mimmo::text::parse(cursor, end, label) && (label == -12);
+    check = check && mimmo::text::parse(cursor, end, value) && (value == 350.);
+    check = check && mimmo::text::skipDelimiter(cursor, end, ',');
+    check = check && mimmo::text::parse(cursor, end, count) && (count == 7);
+    check = check && !mimmo::text::parse(cursor, end, value) && (value == 350.);
+
+    // write a file of records
+    mimmo::threads::setNumberOfThreads(4);
+    long nRecords = 200000;
+    {
+        std::ofstream out("textparser.dat");
+        out << "# comment line\n";
+        for(long i = 0; i < nRecords; ++i){
+            out << "$REC " << i << " " << 0.5 * double(i) << "\n";
+        }
+    }
+
+    mimmo::text::FileBuffer file("textparser.dat");
+    check = check && file.isOpen();
+
+    std::vector<const char *> bounds = mimmo::text::splitLines(file.begin(), file.end(), 4);
+    check = check && (bounds.size() == 5);
+    for(std::size_t i = 1; i + 1 < bounds.size(); ++i){
+        check = check && (*(bounds[i] - 1) == '\n');
+    }
+
+    auto parseRecords = [](const char * begin, const char * end, Records & records){
+        for(const char * line = begin; line < end; line = mimmo::text::nextLine(line, end)){
+            const char * cursor = line;
+            const char * stop = mimmo::text::lineEnd(line, end);
+            const char * keyBegin;
+            const char * keyEnd;
+            if(!mimmo::text::nextToken(cursor, stop, keyBegin, keyEnd)) continue;
+            if(!mimmo::text::equals(keyBegin, keyEnd, "$REC")) continue;
+            long label;
+            double value;
+            if(mimmo::text::parse(cursor, stop, label) && mimmo::text::parse(cursor, stop, value)){
+                records.labels.push_back(label);
+                records.values.push_back(value);
+            }
+        }
+    };
+    std::vector<Records> chunks = mimmo::text::parseChunks<Records>(file.begin(), file.end(), parseRecords, 4096);
+    check = check && (chunks.size() > 1);
+
+    long expected = 0;
+    for(const Records & records : chunks){
+        for(std::size_t i = 0; i < records.labels.size(); ++i){
+            check = check && (records.labels[i] == expected) && (records.values[i] == 0.5 * double(expected));
+            ++expected;
+        }
+    }
+    check = check && (expected == nRecords);
+
+    // stream over a memory chunk
+    mimmo::text::MemoryStreamBuffer buffer(bounds[1], file.end());
+    std::istream in(&buffer);
+    std::string line;
+    std::getline(in, line);
+    check = check && (line.compare(0, 4, "$REC") == 0) && (in.tellg() == std::streamoff(line.size() + 1));
+
+    file.close();
+    std::remove("textparser.dat");
+    mimmo::threads::setNumberOfThreads(0);
+
+    if(check){
+        std::cout<<"test_common_00004 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_common_00004 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    /**<Calling mimmo Test routines*/
+    int val = 1;
+    try{
+        val = test4() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_common_00004 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
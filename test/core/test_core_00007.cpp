@@ -0,0 +1,148 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00007
+ * Testing cached vertex pseudo-normals in skdTree signed distance evaluation.
+ */
+
+/*!
+ * Creating a closed tetrahedral surface mesh with outward normals.
+ *
+ * \param[in,out] mesh pointer to a MimmoObject mesh to fill.
+ * \return true if successfully created mesh
+ */
+bool createTetraSurface(mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh){
+
+	mesh->addVertex({{0.0,0.0,0.0}}, 0);
+	mesh->addVertex({{1.0,0.0,0.0}}, 1);
+	mesh->addVertex({{0.0,1.0,0.0}}, 2);
+	mesh->addVertex({{0.0,0.0,1.0}}, 3);
+
+	bitpit::ElementType eltype = bitpit::ElementType::TRIANGLE;
+	mesh->addConnectedCell(livector1D({0,2,1}), eltype, long(0));
+	mesh->addConnectedCell(livector1D({0,1,3}), eltype, long(1));
+	mesh->addConnectedCell(livector1D({0,3,2}), eltype, long(2));
+	mesh->addConnectedCell(livector1D({1,2,3}), eltype, long(3));
+
+	mesh->updateAdjacencies();
+	return (mesh->getNCells() == 4) && (mesh->getNVertices() == 4);
+}
+
+// =================================================================================== //
+
+int test7() {
+
+	mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject());
+	if(!createTetraSurface(mesh)){
+		std::cout<<"ERROR.Not able to create MimmoObject mesh"<<std::endl;
+		return 1;
+	}
+
+	mesh->buildSkdTree();
+	mesh->buildVertexNormals();
+	bool check = (mesh->getVertexNormalsSyncStatus() == mimmo::SyncStatus::SYNC);
+	check = check && (mesh->getVertexNormals().size() == 4);
+
+	// points inside, close to faces, edges and vertices of the tetrahedron
+	std::vector<darray3E> points;
+	points.push_back({{0.1,0.1,0.1}});
+	points.push_back({{1.0,1.0,1.0}});
+	points.push_back({{-0.5,-0.5,-0.5}});
+	points.push_back({{0.5,-0.5,-0.5}});
+	points.push_back({{1.5,-0.2,0.1}});
+	points.push_back({{0.2,0.2,-0.3}});
+
+	int nP = points.size();
+	std::vector<long> ids(nP), idsCached(nP);
+	std::vector<double> dist(nP), distCached(nP);
+	std::vector<darray3E> normals(nP), normalsCached(nP);
+
+	mimmo::skdTreeUtils::signedDistance(nP, points.data(), mesh->getSkdTree(), ids.data(), dist.data(), normals.data(), 10.0);
+	mimmo::skdTreeUtils::signedDistance(nP, points.data(), mesh->getSkdTree(), idsCached.data(), distCached.data(), normalsCached.data(), 10.0,
+	                                    &(mesh->getVertexNormals()));
+
+	for(int i=0; i<nP; ++i){
+		check = check && (ids[i] == idsCached[i]);
+		check = check && (std::abs(dist[i] - distCached[i]) < 1.0e-12);
+		check = check && (norm2(normals[i] - normalsCached[i]) < 1.0e-12);
+	}
+	check = check && (distCached[0] < 0.0);
+	for(int i=1; i<nP; ++i){
+		check = check && (distCached[i] > 0.0);
+	}
+
+	// moving a vertex must unsync the cached normals
+	mesh->modifyVertex({{0.0,0.0,2.0}}, 3);
+	check = check && (mesh->getVertexNormalsSyncStatus() == mimmo::SyncStatus::UNSYNC);
+	mesh->update();
+	check = check && (mesh->getVertexNormalsSyncStatus() == mimmo::SyncStatus::SYNC);
+
+	// moving a vertex directly in the patch is tracked by the coordinates revision
+	mesh->getPatch()->getVertex(3).setCoords({{0.0,0.0,1.5}});
+	mesh->markCoordinatesChanged();
+	check = check && (mesh->getVertexNormalsSyncStatus() == mimmo::SyncStatus::UNSYNC);
+	mesh->buildVertexNormals();
+	check = check && (mesh->getVertexNormalsSyncStatus() == mimmo::SyncStatus::SYNC);
+
+	std::cout<<"cached pseudo-normals signed distance test ";
+	if(check)
+		std::cout<<"...PASSED"<<std::endl;
+	else
+		std::cout<<"...FAILED"<<std::endl;
+
+	return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+
+	int val = 1;
+
+	/**<Calling mimmo Test routines*/
+	try{
+		val = test7() ;
+	}
+	catch(std::exception & e){
+		std::cout<<"test_core_00007 exited with an error of type : "<<e.what()<<std::endl;
+		return 1;
+	}
+
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,161 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00008
+ * Testing DistanceGrid sparse cache of a distance field.
+ */
+
+// =================================================================================== //
+
+int test8() {
+
+	//unit square surface used as target of the grid.
+	mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject());
+	mesh->addVertex({{0.0,0.0,0.0}}, 0);
+	mesh->addVertex({{1.0,0.0,0.0}}, 1);
+	mesh->addVertex({{1.0,1.0,0.0}}, 2);
+	mesh->addVertex({{0.0,1.0,0.0}}, 3);
+	mesh->addConnectedCell(livector1D({0,1,2}), bitpit::ElementType::TRIANGLE, long(0));
+	mesh->addConnectedCell(livector1D({0,2,3}), bitpit::ElementType::TRIANGLE, long(1));
+	mesh->update();
+
+	//linear analytic field, exactly reproduced by trilinear interpolation.
+	std::size_t nEvaluated = 0;
+	mimmo::DistanceGrid grid;
+	grid.setSpacing(0.1);
+	grid.setFallbackTolerance(0.05);
+	grid.setEvaluator([&](const std::vector<std::array<double,3>> & points, std::vector<double> & values){
+		values.resize(points.size());
+		for(std::size_t i=0; i<points.size(); ++i){
+			values[i] = points[i][0] + 2.0*points[i][1] - points[i][2];
+		}
+		nEvaluated += points.size();
+	});
+
+	bool check = !grid.setup(mesh, 0.5);
+
+	std::vector<std::array<double,3>> points;
+	points.push_back({{0.33,0.21,0.17}});
+	points.push_back({{0.72,0.55,-0.31}});
+	points.push_back({{0.01,0.98,0.44}});
+	points.push_back({{5.0,5.0,5.0}});   //outside the grid, evaluated exactly
+	points.push_back({{0.01,0.0,0.0}});  //under fallback tolerance, evaluated exactly
+
+	std::vector<double> distances;
+	grid.evaluate(points, distances);
+	for(std::size_t i=0; i<points.size(); ++i){
+		check = check && (std::abs(distances[i] - (points[i][0] + 2.0*points[i][1] - points[i][2])) < 1.0e-12);
+	}
+	std::size_t nodes = grid.getCachedNodeCount();
+	check = check && (nodes > 0);
+
+	//second evaluation on the same points must reuse cached nodes.
+	check = check && grid.setup(mesh, 0.5);
+	std::size_t before = nEvaluated;
+	grid.evaluate(points, distances);
+	check = check && (grid.getCachedNodeCount() == nodes);
+	check = check && ((nEvaluated - before) == 2);
+
+	//a modification of the target resets the cache.
+	mesh->modifyVertex({{2.0,1.0,0.0}}, 2);
+	mesh->update();
+	check = check && !grid.setup(mesh, 0.5);
+	check = check && (grid.getCachedNodeCount() == 0);
+
+	//an in place modification keeping the bounding box resets the cache too.
+	grid.evaluate(points, distances);
+	check = check && grid.setup(mesh, 0.5);
+	mesh->modifyVertex({{0.5,0.5,0.0}}, 3);
+	check = check && !grid.setup(mesh, 0.5);
+	check = check && (grid.getCachedNodeCount() == 0);
+
+	//an identical copy of the target is a different target.
+	grid.evaluate(points, distances);
+	check = check && grid.setup(mesh, 0.5);
+	mimmo::MimmoSharedPointer<mimmo::MimmoObject> copy = mesh->clone();
+	check = check && !grid.setup(copy, 0.5);
+
+	//failed node evaluations, beyond the search radius of the evaluator, are not cached.
+	double radius = 0.5;
+	mimmo::DistanceGrid radiusGrid;
+	radiusGrid.setSpacing(0.1);
+	radiusGrid.setFallbackTolerance(0.05);
+	radiusGrid.setEvaluator([&](const std::vector<std::array<double,3>> & work, std::vector<double> & values){
+		values.resize(work.size());
+		for(std::size_t i=0; i<work.size(); ++i){
+			values[i] = work[i][0] + 2.0*work[i][1] - work[i][2];
+			if(std::abs(values[i]) > radius)	values[i] = std::numeric_limits<double>::max();
+		}
+	});
+	radiusGrid.setup(mesh, 0.5);
+	radiusGrid.evaluate(points, distances);
+	std::size_t partial = radiusGrid.getCachedNodeCount();
+	radius = 100.0;
+	radiusGrid.evaluate(points, distances);
+	check = check && (radiusGrid.getCachedNodeCount() > partial);
+	for(std::size_t i=0; i<points.size(); ++i){
+		check = check && (std::abs(distances[i] - (points[i][0] + 2.0*points[i][1] - points[i][2])) < 1.0e-12);
+	}
+
+	std::cout<<"distance grid cache test ";
+	if(check)
+		std::cout<<"...PASSED"<<std::endl;
+	else
+		std::cout<<"...FAILED"<<std::endl;
+
+	return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+
+	int val = 1;
+
+	/**<Calling mimmo Test routines*/
+	try{
+		val = test8() ;
+	}
+	catch(std::exception & e){
+		std::cout<<"test_core_00008 exited with an error of type : "<<e.what()<<std::endl;
+		return 1;
+	}
+
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,168 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+
+#include "mimmo_core.hpp"
+#include <random>
+
+/*
+ * Test 00009
+ * Testing bulk median-ordered kdTree construction of MimmoObject, filling the node
+ * array directly: retrieval of all the vertices and depth of the tree.
+ */
+
+/*!
+ * Check that every vertex of the mesh is found in its kdTree with the right id.
+ *
+ * \param[in] mesh pointer to a MimmoObject mesh with kdTree built.
+ * \return true if all vertices are retrieved.
+ */
+bool checkKdTree(mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh){
+
+	bool check = (mesh->getKdTreeSyncStatus() == mimmo::SyncStatus::SYNC);
+	check = check && (mesh->getKdTree()->n_nodes == long(mesh->getNVertices()));
+	for(bitpit::Vertex & vertex : mesh->getVertices()){
+		long label = bitpit::Vertex::NULL_ID;
+		mesh->getKdTree()->exist(&vertex, label);
+		check = check && (label == vertex.getId());
+	}
+	return check;
+}
+
+/*!
+ * Evaluate the depth of the kdTree of a mesh, i.e. the number of nodes of its longest branch.
+ *
+ * \param[in] mesh pointer to a MimmoObject mesh with kdTree built.
+ * \return depth of the tree.
+ */
+int kdTreeDepth(mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh){
+
+	bitpit::KdTree<3,bitpit::Vertex,long> * tree = mesh->getKdTree();
+	if(tree->n_nodes == 0) return 0;
+	int depth = 0;
+	std::vector<std::pair<int,int>> stack(1, std::make_pair(0, 1));
+	while(!stack.empty()){
+		std::pair<int,int> entry = stack.back();
+		stack.pop_back();
+		depth = std::max(depth, entry.second);
+		if(tree->nodes[entry.first].lchild_ >= 0) stack.push_back(std::make_pair(tree->nodes[entry.first].lchild_, entry.second + 1));
+		if(tree->nodes[entry.first].rchild_ >= 0) stack.push_back(std::make_pair(tree->nodes[entry.first].rchild_, entry.second + 1));
+	}
+	return depth;
+}
+
+/*!
+ * \return depth of a perfectly balanced binary tree with n nodes.
+ * \param[in] n number of nodes
+ */
+int balancedDepth(long n){
+	return int(std::ceil(std::log2(double(n) + 1.0)));
+}
+
+// =================================================================================== //
+
+int test9() {
+
+	mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(3));
+
+	// cloud of points with repeated coordinates along each direction
+	int n = 24;
+	long id = 0;
+	for(int k=0; k<n; ++k){
+		for(int j=0; j<n; ++j){
+			for(int i=0; i<n; ++i){
+				darray3E point = {{double(i)/n, double(j)/n, double(k)/n}};
+				mesh->addVertex(point, id);
+				++id;
+			}
+		}
+	}
+
+	mimmo::threads::setNumberOfThreads(4);
+
+	long nVertices = mesh->getNVertices();
+
+	// points tied on the splitting planes cost at most a couple of levels
+	mesh->buildKdTree();
+	bool check = checkKdTree(mesh);
+	check = check && (kdTreeDepth(mesh) <= balancedDepth(nVertices) + 2);
+
+	mimmo::threads::setNumberOfThreads(1);
+	mesh->cleanKdTree();
+	mesh->buildKdTree();
+	check = check && checkKdTree(mesh);
+	check = check && (kdTreeDepth(mesh) <= balancedDepth(nVertices) + 2);
+
+	// cloud of random points, without ties
+	mimmo::MimmoSharedPointer<mimmo::MimmoObject> cloud(new mimmo::MimmoObject(3));
+	std::mt19937 generator(9);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	for(long i=0; i<nVertices; ++i){
+		darray3E point = {{distribution(generator), distribution(generator), distribution(generator)}};
+		cloud->addVertex(point, i);
+	}
+	mimmo::threads::setNumberOfThreads(4);
+	cloud->buildKdTree();
+	check = check && checkKdTree(cloud);
+	check = check && (kdTreeDepth(cloud) <= balancedDepth(nVertices));
+
+	mimmo::threads::setNumberOfThreads(0);
+
+	std::cout<<"bulk kdTree construction test ";
+	if(check)
+		std::cout<<"...PASSED"<<std::endl;
+	else
+		std::cout<<"...FAILED"<<std::endl;
+
+	return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+
+	int val = 1;
+
+	/**<Calling mimmo Test routines*/
+	try{
+		val = test9() ;
+	}
+	catch(std::exception & e){
+		std::cout<<"test_core_00009 exited with an error of type : "<<e.what()<<std::endl;
+		return 1;
+	}
+
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,121 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00010
+ * Testing aligned (dense) mode of MimmoPiercedVector.
+ */
+
+// =================================================================================== //
+
+int test10() {
+
+	mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(3));
+	for(long id=0; id<10; ++id){
+		darray3E point = {{double(id), 0.0, 0.0}};
+		mesh->addVertex(point, id);
+	}
+	// pierce the vertex container
+	mesh->getPatch()->deleteVertex(4);
+
+	// sparse field, with ids inserted in reverse order and an id not in geometry
+	dmpvector1D field(mesh, mimmo::MPVLocation::POINT);
+	for(long id=9; id>=0; id-=2){
+		field.insert(id, double(id));
+	}
+	field.insert(100, -1.0);
+
+	bool check = !field.isAligned();
+	check = check && field.alignToGeometry(0.5);
+	check = check && field.isAligned();
+	check = check && (field.size() == mesh->getNVertices());
+	check = check && !field.exists(100);
+
+	// values follow geometry order, missing ones get the default value
+	auto itV = mesh->getVertices().cbegin();
+	for(auto it = field.cbegin(); it != field.cend(); ++it){
+		long id = itV.getId();
+		check = check && (it.getId() == id);
+		check = check && ((*it) == ((id % 2) ? double(id) : 0.5));
+		++itV;
+	}
+
+	// plain contiguous arrays
+	std::vector<double> values = field.getAlignedData();
+	check = check && (values.size() == field.size());
+	for(double & val : values){
+		val *= 2.0;
+	}
+	check = check && field.setAlignedData(values);
+	check = check && (field.at(9) == 18.0) && (field.at(2) == 1.0);
+	check = check && field.completeMissingData(0.0);
+
+	values.pop_back();
+	check = check && !field.setAlignedData(values);
+
+	// fields without geometry cannot be aligned
+	dmpvector1D orphan;
+	orphan.insert(0, 1.0);
+	check = check && !orphan.isAligned() && !orphan.alignToGeometry(0.0);
+
+	std::cout<<"aligned MimmoPiercedVector test ";
+	if(check)
+		std::cout<<"...PASSED"<<std::endl;
+	else
+		std::cout<<"...FAILED"<<std::endl;
+
+	return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+
+	int val = 1;
+
+	/**<Calling mimmo Test routines*/
+	try{
+		val = test10() ;
+	}
+	catch(std::exception & e){
+		std::cout<<"test_core_00010 exited with an error of type : "<<e.what()<<std::endl;
+		return 1;
+	}
+
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
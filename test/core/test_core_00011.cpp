@@ -0,0 +1,135 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00011
+ * Testing algebraic expressions and reductions on MimmoPiercedVector fields.
+ */
+
+// =================================================================================== //
+
+int test11() {
+
+	mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(3));
+	for(long id=0; id<8; ++id){
+		darray3E point = {{double(id), 0.0, 0.0}};
+		mesh->addVertex(point, id);
+	}
+
+	dmpvecarr3E x(mesh, mimmo::MPVLocation::POINT), y(mesh, mimmo::MPVLocation::POINT);
+	dmpvector1D filter(mesh, mimmo::MPVLocation::POINT);
+	for(long id=0; id<8; ++id){
+		x.insert(id, {{double(id), 1.0, 0.0}});
+		y.insert(id, {{1.0, double(id), 2.0}});
+		filter.insert(id, (id < 4) ? 1.0 : 0.5);
+	}
+
+	bool check = x.isAligned() && y.isAligned() && filter.isAligned();
+
+	// a*x + b*y, aligned path
+	dmpvecarr3E z;
+	z = 2.0*x + y*3.0 - x;
+	check = check && z.isAligned() && (z.getGeometry() == mesh);
+	for(long id=0; id<8; ++id){
+		darray3E expected = {{double(id) + 3.0, 1.0 + 3.0*id, 6.0}};
+		check = check && (norm2(z.at(id) - expected) < 1.0e-12);
+	}
+
+	// in-place product by a filter
+	x = x * filter;
+	check = check && (norm2(x.at(6) - darray3E({{3.0, 0.5, 0.0}})) < 1.0e-12);
+	check = check && (norm2(x.at(2) - darray3E({{2.0, 1.0, 0.0}})) < 1.0e-12);
+
+	// pointwise norm and threshold mask
+	dmpvector1D norms, mask;
+	norms = mimmo::pointwiseNorm(y);
+	mask = mimmo::thresholdMask(y, 5.0);
+	for(long id=0; id<8; ++id){
+		check = check && (std::abs(norms.at(id) - norm2(y.at(id))) < 1.0e-12);
+		check = check && (mask.at(id) == ((norm2(y.at(id)) >= 5.0) ? 1.0 : 0.0));
+	}
+
+	// reductions
+	double sum = mimmo::fieldSum(filter);
+	check = check && (std::abs(sum - 6.0) < 1.0e-12);
+	darray3E sumy = mimmo::fieldSum(y);
+	check = check && (norm2(sumy - darray3E({{8.0, 28.0, 16.0}})) < 1.0e-12);
+	double dot = mimmo::fieldDot(filter, filter);
+	check = check && (std::abs(dot - 5.0) < 1.0e-12);
+	double norm = mimmo::fieldNorm2(filter - filter);
+	check = check && (norm < 1.0e-12);
+	check = check && (std::abs(mimmo::fieldNormInf(y) - norm2(y.at(7))) < 1.0e-12);
+
+	// sparse operands: ids of the first field, missing values are zero
+	dmpvector1D sparse(mesh, mimmo::MPVLocation::POINT);
+	sparse.insert(5, 2.0);
+	sparse.insert(1, 3.0);
+	dmpvector1D result;
+	result = sparse + filter;
+	check = check && (result.size() == 2) && !result.isAligned();
+	check = check && (result.at(5) == 2.5) && (result.at(1) == 4.0);
+	result = filter * sparse;
+	check = check && (result.size() == 8) && result.isAligned();
+	check = check && (result.at(5) == 1.0) && (result.at(0) == 0.0);
+
+	std::cout<<"MimmoPiercedVector algebra test ";
+	if(check)
+		std::cout<<"...PASSED"<<std::endl;
+	else
+		std::cout<<"...FAILED"<<std::endl;
+
+	return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+
+	int val = 1;
+
+	/**<Calling mimmo Test routines*/
+	try{
+		val = test11() ;
+	}
+	catch(std::exception & e){
+		std::cout<<"test_core_00011 exited with an error of type : "<<e.what()<<std::endl;
+		return 1;
+	}
+
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
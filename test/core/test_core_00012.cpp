@@ -0,0 +1,202 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+#include "mimmo_core.hpp"
+#include <atomic>
+
+/*
+ * Test 00012
+ * Testing parallel execution of a Chain: diamond dependency graph
+ * source -> (branch1, branch2) -> sink, compared with serial execution.
+ */
+
+static std::atomic<int> execCounter(0);
+
+class Source: public mimmo::BaseManipulation{
+public:
+    double m_value;
+    int m_stamp;
+
+    Source(){m_value = 0.0; m_stamp = -1;};
+    virtual ~Source(){};
+    double getValue(){ return m_value;};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort("M_TESTVALUE", MC_SCALAR, MD_FLOAT,"test_core_00012.cpp");
+        bool built = true;
+        built = built && createPortOut<double, Source>(this, &Source::getValue, "M_TESTVALUE");
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_value = 2.0;
+        m_stamp = execCounter++;
+    };
+};
+
+class Branch: public mimmo::BaseManipulation{
+public:
+    double m_factor;
+    double m_value;
+    double m_result;
+    int m_stamp;
+
+    Branch(double factor){m_factor = factor; m_value = 0.0; m_result = 0.0; m_stamp = -1;};
+    virtual ~Branch(){};
+    void setValue(double value){ m_value = value;};
+    double getResult(){ return m_result;};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort("M_TESTVALUE", MC_SCALAR, MD_FLOAT,"test_core_00012.cpp");
+        mimmo::PortManager::instance().addPort("M_TESTRESULT", MC_SCALAR, MD_FLOAT,"test_core_00012.cpp");
+        bool built = true;
+        built = built && createPortIn<double, Branch>(this, &Branch::setValue, "M_TESTVALUE", true);
+        built = built && createPortOut<double, Branch>(this, &Branch::getResult, "M_TESTRESULT");
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        // some work to let the branches overlap
+        double sum = 0.0;
+        for(int i = 0; i < 1000000; ++i){
+            sum += 1.0e-6;
+        }
+        m_result = m_factor * m_value * std::round(sum);
+        m_stamp = execCounter++;
+    };
+};
+
+class Sink: public mimmo::BaseManipulation{
+public:
+    double m_value1;
+    double m_value2;
+    double m_result;
+    int m_stamp;
+
+    Sink(){m_value1 = 0.0; m_value2 = 0.0; m_result = 0.0; m_stamp = -1;};
+    virtual ~Sink(){};
+    void setValue1(double value){ m_value1 = value;};
+    void setValue2(double value){ m_value2 = value;};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort("M_TESTRESULT", MC_SCALAR, MD_FLOAT,"test_core_00012.cpp");
+        mimmo::PortManager::instance().addPort("M_TESTRESULT2", MC_SCALAR, MD_FLOAT,"test_core_00012.cpp");
+        bool built = true;
+        built = built && createPortIn<double, Sink>(this, &Sink::setValue1, "M_TESTRESULT", true);
+        built = built && createPortIn<double, Sink>(this, &Sink::setValue2, "M_TESTRESULT2", true);
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_result = m_value1 + m_value2;
+        m_stamp = execCounter++;
+    };
+};
+
+// =================================================================================== //
+
+int runChain(bool parallel, double & result) {
+
+    execCounter = 0;
+
+    Source * source = new Source();
+    Branch * branch1 = new Branch(3.0);
+    Branch * branch2 = new Branch(5.0);
+    Sink * sink = new Sink();
+
+    bool checkPin = true;
+    checkPin = checkPin && mimmo::pin::addPin(source, branch1, "M_TESTVALUE", "M_TESTVALUE");
+    checkPin = checkPin && mimmo::pin::addPin(source, branch2, "M_TESTVALUE", "M_TESTVALUE");
+    checkPin = checkPin && mimmo::pin::addPin(branch1, sink, "M_TESTRESULT", "M_TESTRESULT");
+    checkPin = checkPin && mimmo::pin::addPin(branch2, sink, "M_TESTRESULT", "M_TESTRESULT2");
+
+    mimmo::Chain chain;
+    chain.addObject(sink);
+    chain.addObject(branch2);
+    chain.addObject(source);
+    chain.addObject(branch1);
+    chain.setParallelExecution(parallel);
+
+    chain.exec(true);
+
+    bool check = checkPin;
+    check = check && (chain.isParallelExecution() == parallel);
+    check = check && (source->m_stamp == 0);
+    check = check && (branch1->m_stamp > source->m_stamp) && (branch2->m_stamp > source->m_stamp);
+    check = check && (sink->m_stamp > branch1->m_stamp) && (sink->m_stamp > branch2->m_stamp);
+    result = sink->m_result;
+
+    delete source;
+    delete branch1;
+    delete branch2;
+    delete sink;
+
+    return !check;
+}
+
+int test12() {
+
+    mimmo::threads::setNumberOfThreads(4);
+
+    double serialResult = 0.0;
+    double parallelResult = 0.0;
+    bool check = true;
+    check = check && (runChain(false, serialResult) == 0);
+    std::cout<<"serial execution result : "<<serialResult<<std::endl;
+    check = check && (runChain(true, parallelResult) == 0);
+    std::cout<<"parallel execution result : "<<parallelResult<<std::endl;
+
+    check = check && (std::abs(serialResult - 16.0) < 1.0e-12);
+    check = check && (std::abs(parallelResult - serialResult) < 1.0e-12);
+
+    mimmo::threads::setNumberOfThreads(0);
+
+    if(check){
+        std::cout<<"test_core_00012 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00012 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test12() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00012 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
@@ -0,0 +1,159 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00013
+ * Testing memoized execution of a Chain: blocks with unchanged inputs are skipped
+ * and their stored results are forwarded again to the children.
+ */
+
+class Producer: public mimmo::BaseManipulation{
+public:
+    double m_value;
+    double m_output;
+    int m_nExec;
+
+    Producer(){m_value = 1.0; m_output = 0.0; m_nExec = 0;};
+    virtual ~Producer(){};
+    void setValue(double value){ m_value = value; markDirty();};
+    double getOutput(){ return m_output;};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort("M_TESTMEMO", MC_SCALAR, MD_FLOAT,"test_core_00013.cpp");
+        bool built = true;
+        built = built && createPortOut<double, Producer>(this, &Producer::getOutput, "M_TESTMEMO");
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_output = (m_value > 0.0) ? 1.0 : -1.0;
+        ++m_nExec;
+    };
+};
+
+class Consumer: public mimmo::BaseManipulation{
+public:
+    double m_input;
+    double m_result;
+    int m_nExec;
+
+    Consumer(){m_input = 0.0; m_result = 0.0; m_nExec = 0;};
+    virtual ~Consumer(){};
+    void setInput(double value){ m_input = value; markDirty();};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort("M_TESTMEMO", MC_SCALAR, MD_FLOAT,"test_core_00013.cpp");
+        bool built = true;
+        built = built && createPortIn<double, Consumer>(this, &Consumer::setInput, "M_TESTMEMO", true);
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_result = 10.0 * m_input;
+        ++m_nExec;
+    };
+};
+
+// =================================================================================== //
+
+int test13() {
+
+    Producer * producer = new Producer();
+    Consumer * consumer = new Consumer();
+    bool check = mimmo::pin::addPin(producer, consumer, "M_TESTMEMO", "M_TESTMEMO");
+
+    mimmo::Chain chain;
+    chain.addObject(consumer);
+    chain.addObject(producer);
+    chain.setMemoizedExecution(true);
+
+    // first run: everything executed
+    chain.exec();
+    check = check && (producer->m_nExec == 1) && (consumer->m_nExec == 1);
+    check = check && (std::abs(consumer->m_result - 10.0) < 1.0e-12);
+
+    // nothing changed: everything skipped
+    chain.exec();
+    check = check && (producer->m_nExec == 1) && (consumer->m_nExec == 1);
+    check = check && !producer->wasExecuted() && !consumer->wasExecuted();
+
+    // producer parameter changed, same output: consumer skipped
+    producer->setValue(2.0);
+    chain.exec();
+    check = check && (producer->m_nExec == 2) && (consumer->m_nExec == 1);
+
+    // producer output changed: consumer executed
+    producer->setValue(-2.0);
+    chain.exec();
+    check = check && (producer->m_nExec == 3) && (consumer->m_nExec == 2);
+    check = check && (std::abs(consumer->m_result + 10.0) < 1.0e-12);
+
+    // forced execution
+    consumer->markDirty();
+    chain.exec();
+    check = check && (producer->m_nExec == 3) && (consumer->m_nExec == 3);
+
+    // memoization off: everything executed
+    chain.setMemoizedExecution(false);
+    producer->setMemoization(false);
+    consumer->setMemoization(false);
+    chain.exec();
+    check = check && (producer->m_nExec == 4) && (consumer->m_nExec == 4);
+
+    delete producer;
+    delete consumer;
+
+    if(check){
+        std::cout<<"test_core_00013 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00013 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test13() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00013 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
@@ -0,0 +1,278 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00014
+ * Testing memoized execution with in place deformation of a geometry: the undeformed
+ * coordinates are restored before a new deformation if the geometry producer was skipped,
+ * and before the execution of blocks placed between the producer and the deforming block.
+ */
+
+class GeometrySource: public mimmo::BaseManipulation{
+public:
+    int m_nExec;
+
+    GeometrySource(){m_nExec = 0;};
+    virtual ~GeometrySource(){};
+    void buildPorts(){
+        bool built = true;
+        built = built && createPortOut<mimmo::MimmoSharedPointer<mimmo::MimmoObject>, GeometrySource>(this, &mimmo::BaseManipulation::getGeometry, M_GEOM);
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_geometry = mimmo::MimmoSharedPointer<mimmo::MimmoObject>(new mimmo::MimmoObject(3));
+        for(long id=0; id<10; ++id){
+            darray3E point = {{double(id), 0.0, 0.0}};
+            m_geometry->addVertex(point, id);
+        }
+        ++m_nExec;
+    };
+};
+
+class Translation: public mimmo::BaseManipulation{
+public:
+    double m_shift;
+    int m_nExec;
+    mimmo::MimmoPiercedVector<darray3E> m_displ;
+
+    Translation(){m_shift = 0.0; m_nExec = 0;};
+    virtual ~Translation(){};
+    void setShift(double shift){ m_shift = shift; markDirty();};
+    void buildPorts(){
+        bool built = true;
+        built = built && createPortIn<mimmo::MimmoSharedPointer<mimmo::MimmoObject>, Translation>(this, &mimmo::BaseManipulation::setGeometry, M_GEOM, true);
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_displ.clear();
+        m_displ.setGeometry(m_geometry);
+        m_displ.setDataLocation(mimmo::MPVLocation::POINT);
+        for(const auto & vertex : m_geometry->getVertices()){
+            m_displ.insert(vertex.getId(), {{m_shift, 0.0, 0.0}});
+        }
+        ++m_nExec;
+    };
+    void apply(){
+        _apply(m_displ);
+    };
+};
+
+class Stretch: public mimmo::BaseManipulation{
+public:
+    double m_factor;
+    int m_nExec;
+    mimmo::MimmoPiercedVector<darray3E> m_displ;
+
+    Stretch(){m_factor = 0.0; m_nExec = 0;};
+    virtual ~Stretch(){};
+    void setFactor(double factor){ m_factor = factor; markDirty();};
+    mimmo::MimmoPiercedVector<darray3E> * getDispl(){ return &m_displ;};
+    void buildPorts(){
+        bool built = true;
+        mimmo::PortManager::instance().addPort("M_TESTDISPLS", MC_SCALAR, MD_MPVECARR3FLOAT_, "test_core_00014.cpp");
+        built = built && createPortIn<mimmo::MimmoSharedPointer<mimmo::MimmoObject>, Stretch>(this, &mimmo::BaseManipulation::setGeometry, M_GEOM, true);
+        built = built && createPortOut<mimmo::MimmoPiercedVector<darray3E>*, Stretch>(this, &Stretch::getDispl, "M_TESTDISPLS");
+        m_arePortsBuilt = built;
+    };
+    // displacements depend on the current coordinates of the geometry.
+    void execute(){
+        m_displ.clear();
+        m_displ.setGeometry(m_geometry);
+        m_displ.setDataLocation(mimmo::MPVLocation::POINT);
+        for(const auto & vertex : m_geometry->getVertices()){
+            m_displ.insert(vertex.getId(), {{m_factor*vertex.getCoords()[0], 0.0, 0.0}});
+        }
+        ++m_nExec;
+    };
+};
+
+class Applier: public mimmo::BaseManipulation{
+public:
+    int m_nExec;
+    mimmo::MimmoPiercedVector<darray3E> m_displ;
+
+    Applier(){m_nExec = 0;};
+    virtual ~Applier(){};
+    void setDispl(mimmo::MimmoPiercedVector<darray3E> * displ){ if(displ) m_displ = *displ;};
+    void buildPorts(){
+        bool built = true;
+        mimmo::PortManager::instance().addPort("M_TESTDISPLS", MC_SCALAR, MD_MPVECARR3FLOAT_, "test_core_00014.cpp");
+        built = built && createPortIn<mimmo::MimmoSharedPointer<mimmo::MimmoObject>, Applier>(this, &mimmo::BaseManipulation::setGeometry, M_GEOM, true);
+        built = built && createPortIn<mimmo::MimmoPiercedVector<darray3E>*, Applier>(this, &Applier::setDispl, "M_TESTDISPLS", true);
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        ++m_nExec;
+    };
+    void apply(){
+        _apply(m_displ);
+    };
+};
+
+// =================================================================================== //
+
+bool checkCoordinates(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geometry, double shift){
+    bool check = (geometry != nullptr);
+    if(!check) return false;
+    for(const auto & vertex : geometry->getVertices()){
+        check = check && (std::abs(vertex.getCoords()[0] - (double(vertex.getId()) + shift)) < 1.0e-12);
+    }
+    return check;
+}
+
+bool checkStretched(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geometry, double scale){
+    bool check = (geometry != nullptr);
+    if(!check) return false;
+    for(const auto & vertex : geometry->getVertices()){
+        check = check && (std::abs(vertex.getCoords()[0] - scale*double(vertex.getId())) < 1.0e-12);
+    }
+    return check;
+}
+
+/*!
+ * Chain source -> stretch -> applier, with a stretch depending on the coordinates of the geometry.
+ */
+bool testStretch() {
+
+    GeometrySource * source = new GeometrySource();
+    Stretch * stretch = new Stretch();
+    Applier * applier = new Applier();
+    applier->setApply(true);
+    bool check = mimmo::pin::addPin(source, stretch, M_GEOM, M_GEOM);
+    check = check && mimmo::pin::addPin(source, applier, M_GEOM, M_GEOM);
+    check = check && mimmo::pin::addPin(stretch, applier, "M_TESTDISPLS", "M_TESTDISPLS");
+
+    mimmo::Chain chain;
+    chain.addObject(applier);
+    chain.addObject(stretch);
+    chain.addObject(source);
+    chain.setMemoizedExecution(true);
+
+    stretch->setFactor(1.0);
+    chain.exec();
+    check = check && (source->m_nExec == 1) && (stretch->m_nExec == 1) && (applier->m_nExec == 1);
+    check = check && checkStretched(source->getGeometry(), 2.0);
+
+    // nothing changed: geometry untouched
+    chain.exec();
+    check = check && (source->m_nExec == 1) && (stretch->m_nExec == 1) && (applier->m_nExec == 1);
+    check = check && checkStretched(source->getGeometry(), 2.0);
+
+    // new factor, source skipped: the stretch works on the undeformed geometry
+    stretch->setFactor(2.0);
+    chain.exec();
+    check = check && (source->m_nExec == 1) && (stretch->m_nExec == 2) && (applier->m_nExec == 2);
+    check = check && checkStretched(source->getGeometry(), 3.0);
+
+    // parallel execution of the chain
+    chain.setParallelExecution(true);
+    stretch->setFactor(4.0);
+    chain.exec();
+    check = check && (source->m_nExec == 1) && (stretch->m_nExec == 3) && (applier->m_nExec == 3);
+    check = check && checkStretched(source->getGeometry(), 5.0);
+
+    delete source;
+    delete stretch;
+    delete applier;
+
+    return check;
+}
+
+int test14() {
+
+    GeometrySource * source = new GeometrySource();
+    Translation * translation = new Translation();
+    translation->setApply(true);
+    bool check = mimmo::pin::addPin(source, translation, M_GEOM, M_GEOM);
+
+    mimmo::Chain chain;
+    chain.addObject(translation);
+    chain.addObject(source);
+    chain.setMemoizedExecution(true);
+
+    translation->setShift(1.0);
+    chain.exec();
+    check = check && (source->m_nExec == 1) && (translation->m_nExec == 1);
+    check = check && checkCoordinates(source->getGeometry(), 1.0);
+
+    // nothing changed: geometry untouched
+    chain.exec();
+    check = check && (source->m_nExec == 1) && (translation->m_nExec == 1);
+    check = check && checkCoordinates(source->getGeometry(), 1.0);
+
+    // new shift, source skipped: deformation applied to the undeformed geometry
+    translation->setShift(2.0);
+    chain.exec();
+    check = check && (source->m_nExec == 1) && (translation->m_nExec == 2);
+    check = check && checkCoordinates(source->getGeometry(), 2.0);
+
+    // source executed again: new geometry deformed
+    source->markDirty();
+    translation->setShift(3.0);
+    chain.exec();
+    check = check && (source->m_nExec == 2) && (translation->m_nExec == 3);
+    check = check && checkCoordinates(source->getGeometry(), 3.0);
+
+    delete source;
+    delete translation;
+
+    check = testStretch() && check;
+
+    if(check){
+        std::cout<<"test_core_00014 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00014 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test14() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00014 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
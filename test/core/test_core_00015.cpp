@@ -0,0 +1,200 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00015
+ * Testing DesignSweep: designs evaluated by two replicas of a workflow, with the
+ * setup block executed only once per replica and failing designs reported. Then the
+ * same setup block is shared by the two replicas and executed once before the sweep.
+ */
+
+class Setup: public mimmo::BaseManipulation{
+public:
+    double m_output;
+    int m_nExec;
+
+    Setup(){m_output = 0.0; m_nExec = 0;};
+    virtual ~Setup(){};
+    double getOutput(){ return m_output;};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort("M_TESTSWEEP", MC_SCALAR, MD_FLOAT,"test_core_00015.cpp");
+        bool built = true;
+        built = built && createPortOut<double, Setup>(this, &Setup::getOutput, "M_TESTSWEEP");
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_output = 100.0;
+        ++m_nExec;
+    };
+};
+
+class Evaluator: public mimmo::BaseManipulation{
+public:
+    double m_offset;
+    double m_value;
+    double m_result;
+    int m_nExec;
+
+    Evaluator(){m_offset = 0.0; m_value = 0.0; m_result = 0.0; m_nExec = 0;};
+    virtual ~Evaluator(){};
+    void setOffset(double value){ m_offset = value; markDirty();};
+    void setValue(double value){ m_value = value; markDirty();};
+    void buildPorts(){
+        mimmo::PortManager::instance().addPort("M_TESTSWEEP", MC_SCALAR, MD_FLOAT,"test_core_00015.cpp");
+        bool built = true;
+        built = built && createPortIn<double, Evaluator>(this, &Evaluator::setOffset, "M_TESTSWEEP", true);
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_result = m_offset + m_value;
+        ++m_nExec;
+    };
+};
+
+// =================================================================================== //
+
+int test15() {
+
+    const std::size_t nDesigns = 8;
+    const std::size_t failing = 5;
+    const std::size_t failingUnknown = 6;
+
+    std::vector<std::unique_ptr<Setup>> setups;
+    std::vector<std::unique_ptr<Evaluator>> evaluators;
+    std::vector<std::unique_ptr<mimmo::Chain>> chains;
+    bool check = true;
+
+    mimmo::DesignSweep sweep;
+    for(int i = 0; i < 2; ++i){
+        setups.emplace_back(new Setup());
+        evaluators.emplace_back(new Evaluator());
+        check = check && mimmo::pin::addPin(setups.back().get(), evaluators.back().get(), "M_TESTSWEEP", "M_TESTSWEEP");
+        chains.emplace_back(new mimmo::Chain());
+        chains.back()->addObject(setups.back().get());
+        chains.back()->addObject(evaluators.back().get());
+        sweep.addReplica(std::vector<mimmo::Chain*>(1, chains.back().get()));
+    }
+    check = check && (sweep.getNReplicas() == 2);
+
+    sweep.setDesignSetter([&](std::size_t design, std::size_t replica){
+        if(design == failing) throw std::runtime_error("invalid design");
+        if(design == failingUnknown) throw 1;
+        evaluators[replica]->setValue(double(design));
+    });
+
+    // the observer runs on the thread of the replica, before it picks a new design
+    std::vector<double> observed(nDesigns, -1.0);
+    sweep.setDesignObserver([&](const mimmo::DesignSweep::DesignResult & result){
+        if(result.success) observed[result.design] = evaluators[result.replica]->m_result;
+    });
+
+    std::vector<mimmo::DesignSweep::DesignResult> results = sweep.run(nDesigns);
+
+    check = check && (results.size() == nDesigns);
+    for(std::size_t design = 0; design < nDesigns; ++design){
+        check = check && (results[design].design == design);
+        check = check && (results[design].waitTime >= 0.0) && (results[design].waitTime <= results[design].time);
+        if(design == failing){
+            check = check && !results[design].success && (results[design].message == "invalid design");
+        }else if(design == failingUnknown){
+            check = check && !results[design].success && (results[design].message == "unknown exception");
+        }else{
+            check = check && results[design].success;
+            check = check && (std::abs(observed[design] - (100.0 + double(design))) < 1.0e-12);
+        }
+    }
+
+    int nSetupExec = 0;
+    int nEvalExec = 0;
+    for(int i = 0; i < 2; ++i){
+        check = check && (setups[i]->m_nExec <= 1);
+        nSetupExec += setups[i]->m_nExec;
+        nEvalExec += evaluators[i]->m_nExec;
+    }
+    check = check && (nSetupExec >= 1) && (nEvalExec == int(nDesigns - 2));
+
+    // setup shared by the replicas: executed once, out of the chains of the replicas
+    Setup shared;
+    std::vector<std::unique_ptr<Evaluator>> sharedEvaluators;
+    std::vector<std::unique_ptr<mimmo::Chain>> sharedChains;
+    mimmo::DesignSweep sharedSweep;
+    for(int i = 0; i < 2; ++i){
+        sharedEvaluators.emplace_back(new Evaluator());
+        check = check && mimmo::pin::addPin(&shared, sharedEvaluators.back().get(), "M_TESTSWEEP", "M_TESTSWEEP");
+        sharedChains.emplace_back(new mimmo::Chain());
+        sharedChains.back()->addObject(sharedEvaluators.back().get());
+        sharedSweep.addReplica(std::vector<mimmo::Chain*>(1, sharedChains.back().get()));
+    }
+    shared.exec();
+    sharedSweep.setDesignSetter([&](std::size_t design, std::size_t replica){
+        sharedEvaluators[replica]->setValue(double(design));
+    });
+    std::vector<double> sharedObserved(nDesigns, -1.0);
+    sharedSweep.setDesignObserver([&](const mimmo::DesignSweep::DesignResult & result){
+        if(result.success) sharedObserved[result.design] = sharedEvaluators[result.replica]->m_result;
+    });
+    results = sharedSweep.run(nDesigns);
+    for(std::size_t design = 0; design < nDesigns; ++design){
+        check = check && results[design].success;
+        check = check && (std::abs(sharedObserved[design] - (100.0 + double(design))) < 1.0e-12);
+    }
+    check = check && (shared.m_nExec == 1);
+
+    if(check){
+        std::cout<<"test_core_00015 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00015 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test15() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00015 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
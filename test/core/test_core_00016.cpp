@@ -0,0 +1,149 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00016
+ * Testing port ids: interning of port names in PortManager, access to the ports of a
+ * block by id, compatibility check by data type id and data transfer to several receivers.
+ */
+
+class Source: public mimmo::BaseManipulation{
+public:
+    double m_output;
+
+    Source(){m_output = 0.0;};
+    virtual ~Source(){};
+    double getOutput(){ return m_output;};
+    void buildPorts(){
+        bool built = true;
+        built = built && createPortOut<double, Source>(this, &Source::getOutput, "M_TESTPORTID");
+        m_arePortsBuilt = built;
+    };
+    void execute(){
+        m_output = 42.0;
+    };
+};
+
+class Sink: public mimmo::BaseManipulation{
+public:
+    double m_value;
+    int m_counter;
+
+    Sink(){m_value = 0.0; m_counter = 0;};
+    virtual ~Sink(){};
+    void setValue(double value){ m_value = value;};
+    void setCounter(int value){ m_counter = value;};
+    void buildPorts(){
+        bool built = true;
+        built = built && createPortIn<double, Sink>(this, &Sink::setValue, "M_TESTPORTID");
+        built = built && createPortIn<int, Sink>(this, &Sink::setCounter, "M_TESTPORTIDINT");
+        m_arePortsBuilt = built;
+    };
+    void execute(){};
+};
+
+// =================================================================================== //
+
+int test16() {
+
+    mimmo::PortManager & manager = mimmo::PortManager::instance();
+    long id = manager.addPort("M_TESTPORTID", MC_SCALAR, MD_FLOAT, "test_core_00016.cpp");
+    long idInt = manager.addPort("M_TESTPORTIDINT", MC_SCALAR, MD_INT, "test_core_00016.cpp");
+
+    bool check = true;
+
+    // interned names
+    check = check && (manager.getPortId("M_TESTPORTID") == id);
+    check = check && (manager.getPortName(id) == "M_TESTPORTID");
+    check = check && (manager.getPortId("M_TESTPORTNOTREGISTERED") == -1);
+    check = check && (manager.getPortName(long(manager.getNPorts())).empty());
+    check = check && (manager.addPort("M_TESTPORTID", MC_SCALAR, MD_FLOAT, "test_core_00016.cpp") == id);
+    mimmo::InfoPort info = manager.getPortData("M_TESTPORTID");
+    check = check && (info.datatypeId != manager.getPortData("M_TESTPORTIDINT").datatypeId);
+    check = check && (info.containerId == manager.getPortData("M_TESTPORTIDINT").containerId);
+
+    Source source;
+    Sink sink1, sink2;
+
+    // compatible and incompatible connections
+    check = check && mimmo::pin::addPin(&source, &sink1, "M_TESTPORTID", "M_TESTPORTID");
+    check = check && mimmo::pin::addPin(&source, &sink2, "M_TESTPORTID", "M_TESTPORTID");
+    check = check && !mimmo::pin::addPin(&source, &sink1, "M_TESTPORTID", "M_TESTPORTIDINT");
+    check = check && !mimmo::pin::addPin(&source, &sink1, "M_TESTPORTNOTREGISTERED", "M_TESTPORTID");
+
+    // ports by id
+    check = check && (sink1.getPortIn(id) != nullptr) && (sink1.getPortIn(idInt) != nullptr);
+    check = check && (sink1.getPortOut(id) == nullptr) && (source.getPortIn(id) == nullptr);
+    check = check && (source.getPortOut(id) != nullptr) && (source.getPortOut(-1) == nullptr);
+    check = check && (source.getPortOut(id)->getLink().size() == 2);
+
+    // fan-out of the data
+    source.exec();
+    check = check && (sink1.m_value == 42.0) && (sink2.m_value == 42.0);
+
+    // removed link
+    mimmo::pin::removePin(&source, &sink1, "M_TESTPORTID", "M_TESTPORTID");
+    sink1.m_value = 0.0;
+    sink2.m_value = 0.0;
+    source.exec();
+    check = check && (sink1.m_value == 0.0) && (sink2.m_value == 42.0);
+    check = check && (source.getPortOut(id)->getLink().size() == 1);
+
+    if(check){
+        std::cout<<"test_core_00016 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00016 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test16() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00016 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
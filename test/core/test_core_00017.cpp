@@ -0,0 +1,156 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00017
+ * Testing vertex maps and boundary vertices of MimmoObject: direct map evaluated from the
+ * inverse one, compact coordinates and boundary vertices extracted as set, cached
+ * coordinates and connectivities rebuilt only when the geometry revisions change.
+ */
+
+/*!
+ * Creating a structured quad surface mesh of n x n cells and return it in a MimmoObject.
+ * \param[in] n number of cells in each direction
+ * \return shared pointer to the mesh
+ */
+mimmo::MimmoSharedPointer<mimmo::MimmoObject> createQuadMesh(int n){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(1));
+    double dx = 1.0/double(n);
+
+    mesh->getVertices().reserve((n+1)*(n+1));
+    mesh->getCells().reserve(n*n);
+
+    for(int j=0; j<=n; ++j){
+        for(int i=0; i<=n; ++i){
+            mesh->addVertex(darray3E({{i*dx, j*dx, 0.0}}), long(j*(n+1) + i));
+        }
+    }
+
+    livector1D conn(4);
+    for(int j=0; j<n; ++j){
+        for(int i=0; i<n; ++i){
+            conn[0] = j*(n+1) + i;
+            conn[1] = j*(n+1) + i + 1;
+            conn[2] = (j+1)*(n+1) + i + 1;
+            conn[3] = (j+1)*(n+1) + i;
+            mesh->addConnectedCell(conn, bitpit::ElementType::QUAD, long(j*n + i));
+        }
+    }
+
+    mesh->updateAdjacencies();
+    return mesh;
+}
+
+// =================================================================================== //
+
+int test17() {
+
+    int n = 8;
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createQuadMesh(n);
+
+    bool check = (mesh->getNVertices() == long((n+1)*(n+1))) && (mesh->getNCells() == long(n*n));
+
+    // direct map from inverse map
+    lilimap mapDataInv = mesh->getMapDataInv(true);
+    lilimap mapData = mesh->getMapData(mapDataInv);
+    check = check && (mapData == mesh->getMapData(true));
+    check = check && (mapData.size() == mapDataInv.size());
+    for(auto & val : mapDataInv){
+        check = check && (mapData.count(val.second) > 0) && (mapData[val.second] == val.first);
+    }
+
+    // compact coordinates consistent with the inverse map
+    lilimap coordsMapInv;
+    dvecarr3E coords = mesh->getVerticesCoords(&coordsMapInv);
+    check = check && (coordsMapInv == mapDataInv) && (coords.size() == mapDataInv.size());
+    for(auto & val : mapDataInv){
+        check = check && (coords[val.second] == mesh->getVertexCoords(val.first));
+    }
+
+    // boundary vertices as set and as list
+    std::unordered_set<long> boundarySet = mesh->extractBoundaryVertexSet();
+    livector1D boundaryList = mesh->extractBoundaryVertexID();
+    check = check && (boundarySet.size() == std::size_t(4*n)) && (boundaryList.size() == boundarySet.size());
+    for(long id : boundaryList){
+        check = check && (boundarySet.count(id) > 0);
+    }
+
+    // cached coordinates and connectivities
+    const dvecarr3E & cachedCoords = mesh->getCachedVerticesCoords();
+    const livector2D & cachedConn = mesh->getCachedConnectivity();
+    const livector2D & cachedCompactConn = mesh->getCachedCompactConnectivity();
+    check = check && (cachedCoords == coords) && (mesh->getCachedVerticesMapDataInv() == mapDataInv);
+    check = check && (cachedConn == mesh->getConnectivity());
+    check = check && (cachedCompactConn == mesh->getCompactConnectivity(mapDataInv));
+    check = check && (&mesh->getCachedVerticesCoords() == &cachedCoords);
+
+    mesh->modifyVertex(darray3E({{0.5, 0.5, 1.0}}), long(0));
+    check = check && (mesh->getCachedVerticesCoords()[mapDataInv[0]] == darray3E({{0.5, 0.5, 1.0}}));
+    check = check && (cachedConn == mesh->getConnectivity());
+
+    mesh->addVertex(darray3E({{2.0, 2.0, 0.0}}), long((n+1)*(n+1)));
+    mesh->addConnectedCell(livector1D({long(n), long(n+1+n), long((n+1)*(n+1))}), bitpit::ElementType::TRIANGLE, long(n*n));
+    check = check && (mesh->getCachedVerticesCoords().size() == std::size_t(mesh->getNVertices()));
+    check = check && (mesh->getCachedConnectivity() == mesh->getConnectivity());
+    lilimap newMapDataInv = mesh->getMapDataInv(true);
+    check = check && (mesh->getCachedCompactConnectivity() == mesh->getCompactConnectivity(newMapDataInv));
+
+    if(check){
+        std::cout<<"test_core_00017 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00017 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test17() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00017 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
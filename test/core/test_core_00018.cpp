@@ -0,0 +1,147 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00018
+ * Testing revision numbers of MimmoObject (topology, coordinates, PIDs)
+ * and data revision of MimmoPiercedVector.
+ */
+
+/*!
+ * Creating a surface mesh of two triangles and return it in a MimmoObject.
+ * \return shared pointer to the mesh
+ */
+mimmo::MimmoSharedPointer<mimmo::MimmoObject> createTriangles(){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(1));
+    mesh->addVertex(darray3E({{0.0, 0.0, 0.0}}), 0);
+    mesh->addVertex(darray3E({{1.0, 0.0, 0.0}}), 1);
+    mesh->addVertex(darray3E({{1.0, 1.0, 0.0}}), 2);
+    mesh->addVertex(darray3E({{0.0, 1.0, 0.0}}), 3);
+    mesh->addConnectedCell({0, 1, 2}, bitpit::ElementType::TRIANGLE, long(0));
+    mesh->addConnectedCell({0, 2, 3}, bitpit::ElementType::TRIANGLE, long(1));
+    return mesh;
+}
+
+// =================================================================================== //
+
+int test18() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createTriangles();
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> other = createTriangles();
+
+    bool check = true;
+
+    // revisions are not shared between different objects
+    check = check && (mesh->getTopologyRevision() != other->getTopologyRevision());
+    check = check && (mesh->getCoordinatesRevision() != other->getCoordinatesRevision());
+
+    std::size_t topology = mesh->getTopologyRevision();
+    std::size_t coords = mesh->getCoordinatesRevision();
+    std::size_t pids = mesh->getPIDRevision();
+
+    // queries do not change revisions
+    mesh->update();
+    mesh->getVerticesCoords();
+    check = check && (mesh->getTopologyRevision() == topology);
+    check = check && (mesh->getCoordinatesRevision() == coords) && (mesh->getPIDRevision() == pids);
+
+    // vertex displacement changes coordinates only
+    mesh->modifyVertex(darray3E({{0.0, 0.0, 1.0}}), 0);
+    check = check && (mesh->getTopologyRevision() == topology) && (mesh->getPIDRevision() == pids);
+    check = check && (mesh->getCoordinatesRevision() > coords);
+    coords = mesh->getCoordinatesRevision();
+
+    // PID assignment changes PIDs only
+    mesh->setPIDCell(1, 3);
+    check = check && (mesh->getTopologyRevision() == topology) && (mesh->getCoordinatesRevision() == coords);
+    check = check && (mesh->getPIDRevision() > pids);
+    pids = mesh->getPIDRevision();
+
+    // topology change invalidates everything
+    mesh->addVertex(darray3E({{2.0, 0.0, 0.0}}), 4);
+    check = check && (mesh->getTopologyRevision() > topology);
+    check = check && (mesh->getCoordinatesRevision() > coords) && (mesh->getPIDRevision() > pids);
+    topology = mesh->getTopologyRevision();
+
+    // external modifications marked by setUnsyncAll
+    mesh->getPatch()->deleteVertex(4);
+    mesh->setUnsyncAll();
+    check = check && (mesh->getTopologyRevision() > topology);
+
+    // field data revision
+    mimmo::MimmoPiercedVector<double> field(mesh, mimmo::MPVLocation::POINT);
+    field.initialize(mesh, mimmo::MPVLocation::POINT, 1.0);
+    std::size_t data = field.getDataRevision();
+
+    mimmo::MimmoPiercedVector<double> copy(field);
+    check = check && (copy.getDataRevision() == data);
+
+    std::vector<double> values(field.size(), 2.0);
+    check = check && field.setAlignedData(values);
+    check = check && (field.getDataRevision() > data) && (copy.getDataRevision() == data);
+    data = field.getDataRevision();
+
+    field[0] = 3.0;
+    check = check && (field.getDataRevision() == data);
+    field.markDataChanged();
+    check = check && (field.getDataRevision() > data);
+
+    if(check){
+        std::cout<<"test_core_00018 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00018 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test18() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00018 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
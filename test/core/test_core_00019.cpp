@@ -0,0 +1,160 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00019
+ * Testing streaming VTU writer/reader: round trip of a mixed surface mesh with
+ * double/single precision coordinates and (if available) compressed blocks.
+ */
+
+/*!
+ * Creating a surface mesh of triangles, quads and polygons, with custom ids and PIDs.
+ * \param[in] n number of vertices on each side of the mesh
+ * \return shared pointer to the mesh
+ */
+mimmo::MimmoSharedPointer<mimmo::MimmoObject> createMesh(int n){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(1));
+    for(int i=0; i<n; ++i){
+        for(int j=0; j<n; ++j){
+            mesh->addVertex(darray3E({{0.1*i, 0.37*j, 0.001*i*j}}), 10 + i*n + j);
+        }
+    }
+    long id = 5;
+    for(int i=0; i<n-1; ++i){
+        for(int j=0; j<n-1; ++j){
+            long a = 10 + i*n + j, b = a + n, c = b + 1, d = a + 1;
+            switch((i+j)%3){
+            case 0:
+                mesh->addConnectedCell({a, b, c}, bitpit::ElementType::TRIANGLE, long(i%4), id++);
+                break;
+            case 1:
+                mesh->addConnectedCell({a, b, c, d}, bitpit::ElementType::QUAD, long(7), id++);
+                break;
+            default:
+                mesh->addConnectedCell({4, a, b, c, d}, bitpit::ElementType::POLYGON, long(2), id++);
+                break;
+            }
+        }
+    }
+    return mesh;
+}
+
+/*!
+ * Compare two meshes: vertex ids and coordinates, cell ids, types, PIDs and connectivity.
+ * \param[in] mesh reference mesh
+ * \param[in] other mesh to be checked
+ * \param[in] tol tolerance on coordinates
+ * \return true if the meshes are equal.
+ */
+bool compareMesh(mimmo::MimmoObject * mesh, mimmo::MimmoObject * other, double tol){
+
+    if(mesh->getNVertices() != other->getNVertices() || mesh->getNCells() != other->getNCells()) return false;
+    for(const bitpit::Vertex & vertex : mesh->getVertices()){
+        long id = vertex.getId();
+        if(!other->getVertices().exists(id)) return false;
+        if(norm2(vertex.getCoords() - other->getVertexCoords(id)) > tol) return false;
+    }
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        long id = cell.getId();
+        if(!other->getCells().exists(id)) return false;
+        const bitpit::Cell & otherCell = other->getCells().at(id);
+        if(cell.getType() != otherCell.getType() || cell.getPID() != otherCell.getPID()) return false;
+        bitpit::ConstProxyVector<long> conn = cell.getVertexIds();
+        bitpit::ConstProxyVector<long> otherConn = otherCell.getVertexIds();
+        if(!std::equal(conn.begin(), conn.end(), otherConn.begin()) || conn.size() != otherConn.size()) return false;
+    }
+    return true;
+}
+
+// =================================================================================== //
+
+int test19() {
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = createMesh(21);
+
+    bool check = true;
+    // without zlib support the compression option is ignored
+    for(int compress = 0; compress < 2; ++compress){
+        for(int float32 = 0; float32 < 2; ++float32){
+            mimmo::VTUStreamOptions options;
+            options.compress = compress;
+            options.float32 = float32;
+            // small blocks, to check values across several blocks
+            options.blockSize = 1000;
+            mimmo::VTUStreamWriter writer(options);
+            writer.write(mesh.get(), "./test_core_00019.vtu");
+
+            mimmo::MimmoSharedPointer<mimmo::MimmoObject> read(new mimmo::MimmoObject(1));
+            mimmo::VTUStreamReader reader(1000);
+            bool valid = reader.read("./test_core_00019.vtu", read.get());
+            check = check && valid && compareMesh(mesh.get(), read.get(), (float32 ? 1.0e-05 : 1.0e-12));
+        }
+    }
+
+    // files with inline data are left to the standard reader
+    mimmo::VTUFlushStreamerASCII streamer;
+    mimmo::VTUGridWriterASCII vtkascii(streamer, *(mesh->getPatch()));
+    vtkascii.write("./", "test_core_00019_ascii");
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> read(new mimmo::MimmoObject(1));
+    mimmo::VTUStreamReader reader;
+    check = check && !reader.read("./test_core_00019_ascii.vtu", read.get()) && (read->getNCells() == 0);
+
+    if(check){
+        std::cout<<"test_core_00019 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00019 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test19() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00019 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
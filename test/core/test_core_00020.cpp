@@ -0,0 +1,222 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_core.hpp"
+
+/*
+ * Test 00020
+ * Testing single precision fields: conversion of displacements and distances to
+ * single precision and back, preserving ids, order, geometry, location and name.
+ * Writing the fields with the OutputFloat32 option, as Float32 VTU data arrays.
+ */
+
+class FieldWriter: public mimmo::BaseManipulation{
+public:
+    FieldWriter(){};
+    virtual ~FieldWriter(){};
+    void writeFields(mimmo::dmpvecarr3E & displ, mimmo::dmpvector1D & dist){
+        write(displ.getGeometry(), displ, dist);
+    };
+    void execute(){};
+};
+
+/*!
+ * Read the type and the ascii values of a data array of a VTU file.
+ * \param[in] filename path to the VTU file
+ * \param[in] name name of the data array
+ * \param[out] type type of the data array, empty if the array is not found
+ * \param[out] values values of the data array
+ */
+void readVTUDataArray(const std::string & filename, const std::string & name, std::string & type, std::vector<double> & values){
+
+    type.clear();
+    values.clear();
+    std::ifstream in(filename);
+    std::string line;
+    while(std::getline(in, line)){
+        if(line.find("<DataArray") == std::string::npos || line.find("Name=\"" + name + "\"") == std::string::npos) continue;
+        std::size_t pos = line.find("type=\"");
+        if(pos == std::string::npos)    return;
+        pos += 6;
+        type = line.substr(pos, line.find('"', pos) - pos);
+        double value;
+        while(std::getline(in, line) && line.find("</DataArray>") == std::string::npos){
+            std::istringstream ss(line);
+            while(ss >> value){
+                values.push_back(value);
+            }
+        }
+        return;
+    }
+}
+
+/*!
+ * Write displacements and distances in an ascii VTU file, with or without the OutputFloat32
+ * option, and check the type and the values of the written data arrays.
+ * \param[in] float32 single precision output flag
+ * \param[in] type expected type of the data arrays
+ */
+bool checkOutputPrecision(mimmo::dmpvecarr3E & displ, mimmo::dmpvector1D & dist, bool float32, const std::string & type){
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = displ.getGeometry();
+    mesh->getPatch()->getVTK().setCodex(bitpit::VTKFormat::ASCII);
+
+    FieldWriter writer;
+    writer.setName("test_core_00020_output");
+    writer.setOutputPlot(".");
+    writer.setOutputFloat32(float32);
+    bool check = (writer.isOutputFloat32() == float32);
+    writer.writeFields(displ, dist);
+    std::string filename = "./test_core_00020_output" + std::to_string(writer.getId()) + ".vtu";
+
+    std::string displType, distType;
+    std::vector<double> displValues, distValues;
+    readVTUDataArray(filename, "displacements", displType, displValues);
+    readVTUDataArray(filename, "distances", distType, distValues);
+    check = check && (displType == type) && (distType == type);
+    check = check && (displValues.size() == 3*std::size_t(mesh->getNVertices())) && (distValues.size() == std::size_t(mesh->getNCells()));
+
+    // values are written in the order of the patch, with the ascii precision of the writer
+    double maxErr = 0.0;
+    std::size_t k = 0;
+    for(const bitpit::Vertex & vertex : mesh->getVertices()){
+        if(3*k + 2 >= displValues.size())   break;
+        const darray3E & value = displ[vertex.getId()];
+        for(int d = 0; d < 3; ++d){
+            maxErr = std::max(maxErr, std::abs(displValues[3*k + d] - value[d]));
+        }
+        ++k;
+    }
+    k = 0;
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        if(k >= distValues.size())  break;
+        maxErr = std::max(maxErr, std::abs(distValues[k] - dist[cell.getId()]) / std::max(1.0, dist[cell.getId()]));
+        ++k;
+    }
+    check = check && (maxErr < 1.0e-5);
+
+    std::cout<<"output as "<<type<<" : type "<<displType<<"/"<<distType<<", max error "<<maxErr<<std::endl;
+    return check;
+}
+
+// =================================================================================== //
+
+int test20() {
+
+    // triangulated unit square, 16 x 16 vertices
+    int n = 16;
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(1));
+    for(int j=0; j<n; ++j){
+        for(int i=0; i<n; ++i){
+            mesh->addVertex(darray3E({{i/double(n-1), j/double(n-1), 0.0}}), long(j*n + i));
+        }
+    }
+    long idCell = 0;
+    for(int j=0; j<n-1; ++j){
+        for(int i=0; i<n-1; ++i){
+            long v0 = j*n + i;
+            mesh->addConnectedCell(livector1D({v0, v0 + 1, v0 + n + 1}), bitpit::ElementType::TRIANGLE, idCell++);
+            mesh->addConnectedCell(livector1D({v0, v0 + n + 1, v0 + n}), bitpit::ElementType::TRIANGLE, idCell++);
+        }
+    }
+
+    mimmo::dmpvecarr3E displ(mesh, mimmo::MPVLocation::POINT);
+    displ.setName("displacements");
+    mimmo::dmpvector1D dist(mesh, mimmo::MPVLocation::CELL);
+    dist.setName("distances");
+    for(const bitpit::Vertex & vertex : mesh->getVertices()){
+        const darray3E & coords = vertex.getCoords();
+        displ.insert(vertex.getId(), darray3E({{0.1*coords[0], std::sin(coords[1]), 1.0/3.0}}));
+    }
+    for(const bitpit::Cell & cell : mesh->getCells()){
+        dist.insert(cell.getId(), std::sqrt(double(cell.getId())));
+    }
+    bool check = displ.alignToGeometry(darray3E({{0.0, 0.0, 0.0}})) && displ.isAligned();
+
+    // single precision copies
+    mimmo::fmpvecarr3E displ32 = mimmo::toFloat32(displ);
+    mimmo::fmpvector1D dist32 = mimmo::toFloat32(dist);
+    check = check && (displ32.size() == displ.size()) && (dist32.size() == dist.size());
+    check = check && (displ32.getGeometry() == mesh) && (displ32.getDataLocation() == mimmo::MPVLocation::POINT);
+    check = check && (displ32.getName() == "displacements") && (dist32.getName() == "distances");
+    check = check && displ32.isAligned();
+    check = check && (displ32.getIds(false) == displ.getIds(false)) && (dist32.getIds(false) == dist.getIds(false));
+
+    // explicit conversion back to double precision
+    mimmo::dmpvecarr3E displ64 = mimmo::toFloat64(displ32);
+    mimmo::dmpvector1D dist64 = mimmo::toFloat64(dist32);
+    double maxErr = 0.0;
+    for(auto it = displ.begin(); it != displ.end(); ++it){
+        maxErr = std::max(maxErr, norm2(displ64[it.getId()] - *it));
+        maxErr = std::max(maxErr, norm2(darray3E({{double(displ32[it.getId()][0]), double(displ32[it.getId()][1]), double(displ32[it.getId()][2])}}) - *it));
+    }
+    for(auto it = dist.begin(); it != dist.end(); ++it){
+        maxErr = std::max(maxErr, std::abs(dist64[it.getId()] - *it));
+    }
+    check = check && (maxErr < 1.0e-6) && (maxErr > 0.0);
+    check = check && displ64.isAligned() && (displ64.getGeometry() == mesh);
+
+    // non floating point values are copied as they are
+    mimmo::limpvector1D labels = mimmo::toFloat32(mimmo::limpvector1D(mesh, mimmo::MPVLocation::CELL));
+    check = check && labels.empty();
+
+    // single precision output
+    check = checkOutputPrecision(displ, dist, true, "Float32") && check;
+    check = checkOutputPrecision(displ, dist, false, "Float64") && check;
+
+    if(check){
+        std::cout<<"test_core_00020 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_core_00020 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test20() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_core_00020 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
@@ -0,0 +1,126 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_iocgns.hpp"
+#include <cgnslib.h>
+#include <exception>
+
+/*!
+ * Read the cgns file with the given mode and return the reader.
+ */
+mimmo::IOCGNS * readGrid(const std::string & dir, const std::string & filename, bool parallel){
+    mimmo::IOCGNS * reader = new mimmo::IOCGNS(mimmo::IOCGNS::IOCGNS_Mode::READ);
+    reader->setDir(dir);
+    reader->setFilename(filename);
+    reader->setReadingParallel(parallel);
+    reader->exec();
+    return reader;
+}
+
+/*!
+ * Compare global counts of volume and boundary cells and vertices of two readers.
+ */
+bool compareGrids(mimmo::IOCGNS * first, mimmo::IOCGNS * second){
+    bool check = (first->getGeometry()->getNGlobalCells() == second->getGeometry()->getNGlobalCells());
+    check = check && (first->getGeometry()->getNGlobalVertices() == second->getGeometry()->getNGlobalVertices());
+    check = check && (first->getSurfaceBoundary()->getNGlobalCells() == second->getSurfaceBoundary()->getNGlobalCells());
+    check = check && (first->getSurfaceBoundary()->getNGlobalVertices() == second->getSurfaceBoundary()->getNGlobalVertices());
+    check = check && (first->getBoundaryConditions()->mcg_bcpidnames == second->getBoundaryConditions()->mcg_bcpidnames);
+    return check;
+}
+
+// =================================================================================== //
+/*!
+ * //testing parallel cgns :
+   - reading cgns with master rank and with all the ranks
+   - writing the partitioned mesh with all the ranks (parallel cgns only)
+   - reading back the written file with master rank
+ */
+int test1() {
+
+    mimmo::IOCGNS * serial = readGrid("geodata", "grid", false);
+    bitpit::Logger & log = serial->getLog();
+    log.setPriority(bitpit::log::Priority::NORMAL);
+
+    bool check = (serial->getGeometry()->getNGlobalVertices() == 201306);
+    check = check && (serial->getGeometry()->getNGlobalCells() == 643873);
+    check = check && (serial->getSurfaceBoundary()->getNGlobalCells() == 18856);
+    log<<"Read grid.cgns with master rank : "<<check<<std::endl;
+
+    mimmo::IOCGNS * parallel = readGrid("geodata", "grid", true);
+    bool checkParallel = parallel->getGeometry()->isDistributed() && compareGrids(serial, parallel);
+    log<<"Read grid.cgns with all the ranks, matching master rank read : "<<checkParallel<<std::endl;
+    check = check && checkParallel;
+
+#if CG_BUILD_PARALLEL
+    mimmo::IOCGNS * writer = new mimmo::IOCGNS(mimmo::IOCGNS::IOCGNS_Mode::WRITE);
+    writer->setDir(".");
+    writer->setFilename("tip1_grid");
+    writer->setGeometry(parallel->getGeometry());
+    writer->setSurfaceBoundary(parallel->getSurfaceBoundary());
+    writer->setBoundaryConditions(parallel->getBoundaryConditions());
+    writer->setWritingParallel(true);
+    writer->exec();
+
+    mimmo::IOCGNS * readback = readGrid(".", "tip1_grid", false);
+    bool checkWrite = compareGrids(serial, readback);
+    log<<"Written partitioned grid with all the ranks, matching master rank read back : "<<checkWrite<<std::endl;
+    check = check && checkWrite;
+
+    delete writer;
+    delete readback;
+#endif
+
+    log<<"test passed : "<<check<<std::endl;
+
+    delete serial;
+    delete parallel;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+    int val = 1;
+    try{
+        /**<Calling mimmo Test routines*/
+        val = test1() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_iocgns_parallel_00001 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -189,6 +189,40 @@ int test2_3() {
 
     return int(!check);
 }
+
+/*!
+ * Check that a memoized GenericInput is executed again when its input file is rewritten.
+ */
+int test2_4() {
+
+    std::ofstream out("./memoized_input.txt");
+    out<<1.5<<std::endl;
+    out.close();
+
+    mimmo::GenericInput * ginput = new mimmo::GenericInput(".", "memoized_input.txt");
+    ginput->setMemoization(true);
+    ginput->exec();
+    bool check = ginput->wasExecuted();
+    check = check && (std::abs(ginput->getResult<double>() - 1.5) < 1.0e-12);
+
+    //file unchanged: execution skipped
+    ginput->exec();
+    check = check && !ginput->wasExecuted();
+
+    //file rewritten with the same name: executed again
+    out.open("./memoized_input.txt");
+    out<<-12.25<<std::endl;
+    out.close();
+    ginput->exec();
+    check = check && ginput->wasExecuted();
+    check = check && (std::abs(ginput->getResult<double>() + 12.25) < 1.0e-12);
+
+    delete ginput;
+
+    std::cout<<"test passed :"<<check<<std::endl;
+
+    return int(!check);
+}
 // =================================================================================== //
 
 int main( int argc, char *argv[] ) {
@@ -205,6 +239,7 @@ int main( int argc, char *argv[] ) {
             val = test2_1() ;
             val = std::max(val, test2_2());
             val = std::max(val, test2_3());
+            val = std::max(val, test2_4());
         }
         catch(std::exception & e){
             std::cout<<"test_iogeneric_00002 exited with an error of type : "<<e.what()<<std::endl;
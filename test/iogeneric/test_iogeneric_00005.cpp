@@ -0,0 +1,178 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_iogeneric.hpp"
+
+// =================================================================================== //
+/*!
+ * Write two MimmoPiercedVector fields in the same field container file with
+ * GenericOutputMPVData and read them back by name with GenericInputMPVData.
+ * Append twice the same field and check the last version is read by name.
+ */
+int test5_1() {
+
+    //create a fake geometry();
+    dvecarr3E points(4, {{0,0,0}});
+    livector2D  conn(2, livector1D(3,0));
+    points[1][0] = 1.0;
+    points[2][1] = 1.0;
+    points[3][0] = 1.0;
+    points[3][1] = 1.0;
+    conn[0][1] = 1; conn[0][2]=2;
+    conn[1][0] = 1; conn[1][1]=3; conn[1][2] = 2;
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo(new mimmo::MimmoObject(1));
+    for(int i=0; i<(int)points.size(); ++i) geo->addVertex(points[i], i);
+    geo->addConnectedCell(conn[0], bitpit::ElementType::TRIANGLE, long(0), long(0));
+    geo->addConnectedCell(conn[1], bitpit::ElementType::TRIANGLE, long(0), long(1));
+
+    //create a MPV vector of doubles and darray3E; the vector field has ids out of the geometry.
+    mimmo::MimmoPiercedVector<double> scalar(geo, mimmo::MPVLocation::CELL);
+    mimmo::MimmoPiercedVector<darray3E> vector(geo, mimmo::MPVLocation::POINT);
+    scalar.setName("pressure");
+    vector.setName("displacement");
+    scalar.insert(1, -3.456);
+    scalar.insert(0, 12.5);
+    vector.insert(1,{{-1.0, 0, 2.0}});
+    vector.insert(2,{{-0.976, -0.976, -0.976}});
+    vector.insert(0,{{1.2, 1.3, 1.4}});
+    vector.insert(3,{{0, 0, 12.0}});
+    vector.insert(5,{{0, 0, 0.0}});
+    vector.insert(22,{{0, 0, 0.0}});
+
+    // write the scalar field in single precision, then append the vector field.
+    mimmo::GenericOutputMPVData * write_scalar = new mimmo::GenericOutputMPVData();
+    write_scalar->setWriteDir(".");
+    write_scalar->setFilename("fields.mfld");
+    write_scalar->setContainer(true);
+    write_scalar->setFloat32(true);
+    write_scalar->setInput(scalar);
+
+    mimmo::GenericOutputMPVData * write_vector = new mimmo::GenericOutputMPVData();
+    write_vector->setWriteDir(".");
+    write_vector->setFilename("fields.mfld");
+    write_vector->setContainer(true);
+    write_vector->setAppend(true);
+    write_vector->setInput(vector);
+
+    write_scalar->exec();
+    write_vector->exec();
+
+    bool check = mimmo::fieldContainer::isContainerFile("./fields.mfld");
+
+    //re read fields by name.
+    mimmo::GenericInputMPVData * read_scalar = new mimmo::GenericInputMPVData();
+    read_scalar->setReadDir(".");
+    read_scalar->setFilename("fields.mfld");
+    read_scalar->setFieldName("pressure");
+    read_scalar->setGeometry(geo);
+
+    mimmo::GenericInputMPVData * read_vector = new mimmo::GenericInputMPVData();
+    read_vector->setReadDir(".");
+    read_vector->setFilename("fields.mfld");
+    read_vector->setFieldName("displacement");
+    read_vector->setGeometry(geo);
+
+    read_scalar->exec();
+    read_vector->exec();
+
+    auto rscalar = read_scalar->getResult<double>();
+    auto rvector = read_vector->getResult<darray3E>();
+
+    check = check && (rscalar->getGeometry() == geo);
+    check = check && (rscalar->getDataLocation() == mimmo::MPVLocation::CELL);
+    check = check && (rvector->getDataLocation() == mimmo::MPVLocation::POINT);
+    check = check && (rscalar->size() == scalar.size());
+    check = check && (int(rvector->size()) == geo->getPatch()->getVertexCount());
+    check = check && (std::abs(rscalar->at(0) - 12.5) < 1.0e-12);
+    check = check && (std::abs(rscalar->at(1) + 3.456) < 1.0e-6);
+    check = check && (norm2(rvector->at(2) - vector.at(2)) < 1.0e-12);
+
+    //read directly a range of ids of the vector field.
+    mimmo::fieldContainer::Reader reader("./fields.mfld");
+    check = check && (reader.getFieldCount() == 2);
+    const mimmo::fieldContainer::FieldInfo * info = reader.getFieldInfo("displacement");
+    check = check && (info != nullptr) && (info->count == vector.size());
+    mimmo::MimmoPiercedVector<darray3E> range;
+    check = check && (info != nullptr) && reader.read(*info, range, 2, 6);
+    check = check && (range.size() == 3) && range.exists(5) && !range.exists(1) && !range.exists(22);
+    reader.close();
+
+    //append twice in a row a new version of the scalar field: the last one is read by name.
+    mimmo::fieldContainer::Writer writer;
+    check = check && writer.open("./fields.mfld", true);
+    for(double factor : {2.0, 3.0}){
+        mimmo::MimmoPiercedVector<double> version(geo, mimmo::MPVLocation::CELL);
+        version.setName("pressure");
+        version.insert(0, factor * 12.5);
+        version.insert(1, factor * -3.456);
+        check = check && writer.write(version);
+    }
+    writer.close();
+
+    check = check && reader.open("./fields.mfld");
+    check = check && (reader.getFieldCount() == 4);
+    const mimmo::fieldContainer::FieldInfo * last = reader.getFieldInfo("pressure");
+    check = check && (last != nullptr) && (last == reader.getFieldInfo(3)) && (last->count == scalar.size());
+    mimmo::MimmoPiercedVector<double> rlast, rsecond;
+    check = check && (last != nullptr) && reader.read(*last, rlast);
+    check = check && (rlast.size() == 2) && (std::abs(rlast.at(0) - 37.5) < 1.0e-12);
+    check = check && reader.read(*reader.getFieldInfo(2), rsecond);
+    check = check && (rsecond.size() == 2) && (std::abs(rsecond.at(0) - 25.0) < 1.0e-12);
+
+    delete write_scalar;
+    delete write_vector;
+    delete read_scalar;
+    delete read_vector;
+
+    std::cout<<"test passed :"<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		/**<Calling mimmo Test routines*/
+        int val = 1;
+        try{
+            val = test5_1() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_iogeneric_00005 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,153 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_iogeneric.hpp"
+
+// =================================================================================== //
+/*!
+ * Write an obj file with two sub-objects: a large grid of textured quads, big enough to be
+ * parsed in several chunks, and a small object of triangles with vertex normals, whose
+ * facets use indices relative to the end of the vertex lists.
+ * \param[in] n number of grid vertices for each direction
+ */
+void writeObjFile(int n) {
+
+    std::ofstream out("./obj_grid.obj");
+    out<<"# mimmo test obj file"<<'\n';
+    out<<"mtllib obj_grid.mtl"<<'\n';
+    out<<"o Lower"<<'\n';
+    for(int j=0; j<n; ++j){
+        for(int i=0; i<n; ++i){
+            out<<"v "<<double(i)/(n-1)<<" "<<double(j)/(n-1)<<" 0.0"<<'\n';
+        }
+    }
+    for(int j=0; j<n; ++j){
+        for(int i=0; i<n; ++i){
+            out<<"vt "<<double(i)/(n-1)<<" "<<double(j)/(n-1)<<'\n';
+        }
+    }
+    out<<"usemtl steel"<<'\n';
+    out<<"s 1"<<'\n';
+    for(int j=0; j<n-1; ++j){
+        for(int i=0; i<n-1; ++i){
+            long v0 = long(j)*n + i + 1;
+            long v1 = v0 + 1;
+            long v2 = v1 + n;
+            long v3 = v0 + n;
+            out<<"f "<<v0<<"/"<<v0<<" "<<v1<<"/"<<v1<<" "<<v2<<"/"<<v2<<" "<<v3<<"/"<<v3<<'\n';
+        }
+    }
+    out<<"o Upper"<<'\n';
+    out<<"v 0.0 0.0 1.0"<<'\n';
+    out<<"v 1.0 0.0 1.0"<<'\n';
+    out<<"v 1.0 1.0 1.0"<<'\n';
+    out<<"v 0.0 1.0 1.0"<<'\n';
+    out<<"vn 0.0 0.0 1.0"<<'\n';
+    out<<"g top"<<'\n';
+    out<<"f -4//-1 -3//-1 -2//-1"<<'\n';
+    out<<"f -4//-1 -2//-1 -1//-1"<<'\n';
+    out.close();
+}
+
+/*!
+ * Read an obj file with IOWavefrontOBJ and check mesh, parts, textures, normals and cell data.
+ */
+int test6_1() {
+
+    int n = 300;
+    writeObjFile(n);
+
+    mimmo::IOWavefrontOBJ * reader = new mimmo::IOWavefrontOBJ(mimmo::IOWavefrontOBJ::IOMode::READ);
+    reader->setDir(".");
+    reader->setFilename("obj_grid");
+    reader->printResumeFile(false);
+    reader->exec();
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo = reader->getGeometry();
+    long nGrid = long(n-1)*long(n-1);
+    long nVertices = long(n)*long(n) + 4;
+
+    bool check = (geo->getPatch()->getVertexCount() == nVertices);
+    check = check && (geo->getPatch()->getCellCount() == nGrid + 2);
+    check = check && (reader->getMaterialFile() == "obj_grid.mtl");
+
+    //parts
+    std::unordered_map<long, std::string> parts = reader->getSubParts();
+    check = check && (parts.size() == 2) && (parts[0] == "Lower") && (parts[1] == "Upper");
+    long nLower(0), nUpper(0);
+    for(const bitpit::Cell & cell : geo->getCells()){
+        if(cell.getPID() == 0) ++nLower;
+        if(cell.getPID() == 1) ++nUpper;
+    }
+    check = check && (nLower == nGrid) && (nUpper == 2);
+
+    //relative indices of the last object
+    bitpit::ConstProxyVector<long> conn = geo->getPatch()->getCell(nGrid + 2).getVertexIds();
+    check = check && (conn.size() == 3) && (conn[0] == nVertices - 3) && (conn[1] == nVertices - 1) && (conn[2] == nVertices);
+
+    //textures and normals
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> textures = reader->getTextures();
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> normals = reader->getNormals();
+    check = check && textures && (textures->getPatch()->getCellCount() == nGrid);
+    check = check && normals && (normals->getPatch()->getCellCount() == 2);
+    check = check && normals && (normals->getPatch()->getVertexCount() == 1);
+
+    //cell data
+    mimmo::WavefrontOBJData * data = reader->getData();
+    check = check && (data->materials.at(1) == "steel") && (data->materials.at(nGrid + 1) == "");
+    check = check && (data->smoothids.at(nGrid) == 1) && (data->smoothids.at(nGrid + 2) == 0);
+    check = check && (data->cellgroups.at(1) == "") && (data->cellgroups.at(nGrid + 2) == "top");
+
+    delete reader;
+
+    std::cout<<"test passed :"<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		/**<Calling mimmo Test routines*/
+        int val = 1;
+        try{
+            val = test6_1() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_iogeneric_00006 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,257 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_iogeneric.hpp"
+
+typedef mimmo::ManipulateWFOBJData::NormalsComputeMode NormalsMode;
+typedef mimmo::ManipulateWFOBJData::OverlapAnnotationMode AnnotationMode;
+
+// =================================================================================== //
+/*!
+ * Write an obj file of 5 triangles sharing the vertex 1. Cells 1-3 (group "fanA") and
+ * cells 4-5 (group "fanB") are not connected through edges, so vertex 1 is a bowtie
+ * (non-manifold) vertex.
+ */
+void writeBowtieFile() {
+
+    std::ofstream out("./obj_bowtie.obj");
+    out<<"# mimmo test obj file"<<'\n';
+    out<<"o Bowtie"<<'\n';
+    out<<"v 0.0 0.0 0.0"<<'\n';
+    out<<"v 1.0 0.0 0.0"<<'\n';
+    out<<"v 1.0 1.0 0.5"<<'\n';
+    out<<"v 0.0 1.0 0.0"<<'\n';
+    out<<"v -0.5 1.0 0.2"<<'\n';
+    out<<"v -1.0 0.0 0.0"<<'\n';
+    out<<"v -1.0 0.0 1.0"<<'\n';
+    out<<"v 0.0 0.0 1.0"<<'\n';
+    out<<"vn 0.0 0.0 1.0"<<'\n';
+    out<<"g fanA"<<'\n';
+    out<<"f 1//1 2//1 3//1"<<'\n';
+    out<<"f 1//1 3//1 4//1"<<'\n';
+    out<<"f 1//1 4//1 5//1"<<'\n';
+    out<<"g fanB"<<'\n';
+    out<<"f 1//1 6//1 7//1"<<'\n';
+    out<<"f 1//1 7//1 8//1"<<'\n';
+    out.close();
+}
+
+/*!
+ * Reference vertex normal, averaged on the one-ring of cells walked through adjacencies,
+ * as ManipulateWFOBJData::evalVNormal does.
+ */
+darray3E evalRefNormal(bitpit::SurfaceKernel * mesh, long idCell, int locVertex, NormalsMode mode){
+
+    if(mode == NormalsMode::FLAT_BITPIT){
+        return mesh->evalVertexNormal(idCell, locVertex);
+    }
+
+    long targetVID = mesh->getCell(idCell).getVertexId(locVertex);
+    darray3E targetCoords = mesh->getVertexCoords(targetVID);
+    darray3E result({{0.0, 0.0, 0.0}});
+    double wwTot = 0.0, ww;
+    for(long id_r : mesh->findCellVertexOneRing(idCell, locVertex)){
+        if(mode == NormalsMode::AREA_WEIGHTED){
+            ww = mesh->evalCellArea(id_r);
+        }else{
+            bitpit::ConstProxyVector<long> vlist = mesh->getCell(id_r).getVertexIds();
+            std::size_t size = vlist.size();
+            std::size_t loc = mesh->getCell(id_r).findVertex(targetVID);
+            darray3E e0 = mesh->getVertexCoords(vlist[(loc - 1 + size)%size]) - targetCoords;
+            darray3E e1 = mesh->getVertexCoords(vlist[(loc + 1)%size]) - targetCoords;
+            ww = std::acos(std::min(1.0, std::max(-1.0, dotProduct(e0,e1)/(norm2(e0)*norm2(e1)))));
+        }
+        result += ww * mesh->evalFacetNormal(id_r);
+        wwTot += ww;
+    }
+    return result / wwTot;
+}
+
+/*!
+ * Reference annotation of the cell groups, marking cells one by one.
+ */
+void annotateRef(std::map<long, std::string> & groups, const std::vector<std::pair<std::string, livector1D>> & annotations,
+                 AnnotationMode mode){
+
+    for(const auto & annotation : annotations){
+        const std::string & name = annotation.first;
+        for(long id : annotation.second){
+            if(!groups.count(id))   continue;
+            std::string & entry = groups[id];
+            switch(mode){
+                case AnnotationMode::SOFT:
+                    if(entry.empty())   entry = name;
+                    break;
+                case AnnotationMode::GETALL:
+                    entry = entry.empty() ? name : entry + " " + name;
+                    break;
+                case AnnotationMode::GETALLNOBLANKS:
+                    if(entry.empty())   entry = name;
+                    else if(entry.find(name) == std::string::npos)  entry += name;
+                    break;
+                case AnnotationMode::HARD:
+                default:
+                    entry = name;
+                    break;
+            }
+        }
+    }
+}
+
+/*!
+ * Recompute the vertex normals of all the cells of a mesh with a bowtie vertex with
+ * ManipulateWFOBJData, and compare them with the one-ring reference normals.
+ * Annotate the cell groups with all the overlap modes and compare them with a reference
+ * marking.
+ */
+int test7_1() {
+
+    writeBowtieFile();
+    bool check = true;
+
+    //normals
+    std::vector<NormalsMode> normalsModes = {NormalsMode::FLAT_BITPIT, NormalsMode::AREA_WEIGHTED, NormalsMode::ANGLE_WEIGHTED};
+    for(NormalsMode mode : normalsModes){
+
+        mimmo::IOWavefrontOBJ * reader = new mimmo::IOWavefrontOBJ(mimmo::IOWavefrontOBJ::IOMode::READ);
+        reader->setDir(".");
+        reader->setFilename("obj_bowtie");
+        reader->printResumeFile(false);
+        reader->exec();
+
+        mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo = reader->getGeometry();
+        mimmo::WavefrontOBJData * data = reader->getData();
+
+        mimmo::MimmoPiercedVector<long> cellList(geo, mimmo::MPVLocation::CELL);
+        for(long id : geo->getCells().getIds()){
+            cellList.insert(id, id);
+        }
+
+        mimmo::ManipulateWFOBJData * manip = new mimmo::ManipulateWFOBJData();
+        manip->setData(data);
+        manip->setRecomputeNormalsCells(&cellList);
+        manip->setNormalsComputeStrategy(mode);
+        manip->exec();
+
+        geo->updateAdjacencies();
+        bitpit::SurfaceKernel * mesh = static_cast<bitpit::SurfaceKernel*>(geo->getPatch());
+        mimmo::MimmoSharedPointer<mimmo::MimmoObject> normals = data->normals;
+        bool modeCheck = (normals->getNCells() == geo->getNCells());
+        for(const bitpit::Cell & cell : geo->getCells()){
+            if(!normals->getCells().exists(cell.getId())){
+                modeCheck = false;
+                continue;
+            }
+            bitpit::ConstProxyVector<long> nconn = normals->getCells().at(cell.getId()).getVertexIds();
+            for(int j=0; j<int(cell.getVertexCount()); ++j){
+                darray3E ref = evalRefNormal(mesh, cell.getId(), j, mode);
+                modeCheck = modeCheck && (norm2(normals->getVertexCoords(nconn[j]) - ref) < 1.0E-10);
+            }
+        }
+        //the bowtie vertex has a different normal on each fan.
+        long nA = normals->getCells().at(1).getVertexId(0);
+        long nB = normals->getCells().at(4).getVertexId(0);
+        modeCheck = modeCheck && (norm2(normals->getVertexCoords(nA) - normals->getVertexCoords(nB)) > 1.0E-6);
+
+        std::cout<<"normals mode "<<int(mode)<<" match one-ring reference : "<<modeCheck<<std::endl;
+        check = check && modeCheck;
+
+        delete manip;
+        delete reader;
+    }
+
+    //annotations
+    std::vector<AnnotationMode> annotationModes = {AnnotationMode::HARD, AnnotationMode::SOFT, AnnotationMode::GETALL, AnnotationMode::GETALLNOBLANKS};
+    std::vector<std::pair<std::string, livector1D>> annotations = {{"ann1", {1, 2, 99}}, {"ann2", {2, 4}}, {"fanA", {3, 5}}};
+    for(AnnotationMode mode : annotationModes){
+
+        mimmo::IOWavefrontOBJ * reader = new mimmo::IOWavefrontOBJ(mimmo::IOWavefrontOBJ::IOMode::READ);
+        reader->setDir(".");
+        reader->setFilename("obj_bowtie");
+        reader->printResumeFile(false);
+        reader->exec();
+
+        mimmo::MimmoSharedPointer<mimmo::MimmoObject> geo = reader->getGeometry();
+        mimmo::WavefrontOBJData * data = reader->getData();
+
+        std::map<long, std::string> groups;
+        for(auto it = data->cellgroups.begin(); it != data->cellgroups.end(); ++it){
+            groups[it.getId()] = *it;
+        }
+        annotateRef(groups, annotations, mode);
+
+        mimmo::ManipulateWFOBJData * manip = new mimmo::ManipulateWFOBJData();
+        manip->setData(data);
+        manip->setMultipleAnnotationStrategy(mode);
+        std::vector<mimmo::MimmoPiercedVector<long>> marks(annotations.size(), mimmo::MimmoPiercedVector<long>(geo, mimmo::MPVLocation::CELL));
+        for(std::size_t k=0; k<annotations.size(); ++k){
+            marks[k].setName(annotations[k].first);
+            for(long id : annotations[k].second){
+                marks[k].insert(id, id);
+            }
+            manip->addAnnotation(&marks[k]);
+        }
+        manip->exec();
+
+        bool modeCheck = (std::size_t(data->cellgroups.size()) == groups.size());
+        for(const auto & entry : groups){
+            modeCheck = modeCheck && data->cellgroups.exists(entry.first) && (data->cellgroups.at(entry.first) == entry.second);
+        }
+        std::cout<<"annotation mode "<<int(mode)<<" match reference : "<<modeCheck<<std::endl;
+        check = check && modeCheck;
+
+        delete manip;
+        delete reader;
+    }
+
+    std::cout<<"test passed :"<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+		/**<Calling mimmo Test routines*/
+        int val = 1;
+        try{
+            val = test7_1() ;
+        }
+        catch(std::exception & e){
+            std::cout<<"test_iogeneric_00007 exited with an error of type : "<<e.what()<<std::endl;
+            return 1;
+        }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,235 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_iogeneric.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+/*!
+ * Surface of the unit cube: 8 vertices and 12 triangles. The first 6 triangles belong
+ * to the first solid/PID, the others to the second one.
+ */
+void buildCube(std::vector<darray3E> & points, std::vector<std::array<int,3>> & triangles){
+    points.clear();
+    for(int k = 0; k < 2; ++k){
+        for(int j = 0; j < 2; ++j){
+            for(int i = 0; i < 2; ++i){
+                points.push_back({{double(i), double(j), double(k)}});
+            }
+        }
+    }
+    triangles = {{{0,2,1}}, {{1,2,3}}, {{4,5,6}}, {{5,7,6}},
+                 {{0,1,4}}, {{1,5,4}}, {{2,6,3}}, {{3,6,7}},
+                 {{0,4,2}}, {{2,4,6}}, {{1,3,5}}, {{3,7,5}}};
+}
+
+/*!
+ * Write the cube as a two-solids ascii STL file.
+ */
+void writeSTLASCII(const std::string & filename){
+    std::vector<darray3E> points;
+    std::vector<std::array<int,3>> triangles;
+    buildCube(points, triangles);
+    std::ofstream out(filename);
+    for(int solid = 0; solid < 2; ++solid){
+        out<<"solid part"<<solid<<std::endl;
+        for(int t = 6*solid; t < 6*(solid+1); ++t){
+            out<<"  facet normal 0 0 0"<<std::endl;
+            out<<"    outer loop"<<std::endl;
+            for(int v : triangles[t]){
+                out<<"      vertex "<<points[v][0]<<" "<<points[v][1]<<" "<<points[v][2]<<std::endl;
+            }
+            out<<"    endloop"<<std::endl;
+            out<<"  endfacet"<<std::endl;
+        }
+        out<<"endsolid part"<<solid<<std::endl;
+    }
+}
+
+/*!
+ * Write the cube as a binary STL file.
+ * \param[in] header text at the beginning of the 80 bytes header
+ */
+void writeSTLBinary(const std::string & filename, const std::string & header){
+    std::vector<darray3E> points;
+    std::vector<std::array<int,3>> triangles;
+    buildCube(points, triangles);
+    std::ofstream out(filename, std::ios::binary);
+    char head[80];
+    std::memset(head, ' ', 80);
+    std::memcpy(head, header.data(), std::min(header.size(), std::size_t(80)));
+    out.write(head, 80);
+    std::uint32_t nFacets = std::uint32_t(triangles.size());
+    out.write(reinterpret_cast<const char *>(&nFacets), sizeof(nFacets));
+    for(const auto & triangle : triangles){
+        float record[12] = {0.0f, 0.0f, 0.0f};
+        for(int k = 0; k < 3; ++k){
+            for(int d = 0; d < 3; ++d){
+                record[3 + 3*k + d] = float(points[triangle[k]][d]);
+            }
+        }
+        out.write(reinterpret_cast<const char *>(record), sizeof(record));
+        std::uint16_t attribute = 0;
+        out.write(reinterpret_cast<const char *>(&attribute), sizeof(attribute));
+    }
+}
+
+/*!
+ * Write the cube as a short format Nastran file, with PIDs 1 and 2.
+ */
+void writeNAS(const std::string & filename){
+    std::vector<darray3E> points;
+    std::vector<std::array<int,3>> triangles;
+    buildCube(points, triangles);
+    std::ofstream out(filename);
+    char line[128];
+    out<<"BEGIN BULK"<<std::endl;
+    for(std::size_t i = 0; i < points.size(); ++i){
+        std::snprintf(line, sizeof(line), "GRID    %8d        %8.4f%8.4f%8.4f", int(i+1), points[i][0], points[i][1], points[i][2]);
+        out<<line<<std::endl;
+    }
+    for(std::size_t t = 0; t < triangles.size(); ++t){
+        std::snprintf(line, sizeof(line), "CTRIA3  %8d%8d%8d%8d%8d", int(t+1), int(t/6 + 1),
+                      triangles[t][0]+1, triangles[t][1]+1, triangles[t][2]+1);
+        out<<line<<std::endl;
+    }
+    out<<"ENDDATA"<<std::endl;
+}
+
+/*!
+ * Count the interior cells of each PID, throughout the processes.
+ */
+std::map<long, long> countPIDs(mimmo::MimmoSharedPointer<mimmo::MimmoObject> geometry){
+    long maxPID = 0;
+    for(const bitpit::Cell & cell : geometry->getCells()){
+        maxPID = std::max(maxPID, cell.getPID());
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &maxPID, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+    std::vector<long> counts(maxPID + 1, 0);
+    for(const bitpit::Cell & cell : geometry->getCells()){
+        if(cell.isInterior()) ++counts[cell.getPID()];
+    }
+    MPI_Allreduce(MPI_IN_PLACE, counts.data(), int(counts.size()), MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+    std::map<long, long> result;
+    for(long pid = 0; pid <= maxPID; ++pid){
+        if(counts[pid] > 0) result[pid] = counts[pid];
+    }
+    return result;
+}
+
+/*!
+ * Read a file serially and in parallel, and compare global counts of cells and vertices and PIDs.
+ * \param[in] nPIDs expected number of PIDs
+ */
+bool compareReads(const std::string & filename, FileType type, std::size_t nPIDs, bitpit::Logger & log){
+
+    mimmo::MimmoGeometry * serial = new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::READ);
+    serial->setReadDir(".");
+    serial->setReadFilename(filename);
+    serial->setReadFileType(type);
+    serial->exec();
+
+    mimmo::MimmoGeometry * parallel = new mimmo::MimmoGeometry(mimmo::MimmoGeometry::IOMode::READ);
+    parallel->setReadDir(".");
+    parallel->setReadFilename(filename);
+    parallel->setReadFileType(type);
+    parallel->setParallelRead(true);
+    parallel->exec();
+
+    bool check = (serial->getGeometry()->getNGlobalCells() == 12);
+    check = check && (serial->getGeometry()->getNGlobalVertices() == 8);
+    check = check && (parallel->getGeometry()->getNGlobalCells() == serial->getGeometry()->getNGlobalCells());
+    check = check && (parallel->getGeometry()->getNGlobalVertices() == serial->getGeometry()->getNGlobalVertices());
+    std::map<long, long> serialPIDs = countPIDs(serial->getGeometry());
+    check = check && (serialPIDs.size() == nPIDs);
+    check = check && (countPIDs(parallel->getGeometry()) == serialPIDs);
+
+    log<<filename<<" : serial and parallel reads match : "<<check<<std::endl;
+
+    delete serial;
+    delete parallel;
+    return check;
+}
+
+// =================================================================================== //
+/*!
+ * //testing parallel read of STL and Nastran files:
+   - ascii multi-solid STL
+   - binary STL
+   - binary STL whose header starts with "solid"
+   - short format Nastran
+   Global counts of cells and vertices and PIDs are compared with the ones of a serial read.
+ */
+int test2() {
+
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if(rank == 0){
+        writeSTLASCII("tip2_ascii.stl");
+        writeSTLBinary("tip2_binary.stl", "binary STL");
+        writeSTLBinary("tip2_solidbinary.stl", "solid binary STL");
+        writeNAS("tip2_nastran.nas");
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    bitpit::Logger & log = bitpit::log::cout(MIMMO_LOG_FILE);
+    log.setPriority(bitpit::log::Priority::NORMAL);
+
+    bool check = compareReads("tip2_ascii", FileType::STL, 2, log);
+    check = compareReads("tip2_binary", FileType::STL, 1, log) && check;
+    check = compareReads("tip2_solidbinary", FileType::STL, 1, log) && check;
+    check = compareReads("tip2_nastran", FileType::NAS, 2, log) && check;
+
+    log<<"test passed : "<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+	MPI_Init(&argc, &argv);
+#endif
+    int val = 1;
+    try{
+        /**<Calling mimmo Test routines*/
+        val = test2() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_iogeneric_parallel_00002 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+#if MIMMO_ENABLE_MPI
+	MPI_Finalize();
+#endif
+
+	return val;
+}
@@ -0,0 +1,368 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "IOOFOAM.hpp"
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <map>
+#include <sys/stat.h>
+
+/*
+ * Structured block of NX x NY x NZ hexahedra of unit size, split into two subdomains
+ * along x by the plane x = NX/2.
+ */
+const int NX = 4, NY = 2, NZ = 2;
+
+struct Face{
+    std::vector<long> vertices;
+    long owner;
+    long neighbour;
+};
+
+long pointId(int i, int j, int k){ return i + (NX+1)*(j + (NY+1)*k); }
+long cellId(int i, int j, int k){ return i + NX*(j + NY*k); }
+int  subdomainOf(long cell){ return (cell % NX) < NX/2 ? 0 : 1; }
+
+/*
+ * Faces of the undecomposed block: internal faces first, boundary faces after.
+ */
+std::vector<Face> blockFaces(){
+    std::vector<Face> internal, boundary;
+    for(int k=0; k<NZ; ++k){
+        for(int j=0; j<NY; ++j){
+            for(int i=0; i<NX; ++i){
+                long c = cellId(i,j,k);
+                Face fx{{pointId(i+1,j,k), pointId(i+1,j+1,k), pointId(i+1,j+1,k+1), pointId(i+1,j,k+1)}, c, -1};
+                Face fy{{pointId(i,j+1,k), pointId(i,j+1,k+1), pointId(i+1,j+1,k+1), pointId(i+1,j+1,k)}, c, -1};
+                Face fz{{pointId(i,j,k+1), pointId(i+1,j,k+1), pointId(i+1,j+1,k+1), pointId(i,j+1,k+1)}, c, -1};
+                if(i+1 < NX){ fx.neighbour = cellId(i+1,j,k); internal.push_back(fx);} else boundary.push_back(fx);
+                if(j+1 < NY){ fy.neighbour = cellId(i,j+1,k); internal.push_back(fy);} else boundary.push_back(fy);
+                if(k+1 < NZ){ fz.neighbour = cellId(i,j,k+1); internal.push_back(fz);} else boundary.push_back(fz);
+                if(i == 0) boundary.push_back(Face{{pointId(i,j,k), pointId(i,j,k+1), pointId(i,j+1,k+1), pointId(i,j+1,k)}, c, -1});
+                if(j == 0) boundary.push_back(Face{{pointId(i,j,k), pointId(i+1,j,k), pointId(i+1,j,k+1), pointId(i,j,k+1)}, c, -1});
+                if(k == 0) boundary.push_back(Face{{pointId(i,j,k), pointId(i,j+1,k), pointId(i+1,j+1,k), pointId(i+1,j,k)}, c, -1});
+            }
+        }
+    }
+    internal.insert(internal.end(), boundary.begin(), boundary.end());
+    return internal;
+}
+
+void writeHeader(std::ofstream & out, bool binary, const std::string & foamClass, const std::string & object, int labelBits = 32){
+    out<<"FoamFile\n{\n    version     2.0;\n    format      "<<(binary ? "binary" : "ascii")<<";\n";
+    out<<"    class       "<<foamClass<<";\n    arch        \"LSB;label="<<labelBits<<";scalar=64\";\n";
+    out<<"    object      "<<object<<";\n}\n// * * * * * * * * * * //\n\n";
+}
+
+void writeLabels(const std::string & filename, bool binary, const std::string & object, const std::vector<long> & labels, int labelBits = 32){
+    std::ofstream out(filename, std::ios::binary);
+    writeHeader(out, binary, "labelList", object, labelBits);
+    out<<labels.size()<<"\n(";
+    for(long label : labels){
+        if(binary && labelBits == 64){
+            std::int64_t value = std::int64_t(label);
+            out.write(reinterpret_cast<const char*>(&value), sizeof(std::int64_t));
+        }else if(binary){
+            std::int32_t value = std::int32_t(label);
+            out.write(reinterpret_cast<const char*>(&value), sizeof(std::int32_t));
+        }else{
+            out<<label<<"\n";
+        }
+    }
+    out<<")\n";
+}
+
+void writePolyMesh(const std::string & dir, bool binary, const std::vector<std::array<double,3>> & points,
+                   const std::vector<Face> & faces, long nInternal,
+                   const std::vector<std::pair<std::string, std::pair<long,long>>> & patches, int labelBits = 32){
+
+    {
+        std::ofstream out(dir + "/points", std::ios::binary);
+        writeHeader(out, binary, "vectorField", "points", labelBits);
+        out<<points.size()<<"\n(";
+        for(const std::array<double,3> & point : points){
+            if(binary){
+                out.write(reinterpret_cast<const char*>(point.data()), 3*sizeof(double));
+            }else{
+                out<<"("<<point[0]<<" "<<point[1]<<" "<<point[2]<<")\n";
+            }
+        }
+        out<<")\n";
+    }
+    {
+        std::ofstream out(dir + "/faces");
+        writeHeader(out, false, "faceList", "faces", labelBits);
+        out<<faces.size()<<"\n(\n";
+        for(const Face & face : faces){
+            out<<face.vertices.size()<<"("<<face.vertices[0]<<" "<<face.vertices[1]<<" "<<face.vertices[2]<<" "<<face.vertices[3]<<")\n";
+        }
+        out<<")\n";
+    }
+    std::vector<long> owner, neighbour;
+    for(long i = 0; i < long(faces.size()); ++i){
+        owner.push_back(faces[i].owner);
+        if(i < nInternal) neighbour.push_back(faces[i].neighbour);
+    }
+    writeLabels(dir + "/owner", binary, "owner", owner, labelBits);
+    writeLabels(dir + "/neighbour", binary, "neighbour", neighbour, labelBits);
+    {
+        std::ofstream out(dir + "/boundary");
+        writeHeader(out, false, "polyBoundaryMesh", "boundary", labelBits);
+        out<<patches.size()<<"\n(\n";
+        for(const auto & patch : patches){
+            bool processor = patch.first.compare(0, 4, "proc") == 0;
+            out<<"    "<<patch.first<<"\n    {\n        type "<<(processor ? "processor" : "wall")<<";\n";
+            out<<"        nFaces "<<patch.second.second<<";\n        startFace "<<patch.second.first<<";\n";
+            if(processor){
+                out<<"        neighbProcNo "<<patch.first.back()<<";\n";
+            }
+            out<<"    }\n";
+        }
+        out<<")\n";
+    }
+}
+
+/*
+ * Write an undecomposed case in ascii format and, in a second case, its decomposition
+ * in two subdomains in binary format with 64 bits labels.
+ */
+void writeCases(const std::string & dir, const std::string & decomposedDir){
+
+    std::vector<std::array<double,3>> points;
+    for(int k=0; k<=NZ; ++k)
+        for(int j=0; j<=NY; ++j)
+            for(int i=0; i<=NX; ++i)
+                points.push_back({{double(i), double(j), double(k)}});
+    std::vector<Face> faces = blockFaces();
+    long nInternal = 0;
+    while(faces[nInternal].neighbour >= 0) ++nInternal;
+
+    // remove points written back by a previous run
+    std::remove((dir + "/0/polyMesh/points").c_str());
+    std::remove((decomposedDir + "/processor0/0/polyMesh/points").c_str());
+    std::remove((decomposedDir + "/processor1/0/polyMesh/points").c_str());
+
+    mkdir(dir.c_str(), 0755);
+    mkdir((dir + "/constant").c_str(), 0755);
+    mkdir((dir + "/constant/polyMesh").c_str(), 0755);
+    writePolyMesh(dir + "/constant/polyMesh", false, points, faces, nInternal,
+                  {{"walls", {nInternal, long(faces.size()) - nInternal}}});
+
+    mkdir(decomposedDir.c_str(), 0755);
+
+    for(int s = 0; s < 2; ++s){
+        std::vector<long> cellAddressing, pointAddressing, faceAddressing;
+        std::map<long,long> localCell, localPoint;
+        for(long c = 0; c < NX*NY*NZ; ++c){
+            if(subdomainOf(c) != s) continue;
+            localCell[c] = long(cellAddressing.size());
+            cellAddressing.push_back(c);
+        }
+        std::vector<Face> internal, walls, processor;
+        std::vector<long> internalIds, wallIds, processorIds;
+        for(long f = 0; f < long(faces.size()); ++f){
+            Face face = faces[f];
+            bool ownerIn = subdomainOf(face.owner) == s;
+            bool neighbourIn = face.neighbour >= 0 && subdomainOf(face.neighbour) == s;
+            if(!ownerIn && !neighbourIn) continue;
+            if(ownerIn && neighbourIn){
+                internal.push_back(face); internalIds.push_back(f + 1);
+            }else if(face.neighbour < 0){
+                walls.push_back(face); wallIds.push_back(f + 1);
+            }else if(ownerIn){
+                face.neighbour = -1;
+                processor.push_back(face); processorIds.push_back(f + 1);
+            }else{
+                face.owner = face.neighbour;
+                face.neighbour = -1;
+                std::reverse(face.vertices.begin(), face.vertices.end());
+                processor.push_back(face); processorIds.push_back(-f - 1);
+            }
+        }
+        std::vector<Face> localFaces(internal);
+        localFaces.insert(localFaces.end(), walls.begin(), walls.end());
+        localFaces.insert(localFaces.end(), processor.begin(), processor.end());
+        faceAddressing = internalIds;
+        faceAddressing.insert(faceAddressing.end(), wallIds.begin(), wallIds.end());
+        faceAddressing.insert(faceAddressing.end(), processorIds.begin(), processorIds.end());
+
+        std::vector<std::array<double,3>> localPoints;
+        for(Face & face : localFaces){
+            face.owner = localCell[face.owner];
+            if(face.neighbour >= 0) face.neighbour = localCell[face.neighbour];
+            for(long & vertex : face.vertices){
+                if(localPoint.count(vertex) == 0){
+                    localPoint[vertex] = long(pointAddressing.size());
+                    pointAddressing.push_back(vertex);
+                    localPoints.push_back(points[vertex]);
+                }
+                vertex = localPoint[vertex];
+            }
+        }
+
+        std::string procDir = decomposedDir + "/processor" + std::to_string(s);
+        mkdir(procDir.c_str(), 0755);
+        mkdir((procDir + "/constant").c_str(), 0755);
+        mkdir((procDir + "/constant/polyMesh").c_str(), 0755);
+        long nLocalInternal = long(internal.size());
+        long nWalls = long(walls.size());
+        writePolyMesh(procDir + "/constant/polyMesh", true, localPoints, localFaces, nLocalInternal,
+                      {{"walls", {nLocalInternal, nWalls}},
+                       {"procBoundary" + std::to_string(s) + "to" + std::to_string(1 - s), {nLocalInternal + nWalls, long(processor.size())}}}, 64);
+        writeLabels(procDir + "/constant/polyMesh/pointProcAddressing", true, "pointProcAddressing", pointAddressing, 64);
+        writeLabels(procDir + "/constant/polyMesh/faceProcAddressing", true, "faceProcAddressing", faceAddressing, 64);
+        writeLabels(procDir + "/constant/polyMesh/cellProcAddressing", true, "cellProcAddressing", cellAddressing, 64);
+    }
+}
+
+/*
+ * Read the case with direct read and check the bulk and boundary meshes.
+ */
+bool checkRead(const std::string & dir, long nFaces){
+
+    mimmo::IOOFOAM * reader = new mimmo::IOOFOAM(false);
+    reader->setDir(dir);
+    reader->setDirectRead(true);
+    reader->exec();
+
+    bool check = true;
+    check = check && (reader->getGeometry()->getPatch()->getVertexCount() == (NX+1)*(NY+1)*(NZ+1));
+    check = check && (reader->getGeometry()->getPatch()->getCellCount() == NX*NY*NZ);
+    check = check && (reader->getBoundaryGeometry()->getPatch()->getCellCount() == 2*(NX*NY + NX*NZ + NY*NZ));
+    check = check && (reader->getBoundaryGeometry()->getPIDTypeList().size() == 1);
+    check = check && (reader->getBoundaryGeometry()->getPIDTypeList().count(1) == 1);
+    std::unordered_map<long,long> facesMap = reader->getFacesMap();
+    check = check && (long(facesMap.size()) == nFaces);
+    for(auto & entry : facesMap){
+        check = check && (entry.second != bitpit::Interface::NULL_ID);
+    }
+
+    double volume = 0.;
+    for(long cellId : reader->getGeometry()->getCellsIds(true)){
+        volume += reader->getGeometry()->evalCellVolume(cellId);
+    }
+    check = check && (std::abs(volume - double(NX*NY*NZ)) < 1.0E-12);
+
+    delete reader;
+    return check;
+}
+
+/*
+ * Read the case with direct read, translate the mesh and write its points back directly.
+ * Check the translated mesh is read back, and that the written points files declare the
+ * label size of the case.
+ */
+bool checkWriteBack(const std::string & dir, const std::vector<std::string> & pointsFiles, int labelBits){
+
+    mimmo::IOOFOAM * reader = new mimmo::IOOFOAM(false);
+    reader->setDir(dir);
+    reader->setDirectRead(true);
+    reader->exec();
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = reader->getGeometry();
+    for(long vertexId : mesh->getVertices().getIds()){
+        darray3E coords = mesh->getVertexCoords(vertexId);
+        coords[0] += 1.;
+        mesh->modifyVertex(coords, vertexId);
+    }
+
+    mimmo::IOOFOAM * writer = new mimmo::IOOFOAM(true);
+    writer->setDir(dir);
+    writer->setDirectRead(true);
+    writer->setOverwrite(true);
+    writer->setGeometry(mesh);
+    writer->exec();
+
+    mimmo::IOOFOAM * rereader = new mimmo::IOOFOAM(false);
+    rereader->setDir(dir);
+    rereader->setDirectRead(true);
+    rereader->exec();
+
+    darray3E pmin, pmax;
+    rereader->getGeometry()->getBoundingBox(pmin, pmax);
+    bool check = (std::abs(pmin[0] - 1.) < 1.0E-12) && (std::abs(pmax[0] - double(NX + 1)) < 1.0E-12);
+    check = check && (rereader->getGeometry()->getPatch()->getCellCount() == NX*NY*NZ);
+    std::string arch = "label=" + std::to_string(labelBits) + ";";
+    for(const std::string & pointsFile : pointsFiles){
+        std::ifstream in(dir + "/" + pointsFile, std::ios::binary);
+        std::string header((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        check = check && (header.find(arch) != std::string::npos);
+    }
+
+    delete reader;
+    delete writer;
+    delete rereader;
+    return check;
+}
+
+// =================================================================================== //
+int test2() {
+
+    long nFaces = long(blockFaces().size());
+    writeCases("ofoam_direct", "ofoam_direct_decomposed");
+
+    bool check = true;
+    check = check && checkRead("ofoam_direct", nFaces);
+    std::cout<<"undecomposed case read : "<<check<<std::endl;
+
+    // both subdomains are read concurrently and merged
+    check = check && checkRead("ofoam_direct_decomposed", nFaces);
+    std::cout<<"decomposed case read : "<<check<<std::endl;
+
+    check = check && checkWriteBack("ofoam_direct", {"0/polyMesh/points"}, 32);
+    check = check && checkWriteBack("ofoam_direct_decomposed", {"processor0/0/polyMesh/points", "processor1/0/polyMesh/points"}, 64);
+    std::cout<<"points write back : "<<check<<std::endl;
+
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+    #if MIMMO_ENABLE_MPI
+    	MPI_Init(&argc, &argv);
+    #endif
+    		/**<Calling mimmo Test routines*/
+            int val = 1;
+            try{
+                val = test2() ;
+            }
+            catch(std::exception & e){
+                std::cout<<"test_ioofoam_00002 exited with an error of type : "<<e.what()<<std::endl;
+                return 1;
+            }
+
+    #if MIMMO_ENABLE_MPI
+    	MPI_Finalize();
+    #endif
+
+    return val;
+}
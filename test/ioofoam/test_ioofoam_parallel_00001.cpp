@@ -0,0 +1,302 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "IOOFOAM.hpp"
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sys/stat.h>
+
+/*
+ * Structured block of NX x NY x NZ hexahedra of unit size, split into NS subdomains
+ * along x, each one NX/NS cells wide.
+ */
+const int NX = 6, NY = 2, NZ = 2, NS = 3;
+
+struct Face{
+    std::vector<long> vertices;
+    long owner;
+    long neighbour;
+};
+
+long pointId(int i, int j, int k){ return i + (NX+1)*(j + (NY+1)*k); }
+long cellId(int i, int j, int k){ return i + NX*(j + NY*k); }
+int  subdomainOf(long cell){ return int(cell % NX) / (NX/NS); }
+
+/*
+ * Faces of the undecomposed block: internal faces first, boundary faces after.
+ */
+std::vector<Face> blockFaces(){
+    std::vector<Face> internal, boundary;
+    for(int k=0; k<NZ; ++k){
+        for(int j=0; j<NY; ++j){
+            for(int i=0; i<NX; ++i){
+                long c = cellId(i,j,k);
+                Face fx{{pointId(i+1,j,k), pointId(i+1,j+1,k), pointId(i+1,j+1,k+1), pointId(i+1,j,k+1)}, c, -1};
+                Face fy{{pointId(i,j+1,k), pointId(i,j+1,k+1), pointId(i+1,j+1,k+1), pointId(i+1,j+1,k)}, c, -1};
+                Face fz{{pointId(i,j,k+1), pointId(i+1,j,k+1), pointId(i+1,j+1,k+1), pointId(i,j+1,k+1)}, c, -1};
+                if(i+1 < NX){ fx.neighbour = cellId(i+1,j,k); internal.push_back(fx);} else boundary.push_back(fx);
+                if(j+1 < NY){ fy.neighbour = cellId(i,j+1,k); internal.push_back(fy);} else boundary.push_back(fy);
+                if(k+1 < NZ){ fz.neighbour = cellId(i,j,k+1); internal.push_back(fz);} else boundary.push_back(fz);
+                if(i == 0) boundary.push_back(Face{{pointId(i,j,k), pointId(i,j,k+1), pointId(i,j+1,k+1), pointId(i,j+1,k)}, c, -1});
+                if(j == 0) boundary.push_back(Face{{pointId(i,j,k), pointId(i+1,j,k), pointId(i+1,j,k+1), pointId(i,j,k+1)}, c, -1});
+                if(k == 0) boundary.push_back(Face{{pointId(i,j,k), pointId(i,j+1,k), pointId(i+1,j+1,k), pointId(i+1,j,k)}, c, -1});
+            }
+        }
+    }
+    internal.insert(internal.end(), boundary.begin(), boundary.end());
+    return internal;
+}
+
+void writeHeader(std::ofstream & out, bool binary, const std::string & foamClass, const std::string & object){
+    out<<"FoamFile\n{\n    version     2.0;\n    format      "<<(binary ? "binary" : "ascii")<<";\n";
+    out<<"    class       "<<foamClass<<";\n    arch        \"LSB;label=32;scalar=64\";\n";
+    out<<"    object      "<<object<<";\n}\n// * * * * * * * * * * //\n\n";
+}
+
+void writeLabels(const std::string & filename, bool binary, const std::string & object, const std::vector<long> & labels){
+    std::ofstream out(filename, std::ios::binary);
+    writeHeader(out, binary, "labelList", object);
+    out<<labels.size()<<"\n(";
+    for(long label : labels){
+        if(binary){
+            int value = int(label);
+            out.write(reinterpret_cast<const char*>(&value), sizeof(int));
+        }else{
+            out<<label<<"\n";
+        }
+    }
+    out<<")\n";
+}
+
+/*
+ * Patch of a subdomain: name, first face, number of faces and neighbour subdomain (-1 for walls).
+ */
+struct Patch{
+    std::string name;
+    long        startFace;
+    long        nFaces;
+    int         neighbour;
+};
+
+void writePolyMesh(const std::string & dir, const std::vector<std::array<double,3>> & points,
+                   const std::vector<Face> & faces, long nInternal, const std::vector<Patch> & patches){
+
+    {
+        std::ofstream out(dir + "/points", std::ios::binary);
+        writeHeader(out, true, "vectorField", "points");
+        out<<points.size()<<"\n(";
+        for(const std::array<double,3> & point : points){
+            out.write(reinterpret_cast<const char*>(point.data()), 3*sizeof(double));
+        }
+        out<<")\n";
+    }
+    {
+        std::ofstream out(dir + "/faces");
+        writeHeader(out, false, "faceList", "faces");
+        out<<faces.size()<<"\n(\n";
+        for(const Face & face : faces){
+            out<<face.vertices.size()<<"("<<face.vertices[0]<<" "<<face.vertices[1]<<" "<<face.vertices[2]<<" "<<face.vertices[3]<<")\n";
+        }
+        out<<")\n";
+    }
+    std::vector<long> owner, neighbour;
+    for(long i = 0; i < long(faces.size()); ++i){
+        owner.push_back(faces[i].owner);
+        if(i < nInternal) neighbour.push_back(faces[i].neighbour);
+    }
+    writeLabels(dir + "/owner", true, "owner", owner);
+    writeLabels(dir + "/neighbour", true, "neighbour", neighbour);
+    {
+        std::ofstream out(dir + "/boundary");
+        writeHeader(out, false, "polyBoundaryMesh", "boundary");
+        out<<patches.size()<<"\n(\n";
+        for(const Patch & patch : patches){
+            out<<"    "<<patch.name<<"\n    {\n        type "<<(patch.neighbour >= 0 ? "processor" : "wall")<<";\n";
+            out<<"        nFaces "<<patch.nFaces<<";\n        startFace "<<patch.startFace<<";\n";
+            if(patch.neighbour >= 0){
+                out<<"        neighbProcNo "<<patch.neighbour<<";\n";
+            }
+            out<<"    }\n";
+        }
+        out<<")\n";
+    }
+}
+
+/*
+ * Write the decomposition of the block in NS subdomains in binary format.
+ */
+void writeDecomposedCase(const std::string & decomposedDir){
+
+    std::vector<std::array<double,3>> points;
+    for(int k=0; k<=NZ; ++k)
+        for(int j=0; j<=NY; ++j)
+            for(int i=0; i<=NX; ++i)
+                points.push_back({{double(i), double(j), double(k)}});
+    std::vector<Face> faces = blockFaces();
+
+    mkdir(decomposedDir.c_str(), 0755);
+
+    for(int s = 0; s < NS; ++s){
+        std::vector<long> cellAddressing, pointAddressing, faceAddressing;
+        std::map<long,long> localCell, localPoint;
+        for(long c = 0; c < NX*NY*NZ; ++c){
+            if(subdomainOf(c) != s) continue;
+            localCell[c] = long(cellAddressing.size());
+            cellAddressing.push_back(c);
+        }
+        // processor faces are grouped by neighbour subdomain, in global face order on both sides
+        std::vector<Face> internal, walls;
+        std::vector<long> internalIds, wallIds;
+        std::map<int, std::vector<Face>> processor;
+        std::map<int, std::vector<long>> processorIds;
+        for(long f = 0; f < long(faces.size()); ++f){
+            Face face = faces[f];
+            bool ownerIn = subdomainOf(face.owner) == s;
+            bool neighbourIn = face.neighbour >= 0 && subdomainOf(face.neighbour) == s;
+            if(!ownerIn && !neighbourIn) continue;
+            if(ownerIn && neighbourIn){
+                internal.push_back(face); internalIds.push_back(f + 1);
+            }else if(face.neighbour < 0){
+                walls.push_back(face); wallIds.push_back(f + 1);
+            }else if(ownerIn){
+                int other = subdomainOf(face.neighbour);
+                face.neighbour = -1;
+                processor[other].push_back(face); processorIds[other].push_back(f + 1);
+            }else{
+                int other = subdomainOf(face.owner);
+                face.owner = face.neighbour;
+                face.neighbour = -1;
+                std::reverse(face.vertices.begin(), face.vertices.end());
+                processor[other].push_back(face); processorIds[other].push_back(-f - 1);
+            }
+        }
+        std::vector<Face> localFaces(internal);
+        localFaces.insert(localFaces.end(), walls.begin(), walls.end());
+        faceAddressing = internalIds;
+        faceAddressing.insert(faceAddressing.end(), wallIds.begin(), wallIds.end());
+        long nLocalInternal = long(internal.size());
+        std::vector<Patch> patches = {{"walls", nLocalInternal, long(walls.size()), -1}};
+        for(auto & entry : processor){
+            patches.push_back(Patch{"procBoundary" + std::to_string(s) + "to" + std::to_string(entry.first),
+                                    long(localFaces.size()), long(entry.second.size()), entry.first});
+            localFaces.insert(localFaces.end(), entry.second.begin(), entry.second.end());
+            faceAddressing.insert(faceAddressing.end(), processorIds[entry.first].begin(), processorIds[entry.first].end());
+        }
+
+        std::vector<std::array<double,3>> localPoints;
+        for(Face & face : localFaces){
+            face.owner = localCell[face.owner];
+            if(face.neighbour >= 0) face.neighbour = localCell[face.neighbour];
+            for(long & vertex : face.vertices){
+                if(localPoint.count(vertex) == 0){
+                    localPoint[vertex] = long(pointAddressing.size());
+                    pointAddressing.push_back(vertex);
+                    localPoints.push_back(points[vertex]);
+                }
+                vertex = localPoint[vertex];
+            }
+        }
+
+        std::string procDir = decomposedDir + "/processor" + std::to_string(s);
+        mkdir(procDir.c_str(), 0755);
+        mkdir((procDir + "/constant").c_str(), 0755);
+        mkdir((procDir + "/constant/polyMesh").c_str(), 0755);
+        writePolyMesh(procDir + "/constant/polyMesh", localPoints, localFaces, nLocalInternal, patches);
+        writeLabels(procDir + "/constant/polyMesh/pointProcAddressing", true, "pointProcAddressing", pointAddressing);
+        writeLabels(procDir + "/constant/polyMesh/faceProcAddressing", true, "faceProcAddressing", faceAddressing);
+        writeLabels(procDir + "/constant/polyMesh/cellProcAddressing", true, "cellProcAddressing", cellAddressing);
+    }
+}
+
+// =================================================================================== //
+/*
+ * Testing direct read of a case decomposed in NS = 3 subdomains with 2 processes: the
+ * first process reads two subdomains concurrently, the second one reads the last one.
+ * Several threads are enabled, so that the subdomains, their files and the chunks of
+ * each file share them. Global counts of the partitioned mesh and its volume are checked.
+ */
+int test1() {
+
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if(rank == 0){
+        writeDecomposedCase("ofoam_parallel_decomposed");
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    mimmo::threads::setNumberOfThreads(4);
+
+    mimmo::IOOFOAM * reader = new mimmo::IOOFOAM(false);
+    reader->setDir("ofoam_parallel_decomposed");
+    reader->setDirectRead(true);
+    reader->exec();
+
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh = reader->getGeometry();
+    bool check = mesh->isDistributed();
+    check = check && (mesh->getNGlobalVertices() == (NX+1)*(NY+1)*(NZ+1));
+    check = check && (mesh->getNGlobalCells() == NX*NY*NZ);
+    check = check && (reader->getBoundaryGeometry()->getNGlobalCells() == 2*(NX*NY + NX*NZ + NY*NZ));
+
+    double volume = 0.;
+    for(long cellId : mesh->getCellsIds(true)){
+        volume += mesh->evalCellVolume(cellId);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &volume, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    check = check && (std::abs(volume - double(NX*NY*NZ)) < 1.0E-12);
+
+    MPI_Allreduce(MPI_IN_PLACE, &check, 1, MPI_C_BOOL, MPI_LAND, MPI_COMM_WORLD);
+    std::cout<<"decomposed case read with "<<NS<<" subdomains : "<<check<<std::endl;
+
+    mimmo::threads::setNumberOfThreads(0);
+    delete reader;
+    return int(!check);
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+    #if MIMMO_ENABLE_MPI
+    	MPI_Init(&argc, &argv);
+    #endif
+    		/**<Calling mimmo Test routines*/
+            int val = 1;
+            try{
+                val = test1() ;
+            }
+            catch(std::exception & e){
+                std::cout<<"test_ioofoam_parallel_00001 exited with an error of type : "<<e.what()<<std::endl;
+                return 1;
+            }
+
+    #if MIMMO_ENABLE_MPI
+    	MPI_Finalize();
+    #endif
+
+    return val;
+}
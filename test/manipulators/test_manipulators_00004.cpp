@@ -0,0 +1,140 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+#include "mimmo_manipulators.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/*
+ * Test 00004
+ * Testing the concurrent execution of thread-safe manipulators: a TranslationGeometry
+ * and a ScaleGeometry are executed on two threads while a third thread-safe block is
+ * still running, waiting for both of them. A block not declared thread-safe would wait
+ * for the running block to end, and the gate would expire.
+ */
+
+class Gate: public mimmo::BaseManipulation{
+public:
+    std::atomic<bool> m_running;
+    std::atomic<int> * m_completed;
+    bool m_passed;
+
+    Gate(std::atomic<int> * completed){m_running = false; m_completed = completed; m_passed = false;};
+    virtual ~Gate(){};
+    void buildPorts(){ m_arePortsBuilt = true;};
+    bool isThreadSafe(){ return true;};
+    void execute(){
+        m_running = true;
+        auto start = std::chrono::steady_clock::now();
+        while(*m_completed < 2 && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_passed = (*m_completed == 2);
+    };
+};
+
+// =================================================================================== //
+
+int test4() {
+
+    //two meshes of a single triangle.
+    std::vector<mimmo::MimmoSharedPointer<mimmo::MimmoObject>> meshes;
+    for(int i = 0; i < 2; ++i){
+        meshes.emplace_back(new mimmo::MimmoObject(1));
+        meshes[i]->addVertex({{0.0,0.0,0.0}}, 0);
+        meshes[i]->addVertex({{1.0,0.0,0.0}}, 1);
+        meshes[i]->addVertex({{0.0,1.0,0.0}}, 2);
+        meshes[i]->addConnectedCell(livector1D({0,1,2}), bitpit::ElementType::TRIANGLE, long(0), long(0));
+    }
+
+    mimmo::TranslationGeometry * translation = new mimmo::TranslationGeometry();
+    translation->setGeometry(meshes[0]);
+    translation->setDirection({{1.0,0.0,0.0}});
+    translation->setTranslation(2.0);
+    translation->setApply(true);
+
+    mimmo::ScaleGeometry * scale = new mimmo::ScaleGeometry();
+    scale->setGeometry(meshes[1]);
+    scale->setOrigin({{0.0,0.0,0.0}});
+    scale->setScaling({{3.0,3.0,3.0}});
+    scale->setApply(true);
+
+    bool check = translation->isThreadSafe() && scale->isThreadSafe();
+
+    std::atomic<int> completed(0);
+    Gate gate(&completed);
+    std::thread gateThread([&gate](){ gate.exec(); });
+    while(!gate.m_running){
+        std::this_thread::yield();
+    }
+
+    std::thread translationThread([&](){ translation->exec(); ++completed; });
+    std::thread scaleThread([&](){ scale->exec(); ++completed; });
+    translationThread.join();
+    scaleThread.join();
+    gateThread.join();
+
+    check = check && gate.m_passed;
+    check = check && (norm2(meshes[0]->getVertexCoords(1) - darray3E({{3.0,0.0,0.0}})) < 1.0e-12);
+    check = check && (norm2(meshes[1]->getVertexCoords(2) - darray3E({{0.0,3.0,0.0}})) < 1.0e-12);
+
+    delete translation;
+    delete scale;
+
+    if(check){
+        std::cout<<"test_manipulators_00004 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_manipulators_00004 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test4() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_manipulators_00004 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
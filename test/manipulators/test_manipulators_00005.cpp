@@ -0,0 +1,128 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  mimmo
+ *
+ *  Copyright (C) 2015-2021 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of mimmo.
+ *
+ *  mimmo is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  mimmo is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with mimmo. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \ *---------------------------------------------------------------------------*/
+
+
+#include "mimmo_manipulators.hpp"
+
+/*
+ * Test 00005
+ * Testing single precision ports: a displacement field and a filter stored in single
+ * precision are linked to an Apply block through the ports M_GDISPLS32 and M_FILTER32,
+ * and converted to double precision to deform the geometry. Single and double precision
+ * ports are not compatible.
+ */
+
+class Float32Source: public mimmo::BaseManipulation{
+public:
+    mimmo::fmpvecarr3E m_displ;
+    mimmo::fmpvector1D m_filter;
+
+    Float32Source(){};
+    virtual ~Float32Source(){};
+    void buildPorts(){
+        bool built = true;
+        built = (built && createPortOut<mimmo::fmpvecarr3E*, Float32Source>(this, &Float32Source::getDispl, M_GDISPLS32));
+        built = (built && createPortOut<mimmo::fmpvector1D*, Float32Source>(this, &Float32Source::getFilter, M_FILTER32));
+        m_arePortsBuilt = built;
+    };
+    mimmo::fmpvecarr3E * getDispl(){ return &m_displ;};
+    mimmo::fmpvector1D * getFilter(){ return &m_filter;};
+    void execute(){};
+};
+
+// =================================================================================== //
+
+int test5() {
+
+    //a single triangle.
+    mimmo::MimmoSharedPointer<mimmo::MimmoObject> mesh(new mimmo::MimmoObject(1));
+    mesh->addVertex({{0.0,0.0,0.0}}, 0);
+    mesh->addVertex({{1.0,0.0,0.0}}, 1);
+    mesh->addVertex({{0.0,1.0,0.0}}, 2);
+    mesh->addConnectedCell(livector1D({0,1,2}), bitpit::ElementType::TRIANGLE, long(0), long(0));
+
+    Float32Source * source = new Float32Source();
+    source->m_displ = mimmo::fmpvecarr3E(mesh, mimmo::MPVLocation::POINT);
+    source->m_filter = mimmo::fmpvector1D(mesh, mimmo::MPVLocation::POINT);
+    for(long id : mesh->getVertices().getIds()){
+        source->m_displ.insert(id, {{0.0f, 0.0f, float(id + 1)}});
+        source->m_filter.insert(id, 0.5f);
+    }
+
+    mimmo::Apply * applier = new mimmo::Apply();
+    applier->setGeometry(mesh);
+
+    bool check = !mimmo::pin::addPin(source, applier, M_GDISPLS32, M_GDISPLS);
+    check = mimmo::pin::addPin(source, applier, M_GDISPLS32, M_GDISPLS32) && check;
+    check = mimmo::pin::addPin(source, applier, M_FILTER32, M_FILTER32) && check;
+
+    source->exec();
+    applier->exec();
+
+    mimmo::dmpvecarr3E * output = applier->getOutput();
+    check = check && (output->size() == 3);
+    for(long id : mesh->getVertices().getIds()){
+        darray3E expected = {{0.0, 0.0, 0.5*double(id + 1)}};
+        check = check && (norm2((*output)[id] - expected) < 1.0e-12);
+        check = check && (std::abs(mesh->getVertexCoords(id)[2] - expected[2]) < 1.0e-12);
+    }
+
+    delete source;
+    delete applier;
+
+    if(check){
+        std::cout<<"test_manipulators_00005 PASSED"<<std::endl;
+    }else{
+        std::cout<<"test_manipulators_00005 FAILED"<<std::endl;
+    }
+    return !check;
+}
+
+// =================================================================================== //
+
+int main( int argc, char *argv[] ) {
+
+    BITPIT_UNUSED(argc);
+    BITPIT_UNUSED(argv);
+
+#if MIMMO_ENABLE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int val = 1;
+    /**<Calling mimmo Test routines*/
+    try{
+        val = test5() ;
+    }
+    catch(std::exception & e){
+        std::cout<<"test_manipulators_00005 exited with an error of type : "<<e.what()<<std::endl;
+        return 1;
+    }
+
+#if MIMMO_ENABLE_MPI
+    MPI_Finalize();
+#endif
+
+    return val;
+}
@@ -136,6 +136,9 @@ int test0() {
     /* Instantiation of a Partition object with default patition method space filling curve.
      * Plot Optional results during execution active for Partition block.
      */
+    mimmo0->buildVertexNormals();
+    std::size_t topologyRevision = mimmo0->getTopologyRevision();
+
     mimmo::Partition* partition = new mimmo::Partition();
     partition->setPartitionMethod(mimmo::PartitionMethod::PARTGEOM);
     partition->setPlotInExecution(true);
@@ -143,6 +146,14 @@ int test0() {
     partition->exec();
     mimmo0->getPatch()->write("support.1");
 
+    /* The partition changes the topology: caches built on the serial mesh are not valid anymore. */
+    bool checkCaches = (mimmo0->getTopologyRevision() != topologyRevision);
+    checkCaches = checkCaches && (mimmo0->getVertexNormalsSyncStatus() != mimmo::SyncStatus::SYNC);
+    if(!checkCaches){
+        bitpit::log::cout() << " geometry caches not invalidated by the partition " << std::endl;
+        return 1;
+    }
+
     /*Build the SkdTree of the geometry and retrieve it. */
     mimmo0->buildSkdTree();
     bitpit::PatchSkdTree* tree = mimmo0->getSkdTree();